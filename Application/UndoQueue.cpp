@@ -2,6 +2,7 @@
 #include "UndoQueue.h"
 
 #include "Platform/Assert.h"
+#include "Platform/Timer.h"
 #include "Foundation/Log.h"
 #include "Foundation/Exception.h"
 
@@ -24,12 +25,14 @@ UndoCommand::~UndoCommand()
 
 BatchUndoCommand::BatchUndoCommand()
     : m_IsSignificant( false )
+    , m_MergeKey( NULL )
 {
 
 }
 
 BatchUndoCommand::BatchUndoCommand(const std::vector<UndoCommandPtr>& objects)
     : m_IsSignificant( false )
+    , m_MergeKey( NULL )
 {
     Set( objects );
 }
@@ -88,8 +91,76 @@ bool BatchUndoCommand::IsEmpty() const
     return m_Commands.empty();
 }
 
+void BatchUndoCommand::SetMergeKey(const void* key)
+{
+    m_MergeKey = key;
+}
+
+const void* BatchUndoCommand::GetMergeKey() const
+{
+    return m_MergeKey;
+}
+
+bool BatchUndoCommand::Merge( UndoCommand* command )
+{
+    // commands sharing a merge key are always of the same type
+    BatchUndoCommand* next = static_cast< BatchUndoCommand* >( command );
+    if ( next->m_Commands.size() != m_Commands.size() )
+    {
+        return false;
+    }
+
+    // only merge if every command changes the same data as its counterpart, so nothing is touched on failure
+    for ( size_t i = 0; i < m_Commands.size(); ++i )
+    {
+        const void* key = m_Commands[ i ]->GetMergeKey();
+        if ( !key || next->m_Commands[ i ]->GetMergeKey() != key )
+        {
+            return false;
+        }
+    }
+
+    for ( size_t i = 0; i < m_Commands.size(); ++i )
+    {
+        bool merged = m_Commands[ i ]->Merge( next->m_Commands[ i ] );
+        HELIUM_ASSERT( merged );
+        HELIUM_UNREF( merged );
+    }
+
+    m_IsSignificant |= next->m_IsSignificant;
+    return true;
+}
+
+void BatchUndoCommand::Compact()
+{
+    std::vector<UndoCommandPtr>::iterator itr = m_Commands.begin();
+    std::vector<UndoCommandPtr>::iterator end = m_Commands.end();
+    for ( ; itr != end; ++itr )
+    {
+        UndoCommandPtr& command = *itr;
+        command->Compact();
+    }
+}
+
+size_t BatchUndoCommand::GetMemorySize() const
+{
+    size_t size = sizeof( *this ) + m_Commands.capacity() * sizeof( UndoCommandPtr );
+
+    std::vector<UndoCommandPtr>::const_iterator itr = m_Commands.begin();
+    std::vector<UndoCommandPtr>::const_iterator end = m_Commands.end();
+    for ( ; itr != end; ++itr )
+    {
+        const UndoCommandPtr& command = *itr;
+        size += command->GetMemorySize();
+    }
+
+    return size;
+}
+
 UndoQueue::UndoQueue()
 : m_MaxLength (0)
+, m_MemoryBudget (0)
+, m_MergeWindow (500)
 {
     Reset();
 }
@@ -105,12 +176,25 @@ void UndoQueue::Reset()
     m_Redo.clear();
     m_Active = false;
     m_BatchState = 0;
+    m_MemoryUsage = 0;
+    m_CanMerge = false;
+    m_LastPushTicks = 0;
+    m_MergedCount = 0;
+    m_TrimmedCount = 0;
+    m_LastUndoRedoMilliseconds = 0.0f;
     m_Reset.Raise( UndoQueueChangeArgs( this, NULL ) );
 }
 
 void UndoQueue::Print() const
 {
     Log::Print( TXT( "Max: %d\tUndo Length:\t%d\tRedo Length:\t%d\n" ), GetMaxLength(), m_Undo.size(), m_Redo.size() );
+    Log::Print(
+        TXT( "Memory: %" ) PRIuSZ TXT( " / %" ) PRIuSZ TXT( " bytes\tMerged:\t%u\tTrimmed:\t%u\tLast Undo/Redo:\t%.3f ms\n" ),
+        m_MemoryUsage,
+        m_MemoryBudget,
+        m_MergedCount,
+        m_TrimmedCount,
+        m_LastUndoRedoMilliseconds );
 }
 
 bool UndoQueue::IsActive() const
@@ -133,6 +217,48 @@ void UndoQueue::SetMaxLength( int value )
     m_MaxLength = value;
 }
 
+size_t UndoQueue::GetMemoryBudget() const
+{
+    return m_MemoryBudget;
+}
+
+void UndoQueue::SetMemoryBudget( size_t bytes )
+{
+    m_MemoryBudget = bytes;
+
+    Trim();
+}
+
+size_t UndoQueue::GetMemoryUsage() const
+{
+    return m_MemoryUsage;
+}
+
+uint32_t UndoQueue::GetMergeWindow() const
+{
+    return m_MergeWindow;
+}
+
+void UndoQueue::SetMergeWindow( uint32_t milliseconds )
+{
+    m_MergeWindow = milliseconds;
+}
+
+uint32_t UndoQueue::GetMergedCount() const
+{
+    return m_MergedCount;
+}
+
+uint32_t UndoQueue::GetTrimmedCount() const
+{
+    return m_TrimmedCount;
+}
+
+float32_t UndoQueue::GetLastUndoRedoMilliseconds() const
+{
+    return m_LastUndoRedoMilliseconds;
+}
+
 bool UndoQueue::IsBatching() const
 {
     return m_BatchState > 0;
@@ -173,16 +299,55 @@ void UndoQueue::Push( const UndoCommandPtr& c )
     HELIUM_ASSERT( c.ReferencesObject() );
 
     // we have a new command, so delete all subsequent commands from our current position
+    for ( std::vector<UndoCommandPtr>::const_iterator itr = m_Redo.begin(), end = m_Redo.end(); itr != end; ++itr )
+    {
+        m_MemoryUsage -= (*itr)->GetMemorySize();
+    }
     m_Redo.clear();
 
+    uint64_t ticks = Timer::GetTickCount();
+
+    // if this changes the same data as the last command, and follows it closely enough, fold it into that command
+    const void* mergeKey = c->GetMergeKey();
+    if ( mergeKey && m_CanMerge && !m_Undo.empty() && m_Undo.back()->GetMergeKey() == mergeKey &&
+         Timer::TicksToMilliseconds( ticks - m_LastPushTicks ) <= m_MergeWindow )
+    {
+        UndoCommandPtr& last = m_Undo.back();
+        size_t lastSize = last->GetMemorySize();
+        if ( last->Merge( c ) )
+        {
+            m_MemoryUsage = m_MemoryUsage - lastSize + last->GetMemorySize();
+            m_LastPushTicks = ticks;
+            ++m_MergedCount;
+
+            // fire an event to interested listeners
+            m_UndoCommandPushed.Raise( UndoQueueChangeArgs( this, last ) );
+
+#ifdef DEBUG_UNDO
+            Print();
+#endif
+            return;
+        }
+    }
+
+    // the last command pushed has been applied by now, so let it shrink what it captured
+    CompactNewest();
+
     // if we have a finite length and we are full, remove the oldest command
-    while ( m_MaxLength > 0 && GetLength() >= m_MaxLength )
+    while ( m_MaxLength > 0 && !m_Undo.empty() && GetLength() >= m_MaxLength )
     {
-        m_Undo.erase( m_Undo.begin() );
+        RemoveOldest();
     }
 
-    // append our command to the queue
+    // append our command to the queue, keeping it whole until the next command is pushed
     m_Undo.push_back( c );
+    m_MemoryUsage += c->GetMemorySize();
+
+    m_CanMerge = ( m_MergeWindow > 0 );
+    m_LastPushTicks = ticks;
+
+    // keep the history within its memory budget
+    Trim();
 
     // fire an event to interested listeners
     m_UndoCommandPushed.Raise( UndoQueueChangeArgs( this, c ) );
@@ -205,6 +370,9 @@ bool UndoQueue::CanRedo() const
 void UndoQueue::Undo()
 {
     m_Active = true;
+    m_CanMerge = false;
+
+    uint64_t startTicks = Timer::GetTickCount();
 
     // if the undo stack is not empty
     if ( m_Undo.size() > 0 )
@@ -231,12 +399,15 @@ void UndoQueue::Undo()
             }
             catch ( const Exception& e )
             {
+                m_MemoryUsage -= c->GetMemorySize();
+
                 Log::Warning( TXT( "Invalid undo command has been removed from the stack.\n" ) );
                 Log::Warning( TXT( "%s\n" ), e.What() );
             }
         }
     }
 
+    m_LastUndoRedoMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
     m_Active = false;
 
 #ifdef DEBUG_UNDO
@@ -247,6 +418,9 @@ void UndoQueue::Undo()
 void UndoQueue::Redo()
 {
     m_Active = true;
+    m_CanMerge = false;
+
+    uint64_t startTicks = Timer::GetTickCount();
 
     // if the redo staick is not empty
     if ( m_Redo.size() > 0 )
@@ -273,15 +447,49 @@ void UndoQueue::Redo()
             }
             catch ( const Exception& e )
             {
+                m_MemoryUsage -= c->GetMemorySize();
+
                 Log::Warning( TXT( "Removing invalid command from undo stack.\n" ) );
                 Log::Warning( TXT( "%s\n" ), e.What() );
             }
         }
     }
 
+    m_LastUndoRedoMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
     m_Active = false;
 
 #ifdef DEBUG_UNDO
     Print();
 #endif
 }
+
+void UndoQueue::CompactNewest()
+{
+    if ( m_Undo.empty() )
+    {
+        return;
+    }
+
+    UndoCommandPtr& newest = m_Undo.back();
+    size_t newestSize = newest->GetMemorySize();
+    newest->Compact();
+    m_MemoryUsage = m_MemoryUsage - newestSize + newest->GetMemorySize();
+}
+
+void UndoQueue::Trim()
+{
+    // always keep the most recent command, even if it alone is over budget
+    while ( m_MemoryBudget > 0 && m_MemoryUsage > m_MemoryBudget && m_Undo.size() > 1 )
+    {
+        RemoveOldest();
+    }
+}
+
+void UndoQueue::RemoveOldest()
+{
+    HELIUM_ASSERT( !m_Undo.empty() );
+
+    m_MemoryUsage -= m_Undo.front()->GetMemorySize();
+    m_Undo.pop_front();
+    ++m_TrimmedCount;
+}
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "Application/API.h"
+#include "Platform/Assert.h"
 #include "Foundation/Event.h"
 #include "Foundation/Property.h"
 #include "Foundation/SmartPtr.h"
 
+#include <deque>
+#include <string>
 #include <vector>
 
 namespace Helium
@@ -33,12 +36,54 @@ namespace Helium
         {
             return true;
         }
+
+        //
+        // Consecutive commands that change the same data (dragging a manipulator, scrubbing a property) can be merged
+        //  by the queue into a single undo step.  A command that supports this returns a non-null key identifying the
+        //  data it changes, such as the address of the member being set.  Commands sharing a key must be of the same
+        //  type.  Merge() absorbs a command pushed right after this one with the same key; afterwards this command
+        //  must undo to its own original state and redo to the state left by the absorbed command.
+        //
+
+        virtual const void* GetMergeKey() const
+        {
+            return NULL;
+        }
+
+        virtual bool Merge( UndoCommand* /*command*/ )
+        {
+            return false;
+        }
+
+        //
+        // Called by the queue once a newer command is pushed on top of this one, so it can shrink any state it
+        //  captured up front (see DeltaPropertyUndoCommand).  By then the change made by this command has been
+        //  applied and evaluated, so properties that return cached state report the changed value.
+        //
+
+        virtual void Compact()
+        {
+
+        }
+
+        //
+        // Approximate number of bytes held by this command, used to keep the undo history within its memory budget.
+        //  The size must not change while the command is in the queue, other than through Merge() and Compact().
+        //
+
+        virtual size_t GetMemorySize() const
+        {
+            return sizeof( UndoCommand );
+        }
     };
 
     typedef Helium::SmartPtr<UndoCommand> UndoCommandPtr;
 
     //
     // This is a tuple of commands for making multiple changes to multiple objects in a single command
+    //  A batch given a merge key (such as the manipulator that pushes it on each drag) merges with the next batch
+    //  sharing that key if both hold the same number of commands and each pair of commands shares a merge key;
+    //  the commands are then merged pairwise.
     //
 
     class HELIUM_APPLICATION_API BatchUndoCommand : public UndoCommand
@@ -46,6 +91,7 @@ namespace Helium
     protected:
         std::vector<UndoCommandPtr>   m_Commands;
         bool                    m_IsSignificant;
+        const void*             m_MergeKey;
 
     public:
         BatchUndoCommand();
@@ -59,10 +105,41 @@ namespace Helium
 
         virtual bool IsSignificant() const HELIUM_OVERRIDE;
         virtual bool IsEmpty() const;
+
+        void SetMergeKey(const void* key);
+        virtual const void* GetMergeKey() const HELIUM_OVERRIDE;
+        virtual bool Merge( UndoCommand* command ) HELIUM_OVERRIDE;
+
+        virtual void Compact() HELIUM_OVERRIDE;
+        virtual size_t GetMemorySize() const HELIUM_OVERRIDE;
     };
 
     typedef Helium::SmartPtr<BatchUndoCommand> BatchUndoCommandPtr;
 
+    //
+    // Approximate number of bytes a value held by an undo command owns outside of the command object itself (heap
+    //  storage, referenced objects that only the command keeps alive).  Specialize this for value types that own
+    //  such memory so it counts toward the undo memory budget.
+    //
+
+    template <class V>
+    struct UndoValueSize
+    {
+        static size_t Get( const V& /*value*/ )
+        {
+            return 0;
+        }
+    };
+
+    template <>
+    struct UndoValueSize< std::string >
+    {
+        static size_t Get( const std::string& value )
+        {
+            return value.capacity();
+        }
+    };
+
     //
     // UndoCommand template for get/set property data
     //
@@ -79,20 +156,30 @@ namespace Helium
 
         bool m_Significant; 
 
+        // identifies the data changed through the property, for merging (see UndoCommand::GetMergeKey)
+        const void* m_MergeKey;
+
+        // size of the memory owned by the latent value (see UndoValueSize), sampled so it stays fixed across swaps
+        size_t m_ValueSize;
+
     public:
         PropertyUndoCommand(const Helium::SmartPtr< Helium::Property<V> >& property)
             : m_Property (property)
             , m_Significant( true )
+            , m_MergeKey( NULL )
         {
             m_Value = m_Property->Get();
+            m_ValueSize = UndoValueSize<V>::Get( m_Value );
         }
 
         PropertyUndoCommand(const Helium::SmartPtr< Helium::Property<V> >& property, const V& val)
             : m_Property (property)
             , m_Value (val)
             , m_Significant( true )
+            , m_MergeKey( NULL )
         {
             Swap();
+            m_ValueSize = UndoValueSize<V>::Get( m_Value );
         }
 
         void SetSignificant(bool significant)
@@ -105,6 +192,33 @@ namespace Helium
             return m_Significant; 
         }
 
+        void SetMergeKey(const void* key)
+        {
+            m_MergeKey = key;
+        }
+
+        virtual const void* GetMergeKey() const HELIUM_OVERRIDE
+        {
+            return m_MergeKey;
+        }
+
+        virtual bool Merge( UndoCommand* command ) HELIUM_OVERRIDE
+        {
+            // we already hold the value from before both changes, so just keep it
+            m_Significant |= command->IsSignificant();
+            return true;
+        }
+
+        virtual void Compact() HELIUM_OVERRIDE
+        {
+            m_ValueSize = UndoValueSize<V>::Get( m_Value );
+        }
+
+        virtual size_t GetMemorySize() const HELIUM_OVERRIDE
+        {
+            return sizeof( *this ) + m_ValueSize;
+        }
+
         virtual void Undo() HELIUM_OVERRIDE
         {
             Swap();
@@ -128,6 +242,221 @@ namespace Helium
         }
     };
 
+    //
+    // UndoCommand template for get/set property data of large plain-old-data values (matrices, fixed arrays).
+    //  The full previous value is kept until a newer command is pushed on top of this one; after that, only the
+    //  32-bit words that differ from the value set by the command are stored, along with a bitmask of their
+    //  positions.  Undo and redo swap those words with the current value of the property.  If no word differs, the
+    //  property has not reported the change yet (its getter returns cached state), so the full value is kept.
+    //
+
+    template <class V>
+    class DeltaPropertyUndoCommand : public UndoCommand
+    {
+    private:
+        static const size_t WordCount = sizeof( V ) / sizeof( uint32_t );
+        static const size_t MaskWordCount = ( WordCount + 31 ) / 32;
+
+        // the property object we will get/set through
+        Helium::SmartPtr< Helium::Property<V> > m_Property;
+
+        // the full latent data value, until compacted
+        V* m_Value;
+
+        // bitmask of changed words followed by the latent data of each changed word, once compacted
+        uint32_t* m_Delta;
+        size_t m_DeltaSize;
+
+        bool m_Significant; 
+
+        // identifies the data changed through the property, for merging (see UndoCommand::GetMergeKey)
+        const void* m_MergeKey;
+
+    public:
+        DeltaPropertyUndoCommand(const Helium::SmartPtr< Helium::Property<V> >& property)
+            : m_Property (property)
+            , m_Value( new V( property->Get() ) )
+            , m_Delta( NULL )
+            , m_DeltaSize( 0 )
+            , m_Significant( true )
+            , m_MergeKey( NULL )
+        {
+            HELIUM_COMPILE_ASSERT( sizeof( V ) % sizeof( uint32_t ) == 0 );
+        }
+
+        DeltaPropertyUndoCommand(const Helium::SmartPtr< Helium::Property<V> >& property, const V& val)
+            : m_Property (property)
+            , m_Value( new V( val ) )
+            , m_Delta( NULL )
+            , m_DeltaSize( 0 )
+            , m_Significant( true )
+            , m_MergeKey( NULL )
+        {
+            HELIUM_COMPILE_ASSERT( sizeof( V ) % sizeof( uint32_t ) == 0 );
+            Swap();
+        }
+
+        virtual ~DeltaPropertyUndoCommand()
+        {
+            delete m_Value;
+            delete [] m_Delta;
+        }
+
+        void SetSignificant(bool significant)
+        {
+            m_Significant = significant; 
+        }
+
+        virtual bool IsSignificant() const
+        {
+            return m_Significant; 
+        }
+
+        void SetMergeKey(const void* key)
+        {
+            m_MergeKey = key;
+        }
+
+        virtual const void* GetMergeKey() const HELIUM_OVERRIDE
+        {
+            return m_MergeKey;
+        }
+
+        virtual bool Merge( UndoCommand* command ) HELIUM_OVERRIDE
+        {
+            // commands sharing a merge key are always of the same type
+            DeltaPropertyUndoCommand* next = static_cast< DeltaPropertyUndoCommand* >( command );
+            if ( !next->m_Value )
+            {
+                return false;
+            }
+
+            // the next command holds the full value set by this one, so rebuild our full previous value from it
+            if ( !m_Value )
+            {
+                m_Value = new V( *next->m_Value );
+                ApplyDelta( *m_Value );
+
+                delete [] m_Delta;
+                m_Delta = NULL;
+                m_DeltaSize = 0;
+            }
+
+            m_Significant |= command->IsSignificant();
+            return true;
+        }
+
+        virtual void Compact() HELIUM_OVERRIDE
+        {
+            if ( !m_Value )
+            {
+                return;
+            }
+
+            V current = m_Property->Get();
+            const uint32_t* currentWords = reinterpret_cast< const uint32_t* >( &current );
+            const uint32_t* latentWords = reinterpret_cast< const uint32_t* >( m_Value );
+
+            uint32_t mask[ MaskWordCount ] = { 0 };
+
+            size_t changedCount = 0;
+            for ( size_t i = 0; i < WordCount; ++i )
+            {
+                if ( currentWords[ i ] != latentWords[ i ] )
+                {
+                    mask[ i / 32 ] |= 1u << ( i % 32 );
+                    ++changedCount;
+                }
+            }
+
+            // keep the full value if the change is not visible through the property yet, or if a delta would not be
+            //  any smaller
+            size_t deltaSize = MaskWordCount + changedCount;
+            if ( changedCount == 0 || deltaSize >= WordCount )
+            {
+                return;
+            }
+
+            m_Delta = new uint32_t[ deltaSize ];
+            m_DeltaSize = deltaSize;
+
+            uint32_t* changedWords = m_Delta;
+            for ( size_t i = 0; i < MaskWordCount; ++i )
+            {
+                *changedWords++ = mask[ i ];
+            }
+
+            for ( size_t i = 0; i < WordCount; ++i )
+            {
+                if ( mask[ i / 32 ] & ( 1u << ( i % 32 ) ) )
+                {
+                    *changedWords++ = latentWords[ i ];
+                }
+            }
+
+            delete m_Value;
+            m_Value = NULL;
+        }
+
+        virtual size_t GetMemorySize() const HELIUM_OVERRIDE
+        {
+            return sizeof( *this ) + ( m_Value ? sizeof( V ) : 0 ) + m_DeltaSize * sizeof( uint32_t );
+        }
+
+        virtual void Undo() HELIUM_OVERRIDE
+        {
+            Swap();
+        }
+
+        virtual void Redo() HELIUM_OVERRIDE
+        {
+            Swap();
+        }
+
+        void Swap()
+        {
+            // read the existing value
+            V old = m_Property->Get();
+
+            if ( m_Value )
+            {
+                // set the stored value and save the previous one
+                m_Property->Set( *m_Value );
+                *m_Value = old;
+                return;
+            }
+
+            // exchange the changed words with the existing value
+            V value = old;
+            ApplyDelta( value );
+            m_Property->Set( value );
+
+            const uint32_t* oldWords = reinterpret_cast< const uint32_t* >( &old );
+            uint32_t* changedWords = m_Delta + MaskWordCount;
+            for ( size_t i = 0; i < WordCount; ++i )
+            {
+                if ( m_Delta[ i / 32 ] & ( 1u << ( i % 32 ) ) )
+                {
+                    *changedWords++ = oldWords[ i ];
+                }
+            }
+        }
+
+    private:
+        void ApplyDelta( V& value ) const
+        {
+            uint32_t* words = reinterpret_cast< uint32_t* >( &value );
+            const uint32_t* changedWords = m_Delta + MaskWordCount;
+            for ( size_t i = 0; i < WordCount; ++i )
+            {
+                if ( m_Delta[ i / 32 ] & ( 1u << ( i % 32 ) ) )
+                {
+                    words[ i ] = *changedWords++;
+                }
+            }
+        }
+    };
+
     //
     // ExistenceUndoCommand helps store some state for add/remove with undo/redo support using delegates
     //
@@ -230,8 +559,8 @@ namespace Helium
         //
 
     private:
-        // The undo and redo stacks
-        std::vector<UndoCommandPtr> m_Undo;
+        // The undo and redo stacks (the oldest undo commands are trimmed from the front)
+        std::deque<UndoCommandPtr> m_Undo;
         std::vector<UndoCommandPtr> m_Redo;
 
         // is the queue active, we don't want to modify the queue while we are commiting a change
@@ -240,6 +569,22 @@ namespace Helium
         // max allowed length of the queue
         int m_MaxLength;
 
+        // max allowed memory use of the queue in bytes (zero for no limit), and the current use
+        size_t m_MemoryBudget;
+        size_t m_MemoryUsage;
+
+        // commands pushed within this many milliseconds of the previous one may be merged with it (zero to disable)
+        uint32_t m_MergeWindow;
+
+        // can the next command be merged with the last one pushed, and when was it pushed
+        bool m_CanMerge;
+        uint64_t m_LastPushTicks;
+
+        // statistics
+        uint32_t m_MergedCount;
+        uint32_t m_TrimmedCount;
+        float32_t m_LastUndoRedoMilliseconds;
+
         // the batch state
         int m_BatchState;
 
@@ -272,6 +617,22 @@ namespace Helium
 
         void SetMaxLength(int value);
 
+        size_t GetMemoryBudget() const;
+
+        void SetMemoryBudget(size_t bytes);
+
+        size_t GetMemoryUsage() const;
+
+        uint32_t GetMergeWindow() const;
+
+        void SetMergeWindow(uint32_t milliseconds);
+
+        uint32_t GetMergedCount() const;
+
+        uint32_t GetTrimmedCount() const;
+
+        float32_t GetLastUndoRedoMilliseconds() const;
+
 
         //
         // Auto-Batching
@@ -301,6 +662,13 @@ namespace Helium
 
         void Redo();
 
+    private:
+        void CompactNewest();
+
+        void Trim();
+
+        void RemoveOldest();
+
 
         // 
         // Events
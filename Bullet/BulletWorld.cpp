@@ -5,6 +5,8 @@
 #include "Bullet/BulletBodyComponent.h"
 #include "Bullet/BulletWorldComponent.h"
 
+#include "Engine/FrameProfiler.h"
+
 using namespace Helium;
 
 void InternalTickCallback(btDynamicsWorld *world, btScalar timeStep)
@@ -148,5 +150,6 @@ BulletWorld::~BulletWorld()
 
 void BulletWorld::Simulate( float dt )
 {
+	HELIUM_FRAME_PROFILE_SCOPE( "BulletWorld::Simulate" );
 	m_DynamicsWorld->stepSimulation(dt,10);
 }
@@ -0,0 +1,193 @@
+#include "ComponentsPch.h"
+#include "Components/AnimationComponent.h"
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+
+#include "Framework/World.h"
+#include "Framework/WorldManager.h"
+#include "Graphics/AnimationEvaluator.h"
+#include "Reflect/TranslatorDeduction.h"
+
+using namespace Helium;
+
+HELIUM_DEFINE_CLASS(Helium::AnimationComponentDefinition);
+
+void AnimationComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField(&AnimationComponentDefinition::m_Animation, "m_Animation");
+	comp.AddField(&AnimationComponentDefinition::m_PlaybackRate, "m_PlaybackRate");
+	comp.AddField(&AnimationComponentDefinition::m_Loop, "m_Loop");
+}
+
+AnimationComponentDefinition::AnimationComponentDefinition()
+	: m_PlaybackRate( 1.0f )
+	, m_Loop( true )
+{
+
+}
+
+HELIUM_DEFINE_COMPONENT(Helium::AnimationComponent, 128);
+
+void AnimationComponent::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+}
+
+/// Constructor.
+AnimationComponent::AnimationComponent()
+: m_PlaybackRate( 1.0f )
+, m_bLoop( true )
+, m_pSkeleton( NULL )
+, m_pBoundClip( NULL )
+{
+}
+
+/// Copy constructor.
+///
+/// Only the playback settings are copied.  The copy binds its own skeleton the first time it is updated.
+AnimationComponent::AnimationComponent( const AnimationComponent& rRhs )
+: m_Animation( rRhs.m_Animation )
+, m_PlaybackRate( rRhs.m_PlaybackRate )
+, m_bLoop( rRhs.m_bLoop )
+, m_pSkeleton( NULL )
+, m_pBoundClip( NULL )
+{
+}
+
+/// Destructor.
+AnimationComponent::~AnimationComponent()
+{
+	Unbind();
+
+	delete m_pSkeleton;
+}
+
+void AnimationComponent::Initialize( const AnimationComponentDefinition& definition )
+{
+	m_Animation = definition.m_Animation;
+	m_PlaybackRate = definition.m_PlaybackRate;
+	m_bLoop = definition.m_Loop;
+}
+
+/// Set the animation clip to play, restarting playback if it changes.
+///
+/// @param[in] pAnimation  Animation clip to play, or null to return the mesh to its reference pose.
+///
+/// @see GetAnimation()
+void AnimationComponent::SetAnimation( Animation* pAnimation )
+{
+	m_Animation = pAnimation;
+}
+
+/// Bind the skeleton to the mesh of the given mesh component if needed and advance playback.
+///
+/// The skeleton itself is not evaluated here, so that all skeletons in a world can be evaluated in parallel once
+/// they have been advanced.
+///
+/// @param[in] pMeshComponent  Sibling mesh component.
+/// @param[in] deltaSeconds    Time elapsed since the previous update, in seconds.
+///
+/// @return  Skeleton to evaluate for this frame, or null if there is nothing to animate.
+AnimatedSkeleton* AnimationComponent::Update( MeshComponent* pMeshComponent, float32_t deltaSeconds )
+{
+	HELIUM_ASSERT( pMeshComponent );
+
+	Mesh* pMesh = pMeshComponent->GetMesh();
+	Animation* pAnimation = m_Animation;
+	if( !pMesh || !pMesh->IsSkinned() || pMesh->GetBoneCount() == 0 ||
+		!pAnimation || pAnimation->GetClipData().m_sampleCount == 0 )
+	{
+		Unbind();
+
+		return NULL;
+	}
+
+	if( m_spBoundMesh.Get() != pMesh || m_MeshComponent.Get() != pMeshComponent )
+	{
+		Unbind();
+
+		if( !m_pSkeleton )
+		{
+			m_pSkeleton = new AnimatedSkeleton;
+			HELIUM_ASSERT( m_pSkeleton );
+		}
+
+		m_pSkeleton->Initialize(
+			pMesh->GetBoneCount(),
+			pMesh->GetBoneNames(),
+			pMesh->GetParentBoneIndices(),
+			pMesh->GetReferencePose() );
+
+		m_spBoundMesh = pMesh;
+		m_MeshComponent = pMeshComponent;
+		pMeshComponent->SetSkinningData(
+			m_pSkeleton->GetInverseReferencePose(),
+			m_pSkeleton->GetBonePalette(),
+			m_pSkeleton->GetBoneCount() );
+	}
+
+	const Animation::PersistentResourceData* pClip = &pAnimation->GetClipData();
+	if( m_pBoundClip != pClip )
+	{
+		m_pSkeleton->SetLayerClip( 0, pClip, m_bLoop );
+		m_pSkeleton->SetLayerWeight( 0, 1.0f );
+		m_pBoundClip = pClip;
+	}
+
+	m_pSkeleton->SetLayerPlaybackRate( 0, m_PlaybackRate );
+	m_pSkeleton->AdvanceTime( deltaSeconds );
+
+	return m_pSkeleton;
+}
+
+/// Release the binding between the skeleton and the current mesh, returning the mesh to its reference pose.
+void AnimationComponent::Unbind()
+{
+	if( m_MeshComponent.IsGood() )
+	{
+		m_MeshComponent->SetSkinningData( NULL, NULL, 0 );
+	}
+
+	m_MeshComponent.Reset();
+	m_spBoundMesh.Release();
+	m_pBoundClip = NULL;
+
+	if( m_pSkeleton )
+	{
+		m_pSkeleton->Shutdown();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// Animation components are updated during the render tick, which only ever updates one world at a time.
+static DynamicArray< AnimatedSkeleton* > animatedSkeletons;
+static float32_t animationDeltaSeconds = 0.0f;
+
+void UpdateAnimationComponent(AnimationComponent *pAnimationComponent, MeshComponent *pMeshComponent)
+{
+	AnimatedSkeleton* pSkeleton = pAnimationComponent->Update( pMeshComponent, animationDeltaSeconds );
+	if( pSkeleton )
+	{
+		animatedSkeletons.Push( pSkeleton );
+	}
+}
+
+void UpdateAnimationComponents( World *pWorld )
+{
+	animatedSkeletons.Resize( 0 );
+	animationDeltaSeconds = WorldManager::GetStaticInstance().GetFrameDeltaSeconds();
+
+	QueryComponents< AnimationComponent, MeshComponent, UpdateAnimationComponent >( pWorld );
+
+	AnimationEvaluator::GetStaticInstance().Evaluate( animatedSkeletons.GetData(), animatedSkeletons.GetSize() );
+}
+
+void Helium::UpdateAnimationComponentsTask::DefineContract( TaskContract &rContract )
+{
+	rContract.ExecuteBefore<Helium::UpdateMeshComponentsTask>();
+	rContract.ExecuteAfter<StandardDependencies::ProcessPhysics>();
+}
+
+HELIUM_DEFINE_TASK( UpdateAnimationComponentsTask, (ForEachWorld< UpdateAnimationComponents >), TickTypes::Render );
+
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Components/Components.h"
+
+#include "Components/MeshComponent.h"
+#include "Framework/ComponentDefinition.h"
+#include "Framework/TaskScheduler.h"
+#include "Graphics/Animation.h"
+#include "Graphics/AnimatedSkeleton.h"
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+
+namespace Helium
+{
+	struct AnimationComponentDefinition;
+
+	/// Plays an animation clip on the skinned mesh of a sibling MeshComponent.
+	///
+	/// Skeletons of all animation components in a world are evaluated together by the AnimationEvaluator during the
+	/// render tick, and the resulting bone palettes are handed to the mesh component for rendering.
+	class HELIUM_COMPONENTS_API AnimationComponent : public Component
+	{
+	public:
+		HELIUM_DECLARE_COMPONENT( Helium::AnimationComponent, Helium::Component );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		AnimationComponent();
+		AnimationComponent( const AnimationComponent& rRhs );
+		virtual ~AnimationComponent();
+
+		void Initialize( const Helium::AnimationComponentDefinition& definition );
+
+		/// @name Playback
+		//@{
+		void SetAnimation( Animation* pAnimation );
+		inline Animation* GetAnimation() const;
+
+		inline void SetPlaybackRate( float32_t playbackRate );
+		inline float32_t GetPlaybackRate() const;
+		//@}
+
+		AnimatedSkeleton* Update( MeshComponent* pMeshComponent, float32_t deltaSeconds );
+
+	private:
+		/// Animation clip being played.
+		StrongPtr< Animation > m_Animation;
+		/// Playback rate (1 for normal speed).
+		float32_t m_PlaybackRate;
+		/// True to loop the clip, false to hold its last sample.
+		bool m_bLoop;
+
+		/// Skeleton instance (allocated once bound to a skinned mesh).
+		AnimatedSkeleton* m_pSkeleton;
+		/// Mesh to which the skeleton is currently bound.
+		StrongPtr< Mesh > m_spBoundMesh;
+		/// Clip data currently played by the skeleton.
+		const Animation::PersistentResourceData* m_pBoundClip;
+		/// Mesh component receiving the bone palette.
+		MeshComponentPtr m_MeshComponent;
+
+		void Unbind();
+	};
+
+	struct HELIUM_COMPONENTS_API AnimationComponentDefinition : public Helium::ComponentDefinitionHelper<AnimationComponent, AnimationComponentDefinition>
+	{
+	public:
+		HELIUM_DECLARE_CLASS( Helium::AnimationComponentDefinition, Helium::ComponentDefinition );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		AnimationComponentDefinition();
+
+		StrongPtr< Animation > m_Animation;
+		float32_t m_PlaybackRate;
+		bool m_Loop;
+	};
+	typedef StrongPtr<AnimationComponentDefinition> AnimationComponentDefinitionPtr;
+
+	struct HELIUM_COMPONENTS_API UpdateAnimationComponentsTask : public TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(UpdateAnimationComponentsTask);
+		virtual void DefineContract(TaskContract &rContract);
+	};
+}
+
+#include "Components/AnimationComponent.inl"
+
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
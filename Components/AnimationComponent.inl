@@ -0,0 +1,29 @@
+/// Get the animation clip being played.
+///
+/// @return  Animation clip.
+///
+/// @see SetAnimation()
+Helium::Animation* Helium::AnimationComponent::GetAnimation() const
+{
+    return m_Animation;
+}
+
+/// Set the playback rate of the animation clip.
+///
+/// @param[in] playbackRate  Playback rate (1 for normal speed).
+///
+/// @see GetPlaybackRate()
+void Helium::AnimationComponent::SetPlaybackRate( float32_t playbackRate )
+{
+    m_PlaybackRate = playbackRate;
+}
+
+/// Get the playback rate of the animation clip.
+///
+/// @return  Playback rate.
+///
+/// @see SetPlaybackRate()
+float32_t Helium::AnimationComponent::GetPlaybackRate() const
+{
+    return m_PlaybackRate;
+}
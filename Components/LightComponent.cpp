@@ -0,0 +1,207 @@
+#include "ComponentsPch.h"
+#include "Components/LightComponent.h"
+
+#include "Framework/World.h"
+#include "Graphics/GraphicsManagerComponent.h"
+#include "Reflect/TranslatorDeduction.h"
+
+using namespace Helium;
+
+HELIUM_DEFINE_CLASS(Helium::LightComponentDefinition);
+
+void LightComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField(&LightComponentDefinition::m_Color, "m_Color");
+	comp.AddField(&LightComponentDefinition::m_Brightness, "m_Brightness");
+	comp.AddField(&LightComponentDefinition::m_Radius, "m_Radius");
+	comp.AddField(&LightComponentDefinition::m_SpotInnerAngle, "m_SpotInnerAngle");
+	comp.AddField(&LightComponentDefinition::m_SpotOuterAngle, "m_SpotOuterAngle");
+}
+
+LightComponentDefinition::LightComponentDefinition()
+	: m_Color( 0xffffffff )
+	, m_Brightness( 1.0f )
+	, m_Radius( 10.0f )
+	, m_SpotInnerAngle( 0.0f )
+	, m_SpotOuterAngle( 0.0f )
+{
+
+}
+
+HELIUM_DEFINE_COMPONENT(Helium::LightComponent, 128);
+
+void LightComponent::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+}
+
+/// Constructor.
+LightComponent::LightComponent()
+: m_Color( 0xffffffff )
+, m_Brightness( 1.0f )
+, m_Radius( 10.0f )
+, m_SpotInnerAngle( 0.0f )
+, m_SpotOuterAngle( 0.0f )
+, m_graphicsSceneLightId( Invalid< size_t >() )
+, m_bNeedsUpdate( true )
+{
+}
+
+/// Copy constructor.
+///
+/// Only the light properties are copied.  The copy allocates its own scene light the first time it is updated.
+LightComponent::LightComponent( const LightComponent& rRhs )
+: m_Color( rRhs.m_Color )
+, m_Brightness( rRhs.m_Brightness )
+, m_Radius( rRhs.m_Radius )
+, m_SpotInnerAngle( rRhs.m_SpotInnerAngle )
+, m_SpotOuterAngle( rRhs.m_SpotOuterAngle )
+, m_graphicsSceneLightId( Invalid< size_t >() )
+, m_bNeedsUpdate( true )
+{
+}
+
+/// Destructor.
+LightComponent::~LightComponent()
+{
+	Detach();
+}
+
+void LightComponent::Initialize( const LightComponentDefinition& definition )
+{
+	m_Color = definition.m_Color;
+	m_Brightness = definition.m_Brightness;
+	m_Radius = definition.m_Radius;
+	m_SpotInnerAngle = definition.m_SpotInnerAngle;
+	m_SpotOuterAngle = definition.m_SpotOuterAngle;
+	m_bNeedsUpdate = true;
+}
+
+/// Set the light color.
+///
+/// @param[in] rColor      Light color.
+/// @param[in] brightness  Light brightness factor.
+///
+/// @see GetColor(), GetBrightness()
+void LightComponent::SetColor( const Color& rColor, float32_t brightness )
+{
+	m_Color = rColor;
+	m_Brightness = brightness;
+	m_bNeedsUpdate = true;
+}
+
+/// Set the distance at which the light's contribution falls off to zero.
+///
+/// @param[in] radius  Light radius.
+///
+/// @see GetRadius()
+void LightComponent::SetRadius( float32_t radius )
+{
+	m_Radius = Max( radius, 0.0f );
+	m_bNeedsUpdate = true;
+}
+
+/// Set the spot cone angles of the light.
+///
+/// @param[in] innerAngle  Half-angle of the cone inside which the light is at full intensity, in degrees.
+/// @param[in] outerAngle  Half-angle of the cone outside which the light has no contribution, in degrees, or zero to
+///                        make this a point light.
+///
+/// @see GetSpotInnerAngle(), GetSpotOuterAngle()
+void LightComponent::SetSpotAngles( float32_t innerAngle, float32_t outerAngle )
+{
+	m_SpotInnerAngle = innerAngle;
+	m_SpotOuterAngle = outerAngle;
+	m_bNeedsUpdate = true;
+}
+
+/// Attach the light to the graphics scene if necessary and update its placement and properties.
+///
+/// @param[in] pGraphicsScene  Graphics scene of the world to which this component belongs.
+/// @param[in] pTransform      Transform of the entity to which this component belongs.
+void LightComponent::Update( GraphicsScene* pGraphicsScene, TransformComponent* pTransform )
+{
+	HELIUM_ASSERT( pGraphicsScene );
+	HELIUM_ASSERT( pTransform );
+
+	if( m_spGraphicsScene.Get() != pGraphicsScene )
+	{
+		Detach();
+
+		m_spGraphicsScene = pGraphicsScene;
+		m_graphicsSceneLightId = pGraphicsScene->AllocateSceneLight();
+		HELIUM_ASSERT( IsValid( m_graphicsSceneLightId ) );
+
+		m_bNeedsUpdate = true;
+	}
+
+	if( !m_bNeedsUpdate && !pTransform->IsDirty() )
+	{
+		return;
+	}
+
+	GraphicsSceneLight* pSceneLight = pGraphicsScene->GetSceneLight( m_graphicsSceneLightId );
+	HELIUM_ASSERT( pSceneLight );
+
+	const Simd::Vector3& rPosition = pTransform->GetPosition();
+	if( m_SpotOuterAngle > 0.0f )
+	{
+		Simd::Matrix44 rotation( Simd::Matrix44::INIT_ROTATION_TRANSLATION, pTransform->GetRotation(), rPosition );
+		Simd::Vector3 direction = rotation.TransformVector( Simd::Vector3( 0.0f, 0.0f, 1.0f ) );
+
+		float32_t degreesToRadians = static_cast< float32_t >( HELIUM_DEG_TO_RAD );
+		pSceneLight->SetSpotLight(
+			rPosition,
+			direction,
+			m_Radius,
+			m_SpotInnerAngle * degreesToRadians,
+			m_SpotOuterAngle * degreesToRadians );
+	}
+	else
+	{
+		pSceneLight->SetPointLight( rPosition, m_Radius );
+	}
+
+	pSceneLight->SetColor( m_Color, m_Brightness );
+
+	m_bNeedsUpdate = false;
+}
+
+/// Release the scene light representing this component, if any.
+void LightComponent::Detach()
+{
+	if( m_spGraphicsScene && IsValid( m_graphicsSceneLightId ) )
+	{
+		m_spGraphicsScene->ReleaseSceneLight( m_graphicsSceneLightId );
+	}
+
+	SetInvalid( m_graphicsSceneLightId );
+	m_spGraphicsScene.Release();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+static GraphicsScene *pGraphicsScene = NULL;
+
+void UpdateLightComponent(TransformComponent *pTransform, LightComponent *pLightComponent)
+{
+	pLightComponent->Update( pGraphicsScene, pTransform );
+}
+
+void UpdateLightComponents( World *pWorld )
+{
+	GraphicsManagerComponent *pGraphicsManager = pWorld->GetComponents().GetFirst<GraphicsManagerComponent>();
+	HELIUM_ASSERT( pGraphicsManager );
+
+	pGraphicsScene = pGraphicsManager->GetGraphicsScene();
+	HELIUM_ASSERT( pGraphicsScene );
+
+	QueryComponents< TransformComponent, LightComponent, UpdateLightComponent >( pWorld );
+}
+
+void Helium::UpdateLightComponentsTask::DefineContract( TaskContract &rContract )
+{
+	rContract.ExecuteBefore<StandardDependencies::Render>();
+	rContract.ExecuteAfter<StandardDependencies::ProcessPhysics>();
+}
+
+HELIUM_DEFINE_TASK( UpdateLightComponentsTask, (ForEachWorld< UpdateLightComponents >), TickTypes::Render );
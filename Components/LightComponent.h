@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Components/Components.h"
+
+#include "Components/TransformComponent.h"
+#include "Framework/ComponentDefinition.h"
+#include "Framework/TaskScheduler.h"
+#include "Graphics/GraphicsManagerComponent.h"
+
+namespace Helium
+{
+	struct LightComponentDefinition;
+
+	/// Local point or spot light placed at the position of a sibling TransformComponent.
+	///
+	/// Spot lights point along the transform's local z axis.  Lights are assigned to light clusters by the graphics
+	/// scene for each view in which they are visible, so large numbers of lights can be placed in a world.
+	class HELIUM_COMPONENTS_API LightComponent : public Component
+	{
+	public:
+		HELIUM_DECLARE_COMPONENT( Helium::LightComponent, Helium::Component );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		LightComponent();
+		LightComponent( const LightComponent& rRhs );
+		virtual ~LightComponent();
+
+		void Initialize( const Helium::LightComponentDefinition& definition );
+
+		/// @name Light Properties
+		//@{
+		void SetColor( const Color& rColor, float32_t brightness );
+		inline const Color& GetColor() const;
+		inline float32_t GetBrightness() const;
+
+		void SetRadius( float32_t radius );
+		inline float32_t GetRadius() const;
+
+		void SetSpotAngles( float32_t innerAngle, float32_t outerAngle );
+		inline float32_t GetSpotInnerAngle() const;
+		inline float32_t GetSpotOuterAngle() const;
+		//@}
+
+		void Update( GraphicsScene* pGraphicsScene, TransformComponent* pTransform );
+
+	private:
+		/// Light color.
+		Color m_Color;
+		/// Light brightness factor.
+		float32_t m_Brightness;
+		/// Distance at which the light's contribution falls off to zero.
+		float32_t m_Radius;
+		/// Half-angle of the spot cone inside which the light is at full intensity, in degrees.
+		float32_t m_SpotInnerAngle;
+		/// Half-angle of the spot cone outside which the light has no contribution, in degrees (zero for point lights).
+		float32_t m_SpotOuterAngle;
+
+		/// Graphics scene to which the light is attached.
+		GraphicsScenePtr m_spGraphicsScene;
+		/// ID of the scene light representing this component in the graphics scene.
+		size_t m_graphicsSceneLightId;
+		/// True if the light properties have changed since the scene light was last updated.
+		bool m_bNeedsUpdate;
+
+		void Detach();
+	};
+	typedef Helium::ComponentPtr<LightComponent> LightComponentPtr;
+
+	struct HELIUM_COMPONENTS_API LightComponentDefinition : public Helium::ComponentDefinitionHelper<LightComponent, LightComponentDefinition>
+	{
+	public:
+		HELIUM_DECLARE_CLASS( Helium::LightComponentDefinition, Helium::ComponentDefinition );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		LightComponentDefinition();
+
+		Color m_Color;
+		float32_t m_Brightness;
+		float32_t m_Radius;
+		/// Spot cone half-angles, in degrees.  The light is a point light if the outer angle is zero (the default).
+		float32_t m_SpotInnerAngle;
+		float32_t m_SpotOuterAngle;
+	};
+	typedef StrongPtr<LightComponentDefinition> LightComponentDefinitionPtr;
+
+	struct HELIUM_COMPONENTS_API UpdateLightComponentsTask : public TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(UpdateLightComponentsTask);
+		virtual void DefineContract(TaskContract &rContract);
+	};
+}
+
+#include "Components/LightComponent.inl"
@@ -0,0 +1,49 @@
+/// Get the light color.
+///
+/// @return  Light color.
+///
+/// @see GetBrightness(), SetColor()
+const Helium::Color& Helium::LightComponent::GetColor() const
+{
+    return m_Color;
+}
+
+/// Get the light brightness factor.
+///
+/// @return  Light brightness.
+///
+/// @see GetColor(), SetColor()
+float32_t Helium::LightComponent::GetBrightness() const
+{
+    return m_Brightness;
+}
+
+/// Get the distance at which the light's contribution falls off to zero.
+///
+/// @return  Light radius.
+///
+/// @see SetRadius()
+float32_t Helium::LightComponent::GetRadius() const
+{
+    return m_Radius;
+}
+
+/// Get the half-angle of the spot cone inside which the light is at full intensity.
+///
+/// @return  Inner spot cone angle, in degrees.
+///
+/// @see GetSpotOuterAngle(), SetSpotAngles()
+float32_t Helium::LightComponent::GetSpotInnerAngle() const
+{
+    return m_SpotInnerAngle;
+}
+
+/// Get the half-angle of the spot cone outside which the light has no contribution.
+///
+/// @return  Outer spot cone angle, in degrees (zero for point lights).
+///
+/// @see GetSpotInnerAngle(), SetSpotAngles()
+float32_t Helium::LightComponent::GetSpotOuterAngle() const
+{
+    return m_SpotOuterAngle;
+}
@@ -24,6 +24,8 @@ void MeshComponent::Initialize( const MeshComponentDefinition& definition )
 	{
 		m_Mesh = definition.m_Mesh;
 	}
+
+	m_OccluderScale = definition.m_OccluderScale;
 }
 
 void MeshComponent::Finalize( const MeshComponentDefinition& definition )
@@ -49,11 +51,26 @@ void MeshComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
 {
 	comp.AddField(&MeshComponentDefinition::m_Mesh, "m_Mesh");
 	comp.AddField(&MeshComponentDefinition::m_OverrideMaterials, "m_OverrideMaterials");
+	comp.AddField(&MeshComponentDefinition::m_OccluderScale, "m_OccluderScale");
+}
+
+MeshComponentDefinition::MeshComponentDefinition()
+	: m_OccluderScale( 0.0f )
+{
+
 }
 
 /// Constructor.
 MeshComponent::MeshComponent()
-: m_graphicsSceneObjectId( Invalid< size_t >() )
+: m_OccluderScale( 0.0f )
+, m_graphicsSceneObjectId( Invalid< size_t >() )
+, m_NeedsReattach( false )
+#if !HELIUM_USE_GRANNY_ANIMATION
+, m_pInverseReferencePose( NULL )
+, m_pBonePalette( NULL )
+, m_boneCount( 0 )
+, m_bSkinningDataChanged( false )
+#endif
 {
 }
 
@@ -139,6 +156,40 @@ void MeshComponent::SetMesh( Mesh* pMesh )
 	}
 }
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+/// Set the skinning data used to render this mesh.
+///
+/// The data is referenced, not copied, so the caller can update the palette in place each frame without needing to
+/// call this again.  The data must remain valid until it is replaced or cleared.
+///
+/// @param[in] pInverseReferencePose  Inverse mesh-space reference pose of each bone, or null to clear the skinning
+///                                   data.
+/// @param[in] pBonePalette           Mesh-space transform of each bone, or null to clear the skinning data.
+/// @param[in] boneCount              Number of bones in the skinning data.
+void MeshComponent::SetSkinningData(
+	const Simd::Matrix44* pInverseReferencePose,
+	const Simd::Matrix44* pBonePalette,
+	uint8_t boneCount )
+{
+	if( !pInverseReferencePose || !pBonePalette )
+	{
+		pInverseReferencePose = NULL;
+		pBonePalette = NULL;
+		boneCount = 0;
+	}
+
+	if( m_pInverseReferencePose != pInverseReferencePose ||
+		m_pBonePalette != pBonePalette ||
+		m_boneCount != boneCount )
+	{
+		m_pInverseReferencePose = pInverseReferencePose;
+		m_pBonePalette = pBonePalette;
+		m_boneCount = boneCount;
+		m_bSkinningDataChanged = true;
+	}
+}
+#endif
+
 /// Flag the graphics scene object as requiring an update if one exists.
 ///
 /// This is safe to call by an entity during its pre-update.  It should only ever be called by the entity itself.
@@ -218,6 +269,20 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 
 	pSceneObject->SetWorldBounds( worldBounds );
 
+	// Skinned meshes deform away from their reference pose bounds, so only static meshes are used as occluders.
+	if( pMesh && !pMesh->IsSkinned() && pThis->m_OccluderScale > 0.0f )
+	{
+		const Simd::AaBox& rMeshBounds = pMesh->GetBounds();
+		Simd::Vector3 center = ( rMeshBounds.GetMinimum() + rMeshBounds.GetMaximum() ) * Simd::Vector3( 0.5f );
+		Simd::Vector3 halfExtent =
+			( rMeshBounds.GetMaximum() - rMeshBounds.GetMinimum() ) * Simd::Vector3( 0.5f * pThis->m_OccluderScale );
+		pSceneObject->SetOccluderBox( Simd::AaBox( center - halfExtent, center + halfExtent ) );
+	}
+	else
+	{
+		pSceneObject->ClearOccluderBox();
+	}
+
 	const DynamicArray< size_t >& rSubMeshDataIds = pThis->m_graphicsSceneObjectSubMeshDataIds;
 	size_t subMeshCount = rSubMeshDataIds.GetSize();
 	size_t meshSectionCount = 0;
@@ -226,6 +291,11 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 	{
 		pSceneObject->SetVertexData( NULL, NULL, 0 );
 		pSceneObject->SetIndexBuffer( NULL );
+		pSceneObject->SetLodScreenSizes( NULL, 1 );
+#if !HELIUM_USE_GRANNY_ANIMATION
+		pSceneObject->SetBoneData( NULL, 0 );
+		pSceneObject->SetBonePalette( NULL );
+#endif
 	}
 	else
 	{
@@ -247,6 +317,16 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 		pSceneObject->SetVertexData( pVertexBuffer, pVertexDescription, vertexStride );
 		pSceneObject->SetIndexBuffer( pIndexBuffer );
 
+		uint8_t lodCount = static_cast< uint8_t >( pMesh->GetLodCount() );
+		pSceneObject->SetLodScreenSizes( pMesh->GetLodScreenSizes(), lodCount );
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+		bool bAnimated =
+			pMesh->IsSkinned() && pThis->m_pBonePalette && pThis->m_boneCount == pMesh->GetBoneCount();
+		pSceneObject->SetBoneData( bAnimated ? pThis->m_pInverseReferencePose : NULL, bAnimated ? pThis->m_boneCount : 0 );
+		pSceneObject->SetBonePalette( bAnimated ? pThis->m_pBonePalette : NULL );
+#endif
+
 		meshSectionCount = pMesh->GetSectionCount();
 		if( meshSectionCount > subMeshCount )
 		{
@@ -270,6 +350,14 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 			pSubMeshData->SetStartVertex( sectionVertexOffset );
 			pSubMeshData->SetVertexRange( vertexCount );
 			pSubMeshData->SetStartIndex( sectionIndexOffset );
+			pSubMeshData->SetLodData(
+				pMesh->GetSectionLodStartIndices( meshSectionIndex ),
+				pMesh->GetSectionLodTriangleCounts( meshSectionIndex ),
+				lodCount );
+#if !HELIUM_USE_GRANNY_ANIMATION
+			pSubMeshData->SetSkinningPaletteMap(
+				pMesh->IsSkinned() ? pMesh->GetSectionSkinningPaletteMap( meshSectionIndex ) : NULL );
+#endif
 
 			sectionVertexOffset += vertexCount;
 			sectionIndexOffset += triangleCount * 3;
@@ -288,6 +376,10 @@ void MeshComponent::GraphicsSceneObjectUpdate(
 		pSubMeshData->SetStartVertex( 0 );
 		pSubMeshData->SetVertexRange( 0 );
 		pSubMeshData->SetStartIndex( 0 );
+		pSubMeshData->SetLodData( NULL, NULL, 1 );
+#if !HELIUM_USE_GRANNY_ANIMATION
+		pSubMeshData->SetSkinningPaletteMap( NULL );
+#endif
 	}
 }
 
@@ -297,7 +389,18 @@ void Helium::MeshComponent::Update( GraphicsScene *pGraphicsScene, TransformComp
 	{
 		Detach(pGraphicsScene);
 		Attach(pGraphicsScene, pTransform);
+		m_NeedsReattach = false;
+#if !HELIUM_USE_GRANNY_ANIMATION
+		m_bSkinningDataChanged = false;
+#endif
+	}
+#if !HELIUM_USE_GRANNY_ANIMATION
+	else if (m_bSkinningDataChanged)
+	{
+		SetNeedsGraphicsSceneObjectUpdate( pTransform, GraphicsSceneObject::UPDATE_FULL );
+		m_bSkinningDataChanged = false;
 	}
+#endif
 
 	if (pTransform->IsDirty())
 	{
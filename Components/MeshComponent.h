@@ -46,6 +46,14 @@ namespace Helium
 		inline Material* GetMaterial( size_t index ) const;
 		//@}
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+		/// @name Skinning
+		//@{
+		void SetSkinningData(
+			const Simd::Matrix44* pInverseReferencePose, const Simd::Matrix44* pBonePalette, uint8_t boneCount );
+		//@}
+#endif
+
 		void Update( class GraphicsScene *pGraphicsScene, class TransformComponent *pTransform );
 		
 		/// @name Scene GameObject Synchronization Callback
@@ -63,6 +71,8 @@ namespace Helium
 		StrongPtr< Mesh > m_Mesh;
 		/// Override material set.
 		DynamicArray< MaterialPtr > m_OverrideMaterials;
+		/// Scale applied to the mesh bounds about their center to produce the occluder box (zero if not an occluder).
+		float32_t m_OccluderScale;
 
 		/// ID of the scene object representing this entity in the graphics scene.
 		size_t m_graphicsSceneObjectId;
@@ -73,6 +83,17 @@ namespace Helium
 
 		bool m_NeedsReattach;
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+		/// Inverse mesh-space reference pose of each bone (null if this mesh is not animated).
+		const Simd::Matrix44* m_pInverseReferencePose;
+		/// Current bone palette (null if this mesh is not animated).
+		const Simd::Matrix44* m_pBonePalette;
+		/// Number of bones in the skinning data.
+		uint8_t m_boneCount;
+		/// True if the skinning data has changed since the graphics scene object was last fully updated.
+		bool m_bSkinningDataChanged;
+#endif
+
 		/// @name Graphics Scene GameObject Updating
 		//@{
 		void SetNeedsGraphicsSceneObjectUpdate(
@@ -89,9 +110,15 @@ namespace Helium
 	public:
 		HELIUM_DECLARE_CLASS( Helium::MeshComponentDefinition, Helium::ComponentDefinition );
 		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		MeshComponentDefinition();
 				
 		StrongPtr<Mesh> m_Mesh;
 		DynamicArray< MaterialPtr > m_OverrideMaterials;
+		/// Scale applied to the mesh bounds about their center to produce a box lying entirely within the solid mesh
+		/// geometry, used to hide other objects during occlusion culling.  Zero (the default) if the mesh should not
+		/// occlude other objects.
+		float32_t m_OccluderScale;
 	};
 	typedef StrongPtr<MeshComponentDefinition> MeshComponentDefinitionPtr;
 	
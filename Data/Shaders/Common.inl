@@ -13,6 +13,47 @@
 /// Dev/Engine/Include/GraphicsTypes/VertexTypes.h).
 #define BONE_COUNT_MAX 75
 
+/// Maximum number of directional light shadow cascades (must match GraphicsConfig::SHADOW_CASCADE_COUNT_MAX in
+/// Dev/Engine/Include/Graphics/GraphicsConfig.h).
+#define SHADOW_CASCADE_COUNT_MAX 4
+
+/// Number of light clusters along each axis (must match the cluster counts in Dev/Engine/Include/Graphics/
+/// LightClusterGrid.h).
+#define LIGHT_CLUSTER_COUNT_X 16
+#define LIGHT_CLUSTER_COUNT_Y 8
+#define LIGHT_CLUSTER_COUNT_Z 16
+
+/// Light cluster lookup texture dimensions (must match the texture sizes used in GraphicsScene.cpp).
+#define LIGHT_CLUSTER_TEXTURE_WIDTH 256
+#define LIGHT_CLUSTER_TEXTURE_HEIGHT 8
+#define LIGHT_INDEX_TEXTURE_WIDTH 256
+#define LIGHT_INDEX_TEXTURE_HEIGHT 64
+#define LIGHT_DATA_TEXTURE_WIDTH 256
+#define LIGHT_DATA_TEXTURE_HEIGHT 4
+
+/// Value stored at glyph edges in signed distance field font texture sheets (must match the edge value written by
+/// FontResourceHandler).
+#define DISTANCE_FIELD_EDGE ( 128.0f / 255.0f )
+/// Change in signed distance field values across one texel at the cached font size (the full value range covers
+/// 2 * Font::PersistentResourceData::m_distanceFieldSpread texels).
+#define DISTANCE_FIELD_TEXEL_DELTA ( 1.0f / 8.0f )
+
+/// Compute glyph coverage from a signed distance field font texture sample.
+///
+/// The edge is smoothed over roughly one screen pixel based on how quickly the distance changes across the pixel,
+/// which keeps glyph edges sharp at any scale.  Shader model 2 has no screen-space derivatives, so it assumes the text
+/// is drawn at its cached size.
+float DistanceFieldCoverage( float distance )
+{
+#if HELIUM_PROFILE_PC_SM2
+    float edgeWidth = 0.5f * DISTANCE_FIELD_TEXEL_DELTA;
+#else
+    float edgeWidth = max( 0.5f * fwidth( distance ), 1.0f / 255.0f );
+#endif
+
+    return smoothstep( DISTANCE_FIELD_EDGE - edgeWidth, DISTANCE_FIELD_EDGE + edgeWidth, distance );
+}
+
 /// Per-view vertex shader constant data for all passes.
 struct ViewVertexConstantGlobalData
 {
@@ -25,7 +66,8 @@ struct ViewVertexConstantGlobalData
 /// Per-view vertex shader constant data for base-pass rendering.
 struct ViewVertexConstantBasePassData
 {
-    /// Directional light shadow inverse view/projection matrix, with offsetting to map to UV space.
+    /// Directional light shadow inverse view/projection matrix, with offsetting to map to the first shadow cascade's
+    /// normalized [0, 1] coordinate space.
     matrix shadowInverseViewProjection;
 
     /// Directional light direction (pre-transformed to view space).
@@ -48,8 +90,25 @@ struct ViewPixelConstantBasePassData
     /// Directional light color.
     float4 directionalLightColor;
 
-    /// Inverse shadow map resolution (z & w components are unused).
+    /// x & y: Inverse shadow map resolution
+    /// z: Minimum normalized cascade coordinate used before falling back to the next cascade
+    /// w: Maximum normalized cascade coordinate used before falling back to the next cascade
     float4 inverseShadowMapResolution;
+
+    /// Scale (x & y) and offset (z & w) mapping the first shadow cascade's normalized coordinates to each cascade's
+    /// normalized coordinates.
+    float4 shadowCascadeScaleOffset[ SHADOW_CASCADE_COUNT_MAX ];
+    /// Scale (x & y) and offset (z & w) mapping each shadow cascade's normalized coordinates to its tile within the
+    /// shadow map.
+    float4 shadowCascadeTileScaleOffset[ SHADOW_CASCADE_COUNT_MAX ];
+
+    /// x & y: Horizontal and vertical projection scales
+    /// z & w: Scale and offset applied to the view depth to compute the clip-space w coordinate
+    float4 lightClusterProjection;
+    /// x: Scale applied to the base-2 logarithm of the view depth to compute the light cluster depth slice
+    /// y: Bias added to the scaled logarithm of the view depth to compute the light cluster depth slice
+    /// z & w: Unused
+    float4 lightClusterSlices;
 };
 
 /// Per-instance vertex shader constant data for all passes.
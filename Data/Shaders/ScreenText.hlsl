@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------------------------------------------------
 
 //! @systoggle_v PROJECT
+//! @systoggle_p DISTANCE_FIELD
 
 #include "Common.inl"
 
@@ -68,7 +69,11 @@ Texture2D DiffuseMap;
 float4 main( VertexOutput vOut ) : SV_Target
 {
     float4 color = vOut.color;
+#if DISTANCE_FIELD
+    color.a *= DistanceFieldCoverage( DiffuseMap.Sample( DefaultSamplerState, vOut.texCoord.xy ).r );
+#else
     color.a *= DiffuseMap.Sample( DefaultSamplerState, vOut.texCoord.xy ).r;
+#endif
 
     return color;
 }
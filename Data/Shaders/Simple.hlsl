@@ -5,7 +5,7 @@
 // All Rights Reserved
 //----------------------------------------------------------------------------------------------------------------------
 
-//! @sysselect TEXTURING NONE TEXTURING_BLEND TEXTURING_ALPHA
+//! @sysselect TEXTURING NONE TEXTURING_BLEND TEXTURING_ALPHA TEXTURING_DISTANCE_FIELD
 //! @systoggle_v POINT_SPRITE
 
 #include "Common.inl"
@@ -78,6 +78,8 @@ float4 main( VertexOutput vOut ) : SV_Target
     color *= DiffuseMap.Sample( DefaultSamplerState, vOut.texCoord.xy );
 #elif TEXTURING_ALPHA
     color.a *= DiffuseMap.Sample( DefaultSamplerState, vOut.texCoord.xy ).r;
+#elif TEXTURING_DISTANCE_FIELD
+    color.a *= DistanceFieldCoverage( DiffuseMap.Sample( DefaultSamplerState, vOut.texCoord.xy ).r );
 #endif
 
     return color;
@@ -10,6 +10,7 @@
 //! @select SPECULAR NONE SPECULAR_DIFFUSE_ALPHA SPECULAR_MAP
 //! @sysselect_v SKINNING NONE SKINNING_SMOOTH SKINNING_RIGID
 //! @sysselect SHADOWS NONE SHADOWS_SIMPLE SHADOWS_PCF_DITHERED
+//! @sysselect LOCAL_LIGHTS NONE LOCAL_LIGHTS_CLUSTERED
 
 #include "Common.inl"
 
@@ -32,6 +33,13 @@ struct VertexOutput
 #if SHADOWS_PCF_DITHERED
     float3 screenPos          : TEXCOORD5;
 #endif
+
+#if LOCAL_LIGHTS_CLUSTERED
+    // View-space tangent frame, with the view-space position packed into the w components.
+    float4 viewTangent        : TEXCOORD6;
+    float4 viewBinormal       : TEXCOORD7;
+    float4 viewNormal         : TEXCOORD8;
+#endif
 };
 
 #if HELIUM_TYPE_VERTEX
@@ -118,6 +126,13 @@ float4 main( VertexInput vIn, out VertexOutput vOut ) : POSITION
     vOut.toEye = half3( normalize( -mul( worldInvView, localPosition ).xyz ) );
 #endif
 
+#if LOCAL_LIGHTS_CLUSTERED
+    float3 viewPosition = mul( worldInvView, localPosition ).xyz;
+    vOut.viewTangent = float4( tangent, viewPosition.x );
+    vOut.viewBinormal = float4( binormal, viewPosition.y );
+    vOut.viewNormal = float4( normal, viewPosition.z );
+#endif
+
     matrix worldInvViewProjection = mul( ViewGlobalData.inverseViewProjection, worldMatrix );
     
     float4 outPosition = mul( worldInvViewProjection, localPosition );
@@ -179,6 +194,48 @@ sampler _ShadowMap = sampler_state
 #endif  // HELIUM_PROFILE_PC_SM4
 #endif  // SHADOWS
 
+#if LOCAL_LIGHTS_CLUSTERED
+// Light cluster offsets and counts, light index lists, and light data (see GraphicsScene::UpdateLightClusters()).
+#if HELIUM_PROFILE_PC_SM4
+Texture2D _LightClusters;
+Texture2D _LightIndices;
+Texture2D _LightData;
+#else  // HELIUM_PROFILE_PC_SM4
+Texture2D _LightClustersTexture;
+sampler _LightClusters = sampler_state
+{
+	Texture = <_LightClustersTexture>;
+	MipFilter = POINT;
+	MinFilter = POINT;
+	MagFilter = POINT;
+	AddressU = CLAMP;
+	AddressV = CLAMP;
+};
+
+Texture2D _LightIndicesTexture;
+sampler _LightIndices = sampler_state
+{
+	Texture = <_LightIndicesTexture>;
+	MipFilter = POINT;
+	MinFilter = POINT;
+	MagFilter = POINT;
+	AddressU = CLAMP;
+	AddressV = CLAMP;
+};
+
+Texture2D _LightDataTexture;
+sampler _LightData = sampler_state
+{
+	Texture = <_LightDataTexture>;
+	MipFilter = POINT;
+	MinFilter = POINT;
+	MagFilter = POINT;
+	AddressU = CLAMP;
+	AddressV = CLAMP;
+};
+#endif  // HELIUM_PROFILE_PC_SM4
+#endif  // LOCAL_LIGHTS_CLUSTERED
+
 cbuffer ViewPassData
 {
     ViewPixelConstantBasePassData ViewPassData : register( c0 );
@@ -187,11 +244,11 @@ cbuffer ViewPassData
 cbuffer MaterialParameters
 {
 #if NORMAL_MAP
-    float NormalMapHeightScale : register( c4 );
+    float NormalMapHeightScale : register( c14 );
 #endif
 
 #if SPECULAR
-    float SpecularExponent : register( c5 );
+    float SpecularExponent : register( c15 );
 #endif
 }
 
@@ -203,6 +260,53 @@ static const float4 PCF_BASE_KERNEL[] =
 };
 #endif
 
+#if LOCAL_LIGHTS_CLUSTERED
+/// Load a texel from the light cluster texture.
+///
+/// @param[in] texel  Integer texel coordinates.
+///
+/// @return  Texel value.
+float4 LoadLightClusterTexel( float2 texel )
+{
+#if HELIUM_PROFILE_PC_SM4
+	return _LightClusters.Load( int3( texel, 0 ) );
+#else
+	float2 texCoord = ( texel + 0.5 ) / float2( LIGHT_CLUSTER_TEXTURE_WIDTH, LIGHT_CLUSTER_TEXTURE_HEIGHT );
+	return tex2Dlod( _LightClusters, float4( texCoord, 0, 0 ) );
+#endif
+}
+
+/// Load a texel from the light index texture.
+///
+/// @param[in] texel  Integer texel coordinates.
+///
+/// @return  Texel value.
+float4 LoadLightIndexTexel( float2 texel )
+{
+#if HELIUM_PROFILE_PC_SM4
+	return _LightIndices.Load( int3( texel, 0 ) );
+#else
+	float2 texCoord = ( texel + 0.5 ) / float2( LIGHT_INDEX_TEXTURE_WIDTH, LIGHT_INDEX_TEXTURE_HEIGHT );
+	return tex2Dlod( _LightIndices, float4( texCoord, 0, 0 ) );
+#endif
+}
+
+/// Load a texel from the light data texture.
+///
+/// @param[in] texel  Integer texel coordinates.
+///
+/// @return  Texel value.
+float4 LoadLightDataTexel( float2 texel )
+{
+#if HELIUM_PROFILE_PC_SM4
+	return _LightData.Load( int3( texel, 0 ) );
+#else
+	float2 texCoord = ( texel + 0.5 ) / float2( LIGHT_DATA_TEXTURE_WIDTH, LIGHT_DATA_TEXTURE_HEIGHT );
+	return tex2Dlod( _LightData, float4( texCoord, 0, 0 ) );
+#endif
+}
+#endif  // LOCAL_LIGHTS_CLUSTERED
+
 float4 main( VertexOutput vOut ) : SV_Target
 {
     half2 texCoord0 = half2( vOut.texCoord0.xy );
@@ -230,11 +334,35 @@ float4 main( VertexOutput vOut ) : SV_Target
         ambientBlend ) );
 
 	half shadow = 1.0;
+#if SHADOWS
+	// Select the finest cascade covering this pixel (leaving a border so that filtering does not sample neighboring
+	// cascade tiles), and compute the coordinates within its tile of the shadow map.
+	float3 shadowPos = float3( -1, -1, vOut.shadowPos.z );
+	float shadowCascadeFound = 0;
+
+	[unroll]
+	for( int cascadeIndex = SHADOW_CASCADE_COUNT_MAX - 1; cascadeIndex >= 0; --cascadeIndex )
+	{
+		float4 cascadeScaleOffset = ViewPassData.shadowCascadeScaleOffset[ cascadeIndex ];
+		float4 cascadeTileScaleOffset = ViewPassData.shadowCascadeTileScaleOffset[ cascadeIndex ];
+
+		float2 cascadePos = vOut.shadowPos.xy * cascadeScaleOffset.xy + cascadeScaleOffset.zw;
+		float2 cascadeInRange =
+			step( ViewPassData.inverseShadowMapResolution.zz, cascadePos ) *
+			step( cascadePos, ViewPassData.inverseShadowMapResolution.ww );
+		float cascadeSelect = cascadeInRange.x * cascadeInRange.y;
+
+		float2 cascadeTilePos = cascadePos * cascadeTileScaleOffset.xy + cascadeTileScaleOffset.zw;
+		shadowPos.xy = lerp( shadowPos.xy, cascadeTilePos, cascadeSelect );
+		shadowCascadeFound = max( shadowCascadeFound, cascadeSelect );
+	}
+#endif
+
 #if SHADOWS_SIMPLE
 #if HELIUM_PROFILE_PC_SM4
-	shadow = half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, vOut.shadowPos.xy, vOut.shadowPos.z ) );
+	shadow = half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, shadowPos.xy, shadowPos.z ) );
 #else
-	shadow = half( tex2Dproj( _ShadowMap, half4( vOut.shadowPos.xyz, 1 ) ).r );
+	shadow = half( tex2Dproj( _ShadowMap, half4( shadowPos.xyz, 1 ) ).r );
 #endif
 #elif SHADOWS_PCF_DITHERED
 	float2 screenPos = vOut.screenPos.xy / vOut.screenPos.z;
@@ -253,20 +381,25 @@ float4 main( VertexOutput vOut ) : SV_Target
 
 #if HELIUM_PROFILE_PC_SM4
 	half4 shadowComponents = half4(
-		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, vOut.shadowPos.xy + pcfOffsets[ 0 ].xy, vOut.shadowPos.z ) ),
-		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, vOut.shadowPos.xy + pcfOffsets[ 0 ].zw, vOut.shadowPos.z ) ),
-		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, vOut.shadowPos.xy + pcfOffsets[ 1 ].xy, vOut.shadowPos.z ) ),
-		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, vOut.shadowPos.xy + pcfOffsets[ 1 ].zw, vOut.shadowPos.z ) ) );
+		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, shadowPos.xy + pcfOffsets[ 0 ].xy, shadowPos.z ) ),
+		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, shadowPos.xy + pcfOffsets[ 0 ].zw, shadowPos.z ) ),
+		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, shadowPos.xy + pcfOffsets[ 1 ].xy, shadowPos.z ) ),
+		half( _ShadowMap.SampleCmpLevelZero( ShadowSamplerState, shadowPos.xy + pcfOffsets[ 1 ].zw, shadowPos.z ) ) );
 #else
 	half4 shadowComponents = half4(
-		half( tex2Dproj( _ShadowMap, half4( vOut.shadowPos.xy + pcfOffsets[ 0 ].xy, vOut.shadowPos.z, 1 ) ).r ),
-		half( tex2Dproj( _ShadowMap, half4( vOut.shadowPos.xy + pcfOffsets[ 0 ].zw, vOut.shadowPos.z, 1 ) ).r ),
-		half( tex2Dproj( _ShadowMap, half4( vOut.shadowPos.xy + pcfOffsets[ 1 ].xy, vOut.shadowPos.z, 1 ) ).r ),
-		half( tex2Dproj( _ShadowMap, half4( vOut.shadowPos.xy + pcfOffsets[ 1 ].zw, vOut.shadowPos.z, 1 ) ).r ) );
+		half( tex2Dproj( _ShadowMap, half4( shadowPos.xy + pcfOffsets[ 0 ].xy, shadowPos.z, 1 ) ).r ),
+		half( tex2Dproj( _ShadowMap, half4( shadowPos.xy + pcfOffsets[ 0 ].zw, shadowPos.z, 1 ) ).r ),
+		half( tex2Dproj( _ShadowMap, half4( shadowPos.xy + pcfOffsets[ 1 ].xy, shadowPos.z, 1 ) ).r ),
+		half( tex2Dproj( _ShadowMap, half4( shadowPos.xy + pcfOffsets[ 1 ].zw, shadowPos.z, 1 ) ).r ) );
 #endif
 	shadow = dot( shadowComponents, half4( 0.25, 0.25, 0.25, 0.25 ) );
 #endif
 
+#if SHADOWS
+	// Pixels outside of all cascades (beyond the shadow cutoff distance) are left unshadowed.
+	shadow = half( lerp( 1.0, shadow, shadowCascadeFound ) );
+#endif
+
     half3 toDirectionalLight = half3( normalize( vOut.toDirectionalLight ) );
     half3 directionalLightColor = half3( ViewPassData.directionalLightColor.rgb );
     diffuse += directionalLightColor * half( saturate( dot( normal, toDirectionalLight ) ) ) * shadow;
@@ -292,6 +425,73 @@ float4 main( VertexOutput vOut ) : SV_Target
     color.rgb += specular * specularSample;
 #endif
 
+#if LOCAL_LIGHTS_CLUSTERED
+	// Find the light cluster containing this pixel.
+	float3 viewPosition = float3( vOut.viewTangent.w, vOut.viewBinormal.w, vOut.viewNormal.w );
+	float4 clusterProjection = ViewPassData.lightClusterProjection;
+	float clipW = viewPosition.z * clusterProjection.z + clusterProjection.w;
+	float2 ndc = viewPosition.xy * clusterProjection.xy / clipW;
+
+	float2 clusterTile = clamp(
+		floor( ( ndc * 0.5 + 0.5 ) * float2( LIGHT_CLUSTER_COUNT_X, LIGHT_CLUSTER_COUNT_Y ) ),
+		float2( 0, 0 ),
+		float2( LIGHT_CLUSTER_COUNT_X - 1, LIGHT_CLUSTER_COUNT_Y - 1 ) );
+	float clusterSlice = clamp(
+		floor( log2( max( viewPosition.z, 1e-4 ) ) * ViewPassData.lightClusterSlices.x +
+			ViewPassData.lightClusterSlices.y ),
+		0,
+		LIGHT_CLUSTER_COUNT_Z - 1 );
+
+	float4 cluster = round( LoadLightClusterTexel(
+		float2( clusterTile.x + clusterSlice * LIGHT_CLUSTER_COUNT_X, clusterTile.y ) ) * 255 );
+	float clusterOffset = cluster.r + cluster.g * 256;
+	float clusterLightCount = cluster.b;
+
+	// Accumulate the contribution of each light in the cluster in view space.
+	half3 localNormal = half3( normalize(
+		vOut.viewTangent.xyz * normal.x + vOut.viewBinormal.xyz * normal.y + vOut.viewNormal.xyz * normal.z ) );
+	half3 localDiffuse = half3( 0, 0, 0 );
+#if SPECULAR
+	half3 localToEye = half3( normalize( -viewPosition ) );
+	half3 localSpecular = half3( 0, 0, 0 );
+#endif
+
+	[loop]
+	for( float lightEntry = 0; lightEntry < clusterLightCount; ++lightEntry )
+	{
+		float indexPosition = clusterOffset + lightEntry;
+		float2 indexTexel = float2(
+			fmod( indexPosition, LIGHT_INDEX_TEXTURE_WIDTH ),
+			floor( indexPosition / LIGHT_INDEX_TEXTURE_WIDTH ) );
+		float lightIndex = round( LoadLightIndexTexel( indexTexel ).r * 255 );
+
+		float4 lightPositionInvRadiusSq = LoadLightDataTexel( float2( lightIndex, 0 ) );
+		float4 lightColorSpotOffset = LoadLightDataTexel( float2( lightIndex, 1 ) );
+		float4 lightDirectionSpotScale = LoadLightDataTexel( float2( lightIndex, 2 ) );
+
+		float3 toLight = lightPositionInvRadiusSq.xyz - viewPosition;
+		float distanceSq = dot( toLight, toLight );
+		half3 toLightDirection = half3( toLight * rsqrt( max( distanceSq, 1e-6 ) ) );
+
+		float falloff = saturate( 1 - distanceSq * lightPositionInvRadiusSq.w );
+		float spot = saturate(
+			dot( -toLightDirection, lightDirectionSpotScale.xyz ) * lightDirectionSpotScale.w +
+			lightColorSpotOffset.w );
+		half3 lightColor = half3( lightColorSpotOffset.rgb * ( falloff * falloff * spot ) );
+
+		localDiffuse += lightColor * half( saturate( dot( localNormal, toLightDirection ) ) );
+#if SPECULAR
+		localSpecular += lightColor *
+			half( pow( saturate( dot( localToEye, reflect( -toLightDirection, localNormal ) ) ), specularExponent ) );
+#endif
+	}
+
+	color.rgb += localDiffuse * diffuseSample.rgb;
+#if SPECULAR
+	color.rgb += localSpecular * specularSample;
+#endif
+#endif  // LOCAL_LIGHTS_CLUSTERED
+
     return float4( color );
 }
 
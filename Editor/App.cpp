@@ -59,6 +59,19 @@
 #include "Editor/Dialogs/PerforceWaitDialog.h"
 #include "Editor/Vault/VaultSettings.h"
 
+#include "Editor/Commands/CookCommand.h"
+#include "Editor/Commands/AssetPathBenchmarkCommand.h"
+#include "Editor/Commands/PickBenchmarkCommand.h"
+#include "Editor/Commands/TextureCompressionCheckCommand.h"
+#include "Editor/Commands/FontBenchmarkCommand.h"
+#include "Editor/Commands/ImageConversionCheckCommand.h"
+#include "Editor/Commands/AnimationBenchmarkCommand.h"
+#include "Editor/Commands/LightClusterBenchmarkCommand.h"
+#include "Editor/Commands/ShaderOptionBenchmarkCommand.h"
+#include "Editor/Commands/AssetLookupBenchmarkCommand.h"
+#include "Editor/Commands/StateMachineBenchmarkCommand.h"
+#include "Editor/Commands/UndoQueueBenchmarkCommand.h"
+#include "Editor/Commands/TransformUndoCheckCommand.h"
 #include "Editor/Commands/ProfileDumpCommand.h"
 
 #include "Editor/Clipboard/ClipboardDataWrapper.h"
@@ -628,6 +641,44 @@ int Main( int argc, const char** argv )
 	success &= profileDumpCommand.Initialize( error );
 	success &= processor.RegisterCommand( &profileDumpCommand, error );
 
+	CookCommand cookCommand;
+	success &= cookCommand.Initialize( error );
+	success &= processor.RegisterCommand( &cookCommand, error );
+
+	AssetPathBenchmarkCommand assetPathBenchmarkCommand;
+	PickBenchmarkCommand pickBenchmarkCommand;
+	TextureCompressionCheckCommand textureCompressionCheckCommand;
+	FontBenchmarkCommand fontBenchmarkCommand;
+	ImageConversionCheckCommand imageConversionCheckCommand;
+	AnimationBenchmarkCommand animationBenchmarkCommand;
+	LightClusterBenchmarkCommand lightClusterBenchmarkCommand;
+	ShaderOptionBenchmarkCommand shaderOptionBenchmarkCommand;
+	AssetLookupBenchmarkCommand assetLookupBenchmarkCommand;
+	StateMachineBenchmarkCommand stateMachineBenchmarkCommand;
+	UndoQueueBenchmarkCommand undoQueueBenchmarkCommand;
+	TransformUndoCheckCommand transformUndoCheckCommand;
+
+	Helium::CommandLine::Command* benchmarkCommands[] =
+	{
+		&assetPathBenchmarkCommand,
+		&pickBenchmarkCommand,
+		&textureCompressionCheckCommand,
+		&fontBenchmarkCommand,
+		&imageConversionCheckCommand,
+		&animationBenchmarkCommand,
+		&lightClusterBenchmarkCommand,
+		&shaderOptionBenchmarkCommand,
+		&assetLookupBenchmarkCommand,
+		&stateMachineBenchmarkCommand,
+		&undoQueueBenchmarkCommand,
+		&transformUndoCheckCommand,
+	};
+	for ( size_t commandIndex = 0; commandIndex < HELIUM_ARRAY_COUNT( benchmarkCommands ); ++commandIndex )
+	{
+		success &= benchmarkCommands[ commandIndex ]->Initialize( error );
+		success &= processor.RegisterCommand( benchmarkCommands[ commandIndex ], error );
+	}
+
 	Helium::CommandLine::HelpCommand helpCommand;
 	helpCommand.SetOwner( &processor );
 	success &= helpCommand.Initialize( error );
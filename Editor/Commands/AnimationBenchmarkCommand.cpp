@@ -0,0 +1,237 @@
+#include "EditorPch.h"
+#include "AnimationBenchmarkCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Platform/Timer.h"
+
+#include "Foundation/Log.h"
+
+#include "Application/InitializerStack.h"
+
+#include "Engine/WorkerPool.h"
+
+#include "Graphics/AnimatedSkeleton.h"
+#include "Graphics/AnimationEvaluator.h"
+
+#include <math.h>
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+
+namespace
+{
+	const float32_t BENCHMARK_SAMPLES_PER_SECOND = 30.0f;
+	const uint32_t BENCHMARK_SAMPLE_COUNT = 61;
+	const float32_t BENCHMARK_FRAME_SECONDS = 1.0f / 60.0f;
+
+	// Build a clip that swings every bone around the given axis, with a per-bone phase offset so that neighboring bones
+	// do not move in lockstep.
+	void BuildBenchmarkClip(
+		Animation::PersistentResourceData& rClip,
+		const DynamicArray< Name >& rBoneNames,
+		float32_t axisX,
+		float32_t axisY,
+		float32_t axisZ,
+		float32_t amplitude )
+	{
+		size_t boneCount = rBoneNames.GetSize();
+
+		rClip.m_sampleCount = BENCHMARK_SAMPLE_COUNT;
+		rClip.m_samplesPerSecond = BENCHMARK_SAMPLES_PER_SECOND;
+		rClip.m_trackNames = rBoneNames;
+
+		rClip.m_keys.Resize( 0 );
+		rClip.m_keys.Reserve( BENCHMARK_SAMPLE_COUNT * boneCount * Animation::KEY_VALUE_COUNT );
+
+		for ( uint32_t sampleIndex = 0; sampleIndex < BENCHMARK_SAMPLE_COUNT; ++sampleIndex )
+		{
+			float32_t phase = static_cast< float32_t >( sampleIndex ) / static_cast< float32_t >( BENCHMARK_SAMPLE_COUNT - 1 );
+
+			for ( size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+			{
+				float32_t angle = amplitude * sinf( 6.2831853f * phase + 0.37f * static_cast< float32_t >( boneIndex ) );
+				float32_t halfSin = sinf( 0.5f * angle );
+				float32_t halfCos = cosf( 0.5f * angle );
+
+				// Translation.
+				rClip.m_keys.Push( 0.0f );
+				rClip.m_keys.Push( 1.0f );
+				rClip.m_keys.Push( 0.0f );
+
+				// Rotation (x, y, z, w).
+				rClip.m_keys.Push( axisX * halfSin );
+				rClip.m_keys.Push( axisY * halfSin );
+				rClip.m_keys.Push( axisZ * halfSin );
+				rClip.m_keys.Push( halfCos );
+
+				// Scale.
+				rClip.m_keys.Push( 1.0f );
+				rClip.m_keys.Push( 1.0f );
+				rClip.m_keys.Push( 1.0f );
+			}
+		}
+	}
+}
+
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
+
+AnimationBenchmarkCommand::AnimationBenchmarkCommand()
+	: Command( TXT( "animbench" ), TXT( "" ), TXT( "Evaluate thousands of animated skeletons without a window or renderer and report the evaluation throughput" ) )
+{
+
+}
+
+bool AnimationBenchmarkCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_SkeletonCount, TXT( "s|skeletons" ), TXT( "<COUNT>" ), TXT( "number of skeletons to animate (defaults to 4096)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_BoneCount, TXT( "b|bones" ), TXT( "<COUNT>" ), TXT( "number of bones per skeleton (defaults to 64)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_FrameCount, TXT( "f|frames" ), TXT( "<COUNT>" ), TXT( "number of frames to evaluate (defaults to 300)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_JobCount, TXT( "j|jobs" ), TXT( "<COUNT>" ), TXT( "number of evaluation threads (defaults to the number of processors)" ) ), error );
+	return success;
+}
+
+bool AnimationBenchmarkCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+#if HELIUM_USE_GRANNY_ANIMATION
+	error = TXT( "The animation benchmark requires the built-in animation system." );
+	return false;
+#else
+	int skeletonCount, boneCount, frameCount, jobCount;
+	int processorCount = static_cast< int >( WorkerPool::GetProcessorCount() );
+	if ( !ParseCountOption( m_SkeletonCount, TXT( "skeleton count" ), 4096, 1, 1 << 20, skeletonCount, error ) ||
+		!ParseCountOption( m_BoneCount, TXT( "bone count" ), 64, 1, 255, boneCount, error ) ||
+		!ParseCountOption( m_FrameCount, TXT( "frame count" ), 300, 1, 1 << 20, frameCount, error ) ||
+		!ParseCountOption( m_JobCount, TXT( "job count" ), Max( processorCount, 1 ), 1, 256, jobCount, error ) )
+	{
+		return false;
+	}
+
+	InitializerStack initializerStack;
+	initializerStack.Push( Name::Shutdown );
+
+	// Build a balanced bone tree with a unit offset between each bone and its parent.
+	DynamicArray< Name > boneNames;
+	DynamicArray< uint8_t > parentBoneIndices;
+	DynamicArray< Simd::Matrix44 > referencePose;
+	boneNames.Reserve( boneCount );
+	parentBoneIndices.Reserve( boneCount );
+	referencePose.Reserve( boneCount );
+
+	for ( int boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+	{
+		char boneName[ 32 ];
+		StringPrint( boneName, TXT( "bone%d" ), boneIndex );
+		boneNames.Push( Name( boneName ) );
+
+		parentBoneIndices.Push( boneIndex == 0 ? Invalid< uint8_t >() : static_cast< uint8_t >( ( boneIndex - 1 ) / 2 ) );
+
+		Simd::Matrix44 boneTransform( Simd::Matrix44::IDENTITY );
+		if ( boneIndex != 0 )
+		{
+			boneTransform.SetElement( 13, 1.0f );
+		}
+		referencePose.Push( boneTransform );
+	}
+
+	// Two clips blended on separate layers, so that every bone goes through the full blend path.
+	Animation::PersistentResourceData swingClip;
+	Animation::PersistentResourceData twistClip;
+	BuildBenchmarkClip( swingClip, boneNames, 1.0f, 0.0f, 0.0f, 0.6f );
+	BuildBenchmarkClip( twistClip, boneNames, 0.0f, 1.0f, 0.0f, 0.4f );
+
+	DynamicArray< AnimatedSkeleton* > skeletons;
+	skeletons.Reserve( skeletonCount );
+	for ( int skeletonIndex = 0; skeletonIndex < skeletonCount; ++skeletonIndex )
+	{
+		AnimatedSkeleton* pSkeleton = new AnimatedSkeleton;
+		HELIUM_ASSERT( pSkeleton );
+		pSkeleton->Initialize(
+			static_cast< uint8_t >( boneCount ),
+			boneNames.GetData(),
+			parentBoneIndices.GetData(),
+			referencePose.GetData() );
+
+		// Stagger the playback of each skeleton so they do not all sample the same keys.
+		float32_t startTime = static_cast< float32_t >( skeletonIndex % 97 ) * 0.021f;
+		pSkeleton->SetLayerClip( 0, &swingClip );
+		pSkeleton->SetLayerTime( 0, startTime );
+		pSkeleton->SetLayerWeight( 0, 0.7f );
+		pSkeleton->SetLayerClip( 1, &twistClip );
+		pSkeleton->SetLayerTime( 1, startTime * 0.5f );
+		pSkeleton->SetLayerPlaybackRate( 1, 1.3f );
+		pSkeleton->SetLayerWeight( 1, 0.3f );
+
+		skeletons.Push( pSkeleton );
+	}
+
+	AnimationEvaluator& rEvaluator = AnimationEvaluator::GetStaticInstance();
+	initializerStack.Push( AnimationEvaluator::DestroyStaticInstance );
+
+	// The evaluator runs on the shared worker pool, so it uses at most one thread more than the pool has workers.
+	rEvaluator.SetMaxThreadCount( static_cast< size_t >( jobCount ) );
+	int threadCount = static_cast< int >( rEvaluator.GetThreadCount() );
+
+	Log::Print(
+		TXT( "Animating %d skeletons with %d bones each for %d frames on %d threads...\n" ),
+		skeletonCount,
+		boneCount,
+		frameCount,
+		threadCount );
+
+	float32_t totalMilliseconds = 0.0f;
+	float32_t minMilliseconds = 0.0f;
+	float32_t maxMilliseconds = 0.0f;
+	for ( int frameIndex = 0; frameIndex < frameCount; ++frameIndex )
+	{
+		uint64_t frameStartTicks = Timer::GetTickCount();
+
+		for ( size_t skeletonIndex = 0; skeletonIndex < skeletons.GetSize(); ++skeletonIndex )
+		{
+			skeletons[ skeletonIndex ]->AdvanceTime( BENCHMARK_FRAME_SECONDS );
+		}
+
+		rEvaluator.Evaluate( skeletons.GetData(), skeletons.GetSize() );
+
+		float32_t frameMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - frameStartTicks ) );
+		totalMilliseconds += frameMilliseconds;
+		minMilliseconds = ( frameIndex == 0 ? frameMilliseconds : Min( minMilliseconds, frameMilliseconds ) );
+		maxMilliseconds = Max( maxMilliseconds, frameMilliseconds );
+	}
+
+	float32_t averageMilliseconds = totalMilliseconds / static_cast< float32_t >( frameCount );
+	float32_t skeletonsPerSecond = ( averageMilliseconds > 0.0f ? static_cast< float32_t >( skeletonCount ) * 1000.0f / averageMilliseconds : 0.0f );
+
+	Log::Print(
+		TXT( "Frame time: %.3f ms average, %.3f ms min, %.3f ms max (evaluation only: %.3f ms last frame).\n" ),
+		averageMilliseconds,
+		minMilliseconds,
+		maxMilliseconds,
+		rEvaluator.GetLastEvaluationMilliseconds() );
+	Log::Print(
+		TXT( "Throughput: %.0f skeletons/s, %.0f bones/s.\n" ),
+		skeletonsPerSecond,
+		skeletonsPerSecond * static_cast< float32_t >( boneCount ) );
+
+	for ( size_t skeletonIndex = 0; skeletonIndex < skeletons.GetSize(); ++skeletonIndex )
+	{
+		delete skeletons[ skeletonIndex ];
+	}
+	skeletons.Clear();
+	swingClip.m_trackNames.Clear();
+	twistClip.m_trackNames.Clear();
+	boneNames.Clear();
+
+	initializerStack.Cleanup();
+
+	return true;
+#endif  // HELIUM_USE_GRANNY_ANIMATION
+}
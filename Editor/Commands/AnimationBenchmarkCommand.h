@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Application/CmdLineProcessor.h"
+
+namespace Helium
+{
+    namespace Editor
+    {
+        class AnimationBenchmarkCommand : public Helium::CommandLine::Command
+        {
+        public:
+            AnimationBenchmarkCommand();
+
+            virtual bool Initialize( std::string& error ) HELIUM_OVERRIDE;
+            virtual bool Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error ) HELIUM_OVERRIDE;
+
+        private:
+            std::string m_SkeletonCount;
+            std::string m_BoneCount;
+            std::string m_FrameCount;
+            std::string m_JobCount;
+        };
+    }
+}
@@ -0,0 +1,232 @@
+#include "EditorPch.h"
+#include "AssetLookupBenchmarkCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Platform/Thread.h"
+#include "Platform/Timer.h"
+
+#include "Foundation/Log.h"
+
+#include "Application/InitializerStack.h"
+
+#include "Engine/Asset.h"
+#include "Engine/WorkerPool.h"
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	// Work done by a single benchmark thread.
+	struct BenchmarkWorker
+	{
+		// True to register new objects, false to look up children of the owner by name.
+		bool bRegister;
+		const Asset* pOwner;
+		const DynamicArray< Name >* pNames;
+		uint32_t seed;
+		int operationCount;
+		int foundCount;
+
+		// Objects registered by this worker, released on the main thread once timing is done.
+		DynamicArray< PackagePtr > packages;
+
+		void Run()
+		{
+			if ( bRegister )
+			{
+				packages.Reserve( operationCount );
+				for ( int operationIndex = 0; operationIndex < operationCount; ++operationIndex )
+				{
+					Package* pPackage = new Package;
+					HELIUM_ASSERT( pPackage );
+					HELIUM_VERIFY( Asset::RegisterObject( pPackage ) );
+					packages.Push( pPackage );
+				}
+
+				return;
+			}
+
+			size_t nameCount = pNames->GetSize();
+			for ( int operationIndex = 0; operationIndex < operationCount; ++operationIndex )
+			{
+				const Name& rName = ( *pNames )[ NextRandom( seed ) % nameCount ];
+				if ( Asset::FindChildOf( pOwner, rName ) )
+				{
+					++foundCount;
+				}
+			}
+		}
+	};
+
+	// Run a set of workers on separate threads and return the elapsed wall clock time in milliseconds.
+	float32_t RunWorkers( DynamicArray< BenchmarkWorker >& rWorkers )
+	{
+		Helium::CallbackThread::Entry entry =
+			&Helium::CallbackThread::EntryHelper< BenchmarkWorker, &BenchmarkWorker::Run >;
+
+		DynamicArray< CallbackThread* > threads;
+		threads.Reserve( rWorkers.GetSize() );
+
+		uint64_t startTicks = Timer::GetTickCount();
+
+		for ( size_t workerIndex = 1; workerIndex < rWorkers.GetSize(); ++workerIndex )
+		{
+			CallbackThread* pThread = new CallbackThread;
+			HELIUM_ASSERT( pThread );
+			HELIUM_VERIFY( pThread->Create( entry, &rWorkers[ workerIndex ], TXT( "Asset benchmark" ) ) );
+			threads.Push( pThread );
+		}
+
+		// The calling thread takes part as well.
+		rWorkers[ 0 ].Run();
+
+		for ( size_t threadIndex = 0; threadIndex < threads.GetSize(); ++threadIndex )
+		{
+			CallbackThread* pThread = threads[ threadIndex ];
+			pThread->Join();
+			delete pThread;
+		}
+
+		return static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+	}
+
+	// Set up one worker per thread, splitting the total operation count between them.
+	void InitializeWorkers(
+		DynamicArray< BenchmarkWorker >& rWorkers, int threadCount, int operationCount, bool bRegister, const Asset* pOwner,
+		const DynamicArray< Name >& rNames )
+	{
+		rWorkers.Resize( 0 );
+		rWorkers.Resize( threadCount );
+		for ( int threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+		{
+			BenchmarkWorker& rWorker = rWorkers[ threadIndex ];
+			rWorker.bRegister = bRegister;
+			rWorker.pOwner = pOwner;
+			rWorker.pNames = &rNames;
+			rWorker.seed = 12345 + threadIndex * 7919;
+			rWorker.operationCount = operationCount / threadCount + ( threadIndex < operationCount % threadCount ? 1 : 0 );
+			rWorker.foundCount = 0;
+		}
+	}
+}
+
+AssetLookupBenchmarkCommand::AssetLookupBenchmarkCommand()
+	: Command( TXT( "assetbench" ), TXT( "" ), TXT( "Look up child assets by name and register new assets from one and from many threads, and report the throughput of each" ) )
+{
+
+}
+
+bool AssetLookupBenchmarkCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_ObjectCount, TXT( "o|objects" ), TXT( "<COUNT>" ), TXT( "number of child assets under a single package (defaults to 10000)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_LookupCount, TXT( "n|lookups" ), TXT( "<COUNT>" ), TXT( "number of lookups and registrations for each run (defaults to 1000000)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_ThreadCount, TXT( "t|threads" ), TXT( "<COUNT>" ), TXT( "number of threads for the concurrent runs (defaults to the number of processors)" ) ), error );
+	return success;
+}
+
+bool AssetLookupBenchmarkCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	int objectCount, lookupCount, threadCount;
+	int processorCount = static_cast< int >( WorkerPool::GetProcessorCount() );
+	if ( !ParseCountOption( m_ObjectCount, TXT( "object count" ), 10000, 1, 1 << 22, objectCount, error ) ||
+		!ParseCountOption( m_LookupCount, TXT( "lookup count" ), 1000000, 1, 1 << 28, lookupCount, error ) ||
+		!ParseCountOption( m_ThreadCount, TXT( "thread count" ), Max( processorCount, 1 ), 1, 256, threadCount, error ) )
+	{
+		return false;
+	}
+
+	InitializerStack initializerStack;
+	initializerStack.Push( Name::Shutdown );
+	initializerStack.Push( AssetPath::Shutdown );
+	initializerStack.Push( Reflect::ObjectRefCountSupport::Shutdown );
+	initializerStack.Push( Asset::Shutdown );
+	initializerStack.Push( AssetType::Shutdown );
+	initializerStack.Push( Reflect::Initialize, Reflect::Cleanup );
+
+	Log::Print( TXT( "Creating %d child assets under a single package...\n" ), objectCount );
+
+	// Build a single package with many children, as with a large level or a package of imported meshes.
+	PackagePtr spRootPackage = new Package;
+	HELIUM_VERIFY( Asset::RegisterObject( spRootPackage ) );
+
+	Asset::RenameParameters renameParameters;
+	renameParameters.name.Set( TXT( "AssetLookupBenchmark" ) );
+	HELIUM_VERIFY( spRootPackage->Rename( renameParameters ) );
+
+	DynamicArray< Name > names;
+	DynamicArray< PackagePtr > children;
+	names.Reserve( objectCount );
+	children.Reserve( objectCount );
+
+	uint64_t createStartTicks = Timer::GetTickCount();
+
+	renameParameters.spOwner = spRootPackage;
+	for ( int objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+	{
+		char objectName[ 32 ];
+		StringPrint( objectName, TXT( "asset%d" ), objectIndex );
+		names.Push( Name( objectName ) );
+
+		PackagePtr spChild = new Package;
+		HELIUM_VERIFY( Asset::RegisterObject( spChild ) );
+
+		renameParameters.name = names[ objectIndex ];
+		HELIUM_VERIFY( spChild->Rename( renameParameters ) );
+
+		children.Push( spChild );
+	}
+
+	float32_t createMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - createStartTicks ) );
+	Log::Print( TXT( "Create: %.3f ms (%.0f assets/s).\n" ), createMilliseconds, ( createMilliseconds > 0.0f ? static_cast< float32_t >( objectCount ) * 1000.0f / createMilliseconds : 0.0f ) );
+
+	DynamicArray< BenchmarkWorker > workers;
+	int runThreadCounts[ 2 ] = { 1, threadCount };
+	size_t runCount = ( threadCount > 1 ? 2 : 1 );
+	for ( size_t runIndex = 0; runIndex < runCount; ++runIndex )
+	{
+		int runThreadCount = runThreadCounts[ runIndex ];
+
+		InitializeWorkers( workers, runThreadCount, lookupCount, false, spRootPackage, names );
+		float32_t lookupMilliseconds = RunWorkers( workers );
+
+		int foundCount = 0;
+		for ( size_t workerIndex = 0; workerIndex < workers.GetSize(); ++workerIndex )
+		{
+			foundCount += workers[ workerIndex ].foundCount;
+		}
+
+		if ( foundCount != lookupCount )
+		{
+			error = TXT( "Child asset lookup failed to find one or more assets." );
+			spRootPackage.Release();
+			children.Clear();
+			workers.Clear();
+			return false;
+		}
+
+		InitializeWorkers( workers, runThreadCount, lookupCount, true, NULL, names );
+		float32_t registerMilliseconds = RunWorkers( workers );
+
+		// Releasing the registered objects unregisters them again, outside of the timed section.
+		workers.Clear();
+
+		Log::Print(
+			TXT( "%d thread(s): %.0f lookups/s, %.0f registrations/s.\n" ),
+			runThreadCount,
+			( lookupMilliseconds > 0.0f ? static_cast< float32_t >( lookupCount ) * 1000.0f / lookupMilliseconds : 0.0f ),
+			( registerMilliseconds > 0.0f ? static_cast< float32_t >( lookupCount ) * 1000.0f / registerMilliseconds : 0.0f ) );
+	}
+
+	children.Clear();
+	spRootPackage.Release();
+
+	return true;
+}
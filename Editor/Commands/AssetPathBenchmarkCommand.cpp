@@ -0,0 +1,229 @@
+#include "EditorPch.h"
+#include "AssetPathBenchmarkCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Platform/Thread.h"
+#include "Platform/Timer.h"
+
+#include "Foundation/Log.h"
+
+#include "Application/InitializerStack.h"
+
+#include "Engine/AssetPath.h"
+#include "Engine/WorkerPool.h"
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	// Number of assets in each package of the generated paths.
+	const int BENCHMARK_PACKAGE_SIZE = 64;
+
+	// Build a set of asset path strings, grouped into packages as in a typical project.
+	void BuildPathStrings( DynamicArray< String >& rStrings, const char* pRootName, int pathCount )
+	{
+		rStrings.Resize( 0 );
+		rStrings.Reserve( pathCount );
+		for ( int pathIndex = 0; pathIndex < pathCount; ++pathIndex )
+		{
+			char pathString[ 128 ];
+			StringPrint(
+				pathString,
+				TXT( "/%s/Package%d:Asset%d" ),
+				pRootName,
+				pathIndex / BENCHMARK_PACKAGE_SIZE,
+				pathIndex );
+			rStrings.Push( String( pathString ) );
+		}
+	}
+
+	// Work done by a single benchmark thread.
+	struct BenchmarkWorker
+	{
+		// Paths to parse, shared between all workers when looking up existing paths.
+		const DynamicArray< String >* pStrings;
+		// True to parse random paths from the set, false to parse each path in the set once, in order.
+		bool bRandom;
+		uint32_t seed;
+		int operationCount;
+		int failureCount;
+
+		void Run()
+		{
+			size_t stringCount = pStrings->GetSize();
+			AssetPath path;
+			for ( int operationIndex = 0; operationIndex < operationCount; ++operationIndex )
+			{
+				size_t stringIndex = ( bRandom ? NextRandom( seed ) % stringCount : static_cast< size_t >( operationIndex ) );
+				if ( !path.Set( *( *pStrings )[ stringIndex ] ) )
+				{
+					++failureCount;
+				}
+			}
+		}
+	};
+
+	// Run a set of workers on separate threads and return the elapsed wall clock time in milliseconds.
+	float32_t RunWorkers( DynamicArray< BenchmarkWorker >& rWorkers )
+	{
+		Helium::CallbackThread::Entry entry =
+			&Helium::CallbackThread::EntryHelper< BenchmarkWorker, &BenchmarkWorker::Run >;
+
+		DynamicArray< CallbackThread* > threads;
+		threads.Reserve( rWorkers.GetSize() );
+
+		uint64_t startTicks = Timer::GetTickCount();
+
+		for ( size_t workerIndex = 1; workerIndex < rWorkers.GetSize(); ++workerIndex )
+		{
+			CallbackThread* pThread = new CallbackThread;
+			HELIUM_ASSERT( pThread );
+			HELIUM_VERIFY( pThread->Create( entry, &rWorkers[ workerIndex ], TXT( "Asset path benchmark" ) ) );
+			threads.Push( pThread );
+		}
+
+		// The calling thread takes part as well.
+		rWorkers[ 0 ].Run();
+
+		for ( size_t threadIndex = 0; threadIndex < threads.GetSize(); ++threadIndex )
+		{
+			CallbackThread* pThread = threads[ threadIndex ];
+			pThread->Join();
+			delete pThread;
+		}
+
+		return static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+	}
+
+	// Sum the parse failures of a set of workers.
+	int GetFailureCount( const DynamicArray< BenchmarkWorker >& rWorkers )
+	{
+		int failureCount = 0;
+		for ( size_t workerIndex = 0; workerIndex < rWorkers.GetSize(); ++workerIndex )
+		{
+			failureCount += rWorkers[ workerIndex ].failureCount;
+		}
+
+		return failureCount;
+	}
+
+	float32_t GetOperationsPerSecond( int operationCount, float32_t milliseconds )
+	{
+		return ( milliseconds > 0.0f ? static_cast< float32_t >( operationCount ) * 1000.0f / milliseconds : 0.0f );
+	}
+}
+
+AssetPathBenchmarkCommand::AssetPathBenchmarkCommand()
+	: Command( TXT( "assetpathbench" ), TXT( "" ), TXT( "Parse existing asset paths and intern new asset paths from one and from many threads at once, and report the throughput of each" ) )
+{
+
+}
+
+bool AssetPathBenchmarkCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_PathCount, TXT( "p|paths" ), TXT( "<COUNT>" ), TXT( "number of existing paths looked up, and of new paths interned by each run (defaults to 100000)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_OperationCount, TXT( "n|lookups" ), TXT( "<COUNT>" ), TXT( "number of existing path lookups for each run (defaults to 1000000)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_ThreadCount, TXT( "t|threads" ), TXT( "<COUNT>" ), TXT( "number of threads for the concurrent runs (defaults to the number of processors)" ) ), error );
+	return success;
+}
+
+bool AssetPathBenchmarkCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	int pathCount, lookupCount, threadCount;
+	int processorCount = static_cast< int >( WorkerPool::GetProcessorCount() );
+	if ( !ParseCountOption( m_PathCount, TXT( "path count" ), 100000, 1, 1 << 22, pathCount, error ) ||
+		!ParseCountOption( m_OperationCount, TXT( "lookup count" ), 1000000, 1, 1 << 28, lookupCount, error ) ||
+		!ParseCountOption( m_ThreadCount, TXT( "thread count" ), Max( processorCount, 1 ), 1, 256, threadCount, error ) )
+	{
+		return false;
+	}
+
+	InitializerStack initializerStack;
+	initializerStack.Push( Name::Shutdown );
+	initializerStack.Push( AssetPath::Shutdown );
+
+	Log::Print( TXT( "Interning %d asset paths...\n" ), pathCount );
+
+	// Paths that already exist, as when loading assets that reference each other.
+	DynamicArray< String > existingStrings;
+	BuildPathStrings( existingStrings, TXT( "AssetPathBenchmark" ), pathCount );
+
+	DynamicArray< BenchmarkWorker > workers;
+	workers.Resize( 1 );
+	workers[ 0 ].pStrings = &existingStrings;
+	workers[ 0 ].bRandom = false;
+	workers[ 0 ].seed = 0;
+	workers[ 0 ].operationCount = pathCount;
+	workers[ 0 ].failureCount = 0;
+
+	float32_t createMilliseconds = RunWorkers( workers );
+	Log::Print( TXT( "Create: %.3f ms (%.0f paths/s).\n" ), createMilliseconds, GetOperationsPerSecond( pathCount, createMilliseconds ) );
+
+	DynamicArray< DynamicArray< String > > newStrings;
+	int runThreadCounts[ 2 ] = { 1, threadCount };
+	size_t runCount = ( threadCount > 1 ? 2 : 1 );
+	for ( size_t runIndex = 0; runIndex < runCount; ++runIndex )
+	{
+		int runThreadCount = runThreadCounts[ runIndex ];
+
+		// All threads look up paths from the same set, contending on the same table entries.
+		workers.Resize( 0 );
+		workers.Resize( runThreadCount );
+		for ( int threadIndex = 0; threadIndex < runThreadCount; ++threadIndex )
+		{
+			BenchmarkWorker& rWorker = workers[ threadIndex ];
+			rWorker.pStrings = &existingStrings;
+			rWorker.bRandom = true;
+			rWorker.seed = 12345 + threadIndex * 7919;
+			rWorker.operationCount = lookupCount / runThreadCount + ( threadIndex < lookupCount % runThreadCount ? 1 : 0 );
+			rWorker.failureCount = 0;
+		}
+
+		float32_t lookupMilliseconds = RunWorkers( workers );
+		int lookupFailureCount = GetFailureCount( workers );
+
+		// Each thread interns its own new paths, contending on table insertion and growth.  Every run uses different
+		// paths, so that each run starts from the same table state.
+		newStrings.Resize( 0 );
+		newStrings.Resize( runThreadCount );
+		for ( int threadIndex = 0; threadIndex < runThreadCount; ++threadIndex )
+		{
+			char rootName[ 64 ];
+			StringPrint( rootName, TXT( "AssetPathBenchmarkRun%dThread%d" ), static_cast< int >( runIndex ), threadIndex );
+
+			int threadPathCount = pathCount / runThreadCount + ( threadIndex < pathCount % runThreadCount ? 1 : 0 );
+			BuildPathStrings( newStrings[ threadIndex ], rootName, threadPathCount );
+
+			BenchmarkWorker& rWorker = workers[ threadIndex ];
+			rWorker.pStrings = &newStrings[ threadIndex ];
+			rWorker.bRandom = false;
+			rWorker.operationCount = threadPathCount;
+			rWorker.failureCount = 0;
+		}
+
+		float32_t internMilliseconds = RunWorkers( workers );
+		int internFailureCount = GetFailureCount( workers );
+
+		if ( lookupFailureCount != 0 || internFailureCount != 0 )
+		{
+			error = TXT( "Failed to parse one or more asset paths." );
+			return false;
+		}
+
+		Log::Print(
+			TXT( "%d thread(s): %.0f lookups/s, %.0f new paths/s.\n" ),
+			runThreadCount,
+			GetOperationsPerSecond( lookupCount, lookupMilliseconds ),
+			GetOperationsPerSecond( pathCount, internMilliseconds ) );
+	}
+
+	return true;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Application/CmdLineProcessor.h"
+
+namespace Helium
+{
+    namespace Editor
+    {
+        class AssetPathBenchmarkCommand : public Helium::CommandLine::Command
+        {
+        public:
+            AssetPathBenchmarkCommand();
+
+            virtual bool Initialize( std::string& error ) HELIUM_OVERRIDE;
+            virtual bool Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error ) HELIUM_OVERRIDE;
+
+        private:
+            std::string m_PathCount;
+            std::string m_OperationCount;
+            std::string m_ThreadCount;
+        };
+    }
+}
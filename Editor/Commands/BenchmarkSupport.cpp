@@ -0,0 +1,32 @@
+#include "EditorPch.h"
+#include "BenchmarkSupport.h"
+
+#include <stdlib.h>
+
+using namespace Helium;
+using namespace Helium::Editor;
+
+bool Helium::Editor::ParseCountOption(
+	const std::string& value,
+	const char* pOptionName,
+	int defaultCount,
+	int minCount,
+	int maxCount,
+	int& rCount,
+	std::string& error )
+{
+	if ( value.empty() )
+	{
+		rCount = defaultCount;
+		return true;
+	}
+
+	rCount = atoi( value.c_str() );
+	if ( rCount < minCount || rCount > maxCount )
+	{
+		error = std::string( TXT( "Invalid " ) ) + pOptionName + TXT( ": " ) + value;
+		return false;
+	}
+
+	return true;
+}
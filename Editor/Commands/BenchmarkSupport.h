@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+namespace Helium
+{
+    namespace Editor
+    {
+        // Parse an integer count option for a benchmark or check command, using the given default if the option was
+        // not specified.  Values outside [minCount, maxCount] are rejected with an error naming the option.
+        bool ParseCountOption(
+            const std::string& value,
+            const char* pOptionName,
+            int defaultCount,
+            int minCount,
+            int maxCount,
+            int& rCount,
+            std::string& error );
+
+        // Deterministic 24-bit pseudo-random number, so that runs are comparable and failures can be reproduced from
+        // their seed.
+        inline uint32_t NextRandom( uint32_t& rSeed )
+        {
+            rSeed = rSeed * 1664525u + 1013904223u;
+            return rSeed >> 8;
+        }
+
+        // Deterministic pseudo-random number in [minimum, maximum).
+        inline float32_t NextRandomFloat( uint32_t& rSeed, float32_t minimum, float32_t maximum )
+        {
+            return minimum + ( maximum - minimum ) * static_cast< float32_t >( NextRandom( rSeed ) ) * ( 1.0f / 16777216.0f );
+        }
+    }
+}
@@ -0,0 +1,284 @@
+#include "EditorPch.h"
+#include "CookCommand.h"
+
+#include "Platform/Process.h"
+#include "Platform/Timer.h"
+
+#include "Foundation/DirectoryIterator.h"
+#include "Foundation/Log.h"
+
+#include "Application/InitializerStack.h"
+
+#include "Engine/FileLocations.h"
+#include "Engine/AsyncLoader.h"
+#include "Engine/Asset.h"
+#include "Engine/AssetLoader.h"
+#include "Engine/CacheManager.h"
+#include "Engine/Config.h"
+#include "Engine/PackageLoader.h"
+#include "Engine/WorkerPool.h"
+
+#include "EngineJobs/EngineJobs.h"
+
+#include "GraphicsJobs/GraphicsJobs.h"
+
+#include "PcSupport/AssetPreprocessor.h"
+#include "PcSupport/LooseAssetLoader.h"
+
+#include "PreprocessingPc/PcPreprocessor.h"
+
+#include <algorithm>
+#include <stdlib.h>
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	// Asset queued for cooking.
+	struct CookAsset
+	{
+		// Asset path.
+		AssetPath path;
+		// Asset path string (used for sorting).
+		String pathString;
+		// Asset load request ID.
+		size_t loadId;
+		// Loaded asset.
+		AssetPtr spAsset;
+	};
+
+	// Sort predicate for loading assets in order of their path names.
+	bool CookAssetPathLess( const CookAsset& rAsset0, const CookAsset& rAsset1 )
+	{
+		return ( CompareString( *rAsset0.pathString, *rAsset1.pathString ) < 0 );
+	}
+}
+
+CookCommand::CookCommand()
+	: Command( TXT( "cook" ), TXT( "[<PACKAGE> ...]" ), TXT( "Preprocess and cache every asset in the given packages (or the entire data directory)" ) )
+{
+
+}
+
+bool CookCommand::Initialize( std::string& error )
+{
+	return AddOption( new SimpleOption< std::string >( &m_JobCount, TXT( "j|jobs" ), TXT( "<COUNT>" ), TXT( "number of worker threads (defaults to one less than the number of processors)" ) ), error );
+}
+
+bool CookCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	size_t workerCount;
+	if ( !m_JobCount.empty() )
+	{
+		int jobCount = atoi( m_JobCount.c_str() );
+		if ( jobCount < 1 )
+		{
+			error = TXT( "Invalid job count: " ) + m_JobCount;
+			return false;
+		}
+
+		workerCount = static_cast< size_t >( jobCount - 1 );
+	}
+	else
+	{
+		int processorCount = static_cast< int >( WorkerPool::GetProcessorCount() );
+		workerCount = ( processorCount > 1 ? static_cast< size_t >( processorCount - 1 ) : 0 );
+	}
+
+	// Resolve the packages to cook before starting up, so that bad arguments don't cost a full engine start.
+	DynamicArray< AssetPath > packagePaths;
+	while ( argsBegin != argsEnd )
+	{
+		const std::string& arg = (*argsBegin);
+		++argsBegin;
+
+		AssetPath packagePath;
+		if ( !packagePath.Set( arg.c_str() ) || !packagePath.IsPackage() )
+		{
+			error = TXT( "Invalid package path: " ) + arg;
+			return false;
+		}
+
+		packagePaths.Push( packagePath );
+	}
+
+	uint64_t startTicks = Timer::GetTickCount();
+
+	HELIUM_TRACE_SET_LEVEL( TraceLevels::Info );
+
+	// Initialize sibling dynamically loaded modules.
+	Helium::FilePath path ( Helium::GetProcessPath() );
+	for ( DirectoryIterator itr ( FilePath( path.Directory() ) ); !itr.IsDone(); itr.Next() )
+	{
+		std::string ext = itr.GetItem().m_Path.Extension();
+		if ( ext == HELIUM_MODULE_EXTENSION )
+		{
+			ModuleHandle module = LoadModule( itr.GetItem().m_Path.c_str() );
+			HELIUM_ASSERT( module != HELIUM_INVALID_MODULE );
+		}
+	}
+
+	// Start up the same systems as the editor, minus anything that needs a window or renderer.
+	InitializerStack initializerStack;
+
+	InitEngineJobsDefaultHeap();
+	InitGraphicsJobsDefaultHeap();
+
+	initializerStack.Push( FileLocations::Shutdown );
+	initializerStack.Push( Name::Shutdown );
+	initializerStack.Push( AssetPath::Shutdown );
+
+	AsyncLoader& asyncLoader = AsyncLoader::GetStaticInstance();
+	HELIUM_VERIFY( asyncLoader.Initialize() );
+	initializerStack.Push( AsyncLoader::DestroyStaticInstance );
+
+	FilePath baseDirectory;
+	if ( !FileLocations::GetBaseDirectory( baseDirectory ) )
+	{
+		error = TXT( "Could not get base directory." );
+		return false;
+	}
+
+	HELIUM_VERIFY( CacheManager::InitializeStaticInstance( baseDirectory ) );
+	initializerStack.Push( CacheManager::DestroyStaticInstance );
+
+	initializerStack.Push( Reflect::ObjectRefCountSupport::Shutdown );
+	initializerStack.Push( Asset::Shutdown );
+	initializerStack.Push( AssetType::Shutdown );
+	initializerStack.Push( Reflect::Initialize, Reflect::Cleanup );
+
+	HELIUM_VERIFY( LooseAssetLoader::InitializeStaticInstance() );
+	initializerStack.Push( LooseAssetLoader::DestroyStaticInstance );
+
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	HELIUM_ASSERT( pAssetLoader );
+
+	AssetPreprocessor* pAssetPreprocessor = AssetPreprocessor::CreateStaticInstance();
+	HELIUM_ASSERT( pAssetPreprocessor );
+	PlatformPreprocessor* pPlatformPreprocessor = new PcPreprocessor;
+	HELIUM_ASSERT( pPlatformPreprocessor );
+	pAssetPreprocessor->SetPlatformPreprocessor( Cache::PLATFORM_PC, pPlatformPreprocessor );
+	initializerStack.Push( AssetPreprocessor::DestroyStaticInstance );
+
+	Config& rConfig = Config::GetStaticInstance();
+	rConfig.BeginLoad();
+	while( !rConfig.TryFinishLoad() )
+	{
+		pAssetLoader->Tick();
+	}
+
+	initializerStack.Push( Config::DestroyStaticInstance );
+
+	if ( packagePaths.IsEmpty() )
+	{
+		pAssetLoader->EnumerateRootPackages( packagePaths );
+	}
+
+	// Walk the package tree to find every asset to cook.  Packages are kept loaded until cooking is done.
+	DynamicArray< AssetPtr > packages;
+	DynamicArray< CookAsset > assets;
+
+	for ( size_t packageIndex = 0; packageIndex < packagePaths.GetSize(); ++packageIndex )
+	{
+		AssetPath packagePath = packagePaths[ packageIndex ];
+
+		AssetPtr spPackage;
+		Package* pPackage = NULL;
+		if ( pAssetLoader->LoadObject( packagePath, spPackage ) )
+		{
+			pPackage = Reflect::SafeCast< Package >( spPackage.Get() );
+		}
+
+		if ( !pPackage || !pPackage->GetLoader() )
+		{
+			HELIUM_TRACE( TraceLevels::Error, TXT( "Cook: Failed to load package \"%s\".\n" ), *packagePath.ToString() );
+			continue;
+		}
+
+		packages.Push( spPackage );
+
+		DynamicArray< AssetPath > children;
+		pPackage->GetLoader()->EnumerateChildren( children );
+
+		for ( DynamicArray< AssetPath >::Iterator childIter = children.Begin(); childIter != children.End(); ++childIter )
+		{
+			if ( childIter->IsPackage() )
+			{
+				packagePaths.Push( *childIter );
+			}
+			else
+			{
+				CookAsset* pAsset = assets.New();
+				HELIUM_ASSERT( pAsset );
+				pAsset->path = *childIter;
+				childIter->ToString( pAsset->pathString );
+				pAsset->loadId = Invalid< size_t >();
+			}
+		}
+	}
+
+	// Load every asset in a fixed order.  Assets are preprocessed and cached as they finish loading, with resources
+	// that can be preprocessed independently left for the worker threads once everything has loaded.
+	std::sort( assets.Begin(), assets.End(), CookAssetPathLess );
+
+	Log::Print( TXT( "Cooking %" ) PRIuSZ TXT( " assets from %" ) PRIuSZ TXT( " packages...\n" ), assets.GetSize(), packages.GetSize() );
+
+	pAssetPreprocessor->BeginBatchCook();
+
+	for ( DynamicArray< CookAsset >::Iterator assetIter = assets.Begin(); assetIter != assets.End(); ++assetIter )
+	{
+		assetIter->loadId = pAssetLoader->BeginLoadObject( assetIter->path );
+	}
+
+	size_t failedAssetCount = 0;
+	for ( size_t pendingAssetCount = assets.GetSize(); pendingAssetCount != 0; )
+	{
+		pAssetLoader->Tick();
+
+		for ( DynamicArray< CookAsset >::Iterator assetIter = assets.Begin(); assetIter != assets.End(); ++assetIter )
+		{
+			if ( IsValid( assetIter->loadId ) && pAssetLoader->TryFinishLoad( assetIter->loadId, assetIter->spAsset ) )
+			{
+				SetInvalid( assetIter->loadId );
+				--pendingAssetCount;
+
+				if ( !assetIter->spAsset || assetIter->spAsset->GetAnyFlagSet( Asset::FLAG_BROKEN ) )
+				{
+					HELIUM_TRACE( TraceLevels::Error, TXT( "Cook: Failed to load asset \"%s\".\n" ), *assetIter->path.ToString() );
+					++failedAssetCount;
+				}
+			}
+		}
+	}
+
+	bool bCookSuccess = pAssetPreprocessor->EndBatchCook( workerCount );
+
+	pAssetPreprocessor->TraceBatchCookSummary();
+
+	assets.Clear();
+	packages.Clear();
+
+	initializerStack.Cleanup();
+
+	ThreadLocalStackAllocator::ReleaseMemoryHeap();
+
+	Log::Print(
+		TXT( "Cook finished in %.2f seconds (%" ) PRIuSZ TXT( " assets failed to load).\n" ),
+		static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) ) * 0.001f,
+		failedAssetCount );
+
+	if ( !bCookSuccess || failedAssetCount != 0 )
+	{
+		error = TXT( "Cook failed; see the log for details." );
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,190 @@
+#include "EditorPch.h"
+#include "FontBenchmarkCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Platform/Timer.h"
+
+#include "Foundation/Log.h"
+
+#include "Application/InitializerStack.h"
+
+#include "Engine/FileLocations.h"
+
+#include "EditorSupport/FontResourceHandler.h"
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	// Scales, relative to the base point size, of the bitmap fonts a game would otherwise need to cache to display text
+	// at different sizes.
+	const float32_t BENCHMARK_SIZE_SCALES[] = { 1.0f, 1.5f, 2.0f, 3.0f, 4.0f };
+
+	// Texture sheet statistics for a single font configuration.
+	struct AtlasResult
+	{
+		size_t characterCount;
+		size_t sheetCount;
+		size_t sheetBytes;
+		float32_t milliseconds;
+	};
+
+	// Render every glyph in the font and gather the resulting texture sheet statistics.
+	bool BuildAtlas(
+		const String& rFileName,
+		float32_t pointSize,
+		uint16_t sheetSize,
+		bool bDistanceField,
+		AtlasResult& rResult )
+	{
+		StrongPtr< Font::PersistentResourceData > spResourceData( new Font::PersistentResourceData() );
+		DynamicArray< DynamicArray< uint8_t > > textureSheets;
+
+		uint64_t startTicks = Timer::GetTickCount();
+		bool bSuccess = FontResourceHandler::BuildTextureSheets(
+			rFileName,
+			pointSize,
+			Font::DEFAULT_DPI,
+			sheetSize,
+			sheetSize,
+			true,
+			bDistanceField,
+			*spResourceData,
+			textureSheets );
+		rResult.milliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTicks ) );
+
+		rResult.characterCount = spResourceData->m_characters.GetSize();
+		rResult.sheetCount = textureSheets.GetSize();
+		rResult.sheetBytes = 0;
+		for ( size_t sheetIndex = 0; sheetIndex < textureSheets.GetSize(); ++sheetIndex )
+		{
+			rResult.sheetBytes += textureSheets[ sheetIndex ].GetSize();
+		}
+
+		return bSuccess;
+	}
+
+	void PrintAtlasResult( const char* pLabel, float32_t pointSize, const AtlasResult& rResult )
+	{
+		Log::Print(
+			TXT( "%s %5.1f pt: %" ) PRIuSZ TXT( " glyphs, %" ) PRIuSZ TXT( " sheets, %.1f KiB, %.2f ms (%.1f us/glyph).\n" ),
+			pLabel,
+			pointSize,
+			rResult.characterCount,
+			rResult.sheetCount,
+			static_cast< float32_t >( rResult.sheetBytes ) / 1024.0f,
+			rResult.milliseconds,
+			( rResult.characterCount != 0 ? rResult.milliseconds * 1000.0f / static_cast< float32_t >( rResult.characterCount ) : 0.0f ) );
+	}
+}
+
+FontBenchmarkCommand::FontBenchmarkCommand()
+	: Command( TXT( "fontbench" ), TXT( "" ), TXT( "Build bitmap font texture sheets at several sizes and a single signed distance field texture sheet set, and compare their memory use and per-glyph build cost" ) )
+{
+
+}
+
+bool FontBenchmarkCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_FileName, TXT( "f|file" ), TXT( "<FILE>" ), TXT( "TrueType font file to render (defaults to Fonts/Vera.ttf in the data directory)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_PointSize, TXT( "p|points" ), TXT( "<SIZE>" ), TXT( "base font size, in points (defaults to 16)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_SizeCount, TXT( "s|sizes" ), TXT( "<COUNT>" ), TXT( "number of bitmap font sizes needed to display the same text at different scales (defaults to 5, at most 5)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_SheetSize, TXT( "w|sheet" ), TXT( "<SIZE>" ), TXT( "texture sheet width and height, in pixels (defaults to 256)" ) ), error );
+	return success;
+}
+
+bool FontBenchmarkCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	int pointSize, sizeCount, sheetSize;
+	if ( !ParseCountOption( m_PointSize, TXT( "point size" ), 16, 4, 128, pointSize, error ) ||
+		!ParseCountOption( m_SizeCount, TXT( "size count" ), static_cast< int >( HELIUM_ARRAY_COUNT( BENCHMARK_SIZE_SCALES ) ), 1, static_cast< int >( HELIUM_ARRAY_COUNT( BENCHMARK_SIZE_SCALES ) ), sizeCount, error ) ||
+		!ParseCountOption( m_SheetSize, TXT( "sheet size" ), Font::DEFAULT_TEXTURE_SHEET_WIDTH, 64, 4096, sheetSize, error ) )
+	{
+		return false;
+	}
+
+	InitializerStack initializerStack;
+	initializerStack.Push( FileLocations::Shutdown );
+	initializerStack.Push( Reflect::ObjectRefCountSupport::Shutdown );
+	initializerStack.Push( Reflect::Initialize, Reflect::Cleanup );
+	FontResourceHandler::InitializeStaticLibrary();
+	initializerStack.Push( FontResourceHandler::DestroyStaticLibrary );
+
+	String fileName;
+	if ( m_FileName.empty() )
+	{
+		FilePath fontFilePath;
+		if ( !FileLocations::GetDataDirectory( fontFilePath ) )
+		{
+			error = TXT( "Could not retrieve the data directory" );
+			return false;
+		}
+
+		fontFilePath += TXT( "Fonts/Vera.ttf" );
+		fileName = fontFilePath.c_str();
+	}
+	else
+	{
+		fileName = m_FileName.c_str();
+	}
+
+	Log::Print( TXT( "Building texture sheets for \"%s\" with %dx%d sheets...\n" ), *fileName, sheetSize, sheetSize );
+
+	// A bitmap font only looks right at the size it was cached at, so each display size needs its own set of sheets.
+	AtlasResult bitmapTotal;
+	MemoryZero( &bitmapTotal, sizeof( bitmapTotal ) );
+
+	for ( int sizeIndex = 0; sizeIndex < sizeCount; ++sizeIndex )
+	{
+		float32_t scaledPointSize = static_cast< float32_t >( pointSize ) * BENCHMARK_SIZE_SCALES[ sizeIndex ];
+
+		AtlasResult result;
+		if ( !BuildAtlas( fileName, scaledPointSize, static_cast< uint16_t >( sheetSize ), false, result ) )
+		{
+			error = TXT( "Failed to build bitmap font texture sheets (the glyphs may not fit on a single sheet)" );
+			return false;
+		}
+
+		PrintAtlasResult( TXT( "Bitmap        " ), scaledPointSize, result );
+
+		bitmapTotal.characterCount += result.characterCount;
+		bitmapTotal.sheetCount += result.sheetCount;
+		bitmapTotal.sheetBytes += result.sheetBytes;
+		bitmapTotal.milliseconds += result.milliseconds;
+	}
+
+	// A distance field font is cached once at the base size and scaled at runtime.
+	AtlasResult distanceFieldResult;
+	if ( !BuildAtlas( fileName, static_cast< float32_t >( pointSize ), static_cast< uint16_t >( sheetSize ), true, distanceFieldResult ) )
+	{
+		error = TXT( "Failed to build distance field font texture sheets (the glyphs may not fit on a single sheet)" );
+		return false;
+	}
+
+	PrintAtlasResult( TXT( "Distance field" ), static_cast< float32_t >( pointSize ), distanceFieldResult );
+
+	// Sizes are for uncompressed grayscale sheets (distance field sheets are always stored this way, while bitmap fonts
+	// using COLOR_COMPRESSED sheets take half the memory at the cost of compression time and edge quality).
+	Log::Print(
+		TXT( "Bitmap fonts for %d sizes: %.1f KiB, %.2f ms; distance field font: %.1f KiB (%.2fx), %.2f ms (%.2fx per glyph).\n" ),
+		sizeCount,
+		static_cast< float32_t >( bitmapTotal.sheetBytes ) / 1024.0f,
+		bitmapTotal.milliseconds,
+		static_cast< float32_t >( distanceFieldResult.sheetBytes ) / 1024.0f,
+		( bitmapTotal.sheetBytes != 0 ? static_cast< float32_t >( distanceFieldResult.sheetBytes ) / static_cast< float32_t >( bitmapTotal.sheetBytes ) : 0.0f ),
+		distanceFieldResult.milliseconds,
+		( bitmapTotal.milliseconds > 0.0f && distanceFieldResult.characterCount != 0
+			? ( distanceFieldResult.milliseconds / static_cast< float32_t >( distanceFieldResult.characterCount ) ) /
+			  ( bitmapTotal.milliseconds / static_cast< float32_t >( bitmapTotal.characterCount ) )
+			: 0.0f ) );
+
+	return true;
+}
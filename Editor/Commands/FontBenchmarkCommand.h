@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Application/CmdLineProcessor.h"
+
+namespace Helium
+{
+    namespace Editor
+    {
+        class FontBenchmarkCommand : public Helium::CommandLine::Command
+        {
+        public:
+            FontBenchmarkCommand();
+
+            virtual bool Initialize( std::string& error ) HELIUM_OVERRIDE;
+            virtual bool Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error ) HELIUM_OVERRIDE;
+
+        private:
+            std::string m_FileName;
+            std::string m_PointSize;
+            std::string m_SizeCount;
+            std::string m_SheetSize;
+        };
+    }
+}
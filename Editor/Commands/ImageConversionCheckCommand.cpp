@@ -0,0 +1,215 @@
+#include "EditorPch.h"
+#include "ImageConversionCheckCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Foundation/Log.h"
+
+#include "Application/InitializerStack.h"
+
+#include "Engine/WorkerPool.h"
+
+#include "EditorSupport/Image.h"
+
+#include <algorithm>
+#include <string.h>
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	// Every this many images, a large image is converted so that the conversion is split across the shared worker pool.
+	const int CHECK_LARGE_IMAGE_INTERVAL = 16;
+	// Size of the large images (large enough to be split into bands of rows).
+	const uint32_t CHECK_LARGE_IMAGE_WIDTH = 1024;
+	const uint32_t CHECK_LARGE_IMAGE_HEIGHT = 300;
+
+	// Pick a random direct color format.  Byte-aligned formats only use 8-bit channels at byte offsets (the formats
+	// handled by the byte shuffle fast paths), while other formats use any channel sizes packed at random positions.
+	void RandomizeFormat( uint32_t& rSeed, bool bByteAligned, uint8_t bytesPerPixel, Image::Format& rFormat )
+	{
+		rFormat = Image::Format();
+		rFormat.SetBytesPerPixel( bytesPerPixel );
+
+		Image::EChannel channels[ Image::CHANNEL_MAX ] = { Image::CHANNEL_RED, Image::CHANNEL_GREEN, Image::CHANNEL_BLUE, Image::CHANNEL_ALPHA };
+		for ( uint32_t channelIndex = Image::CHANNEL_MAX - 1; channelIndex > 0; --channelIndex )
+		{
+			std::swap( channels[ channelIndex ], channels[ NextRandom( rSeed ) % ( channelIndex + 1 ) ] );
+		}
+
+		uint32_t bitCountMax = static_cast< uint32_t >( bytesPerPixel ) * 8;
+		uint32_t bitOffset = 0;
+		for ( uint32_t channelIndex = 0; channelIndex < Image::CHANNEL_MAX; ++channelIndex )
+		{
+			uint32_t bitCount = ( bByteAligned ? ( NextRandom( rSeed ) % 4 != 0 ? 8 : 0 ) : NextRandom( rSeed ) % 9 );
+			if ( bitOffset + bitCount > bitCountMax )
+			{
+				bitCount = 0;
+			}
+
+			if ( bitCount != 0 )
+			{
+				rFormat.SetChannelBitCount( channels[ channelIndex ], static_cast< uint8_t >( bitCount ) );
+				rFormat.SetChannelBitOffset( channels[ channelIndex ], static_cast< uint8_t >( bitOffset ) );
+				bitOffset += bitCount;
+			}
+		}
+	}
+
+	// Get whether the pixels of two images of the same size and format are identical (ignoring any row padding).
+	bool ComparePixels( const Image& rImage0, const Image& rImage1, uint32_t& rMismatchX, uint32_t& rMismatchY )
+	{
+		HELIUM_ASSERT( rImage0.GetWidth() == rImage1.GetWidth() );
+		HELIUM_ASSERT( rImage0.GetHeight() == rImage1.GetHeight() );
+		HELIUM_ASSERT( rImage0.GetFormat().GetBytesPerPixel() == rImage1.GetFormat().GetBytesPerPixel() );
+
+		uint32_t bytesPerPixel = rImage0.GetFormat().GetBytesPerPixel();
+		uint32_t rowSize = rImage0.GetWidth() * bytesPerPixel;
+		for ( uint32_t y = 0; y < rImage0.GetHeight(); ++y )
+		{
+			const uint8_t* pRow0 = static_cast< const uint8_t* >( rImage0.GetPixelData() ) + static_cast< size_t >( y ) * rImage0.GetPitch();
+			const uint8_t* pRow1 = static_cast< const uint8_t* >( rImage1.GetPixelData() ) + static_cast< size_t >( y ) * rImage1.GetPitch();
+			if ( memcmp( pRow0, pRow1, rowSize ) != 0 )
+			{
+				uint32_t byteIndex = 0;
+				while ( pRow0[ byteIndex ] == pRow1[ byteIndex ] )
+				{
+					++byteIndex;
+				}
+
+				rMismatchX = byteIndex / bytesPerPixel;
+				rMismatchY = y;
+
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void PrintFormat( const char* pLabel, const Image::Format& rFormat )
+	{
+		Log::Print(
+			TXT( "  %s: %u bytes per pixel, RGBA bit counts %u %u %u %u, bit offsets %u %u %u %u\n" ),
+			pLabel,
+			rFormat.GetBytesPerPixel(),
+			rFormat.GetChannelBitCount( Image::CHANNEL_RED ),
+			rFormat.GetChannelBitCount( Image::CHANNEL_GREEN ),
+			rFormat.GetChannelBitCount( Image::CHANNEL_BLUE ),
+			rFormat.GetChannelBitCount( Image::CHANNEL_ALPHA ),
+			rFormat.GetChannelBitOffset( Image::CHANNEL_RED ),
+			rFormat.GetChannelBitOffset( Image::CHANNEL_GREEN ),
+			rFormat.GetChannelBitOffset( Image::CHANNEL_BLUE ),
+			rFormat.GetChannelBitOffset( Image::CHANNEL_ALPHA ) );
+	}
+}
+
+ImageConversionCheckCommand::ImageConversionCheckCommand()
+	: Command( TXT( "imageconvertcheck" ), TXT( "" ), TXT( "Convert random images between random pixel formats with the image conversion fast paths (byte shuffles, SSE, and banded conversion) and the general conversion loop, and check that the results match byte for byte" ) )
+{
+
+}
+
+bool ImageConversionCheckCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_ImageCount, TXT( "i|images" ), TXT( "<COUNT>" ), TXT( "number of images to convert (defaults to 2000)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_MaxSize, TXT( "s|size" ), TXT( "<SIZE>" ), TXT( "maximum width and height of the small images (defaults to 67)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_Seed, TXT( "r|seed" ), TXT( "<SEED>" ), TXT( "random number seed (defaults to 1)" ) ), error );
+	return success;
+}
+
+bool ImageConversionCheckCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	int imageCount, maxSize, seedOption;
+	if ( !ParseCountOption( m_ImageCount, TXT( "image count" ), 2000, 1, 1 << 24, imageCount, error ) ||
+		!ParseCountOption( m_MaxSize, TXT( "image size" ), 67, 1, 4096, maxSize, error ) ||
+		!ParseCountOption( m_Seed, TXT( "seed" ), 1, 0, 0x7fffffff, seedOption, error ) )
+	{
+		return false;
+	}
+
+	// Start the shared worker pool so that large images are converted in bands, as they are when cooking textures.
+	InitializerStack initializerStack( true );
+	initializerStack.Push( WorkerPool::Startup, WorkerPool::Shutdown );
+
+	Log::Print( TXT( "Checking %d image conversions (seed %d)...\n" ), imageCount, seedOption );
+
+	uint32_t seed = static_cast< uint32_t >( seedOption );
+	DynamicArray< uint8_t > sourceData;
+	int byteAlignedCount = 0;
+	int largeCount = 0;
+	for ( int imageIndex = 0; imageIndex < imageCount; ++imageIndex )
+	{
+		// Most conversions use byte-aligned formats, a third of them between 32-bit formats (the SSE path).
+		bool bByteAligned = ( NextRandom( seed ) % 4 != 0 );
+		bool bFourBytes = bByteAligned && ( NextRandom( seed ) % 3 == 0 );
+
+		Image::Format sourceFormat;
+		Image::Format destFormat;
+		RandomizeFormat( seed, bByteAligned, static_cast< uint8_t >( bFourBytes ? 4 : 1 + NextRandom( seed ) % 4 ), sourceFormat );
+		RandomizeFormat( seed, bByteAligned, static_cast< uint8_t >( bFourBytes ? 4 : 1 + NextRandom( seed ) % 4 ), destFormat );
+
+		bool bLarge = ( ( imageIndex + 1 ) % CHECK_LARGE_IMAGE_INTERVAL == 0 );
+
+		Image::InitParameters parameters;
+		parameters.format = sourceFormat;
+		parameters.width = ( bLarge ? CHECK_LARGE_IMAGE_WIDTH : 1 + NextRandom( seed ) % static_cast< uint32_t >( maxSize ) );
+		parameters.height = ( bLarge ? CHECK_LARGE_IMAGE_HEIGHT : 1 + NextRandom( seed ) % static_cast< uint32_t >( maxSize ) );
+		parameters.pitch = parameters.width * sourceFormat.GetBytesPerPixel() + NextRandom( seed ) % 8;
+
+		sourceData.Resize( static_cast< size_t >( parameters.pitch ) * parameters.height );
+		for ( size_t byteIndex = 0; byteIndex < sourceData.GetSize(); ++byteIndex )
+		{
+			sourceData[ byteIndex ] = static_cast< uint8_t >( NextRandom( seed ) );
+		}
+
+		parameters.pPixelData = sourceData.GetData();
+
+		Image sourceImage;
+		Image fastImage;
+		Image referenceImage;
+		if ( !sourceImage.Initialize( parameters ) ||
+			!sourceImage.Convert( fastImage, destFormat ) ||
+			!sourceImage.ConvertReference( referenceImage, destFormat ) )
+		{
+			error = TXT( "Failed to initialize or convert a test image" );
+			return false;
+		}
+
+		uint32_t mismatchX = 0;
+		uint32_t mismatchY = 0;
+		if ( !ComparePixels( fastImage, referenceImage, mismatchX, mismatchY ) )
+		{
+			Log::Print(
+				TXT( "Image %d (%ux%u) differs from the reference conversion at pixel (%u, %u):\n" ),
+				imageIndex,
+				parameters.width,
+				parameters.height,
+				mismatchX,
+				mismatchY );
+			PrintFormat( TXT( "source" ), sourceFormat );
+			PrintFormat( TXT( "destination" ), destFormat );
+
+			error = TXT( "Image conversion fast path output does not match the reference conversion" );
+			return false;
+		}
+
+		byteAlignedCount += ( bByteAligned ? 1 : 0 );
+		largeCount += ( bLarge ? 1 : 0 );
+	}
+
+	Log::Print(
+		TXT( "All %d conversions matched (%d between byte-aligned formats, %d large images).\n" ),
+		imageCount,
+		byteAlignedCount,
+		largeCount );
+
+	return true;
+}
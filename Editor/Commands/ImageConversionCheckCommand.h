@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Application/CmdLineProcessor.h"
+
+namespace Helium
+{
+    namespace Editor
+    {
+        class ImageConversionCheckCommand : public Helium::CommandLine::Command
+        {
+        public:
+            ImageConversionCheckCommand();
+
+            virtual bool Initialize( std::string& error ) HELIUM_OVERRIDE;
+            virtual bool Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error ) HELIUM_OVERRIDE;
+
+        private:
+            std::string m_ImageCount;
+            std::string m_MaxSize;
+            std::string m_Seed;
+        };
+    }
+}
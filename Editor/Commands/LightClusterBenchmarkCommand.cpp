@@ -0,0 +1,162 @@
+#include "EditorPch.h"
+#include "LightClusterBenchmarkCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Platform/Timer.h"
+
+#include "Foundation/Log.h"
+
+#include "Graphics/LightClusterGrid.h"
+
+#include <math.h>
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	const float32_t BENCHMARK_HORIZONTAL_FOV_DEGREES = 90.0f;
+	const float32_t BENCHMARK_ASPECT_RATIO = 16.0f / 9.0f;
+	const float32_t BENCHMARK_NEAR_CLIP = 0.1f;
+	const float32_t BENCHMARK_FAR_CLIP = 1000.0f;
+	const float32_t BENCHMARK_FIELD_EXTENT = 400.0f;
+	const float32_t BENCHMARK_FRAME_SECONDS = 1.0f / 60.0f;
+
+	// Placement and motion of a synthesized light.
+	struct BenchmarkLight
+	{
+		float32_t x, y, z;
+		float32_t radius;
+		float32_t phase;
+	};
+}
+
+LightClusterBenchmarkCommand::LightClusterBenchmarkCommand()
+	: Command( TXT( "lightbench" ), TXT( "" ), TXT( "Assign thousands of moving lights to light clusters without a window or renderer and report the assignment throughput" ) )
+{
+
+}
+
+bool LightClusterBenchmarkCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_LightCount, TXT( "l|lights" ), TXT( "<COUNT>" ), TXT( "number of lights in the scene (defaults to 4096)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_FrameCount, TXT( "f|frames" ), TXT( "<COUNT>" ), TXT( "number of frames to assign (defaults to 300)" ) ), error );
+	return success;
+}
+
+bool LightClusterBenchmarkCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	int lightCount, frameCount;
+	if ( !ParseCountOption( m_LightCount, TXT( "light count" ), 4096, 1, 1 << 20, lightCount, error ) ||
+		!ParseCountOption( m_FrameCount, TXT( "frame count" ), 300, 1, 1 << 20, frameCount, error ) )
+	{
+		return false;
+	}
+
+	// Scatter lights through a field in front of the camera, most of which lies outside the view frustum, as would be
+	// the case when moving through a large level.
+	DynamicArray< BenchmarkLight > lights;
+	lights.Reserve( lightCount );
+
+	uint32_t seed = 12345;
+	for ( int lightIndex = 0; lightIndex < lightCount; ++lightIndex )
+	{
+		BenchmarkLight light;
+		light.x = NextRandomFloat( seed, -0.5f, 0.5f ) * BENCHMARK_FIELD_EXTENT;
+		light.y = NextRandomFloat( seed, -0.125f, 0.125f ) * BENCHMARK_FIELD_EXTENT;
+		light.z = NextRandomFloat( seed, 0.0f, BENCHMARK_FIELD_EXTENT );
+		light.radius = NextRandomFloat( seed, 2.0f, 16.0f );
+		light.phase = NextRandomFloat( seed, 0.0f, 6.2831853f );
+		lights.Push( light );
+	}
+
+	Simd::Matrix44 projection;
+	projection.SetPerspectiveProjection(
+		BENCHMARK_HORIZONTAL_FOV_DEGREES * static_cast< float32_t >( HELIUM_DEG_TO_RAD ),
+		BENCHMARK_ASPECT_RATIO,
+		BENCHMARK_NEAR_CLIP,
+		BENCHMARK_FAR_CLIP );
+
+	LightClusterGrid* pGrid = new LightClusterGrid;
+	HELIUM_ASSERT( pGrid );
+
+	Log::Print(
+		TXT( "Assigning %d lights to %u light clusters for %d frames...\n" ),
+		lightCount,
+		LightClusterGrid::CLUSTER_COUNT,
+		frameCount );
+
+	float32_t totalMilliseconds = 0.0f;
+	float32_t minMilliseconds = 0.0f;
+	float32_t maxMilliseconds = 0.0f;
+	uint64_t totalInViewLights = 0;
+	uint64_t totalAssignedLights = 0;
+	uint64_t totalDroppedLights = 0;
+	uint32_t maxDroppedLights = 0;
+	uint64_t totalLightIndices = 0;
+	uint64_t totalOccupiedClusters = 0;
+	for ( int frameIndex = 0; frameIndex < frameCount; ++frameIndex )
+	{
+		float32_t time = static_cast< float32_t >( frameIndex ) * BENCHMARK_FRAME_SECONDS;
+
+		uint64_t frameStartTicks = Timer::GetTickCount();
+
+		pGrid->Begin( projection, BENCHMARK_NEAR_CLIP, BENCHMARK_FAR_CLIP );
+		for ( size_t lightIndex = 0; lightIndex < lights.GetSize(); ++lightIndex )
+		{
+			const BenchmarkLight& rLight = lights[ lightIndex ];
+			Simd::Vector3 center(
+				rLight.x + sinf( time + rLight.phase ) * 4.0f,
+				rLight.y,
+				rLight.z + cosf( time + rLight.phase ) * 4.0f );
+			pGrid->AddLight( center, rLight.radius );
+		}
+		pGrid->End();
+
+		float32_t frameMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - frameStartTicks ) );
+		totalMilliseconds += frameMilliseconds;
+		minMilliseconds = ( frameIndex == 0 ? frameMilliseconds : Min( minMilliseconds, frameMilliseconds ) );
+		maxMilliseconds = Max( maxMilliseconds, frameMilliseconds );
+
+		HELIUM_ASSERT( pGrid->GetLightCount() <= LightClusterGrid::VISIBLE_LIGHT_COUNT_MAX );
+		totalInViewLights += pGrid->GetAddedLightCount();
+		totalAssignedLights += pGrid->GetLightCount();
+		totalDroppedLights += pGrid->GetDroppedLightCount();
+		maxDroppedLights = Max( maxDroppedLights, pGrid->GetDroppedLightCount() );
+		totalLightIndices += pGrid->GetLightIndexCount();
+		totalOccupiedClusters += pGrid->GetOccupiedClusterCount();
+	}
+
+	float32_t averageMilliseconds = totalMilliseconds / static_cast< float32_t >( frameCount );
+	float32_t lightsPerSecond = ( averageMilliseconds > 0.0f ? static_cast< float32_t >( lightCount ) * 1000.0f / averageMilliseconds : 0.0f );
+	float32_t frameCountFloat = static_cast< float32_t >( frameCount );
+
+	Log::Print(
+		TXT( "Frame time: %.3f ms average, %.3f ms min, %.3f ms max.\n" ),
+		averageMilliseconds,
+		minMilliseconds,
+		maxMilliseconds );
+	Log::Print(
+		TXT( "Per frame: %.1f lights in view, %.1f lights assigned (of %u maximum), %.1f lights dropped (%u max).\n" ),
+		static_cast< float32_t >( totalInViewLights ) / frameCountFloat,
+		static_cast< float32_t >( totalAssignedLights ) / frameCountFloat,
+		LightClusterGrid::VISIBLE_LIGHT_COUNT_MAX,
+		static_cast< float32_t >( totalDroppedLights ) / frameCountFloat,
+		maxDroppedLights );
+	Log::Print(
+		TXT( "Per frame: %.1f cluster entries, %.1f occupied clusters.\n" ),
+		static_cast< float32_t >( totalLightIndices ) / frameCountFloat,
+		static_cast< float32_t >( totalOccupiedClusters ) / frameCountFloat );
+	Log::Print( TXT( "Throughput: %.0f lights/s.\n" ), lightsPerSecond );
+
+	delete pGrid;
+
+	return true;
+}
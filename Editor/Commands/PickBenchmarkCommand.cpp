@@ -0,0 +1,246 @@
+#include "EditorPch.h"
+#include "PickBenchmarkCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Platform/Timer.h"
+
+#include "Foundation/Log.h"
+
+#include "Math/Line.h"
+
+#include "EditorScene/BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	// Size of the cube over which nodes are scattered.
+	const float32_t BENCHMARK_WORLD_SIZE = 1000.0f;
+	// Maximum half extent of each node's bounds.
+	const float32_t BENCHMARK_NODE_EXTENT_MAX = 2.0f;
+	// Maximum distance a moving node travels between picks.
+	const float32_t BENCHMARK_MOVE_DISTANCE_MAX = 0.5f;
+	// Number of picks between each round of node movement.
+	const int BENCHMARK_PICKS_PER_FRAME = 10;
+
+	AlignedBox MakeBox( const Vector3& rCenter, float32_t extent )
+	{
+		AlignedBox box;
+		box.minimum = Vector3( rCenter.x - extent, rCenter.y - extent, rCenter.z - extent );
+		box.maximum = Vector3( rCenter.x + extent, rCenter.y + extent, rCenter.z + extent );
+		return box;
+	}
+
+	// A pick ray from outside the world through a random point in it, as when clicking in a viewport.
+	Line MakePickLine( uint32_t& rSeed )
+	{
+		float32_t halfSize = BENCHMARK_WORLD_SIZE * 0.5f;
+		Vector3 origin( NextRandomFloat( rSeed, -halfSize, halfSize ), halfSize * 2.0f, NextRandomFloat( rSeed, -halfSize, halfSize ) );
+		Vector3 target( NextRandomFloat( rSeed, -halfSize, halfSize ), NextRandomFloat( rSeed, -halfSize, halfSize ), NextRandomFloat( rSeed, -halfSize, halfSize ) );
+		return Line( origin, target );
+	}
+
+	// Tests boxes from the picking hierarchy against a pick ray, as Scene::Pick() does through the pick visitor.
+	struct LinePickTest
+	{
+		const Line* m_Line;
+
+		LinePickTest( const Line* line )
+			: m_Line( line )
+		{
+
+		}
+
+		bool operator()( const AlignedBox& box ) const
+		{
+			return m_Line->IntersectsBox( box );
+		}
+	};
+
+	// Timing and candidate statistics for one scene size.
+	struct PickResult
+	{
+		float32_t buildMilliseconds;
+		float32_t updateMilliseconds;
+		float32_t linearMilliseconds;
+		float32_t hierarchyMilliseconds;
+		uint64_t hitCount;
+		uint64_t candidateCount;
+		uint64_t restructureCount;
+		int32_t height;
+	};
+
+	// Scatter nodes over the world, then interleave node movement with picks, picking every pick both by testing every
+	// node (as picking did before the scene kept a hierarchy) and by querying the hierarchy.
+	bool RunPicks( int nodeCount, int pickCount, int movingPercent, PickResult& rResult )
+	{
+		MemoryZero( &rResult, sizeof( rResult ) );
+
+		uint32_t seed = 12345;
+		float32_t halfSize = BENCHMARK_WORLD_SIZE * 0.5f;
+
+		std::vector< Vector3 > centers;
+		std::vector< float32_t > extents;
+		std::vector< AlignedBox > boxes;
+		centers.reserve( nodeCount );
+		extents.reserve( nodeCount );
+		boxes.reserve( nodeCount );
+		for ( int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex )
+		{
+			centers.push_back( Vector3( NextRandomFloat( seed, -halfSize, halfSize ), NextRandomFloat( seed, -halfSize, halfSize ), NextRandomFloat( seed, -halfSize, halfSize ) ) );
+			extents.push_back( NextRandomFloat( seed, 0.1f, BENCHMARK_NODE_EXTENT_MAX ) );
+			boxes.push_back( MakeBox( centers.back(), extents.back() ) );
+		}
+
+		BoundingVolumeHierarchy hierarchy;
+		std::vector< int32_t > proxies;
+		proxies.reserve( nodeCount );
+
+		uint64_t buildStartTicks = Timer::GetTickCount();
+		for ( int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex )
+		{
+			proxies.push_back( hierarchy.Insert( boxes[ nodeIndex ], &boxes[ nodeIndex ] ) );
+		}
+		rResult.buildMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - buildStartTicks ) );
+
+		int movingCount = static_cast< int >( static_cast< int64_t >( nodeCount ) * movingPercent / 100 );
+
+		std::vector< void* > linearHits;
+		std::vector< void* > candidates;
+		uint64_t updateTicks = 0;
+		uint64_t linearTicks = 0;
+		uint64_t hierarchyTicks = 0;
+		for ( int pickIndex = 0; pickIndex < pickCount; ++pickIndex )
+		{
+			if ( pickIndex % BENCHMARK_PICKS_PER_FRAME == 0 && movingCount != 0 )
+			{
+				uint64_t updateStartTicks = Timer::GetTickCount();
+				for ( int moveIndex = 0; moveIndex < movingCount; ++moveIndex )
+				{
+					int nodeIndex = static_cast< int >( NextRandom( seed ) % static_cast< uint32_t >( nodeCount ) );
+					Vector3& rCenter = centers[ nodeIndex ];
+					rCenter.x += NextRandomFloat( seed, -BENCHMARK_MOVE_DISTANCE_MAX, BENCHMARK_MOVE_DISTANCE_MAX );
+					rCenter.y += NextRandomFloat( seed, -BENCHMARK_MOVE_DISTANCE_MAX, BENCHMARK_MOVE_DISTANCE_MAX );
+					rCenter.z += NextRandomFloat( seed, -BENCHMARK_MOVE_DISTANCE_MAX, BENCHMARK_MOVE_DISTANCE_MAX );
+					boxes[ nodeIndex ] = MakeBox( rCenter, extents[ nodeIndex ] );
+
+					if ( hierarchy.Update( proxies[ nodeIndex ], boxes[ nodeIndex ] ) )
+					{
+						++rResult.restructureCount;
+					}
+				}
+				updateTicks += Timer::GetTickCount() - updateStartTicks;
+			}
+
+			Line line = MakePickLine( seed );
+
+			uint64_t linearStartTicks = Timer::GetTickCount();
+			linearHits.clear();
+			for ( int nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex )
+			{
+				if ( line.IntersectsBox( boxes[ nodeIndex ] ) )
+				{
+					linearHits.push_back( &boxes[ nodeIndex ] );
+				}
+			}
+			linearTicks += Timer::GetTickCount() - linearStartTicks;
+
+			uint64_t hierarchyStartTicks = Timer::GetTickCount();
+			candidates.clear();
+			hierarchy.Query( LinePickTest( &line ), candidates );
+			hierarchyTicks += Timer::GetTickCount() - hierarchyStartTicks;
+
+			// The hierarchy stores enlarged boxes, so it may return extra candidates (which the per-node pick tests
+			// reject), but it must never miss a node the ray actually hits.
+			std::sort( candidates.begin(), candidates.end() );
+			for ( size_t hitIndex = 0; hitIndex < linearHits.size(); ++hitIndex )
+			{
+				if ( !std::binary_search( candidates.begin(), candidates.end(), linearHits[ hitIndex ] ) )
+				{
+					return false;
+				}
+			}
+
+			rResult.hitCount += linearHits.size();
+			rResult.candidateCount += candidates.size();
+		}
+
+		rResult.updateMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( updateTicks ) );
+		rResult.linearMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( linearTicks ) );
+		rResult.hierarchyMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( hierarchyTicks ) );
+		rResult.height = hierarchy.GetHeight();
+
+		return true;
+	}
+}
+
+PickBenchmarkCommand::PickBenchmarkCommand()
+	: Command( TXT( "pickbench" ), TXT( "" ), TXT( "Pick scenes of moving nodes by testing every node and by querying the scene picking hierarchy, and report the cost of each" ) )
+{
+
+}
+
+bool PickBenchmarkCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_NodeCount, TXT( "n|nodes" ), TXT( "<COUNT>" ), TXT( "number of nodes in the largest scene; a scene a tenth of the size is picked as well (defaults to 100000)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_PickCount, TXT( "p|picks" ), TXT( "<COUNT>" ), TXT( "number of picks in each scene (defaults to 1000)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_MovingPercent, TXT( "m|moving" ), TXT( "<PERCENT>" ), TXT( "percentage of the nodes moved between every ten picks (defaults to 1)" ) ), error );
+	return success;
+}
+
+bool PickBenchmarkCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	int nodeCount, pickCount, movingPercent;
+	if ( !ParseCountOption( m_NodeCount, TXT( "node count" ), 100000, 1, 1 << 22, nodeCount, error ) ||
+		!ParseCountOption( m_PickCount, TXT( "pick count" ), 1000, 1, 1 << 24, pickCount, error ) ||
+		!ParseCountOption( m_MovingPercent, TXT( "moving percentage" ), 1, 0, 100, movingPercent, error ) )
+	{
+		return false;
+	}
+
+	int sceneNodeCounts[ 2 ] = { nodeCount / 10, nodeCount };
+	for ( size_t sceneIndex = 0; sceneIndex < HELIUM_ARRAY_COUNT( sceneNodeCounts ); ++sceneIndex )
+	{
+		int sceneNodeCount = sceneNodeCounts[ sceneIndex ];
+		if ( sceneNodeCount == 0 )
+		{
+			continue;
+		}
+
+		PickResult result;
+		if ( !RunPicks( sceneNodeCount, pickCount, movingPercent, result ) )
+		{
+			error = TXT( "The picking hierarchy missed a node hit by a pick." );
+			return false;
+		}
+
+		float32_t pickCountFloat = static_cast< float32_t >( pickCount );
+		float32_t linearPickMilliseconds = result.linearMilliseconds / pickCountFloat;
+		float32_t hierarchyPickMilliseconds = result.hierarchyMilliseconds / pickCountFloat;
+
+		Log::Print( TXT( "%d nodes: built hierarchy in %.3f ms (height %d).\n" ), sceneNodeCount, result.buildMilliseconds, result.height );
+		Log::Print(
+			TXT( "  Per pick: %.4f ms testing every node, %.4f ms querying the hierarchy (%.1fx), %.1f hits, %.1f candidates.\n" ),
+			linearPickMilliseconds,
+			hierarchyPickMilliseconds,
+			( hierarchyPickMilliseconds > 0.0f ? linearPickMilliseconds / hierarchyPickMilliseconds : 0.0f ),
+			static_cast< float32_t >( result.hitCount ) / pickCountFloat,
+			static_cast< float32_t >( result.candidateCount ) / pickCountFloat );
+		Log::Print(
+			TXT( "  Node movement: %.3f ms total, %" ) PRIu64 TXT( " hierarchy changes.\n" ),
+			result.updateMilliseconds,
+			result.restructureCount );
+	}
+
+	return true;
+}
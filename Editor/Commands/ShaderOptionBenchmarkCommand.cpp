@@ -0,0 +1,215 @@
+#include "EditorPch.h"
+#include "ShaderOptionBenchmarkCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Platform/Timer.h"
+
+#include "Foundation/Log.h"
+
+#include "Graphics/Shader.h"
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	// Number of distinct option combinations requested during the benchmark.
+	const size_t BENCHMARK_REQUEST_COUNT = 256;
+	// Number of choices for each of the synthesized selections.
+	const size_t BENCHMARK_SELECT_CHOICE_COUNT = 3;
+	// Number of synthesized selections (the first one is optional).
+	const size_t BENCHMARK_SELECT_COUNT = 2;
+
+	// Option names requested for a single variant lookup.
+	struct BenchmarkRequest
+	{
+		DynamicArray< Name > toggleNames;
+		Shader::SelectPair selectPairs[ BENCHMARK_SELECT_COUNT ];
+		Shader::Options::OptionMask optionMask;
+	};
+}
+
+ShaderOptionBenchmarkCommand::ShaderOptionBenchmarkCommand()
+	: Command( TXT( "shaderoptionbench" ), TXT( "" ), TXT( "Resolve shader variant indices for a shader with many toggles using option names and precomputed option masks, and compare the lookup throughput" ) )
+{
+
+}
+
+bool ShaderOptionBenchmarkCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_ToggleCount, TXT( "t|toggles" ), TXT( "<COUNT>" ), TXT( "number of shader toggles (defaults to 24, at most 26)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_LookupCount, TXT( "n|lookups" ), TXT( "<COUNT>" ), TXT( "number of variant lookups for each method (defaults to 1000000)" ) ), error );
+	return success;
+}
+
+bool ShaderOptionBenchmarkCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	// The toggle limit keeps the option set count within 32 bits when combined with the selections.
+	int toggleCount, lookupCount;
+	if ( !ParseCountOption( m_ToggleCount, TXT( "toggle count" ), 24, 1, 26, toggleCount, error ) ||
+		!ParseCountOption( m_LookupCount, TXT( "lookup count" ), 1000000, 1, 1 << 30, lookupCount, error ) )
+	{
+		return false;
+	}
+
+	// Synthesize a set of shader options, with some toggles only applying to one shader type as is common for real
+	// shaders.
+	Shader::Options options;
+
+	DynamicArray< Shader::Toggle >& rToggles = options.GetToggles();
+	for ( int toggleIndex = 0; toggleIndex < toggleCount; ++toggleIndex )
+	{
+		String nameString;
+		nameString.Format( TXT( "TOGGLE_%d" ), toggleIndex );
+
+		Shader::Toggle* pToggle = rToggles.New();
+		HELIUM_ASSERT( pToggle );
+		pToggle->name = Name( nameString );
+		pToggle->shaderTypeFlags = ( toggleIndex % 4 == 3 ? ( 1 << RShader::TYPE_PIXEL ) : ( 1 << RShader::TYPE_MAX ) - 1 );
+	}
+
+	DynamicArray< Shader::Select >& rSelects = options.GetSelects();
+	for ( size_t selectIndex = 0; selectIndex < BENCHMARK_SELECT_COUNT; ++selectIndex )
+	{
+		String nameString;
+		nameString.Format( TXT( "SELECT_%" ) PRIuSZ, selectIndex );
+
+		Shader::Select* pSelect = rSelects.New();
+		HELIUM_ASSERT( pSelect );
+		pSelect->name = Name( nameString );
+		pSelect->allFlags = 0;
+		pSelect->shaderTypeFlags = ( 1 << RShader::TYPE_MAX ) - 1;
+		pSelect->bOptional = ( selectIndex == 0 );
+
+		for ( size_t choiceIndex = 0; choiceIndex < BENCHMARK_SELECT_CHOICE_COUNT; ++choiceIndex )
+		{
+			nameString.Format( TXT( "SELECT_%" ) PRIuSZ TXT( "_CHOICE_%" ) PRIuSZ, selectIndex, choiceIndex );
+			HELIUM_VERIFY( pSelect->choices.New( Name( nameString ) ) );
+		}
+	}
+
+	uint64_t compileStartTicks = Timer::GetTickCount();
+	options.CompileOptionMasks();
+	float32_t compileMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - compileStartTicks ) );
+
+	// Build a set of requests enabling roughly half of the toggles each, and precompute the option mask for each
+	// request as materials and the graphics scene do.
+	DynamicArray< BenchmarkRequest > requests;
+	requests.Resize( BENCHMARK_REQUEST_COUNT );
+
+	uint32_t seed = 12345;
+	for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+	{
+		BenchmarkRequest& rRequest = requests[ requestIndex ];
+		for ( int toggleIndex = 0; toggleIndex < toggleCount; ++toggleIndex )
+		{
+			if ( NextRandom( seed ) & 1 )
+			{
+				rRequest.toggleNames.Push( rToggles[ toggleIndex ].name );
+			}
+		}
+
+		for ( size_t selectIndex = 0; selectIndex < BENCHMARK_SELECT_COUNT; ++selectIndex )
+		{
+			const Shader::Select& rSelect = rSelects[ selectIndex ];
+			size_t choiceIndex = NextRandom( seed ) % ( BENCHMARK_SELECT_CHOICE_COUNT + 1 );
+			rRequest.selectPairs[ selectIndex ] = Shader::SelectPair(
+				rSelect.name,
+				( choiceIndex < BENCHMARK_SELECT_CHOICE_COUNT ? rSelect.choices[ choiceIndex ] : Name( NULL_NAME ) ) );
+		}
+	}
+
+	uint64_t maskStartTicks = Timer::GetTickCount();
+	for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+	{
+		BenchmarkRequest& rRequest = requests[ requestIndex ];
+		rRequest.optionMask = options.GetOptionMask(
+			rRequest.toggleNames.GetData(),
+			rRequest.toggleNames.GetSize(),
+			rRequest.selectPairs,
+			BENCHMARK_SELECT_COUNT );
+	}
+	float32_t maskMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - maskStartTicks ) );
+
+	// Make sure both lookup methods agree before timing them.
+	size_t mismatchCount = 0;
+	for ( size_t requestIndex = 0; requestIndex < BENCHMARK_REQUEST_COUNT; ++requestIndex )
+	{
+		const BenchmarkRequest& rRequest = requests[ requestIndex ];
+		for ( size_t shaderTypeIndex = 0; shaderTypeIndex < static_cast< size_t >( RShader::TYPE_MAX ); ++shaderTypeIndex )
+		{
+			RShader::EType shaderType = static_cast< RShader::EType >( shaderTypeIndex );
+			size_t nameIndex = options.GetOptionSetIndex(
+				shaderType,
+				rRequest.toggleNames.GetData(),
+				rRequest.toggleNames.GetSize(),
+				rRequest.selectPairs,
+				BENCHMARK_SELECT_COUNT );
+			size_t maskIndex = options.GetOptionSetIndex( shaderType, rRequest.optionMask );
+			if ( nameIndex != maskIndex )
+			{
+				++mismatchCount;
+			}
+		}
+	}
+
+	Log::Print(
+		TXT( "Resolving %d variant lookups for a shader with %d toggles and %" ) PRIuSZ TXT( " selections (%" ) PRIuSZ TXT( " vertex and %" ) PRIuSZ TXT( " pixel variants)...\n" ),
+		lookupCount,
+		toggleCount,
+		BENCHMARK_SELECT_COUNT,
+		options.ComputeOptionSetCount( RShader::TYPE_VERTEX ),
+		options.ComputeOptionSetCount( RShader::TYPE_PIXEL ) );
+
+	size_t checksum = 0;
+
+	uint64_t nameStartTicks = Timer::GetTickCount();
+	for ( int lookupIndex = 0; lookupIndex < lookupCount; ++lookupIndex )
+	{
+		const BenchmarkRequest& rRequest = requests[ static_cast< size_t >( lookupIndex ) % BENCHMARK_REQUEST_COUNT ];
+		checksum += options.GetOptionSetIndex(
+			static_cast< RShader::EType >( lookupIndex & 1 ),
+			rRequest.toggleNames.GetData(),
+			rRequest.toggleNames.GetSize(),
+			rRequest.selectPairs,
+			BENCHMARK_SELECT_COUNT );
+	}
+	float32_t nameMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - nameStartTicks ) );
+
+	uint64_t lookupStartTicks = Timer::GetTickCount();
+	for ( int lookupIndex = 0; lookupIndex < lookupCount; ++lookupIndex )
+	{
+		const BenchmarkRequest& rRequest = requests[ static_cast< size_t >( lookupIndex ) % BENCHMARK_REQUEST_COUNT ];
+		checksum -= options.GetOptionSetIndex( static_cast< RShader::EType >( lookupIndex & 1 ), rRequest.optionMask );
+	}
+	float32_t lookupMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - lookupStartTicks ) );
+
+	float32_t lookupCountFloat = static_cast< float32_t >( lookupCount );
+
+	Log::Print( TXT( "Option mask compile: %.3f ms; mask building: %.3f ms for %" ) PRIuSZ TXT( " requests.\n" ), compileMilliseconds, maskMilliseconds, BENCHMARK_REQUEST_COUNT );
+	Log::Print(
+		TXT( "Name lookups: %.3f ms (%.1f ns/lookup).\n" ),
+		nameMilliseconds,
+		nameMilliseconds * 1000000.0f / lookupCountFloat );
+	Log::Print(
+		TXT( "Mask lookups: %.3f ms (%.1f ns/lookup), %.1fx faster.\n" ),
+		lookupMilliseconds,
+		lookupMilliseconds * 1000000.0f / lookupCountFloat,
+		( lookupMilliseconds > 0.0f ? nameMilliseconds / lookupMilliseconds : 0.0f ) );
+
+	if ( mismatchCount != 0 || checksum != 0 )
+	{
+		Log::Print( TXT( "Mask lookups disagreed with name lookups for %" ) PRIuSZ TXT( " requests.\n" ), mismatchCount );
+		error = TXT( "Shader option mask lookups do not match name lookups" );
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,200 @@
+#include "EditorPch.h"
+#include "StateMachineBenchmarkCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Platform/Timer.h"
+
+#include "Foundation/Log.h"
+
+#include "Application/InitializerStack.h"
+
+#include "Framework/StateMachine.h"
+#include "Framework/World.h"
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	const float BENCHMARK_FRAME_SECONDS = 1.0f / 60.0f;
+	// Number of frames over which agents are spawned before timing starts, so that their timers are staggered.
+	const int BENCHMARK_SPAWN_FRAME_COUNT = 120;
+
+	// Add a timed transition to a state.
+	void AddTransition( State& rState, const char* pNextStateName, float minimumTimeInState )
+	{
+		StateTransition& rTransition = *rState.m_Transitions.New();
+		rTransition.m_NextStateName.Set( pNextStateName );
+		rTransition.m_MinimumTimeInState = minimumTimeInState;
+	}
+
+	// Build the states of a simple agent behavior driven entirely by timers.
+	void BuildBenchmarkStates( DynamicArray< State >& rStates )
+	{
+		State& rIdle = *rStates.New();
+		rIdle.m_StateName.Set( TXT( "Idle" ) );
+		AddTransition( rIdle, TXT( "Patrol" ), 2.0f );
+
+		State& rPatrol = *rStates.New();
+		rPatrol.m_StateName.Set( TXT( "Patrol" ) );
+		AddTransition( rPatrol, TXT( "Investigate" ), 5.0f );
+		AddTransition( rPatrol, TXT( "Idle" ), 7.5f );
+
+		State& rInvestigate = *rStates.New();
+		rInvestigate.m_StateName.Set( TXT( "Investigate" ) );
+		AddTransition( rInvestigate, TXT( "Chase" ), 1.5f );
+
+		State& rChase = *rStates.New();
+		rChase.m_StateName.Set( TXT( "Chase" ) );
+		AddTransition( rChase, TXT( "Attack" ), 3.0f );
+
+		State& rAttack = *rStates.New();
+		rAttack.m_StateName.Set( TXT( "Attack" ) );
+		AddTransition( rAttack, TXT( "Flee" ), 0.75f );
+
+		State& rFlee = *rStates.New();
+		rFlee.m_StateName.Set( TXT( "Flee" ) );
+		AddTransition( rFlee, TXT( "Idle" ), 4.0f );
+	}
+
+	// Report the frame time of a tick method.
+	void PrintResults( const char* pMethodName, int agentCount, int frameCount, float32_t totalMilliseconds )
+	{
+		float32_t averageMilliseconds = totalMilliseconds / static_cast< float32_t >( frameCount );
+		Log::Print(
+			TXT( "%s: %.3f ms per frame, %.0f agents/ms.\n" ),
+			pMethodName,
+			averageMilliseconds,
+			( averageMilliseconds > 0.0f ? static_cast< float32_t >( agentCount ) / averageMilliseconds : 0.0f ) );
+	}
+}
+
+StateMachineBenchmarkCommand::StateMachineBenchmarkCommand()
+	: Command( TXT( "statemachinebench" ), TXT( "" ), TXT( "Tick thousands of state machine instances one at a time and as a batch, and report the agents ticked per millisecond" ) )
+{
+
+}
+
+bool StateMachineBenchmarkCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_AgentCount, TXT( "a|agents" ), TXT( "<COUNT>" ), TXT( "number of state machine instances (defaults to 10000)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_FrameCount, TXT( "f|frames" ), TXT( "<COUNT>" ), TXT( "number of frames to tick (defaults to 600)" ) ), error );
+	return success;
+}
+
+bool StateMachineBenchmarkCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	int agentCount, frameCount;
+	if ( !ParseCountOption( m_AgentCount, TXT( "agent count" ), 10000, 1, 1 << 22, agentCount, error ) ||
+		!ParseCountOption( m_FrameCount, TXT( "frame count" ), 600, 1, 1 << 20, frameCount, error ) )
+	{
+		return false;
+	}
+
+	InitializerStack initializerStack;
+	initializerStack.Push( Name::Shutdown );
+	initializerStack.Push( AssetPath::Shutdown );
+	initializerStack.Push( Reflect::ObjectRefCountSupport::Shutdown );
+	initializerStack.Push( Asset::Shutdown );
+	initializerStack.Push( AssetType::Shutdown );
+	initializerStack.Push( Reflect::Initialize, Reflect::Cleanup );
+
+	StateMachineDefinitionPtr spDefinition = new StateMachineDefinition;
+	HELIUM_VERIFY( Asset::RegisterObject( spDefinition ) );
+
+	Asset::RenameParameters renameParameters;
+	renameParameters.name.Set( TXT( "StateMachineBenchmark" ) );
+	HELIUM_VERIFY( spDefinition->Rename( renameParameters ) );
+
+	DynamicArray< State > states;
+	BuildBenchmarkStates( states );
+	spDefinition->SetStates( states, Name( TXT( "Idle" ) ) );
+	spDefinition->FinalizeLoad();
+
+	WorldPtr spWorld = new World;
+
+	Log::Print(
+		TXT( "Ticking %d state machine instances with %" ) PRIuSZ TXT( " states for %d frames...\n" ),
+		agentCount,
+		states.GetSize(),
+		frameCount );
+
+	// Tick each instance separately.
+	DynamicArray< StateMachineInstance* > instances;
+	instances.Reserve( agentCount );
+
+	for ( int frameIndex = 0; frameIndex < BENCHMARK_SPAWN_FRAME_COUNT; ++frameIndex )
+	{
+		size_t targetAgentCount = static_cast< size_t >( agentCount ) * ( frameIndex + 1 ) / BENCHMARK_SPAWN_FRAME_COUNT;
+		while ( instances.GetSize() < targetAgentCount )
+		{
+			StateMachineInstance* pInstance = new StateMachineInstance;
+			HELIUM_ASSERT( pInstance );
+			pInstance->Initialize( *spWorld, spDefinition );
+			instances.Push( pInstance );
+		}
+
+		for ( size_t instanceIndex = 0; instanceIndex < instances.GetSize(); ++instanceIndex )
+		{
+			instances[ instanceIndex ]->Tick( *spWorld, BENCHMARK_FRAME_SECONDS );
+		}
+	}
+
+	uint64_t instanceStartTicks = Timer::GetTickCount();
+	for ( int frameIndex = 0; frameIndex < frameCount; ++frameIndex )
+	{
+		for ( size_t instanceIndex = 0; instanceIndex < instances.GetSize(); ++instanceIndex )
+		{
+			instances[ instanceIndex ]->Tick( *spWorld, BENCHMARK_FRAME_SECONDS );
+		}
+	}
+
+	float32_t instanceMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - instanceStartTicks ) );
+
+	for ( size_t instanceIndex = 0; instanceIndex < instances.GetSize(); ++instanceIndex )
+	{
+		delete instances[ instanceIndex ];
+	}
+
+	instances.Clear();
+
+	// Tick all instances together.
+	StateMachineBatch batch;
+	batch.Initialize( spDefinition );
+
+	for ( int frameIndex = 0; frameIndex < BENCHMARK_SPAWN_FRAME_COUNT; ++frameIndex )
+	{
+		size_t targetAgentCount = static_cast< size_t >( agentCount ) * ( frameIndex + 1 ) / BENCHMARK_SPAWN_FRAME_COUNT;
+		while ( batch.GetInstanceCount() < targetAgentCount )
+		{
+			batch.AddInstance( *spWorld );
+		}
+
+		batch.Tick( *spWorld, BENCHMARK_FRAME_SECONDS );
+	}
+
+	uint64_t batchStartTicks = Timer::GetTickCount();
+	for ( int frameIndex = 0; frameIndex < frameCount; ++frameIndex )
+	{
+		batch.Tick( *spWorld, BENCHMARK_FRAME_SECONDS );
+	}
+
+	float32_t batchMilliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - batchStartTicks ) );
+
+	batch.Shutdown();
+
+	PrintResults( TXT( "StateMachineInstance::Tick()" ), agentCount, frameCount, instanceMilliseconds );
+	PrintResults( TXT( "StateMachineBatch::Tick()" ), agentCount, frameCount, batchMilliseconds );
+
+	spWorld.Release();
+	spDefinition.Release();
+
+	return true;
+}
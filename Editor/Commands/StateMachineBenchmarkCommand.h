@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Application/CmdLineProcessor.h"
+
+namespace Helium
+{
+    namespace Editor
+    {
+        class StateMachineBenchmarkCommand : public Helium::CommandLine::Command
+        {
+        public:
+            StateMachineBenchmarkCommand();
+
+            virtual bool Initialize( std::string& error ) HELIUM_OVERRIDE;
+            virtual bool Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error ) HELIUM_OVERRIDE;
+
+        private:
+            std::string m_AgentCount;
+            std::string m_FrameCount;
+        };
+    }
+}
@@ -0,0 +1,171 @@
+#include "EditorPch.h"
+#include "TextureCompressionCheckCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Foundation/Log.h"
+
+#include "Application/InitializerStack.h"
+
+#include "Engine/WorkerPool.h"
+
+#include "EditorSupport/Texture2dResourceHandler.h"
+
+#include <string.h>
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	// Every this many images, a large image is compressed so that each of its top mip levels is split into several bands.
+	const int CHECK_LARGE_IMAGE_INTERVAL = 4;
+	// Size of the large images (not a multiple of the block size, so that the last band of each level is partial).
+	const uint32_t CHECK_LARGE_IMAGE_WIDTH = 258;
+	const uint32_t CHECK_LARGE_IMAGE_HEIGHT = 517;
+
+	// Fill a BGRA image with random gradients plus noise, so that blocks are neither flat nor pure noise.  Alpha is left
+	// fully opaque for some images, as the texture handler compresses those without alpha.
+	void FillImage( uint32_t& rSeed, uint32_t width, uint32_t height, bool bOpaque, DynamicArray< uint8_t >& rPixelData )
+	{
+		uint32_t baseColor = NextRandom( rSeed );
+		uint32_t noiseMask = ( 1u << ( NextRandom( rSeed ) % 7 ) ) - 1;
+
+		rPixelData.Resize( static_cast< size_t >( width ) * height * 4 );
+		uint8_t* pPixel = rPixelData.GetData();
+		for ( uint32_t y = 0; y < height; ++y )
+		{
+			for ( uint32_t x = 0; x < width; ++x, pPixel += 4 )
+			{
+				for ( uint32_t channelIndex = 0; channelIndex < 4; ++channelIndex )
+				{
+					uint32_t value = ( baseColor >> ( channelIndex * 6 ) ) + x * ( channelIndex + 1 ) + y * ( 4 - channelIndex );
+					pPixel[ channelIndex ] = static_cast< uint8_t >( value + ( NextRandom( rSeed ) & noiseMask ) );
+				}
+
+				if ( bOpaque )
+				{
+					pPixel[ 3 ] = 0xff;
+				}
+			}
+		}
+	}
+}
+
+TextureCompressionCheckCommand::TextureCompressionCheckCommand()
+	: Command( TXT( "texturecompresscheck" ), TXT( "" ), TXT( "Compress random textures with every compression setting both in bands on the shared worker pool and in a single nvtt pass, and check that the results match byte for byte" ) )
+{
+
+}
+
+bool TextureCompressionCheckCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_ImageCount, TXT( "i|images" ), TXT( "<COUNT>" ), TXT( "number of images to compress (defaults to 48)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_MaxSize, TXT( "s|size" ), TXT( "<SIZE>" ), TXT( "maximum width and height of the small images (defaults to 131)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_Seed, TXT( "r|seed" ), TXT( "<SEED>" ), TXT( "random number seed (defaults to 1)" ) ), error );
+	return success;
+}
+
+bool TextureCompressionCheckCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	int imageCount, maxSize, seedOption;
+	if ( !ParseCountOption( m_ImageCount, TXT( "image count" ), 48, 1, 1 << 20, imageCount, error ) ||
+		!ParseCountOption( m_MaxSize, TXT( "image size" ), 131, 1, 4096, maxSize, error ) ||
+		!ParseCountOption( m_Seed, TXT( "seed" ), 1, 0, 0x7fffffff, seedOption, error ) )
+	{
+		return false;
+	}
+
+	// Start the shared worker pool so that textures are compressed in bands, as they are when cooking.
+	InitializerStack initializerStack( true );
+	initializerStack.Push( WorkerPool::Startup, WorkerPool::Shutdown );
+
+	Log::Print( TXT( "Checking %d texture compressions (seed %d)...\n" ), imageCount, seedOption );
+
+	uint32_t seed = static_cast< uint32_t >( seedOption );
+	DynamicArray< uint8_t > pixelData;
+	DynamicArray< DynamicArray< uint8_t > > bandedMipLevels;
+	DynamicArray< DynamicArray< uint8_t > > referenceMipLevels;
+	size_t totalJobCount = 0;
+	size_t totalMipLevelCount = 0;
+	for ( int imageIndex = 0; imageIndex < imageCount; ++imageIndex )
+	{
+		bool bLarge = ( ( imageIndex + 1 ) % CHECK_LARGE_IMAGE_INTERVAL == 0 );
+		uint32_t width = ( bLarge ? CHECK_LARGE_IMAGE_WIDTH : 1 + NextRandom( seed ) % static_cast< uint32_t >( maxSize ) );
+		uint32_t height = ( bLarge ? CHECK_LARGE_IMAGE_HEIGHT : 1 + NextRandom( seed ) % static_cast< uint32_t >( maxSize ) );
+
+		// Cycle through the compression settings so that each one is covered evenly.
+		Texture::ECompression compression = static_cast< Texture::ECompression::Enum >( imageIndex % Texture::ECompression::MAX );
+		bool bSrgb = ( NextRandom( seed ) % 2 != 0 );
+		bool bCreateMipmaps = ( NextRandom( seed ) % 4 != 0 );
+		bool bIgnoreAlpha = ( NextRandom( seed ) % 2 != 0 );
+
+		FillImage( seed, width, height, bIgnoreAlpha, pixelData );
+
+		ERendererPixelFormat bandedPixelFormat = RENDERER_PIXEL_FORMAT_BC1;
+		ERendererPixelFormat referencePixelFormat = RENDERER_PIXEL_FORMAT_BC1;
+		size_t jobCount = 0;
+		if ( !Texture2dResourceHandler::CompressTexture( pixelData.GetData(), width, height, compression, bSrgb, bCreateMipmaps, bIgnoreAlpha, bandedMipLevels, bandedPixelFormat, jobCount ) ||
+			!Texture2dResourceHandler::CompressTextureReference( pixelData.GetData(), width, height, compression, bSrgb, bCreateMipmaps, bIgnoreAlpha, referenceMipLevels, referencePixelFormat ) )
+		{
+			error = TXT( "Failed to compress a test texture" );
+			return false;
+		}
+
+		// Find the first mip level that differs, if any.
+		size_t mipLevelCount = referenceMipLevels.GetSize();
+		size_t mismatchLevel = mipLevelCount;
+		if ( bandedMipLevels.GetSize() != mipLevelCount || bandedPixelFormat != referencePixelFormat )
+		{
+			mismatchLevel = 0;
+		}
+		else
+		{
+			for ( size_t levelIndex = 0; levelIndex < mipLevelCount; ++levelIndex )
+			{
+				const DynamicArray< uint8_t >& rBandedLevel = bandedMipLevels[ levelIndex ];
+				const DynamicArray< uint8_t >& rReferenceLevel = referenceMipLevels[ levelIndex ];
+				if ( rBandedLevel.GetSize() != rReferenceLevel.GetSize() ||
+					memcmp( rBandedLevel.GetData(), rReferenceLevel.GetData(), rReferenceLevel.GetSize() ) != 0 )
+				{
+					mismatchLevel = levelIndex;
+					break;
+				}
+			}
+		}
+
+		if ( mismatchLevel < mipLevelCount )
+		{
+			Log::Print(
+				TXT( "Texture %d (%ux%u, compression %d, sRGB %d, mipmaps %d, ignore alpha %d) differs from the single pass compression at mip level %u.\n" ),
+				imageIndex,
+				width,
+				height,
+				static_cast< int >( compression ),
+				bSrgb ? 1 : 0,
+				bCreateMipmaps ? 1 : 0,
+				bIgnoreAlpha ? 1 : 0,
+				static_cast< uint32_t >( mismatchLevel ) );
+
+			error = TXT( "Banded texture compression output does not match the single pass compression" );
+			return false;
+		}
+
+		totalJobCount += jobCount;
+		totalMipLevelCount += mipLevelCount;
+	}
+
+	Log::Print(
+		TXT( "All %d textures matched (%u mip levels compressed as %u banded jobs).\n" ),
+		imageCount,
+		static_cast< uint32_t >( totalMipLevelCount ),
+		static_cast< uint32_t >( totalJobCount ) );
+
+	return true;
+}
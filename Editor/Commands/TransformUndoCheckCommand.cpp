@@ -0,0 +1,253 @@
+#include "EditorPch.h"
+#include "TransformUndoCheckCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Foundation/Log.h"
+
+#include "Application/InitializerStack.h"
+#include "Application/UndoQueue.h"
+
+#include "EditorScene/PivotTransform.h"
+
+#include <math.h>
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	// Number of nodes edited (every other node is a PivotTransform, whose reset snapshots its pivots).
+	const int CHECK_NODE_COUNT = 8;
+	// Largest difference allowed between matrix elements (setting an object transform decomposes it into components).
+	const float32_t CHECK_TOLERANCE = 1.0e-4f;
+
+	enum ECheckEdit
+	{
+		CHECK_EDIT_RESET,
+		CHECK_EDIT_CENTER,
+		CHECK_EDIT_DRAG,
+		CHECK_EDIT_SCRUB,
+
+		CHECK_EDIT_MAX
+	};
+
+	const char* const CHECK_EDIT_NAMES[ CHECK_EDIT_MAX ] =
+	{
+		TXT( "reset" ),
+		TXT( "center" ),
+		TXT( "drag" ),
+		TXT( "scrub" ),
+	};
+
+	bool ComponentsMatch( const Vector4& rA, const Vector4& rB )
+	{
+		return fabsf( rA.x - rB.x ) <= CHECK_TOLERANCE &&
+			fabsf( rA.y - rB.y ) <= CHECK_TOLERANCE &&
+			fabsf( rA.z - rB.z ) <= CHECK_TOLERANCE &&
+			fabsf( rA.w - rB.w ) <= CHECK_TOLERANCE;
+	}
+
+	bool MatricesMatch( const Matrix4& rA, const Matrix4& rB )
+	{
+		return ComponentsMatch( rA.x, rB.x ) &&
+			ComponentsMatch( rA.y, rB.y ) &&
+			ComponentsMatch( rA.z, rB.z ) &&
+			ComponentsMatch( rA.t, rB.t );
+	}
+
+	// Evaluate every node, as the scene does before the next frame, and record their object transforms.
+	void EvaluateNodes( const std::vector< Editor::TransformPtr >& rNodes, std::vector< Matrix4 >& rTransforms )
+	{
+		rTransforms.resize( rNodes.size() );
+		for ( size_t nodeIndex = 0; nodeIndex < rNodes.size(); ++nodeIndex )
+		{
+			rNodes[ nodeIndex ]->Evaluate( GraphDirections::Downstream );
+			rTransforms[ nodeIndex ] = rNodes[ nodeIndex ]->GetObjectTransform();
+		}
+	}
+
+	// Get the index of the first node whose object transform differs from the expected one, or -1 if they all match.
+	int FindMismatch( const std::vector< Matrix4 >& rTransforms, const std::vector< Matrix4 >& rExpected )
+	{
+		for ( size_t nodeIndex = 0; nodeIndex < rTransforms.size(); ++nodeIndex )
+		{
+			if ( !MatricesMatch( rTransforms[ nodeIndex ], rExpected[ nodeIndex ] ) )
+			{
+				return static_cast< int >( nodeIndex );
+			}
+		}
+
+		return -1;
+	}
+}
+
+TransformUndoCheckCommand::TransformUndoCheckCommand()
+	: Command( TXT( "transformundocheck" ), TXT( "" ), TXT( "Make random transform edits (reset, center, manipulator drags and property scrubs) through an undo queue, then undo and redo them all and check that every node returns to the transform it had at each step" ) )
+{
+
+}
+
+bool TransformUndoCheckCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_StepCount, TXT( "s|steps" ), TXT( "<COUNT>" ), TXT( "number of edits to make (defaults to 200)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_Seed, TXT( "r|seed" ), TXT( "<SEED>" ), TXT( "random number seed (defaults to 1)" ) ), error );
+	return success;
+}
+
+bool TransformUndoCheckCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	int stepCount, seedOption;
+	if ( !ParseCountOption( m_StepCount, TXT( "step count" ), 200, 1, 1 << 16, stepCount, error ) ||
+		!ParseCountOption( m_Seed, TXT( "seed" ), 1, 0, 0x7fffffff, seedOption, error ) )
+	{
+		return false;
+	}
+
+	InitializerStack initializerStack;
+	initializerStack.Push( Name::Shutdown );
+	initializerStack.Push( Reflect::ObjectRefCountSupport::Shutdown );
+	initializerStack.Push( Reflect::Initialize, Reflect::Cleanup );
+
+	uint32_t seed = static_cast< uint32_t >( seedOption );
+
+	// Nodes are not added to a scene, so they have no parent and their object transform is their global transform.
+	std::vector< Editor::TransformPtr > nodes;
+	nodes.reserve( CHECK_NODE_COUNT );
+	for ( int nodeIndex = 0; nodeIndex < CHECK_NODE_COUNT; ++nodeIndex )
+	{
+		Editor::TransformPtr node = ( nodeIndex % 2 ? new Editor::PivotTransform : new Editor::Transform );
+		node->SetInheritTransform( false );
+		node->SetScale( Scale( NextRandomFloat( seed, 0.5f, 2.0f ), NextRandomFloat( seed, 0.5f, 2.0f ), NextRandomFloat( seed, 0.5f, 2.0f ) ) );
+		node->SetRotate( EulerAngles( Vector3( NextRandomFloat( seed, -3.0f, 3.0f ), NextRandomFloat( seed, -3.0f, 3.0f ), NextRandomFloat( seed, -3.0f, 3.0f ) ) ) );
+		node->SetTranslate( Vector3( NextRandomFloat( seed, -10.0f, 10.0f ), NextRandomFloat( seed, -10.0f, 10.0f ), NextRandomFloat( seed, -10.0f, 10.0f ) ) );
+		nodes.push_back( node );
+	}
+
+	// Merging would fold consecutive drags into one step, so keep every edit as its own step.
+	UndoQueue* pQueue = new UndoQueue;
+	HELIUM_ASSERT( pQueue );
+	pQueue->SetMergeWindow( 0 );
+
+	Log::Print( TXT( "Checking undo and redo of %d transform edits on %d nodes (seed %d)...\n" ), stepCount, CHECK_NODE_COUNT, seedOption );
+
+	// Transforms of every node before the first edit and after each one.
+	std::vector< std::vector< Matrix4 > > history( static_cast< size_t >( stepCount ) + 1 );
+	EvaluateNodes( nodes, history[ 0 ] );
+
+	std::vector< int > editNodes( stepCount );
+	std::vector< int > edits( stepCount );
+	int editCounts[ CHECK_EDIT_MAX ] = { 0 };
+	for ( int stepIndex = 0; stepIndex < stepCount; ++stepIndex )
+	{
+		int nodeIndex = static_cast< int >( NextRandom( seed ) % CHECK_NODE_COUNT );
+		int edit = static_cast< int >( NextRandom( seed ) % CHECK_EDIT_MAX );
+		Editor::Transform* node = nodes[ nodeIndex ];
+
+		switch ( edit )
+		{
+		case CHECK_EDIT_RESET:
+			{
+				pQueue->Push( node->ResetTransform() );
+				break;
+			}
+
+		case CHECK_EDIT_CENTER:
+			{
+				pQueue->Push( node->CenterTransform() );
+				break;
+			}
+
+		case CHECK_EDIT_DRAG:
+			{
+				// Set the object transform, as the manipulators do on each mouse move of a drag.
+				Matrix4 transform = node->GetObjectTransform();
+				transform.t.x += NextRandomFloat( seed, -1.0f, 1.0f );
+				transform.t.y += NextRandomFloat( seed, -1.0f, 1.0f );
+				transform.t.z += NextRandomFloat( seed, -1.0f, 1.0f );
+
+				DeltaPropertyUndoCommand<Matrix4>* command = new DeltaPropertyUndoCommand<Matrix4> ( new Helium::MemberProperty<Editor::Transform, Matrix4> (node, &Editor::Transform::GetObjectTransform, &Editor::Transform::SetObjectTransform), transform );
+				command->SetMergeKey( node->GetObjectTransformMergeKey() );
+				pQueue->Push( command );
+				break;
+			}
+
+		case CHECK_EDIT_SCRUB:
+			{
+				// Change a component in the property grid, which snapshots the whole node first.
+				UndoCommandPtr command = node->SnapShot();
+				node->SetScale( Scale( NextRandomFloat( seed, 0.5f, 2.0f ), NextRandomFloat( seed, 0.5f, 2.0f ), NextRandomFloat( seed, 0.5f, 2.0f ) ) );
+				pQueue->Push( command );
+				break;
+			}
+		}
+
+		EvaluateNodes( nodes, history[ stepIndex + 1 ] );
+		editNodes[ stepIndex ] = nodeIndex;
+		edits[ stepIndex ] = edit;
+		++editCounts[ edit ];
+	}
+
+	if ( pQueue->GetLength() != stepCount )
+	{
+		error = TXT( "The undo queue did not keep one step per edit" );
+		delete pQueue;
+		return false;
+	}
+
+	// Undo every edit, then redo them all, checking every node against the recorded history after each step.
+	std::vector< Matrix4 > transforms;
+	for ( int pass = 0; pass < 2; ++pass )
+	{
+		bool bUndo = ( pass == 0 );
+		for ( int stepOffset = 0; stepOffset < stepCount; ++stepOffset )
+		{
+			int stepIndex = ( bUndo ? stepCount - 1 - stepOffset : stepOffset );
+			if ( bUndo )
+			{
+				pQueue->Undo();
+			}
+			else
+			{
+				pQueue->Redo();
+			}
+
+			EvaluateNodes( nodes, transforms );
+
+			const std::vector< Matrix4 >& rExpected = history[ bUndo ? stepIndex : stepIndex + 1 ];
+			int mismatchIndex = FindMismatch( transforms, rExpected );
+			if ( mismatchIndex >= 0 )
+			{
+				Log::Print(
+					TXT( "Node %d does not match its transform after %s step %d (%s of node %d).\n" ),
+					mismatchIndex,
+					( bUndo ? TXT( "undoing" ) : TXT( "redoing" ) ),
+					stepIndex,
+					CHECK_EDIT_NAMES[ edits[ stepIndex ] ],
+					editNodes[ stepIndex ] );
+
+				error = TXT( "Undo or redo of a transform edit did not restore the transform" );
+				delete pQueue;
+				return false;
+			}
+		}
+	}
+
+	Log::Print(
+		TXT( "All %d edits undid and redid correctly (%d resets, %d centers, %d drags, %d scrubs).\n" ),
+		stepCount,
+		editCounts[ CHECK_EDIT_RESET ],
+		editCounts[ CHECK_EDIT_CENTER ],
+		editCounts[ CHECK_EDIT_DRAG ],
+		editCounts[ CHECK_EDIT_SCRUB ] );
+
+	delete pQueue;
+
+	return true;
+}
@@ -0,0 +1,169 @@
+#include "EditorPch.h"
+#include "UndoQueueBenchmarkCommand.h"
+#include "BenchmarkSupport.h"
+
+#include "Platform/Timer.h"
+
+#include "Foundation/Log.h"
+
+#include "Application/InitializerStack.h"
+#include "Application/UndoQueue.h"
+
+#include "EditorScene/PivotTransform.h"
+
+using namespace Helium;
+using namespace Helium::Editor;
+using namespace Helium::CommandLine;
+
+namespace
+{
+	// Number of nodes edited during the session.
+	const int BENCHMARK_NODE_COUNT = 64;
+	// Number of nodes selected during each manipulator drag.
+	const int BENCHMARK_SELECTION_COUNT = 4;
+	// Number of changes made during a single drag of a manipulator or scrub of a property.
+	const int BENCHMARK_DRAG_EDIT_COUNT = 50;
+	// Every this many drags, a property is scrubbed instead (edited through node snapshots).
+	const int BENCHMARK_SCRUB_INTERVAL = 5;
+	// Number of drags between each undo and redo.
+	const int BENCHMARK_UNDO_INTERVAL = 10;
+	// Number of progress reports over the session.
+	const int BENCHMARK_REPORT_COUNT = 10;
+}
+
+UndoQueueBenchmarkCommand::UndoQueueBenchmarkCommand()
+	: Command( TXT( "undobench" ), TXT( "" ), TXT( "Simulate a long editing session of manipulator drags and property scrubs and report the undo history memory use and undo latency as it grows" ) )
+{
+
+}
+
+bool UndoQueueBenchmarkCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< std::string >( &m_EditCount, TXT( "e|edits" ), TXT( "<COUNT>" ), TXT( "number of property changes over the session (defaults to 500000)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_Budget, TXT( "b|budget" ), TXT( "<KB>" ), TXT( "undo history memory budget in kilobytes, or zero for no limit (defaults to 1024)" ) ), error );
+	success &= AddOption( new SimpleOption< std::string >( &m_MergeWindow, TXT( "w|window" ), TXT( "<MS>" ), TXT( "merge window in milliseconds, or zero to disable merging (defaults to 500)" ) ), error );
+	return success;
+}
+
+bool UndoQueueBenchmarkCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	int editCount, budget, mergeWindow;
+	if ( !ParseCountOption( m_EditCount, TXT( "edit count" ), 500000, 1, 1 << 28, editCount, error ) ||
+		!ParseCountOption( m_Budget, TXT( "memory budget" ), 1024, 0, 1 << 22, budget, error ) ||
+		!ParseCountOption( m_MergeWindow, TXT( "merge window" ), 500, 0, 1 << 20, mergeWindow, error ) )
+	{
+		return false;
+	}
+
+	InitializerStack initializerStack;
+	initializerStack.Push( Name::Shutdown );
+	initializerStack.Push( Reflect::ObjectRefCountSupport::Shutdown );
+	initializerStack.Push( Reflect::Initialize, Reflect::Cleanup );
+
+	// Nodes are not added to a scene, so they have no parent and their object transform is their global transform.
+	std::vector< StrongPtr< Editor::PivotTransform > > nodes;
+	nodes.reserve( BENCHMARK_NODE_COUNT );
+	for ( int nodeIndex = 0; nodeIndex < BENCHMARK_NODE_COUNT; ++nodeIndex )
+	{
+		StrongPtr< Editor::PivotTransform > node = new Editor::PivotTransform;
+		node->SetInheritTransform( false );
+		nodes.push_back( node );
+	}
+
+	UndoQueue* pQueue = new UndoQueue;
+	HELIUM_ASSERT( pQueue );
+	pQueue->SetMemoryBudget( static_cast< size_t >( budget ) * 1024 );
+	pQueue->SetMergeWindow( static_cast< uint32_t >( mergeWindow ) );
+
+	Log::Print(
+		TXT( "Making %d changes to %d nodes in drags of %d changes to %d nodes, scrubbing a property every %d drags...\n" ),
+		editCount,
+		BENCHMARK_NODE_COUNT,
+		BENCHMARK_DRAG_EDIT_COUNT,
+		BENCHMARK_SELECTION_COUNT,
+		BENCHMARK_SCRUB_INTERVAL );
+
+	uint64_t pushTicks = 0;
+	int undoRedoCount = 0;
+	float32_t maxUndoRedoMilliseconds = 0.0f;
+
+	int reportInterval = ( editCount + BENCHMARK_REPORT_COUNT - 1 ) / BENCHMARK_REPORT_COUNT;
+	for ( int editIndex = 0; editIndex < editCount; ++editIndex )
+	{
+		int dragIndex = editIndex / BENCHMARK_DRAG_EDIT_COUNT;
+
+		uint64_t startTicks = Timer::GetTickCount();
+
+		if ( dragIndex % BENCHMARK_SCRUB_INTERVAL == BENCHMARK_SCRUB_INTERVAL - 1 )
+		{
+			// Scrub a property in the property grid, which snapshots the whole node before each change.
+			Editor::PivotTransform* node = nodes[ dragIndex % BENCHMARK_NODE_COUNT ];
+			UndoCommandPtr command = node->SnapShot();
+			node->SetTranslate( node->GetTranslate() + Vector3( 0.0f, 0.01f, 0.0f ) );
+			pQueue->Push( command );
+		}
+		else
+		{
+			// Move the selection a little, as the manipulators do on each mouse move of a drag.
+			BatchUndoCommandPtr batch = new BatchUndoCommand ();
+			batch->SetMergeKey( this );
+
+			for ( int selectionIndex = 0; selectionIndex < BENCHMARK_SELECTION_COUNT; ++selectionIndex )
+			{
+				Editor::PivotTransform* node = nodes[ ( dragIndex * BENCHMARK_SELECTION_COUNT + selectionIndex ) % BENCHMARK_NODE_COUNT ];
+
+				Matrix4 transform = node->GetObjectTransform();
+				transform.t.x += 0.01f;
+				transform.t.y += 0.02f;
+				transform.t.z -= 0.01f;
+
+				DeltaPropertyUndoCommand<Matrix4>* command = new DeltaPropertyUndoCommand<Matrix4> ( new Helium::MemberProperty<Editor::Transform, Matrix4> (node, &Editor::Transform::GetObjectTransform, &Editor::Transform::SetObjectTransform), transform );
+				command->SetMergeKey( node->GetObjectTransformMergeKey() );
+				batch->Push( command );
+			}
+
+			pQueue->Push( batch );
+		}
+
+		pushTicks += Timer::GetTickCount() - startTicks;
+
+		bool bDragEnd = ( ( editIndex + 1 ) % BENCHMARK_DRAG_EDIT_COUNT == 0 );
+		if ( bDragEnd && ( dragIndex + 1 ) % BENCHMARK_UNDO_INTERVAL == 0 )
+		{
+			pQueue->Undo();
+			float32_t undoMilliseconds = pQueue->GetLastUndoRedoMilliseconds();
+			pQueue->Redo();
+			float32_t redoMilliseconds = pQueue->GetLastUndoRedoMilliseconds();
+
+			undoRedoCount += 2;
+			maxUndoRedoMilliseconds = Max( maxUndoRedoMilliseconds, Max( undoMilliseconds, redoMilliseconds ) );
+		}
+
+		if ( ( editIndex + 1 ) % reportInterval == 0 || editIndex + 1 == editCount )
+		{
+			Log::Print(
+				TXT( "%9d changes: %6d undo steps, %8" ) PRIuSZ TXT( " bytes, %u merged, %u trimmed.\n" ),
+				editIndex + 1,
+				pQueue->GetLength(),
+				pQueue->GetMemoryUsage(),
+				pQueue->GetMergedCount(),
+				pQueue->GetTrimmedCount() );
+		}
+	}
+
+	Log::Print(
+		TXT( "Push: %.3f us average.  Undo/redo: %.3f ms maximum over %d operations.\n" ),
+		static_cast< float32_t >( Timer::TicksToMilliseconds( pushTicks ) ) * 1000.0f / static_cast< float32_t >( editCount ),
+		maxUndoRedoMilliseconds,
+		undoRedoCount );
+
+	delete pQueue;
+
+	return true;
+}
@@ -7,6 +7,7 @@
 #endif
 
 #include "Graphics/DynamicDrawer.h"
+#include "Graphics/AnimationEvaluator.h"
 #include "Framework/WorldManager.h"
 #include "Reflect/Object.h"
 #include "Graphics/BufferedDrawer.h"
@@ -356,6 +357,9 @@ void EditorEngine::Shutdown()
 		m_pEngineTickTimer = NULL;
 
 		WorldManager::DestroyStaticInstance();
+#if !HELIUM_USE_GRANNY_ANIMATION
+		AnimationEvaluator::DestroyStaticInstance();
+#endif
 		DynamicDrawer::DestroyStaticInstance();
 		RenderResourceManager::DestroyStaticInstance();
 		Renderer::DestroyStaticInstance();
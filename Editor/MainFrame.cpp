@@ -234,6 +234,10 @@ bool MainFrame::Initialize()
 	const std::vector< std::string >& mruPaths = wxGetApp().GetSettingsManager()->GetSettings<EditorSettings>()->GetMRUProjects();
 	m_MenuMRU->FromVector( mruPaths );
 
+	EditorSettings* editorSettings = wxGetApp().GetSettingsManager()->GetSettings<EditorSettings>();
+	m_UndoQueue.SetMemoryBudget( static_cast< size_t >( editorSettings->GetUndoMemoryBudget() ) * 1024 * 1024 );
+	m_UndoQueue.SetMergeWindow( editorSettings->GetUndoMergeWindow() );
+
 	DropTarget* dropTarget = new DropTarget();
 	dropTarget->SetDragOverCallback( DragOverCallback::Delegate( this, &MainFrame::DragOver ) );
 	dropTarget->SetDropCallback( DropCallback::Delegate( this, &MainFrame::Drop ) );
@@ -17,6 +17,8 @@ EditorSettings::EditorSettings()
 , m_ShowTextOnButtons( false )
 , m_ShowIconsOnButtons( true )
 , m_IconSizeOnButtons( IconSize::Medium )
+, m_UndoMemoryBudget( 64 )
+, m_UndoMergeWindow( 500 )
 {
 }
 
@@ -49,6 +51,14 @@ void EditorSettings::PopulateMetaType( Reflect::MetaStruct& comp )
     field = comp.AddField( &EditorSettings::m_IconSizeOnButtons, TXT( "m_IconSizeOnButtons" ) );
     field->SetProperty( TXT( "UIName" ), TXT( "Icon Size on Buttons" ) );
     field->SetProperty( TXT( "HelpText" ), TXT( "Select the size of the icon to display on buttons." ) );
+
+    field = comp.AddField( &EditorSettings::m_UndoMemoryBudget, TXT( "m_UndoMemoryBudget" ) );
+    field->SetProperty( TXT( "UIName" ), TXT( "Undo History Memory Budget (MB)" ) );
+    field->SetProperty( TXT( "HelpText" ), TXT( "The oldest undo steps are discarded once the undo history uses more memory than this.  Set to zero for no limit." ) );
+
+    field = comp.AddField( &EditorSettings::m_UndoMergeWindow, TXT( "m_UndoMergeWindow" ) );
+    field->SetProperty( TXT( "UIName" ), TXT( "Undo Merge Window (ms)" ) );
+    field->SetProperty( TXT( "HelpText" ), TXT( "Consecutive changes to the same data made within this many milliseconds of each other are undone as a single step.  Set to zero to keep every change separate." ) );
     
 }
 
@@ -91,3 +101,23 @@ void EditorSettings::SetEnableAssetTracker( bool value )
 {
     m_EnableAssetTracker = value;
 }
+
+uint32_t EditorSettings::GetUndoMemoryBudget() const
+{
+    return m_UndoMemoryBudget;
+}
+
+void EditorSettings::SetUndoMemoryBudget( uint32_t megabytes )
+{
+    m_UndoMemoryBudget = megabytes;
+}
+
+uint32_t EditorSettings::GetUndoMergeWindow() const
+{
+    return m_UndoMergeWindow;
+}
+
+void EditorSettings::SetUndoMergeWindow( uint32_t milliseconds )
+{
+    m_UndoMergeWindow = milliseconds;
+}
@@ -46,6 +46,12 @@ namespace Helium
             bool GetEnableAssetTracker() const;
             void SetEnableAssetTracker( bool value );
 
+            uint32_t GetUndoMemoryBudget() const;
+            void SetUndoMemoryBudget( uint32_t megabytes );
+
+            uint32_t GetUndoMergeWindow() const;
+            void SetUndoMergeWindow( uint32_t milliseconds );
+
             HELIUM_DECLARE_CLASS( EditorSettings, Settings );
             static void PopulateMetaType( Reflect::MetaStruct& comp );
 
@@ -58,6 +64,8 @@ namespace Helium
             bool m_ShowTextOnButtons;
             bool m_ShowIconsOnButtons;
             IconSize m_IconSizeOnButtons;
+            uint32_t m_UndoMemoryBudget;
+            uint32_t m_UndoMergeWindow;
         };
 
         typedef Helium::StrongPtr< EditorSettings > GeneralSettingsPtr;
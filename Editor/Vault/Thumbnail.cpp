@@ -50,40 +50,50 @@ bool Thumbnail::FromIcon( HICON icon )
     {
       wxImage image = bitmap.ConvertToImage();
 
-      if ( image.IsOk() )
+      FromImage( image );
+    }
+  }
+
+  m_IsFromIcon = m_Texture != NULL;
+
+  return m_IsFromIcon;
+}
+
+bool Thumbnail::FromImage( const wxImage& image )
+{
+  if ( !image.IsOk() )
+  {
+    return false;
+  }
+
+  // create texture
+  if ( SUCCEEDED( m_DeviceManager->GetD3DDevice()->CreateTexture(image.GetWidth(), image.GetHeight(), 0, 0, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &m_Texture, NULL) ) )
+  {
+    // lock texture
+    D3DLOCKED_RECT rect;
+    if( SUCCEEDED( m_Texture->LockRect( 0, &rect, NULL, D3DLOCK_NOSYSLOCK ) ) )
+    {
+      // copy bitmap data to texture
+      DWORD* dest = (DWORD*)rect.pBits;
+
+      // copy the pixels
+      for ( int y = 0; y < image.GetHeight(); y++ )
       {
-        // create texture
-        if ( SUCCEEDED( m_DeviceManager->GetD3DDevice()->CreateTexture(image.GetWidth(), image.GetHeight(), 0, 0, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &m_Texture, NULL) ) )
+        for( int x = 0 ; x < image.GetWidth() ; x++ )
         {
-          // lock texture
-          D3DLOCKED_RECT rect;
-          if( SUCCEEDED( m_Texture->LockRect( 0, &rect, NULL, D3DLOCK_NOSYSLOCK ) ) )
-          {
-            // copy bitmap data to texture
-            DWORD* dest = (DWORD*)rect.pBits;
-
-            // copy the pixels
-            for ( int y = 0; y < image.GetHeight(); y++ )
-            {
-              for( int x = 0 ; x < image.GetWidth() ; x++ )
-              {
-                dest[ x ] = image.HasAlpha() ? image.GetAlpha( x, y ) : 0xFF << 24 | image.GetRed( x, y ) << 16 | image.GetGreen( x, y ) << 8 | image.GetBlue( x, y );
-              }
-
-              // skip to next row of pixels
-	            dest += rect.Pitch / 4;
-            }
-
-            m_Texture->UnlockRect( 0 );
-          }
+          DWORD alpha = image.HasAlpha() ? image.GetAlpha( x, y ) : 0xFF;
+          dest[ x ] = alpha << 24 | image.GetRed( x, y ) << 16 | image.GetGreen( x, y ) << 8 | image.GetBlue( x, y );
         }
+
+        // skip to next row of pixels
+        dest += rect.Pitch / 4;
       }
+
+      m_Texture->UnlockRect( 0 );
     }
   }
 
-  m_IsFromIcon = m_Texture != NULL;
-
-  return m_IsFromIcon;
+  return m_Texture != NULL;
 }
 
 #endif
@@ -26,6 +26,7 @@ namespace Helium
             }
 
             bool FromIcon( HICON icon );
+            bool FromImage( const wxImage& image );
 #endif
             bool IsFromIcon() const
             {
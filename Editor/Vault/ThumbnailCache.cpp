@@ -0,0 +1,231 @@
+#include "EditorPch.h"
+#include "ThumbnailCache.h"
+
+#include "Foundation/Crc32.h"
+#include "Foundation/FileStream.h"
+
+using namespace Helium;
+using namespace Helium::Editor;
+
+const uint32_t ThumbnailCache::s_Sizes[ ThumbnailCache::SIZE_COUNT ] = { 64, 128, 256 };
+
+namespace
+{
+	const uint32_t s_CacheFileMagic = 0x424d4854; // 'THMB'
+	const uint32_t s_CacheFileVersion = 1;
+
+	struct CacheFileHeader
+	{
+		uint32_t m_Magic;
+		uint32_t m_Version;
+		int64_t  m_SourceTimestamp;
+		uint32_t m_Width;
+		uint32_t m_Height;
+		uint32_t m_HasAlpha;
+		uint32_t m_SourcePathLength; // The source path follows the header to reject hash collisions
+	};
+}
+
+ThumbnailCache::ThumbnailCache()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Set the directory that cached thumbnails are stored in, creating it if
+// necessary.
+// 
+bool ThumbnailCache::Initialize( const Helium::FilePath& directory )
+{
+	Helium::FilePath path( directory );
+	if ( !path.MakePath() )
+	{
+		return false;
+	}
+
+	m_Directory = directory;
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns the smallest cached size that is at least as large as the given
+// number of pixels (or the largest cached size).
+// 
+uint32_t ThumbnailCache::GetBestSize( uint32_t pixels )
+{
+	for ( uint32_t i = 0; i < SIZE_COUNT; ++i )
+	{
+		if ( s_Sizes[ i ] >= pixels )
+		{
+			return s_Sizes[ i ];
+		}
+	}
+
+	return s_Sizes[ SIZE_COUNT - 1 ];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Load a cached thumbnail of the given size.  Fails if there is no entry for
+// the source or if the entry was made from an older version of the source.
+// 
+bool ThumbnailCache::Load( const Helium::FilePath& source, int64_t sourceTimestamp, uint32_t size, wxImage& image ) const
+{
+	if ( !IsInitialized() )
+	{
+		return false;
+	}
+
+	Helium::FilePath cachePath = GetCacheFilePath( source, size );
+	FileStream* pStream = FileStream::OpenFileStream( String( cachePath.c_str() ), FileStream::MODE_READ );
+	if ( !pStream )
+	{
+		return false;
+	}
+
+	bool result = false;
+
+	CacheFileHeader header;
+	if ( pStream->Read( &header, sizeof( header ), 1 ) == 1 &&
+		header.m_Magic == s_CacheFileMagic &&
+		header.m_Version == s_CacheFileVersion &&
+		header.m_SourceTimestamp == sourceTimestamp &&
+		header.m_Width > 0 && header.m_Width <= size &&
+		header.m_Height > 0 && header.m_Height <= size &&
+		header.m_SourcePathLength == source.Get().length() )
+	{
+		std::string sourcePath;
+		sourcePath.resize( header.m_SourcePathLength );
+
+		if ( header.m_SourcePathLength == 0 ||
+			pStream->Read( &sourcePath[ 0 ], 1, header.m_SourcePathLength ) == header.m_SourcePathLength )
+		{
+			if ( sourcePath == source.Get() )
+			{
+				// wxImage takes ownership of buffers allocated with malloc
+				size_t pixelCount = header.m_Width * header.m_Height;
+				unsigned char* rgb = static_cast< unsigned char* >( malloc( pixelCount * 3 ) );
+				unsigned char* alpha = header.m_HasAlpha ? static_cast< unsigned char* >( malloc( pixelCount ) ) : NULL;
+
+				if ( pStream->Read( rgb, 1, pixelCount * 3 ) == pixelCount * 3 &&
+					( !alpha || pStream->Read( alpha, 1, pixelCount ) == pixelCount ) )
+				{
+					image.Create( header.m_Width, header.m_Height, rgb );
+					if ( alpha )
+					{
+						image.SetAlpha( alpha );
+					}
+
+					result = true;
+				}
+				else
+				{
+					free( rgb );
+					free( alpha );
+				}
+			}
+		}
+	}
+
+	delete pStream;
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Downscale a full size source image to every cached size and store the
+// results.
+// 
+bool ThumbnailCache::Store( const Helium::FilePath& source, int64_t sourceTimestamp, const wxImage& image ) const
+{
+	if ( !IsInitialized() || !image.IsOk() )
+	{
+		return false;
+	}
+
+	bool result = true;
+
+	// Downscale from the previous (larger) size where possible, it is much cheaper than rescaling the source each time
+	wxImage scaled = image;
+	for ( int32_t i = SIZE_COUNT - 1; i >= 0; --i )
+	{
+		wxImage next;
+		Downscale( scaled, s_Sizes[ i ], next );
+		result &= Write( source, sourceTimestamp, s_Sizes[ i ], next );
+		scaled = next;
+	}
+
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Scale an image to fit within a square of the given size, preserving the
+// aspect ratio.  Images that already fit are not scaled up.
+// 
+void ThumbnailCache::Downscale( const wxImage& source, uint32_t size, wxImage& result )
+{
+	uint32_t width = source.GetWidth();
+	uint32_t height = source.GetHeight();
+
+	if ( width <= size && height <= size )
+	{
+		result = source;
+		return;
+	}
+
+	if ( width >= height )
+	{
+		height = Max< uint32_t >( 1, height * size / width );
+		width = size;
+	}
+	else
+	{
+		width = Max< uint32_t >( 1, width * size / height );
+		height = size;
+	}
+
+	result = source.Scale( width, height, wxIMAGE_QUALITY_HIGH );
+}
+
+Helium::FilePath ThumbnailCache::GetCacheFilePath( const Helium::FilePath& source, uint32_t size ) const
+{
+	char fileName[ 64 ];
+	StringPrint( fileName, TXT( "%08x_%u.thumb" ), Crc32( source ), size );
+
+	Helium::FilePath path( m_Directory );
+	path += fileName;
+	return path;
+}
+
+bool ThumbnailCache::Write( const Helium::FilePath& source, int64_t sourceTimestamp, uint32_t size, const wxImage& image ) const
+{
+	Helium::FilePath cachePath = GetCacheFilePath( source, size );
+	FileStream* pStream = FileStream::OpenFileStream( String( cachePath.c_str() ), FileStream::MODE_WRITE, true );
+	if ( !pStream )
+	{
+		return false;
+	}
+
+	CacheFileHeader header;
+	header.m_Magic = s_CacheFileMagic;
+	header.m_Version = s_CacheFileVersion;
+	header.m_SourceTimestamp = sourceTimestamp;
+	header.m_Width = image.GetWidth();
+	header.m_Height = image.GetHeight();
+	header.m_HasAlpha = image.HasAlpha() ? 1 : 0;
+	header.m_SourcePathLength = static_cast< uint32_t >( source.Get().length() );
+
+	size_t pixelCount = header.m_Width * header.m_Height;
+
+	bool result = pStream->Write( &header, sizeof( header ), 1 ) == 1 &&
+		pStream->Write( source.Get().c_str(), 1, header.m_SourcePathLength ) == header.m_SourcePathLength &&
+		pStream->Write( image.GetData(), 1, pixelCount * 3 ) == pixelCount * 3 &&
+		( !header.m_HasAlpha || pStream->Write( image.GetAlpha(), 1, pixelCount ) == pixelCount );
+
+	delete pStream;
+
+	if ( !result )
+	{
+		// Never leave a partially written entry behind
+		cachePath.Delete();
+	}
+
+	return result;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Foundation/FilePath.h"
+
+namespace Helium
+{
+    namespace Editor
+    {
+        //
+        // Persistent on-disk cache of pre-downscaled thumbnail images.  Every source image is stored at each of the
+        // cached sizes, keyed by the source path and validated against the source file timestamp, so views can
+        // load a small, already scaled image instead of decoding and rescaling the full size source each session.
+        // Each source file is stored in its own cache files, so different sources can be cached from multiple
+        // threads concurrently.
+        //
+
+        class ThumbnailCache
+        {
+        public:
+            static const uint32_t SIZE_COUNT = 3;
+            static const uint32_t s_Sizes[ SIZE_COUNT ]; // Cached thumbnail sizes (in pixels, smallest first)
+
+            ThumbnailCache();
+
+            bool Initialize( const Helium::FilePath& directory );
+            bool IsInitialized() const
+            {
+                return !m_Directory.Get().empty();
+            }
+
+            static uint32_t GetBestSize( uint32_t pixels );
+
+            bool Load( const Helium::FilePath& source, int64_t sourceTimestamp, uint32_t size, wxImage& image ) const;
+            bool Store( const Helium::FilePath& source, int64_t sourceTimestamp, const wxImage& image ) const;
+
+            static void Downscale( const wxImage& source, uint32_t size, wxImage& result );
+
+        private:
+            Helium::FilePath GetCacheFilePath( const Helium::FilePath& source, uint32_t size ) const;
+            bool Write( const Helium::FilePath& source, int64_t sourceTimestamp, uint32_t size, const wxImage& image ) const;
+
+        private:
+            Helium::FilePath m_Directory;
+        };
+    }
+}
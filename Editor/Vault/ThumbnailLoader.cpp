@@ -1,7 +1,10 @@
 #include "EditorPch.h"
 #include "ThumbnailLoader.h"
 
+#include "Platform/Atomic.h"
+#include "Platform/File.h"
 #include "Foundation/DirectoryIterator.h"
+#include "Application/Preferences.h"
 #include "EditorScene/DeviceManager.h"
 #include "EditorScene/Render.h"
 
@@ -10,10 +13,6 @@ using namespace Helium::Editor;
 
 void* ThumbnailLoader::LoadThread::Entry()
 {
-#ifdef HELIUM_ASSERT_ENABLED
-	bool emptyQueuePollingCheck = false;
-#endif
-
 	while ( true )
 	{
 		m_Loader.m_Signal.Decrement();
@@ -52,152 +51,334 @@ void* ThumbnailLoader::LoadThread::Entry()
 			break;
 		}
 
+		// Cancelled requests leave the semaphore count higher than the number of
+		// queued files, so waking up to find nothing to do is expected
 		Helium::FilePath path;
+		int32_t generation = 0;
+		if ( !m_Loader.Dequeue( path, generation ) )
+		{
+			continue;
+		}
+
+		ResultArgs args;
+		args.m_Path = path;
+
+		m_Loader.Load( path, static_cast< uint32_t >( m_Loader.m_ThumbnailSize ), args.m_Textures );
+		m_Loader.Complete( path );
+
+		// If the loader was stopped while we were working the result is stale
+		args.m_Cancelled = ( generation != m_Loader.m_Generation );
+		if ( args.m_Cancelled )
+		{
+			args.m_Textures.clear();
+		}
+
+		m_Loader.m_Result.Raise( args );
+	}
+
+	return NULL;
+}
+
+ThumbnailLoader::ThumbnailLoader( DeviceManager* d3dManager )
+	: m_Generation( 0 )
+	, m_ThumbnailSize( ThumbnailCache::s_Sizes[ ThumbnailCache::SIZE_COUNT - 1 ] )
+	, m_Quit( false )
+	, m_DeviceManager( d3dManager )
+{
+	Helium::FilePath cacheDirectory;
+	if ( Helium::GetPreferencesDirectory( cacheDirectory ) )
+	{
+		cacheDirectory += TXT( "ThumbnailCache/" );
+		m_Cache.Initialize( cacheDirectory );
+	}
+
+	// Leave a core for the UI thread
+	int threadCount = wxThread::GetCPUCount() - 1;
+	threadCount = Max( threadCount, 1 );
+	threadCount = Min( threadCount, static_cast< int >( s_MaxLoadThreads ) );
+
+	for ( int i = 0; i < threadCount; ++i )
+	{
+		LoadThread* thread = new LoadThread( *this );
+		thread->Create();
+		thread->Run();
+
+		m_LoadThreads.push_back( thread );
+	}
+}
+
+ThumbnailLoader::~ThumbnailLoader()
+{
+	m_Quit = true;
+
+	for ( size_t i = 0; i < m_LoadThreads.size(); ++i )
+	{
+		m_Signal.Increment();
+	}
+
+	for ( std::vector< LoadThread* >::const_iterator itr = m_LoadThreads.begin(), end = m_LoadThreads.end();
+		itr != end;
+		++itr )
+	{
+		(*itr)->Wait();
+		delete *itr;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Set the size (in pixels) that subsequently loaded thumbnails will be
+// displayed at.  The closest cached size is loaded.
+// 
+void ThumbnailLoader::SetThumbnailSize( uint32_t pixels )
+{
+	m_ThumbnailSize = static_cast< int32_t >( ThumbnailCache::GetBestSize( pixels ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Queue files to be loaded.  Visible files replace the previous set of
+// visible files at the front of the queue; any previously visible files that
+// were not loaded yet are moved to the front of the off screen queue.
+// 
+void ThumbnailLoader::Enqueue( const std::set< Helium::FilePath >& files, bool visible )
+{
+	Helium::Locker< LoadQueue >::Handle queue( m_FileQueue );
 
+	if ( visible )
+	{
+		for ( Helium::OrderedSet< Helium::FilePath >::ReverseIterator itr = queue->m_Visible.ReverseBegin(), end = queue->m_Visible.ReverseEnd();
+			itr != end;
+			++itr )
 		{
-			Helium::Locker< Helium::OrderedSet< Helium::FilePath > >::Handle queue( m_Loader.m_FileQueue );
-			if ( !queue->Empty() )
+			if ( files.find( *itr ) == files.end() )
 			{
-#ifdef HELIUM_ASSERT_ENABLED
-				emptyQueuePollingCheck = false;
-#endif
-				path = queue->Front();
+				queue->m_Background.Prepend( *itr );
 			}
-			else
-			{
-				// if you hit this then the bookkeeping of the counting semaphore is broken
-				HELIUM_ASSERT( !emptyQueuePollingCheck );
+		}
 
-#ifdef HELIUM_ASSERT_ENABLED
-				emptyQueuePollingCheck = true;
-#endif
-				continue;
+		queue->m_Visible.Clear();
+
+		for ( std::set< Helium::FilePath >::const_iterator itr = files.begin(), end = files.end();
+			itr != end;
+			++itr )
+		{
+			bool signal = !queue->m_Background.Remove( *itr );
+			queue->m_Visible.Append( *itr );
+			if ( signal )
+			{
+				m_Signal.Increment();
 			}
+		}
+	}
+	else
+	{
+		for ( std::set< Helium::FilePath >::const_iterator itr = files.begin(), end = files.end();
+			itr != end;
+			++itr )
+		{
+			if ( !queue->m_Visible.Contains( *itr ) && queue->m_Background.Append( *itr ) )
+			{
+				m_Signal.Increment();
+			}
+		}
+	}
+}
 
-			queue->Remove( path );
+///////////////////////////////////////////////////////////////////////////////
+// Cancel queued requests for the given files (i.e. requests that have become
+// stale).  Files that are already being loaded are not affected.
+// 
+void ThumbnailLoader::Cancel( const std::set< Helium::FilePath >& files )
+{
+	Helium::Locker< LoadQueue >::Handle queue( m_FileQueue );
+
+	for ( std::set< Helium::FilePath >::const_iterator itr = files.begin(), end = files.end();
+		itr != end;
+		++itr )
+	{
+		if ( queue->m_Visible.Remove( *itr ) || queue->m_Background.Remove( *itr ) )
+		{
+			ResultArgs args;
+			args.m_Path = *itr;
+			args.m_Cancelled = true;
+			m_Result.Raise( args );
 		}
+	}
+}
 
-		ResultArgs args;
-		args.m_Path = path;
-		args.m_Cancelled = false;
+///////////////////////////////////////////////////////////////////////////////
+// Cancel all queued requests.  Results for files that are already being
+// loaded will be reported as cancelled.
+// 
+void ThumbnailLoader::Stop()
+{
+	Helium::Locker< LoadQueue >::Handle queue( m_FileQueue );
 
+	AtomicIncrementRelease( m_Generation );
+
+	Helium::OrderedSet< Helium::FilePath >* queues[] = { &queue->m_Visible, &queue->m_Background };
+	for ( size_t i = 0; i < sizeof( queues ) / sizeof( queues[ 0 ] ); ++i )
+	{
+		while ( !queues[ i ]->Empty() )
+		{
+			ResultArgs args;
+			args.m_Path = ( queues[ i ]->Front() );
+			args.m_Cancelled = true;
+			m_Result.Raise( args );
+
+			queues[ i ]->PopFront();
+		}
+	}
+
+	m_Signal.Reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Take the next file to load, visible files first.  Files that another thread
+// is already loading are left in the queue until that load completes.
+// 
+bool ThumbnailLoader::Dequeue( Helium::FilePath& path, int32_t& generation )
+{
+	Helium::Locker< LoadQueue >::Handle queue( m_FileQueue );
+
+	Helium::OrderedSet< Helium::FilePath >* queues[] = { &queue->m_Visible, &queue->m_Background };
+	for ( size_t i = 0; i < sizeof( queues ) / sizeof( queues[ 0 ] ); ++i )
+	{
+		for ( Helium::OrderedSet< Helium::FilePath >::Iterator itr = queues[ i ]->Begin(), end = queues[ i ]->End();
+			itr != end;
+			++itr )
+		{
+			if ( queue->m_InFlight.find( *itr ) == queue->m_InFlight.end() )
+			{
+				path = *itr;
+				generation = m_Generation;
+
+				queues[ i ]->Remove( path );
+				queue->m_InFlight.insert( path );
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Mark a file as no longer being loaded.  If it was requested again while it
+// was loading, wake a thread to load it again.
+// 
+void ThumbnailLoader::Complete( const Helium::FilePath& path )
+{
+	Helium::Locker< LoadQueue >::Handle queue( m_FileQueue );
+
+	queue->m_InFlight.erase( path );
+
+	if ( queue->m_Visible.Contains( path ) || queue->m_Background.Contains( path ) )
+	{
+		m_Signal.Increment();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Load the thumbnails for a file.
+// 
+void ThumbnailLoader::Load( const Helium::FilePath& path, uint32_t size, V_ThumbnailPtr& textures )
+{
 #ifdef VIEWPORT_REFACTOR
-		if ( Editor::IsSupportedTexture( path.Get() ) )
+	IDirect3DDevice9* device = m_DeviceManager->GetD3DDevice();
+
+	if ( Editor::IsSupportedTexture( path.Get() ) )
+	{
+		wxImage image;
+		if ( LoadImage( path, size, image ) )
 		{
-			IDirect3DTexture9* texture = NULL;
-			if ( texture = LoadTexture( device, path.Get() ) )
+			ThumbnailPtr thumbnail = new Thumbnail( m_DeviceManager );
+			if ( thumbnail->FromImage( image ) )
 			{
-				ThumbnailPtr thumbnail = new Thumbnail( m_Loader.m_DeviceManager, texture );
-				args.m_Textures.push_back( thumbnail );
+				textures.push_back( thumbnail );
 			}
 		}
-		else
+	}
+	else
 #endif
+	{
+		// TODO: When we store the thumbnail in the asset file, fix this
+		if ( path.Extension() == TXT( "HeliumEntity" ) )
 		{
-			// TODO: When we store the thumbnail in the asset file, fix this
-			if ( path.Extension() == TXT( "HeliumEntity" ) )
-			{
-				FilePath thumbnailPath( path.Directory() + path.Basename() + TXT( "_thumbnail.png" ) );
+			FilePath thumbnailPath( path.Directory() + path.Basename() + TXT( "_thumbnail.png" ) );
 
-				if ( thumbnailPath.Exists() )
+			if ( thumbnailPath.Exists() )
+			{
+				wxImage image;
+				if ( LoadImage( thumbnailPath, size, image ) )
 				{
 #ifdef VIEWPORT_REFACTOR
-					IDirect3DTexture9* texture = NULL;
-					if ( texture = LoadTexture( device, thumbnailPath.Get() ) )
+					ThumbnailPtr thumbnail = new Thumbnail( m_DeviceManager );
+					if ( thumbnail->FromImage( image ) )
 					{
-						ThumbnailPtr thumbnail = new Thumbnail( m_Loader.m_DeviceManager, texture );
-						args.m_Textures.push_back( thumbnail );
+						textures.push_back( thumbnail );
 					}
 #endif
 				}
 			}
-			// Include the color map of a shader as a possible thumbnail image
-			else if ( path.Extension() == TXT( "HeliumShader" ) )
-			{
+		}
+		// Include the color map of a shader as a possible thumbnail image
+		else if ( path.Extension() == TXT( "HeliumShader" ) )
+		{
 #ifdef VIEWPORT_REFACTOR
-				if ( colorMap->GetContentPath().Exists() && Editor::IsSupportedTexture( colorMap->GetContentPath().Get() ) )
+			if ( colorMap->GetContentPath().Exists() && Editor::IsSupportedTexture( colorMap->GetContentPath().Get() ) )
+			{
+				IDirect3DTexture9* texture = NULL;
+				if ( texture = LoadTexture( device, colorMap->GetContentPath().Get() ) )
 				{
-					IDirect3DTexture9* texture = NULL;
-					if ( texture = LoadTexture( device, colorMap->GetContentPath().Get() ) )
-					{
-						ThumbnailPtr thumbnail = new Thumbnail( m_Loader.m_DeviceManager, texture );
-						args.m_Textures.push_back( thumbnail );
-					}
+					ThumbnailPtr thumbnail = new Thumbnail( m_DeviceManager, texture );
+					textures.push_back( thumbnail );
 				}
-#endif
 			}
-			else if ( path.Extension() == TXT( "HeliumTexture" ) )
-			{
+#endif
+		}
+		else if ( path.Extension() == TXT( "HeliumTexture" ) )
+		{
 #ifdef VIEWPORT_REFACTOR
-				if ( textureAsset->GetContentPath().Exists() && Editor::IsSupportedTexture( textureAsset->GetContentPath().Get() ) )
+			if ( textureAsset->GetContentPath().Exists() && Editor::IsSupportedTexture( textureAsset->GetContentPath().Get() ) )
+			{
+				IDirect3DTexture9* texture = NULL;
+				if ( texture = LoadTexture( device, textureAsset->GetContentPath().Get() ) )
 				{
-					IDirect3DTexture9* texture = NULL;
-					if ( texture = LoadTexture( device, textureAsset->GetContentPath().Get() ) )
-					{
-						ThumbnailPtr thumbnail = new Thumbnail( m_Loader.m_DeviceManager, texture );
-						args.m_Textures.push_back( thumbnail );
-					}
+					ThumbnailPtr thumbnail = new Thumbnail( m_DeviceManager, texture );
+					textures.push_back( thumbnail );
 				}
-#endif
 			}
+#endif
 		}
-
-		m_Loader.m_Result.Raise( args );
 	}
-
-	return NULL;
 }
 
-ThumbnailLoader::ThumbnailLoader( DeviceManager* d3dManager )
-	: m_LoadThread( *this )
-	, m_Quit( false )
-	, m_DeviceManager( d3dManager )
+///////////////////////////////////////////////////////////////////////////////
+// Load an image downscaled to the given thumbnail size, from the thumbnail
+// cache if possible.  On a cache miss the source image is decoded and stored
+// in the cache at every cached size.
+// 
+bool ThumbnailLoader::LoadImage( const Helium::FilePath& imagePath, uint32_t size, wxImage& image )
 {
-	m_LoadThread.Create();
-	m_LoadThread.Run();
-}
-
-ThumbnailLoader::~ThumbnailLoader()
-{
-	m_Quit = true;
-	m_Signal.Increment();
-	m_LoadThread.Wait();
-}
-
-void ThumbnailLoader::Enqueue( const std::set< Helium::FilePath >& files )
-{
-	Helium::Locker< Helium::OrderedSet< Helium::FilePath > >::Handle queue( m_FileQueue );
+	Helium::Status status;
+	status.Read( imagePath.Get().c_str() );
+	int64_t timestamp = status.m_ModifiedTime;
 
-	for ( std::set< Helium::FilePath >::const_reverse_iterator itr = files.rbegin(), end = files.rend();
-		itr != end;
-		++itr )
+	if ( m_Cache.Load( imagePath, timestamp, size, image ) )
 	{
-		bool signal = !queue->Remove( *itr );
-		queue->Prepend( *itr );
-		if ( signal )
-		{
-			m_Signal.Increment();
-		}
+		return true;
 	}
-}
 
-void ThumbnailLoader::Stop()
-{
-	Helium::Locker< Helium::OrderedSet< Helium::FilePath > >::Handle queue( m_FileQueue );
-	if ( queue->Empty() )
+	wxImage source;
+	if ( !source.LoadFile( wxString( imagePath.Get().c_str() ) ) )
 	{
-		return;
+		return false;
 	}
 
-	while ( !queue->Empty() )
+	if ( !m_Cache.Store( imagePath, timestamp, source ) || !m_Cache.Load( imagePath, timestamp, size, image ) )
 	{
-		ResultArgs args;
-		args.m_Path = ( queue->Front() );
-		args.m_Cancelled = true;
-		m_Result.Raise( args );
-
-		queue->Remove( queue->Front() );
+		ThumbnailCache::Downscale( source, size, image );
 	}
 
-	m_Signal.Reset();
-}
\ No newline at end of file
+	return image.IsOk();
+}
@@ -9,22 +9,30 @@
 #include "EditorScene/DeviceManager.h"
 
 #include "Editor/Vault/Thumbnail.h"
+#include "Editor/Vault/ThumbnailCache.h"
 
 namespace Helium
 {
     namespace Editor
     {
         //
-        // Thumbnail loader loads textures in a thread and notifies results in that background thread via an event
+        // Thumbnail loader loads textures in a pool of threads and notifies results in those background threads via an event
+        //  Requests for visible tiles are serviced before requests for tiles that are off screen, and decoded thumbnails
+        //  are kept in a persistent ThumbnailCache so they only need to be decoded and rescaled once per source change.
         //
 
         class ThumbnailLoader
         {
         public:
+            static const uint32_t s_MaxLoadThreads = 4;
+
             ThumbnailLoader( DeviceManager* d3dManager );
             ~ThumbnailLoader();
 
-            void Enqueue( const std::set< Helium::FilePath >& files );
+            void SetThumbnailSize( uint32_t pixels );
+
+            void Enqueue( const std::set< Helium::FilePath >& files, bool visible = false );
+            void Cancel( const std::set< Helium::FilePath >& files );
             void Stop();
 
 
@@ -38,7 +46,7 @@ namespace Helium
             typedef Helium::Signature< const ResultArgs&> ResultSignature;
 
             //
-            // The result event (raised in the loading thread)
+            // The result event (raised in the loading threads)
             //
 
         private:
@@ -68,12 +76,28 @@ namespace Helium
 
             private:
                 ThumbnailLoader& m_Loader;
-            } m_LoadThread; // The loading thread object
+            };
+
+            struct LoadQueue
+            {
+                Helium::OrderedSet< Helium::FilePath > m_Visible;       // Requests for tiles on screen (loaded first)
+                Helium::OrderedSet< Helium::FilePath > m_Background;    // Requests for tiles off screen
+                std::set< Helium::FilePath >           m_InFlight;      // Files currently being loaded by a thread
+            };
+
+            bool Dequeue( Helium::FilePath& path, int32_t& generation );
+            void Complete( const Helium::FilePath& path );
+            void Load( const Helium::FilePath& path, uint32_t size, V_ThumbnailPtr& textures );
+            bool LoadImage( const Helium::FilePath& imagePath, uint32_t size, wxImage& image );
 
-            Helium::Locker< Helium::OrderedSet< Helium::FilePath > >    m_FileQueue; // The queue of files to load (mutex locked)
-            Helium::Semaphore                                       m_Signal; // Signalling semaphore to wake up load thread
+            std::vector< LoadThread* >                              m_LoadThreads; // The loading thread objects
+            Helium::Locker< LoadQueue >                             m_FileQueue; // The queues of files to load (mutex locked)
+            Helium::Semaphore                                       m_Signal; // Signalling semaphore to wake up load threads
+            volatile int32_t                                        m_Generation; // Incremented to cancel loads in flight
+            volatile int32_t                                        m_ThumbnailSize; // Size of thumbnails to load (in pixels)
             bool                                                    m_Quit;
             DeviceManager*                            m_DeviceManager;
+            ThumbnailCache                                          m_Cache;
         };
     }
-}
\ No newline at end of file
+}
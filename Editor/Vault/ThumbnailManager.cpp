@@ -37,11 +37,29 @@ void ThumbnailManager::Reset()
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Request that some thumbnails be loaded.
+// Set the size (in pixels) that thumbnails are displayed at, so the loader can
+// pick the closest pre-downscaled size from the thumbnail cache.
 // 
-void ThumbnailManager::Request( const std::set< Helium::FilePath >& paths )
+void ThumbnailManager::SetThumbnailSize( uint32_t pixels )
 {
-    m_Loader.Enqueue( paths );
+    m_Loader.SetThumbnailSize( pixels );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Request that some thumbnails be loaded.  Visible requests are loaded ahead
+// of any others and replace the previous set of visible requests.
+// 
+void ThumbnailManager::Request( const std::set< Helium::FilePath >& paths, bool visible )
+{
+    m_Loader.Enqueue( paths, visible );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Cancel pending thumbnail loads for specific paths that are no longer needed.
+// 
+void ThumbnailManager::Cancel( const std::set< Helium::FilePath >& paths )
+{
+    m_Loader.Cancel( paths );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -31,7 +31,9 @@ namespace Helium
             virtual ~ThumbnailManager();
 
             void Reset();
-            void Request( const std::set< Helium::FilePath >& paths );
+            void SetThumbnailSize( uint32_t pixels );
+            void Request( const std::set< Helium::FilePath >& paths, bool visible = false );
+            void Cancel( const std::set< Helium::FilePath >& paths );
             void Cancel();
             void DetachFromWindow();
 
@@ -89,6 +89,7 @@ BEGIN_EVENT_TABLE( Editor::ThumbnailView, wxScrolledWindow )
 	//, m_VaultPanel( vaultPanel )
 {
 	m_ThumbnailManager = new ThumbnailManager( this, &m_DeviceManager );
+	m_ThumbnailManager->SetThumbnailSize( ( uint32_t )m_Scale );
 
 	// Don't erase background
 	SetBackgroundStyle( wxBG_STYLE_CUSTOM );
@@ -344,6 +345,8 @@ void ThumbnailView::SetZoom( uint16_t zoom )
 		m_World.y.y = m_Scale;
 		m_World.z.z = m_Scale;
 
+		m_ThumbnailManager->SetThumbnailSize( ( uint32_t )m_Scale );
+
 		CalculateTotalItemSize();
 
 		// Maintain scroll position if possible
@@ -1211,12 +1214,9 @@ bool ThumbnailView::Draw()
 		DrawTileFileType( device, tileCorners, thumbnail );
 	}
 
-	// Request some textures to be loaded
-	if ( !m_CurrentTextureRequests.empty() )
-	{
-		m_ThumbnailManager->Request( m_CurrentTextureRequests );
-		m_CurrentTextureRequests.clear();
-	}
+	// Request the textures for the visible tiles, these go ahead of any off screen requests
+	m_ThumbnailManager->Request( m_CurrentTextureRequests, true );
+	m_CurrentTextureRequests.clear();
 
 	device->SetRenderState( D3DRS_LIGHTING, TRUE );
 	device->SetRenderState( D3DRS_ALPHABLENDENABLE, FALSE );
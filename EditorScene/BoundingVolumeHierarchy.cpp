@@ -0,0 +1,406 @@
+#include "EditorScenePch.h"
+#include "BoundingVolumeHierarchy.h"
+
+using namespace Helium;
+using namespace Helium::Editor;
+
+// leaf boxes are enlarged by this fraction of their size (plus a fixed margin) so small moves don't touch the tree
+static const float32_t s_FatBoxScale = 0.1f;
+static const float32_t s_FatBoxMargin = 0.05f;
+
+static AlignedBox Combine( const AlignedBox& a, const AlignedBox& b )
+{
+	AlignedBox result ( a );
+	result.Merge( b );
+	return result;
+}
+
+static float32_t SurfaceArea( const AlignedBox& box )
+{
+	float32_t x = box.maximum.x - box.minimum.x;
+	float32_t y = box.maximum.y - box.minimum.y;
+	float32_t z = box.maximum.z - box.minimum.z;
+	return 2.0f * ( x * y + y * z + z * x );
+}
+
+static bool Contains( const AlignedBox& outer, const AlignedBox& inner )
+{
+	return outer.minimum.x <= inner.minimum.x && outer.minimum.y <= inner.minimum.y && outer.minimum.z <= inner.minimum.z
+		&& outer.maximum.x >= inner.maximum.x && outer.maximum.y >= inner.maximum.y && outer.maximum.z >= inner.maximum.z;
+}
+
+static AlignedBox Fatten( const AlignedBox& box )
+{
+	AlignedBox result ( box );
+
+	float32_t x = ( box.maximum.x - box.minimum.x ) * s_FatBoxScale + s_FatBoxMargin;
+	float32_t y = ( box.maximum.y - box.minimum.y ) * s_FatBoxScale + s_FatBoxMargin;
+	float32_t z = ( box.maximum.z - box.minimum.z ) * s_FatBoxScale + s_FatBoxMargin;
+
+	result.minimum.x -= x;
+	result.minimum.y -= y;
+	result.minimum.z -= z;
+	result.maximum.x += x;
+	result.maximum.y += y;
+	result.maximum.z += z;
+
+	return result;
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+	: m_Root( NullProxy )
+	, m_FreeList( NullProxy )
+	, m_LeafCount( 0 )
+{
+}
+
+void BoundingVolumeHierarchy::Clear()
+{
+	m_Nodes.clear();
+	m_Root = NullProxy;
+	m_FreeList = NullProxy;
+	m_LeafCount = 0;
+}
+
+int32_t BoundingVolumeHierarchy::Insert( const AlignedBox& box, void* userData )
+{
+	int32_t proxy = AllocateNode();
+
+	Node& node = m_Nodes[ proxy ];
+	node.m_Box = Fatten( box );
+	node.m_UserData = userData;
+	node.m_Height = 0;
+
+	InsertLeaf( proxy );
+	++m_LeafCount;
+
+	return proxy;
+}
+
+void BoundingVolumeHierarchy::Remove( int32_t proxy )
+{
+	HELIUM_ASSERT( proxy >= 0 && proxy < static_cast< int32_t >( m_Nodes.size() ) );
+	HELIUM_ASSERT( m_Nodes[ proxy ].IsLeaf() );
+
+	RemoveLeaf( proxy );
+	FreeNode( proxy );
+	--m_LeafCount;
+}
+
+bool BoundingVolumeHierarchy::Update( int32_t proxy, const AlignedBox& box )
+{
+	HELIUM_ASSERT( proxy >= 0 && proxy < static_cast< int32_t >( m_Nodes.size() ) );
+	HELIUM_ASSERT( m_Nodes[ proxy ].IsLeaf() );
+
+	const AlignedBox& fatBox = m_Nodes[ proxy ].m_Box;
+
+	// still inside the fat box, and the fat box isn't grossly oversized (i.e. the node shrank a lot)
+	if ( Contains( fatBox, box ) && SurfaceArea( fatBox ) <= 4.0f * SurfaceArea( Fatten( box ) ) )
+	{
+		return false;
+	}
+
+	RemoveLeaf( proxy );
+	m_Nodes[ proxy ].m_Box = Fatten( box );
+	InsertLeaf( proxy );
+
+	return true;
+}
+
+int32_t BoundingVolumeHierarchy::AllocateNode()
+{
+	int32_t index;
+
+	if ( m_FreeList != NullProxy )
+	{
+		index = m_FreeList;
+		m_FreeList = m_Nodes[ index ].m_Parent;
+	}
+	else
+	{
+		index = static_cast< int32_t >( m_Nodes.size() );
+		m_Nodes.push_back( Node() );
+	}
+
+	Node& node = m_Nodes[ index ];
+	node.m_UserData = NULL;
+	node.m_Parent = NullProxy;
+	node.m_Child1 = NullProxy;
+	node.m_Child2 = NullProxy;
+	node.m_Height = 0;
+
+	return index;
+}
+
+void BoundingVolumeHierarchy::FreeNode( int32_t node )
+{
+	m_Nodes[ node ].m_Parent = m_FreeList;
+	m_Nodes[ node ].m_Height = -1;
+	m_FreeList = node;
+}
+
+void BoundingVolumeHierarchy::InsertLeaf( int32_t leaf )
+{
+	if ( m_Root == NullProxy )
+	{
+		m_Root = leaf;
+		m_Nodes[ leaf ].m_Parent = NullProxy;
+		return;
+	}
+
+	// find the best sibling, descending while the cost of pushing the leaf further down is lower
+	const AlignedBox leafBox = m_Nodes[ leaf ].m_Box;
+	int32_t index = m_Root;
+	while ( !m_Nodes[ index ].IsLeaf() )
+	{
+		const Node& node = m_Nodes[ index ];
+		int32_t child1 = node.m_Child1;
+		int32_t child2 = node.m_Child2;
+
+		float32_t area = SurfaceArea( node.m_Box );
+		float32_t combinedArea = SurfaceArea( Combine( node.m_Box, leafBox ) );
+
+		// cost of creating a new parent for this node and the new leaf
+		float32_t cost = 2.0f * combinedArea;
+
+		// minimum cost of pushing the leaf further down the tree
+		float32_t inheritanceCost = 2.0f * ( combinedArea - area );
+
+		float32_t cost1 = SurfaceArea( Combine( m_Nodes[ child1 ].m_Box, leafBox ) ) + inheritanceCost;
+		if ( !m_Nodes[ child1 ].IsLeaf() )
+		{
+			cost1 -= SurfaceArea( m_Nodes[ child1 ].m_Box );
+		}
+
+		float32_t cost2 = SurfaceArea( Combine( m_Nodes[ child2 ].m_Box, leafBox ) ) + inheritanceCost;
+		if ( !m_Nodes[ child2 ].IsLeaf() )
+		{
+			cost2 -= SurfaceArea( m_Nodes[ child2 ].m_Box );
+		}
+
+		if ( cost < cost1 && cost < cost2 )
+		{
+			break;
+		}
+
+		index = cost1 < cost2 ? child1 : child2;
+	}
+
+	int32_t sibling = index;
+
+	// create a new parent (note that this may reallocate the node array)
+	int32_t oldParent = m_Nodes[ sibling ].m_Parent;
+	int32_t newParent = AllocateNode();
+	m_Nodes[ newParent ].m_Parent = oldParent;
+	m_Nodes[ newParent ].m_Box = Combine( leafBox, m_Nodes[ sibling ].m_Box );
+	m_Nodes[ newParent ].m_Height = m_Nodes[ sibling ].m_Height + 1;
+	m_Nodes[ newParent ].m_Child1 = sibling;
+	m_Nodes[ newParent ].m_Child2 = leaf;
+	m_Nodes[ sibling ].m_Parent = newParent;
+	m_Nodes[ leaf ].m_Parent = newParent;
+
+	if ( oldParent != NullProxy )
+	{
+		if ( m_Nodes[ oldParent ].m_Child1 == sibling )
+		{
+			m_Nodes[ oldParent ].m_Child1 = newParent;
+		}
+		else
+		{
+			m_Nodes[ oldParent ].m_Child2 = newParent;
+		}
+	}
+	else
+	{
+		m_Root = newParent;
+	}
+
+	// walk back up fixing heights and boxes
+	for ( index = m_Nodes[ leaf ].m_Parent; index != NullProxy; index = m_Nodes[ index ].m_Parent )
+	{
+		index = Balance( index );
+
+		Node& node = m_Nodes[ index ];
+		node.m_Height = 1 + Max( m_Nodes[ node.m_Child1 ].m_Height, m_Nodes[ node.m_Child2 ].m_Height );
+		node.m_Box = Combine( m_Nodes[ node.m_Child1 ].m_Box, m_Nodes[ node.m_Child2 ].m_Box );
+	}
+}
+
+void BoundingVolumeHierarchy::RemoveLeaf( int32_t leaf )
+{
+	if ( leaf == m_Root )
+	{
+		m_Root = NullProxy;
+		return;
+	}
+
+	int32_t parent = m_Nodes[ leaf ].m_Parent;
+	int32_t grandParent = m_Nodes[ parent ].m_Parent;
+	int32_t sibling = m_Nodes[ parent ].m_Child1 == leaf ? m_Nodes[ parent ].m_Child2 : m_Nodes[ parent ].m_Child1;
+
+	if ( grandParent != NullProxy )
+	{
+		// destroy the parent and connect the sibling to the grandparent
+		if ( m_Nodes[ grandParent ].m_Child1 == parent )
+		{
+			m_Nodes[ grandParent ].m_Child1 = sibling;
+		}
+		else
+		{
+			m_Nodes[ grandParent ].m_Child2 = sibling;
+		}
+		m_Nodes[ sibling ].m_Parent = grandParent;
+		FreeNode( parent );
+
+		for ( int32_t index = grandParent; index != NullProxy; index = m_Nodes[ index ].m_Parent )
+		{
+			index = Balance( index );
+
+			Node& node = m_Nodes[ index ];
+			node.m_Box = Combine( m_Nodes[ node.m_Child1 ].m_Box, m_Nodes[ node.m_Child2 ].m_Box );
+			node.m_Height = 1 + Max( m_Nodes[ node.m_Child1 ].m_Height, m_Nodes[ node.m_Child2 ].m_Height );
+		}
+	}
+	else
+	{
+		m_Root = sibling;
+		m_Nodes[ sibling ].m_Parent = NullProxy;
+		FreeNode( parent );
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Perform a left or right rotation if node A is imbalanced, returns the index
+// of the node that took its place.
+// 
+int32_t BoundingVolumeHierarchy::Balance( int32_t iA )
+{
+	Node& a = m_Nodes[ iA ];
+	if ( a.IsLeaf() || a.m_Height < 2 )
+	{
+		return iA;
+	}
+
+	int32_t iB = a.m_Child1;
+	int32_t iC = a.m_Child2;
+	Node& b = m_Nodes[ iB ];
+	Node& c = m_Nodes[ iC ];
+
+	int32_t balance = c.m_Height - b.m_Height;
+
+	// rotate C up
+	if ( balance > 1 )
+	{
+		int32_t iF = c.m_Child1;
+		int32_t iG = c.m_Child2;
+		Node& f = m_Nodes[ iF ];
+		Node& g = m_Nodes[ iG ];
+
+		// swap A and C
+		c.m_Child1 = iA;
+		c.m_Parent = a.m_Parent;
+		a.m_Parent = iC;
+
+		// A's old parent should point to C
+		if ( c.m_Parent != NullProxy )
+		{
+			if ( m_Nodes[ c.m_Parent ].m_Child1 == iA )
+			{
+				m_Nodes[ c.m_Parent ].m_Child1 = iC;
+			}
+			else
+			{
+				m_Nodes[ c.m_Parent ].m_Child2 = iC;
+			}
+		}
+		else
+		{
+			m_Root = iC;
+		}
+
+		// rotate
+		if ( f.m_Height > g.m_Height )
+		{
+			c.m_Child2 = iF;
+			a.m_Child2 = iG;
+			g.m_Parent = iA;
+			a.m_Box = Combine( b.m_Box, g.m_Box );
+			c.m_Box = Combine( a.m_Box, f.m_Box );
+
+			a.m_Height = 1 + Max( b.m_Height, g.m_Height );
+			c.m_Height = 1 + Max( a.m_Height, f.m_Height );
+		}
+		else
+		{
+			c.m_Child2 = iG;
+			a.m_Child2 = iF;
+			f.m_Parent = iA;
+			a.m_Box = Combine( b.m_Box, f.m_Box );
+			c.m_Box = Combine( a.m_Box, g.m_Box );
+
+			a.m_Height = 1 + Max( b.m_Height, f.m_Height );
+			c.m_Height = 1 + Max( a.m_Height, g.m_Height );
+		}
+
+		return iC;
+	}
+
+	// rotate B up
+	if ( balance < -1 )
+	{
+		int32_t iD = b.m_Child1;
+		int32_t iE = b.m_Child2;
+		Node& d = m_Nodes[ iD ];
+		Node& e = m_Nodes[ iE ];
+
+		// swap A and B
+		b.m_Child1 = iA;
+		b.m_Parent = a.m_Parent;
+		a.m_Parent = iB;
+
+		// A's old parent should point to B
+		if ( b.m_Parent != NullProxy )
+		{
+			if ( m_Nodes[ b.m_Parent ].m_Child1 == iA )
+			{
+				m_Nodes[ b.m_Parent ].m_Child1 = iB;
+			}
+			else
+			{
+				m_Nodes[ b.m_Parent ].m_Child2 = iB;
+			}
+		}
+		else
+		{
+			m_Root = iB;
+		}
+
+		// rotate
+		if ( d.m_Height > e.m_Height )
+		{
+			b.m_Child2 = iD;
+			a.m_Child1 = iE;
+			e.m_Parent = iA;
+			a.m_Box = Combine( c.m_Box, e.m_Box );
+			b.m_Box = Combine( a.m_Box, d.m_Box );
+
+			a.m_Height = 1 + Max( c.m_Height, e.m_Height );
+			b.m_Height = 1 + Max( a.m_Height, d.m_Height );
+		}
+		else
+		{
+			b.m_Child2 = iE;
+			a.m_Child1 = iD;
+			d.m_Parent = iA;
+			a.m_Box = Combine( c.m_Box, d.m_Box );
+			b.m_Box = Combine( a.m_Box, e.m_Box );
+
+			a.m_Height = 1 + Max( c.m_Height, d.m_Height );
+			b.m_Height = 1 + Max( a.m_Height, e.m_Height );
+		}
+
+		return iB;
+	}
+
+	return iA;
+}
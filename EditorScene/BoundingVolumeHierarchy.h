@@ -0,0 +1,129 @@
+#pragma once
+
+#include "EditorScene/API.h"
+#include "Math/AlignedBox.h"
+
+#include <vector>
+
+namespace Helium
+{
+	namespace Editor
+	{
+		/////////////////////////////////////////////////////////////////////////////
+		// Dynamic bounding volume hierarchy of axis aligned boxes.  Leaves store
+		// a slightly enlarged copy of each box so that small movements do not
+		// change the tree, and insertion picks the sibling that minimizes the
+		// growth in surface area, with rotations to keep the tree balanced.
+		// Queries visit only the subtrees whose boxes pass the supplied test.
+		// 
+		class HELIUM_EDITOR_SCENE_API BoundingVolumeHierarchy
+		{
+		public:
+			static const int32_t NullProxy = -1;
+
+			BoundingVolumeHierarchy();
+
+			// remove all leaves
+			void Clear();
+
+			// add a leaf, returns the proxy used to refer to it
+			int32_t Insert( const AlignedBox& box, void* userData );
+
+			// remove a leaf
+			void Remove( int32_t proxy );
+
+			// move a leaf, returns true if the tree had to be changed
+			bool Update( int32_t proxy, const AlignedBox& box );
+
+			void* GetUserData( int32_t proxy ) const
+			{
+				HELIUM_ASSERT( proxy >= 0 && proxy < static_cast< int32_t >( m_Nodes.size() ) );
+				return m_Nodes[ proxy ].m_UserData;
+			}
+
+			const AlignedBox& GetFatBox( int32_t proxy ) const
+			{
+				HELIUM_ASSERT( proxy >= 0 && proxy < static_cast< int32_t >( m_Nodes.size() ) );
+				return m_Nodes[ proxy ].m_Box;
+			}
+
+			size_t GetLeafCount() const
+			{
+				return m_LeafCount;
+			}
+
+			int32_t GetHeight() const
+			{
+				return m_Root == NullProxy ? 0 : m_Nodes[ m_Root ].m_Height;
+			}
+
+			// collect the user data of every leaf whose box passes the test, skipping subtrees whose box fails it
+			//  - test is a functor taking a const AlignedBox& and returning bool
+			template< class BoxTest >
+			void Query( const BoxTest& test, std::vector< void* >& results ) const;
+
+		private:
+			struct Node
+			{
+				AlignedBox  m_Box;
+				void*       m_UserData;
+				int32_t     m_Parent;     // next free node when the node is on the free list
+				int32_t     m_Child1;
+				int32_t     m_Child2;
+				int32_t     m_Height;     // leaves are 0, free nodes are -1
+
+				bool IsLeaf() const
+				{
+					return m_Child1 == NullProxy;
+				}
+			};
+
+			int32_t AllocateNode();
+			void FreeNode( int32_t node );
+
+			void InsertLeaf( int32_t leaf );
+			void RemoveLeaf( int32_t leaf );
+			int32_t Balance( int32_t node );
+
+			std::vector< Node > m_Nodes;
+			int32_t             m_Root;
+			int32_t             m_FreeList;
+			size_t              m_LeafCount;
+			mutable std::vector< int32_t > m_Stack;
+		};
+
+		template< class BoxTest >
+		void BoundingVolumeHierarchy::Query( const BoxTest& test, std::vector< void* >& results ) const
+		{
+			if ( m_Root == NullProxy )
+			{
+				return;
+			}
+
+			m_Stack.clear();
+			m_Stack.push_back( m_Root );
+
+			while ( !m_Stack.empty() )
+			{
+				int32_t index = m_Stack.back();
+				m_Stack.pop_back();
+
+				const Node& node = m_Nodes[ index ];
+				if ( !test( node.m_Box ) )
+				{
+					continue;
+				}
+
+				if ( node.IsLeaf() )
+				{
+					results.push_back( node.m_UserData );
+				}
+				else
+				{
+					m_Stack.push_back( node.m_Child1 );
+					m_Stack.push_back( node.m_Child2 );
+				}
+			}
+		}
+	}
+}
@@ -64,7 +64,9 @@ namespace Helium
 
 			virtual UndoCommandPtr SetValue( const Vector3& v ) HELIUM_OVERRIDE
 			{
-				return new PropertyUndoCommand<Vector3> ( new Helium::MemberProperty<CurveControlPoint, Vector3> (m_Point, &CurveControlPoint::GetPosition, &CurveControlPoint::SetPosition), v);
+				PropertyUndoCommand<Vector3>* command = new PropertyUndoCommand<Vector3> ( new Helium::MemberProperty<CurveControlPoint, Vector3> (m_Point, &CurveControlPoint::GetPosition, &CurveControlPoint::SetPosition), v);
+				command->SetMergeKey( &m_Point->GetPosition() );
+				return command;
 			}
 		};
 
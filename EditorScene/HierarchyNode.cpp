@@ -40,6 +40,7 @@ HierarchyNode::HierarchyNode()
 	, m_Selectable( true )
 	, m_Highlighted( false )
 	, m_Reactive( false )
+	, m_PickProxy( BoundingVolumeHierarchy::NullProxy )
 {
 }
 
@@ -671,6 +672,12 @@ void HierarchyNode::Evaluate(GraphDirection direction)
 		}
 	}
 
+	// our global bounds may have changed, so our leaf in the picking hierarchy needs updating
+	if ( m_Owner )
+	{
+		m_Owner->DirtyPickBounds( this );
+	}
+
 	Base::Evaluate(direction);
 }
 
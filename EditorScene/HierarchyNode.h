@@ -188,6 +188,17 @@ namespace Helium
 
 			AlignedBox GetGlobalHierarchyBounds() const;
 
+			// leaf of this node in the owning scene's picking hierarchy
+			int32_t GetPickProxy() const
+			{
+				return m_PickProxy;
+			}
+
+			void SetPickProxy( int32_t proxy )
+			{
+				m_PickProxy = proxy;
+			}
+
 			//
 			// Hierarchy Modifiers, use by commands only
 			//
@@ -322,6 +333,7 @@ namespace Helium
 			Layer*                      m_LayerColor;               // cached pointers to use for switching color modes in the 3D view
 			AlignedBox            m_ObjectBounds;             // bounds
 			AlignedBox            m_ObjectHierarchyBounds;
+			int32_t                     m_PickProxy;                // leaf in the scene's picking hierarchy
 		};
 	}
 }
\ No newline at end of file
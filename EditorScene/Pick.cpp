@@ -171,6 +171,11 @@ bool LinePickVisitor::IntersectsBox(const AlignedBox& box) const
 	return m_PickSpaceLine.IntersectsBox(box);
 } 
 
+bool LinePickVisitor::IntersectsWorldBox(const AlignedBox& box) const
+{
+	return m_WorldSpaceLine.IntersectsBox(box);
+} 
+
 bool LinePickVisitor::AddHitPoint(const Vector3& p, Vector3& offset)
 {
 	// allocate a hit
@@ -457,6 +462,11 @@ bool FrustumPickVisitor::IntersectsBox(const AlignedBox& box) const
 	return m_PickSpaceFrustum.IntersectsBox(box);
 }
 
+bool FrustumPickVisitor::IntersectsWorldBox(const AlignedBox& box) const
+{
+	return m_WorldSpaceFrustum.IntersectsBox(box);
+}
+
 bool FrustumPickVisitor::AddHitPoint(const Vector3& p)
 {
 	// allocate a hit
@@ -746,6 +756,11 @@ bool FrustumLinePickVisitor::IntersectsBox(const AlignedBox& box) const
 	return m_PickSpaceFrustum.IntersectsBox(box);
 }
 
+bool FrustumLinePickVisitor::IntersectsWorldBox(const AlignedBox& box) const
+{
+	return m_WorldSpaceFrustum.IntersectsBox(box);
+}
+
 
 //
 // PickHit
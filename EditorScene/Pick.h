@@ -178,6 +178,9 @@ namespace Helium
 
 			// testing functions (no hits)
 			virtual bool IntersectsBox(const AlignedBox& box) const = 0;
+
+			// test a box in world space, regardless of the current object (used to cull with acceleration structures)
+			virtual bool IntersectsWorldBox(const AlignedBox& box) const = 0;
 		};
 
 		class LinePickVisitor : virtual public PickVisitor
@@ -220,6 +223,7 @@ namespace Helium
 
 			// testing functions (no hits)
 			virtual bool IntersectsBox(const AlignedBox& box) const HELIUM_OVERRIDE;
+			virtual bool IntersectsWorldBox(const AlignedBox& box) const HELIUM_OVERRIDE;
 
 		protected:
 			// hit adding functions
@@ -270,6 +274,7 @@ namespace Helium
 
 			// testing functions (no hits)
 			virtual bool IntersectsBox(const AlignedBox& box) const HELIUM_OVERRIDE;
+			virtual bool IntersectsWorldBox(const AlignedBox& box) const HELIUM_OVERRIDE;
 
 		protected:
 			// hit adding functions
@@ -306,6 +311,7 @@ namespace Helium
 
 			// testing functions (no hits)
 			virtual bool IntersectsBox(const AlignedBox& box) const HELIUM_OVERRIDE;
+			virtual bool IntersectsWorldBox(const AlignedBox& box) const HELIUM_OVERRIDE;
 		};
 
 
@@ -193,6 +193,21 @@ void PivotTransform::SetSnapPivots(bool value)
 	m_SnapPivots = value;
 }
 
+const void* PivotTransform::GetScalePivotMergeKey() const
+{
+	return &m_ScalePivot;
+}
+
+const void* PivotTransform::GetRotatePivotMergeKey() const
+{
+	return &m_RotatePivot;
+}
+
+const void* PivotTransform::GetTranslatePivotMergeKey() const
+{
+	return &m_TranslatePivot;
+}
+
 Matrix4 PivotTransform::GetScaleComponent() const
 {
 	Matrix4 spi( m_ScalePivot * -1.0f );
@@ -414,7 +429,9 @@ UndoCommandPtr PivotTransform::CenterTransform()
 		}
 	}
 
-	batch->Push( new PropertyUndoCommand<Matrix4> ( new Helium::MemberProperty<Editor::Transform, Matrix4> (this, &Editor::Transform::GetGlobalTransform, &Editor::Transform::SetGlobalTransform), Matrix4 (pos) ) );
+	DeltaPropertyUndoCommand<Matrix4>* command = new DeltaPropertyUndoCommand<Matrix4> ( new Helium::MemberProperty<Editor::Transform, Matrix4> (this, &Editor::Transform::GetGlobalTransform, &Editor::Transform::SetGlobalTransform), Matrix4 (pos) );
+	command->SetMergeKey( GetGlobalTransformMergeKey() );
+	batch->Push( command );
 
 	Evaluate(GraphDirections::Downstream);
 
@@ -77,6 +77,14 @@ namespace Helium
 			bool GetSnapPivots() const;
 			void SetSnapPivots(bool value);
 
+			//
+			// Undo Merge Keys
+			//
+
+			virtual const void* GetScalePivotMergeKey() const HELIUM_OVERRIDE;
+			virtual const void* GetRotatePivotMergeKey() const HELIUM_OVERRIDE;
+			virtual const void* GetTranslatePivotMergeKey() const HELIUM_OVERRIDE;
+
 		public:
 			virtual Matrix4 GetScaleComponent() const HELIUM_OVERRIDE;
 			virtual Matrix4 GetRotateComponent() const HELIUM_OVERRIDE;
@@ -97,6 +97,9 @@ void RotateManipulator::SetResult()
 				{
 					BatchUndoCommandPtr batch = new BatchUndoCommand ();
 
+					// consecutive drags of the same selection collapse into one undo step
+					batch->SetMergeKey( this );
+
 					std::vector< RotateManipulatorAdapter* > set = CompleteSet<RotateManipulatorAdapter>();
 					for ( std::vector<RotateManipulatorAdapter*>::const_iterator itr = set.begin(), end = set.end(); itr != end; ++itr)
 					{
@@ -139,6 +139,9 @@ void ScaleManipulator::SetResult()
 				{
 					BatchUndoCommandPtr batch = new BatchUndoCommand ();
 
+					// consecutive drags of the same selection collapse into one undo step
+					batch->SetMergeKey( this );
+
 					std::vector< ScaleManipulatorAdapter* > set = CompleteSet<ScaleManipulatorAdapter>();
 					for ( std::vector< ScaleManipulatorAdapter* >::const_iterator itr = set.begin(), end = set.end(); itr != end; ++itr )
 					{
@@ -28,6 +28,26 @@
 using namespace Helium;
 using namespace Helium::Editor;
 
+namespace
+{
+	// tests boxes from the picking hierarchy against a pick in world space
+	struct WorldBoxPickTest
+	{
+		const PickVisitor* m_Pick;
+
+		WorldBoxPickTest( const PickVisitor* pick )
+			: m_Pick( pick )
+		{
+
+		}
+
+		bool operator()( const AlignedBox& box ) const
+		{
+			return m_Pick->IntersectsWorldBox( box );
+		}
+	};
+}
+
 // TODO: Move data & serialization into SceneDefinition, drop FilePath arg, add SceneType arg
 // TODO: This will become SceneProxy
 
@@ -37,6 +57,7 @@ Scene::Scene( Editor::Viewport* viewport, SceneDefinition &definition, SceneType
 	, m_Id( TUID::Generate() )
 	, m_Progress( 0 )
 	, m_Importing( false )
+	, m_DirtyPickRoot( true )
 	, m_View( viewport )
 	, m_SmartDuplicateMatrix(Matrix4::Identity)
 	, m_ValidSmartDuplicateMatrix( false )
@@ -326,6 +347,18 @@ void Scene::Reset()
 	// Break down entire graph
 	m_Graph->Reset();
 
+	// Detach nodes from the picking hierarchy (they can outlive us in the undo queue)
+	for ( M_SceneNodeSmartPtr::const_iterator itr = m_Nodes.begin(), end = m_Nodes.end(); itr != end; ++itr )
+	{
+		Editor::HierarchyNode* hierarchyNode = Reflect::SafeCast< Editor::HierarchyNode >( itr->second );
+		if ( hierarchyNode )
+		{
+			hierarchyNode->SetPickProxy( BoundingVolumeHierarchy::NullProxy );
+		}
+	}
+	m_PickHierarchy.Clear();
+	m_DirtyPickNodes.clear();
+
 	// Clear flat hash of nodes
 	m_Nodes.clear();
 
@@ -1225,6 +1258,11 @@ void Scene::AddSceneNode( const SceneNodePtr& node )
 		{
 			hierarchyNode->SetParent(m_Root);
 		}
+
+		if ( hierarchyNode )
+		{
+			DirtyPickBounds( hierarchyNode );
+		}
 	}
 
 	{
@@ -1245,6 +1283,13 @@ void Scene::RemoveSceneNode( const SceneNodePtr& node )
 		e_NodeRemoving.Raise( NodeChangeArgs( node.Ptr() ) );
 	}
 
+	// remove from picking
+	Editor::HierarchyNode* hierarchyNode = Reflect::SafeCast< Editor::HierarchyNode >( node );
+	if ( hierarchyNode )
+	{
+		RemovePickBounds( hierarchyNode );
+	}
+
 	// remove shortcuts to node and children
 	m_Nodes.erase( node->GetID() );
 
@@ -1303,13 +1348,94 @@ bool Scene::Pick( PickVisitor* pick ) const
 
 	size_t hitCount = pick->GetHits().size();
 
+	UpdatePickHierarchy();
+
+	// only visit the nodes whose global hierarchy bounds the pick reaches
+	m_PickCandidates.clear();
+	m_PickHierarchy.Query( WorldBoxPickTest( pick ), m_PickCandidates );
+
 	HierarchyPickTraverser pickTraverser ( pick );
 
-	m_Root->TraverseHierarchy ( &pickTraverser );
+	for ( std::vector< void* >::const_iterator itr = m_PickCandidates.begin(), end = m_PickCandidates.end(); itr != end; ++itr )
+	{
+		pickTraverser.VisitHierarchyNode( static_cast< Editor::HierarchyNode* >( *itr ) );
+	}
 
 	return pick->GetHits().size() > hitCount;
 }
 
+void Scene::DirtyPickBounds( HierarchyNode* node )
+{
+	if ( node == m_Root.Ptr() )
+	{
+		m_DirtyPickRoot = true;
+	}
+	else
+	{
+		// track by id, the node may be released before the next pick
+		m_DirtyPickNodes.insert( node->GetID() );
+	}
+}
+
+void Scene::UpdatePickHierarchy() const
+{
+	HELIUM_EDITOR_SCENE_SCOPE_TIMER( "" );
+
+	if ( m_DirtyPickRoot )
+	{
+		UpdatePickBounds( m_Root.Ptr() );
+		m_DirtyPickRoot = false;
+	}
+
+	for ( std::set< TUID >::const_iterator itr = m_DirtyPickNodes.begin(), end = m_DirtyPickNodes.end(); itr != end; ++itr )
+	{
+		// skip nodes that have been removed from the scene since they were dirtied
+		M_SceneNodeSmartPtr::const_iterator found = m_Nodes.find( *itr );
+		if ( found != m_Nodes.end() )
+		{
+			Editor::HierarchyNode* hierarchyNode = Reflect::SafeCast< Editor::HierarchyNode >( found->second );
+			if ( hierarchyNode )
+			{
+				UpdatePickBounds( hierarchyNode );
+			}
+		}
+	}
+
+	m_DirtyPickNodes.clear();
+}
+
+void Scene::UpdatePickBounds( HierarchyNode* node ) const
+{
+	const AlignedBox& objectBounds = node->GetObjectHierarchyBounds();
+	if ( objectBounds.minimum.x > objectBounds.maximum.x || objectBounds.minimum.y > objectBounds.maximum.y || objectBounds.minimum.z > objectBounds.maximum.z )
+	{
+		// empty bounds can never intersect a pick
+		RemovePickBounds( node );
+		return;
+	}
+
+	AlignedBox bounds = node->GetGlobalHierarchyBounds();
+
+	if ( node->GetPickProxy() == BoundingVolumeHierarchy::NullProxy )
+	{
+		node->SetPickProxy( m_PickHierarchy.Insert( bounds, node ) );
+	}
+	else
+	{
+		m_PickHierarchy.Update( node->GetPickProxy(), bounds );
+	}
+}
+
+void Scene::RemovePickBounds( HierarchyNode* node ) const
+{
+	if ( node->GetPickProxy() != BoundingVolumeHierarchy::NullProxy )
+	{
+		HELIUM_ASSERT( m_PickHierarchy.GetUserData( node->GetPickProxy() ) == node );
+		m_PickHierarchy.Remove( node->GetPickProxy() );
+		node->SetPickProxy( BoundingVolumeHierarchy::NullProxy );
+	}
+}
+
 void Scene::Select( const SelectArgs& args )
 {
 	HELIUM_EDITOR_SCENE_SCOPE_TIMER( "" );
@@ -2616,7 +2742,9 @@ UndoCommandPtr Scene::SmartDuplicateSelected()
 	batch->Push( new ParentCommand( duplicate, node->GetParent() ) );
 
 	// set the global transform for the duplicate object
-	batch->Push( new PropertyUndoCommand<Matrix4> ( new Helium::MemberProperty<Editor::Transform, Matrix4> (transform, &Editor::Transform::GetGlobalTransform, &Editor::Transform::SetGlobalTransform), matrix ) );
+	DeltaPropertyUndoCommand<Matrix4>* command = new DeltaPropertyUndoCommand<Matrix4> ( new Helium::MemberProperty<Editor::Transform, Matrix4> (transform, &Editor::Transform::GetGlobalTransform, &Editor::Transform::SetGlobalTransform), matrix );
+	command->SetMergeKey( transform->GetGlobalTransformMergeKey() );
+	batch->Push( command );
 
 	// make sure the new nodes are initialized
 	duplicate->InitializeHierarchy();
@@ -2649,7 +2777,9 @@ UndoCommandPtr Scene::SnapSelectedToCamera()
 
 		if (transform)
 		{
-			batch->Push( new PropertyUndoCommand<Matrix4> ( new Helium::MemberProperty<Editor::Transform, Matrix4> (transform, &Editor::Transform::GetGlobalTransform, &Editor::Transform::SetGlobalTransform), m ) );
+			DeltaPropertyUndoCommand<Matrix4>* command = new DeltaPropertyUndoCommand<Matrix4> ( new Helium::MemberProperty<Editor::Transform, Matrix4> (transform, &Editor::Transform::GetGlobalTransform, &Editor::Transform::SetGlobalTransform), m );
+			command->SetMergeKey( transform->GetGlobalTransformMergeKey() );
+			batch->Push( command );
 		}
 	}
 
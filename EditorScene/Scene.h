@@ -18,6 +18,7 @@
 #include "Framework/SceneDefinition.h"
 
 #include "Pick.h"
+#include "BoundingVolumeHierarchy.h"
 #include "Tool.h"
 #include "SceneNode.h"
 #include "Graph.h"
@@ -303,6 +304,14 @@ namespace Helium
 			void Render( RenderVisitor* render );
 			bool Pick( PickVisitor* pick ) const;
 
+			// flag a node whose global bounds may have changed, its pick leaf is refreshed before the next pick
+			void DirtyPickBounds( HierarchyNode* node );
+
+			const BoundingVolumeHierarchy& GetPickHierarchy() const
+			{
+				return m_PickHierarchy;
+			}
+
 			// selection and highlight setup
 			void Select( const SelectArgs& args );
 			void SetHighlight( const SetHighlightArgs& args );
@@ -421,6 +430,11 @@ namespace Helium
 			/// Evaluate dependency graph.
 			void Evaluate( bool silent = false );
 
+			/// Bring the picking hierarchy up to date with the nodes that have moved since the last pick.
+			void UpdatePickHierarchy() const;
+			void UpdatePickBounds( HierarchyNode* node ) const;
+			void RemovePickBounds( HierarchyNode* node ) const;
+
 			// Change and Scene Management helpers
 			void ViewPreferencesChanged( const Reflect::ObjectChangeArgs& args );
 
@@ -470,6 +484,12 @@ namespace Helium
 			// container for nodes sorted by name
 			M_NameToSceneNodeDumbPtr m_Names;
 
+			// picking acceleration, kept up to date lazily from the nodes evaluated since the last pick
+			mutable BoundingVolumeHierarchy m_PickHierarchy;
+			mutable std::set< TUID > m_DirtyPickNodes;
+			mutable bool m_DirtyPickRoot;
+			mutable std::vector< void* > m_PickCandidates;
+
 			// selection of this scene
 			Selection m_Selection;
 
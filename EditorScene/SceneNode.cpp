@@ -396,12 +396,20 @@ void SceneNode::SetState( const Reflect::ObjectPtr& state )
 
 UndoCommandPtr SceneNode::SnapShot( Reflect::Object* newState )
 {
+	PropertyUndoCommand<Reflect::ObjectPtr>* command;
 	if ( newState == NULL )
 	{
-		return new PropertyUndoCommand<Reflect::ObjectPtr>( new Helium::MemberProperty<SceneNode, Reflect::ObjectPtr> (this, &SceneNode::GetState, &SceneNode::SetState) );
+		command = new PropertyUndoCommand<Reflect::ObjectPtr>( new Helium::MemberProperty<SceneNode, Reflect::ObjectPtr> (this, &SceneNode::GetState, &SceneNode::SetState) );
 	}
+	else
+	{
+		command = new PropertyUndoCommand<Reflect::ObjectPtr>( new Helium::MemberProperty<SceneNode, Reflect::ObjectPtr> (this, &SceneNode::GetState, &SceneNode::SetState), Reflect::ObjectPtr( newState ) );
+	}
+
+	// successive snapshots of this node (scrubbing a property) collapse into one undo step
+	command->SetMergeKey( this );
 
-	return new PropertyUndoCommand<Reflect::ObjectPtr>( new Helium::MemberProperty<SceneNode, Reflect::ObjectPtr> (this, &SceneNode::GetState, &SceneNode::SetState), Reflect::ObjectPtr( newState ) );
+	return command;
 }
 
 bool SceneNode::IsSelectable() const
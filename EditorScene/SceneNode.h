@@ -375,4 +375,18 @@ namespace Helium
 			uint32_t                m_VisitedID;                            // data cached for evaluation
 		};
 	}
+
+	//
+	// SnapShot() commands hold a clone of the node's state, which is only kept alive by the undo queue; count the
+	//  clone's instance size toward the undo memory budget (heap data owned by its fields is not included)
+	//
+
+	template <>
+	struct UndoValueSize< Reflect::ObjectPtr >
+	{
+		static size_t Get( const Reflect::ObjectPtr& value )
+		{
+			return value.ReferencesObject() ? value->GetMetaClass()->m_Size : 0;
+		}
+	};
 }
\ No newline at end of file
@@ -126,6 +126,21 @@ void Transform::SetTranslatePivot( const Vector3& value )
 
 }
 
+const void* Transform::GetScalePivotMergeKey() const
+{
+	return NULL;
+}
+
+const void* Transform::GetRotatePivotMergeKey() const
+{
+	return NULL;
+}
+
+const void* Transform::GetTranslatePivotMergeKey() const
+{
+	return NULL;
+}
+
 void Transform::SetObjectTransform( const Matrix4& transform )
 {
 	Scale scale;
@@ -185,7 +200,8 @@ Matrix4 Transform::GetTranslateComponent() const
 
 UndoCommandPtr Transform::ResetTransform()
 {
-	UndoCommandPtr command = new PropertyUndoCommand<Matrix4>( new Helium::MemberProperty<Editor::Transform, Matrix4> (this, &Transform::GetObjectTransform, &Transform::SetObjectTransform) );
+	DeltaPropertyUndoCommand<Matrix4>* command = new DeltaPropertyUndoCommand<Matrix4>( new Helium::MemberProperty<Editor::Transform, Matrix4> (this, &Transform::GetObjectTransform, &Transform::SetObjectTransform) );
+	command->SetMergeKey( GetObjectTransformMergeKey() );
 
 	m_Scale = Scale::Identity;
 	m_Rotate = EulerAngles::Zero;
@@ -118,6 +118,40 @@ namespace Helium
 			bool GetInheritTransform() const;
 			void SetInheritTransform(bool inherit);
 
+			//
+			// Undo Merge Keys (identify the data changed by each setter above, see UndoCommand::GetMergeKey)
+			//
+
+			const void* GetScaleMergeKey() const
+			{
+				return &m_Scale;
+			}
+
+			const void* GetRotateMergeKey() const
+			{
+				return &m_Rotate;
+			}
+
+			const void* GetTranslateMergeKey() const
+			{
+				return &m_Translate;
+			}
+
+			const void* GetObjectTransformMergeKey() const
+			{
+				return &m_ObjectTransform;
+			}
+
+			const void* GetGlobalTransformMergeKey() const
+			{
+				return &m_GlobalTransform;
+			}
+
+			// pivots are not stored by Transform, so pivot changes are never merged unless a subclass stores them
+			virtual const void* GetScalePivotMergeKey() const;
+			virtual const void* GetRotatePivotMergeKey() const;
+			virtual const void* GetTranslatePivotMergeKey() const;
+
 		public:
 			// compute scaling component
 			virtual Matrix4 GetScaleComponent() const;
@@ -199,7 +233,9 @@ namespace Helium
 
 			virtual UndoCommandPtr SetValue(const Scale& v) HELIUM_OVERRIDE
 			{
-				return new PropertyUndoCommand<Scale> ( new Helium::MemberProperty<Editor::Transform, Scale> (m_Transform, &Editor::Transform::GetScale, &Editor::Transform::SetScale), v );
+				PropertyUndoCommand<Scale>* command = new PropertyUndoCommand<Scale> ( new Helium::MemberProperty<Editor::Transform, Scale> (m_Transform, &Editor::Transform::GetScale, &Editor::Transform::SetScale), v );
+				command->SetMergeKey( m_Transform->GetScaleMergeKey() );
+				return command;
 			}
 		};
 
@@ -241,7 +277,9 @@ namespace Helium
 
 			virtual UndoCommandPtr SetValue(const Vector3& v) HELIUM_OVERRIDE
 			{
-				return new PropertyUndoCommand<Vector3> ( new Helium::MemberProperty<Editor::Transform, Vector3> (m_Transform, &Editor::Transform::GetScalePivot, &Editor::Transform::SetScalePivot), v );
+				PropertyUndoCommand<Vector3>* command = new PropertyUndoCommand<Vector3> ( new Helium::MemberProperty<Editor::Transform, Vector3> (m_Transform, &Editor::Transform::GetScalePivot, &Editor::Transform::SetScalePivot), v );
+				command->SetMergeKey( m_Transform->GetScalePivotMergeKey() );
+				return command;
 			}
 		};
 
@@ -278,7 +316,9 @@ namespace Helium
 
 			virtual UndoCommandPtr SetValue(const EulerAngles& v) HELIUM_OVERRIDE
 			{
-				return new PropertyUndoCommand<EulerAngles> ( new Helium::MemberProperty<Editor::Transform, EulerAngles> (m_Transform, &Editor::Transform::GetRotate, &Editor::Transform::SetRotate), v );
+				PropertyUndoCommand<EulerAngles>* command = new PropertyUndoCommand<EulerAngles> ( new Helium::MemberProperty<Editor::Transform, EulerAngles> (m_Transform, &Editor::Transform::GetRotate, &Editor::Transform::SetRotate), v );
+				command->SetMergeKey( m_Transform->GetRotateMergeKey() );
+				return command;
 			}
 		};
 
@@ -320,7 +360,9 @@ namespace Helium
 
 			virtual UndoCommandPtr SetValue(const Vector3& v) HELIUM_OVERRIDE
 			{
-				return new PropertyUndoCommand<Vector3> ( new Helium::MemberProperty<Editor::Transform, Vector3> (m_Transform, &Editor::Transform::GetRotatePivot, &Editor::Transform::SetRotatePivot), v );
+				PropertyUndoCommand<Vector3>* command = new PropertyUndoCommand<Vector3> ( new Helium::MemberProperty<Editor::Transform, Vector3> (m_Transform, &Editor::Transform::GetRotatePivot, &Editor::Transform::SetRotatePivot), v );
+				command->SetMergeKey( m_Transform->GetRotatePivotMergeKey() );
+				return command;
 			}
 		};
 
@@ -357,7 +399,9 @@ namespace Helium
 
 			virtual UndoCommandPtr SetValue(const Vector3& v) HELIUM_OVERRIDE
 			{
-				return new PropertyUndoCommand<Vector3> ( new Helium::MemberProperty<Editor::Transform, Vector3> (m_Transform, &Editor::Transform::GetTranslate, &Editor::Transform::SetTranslate), v );
+				PropertyUndoCommand<Vector3>* command = new PropertyUndoCommand<Vector3> ( new Helium::MemberProperty<Editor::Transform, Vector3> (m_Transform, &Editor::Transform::GetTranslate, &Editor::Transform::SetTranslate), v );
+				command->SetMergeKey( m_Transform->GetTranslateMergeKey() );
+				return command;
 			}
 		};
 
@@ -399,7 +443,9 @@ namespace Helium
 
 			virtual UndoCommandPtr SetValue(const Vector3& v) HELIUM_OVERRIDE
 			{
-				return new PropertyUndoCommand<Vector3> ( new Helium::MemberProperty<Editor::Transform, Vector3> (m_Transform, &Editor::Transform::GetTranslatePivot, &Editor::Transform::SetTranslatePivot), v );
+				PropertyUndoCommand<Vector3>* command = new PropertyUndoCommand<Vector3> ( new Helium::MemberProperty<Editor::Transform, Vector3> (m_Transform, &Editor::Transform::GetTranslatePivot, &Editor::Transform::SetTranslatePivot), v );
+				command->SetMergeKey( m_Transform->GetTranslatePivotMergeKey() );
+				return command;
 			}
 		};
 	}
@@ -159,6 +159,9 @@ void TranslateManipulator::SetResult()
 				{
 					BatchUndoCommandPtr batch = new BatchUndoCommand ();
 
+					// consecutive drags of the same selection collapse into one undo step
+					batch->SetMergeKey( this );
+
 					std::vector< TranslateManipulatorAdapter* > set = CompleteSet<TranslateManipulatorAdapter>();
 					for ( std::vector< TranslateManipulatorAdapter* >::const_iterator itr = set.begin(), end = set.end(); itr != end; ++itr )
 					{
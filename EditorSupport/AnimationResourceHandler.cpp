@@ -68,14 +68,82 @@ bool AnimationResourceHandler::CacheResource(
 
     return bCacheResult;
 #else
-    HELIUM_UNREF( pAssetPreprocessor );
-    HELIUM_UNREF( rSourceFilePath );
+    // Tracks are sampled once per source frame; blending between samples at runtime covers the time in between.
+    DynamicArray< FbxSupport::AnimTrackData > tracks;
+    uint_fast32_t samplesPerSecond = 0;
+    bool bLoadSuccess = m_rFbxSupport.LoadAnimation( rSourceFilePath, 1, tracks, samplesPerSecond );
+    if( !bLoadSuccess )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "AnimationResourceHandler::CacheResource(): Failed to build animation from source file \"%s\".\n" ),
+            *rSourceFilePath );
+
+        return false;
+    }
+
+    size_t trackCount = tracks.GetSize();
+    size_t sampleCount = ( trackCount != 0 ? tracks[ 0 ].keys.GetSize() : 0 );
+    for( size_t trackIndex = 1; trackIndex < trackCount; ++trackIndex )
+    {
+        if( tracks[ trackIndex ].keys.GetSize() != sampleCount )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                ( TXT( "AnimationResourceHandler::CacheResource(): Tracks in source file \"%s\" have mismatched " )
+                  TXT( "sample counts.\n" ) ),
+                *rSourceFilePath );
+
+            return false;
+        }
+    }
+
+    HELIUM_ASSERT( sampleCount <= UINT32_MAX );
+
+    StrongPtr< Animation::PersistentResourceData > resource_data( new Animation::PersistentResourceData() );
+    resource_data->m_sampleCount = static_cast< uint32_t >( sampleCount );
+    resource_data->m_samplesPerSecond = static_cast< float32_t >( samplesPerSecond );
+
+    resource_data->m_trackNames.Reserve( trackCount );
+    for( size_t trackIndex = 0; trackIndex < trackCount; ++trackIndex )
+    {
+        resource_data->m_trackNames.Push( tracks[ trackIndex ].name );
+    }
+
+    // Interleave the tracks so that the keys for all tracks at a given sample are contiguous.
+    DynamicArray< float32_t >& rKeys = resource_data->m_keys;
+    rKeys.Reserve( sampleCount * trackCount * Animation::KEY_VALUE_COUNT );
+    for( size_t sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex )
+    {
+        for( size_t trackIndex = 0; trackIndex < trackCount; ++trackIndex )
+        {
+            const FbxSupport::Key& rKey = tracks[ trackIndex ].keys[ sampleIndex ];
+
+            rKeys.Push( rKey.translation.GetElement( 0 ) );
+            rKeys.Push( rKey.translation.GetElement( 1 ) );
+            rKeys.Push( rKey.translation.GetElement( 2 ) );
+            rKeys.Push( rKey.rotation.GetElement( 0 ) );
+            rKeys.Push( rKey.rotation.GetElement( 1 ) );
+            rKeys.Push( rKey.rotation.GetElement( 2 ) );
+            rKeys.Push( rKey.rotation.GetElement( 3 ) );
+            rKeys.Push( rKey.scale.GetElement( 0 ) );
+            rKeys.Push( rKey.scale.GetElement( 1 ) );
+            rKeys.Push( rKey.scale.GetElement( 2 ) );
+        }
+    }
 
     for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
     {
+        PlatformPreprocessor* pPreprocessor = pAssetPreprocessor->GetPlatformPreprocessor(
+            static_cast< Cache::EPlatform >( platformIndex ) );
+        if( !pPreprocessor )
+        {
+            continue;
+        }
+
         Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
             static_cast< Cache::EPlatform >( platformIndex ) );
-        rPreprocessedData.persistentDataBuffer.Clear();
+        SaveObjectToPersistentDataBuffer( resource_data.Get(), rPreprocessedData.persistentDataBuffer );
         rPreprocessedData.subDataBuffers.Clear();
         rPreprocessedData.bLoaded = true;
     }
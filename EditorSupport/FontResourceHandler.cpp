@@ -5,11 +5,13 @@
 #include "EditorSupport/FontResourceHandler.h"
 
 #include "Engine/FileLocations.h"
+#include "Engine/WorkerPool.h"
 #include "Foundation/FileStream.h"
 #include "PcSupport/AssetPreprocessor.h"
 #include "PcSupport/PlatformPreprocessor.h"
 #include "EditorSupport/Image.h"
 #include "EditorSupport/MemoryTextureOutputHandler.h"
+#include "Platform/Timer.h"
 
 #include FT_MODULE_H
 
@@ -22,6 +24,224 @@ using namespace Helium;
 /// Maximum Unicode code point value.
 static const uint_fast32_t UNICODE_CODE_POINT_MAX = 0x10ffff;
 
+/// Parameters for compressing a set of font texture sheets on the shared worker pool.
+struct FontTextureSheetSet
+{
+    /// Sheet width, in pixels.
+    uint16_t width;
+    /// Sheet height, in pixels.
+    uint16_t height;
+    /// Sheet compression scheme.
+    Font::ECompression compression;
+    /// Uncompressed grayscale data for each sheet.
+    const DynamicArray< DynamicArray< uint8_t > >* pSourceSheets;
+    /// Compressed data for each sheet.
+    DynamicArray< DynamicArray< uint8_t > >* pOutputSheets;
+};
+
+/// Distance, in output texels, covered by the range of values in signed distance field texture sheets.
+static const uint32_t DISTANCE_FIELD_SPREAD = 4;
+/// Factor by which glyphs are upscaled when rendering them for signed distance field generation.
+static const uint32_t DISTANCE_FIELD_UPSCALE = 8;
+/// Value used to represent infinite squared distances during distance field generation.
+static const float32_t DISTANCE_FIELD_INFINITY = 1.0e20f;
+
+/// Compute the squared Euclidean distance transform of a one-dimensional sampled function (Felzenszwalb and
+/// Huttenlocher).
+///
+/// @param[in]  pFunction    Function values (zero for feature samples, DISTANCE_FIELD_INFINITY elsewhere).
+/// @param[out] pDistances   Squared distance from each sample to the nearest feature sample.
+/// @param[in]  pVertices    Scratch buffer for parabola vertex locations (must hold count entries).
+/// @param[in]  pBoundaries  Scratch buffer for parabola boundaries (must hold count + 1 entries).
+/// @param[in]  count        Number of samples.
+static void DistanceTransform1d(
+    const float32_t* pFunction,
+    float32_t* pDistances,
+    int32_t* pVertices,
+    float32_t* pBoundaries,
+    int32_t count )
+{
+    int32_t vertexIndex = 0;
+    pVertices[ 0 ] = 0;
+    pBoundaries[ 0 ] = -DISTANCE_FIELD_INFINITY;
+    pBoundaries[ 1 ] = DISTANCE_FIELD_INFINITY;
+
+    for( int32_t sampleIndex = 1; sampleIndex < count; ++sampleIndex )
+    {
+        // Find the intersection with the lower envelope of the parabolas processed so far, discarding any parabolas
+        // hidden by the parabola for this sample (the boundary of the first parabola is lower than any intersection,
+        // so it is never discarded).
+        float32_t sample = static_cast< float32_t >( sampleIndex );
+        float32_t intersection;
+        for( ; ; )
+        {
+            int32_t vertex = pVertices[ vertexIndex ];
+            float32_t vertexFloat = static_cast< float32_t >( vertex );
+            intersection =
+                ( ( pFunction[ sampleIndex ] + sample * sample ) - ( pFunction[ vertex ] + vertexFloat * vertexFloat ) ) /
+                ( 2.0f * ( sample - vertexFloat ) );
+            if( intersection > pBoundaries[ vertexIndex ] )
+            {
+                break;
+            }
+
+            HELIUM_ASSERT( vertexIndex > 0 );
+            --vertexIndex;
+        }
+
+        ++vertexIndex;
+        pVertices[ vertexIndex ] = sampleIndex;
+        pBoundaries[ vertexIndex ] = intersection;
+        pBoundaries[ vertexIndex + 1 ] = DISTANCE_FIELD_INFINITY;
+    }
+
+    vertexIndex = 0;
+    for( int32_t sampleIndex = 0; sampleIndex < count; ++sampleIndex )
+    {
+        float32_t sample = static_cast< float32_t >( sampleIndex );
+        while( pBoundaries[ vertexIndex + 1 ] < sample )
+        {
+            ++vertexIndex;
+        }
+
+        float32_t offset = sample - static_cast< float32_t >( pVertices[ vertexIndex ] );
+        pDistances[ sampleIndex ] = offset * offset + pFunction[ pVertices[ vertexIndex ] ];
+    }
+}
+
+/// Compute the squared Euclidean distance from each texel in an image to the nearest texel flagged as a feature.
+///
+/// @param[in,out] pField   On input, zero for feature texels and DISTANCE_FIELD_INFINITY elsewhere.  On output, the
+///                         squared distance to the nearest feature texel.
+/// @param[in]     width    Image width, in texels.
+/// @param[in]     height   Image height, in texels.
+static void DistanceTransform2d( float32_t* pField, int32_t width, int32_t height )
+{
+    HELIUM_ASSERT( pField );
+
+    int32_t maxDimension = Max( width, height );
+
+    DynamicArray< float32_t > function;
+    DynamicArray< float32_t > distances;
+    DynamicArray< int32_t > vertices;
+    DynamicArray< float32_t > boundaries;
+    function.Resize( maxDimension );
+    distances.Resize( maxDimension );
+    vertices.Resize( maxDimension );
+    boundaries.Resize( maxDimension + 1 );
+
+    // Transform each column, then each row of the column results.
+    for( int32_t x = 0; x < width; ++x )
+    {
+        for( int32_t y = 0; y < height; ++y )
+        {
+            function[ y ] = pField[ y * width + x ];
+        }
+
+        DistanceTransform1d( function.GetData(), distances.GetData(), vertices.GetData(), boundaries.GetData(), height );
+
+        for( int32_t y = 0; y < height; ++y )
+        {
+            pField[ y * width + x ] = distances[ y ];
+        }
+    }
+
+    for( int32_t y = 0; y < height; ++y )
+    {
+        float32_t* pRow = pField + y * width;
+        MemoryCopy( function.GetData(), pRow, width * sizeof( float32_t ) );
+
+        DistanceTransform1d( function.GetData(), distances.GetData(), vertices.GetData(), boundaries.GetData(), width );
+
+        MemoryCopy( pRow, distances.GetData(), width * sizeof( float32_t ) );
+    }
+}
+
+/// Generate a signed distance field image from an upscaled anti-aliased glyph bitmap.
+///
+/// @param[in]  pCoverage       Glyph coverage bitmap, rendered at DISTANCE_FIELD_UPSCALE times the target size.
+/// @param[in]  coveragePitch   Number of bytes between rows in the coverage bitmap.
+/// @param[in]  coverageWidth   Coverage bitmap width, in pixels.
+/// @param[in]  coverageHeight  Coverage bitmap height, in pixels.
+/// @param[out] rOutput         Distance field image, including DISTANCE_FIELD_SPREAD texels of padding on each side.
+/// @param[out] rOutputWidth    Distance field image width, in texels.
+/// @param[out] rOutputHeight   Distance field image height, in texels.
+static void GenerateDistanceField(
+    const uint8_t* pCoverage,
+    int32_t coveragePitch,
+    uint32_t coverageWidth,
+    uint32_t coverageHeight,
+    DynamicArray< uint8_t >& rOutput,
+    uint32_t& rOutputWidth,
+    uint32_t& rOutputHeight )
+{
+    rOutput.Resize( 0 );
+    rOutputWidth = 0;
+    rOutputHeight = 0;
+
+    // Glyphs without an image (i.e. spaces) don't need a distance field.
+    if( coverageWidth == 0 || coverageHeight == 0 )
+    {
+        return;
+    }
+
+    HELIUM_ASSERT( pCoverage );
+
+    rOutputWidth = ( coverageWidth + DISTANCE_FIELD_UPSCALE - 1 ) / DISTANCE_FIELD_UPSCALE + 2 * DISTANCE_FIELD_SPREAD;
+    rOutputHeight = ( coverageHeight + DISTANCE_FIELD_UPSCALE - 1 ) / DISTANCE_FIELD_UPSCALE + 2 * DISTANCE_FIELD_SPREAD;
+
+    // Build the inside and outside feature maps over the padded, upscaled glyph area.
+    int32_t fieldWidth = static_cast< int32_t >( rOutputWidth * DISTANCE_FIELD_UPSCALE );
+    int32_t fieldHeight = static_cast< int32_t >( rOutputHeight * DISTANCE_FIELD_UPSCALE );
+    int32_t padding = static_cast< int32_t >( DISTANCE_FIELD_SPREAD * DISTANCE_FIELD_UPSCALE );
+    size_t fieldSize = static_cast< size_t >( fieldWidth ) * static_cast< size_t >( fieldHeight );
+
+    DynamicArray< float32_t > outsideDistances;
+    DynamicArray< float32_t > insideDistances;
+    outsideDistances.Add( DISTANCE_FIELD_INFINITY, fieldSize );
+    insideDistances.Add( 0.0f, fieldSize );
+
+    for( uint32_t y = 0; y < coverageHeight; ++y )
+    {
+        const uint8_t* pCoverageRow = pCoverage + static_cast< ptrdiff_t >( y ) * coveragePitch;
+        size_t fieldRowOffset = static_cast< size_t >( y + padding ) * fieldWidth + padding;
+
+        for( uint32_t x = 0; x < coverageWidth; ++x )
+        {
+            if( pCoverageRow[ x ] >= 128 )
+            {
+                outsideDistances[ fieldRowOffset + x ] = 0.0f;
+                insideDistances[ fieldRowOffset + x ] = DISTANCE_FIELD_INFINITY;
+            }
+        }
+    }
+
+    DistanceTransform2d( outsideDistances.GetData(), fieldWidth, fieldHeight );
+    DistanceTransform2d( insideDistances.GetData(), fieldWidth, fieldHeight );
+
+    // Sample the signed distance at the center of each output texel, mapping the edge to 128 and the spread distance
+    // inside and outside the glyph to 255 and 0, respectively.
+    float32_t scale = 127.0f / static_cast< float32_t >( padding );
+
+    rOutput.Resize( static_cast< size_t >( rOutputWidth ) * rOutputHeight );
+    uint8_t* pOutputTexel = rOutput.GetData();
+
+    for( uint32_t outputY = 0; outputY < rOutputHeight; ++outputY )
+    {
+        size_t fieldRowOffset =
+            static_cast< size_t >( outputY * DISTANCE_FIELD_UPSCALE + DISTANCE_FIELD_UPSCALE / 2 ) * fieldWidth;
+
+        for( uint32_t outputX = 0; outputX < rOutputWidth; ++outputX )
+        {
+            size_t fieldIndex = fieldRowOffset + outputX * DISTANCE_FIELD_UPSCALE + DISTANCE_FIELD_UPSCALE / 2;
+            float32_t signedDistance = sqrtf( insideDistances[ fieldIndex ] ) - sqrtf( outsideDistances[ fieldIndex ] );
+            float32_t value = 128.0f + signedDistance * scale;
+
+            *( pOutputTexel++ ) = static_cast< uint8_t >( Clamp( value + 0.5f, 0.0f, 255.0f ) );
+        }
+    }
+}
+
 /// Allocate a block of memory for FreeType.
 ///
 /// @param[in] pMemory  Handle to the source memory manager.
@@ -124,6 +344,8 @@ int32_t FontResourceHandler::sm_InitCount = 0;
 /// Constructor.
 FontResourceHandler::FontResourceHandler()
 {
+	WorkerPool::Startup();
+
 	if (!sm_InitCount)
 	{
 #if HELIUM_TOOLS
@@ -143,6 +365,8 @@ FontResourceHandler::~FontResourceHandler()
 		FontResourceHandler::DestroyStaticLibrary();
 #endif
 	}
+
+	WorkerPool::Shutdown();
 }
 
 /// @copydoc ResourceHandler::GetResourceType()
@@ -171,6 +395,114 @@ bool FontResourceHandler::CacheResource(
 
     Font* pFont = Reflect::AssertCast< Font >( pResource );
 
+    // Render the glyphs into texture sheets.
+    uint16_t textureSheetWidth = Max< uint16_t >( pFont->GetTextureSheetWidth(), 1 );
+    uint16_t textureSheetHeight = Max< uint16_t >( pFont->GetTextureSheetHeight(), 1 );
+    bool bDistanceField = pFont->GetDistanceField();
+
+    StrongPtr< Font::PersistentResourceData > resource_data( new Font::PersistentResourceData() );
+    DynamicArray< DynamicArray< uint8_t > > textureSheets;
+    if( !BuildTextureSheets(
+        rSourceFilePath,
+        pFont->GetPointSize(),
+        pFont->GetDpi(),
+        textureSheetWidth,
+        textureSheetHeight,
+        pFont->GetAntialiased(),
+        bDistanceField,
+        *resource_data,
+        textureSheets ) )
+    {
+        return false;
+    }
+
+    // Distance fields are always stored uncompressed, as block compression would distort the edge reconstruction.
+    Font::ECompression textureCompression = pFont->GetTextureCompression();
+    if( bDistanceField )
+    {
+        textureCompression = Font::ECompression::GRAYSCALE_UNCOMPRESSED;
+    }
+
+    // Compress the texture sheets in parallel (uncompressed grayscale sheets are already in their final form).
+    if( textureCompression != Font::ECompression::GRAYSCALE_UNCOMPRESSED )
+    {
+        uint64_t compressStartTicks = Timer::GetTickCount();
+
+        DynamicArray< DynamicArray< uint8_t > > compressedSheets;
+        compressedSheets.Resize( textureSheets.GetSize() );
+
+        FontTextureSheetSet sheetSet;
+        sheetSet.width = textureSheetWidth;
+        sheetSet.height = textureSheetHeight;
+        sheetSet.compression = textureCompression;
+        sheetSet.pSourceSheets = &textureSheets;
+        sheetSet.pOutputSheets = &compressedSheets;
+
+        WorkerPool* pWorkerPool = WorkerPool::GetStaticInstance();
+        HELIUM_ASSERT( pWorkerPool );
+        pWorkerPool->Run( CompressTextureSheetCallback, &sheetSet, textureSheets.GetSize() );
+
+        textureSheets.Swap( compressedSheets );
+
+        HELIUM_TRACE(
+            TraceLevels::Info,
+            ( TXT( "FontResourceHandler: Compressed %" ) PRIuSZ TXT( " texture sheets for font resource \"%s\" in " )
+              TXT( "%.2f ms.\n" ) ),
+            textureSheets.GetSize(),
+            *rSourceFilePath,
+            static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - compressStartTicks ) ) );
+    }
+
+    // Cache the font data.
+    for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
+    {
+        PlatformPreprocessor* pPreprocessor = pAssetPreprocessor->GetPlatformPreprocessor(
+            static_cast< Cache::EPlatform >( platformIndex ) );
+
+        if( !pPreprocessor )
+        {
+            continue;
+        }
+
+        Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
+            static_cast< Cache::EPlatform >( platformIndex ) );
+        //rPreprocessedData.persistentDataBuffer = ;
+        SaveObjectToPersistentDataBuffer(resource_data.Get(), rPreprocessedData.persistentDataBuffer);
+        rPreprocessedData.subDataBuffers = textureSheets;
+        rPreprocessedData.bLoaded = true;
+
+    }
+
+    return true;
+}
+
+/// Render the glyphs of a font into uncompressed 8-bit grayscale texture sheets.
+///
+/// @param[in]  rSourceFilePath     Path name of the font source file.
+/// @param[in]  pointSize           Font size, in points.
+/// @param[in]  dpi                 Font resolution, in DPI.
+/// @param[in]  textureSheetWidth   Width of each texture sheet, in pixels.
+/// @param[in]  textureSheetHeight  Height of each texture sheet, in pixels.
+/// @param[in]  bAntialiased        True to render anti-aliased glyphs, false to render monochrome glyphs.
+/// @param[in]  bDistanceField      True to store signed distance fields instead of glyph bitmaps.
+/// @param[out] rResourceData       Font metrics and character information.
+/// @param[out] rTextureSheets      Texture sheet data.
+///
+/// @return  True if the texture sheets were built successfully, false if not.
+bool FontResourceHandler::BuildTextureSheets(
+    const String& rSourceFilePath,
+    float32_t pointSize,
+    uint32_t dpi,
+    uint16_t textureSheetWidth,
+    uint16_t textureSheetHeight,
+    bool bAntialiased,
+    bool bDistanceField,
+    Font::PersistentResourceData& rResourceData,
+    DynamicArray< DynamicArray< uint8_t > >& rTextureSheets )
+{
+    rResourceData.m_characters.Resize( 0 );
+    rTextureSheets.Resize( 0 );
+
     // Load the font into memory ourselves in order to make sure we properly support Unicode file names.
     FileStream* pFileStream = FileStream::OpenFileStream( rSourceFilePath, FileStream::MODE_READ );
     if( !pFileStream )
@@ -247,10 +579,9 @@ bool FontResourceHandler::CacheResource(
     }
 
     // Set the appropriate font size.
-    int32_t pointSize = Font::Float32ToFixed26x6( pFont->GetPointSize() );
-    uint32_t dpi = pFont->GetDpi();
+    int32_t pointSizeFixed = Font::Float32ToFixed26x6( pointSize );
 
-    error = FT_Set_Char_Size( pFace, pointSize, pointSize, dpi, dpi );
+    error = FT_Set_Char_Size( pFace, pointSizeFixed, pointSizeFixed, dpi, dpi );
     if( error != 0 )
     {
         HELIUM_TRACE(
@@ -268,18 +599,17 @@ bool FontResourceHandler::CacheResource(
     FT_Size pSize = pFace->size;
     HELIUM_ASSERT( pSize );
 
-    StrongPtr< Font::PersistentResourceData > resource_data( new Font::PersistentResourceData() );
     int32_t ascender = pSize->metrics.ascender;
     int32_t descender = pSize->metrics.descender;
     int32_t height = pSize->metrics.height;
     int32_t maxAdvance = pSize->metrics.max_advance;
 
+    // Distance field glyph images include padding for the range of distances stored outside the glyph outline.
+    int32_t glyphPadding = ( bDistanceField ? static_cast< int32_t >( 2 * DISTANCE_FIELD_SPREAD ) : 0 );
+
     // Make sure that all characters in the font will fit on a single texture sheet (note that we also need at least a
     // pixel on each side in order to pad each glyph).
-    uint16_t textureSheetWidth = Max< uint16_t >( pFont->GetTextureSheetWidth(), 1 );
-    uint16_t textureSheetHeight = Max< uint16_t >( pFont->GetTextureSheetHeight(), 1 );
-
-    int32_t integerHeight = ( height + ( 1 << 6 ) - 1 ) >> 6;
+    int32_t integerHeight = ( ( height + ( 1 << 6 ) - 1 ) >> 6 ) + glyphPadding;
     if( integerHeight + 2 > textureSheetHeight )
     {
         HELIUM_TRACE(
@@ -288,7 +618,7 @@ bool FontResourceHandler::CacheResource(
               PRIu16 TXT( ") for font resource \"%s\".\n" ) ),
             integerHeight,
             textureSheetHeight,
-            *pResource->GetPath().ToString() );
+            *rSourceFilePath );
 
         FT_Done_Face( pFace );
         delete [] pFileData;
@@ -296,7 +626,7 @@ bool FontResourceHandler::CacheResource(
         return false;
     }
 
-    int32_t integerMaxAdvance = ( maxAdvance + ( 1 << 6 ) - 1 ) >> 6;
+    int32_t integerMaxAdvance = ( ( maxAdvance + ( 1 << 6 ) - 1 ) >> 6 ) + glyphPadding;
     if( integerMaxAdvance + 2 > textureSheetWidth )
     {
         HELIUM_TRACE(
@@ -305,7 +635,7 @@ bool FontResourceHandler::CacheResource(
               TXT( "width (%" ) PRIu16 TXT( ") for font resource \"%s\".\n" ) ),
             integerMaxAdvance,
             textureSheetWidth,
-            *pResource->GetPath().ToString() );
+            *rSourceFilePath );
 
         FT_Done_Face( pFace );
         delete [] pFileData;
@@ -325,7 +655,7 @@ bool FontResourceHandler::CacheResource(
             ( TXT( "FontResourceHandler: Failed to allocate %" ) PRIuFAST32 TXT( " bytes for texture resource " )
               TXT( "buffer data while caching font resource \"%s\".\n" ) ),
             texturePixelCount,
-            *pResource->GetPath().ToString() );
+            *rSourceFilePath );
 
         FT_Done_Face( pFace );
         delete [] pFileData;
@@ -335,18 +665,40 @@ bool FontResourceHandler::CacheResource(
 
     MemoryZero( pTextureBuffer, texturePixelCount );
 
-    // Build the texture sheets for our glyphs.
-    Font::ECompression textureCompression = pFont->GetTextureCompression();
-    bool bAntialiased = pFont->GetAntialiased();
+    // Distance fields are generated from glyphs rendered at a larger size.
+    if( bDistanceField )
+    {
+        int32_t upscaledPointSize = pointSizeFixed * static_cast< int32_t >( DISTANCE_FIELD_UPSCALE );
+        error = FT_Set_Char_Size( pFace, upscaledPointSize, upscaledPointSize, dpi, dpi );
+        if( error != 0 )
+        {
+            HELIUM_TRACE(
+                TraceLevels::Error,
+                TXT( "FontResourceHandler: Failed to set distance field rendering size of font resource \"%s\".\n" ),
+                *rSourceFilePath );
 
-    DynamicArray< DynamicArray< uint8_t > > textureSheets;
+            delete [] pTextureBuffer;
+            FT_Done_Face( pFace );
+            delete [] pFileData;
+
+            return false;
+        }
+    }
+
+    // Build the texture sheets for our glyphs.
+    DynamicArray< uint8_t > distanceField;
 
     uint16_t penX = 1;
     uint16_t penY = 1;
     uint16_t lineHeight = 0;
 
     FT_Int32 glyphLoadFlags = FT_LOAD_RENDER;
-    if( !bAntialiased )
+    if( bDistanceField )
+    {
+        // Hinting is meaningless for glyphs that are scaled at runtime, and distance fields need smooth coverage data.
+        glyphLoadFlags |= FT_LOAD_NO_HINTING;
+    }
+    else if( !bAntialiased )
     {
         glyphLoadFlags |= FT_LOAD_TARGET_MONO;
     }
@@ -373,18 +725,32 @@ bool FontResourceHandler::CacheResource(
         uint_fast32_t glyphRowCount = static_cast< uint32_t >( pGlyph->bitmap.rows );
         uint_fast32_t glyphWidth = static_cast< uint32_t >( pGlyph->bitmap.width );
 
+        if( bDistanceField )
+        {
+            uint32_t distanceFieldWidth, distanceFieldHeight;
+            GenerateDistanceField(
+                pGlyph->bitmap.buffer,
+                pGlyph->bitmap.pitch,
+                static_cast< uint32_t >( glyphWidth ),
+                static_cast< uint32_t >( glyphRowCount ),
+                distanceField,
+                distanceFieldWidth,
+                distanceFieldHeight );
+
+            glyphWidth = distanceFieldWidth;
+            glyphRowCount = distanceFieldHeight;
+        }
+
         if( penX + glyphWidth + 1 >= textureSheetWidth )
         {
             penX = 1;
 
             if( penY + glyphRowCount + 1 >= textureSheetHeight )
             {
-                CompressTexture(
-                    pTextureBuffer,
-                    textureSheetWidth,
-                    textureSheetHeight,
-                    textureCompression,
-                    textureSheets );
+                // Sheets are compressed independently once all glyphs have been rendered.
+                DynamicArray< uint8_t >* pSheet = rTextureSheets.New();
+                HELIUM_ASSERT( pSheet );
+                pSheet->AddArray( pTextureBuffer, texturePixelCount );
                 MemoryZero( pTextureBuffer, texturePixelCount );
 
                 penY = 1;
@@ -406,7 +772,17 @@ bool FontResourceHandler::CacheResource(
         uint8_t* pTexturePixel =
             pTextureBuffer + static_cast< size_t >( penY ) * static_cast< size_t >( textureSheetWidth ) + penX;
 
-        if( bAntialiased )
+        if( bDistanceField )
+        {
+            const uint8_t* pDistanceFieldRow = distanceField.GetData();
+            for( uint_fast32_t rowIndex = 0; rowIndex < glyphRowCount; ++rowIndex )
+            {
+                MemoryCopy( pTexturePixel, pDistanceFieldRow, glyphWidth );
+                pDistanceFieldRow += glyphWidth;
+                pTexturePixel += textureSheetWidth;
+            }
+        }
+        else if( bAntialiased )
         {
             // Anti-aliased fonts are rendered as 8-bit grayscale images, so just copy the data as-is.
             for( uint_fast32_t rowIndex = 0; rowIndex < glyphRowCount; ++rowIndex )
@@ -458,7 +834,7 @@ bool FontResourceHandler::CacheResource(
         }
 
         // Store the character information in our character array.
-        Font::Character* pCharacter = resource_data->m_characters.New();
+        Font::Character* pCharacter = rResourceData.m_characters.New();
         HELIUM_ASSERT( pCharacter );
     
         pCharacter->codePoint = static_cast< uint32_t >( codePoint );
@@ -473,9 +849,32 @@ bool FontResourceHandler::CacheResource(
         pCharacter->bearingX = pGlyph->metrics.horiBearingX;
         pCharacter->bearingY = pGlyph->metrics.horiBearingY;
         pCharacter->advance = pGlyph->metrics.horiAdvance;
+
+        if( bDistanceField )
+        {
+            // Scale the metrics back down to the cached font size, and extend the bounding box by the padding around
+            // the distance field image so that it covers the same area as the image itself.
+            const int32_t upscale = static_cast< int32_t >( DISTANCE_FIELD_UPSCALE );
+            const int32_t spreadFixed = static_cast< int32_t >( DISTANCE_FIELD_SPREAD ) << 6;
+
+            if( glyphWidth != 0 )
+            {
+                pCharacter->width = static_cast< int32_t >( glyphWidth ) << 6;
+                pCharacter->height = static_cast< int32_t >( glyphRowCount ) << 6;
+            }
+            else
+            {
+                pCharacter->width /= upscale;
+                pCharacter->height /= upscale;
+            }
+
+            pCharacter->bearingX = pCharacter->bearingX / upscale - spreadFixed;
+            pCharacter->bearingY = pCharacter->bearingY / upscale + spreadFixed;
+            pCharacter->advance /= upscale;
+        }
     
-        HELIUM_ASSERT( textureSheets.GetSize() < UINT8_MAX );
-        pCharacter->texture = static_cast< uint8_t >( static_cast< uint8_t >( textureSheets.GetSize() ) );
+        HELIUM_ASSERT( rTextureSheets.GetSize() < UINT8_MAX );
+        pCharacter->texture = static_cast< uint8_t >( static_cast< uint8_t >( rTextureSheets.GetSize() ) );
     
         // Update the pen location as well as the maximum line height as appropriate based on the current line height.
         penX += static_cast< uint16_t >( glyphWidth ) + 1;
@@ -484,10 +883,12 @@ bool FontResourceHandler::CacheResource(
         lineHeight = Max< uint16_t >( lineHeight, static_cast< uint16_t >( glyphRowCount ) );
     }
 
-    // Compress and store the last texture in the sheet.
-    if( !resource_data->m_characters.IsEmpty() )
+    // Store the last texture sheet.
+    if( !rResourceData.m_characters.IsEmpty() )
     {
-        CompressTexture( pTextureBuffer, textureSheetWidth, textureSheetHeight, textureCompression, textureSheets );
+        DynamicArray< uint8_t >* pSheet = rTextureSheets.New();
+        HELIUM_ASSERT( pSheet );
+        pSheet->AddArray( pTextureBuffer, texturePixelCount );
     }
 
     // Done processing the font itself, so free some resources.
@@ -496,44 +897,38 @@ bool FontResourceHandler::CacheResource(
     FT_Done_Face( pFace );
     delete [] pFileData;
 
-    // Cache the font data.
-    size_t characterCountActual = resource_data->m_characters.GetSize();
-    HELIUM_ASSERT( characterCountActual <= UINT32_MAX );
-    uint32_t characterCount = static_cast< uint32_t >( characterCountActual );
+    rResourceData.m_ascender = ascender;
+    rResourceData.m_descender = descender;
+    rResourceData.m_height = height;
+    rResourceData.m_maxAdvance = maxAdvance;
+    rResourceData.m_distanceFieldSpread = static_cast< uint8_t >( bDistanceField ? DISTANCE_FIELD_SPREAD : 0 );
 
-    size_t textureCountActual = textureSheets.GetSize();
+    size_t textureCountActual = rTextureSheets.GetSize();
     HELIUM_ASSERT( textureCountActual < UINT8_MAX );
-    uint8_t textureCount = static_cast< uint8_t >( textureCountActual );
-
-    resource_data->m_ascender = ascender;
-    resource_data->m_descender = descender;
-    resource_data->m_height = height;
-    resource_data->m_maxAdvance = maxAdvance;
-    resource_data->m_textureCount = textureCount;
-    // m_characters is populated above
-
-    for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
-    {
-        PlatformPreprocessor* pPreprocessor = pAssetPreprocessor->GetPlatformPreprocessor(
-            static_cast< Cache::EPlatform >( platformIndex ) );
-
-        if( !pPreprocessor )
-        {
-            continue;
-        }
-
-        Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
-            static_cast< Cache::EPlatform >( platformIndex ) );
-        //rPreprocessedData.persistentDataBuffer = ;
-        SaveObjectToPersistentDataBuffer(resource_data.Get(), rPreprocessedData.persistentDataBuffer);
-        rPreprocessedData.subDataBuffers = textureSheets;
-        rPreprocessedData.bLoaded = true;
-
-    }
+    rResourceData.m_textureCount = static_cast< uint8_t >( textureCountActual );
 
     return true;
 }
 
+/// WorkerPool job callback for compressing a single font texture sheet.
+///
+/// @param[in] pData     FontTextureSheetSet instance.
+/// @param[in] jobIndex  Index of the sheet to compress.
+void FontResourceHandler::CompressTextureSheetCallback( void* pData, size_t jobIndex )
+{
+    FontTextureSheetSet* pSheetSet = static_cast< FontTextureSheetSet* >( pData );
+    HELIUM_ASSERT( pSheetSet );
+    HELIUM_ASSERT( pSheetSet->pSourceSheets );
+    HELIUM_ASSERT( pSheetSet->pOutputSheets );
+
+    CompressTexture(
+        ( *pSheetSet->pSourceSheets )[ jobIndex ].GetData(),
+        pSheetSet->width,
+        pSheetSet->height,
+        pSheetSet->compression,
+        ( *pSheetSet->pOutputSheets )[ jobIndex ] );
+}
+
 /// Initialize the static FreeType library instance.
 ///
 /// @return  Handle for the initialized instance.
@@ -591,19 +986,16 @@ void FontResourceHandler::CompressTexture(
     uint16_t textureWidth,
     uint16_t textureHeight,
     Font::ECompression compression,
-    DynamicArray< DynamicArray< uint8_t > >& rTextureSheets )
+    DynamicArray< uint8_t >& rOutputSheet )
 {
     HELIUM_ASSERT( pGrayscaleData );
 
-    DynamicArray< uint8_t >* pOutputSheet = rTextureSheets.New();
-    HELIUM_ASSERT( pOutputSheet );
-
     // If the output is to be uncompressed grayscale data, simply copy the data to the output texture, as it's already
     // uncompressed grayscale data.
     if( compression == Font::ECompression::GRAYSCALE_UNCOMPRESSED )
     {
         size_t pixelCount = static_cast< size_t >( textureWidth ) * static_cast< size_t >( textureHeight );
-        pOutputSheet->AddArray( pGrayscaleData, pixelCount );
+        rOutputSheet.AddArray( pGrayscaleData, pixelCount );
 
         return;
     }
@@ -686,7 +1078,7 @@ void FontResourceHandler::CompressTexture(
     // Store the compressed data in the output texture sheet.
     const MemoryTextureOutputHandler::MipLevelArray& rMipLevels = outputHandler.GetFace( 0 );
     HELIUM_ASSERT( rMipLevels.GetSize() == 1 );
-    *pOutputSheet = rMipLevels[ 0 ];
+    rOutputSheet = rMipLevels[ 0 ];
 }
 
 #endif  // HELIUM_TOOLS
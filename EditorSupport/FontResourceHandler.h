@@ -34,6 +34,14 @@ namespace Helium
             AssetPreprocessor* pAssetPreprocessor, Resource* pResource, const String& rSourceFilePath );
         //@}
 
+        /// @name Texture Sheet Generation
+        //@{
+        static bool BuildTextureSheets(
+            const String& rSourceFilePath, float32_t pointSize, uint32_t dpi, uint16_t textureSheetWidth,
+            uint16_t textureSheetHeight, bool bAntialiased, bool bDistanceField,
+            Font::PersistentResourceData& rResourceData, DynamicArray< DynamicArray< uint8_t > >& rTextureSheets );
+        //@}
+
         /// @name Static Data Access
         //@{
         static FT_Library InitializeStaticLibrary();
@@ -50,7 +58,8 @@ namespace Helium
         //@{
         static void CompressTexture(
             const uint8_t* pGrayscaleData, uint16_t textureWidth, uint16_t textureHeight,
-            Font::ECompression compression, DynamicArray< DynamicArray< uint8_t > >& rTextureSheets );
+            Font::ECompression compression, DynamicArray< uint8_t >& rOutputSheet );
+        static void CompressTextureSheetCallback( void* pData, size_t jobIndex );
         //@}
     };
 }
@@ -4,8 +4,13 @@
 
 #include "EditorSupport/Image.h"
 
+#include "Engine/WorkerPool.h"
 #include "MathSimd/Color.h"
 
+#if HELIUM_SIMD_SSE
+# include <emmintrin.h>
+#endif
+
 using namespace Helium;
 
 // Pixel value reader for one-byte pixel sizes.
@@ -559,6 +564,370 @@ void ConvertImageSourcePixelSizeSwitch(
     }
 }
 
+/// Minimum number of pixels in an image before conversion is split across multiple threads.
+static const uint64_t PARALLEL_CONVERSION_PIXEL_COUNT_MIN = 512 * 512;
+
+/// Byte shuffle table entry for destination bytes that are always zero.
+static const int8_t BYTE_SHUFFLE_ZERO = -1;
+/// Byte shuffle table entry for destination bytes that are always 0xff.
+static const int8_t BYTE_SHUFFLE_ONE = -2;
+
+// Image conversion parameters.
+struct ImageConversion
+{
+    const uint8_t* pSourceData;
+    uint32_t sourceBytesPerPixel;
+    uint32_t sourcePitch;
+    const Color* pSourcePalette;
+    uint32_t sourcePaletteSize;
+    const uint8_t* pSourceChannelBitCounts;
+    const uint8_t* pSourceChannelBitOffsets;
+    uint32_t sourceChannelMaxValues[ Image::CHANNEL_MAX ];
+
+    uint8_t* pDestData;
+    uint32_t destBytesPerPixel;
+    uint32_t destPitch;
+    const Color* pDestPalette;
+    uint32_t destPaletteSize;
+    const uint8_t* pDestChannelBitOffsets;
+    uint32_t destChannelMaxValues[ Image::CHANNEL_MAX ];
+
+    uint32_t channelAdjustments[ Image::CHANNEL_MAX ];
+
+    uint32_t width;
+    uint32_t height;
+    // Number of rows converted by each call to ConvertImageBand().
+    uint32_t bandRowCount;
+
+    // True if the conversion can be performed by shuffling bytes according to byteShuffle.
+    bool bByteShuffle;
+    // Source byte index for each destination byte (or BYTE_SHUFFLE_ZERO/BYTE_SHUFFLE_ONE for constant bytes).
+    int8_t byteShuffle[ 4 ];
+};
+
+// Get the index of the byte in memory that holds the given bit offset of a pixel value (as read by the pixel value
+// readers and written by the pixel value writers).
+static uint32_t GetPixelByteIndex( uint32_t bytesPerPixel, uint32_t bitOffset )
+{
+#if HELIUM_ENDIAN_LITTLE
+    HELIUM_UNREF( bytesPerPixel );
+    return bitOffset / 8;
+#else
+    return bytesPerPixel - 1 - bitOffset / 8;
+#endif
+}
+
+// Check whether a conversion between two direct color formats is a simple byte shuffle, and build the shuffle table
+// if so.  This is the case when every channel in both formats is either absent or 8 bits wide and byte-aligned, in
+// which case the general conversion loop reduces to copying channel bytes (with absent source channels producing 0xff
+// and bytes not covered by a destination channel producing zero).
+static bool BuildByteShuffle(
+    uint32_t sourceBytesPerPixel,
+    const uint8_t* pSourceChannelBitCounts,
+    const uint8_t* pSourceChannelBitOffsets,
+    uint32_t destBytesPerPixel,
+    const uint8_t* pDestChannelBitCounts,
+    const uint8_t* pDestChannelBitOffsets,
+    int8_t* pByteShuffle )
+{
+    HELIUM_ASSERT( pByteShuffle );
+
+    // Palettized formats are flagged by passing null channel bit counts.
+    if( !pSourceChannelBitCounts || !pDestChannelBitCounts )
+    {
+        return false;
+    }
+
+    for( uint32_t byteIndex = 0; byteIndex < 4; ++byteIndex )
+    {
+        pByteShuffle[ byteIndex ] = BYTE_SHUFFLE_ZERO;
+    }
+
+    for( size_t channelIndex = 0; channelIndex < Image::CHANNEL_MAX; ++channelIndex )
+    {
+        uint32_t sourceBitCount = pSourceChannelBitCounts[ channelIndex ];
+        uint32_t sourceBitOffset = pSourceChannelBitOffsets[ channelIndex ];
+        uint32_t destBitCount = pDestChannelBitCounts[ channelIndex ];
+        uint32_t destBitOffset = pDestChannelBitOffsets[ channelIndex ];
+
+        if( ( sourceBitCount != 0 && sourceBitCount != 8 ) || ( destBitCount != 0 && destBitCount != 8 ) )
+        {
+            return false;
+        }
+
+        if( sourceBitCount != 0 && ( sourceBitOffset % 8 != 0 || sourceBitOffset + 8 > sourceBytesPerPixel * 8 ) )
+        {
+            return false;
+        }
+
+        // Absent destination channels always end up as zero bits.
+        if( destBitCount == 0 )
+        {
+            continue;
+        }
+
+        if( destBitOffset % 8 != 0 || destBitOffset + 8 > destBytesPerPixel * 8 )
+        {
+            return false;
+        }
+
+        // Overlapping destination channels are combined bitwise by the general conversion loop.
+        uint32_t destByteIndex = GetPixelByteIndex( destBytesPerPixel, destBitOffset );
+        if( pByteShuffle[ destByteIndex ] != BYTE_SHUFFLE_ZERO )
+        {
+            return false;
+        }
+
+        pByteShuffle[ destByteIndex ] = ( sourceBitCount != 0
+            ? static_cast< int8_t >( GetPixelByteIndex( sourceBytesPerPixel, sourceBitOffset ) )
+            : BYTE_SHUFFLE_ONE );
+    }
+
+    return true;
+}
+
+#if HELIUM_SIMD_SSE && HELIUM_ENDIAN_LITTLE
+// Shuffle the bytes in a row of 32-bit pixels, four pixels at a time.
+//
+// Each group of destination bytes taken from the same relative source byte position is produced with a single shift
+// and mask of the 32-bit pixel lanes.  Returns the number of pixels processed (the remainder must be handled by the
+// caller).
+static uint32_t ShuffleRow4To4Sse(
+    const uint8_t* pSourceRow,
+    uint8_t* pDestRow,
+    uint32_t width,
+    const int8_t* pByteShuffle )
+{
+    // Group destination bytes by the shift needed to move their source bytes into place.
+    __m128i shiftCounts[ 4 ];
+    __m128i shiftMasks[ 4 ];
+    bool bShiftLeft[ 4 ];
+    int32_t shiftValues[ 4 ];
+    uint32_t shiftCount = 0;
+
+    uint32_t constantMask = 0;
+
+    for( uint32_t destByteIndex = 0; destByteIndex < 4; ++destByteIndex )
+    {
+        int8_t sourceByteIndex = pByteShuffle[ destByteIndex ];
+        if( sourceByteIndex == BYTE_SHUFFLE_ONE )
+        {
+            constantMask |= 0xffU << ( destByteIndex * 8 );
+        }
+
+        if( sourceByteIndex < 0 )
+        {
+            continue;
+        }
+
+        int32_t shift = ( static_cast< int32_t >( destByteIndex ) - sourceByteIndex ) * 8;
+        uint32_t mask = 0xffU << ( destByteIndex * 8 );
+
+        uint32_t shiftIndex;
+        for( shiftIndex = 0; shiftIndex < shiftCount; ++shiftIndex )
+        {
+            if( shiftValues[ shiftIndex ] == shift )
+            {
+                break;
+            }
+        }
+
+        if( shiftIndex == shiftCount )
+        {
+            shiftValues[ shiftIndex ] = shift;
+            bShiftLeft[ shiftIndex ] = ( shift >= 0 );
+            shiftCounts[ shiftIndex ] = _mm_cvtsi32_si128( shift >= 0 ? shift : -shift );
+            shiftMasks[ shiftIndex ] = _mm_setzero_si128();
+            ++shiftCount;
+        }
+
+        shiftMasks[ shiftIndex ] = _mm_or_si128(
+            shiftMasks[ shiftIndex ],
+            _mm_set1_epi32( static_cast< int32_t >( mask ) ) );
+    }
+
+    __m128i constant = _mm_set1_epi32( static_cast< int32_t >( constantMask ) );
+
+    uint32_t x = 0;
+    for( ; x + 4 <= width; x += 4 )
+    {
+        __m128i source = _mm_loadu_si128( reinterpret_cast< const __m128i* >( pSourceRow + x * 4 ) );
+        __m128i result = constant;
+
+        for( uint32_t shiftIndex = 0; shiftIndex < shiftCount; ++shiftIndex )
+        {
+            __m128i shifted = ( bShiftLeft[ shiftIndex ]
+                ? _mm_sll_epi32( source, shiftCounts[ shiftIndex ] )
+                : _mm_srl_epi32( source, shiftCounts[ shiftIndex ] ) );
+            result = _mm_or_si128( result, _mm_and_si128( shifted, shiftMasks[ shiftIndex ] ) );
+        }
+
+        _mm_storeu_si128( reinterpret_cast< __m128i* >( pDestRow + x * 4 ), result );
+    }
+
+    return x;
+}
+#endif  // HELIUM_SIMD_SSE && HELIUM_ENDIAN_LITTLE
+
+// Convert a range of rows by shuffling bytes (see BuildByteShuffle()).
+static void ShuffleImageRows(
+    const ImageConversion& rConversion,
+    const uint8_t* pSourceRow,
+    uint8_t* pDestRow,
+    uint32_t rowCount )
+{
+    uint32_t sourceBytesPerPixel = rConversion.sourceBytesPerPixel;
+    uint32_t destBytesPerPixel = rConversion.destBytesPerPixel;
+    const int8_t* pByteShuffle = rConversion.byteShuffle;
+
+    for( uint32_t y = 0; y < rowCount; ++y )
+    {
+        uint32_t x = 0;
+
+#if HELIUM_SIMD_SSE && HELIUM_ENDIAN_LITTLE
+        if( sourceBytesPerPixel == 4 && destBytesPerPixel == 4 )
+        {
+            x = ShuffleRow4To4Sse( pSourceRow, pDestRow, rConversion.width, pByteShuffle );
+        }
+#endif
+
+        const uint8_t* pSourcePixel = pSourceRow + x * sourceBytesPerPixel;
+        uint8_t* pDestPixel = pDestRow + x * destBytesPerPixel;
+
+        for( ; x < rConversion.width; ++x )
+        {
+            for( uint32_t destByteIndex = 0; destByteIndex < destBytesPerPixel; ++destByteIndex )
+            {
+                int8_t sourceByteIndex = pByteShuffle[ destByteIndex ];
+                pDestPixel[ destByteIndex ] = ( sourceByteIndex >= 0
+                    ? pSourcePixel[ sourceByteIndex ]
+                    : ( sourceByteIndex == BYTE_SHUFFLE_ONE ? 0xff : 0 ) );
+            }
+
+            pSourcePixel += sourceBytesPerPixel;
+            pDestPixel += destBytesPerPixel;
+        }
+
+        pSourceRow += rConversion.sourcePitch;
+        pDestRow += rConversion.destPitch;
+    }
+}
+
+// Convert a range of rows in an image.
+static void ConvertImageRows( const ImageConversion& rConversion, uint32_t startRow, uint32_t rowCount )
+{
+    HELIUM_ASSERT( startRow + rowCount <= rConversion.height );
+
+    const uint8_t* pSourceRow = rConversion.pSourceData + static_cast< size_t >( startRow ) * rConversion.sourcePitch;
+    uint8_t* pDestRow = rConversion.pDestData + static_cast< size_t >( startRow ) * rConversion.destPitch;
+
+    if( rConversion.bByteShuffle )
+    {
+        ShuffleImageRows( rConversion, pSourceRow, pDestRow, rowCount );
+
+        return;
+    }
+
+    if( rConversion.pSourcePalette )
+    {
+        PalettizedColorReader colorReader( rConversion.pSourcePalette, rConversion.sourcePaletteSize );
+
+        if( rConversion.pDestPalette )
+        {
+            PalettizedColorWriter colorWriter( rConversion.pDestPalette, rConversion.destPaletteSize );
+
+            ConvertImageSourcePixelSizeSwitch(
+                colorReader,
+                colorWriter,
+                pSourceRow,
+                rConversion.sourceBytesPerPixel,
+                rConversion.sourcePitch,
+                rConversion.sourceChannelMaxValues,
+                pDestRow,
+                rConversion.destBytesPerPixel,
+                rConversion.destPitch,
+                rConversion.destChannelMaxValues,
+                rConversion.channelAdjustments,
+                rConversion.width,
+                rowCount );
+        }
+        else
+        {
+            DirectColorWriter colorWriter( rConversion.pDestChannelBitOffsets );
+
+            ConvertImageSourcePixelSizeSwitch(
+                colorReader,
+                colorWriter,
+                pSourceRow,
+                rConversion.sourceBytesPerPixel,
+                rConversion.sourcePitch,
+                rConversion.sourceChannelMaxValues,
+                pDestRow,
+                rConversion.destBytesPerPixel,
+                rConversion.destPitch,
+                rConversion.destChannelMaxValues,
+                rConversion.channelAdjustments,
+                rConversion.width,
+                rowCount );
+        }
+    }
+    else
+    {
+        DirectColorReader colorReader( rConversion.pSourceChannelBitCounts, rConversion.pSourceChannelBitOffsets );
+
+        if( rConversion.pDestPalette )
+        {
+            PalettizedColorWriter colorWriter( rConversion.pDestPalette, rConversion.destPaletteSize );
+
+            ConvertImageSourcePixelSizeSwitch(
+                colorReader,
+                colorWriter,
+                pSourceRow,
+                rConversion.sourceBytesPerPixel,
+                rConversion.sourcePitch,
+                rConversion.sourceChannelMaxValues,
+                pDestRow,
+                rConversion.destBytesPerPixel,
+                rConversion.destPitch,
+                rConversion.destChannelMaxValues,
+                rConversion.channelAdjustments,
+                rConversion.width,
+                rowCount );
+        }
+        else
+        {
+            DirectColorWriter colorWriter( rConversion.pDestChannelBitOffsets );
+
+            ConvertImageSourcePixelSizeSwitch(
+                colorReader,
+                colorWriter,
+                pSourceRow,
+                rConversion.sourceBytesPerPixel,
+                rConversion.sourcePitch,
+                rConversion.sourceChannelMaxValues,
+                pDestRow,
+                rConversion.destBytesPerPixel,
+                rConversion.destPitch,
+                rConversion.destChannelMaxValues,
+                rConversion.channelAdjustments,
+                rConversion.width,
+                rowCount );
+        }
+    }
+}
+
+// WorkerPool job callback for converting a band of rows in an image.
+static void ConvertImageBand( void* pData, size_t jobIndex )
+{
+    const ImageConversion* pConversion = static_cast< const ImageConversion* >( pData );
+    HELIUM_ASSERT( pConversion );
+
+    uint32_t startRow = static_cast< uint32_t >( jobIndex ) * pConversion->bandRowCount;
+    HELIUM_ASSERT( startRow < pConversion->height );
+
+    ConvertImageRows( *pConversion, startRow, Min( pConversion->bandRowCount, pConversion->height - startRow ) );
+}
+
 /// Constructor.
 Image::Image()
 : m_pPixelData( NULL )
@@ -762,7 +1131,100 @@ void Image::Swap( Image& rImage )
 /// @param[in]  rFormat       Destination format.
 ///
 /// @return  True if conversion was successful, false if not.
+///
+/// @see ConvertReference()
 bool Image::Convert( Image& rDestination, const Format& rFormat ) const
+{
+    return PrivateConvert( rDestination, rFormat, true );
+}
+
+/// Convert this image to the given format using only the general per-channel conversion loop on the calling thread.
+///
+/// This is much slower than Convert(), but produces the same output, so it can be used to validate the byte shuffle
+/// and SIMD fast paths.
+///
+/// @param[out] rDestination  Converted image.
+/// @param[in]  rFormat       Destination format.
+///
+/// @return  True if conversion was successful, false if not.
+///
+/// @see Convert()
+bool Image::ConvertReference( Image& rDestination, const Format& rFormat ) const
+{
+    return PrivateConvert( rDestination, rFormat, false );
+}
+
+/// Assignment operator.
+///
+/// @param[in] rSource  Source object from which to copy.
+///
+/// @return  Reference to this object.
+Image& Image::operator=( const Image& rSource )
+{
+    if( this != &rSource )
+    {
+        PrivateFree();
+        PrivateCopy( rSource );
+    }
+
+    return *this;
+}
+
+/// Copy data from the given object into this object, assuming this object is in an entirely uninitialized state.
+///
+/// @param[in] rSource  Source object from which to copy.
+///
+/// @see PrivateFree()
+void Image::PrivateCopy( const Image& rSource )
+{
+    m_pPixelData = NULL;
+    if( rSource.m_pPixelData )
+    {
+        size_t imageSize = rSource.m_pitch * rSource.m_height;
+        m_pPixelData = new uint8_t [ imageSize ];
+        HELIUM_ASSERT( m_pPixelData );
+        MemoryCopy( m_pPixelData, rSource.m_pPixelData, imageSize );
+    }
+
+    m_width = rSource.m_width;
+    m_height = rSource.m_height;
+    m_pitch = rSource.m_pitch;
+
+    m_format = rSource.m_format;
+
+    const Color* pPalette = m_format.GetPalette();
+    if( pPalette )
+    {
+        uint32_t paletteSize = m_format.GetPaletteSize();
+        Color* pPaletteCopy = new Color [ paletteSize ];
+        HELIUM_ASSERT( pPaletteCopy );
+        ArrayCopy( pPaletteCopy, pPalette, paletteSize );
+        m_format.SetPalette( pPaletteCopy, paletteSize );
+    }
+}
+
+/// Free all allocated data without resetting data values.
+///
+/// @see PrivateCopy()
+void Image::PrivateFree()
+{
+    delete [] static_cast< uint8_t* >( m_pPixelData );
+
+    // The internally stored palette is always allocated by this object, so it is safe for us to const_cast and
+    // delete the palette memory here.
+    delete [] const_cast< Color* >( m_format.GetPalette() );
+}
+
+/// Convert this image to the given format and store in the destination image object.
+///
+/// @param[out] rDestination     Converted image.
+/// @param[in]  rFormat          Destination format.
+/// @param[in]  bAllowFastPaths  True to use the byte shuffle and SIMD fast paths and split large images across the
+///                              shared worker pool, false to convert every pixel with the general conversion loop
+///                              on the calling thread.
+///
+/// @return  True if conversion was successful, false if not.
+bool Image::PrivateConvert( Image& rDestination, const Format& rFormat, bool bAllowFastPaths ) const
 {
     // Initialize a temporary image into which the converted image will be initially written.
     Image::InitParameters imageParameters;
@@ -852,91 +1314,56 @@ bool Image::Convert( Image& rDestination, const Format& rFormat ) const
         channelAdjustments[ CHANNEL_ALPHA ] = destChannelMaxValues[ CHANNEL_ALPHA ];
     }
 
-    if( pSourcePalette )
+    // Fill out the conversion parameters shared by each band of rows.
+    ImageConversion conversion;
+    conversion.pSourceData = static_cast< const uint8_t* >( m_pPixelData );
+    conversion.sourceBytesPerPixel = sourceBytesPerPixel;
+    conversion.sourcePitch = m_pitch;
+    conversion.pSourcePalette = pSourcePalette;
+    conversion.sourcePaletteSize = sourcePaletteSize;
+    conversion.pSourceChannelBitCounts = pSourceChannelBitCounts;
+    conversion.pSourceChannelBitOffsets = pSourceChannelBitOffsets;
+    conversion.pDestData = static_cast< uint8_t* >( stagingImage.m_pPixelData );
+    conversion.destBytesPerPixel = destBytesPerPixel;
+    conversion.destPitch = stagingImage.m_pitch;
+    conversion.pDestPalette = pDestPalette;
+    conversion.destPaletteSize = destPaletteSize;
+    conversion.pDestChannelBitOffsets = pDestChannelBitOffsets;
+    conversion.width = m_width;
+    conversion.height = m_height;
+    conversion.bandRowCount = m_height;
+
+    ArrayCopy( conversion.sourceChannelMaxValues, sourceChannelMaxValues, CHANNEL_MAX );
+    ArrayCopy( conversion.destChannelMaxValues, destChannelMaxValues, CHANNEL_MAX );
+    ArrayCopy( conversion.channelAdjustments, channelAdjustments, CHANNEL_MAX );
+
+    conversion.bByteShuffle = bAllowFastPaths && BuildByteShuffle(
+        sourceBytesPerPixel,
+        ( pSourcePalette ? NULL : pSourceChannelBitCounts ),
+        pSourceChannelBitOffsets,
+        destBytesPerPixel,
+        ( pDestPalette ? NULL : pDestChannelBitCounts ),
+        pDestChannelBitOffsets,
+        conversion.byteShuffle );
+
+    // Split large images into bands of rows converted in parallel on the shared worker pool.  Each pixel is
+    // converted independently, so the result does not depend on how the rows are split.
+    WorkerPool* pPool = WorkerPool::GetStaticInstance();
+    uint64_t pixelCount = static_cast< uint64_t >( m_width ) * static_cast< uint64_t >( m_height );
+    if( bAllowFastPaths &&
+        pPool &&
+        pPool->GetWorkerCount() != 0 &&
+        pixelCount >= PARALLEL_CONVERSION_PIXEL_COUNT_MIN )
     {
-        PalettizedColorReader colorReader( pSourcePalette, sourcePaletteSize );
+        uint32_t bandCount = static_cast< uint32_t >( pPool->GetWorkerCount() + 1 );
+        conversion.bandRowCount = ( m_height + bandCount - 1 ) / bandCount;
+        bandCount = ( m_height + conversion.bandRowCount - 1 ) / conversion.bandRowCount;
 
-        if( pDestPalette )
-        {
-            PalettizedColorWriter colorWriter( pDestPalette, destPaletteSize );
-
-            ConvertImageSourcePixelSizeSwitch(
-                colorReader,
-                colorWriter,
-                m_pPixelData,
-                sourceBytesPerPixel,
-                m_pitch,
-                sourceChannelMaxValues,
-                stagingImage.m_pPixelData,
-                destBytesPerPixel,
-                stagingImage.m_pitch,
-                destChannelMaxValues,
-                channelAdjustments,
-                m_width,
-                m_height );
-        }
-        else
-        {
-            DirectColorWriter colorWriter( pDestChannelBitOffsets );
-
-            ConvertImageSourcePixelSizeSwitch(
-                colorReader,
-                colorWriter,
-                m_pPixelData,
-                sourceBytesPerPixel,
-                m_pitch,
-                sourceChannelMaxValues,
-                stagingImage.m_pPixelData,
-                destBytesPerPixel,
-                stagingImage.m_pitch,
-                destChannelMaxValues,
-                channelAdjustments,
-                m_width,
-                m_height );
-        }
+        pPool->Run( ConvertImageBand, &conversion, bandCount );
     }
     else
     {
-        DirectColorReader colorReader( pSourceChannelBitCounts, pSourceChannelBitOffsets );
-
-        if( pDestPalette )
-        {
-            PalettizedColorWriter colorWriter( pDestPalette, destPaletteSize );
-
-            ConvertImageSourcePixelSizeSwitch(
-                colorReader,
-                colorWriter,
-                m_pPixelData,
-                sourceBytesPerPixel,
-                m_pitch,
-                sourceChannelMaxValues,
-                stagingImage.m_pPixelData,
-                destBytesPerPixel,
-                stagingImage.m_pitch,
-                destChannelMaxValues,
-                channelAdjustments,
-                m_width,
-                m_height );
-        }
-        else
-        {
-            DirectColorWriter colorWriter( pDestChannelBitOffsets );
-
-            ConvertImageSourcePixelSizeSwitch(
-                colorReader,
-                colorWriter,
-                m_pPixelData,
-                sourceBytesPerPixel,
-                m_pitch,
-                sourceChannelMaxValues,
-                stagingImage.m_pPixelData,
-                destBytesPerPixel,
-                stagingImage.m_pitch,
-                destChannelMaxValues,
-                channelAdjustments,
-                m_width,
-                m_height );
-        }
+        ConvertImageRows( conversion, 0, m_height );
     }
 
     // Store the converted image data in the destination image.
@@ -945,67 +1372,6 @@ bool Image::Convert( Image& rDestination, const Format& rFormat ) const
     return true;
 }
 
-/// Assignment operator.
-///
-/// @param[in] rSource  Source object from which to copy.
-///
-/// @return  Reference to this object.
-Image& Image::operator=( const Image& rSource )
-{
-    if( this != &rSource )
-    {
-        PrivateFree();
-        PrivateCopy( rSource );
-    }
-
-    return *this;
-}
-
-/// Copy data from the given object into this object, assuming this object is in an entirely uninitialized state.
-///
-/// @param[in] rSource  Source object from which to copy.
-///
-/// @see PrivateFree()
-void Image::PrivateCopy( const Image& rSource )
-{
-    m_pPixelData = NULL;
-    if( rSource.m_pPixelData )
-    {
-        size_t imageSize = rSource.m_pitch * rSource.m_height;
-        m_pPixelData = new uint8_t [ imageSize ];
-        HELIUM_ASSERT( m_pPixelData );
-        MemoryCopy( m_pPixelData, rSource.m_pPixelData, imageSize );
-    }
-
-    m_width = rSource.m_width;
-    m_height = rSource.m_height;
-    m_pitch = rSource.m_pitch;
-
-    m_format = rSource.m_format;
-
-    const Color* pPalette = m_format.GetPalette();
-    if( pPalette )
-    {
-        uint32_t paletteSize = m_format.GetPaletteSize();
-        Color* pPaletteCopy = new Color [ paletteSize ];
-        HELIUM_ASSERT( pPaletteCopy );
-        ArrayCopy( pPaletteCopy, pPalette, paletteSize );
-        m_format.SetPalette( pPaletteCopy, paletteSize );
-    }
-}
-
-/// Free all allocated data without resetting data values.
-///
-/// @see PrivateCopy()
-void Image::PrivateFree()
-{
-    delete [] static_cast< uint8_t* >( m_pPixelData );
-
-    // The internally stored palette is always allocated by this object, so it is safe for us to const_cast and
-    // delete the palette memory here.
-    delete [] const_cast< Color* >( m_format.GetPalette() );
-}
-
 /// Validate the parameters in this image format.
 ///
 /// Format validation performs the following checks:
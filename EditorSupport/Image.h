@@ -137,6 +137,7 @@ namespace Helium
         /// @name Image Conversion
         //@{
         bool Convert( Image& rDestination, const Format& rFormat ) const;
+        bool ConvertReference( Image& rDestination, const Format& rFormat ) const;
         //@}
 
         /// @name Overloaded Operators
@@ -162,6 +163,7 @@ namespace Helium
         //@{
         void PrivateCopy( const Image& rSource );
         void PrivateFree();
+        bool PrivateConvert( Image& rDestination, const Format& rFormat, bool bAllowFastPaths ) const;
         //@}
     };
 }
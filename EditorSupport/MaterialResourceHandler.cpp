@@ -40,6 +40,12 @@ bool MaterialResourceHandler::CacheResource(
     Material* pMaterial = Reflect::AssertCast< Material >( pResource );
     Shader* pShader = pMaterial->GetShader();
     bool failedToWriteASubdata = false;
+
+    // The variant indices depend on the shader options, and the parameter buffer layouts on the compiled variants.
+    if( pShader )
+    {
+        pAssetPreprocessor->AddAssetDependency( pMaterial->GetPath(), pShader->GetPath() );
+    }
     
     StrongPtr< Material::PersistentResourceData > resource_data( new Material::PersistentResourceData() );
 
@@ -121,6 +127,8 @@ bool MaterialResourceHandler::CacheResource(
                     continue;
                 }
 
+                pAssetPreprocessor->AddAssetDependency( pMaterial->GetPath(), pVariant->GetPath() );
+
                 const Resource::PreprocessedData& rVariantData = pVariant->GetPreprocessedData(
                     static_cast< Cache::EPlatform >( platformIndex ) );
                 HELIUM_ASSERT( rVariantData.bLoaded );
@@ -0,0 +1,1157 @@
+#include "EditorSupportPch.h"
+
+#if HELIUM_TOOLS
+
+#include "EditorSupport/MeshOptimizer.h"
+
+#include "MathSimd/Vector3.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace Helium;
+
+/// Triangle cluster information used when sorting clusters for overdraw reduction.
+struct OverdrawCluster
+{
+	/// Index of the first triangle in the cluster.
+	size_t startTriangle;
+	/// Number of triangles in the cluster.
+	size_t triangleCount;
+	/// Sort key (larger values are drawn first).
+	float32_t sortKey;
+};
+
+/// Comparison function for sorting overdraw clusters (stable with respect to the original cluster order).
+static bool OverdrawClusterCompare( const OverdrawCluster& rCluster0, const OverdrawCluster& rCluster1 )
+{
+	return ( rCluster0.sortKey > rCluster1.sortKey ||
+		( rCluster0.sortKey == rCluster1.sortKey && rCluster0.startTriangle < rCluster1.startTriangle ) );
+}
+
+/// Quadric error metric (symmetric 4x4 matrix stored as its upper triangle) used during mesh simplification.
+struct SimplifyQuadric
+{
+	float64_t a00, a01, a02, a11, a12, a22;
+	float64_t b0, b1, b2;
+	float64_t c;
+};
+
+/// Collapse candidate used during mesh simplification.
+struct SimplifyCollapse
+{
+	/// Vertex being removed.
+	uint16_t sourceVertex;
+	/// Vertex onto which the source vertex is collapsed.
+	uint16_t targetVertex;
+	/// Collapse error.
+	float32_t cost;
+};
+
+/// Comparison function for sorting collapse candidates by increasing cost.
+static bool SimplifyCollapseCompare( const SimplifyCollapse& rCollapse0, const SimplifyCollapse& rCollapse1 )
+{
+	return ( rCollapse0.cost < rCollapse1.cost );
+}
+
+/// Get the position of a vertex from a strided position stream.
+static const float32_t* GetSimplifyPosition( const uint8_t* pPositionBytes, size_t positionStride, size_t vertexIndex )
+{
+	return reinterpret_cast< const float32_t* >( pPositionBytes + vertexIndex * positionStride );
+}
+
+/// Compute the (unnormalized) normal of a triangle.
+static void ComputeSimplifyNormal(
+	const float32_t* pPosition0,
+	const float32_t* pPosition1,
+	const float32_t* pPosition2,
+	float64_t* pNormal )
+{
+	float64_t edge0[ 3 ] = {
+		pPosition1[ 0 ] - pPosition0[ 0 ], pPosition1[ 1 ] - pPosition0[ 1 ], pPosition1[ 2 ] - pPosition0[ 2 ] };
+	float64_t edge1[ 3 ] = {
+		pPosition2[ 0 ] - pPosition0[ 0 ], pPosition2[ 1 ] - pPosition0[ 1 ], pPosition2[ 2 ] - pPosition0[ 2 ] };
+
+	pNormal[ 0 ] = edge0[ 1 ] * edge1[ 2 ] - edge0[ 2 ] * edge1[ 1 ];
+	pNormal[ 1 ] = edge0[ 2 ] * edge1[ 0 ] - edge0[ 0 ] * edge1[ 2 ];
+	pNormal[ 2 ] = edge0[ 0 ] * edge1[ 1 ] - edge0[ 1 ] * edge1[ 0 ];
+}
+
+/// Add the contribution of a plane to a quadric.
+static void AddSimplifyPlane(
+	SimplifyQuadric& rQuadric,
+	float64_t normalX,
+	float64_t normalY,
+	float64_t normalZ,
+	float64_t distance,
+	float64_t weight )
+{
+	rQuadric.a00 += weight * normalX * normalX;
+	rQuadric.a01 += weight * normalX * normalY;
+	rQuadric.a02 += weight * normalX * normalZ;
+	rQuadric.a11 += weight * normalY * normalY;
+	rQuadric.a12 += weight * normalY * normalZ;
+	rQuadric.a22 += weight * normalZ * normalZ;
+	rQuadric.b0 += weight * normalX * distance;
+	rQuadric.b1 += weight * normalY * distance;
+	rQuadric.b2 += weight * normalZ * distance;
+	rQuadric.c += weight * distance * distance;
+}
+
+/// Accumulate one quadric into another.
+static void AddSimplifyQuadric( SimplifyQuadric& rQuadric, const SimplifyQuadric& rOther )
+{
+	rQuadric.a00 += rOther.a00;
+	rQuadric.a01 += rOther.a01;
+	rQuadric.a02 += rOther.a02;
+	rQuadric.a11 += rOther.a11;
+	rQuadric.a12 += rOther.a12;
+	rQuadric.a22 += rOther.a22;
+	rQuadric.b0 += rOther.b0;
+	rQuadric.b1 += rOther.b1;
+	rQuadric.b2 += rOther.b2;
+	rQuadric.c += rOther.c;
+}
+
+/// Evaluate the error of the sum of two quadrics at a given position.
+static float64_t EvaluateSimplifyQuadrics(
+	const SimplifyQuadric& rQuadric0,
+	const SimplifyQuadric& rQuadric1,
+	const float32_t* pPosition )
+{
+	float64_t x = pPosition[ 0 ];
+	float64_t y = pPosition[ 1 ];
+	float64_t z = pPosition[ 2 ];
+
+	float64_t error = 0.0;
+	const SimplifyQuadric* quadrics[ 2 ] = { &rQuadric0, &rQuadric1 };
+	for( size_t quadricIndex = 0; quadricIndex < 2; ++quadricIndex )
+	{
+		const SimplifyQuadric& rQuadric = *quadrics[ quadricIndex ];
+		error +=
+			rQuadric.a00 * x * x + rQuadric.a11 * y * y + rQuadric.a22 * z * z +
+			2.0 * ( rQuadric.a01 * x * y + rQuadric.a02 * x * z + rQuadric.a12 * y * z ) +
+			2.0 * ( rQuadric.b0 * x + rQuadric.b1 * y + rQuadric.b2 * z ) +
+			rQuadric.c;
+	}
+
+	return ( error < 0.0 ? -error : error );
+}
+
+/// Compute the Forsyth score for a vertex.
+///
+/// @param[in] cachePosition       Position of the vertex in the simulated LRU cache, or -1 if not in the cache.
+/// @param[in] remainingValence    Number of triangles referencing the vertex that have yet to be emitted.
+///
+/// @return  Vertex score.
+static float32_t ComputeVertexScore( int cachePosition, uint32_t remainingValence )
+{
+	if( remainingValence == 0 )
+	{
+		return -1.0f;
+	}
+
+	float32_t score = 0.0f;
+	if( cachePosition >= 0 )
+	{
+		if( cachePosition < 3 )
+		{
+			// Vertices used by the most recently emitted triangle get a fixed score to avoid favoring the exact same
+			// triangle edge ordering.
+			score = 0.75f;
+		}
+		else
+		{
+			const float32_t scaler = 1.0f / static_cast< float32_t >( MeshOptimizer::VERTEX_CACHE_SIZE - 3 );
+			score = 1.0f - static_cast< float32_t >( cachePosition - 3 ) * scaler;
+			score = std::pow( score, 1.5f );
+		}
+	}
+
+	// Boost vertices with few remaining triangles so that lone triangles are not left behind.
+	score += 2.0f * std::pow( static_cast< float32_t >( remainingValence ), -0.5f );
+
+	return score;
+}
+
+/// Hash a block of memory using the FNV-1a algorithm.
+///
+/// @param[in] pData  Data to hash.
+/// @param[in] size   Number of bytes to hash.
+/// @param[in] hash   Initial hash value.
+///
+/// @return  Hash value.
+static uint32_t HashBytes( const void* pData, size_t size, uint32_t hash = 2166136261U )
+{
+	const uint8_t* pBytes = static_cast< const uint8_t* >( pData );
+	for( size_t byteIndex = 0; byteIndex < size; ++byteIndex )
+	{
+		hash ^= pBytes[ byteIndex ];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/// Build a remap table that collapses bitwise-identical vertices into a single vertex.
+///
+/// @param[in]  pVertices        Vertex data.
+/// @param[in]  vertexStride     Size of each vertex, in bytes.
+/// @param[in]  pExtraData       Optional per-vertex data stored in a separate stream that must also match for vertices
+///                              to be welded (i.e. skinning blend data).  This can be null.
+/// @param[in]  extraDataStride  Size of each element in the extra data stream, in bytes.
+/// @param[in]  vertexCount      Number of vertices.
+/// @param[out] rRemap           Mapping from each source vertex index to its welded vertex index.  New indices are
+///                              assigned in order of first occurrence.
+///
+/// @return  Number of unique vertices.
+///
+/// @see RemapIndices(), RemapVertices()
+size_t MeshOptimizer::GenerateWeldRemap(
+	const void* pVertices,
+	size_t vertexStride,
+	const void* pExtraData,
+	size_t extraDataStride,
+	size_t vertexCount,
+	DynamicArray< uint16_t >& rRemap )
+{
+	HELIUM_ASSERT( pVertices || vertexCount == 0 );
+	HELIUM_ASSERT( vertexCount <= UINT16_MAX );
+
+	rRemap.Resize( 0 );
+	rRemap.Reserve( vertexCount );
+
+	if( vertexCount == 0 )
+	{
+		return 0;
+	}
+
+	const uint8_t* pVertexBytes = static_cast< const uint8_t* >( pVertices );
+	const uint8_t* pExtraBytes = static_cast< const uint8_t* >( pExtraData );
+
+	// Open addressing hash table of unique vertex indices (sized to the next power of two above twice the vertex
+	// count to keep probe sequences short).
+	size_t tableSize = 1;
+	while( tableSize < vertexCount * 2 )
+	{
+		tableSize <<= 1;
+	}
+
+	const uint16_t emptySlot = UINT16_MAX;
+	DynamicArray< uint16_t > table;
+	table.Reserve( tableSize );
+	table.Add( emptySlot, tableSize );
+
+	DynamicArray< uint16_t > uniqueSourceIndices;
+	uniqueSourceIndices.Reserve( vertexCount );
+
+	for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		const uint8_t* pVertex = pVertexBytes + vertexIndex * vertexStride;
+		const uint8_t* pExtra = ( pExtraBytes ? pExtraBytes + vertexIndex * extraDataStride : NULL );
+
+		uint32_t hash = HashBytes( pVertex, vertexStride );
+		if( pExtra )
+		{
+			hash = HashBytes( pExtra, extraDataStride, hash );
+		}
+
+		size_t slot = hash & ( tableSize - 1 );
+		for( ; ; )
+		{
+			uint16_t uniqueIndex = table[ slot ];
+			if( uniqueIndex == emptySlot )
+			{
+				uniqueIndex = static_cast< uint16_t >( uniqueSourceIndices.GetSize() );
+				uniqueSourceIndices.Push( static_cast< uint16_t >( vertexIndex ) );
+				table[ slot ] = uniqueIndex;
+				rRemap.Push( uniqueIndex );
+
+				break;
+			}
+
+			size_t sourceIndex = uniqueSourceIndices[ uniqueIndex ];
+			if( memcmp( pVertex, pVertexBytes + sourceIndex * vertexStride, vertexStride ) == 0 &&
+				( !pExtra ||
+				  memcmp( pExtra, pExtraBytes + sourceIndex * extraDataStride, extraDataStride ) == 0 ) )
+			{
+				rRemap.Push( uniqueIndex );
+
+				break;
+			}
+
+			slot = ( slot + 1 ) & ( tableSize - 1 );
+		}
+	}
+
+	return uniqueSourceIndices.GetSize();
+}
+
+/// Reorder a triangle list to improve post-transform vertex cache utilization.
+///
+/// This implements the linear-speed vertex cache optimization algorithm described by Tom Forsyth, which greedily
+/// emits the triangle with the highest score based on the simulated LRU cache position and remaining valence of its
+/// vertices.
+///
+/// @param[in,out] pIndices     Triangle list indices to reorder.
+/// @param[in]     indexCount   Number of indices (must be a multiple of three).
+/// @param[in]     vertexCount  Number of vertices addressed by the index list.
+void MeshOptimizer::OptimizeVertexCache( uint16_t* pIndices, size_t indexCount, size_t vertexCount )
+{
+	HELIUM_ASSERT( pIndices || indexCount == 0 );
+	HELIUM_ASSERT( indexCount % 3 == 0 );
+
+	size_t triangleCount = indexCount / 3;
+	if( triangleCount < 2 )
+	{
+		return;
+	}
+
+	// Build the vertex-to-triangle adjacency lists.
+	DynamicArray< uint32_t > remainingValences;
+	remainingValences.Reserve( vertexCount );
+	remainingValences.Add( 0, vertexCount );
+	for( size_t index = 0; index < indexCount; ++index )
+	{
+		HELIUM_ASSERT( pIndices[ index ] < vertexCount );
+		++remainingValences[ pIndices[ index ] ];
+	}
+
+	DynamicArray< uint32_t > adjacencyOffsets;
+	adjacencyOffsets.Reserve( vertexCount + 1 );
+	adjacencyOffsets.Add( 0, vertexCount + 1 );
+	for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		adjacencyOffsets[ vertexIndex + 1 ] = adjacencyOffsets[ vertexIndex ] + remainingValences[ vertexIndex ];
+	}
+
+	DynamicArray< uint32_t > adjacentTriangles;
+	adjacentTriangles.Reserve( indexCount );
+	adjacentTriangles.Add( 0, indexCount );
+	{
+		DynamicArray< uint32_t > fillCounts;
+		fillCounts.Reserve( vertexCount );
+		fillCounts.Add( 0, vertexCount );
+		for( size_t index = 0; index < indexCount; ++index )
+		{
+			uint16_t vertexIndex = pIndices[ index ];
+			adjacentTriangles[ adjacencyOffsets[ vertexIndex ] + fillCounts[ vertexIndex ] ] =
+				static_cast< uint32_t >( index / 3 );
+			++fillCounts[ vertexIndex ];
+		}
+	}
+
+	// Compute the initial vertex and triangle scores.
+	DynamicArray< int > cachePositions;
+	cachePositions.Reserve( vertexCount );
+	cachePositions.Add( -1, vertexCount );
+
+	DynamicArray< float32_t > vertexScores;
+	vertexScores.Reserve( vertexCount );
+	for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		vertexScores.Push( ComputeVertexScore( -1, remainingValences[ vertexIndex ] ) );
+	}
+
+	DynamicArray< float32_t > triangleScores;
+	triangleScores.Reserve( triangleCount );
+	DynamicArray< bool > emittedTriangles;
+	emittedTriangles.Reserve( triangleCount );
+	emittedTriangles.Add( false, triangleCount );
+
+	size_t bestTriangle = 0;
+	float32_t bestScore = -1.0f;
+	for( size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex )
+	{
+		const uint16_t* pTriangle = pIndices + triangleIndex * 3;
+		float32_t score =
+			vertexScores[ pTriangle[ 0 ] ] + vertexScores[ pTriangle[ 1 ] ] + vertexScores[ pTriangle[ 2 ] ];
+		triangleScores.Push( score );
+
+		if( score > bestScore )
+		{
+			bestScore = score;
+			bestTriangle = triangleIndex;
+		}
+	}
+
+	DynamicArray< uint16_t > sourceIndices;
+	sourceIndices.Reserve( indexCount );
+	sourceIndices.AddArray( pIndices, indexCount );
+
+	// Simulated LRU cache (with room for the three vertices of the triangle being emitted).
+	uint16_t cache[ VERTEX_CACHE_SIZE + 3 ];
+	uint16_t newCache[ VERTEX_CACHE_SIZE + 3 ];
+	size_t cacheCount = 0;
+
+	size_t scanTriangle = 0;
+	for( size_t outputTriangle = 0; outputTriangle < triangleCount; ++outputTriangle )
+	{
+		if( bestScore < 0.0f )
+		{
+			// No triangles adjacent to the cache remain, so fall back to the next unemitted triangle in the source
+			// ordering.
+			while( emittedTriangles[ scanTriangle ] )
+			{
+				++scanTriangle;
+				HELIUM_ASSERT( scanTriangle < triangleCount );
+			}
+
+			bestTriangle = scanTriangle;
+		}
+
+		const uint16_t* pTriangle = &sourceIndices[ bestTriangle * 3 ];
+		MemoryCopy( pIndices + outputTriangle * 3, pTriangle, sizeof( uint16_t ) * 3 );
+		emittedTriangles[ bestTriangle ] = true;
+
+		// Remove the triangle from the adjacency lists of its vertices and push its vertices to the front of the
+		// cache.
+		size_t newCacheCount = 0;
+		for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+		{
+			uint16_t vertexIndex = pTriangle[ cornerIndex ];
+
+			uint32_t* pAdjacency = &adjacentTriangles[ adjacencyOffsets[ vertexIndex ] ];
+			uint32_t& rValence = remainingValences[ vertexIndex ];
+			for( uint32_t adjacencyIndex = 0; adjacencyIndex < rValence; ++adjacencyIndex )
+			{
+				if( pAdjacency[ adjacencyIndex ] == bestTriangle )
+				{
+					pAdjacency[ adjacencyIndex ] = pAdjacency[ rValence - 1 ];
+					--rValence;
+
+					break;
+				}
+			}
+
+			bool bAlreadyAdded = false;
+			for( size_t newCacheIndex = 0; newCacheIndex < newCacheCount; ++newCacheIndex )
+			{
+				if( newCache[ newCacheIndex ] == vertexIndex )
+				{
+					bAlreadyAdded = true;
+
+					break;
+				}
+			}
+
+			if( !bAlreadyAdded )
+			{
+				newCache[ newCacheCount++ ] = vertexIndex;
+			}
+		}
+
+		for( size_t cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex )
+		{
+			uint16_t vertexIndex = cache[ cacheIndex ];
+			if( vertexIndex != pTriangle[ 0 ] && vertexIndex != pTriangle[ 1 ] && vertexIndex != pTriangle[ 2 ] )
+			{
+				newCache[ newCacheCount++ ] = vertexIndex;
+			}
+		}
+
+		// Update the scores of all vertices that were in the cache, including those that were just evicted.
+		for( size_t cacheIndex = 0; cacheIndex < newCacheCount; ++cacheIndex )
+		{
+			uint16_t vertexIndex = newCache[ cacheIndex ];
+			int cachePosition = ( cacheIndex < VERTEX_CACHE_SIZE ? static_cast< int >( cacheIndex ) : -1 );
+			cachePositions[ vertexIndex ] = cachePosition;
+			vertexScores[ vertexIndex ] = ComputeVertexScore( cachePosition, remainingValences[ vertexIndex ] );
+		}
+
+		// Update the scores of the triangles affected by the cache change, tracking the best candidate.
+		bestScore = -1.0f;
+		for( size_t cacheIndex = 0; cacheIndex < newCacheCount; ++cacheIndex )
+		{
+			uint16_t vertexIndex = newCache[ cacheIndex ];
+			const uint32_t* pAdjacency = &adjacentTriangles[ adjacencyOffsets[ vertexIndex ] ];
+			uint32_t valence = remainingValences[ vertexIndex ];
+			for( uint32_t adjacencyIndex = 0; adjacencyIndex < valence; ++adjacencyIndex )
+			{
+				uint32_t triangleIndex = pAdjacency[ adjacencyIndex ];
+				const uint16_t* pAdjacentTriangle = &sourceIndices[ triangleIndex * 3 ];
+				float32_t score =
+					vertexScores[ pAdjacentTriangle[ 0 ] ] +
+					vertexScores[ pAdjacentTriangle[ 1 ] ] +
+					vertexScores[ pAdjacentTriangle[ 2 ] ];
+				triangleScores[ triangleIndex ] = score;
+
+				if( score > bestScore )
+				{
+					bestScore = score;
+					bestTriangle = triangleIndex;
+				}
+			}
+		}
+
+		cacheCount = ( newCacheCount < VERTEX_CACHE_SIZE ? newCacheCount : VERTEX_CACHE_SIZE );
+		MemoryCopy( cache, newCache, sizeof( uint16_t ) * cacheCount );
+	}
+}
+
+/// Reorder clusters of a vertex cache optimized triangle list to reduce pixel overdraw.
+///
+/// The triangle list is split into clusters at points where restarting with an empty vertex cache costs little (based
+/// on the approach from Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw").  Clusters
+/// are then sorted so that those facing away from the mesh center are drawn first, as they are more likely to occlude
+/// the remaining clusters.
+///
+/// @param[in,out] pIndices        Triangle list indices to reorder.  This should already be optimized for the vertex
+///                                cache using OptimizeVertexCache().
+/// @param[in]     indexCount      Number of indices (must be a multiple of three).
+/// @param[in]     pPositions      Pointer to the position of the first vertex.
+/// @param[in]     positionStride  Byte stride between vertex positions.
+/// @param[in]     vertexCount     Number of vertices addressed by the index list.
+/// @param[in]     threshold       Maximum allowed ratio of the resulting cache miss ratio to the cache miss ratio of
+///                                the input index list.
+void MeshOptimizer::OptimizeOverdraw(
+	uint16_t* pIndices,
+	size_t indexCount,
+	const float32_t* pPositions,
+	size_t positionStride,
+	size_t vertexCount,
+	float32_t threshold )
+{
+	HELIUM_ASSERT( pIndices || indexCount == 0 );
+	HELIUM_ASSERT( pPositions || vertexCount == 0 );
+	HELIUM_ASSERT( indexCount % 3 == 0 );
+
+	size_t triangleCount = indexCount / 3;
+	if( triangleCount < 2 )
+	{
+		return;
+	}
+
+	Statistics inputStatistics;
+	ComputeStatistics( pIndices, indexCount, vertexCount, inputStatistics );
+	float32_t targetAcmr = inputStatistics.acmr * threshold;
+
+	const uint8_t* pPositionBytes = reinterpret_cast< const uint8_t* >( pPositions );
+
+	// Split the triangle list into clusters, simulating a cache flush at the start of each cluster.
+	DynamicArray< OverdrawCluster > clusters;
+	DynamicArray< uint32_t > cacheTimestamps;
+	cacheTimestamps.Reserve( vertexCount );
+	cacheTimestamps.Add( 0, vertexCount );
+	uint32_t timestamp = STATISTICS_CACHE_SIZE + 1;
+
+	size_t clusterStart = 0;
+	size_t clusterMisses = 0;
+	for( size_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex )
+	{
+		const uint16_t* pTriangle = pIndices + triangleIndex * 3;
+		for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+		{
+			uint16_t vertexIndex = pTriangle[ cornerIndex ];
+			if( timestamp - cacheTimestamps[ vertexIndex ] > STATISTICS_CACHE_SIZE )
+			{
+				cacheTimestamps[ vertexIndex ] = timestamp++;
+				++clusterMisses;
+			}
+		}
+
+		size_t clusterTriangleCount = triangleIndex + 1 - clusterStart;
+		if( triangleIndex + 1 == triangleCount ||
+			( clusterTriangleCount >= STATISTICS_CACHE_SIZE &&
+			  static_cast< float32_t >( clusterMisses ) <=
+			  targetAcmr * static_cast< float32_t >( clusterTriangleCount ) ) )
+		{
+			OverdrawCluster* pCluster = clusters.New();
+			HELIUM_ASSERT( pCluster );
+			pCluster->startTriangle = clusterStart;
+			pCluster->triangleCount = clusterTriangleCount;
+			pCluster->sortKey = 0.0f;
+
+			// Flush the simulated cache.
+			timestamp += STATISTICS_CACHE_SIZE + 1;
+			clusterStart = triangleIndex + 1;
+			clusterMisses = 0;
+		}
+	}
+
+	size_t clusterCount = clusters.GetSize();
+	if( clusterCount < 2 )
+	{
+		return;
+	}
+
+	// Compute the mesh centroid.
+	Simd::Vector3 meshCentroid( 0.0f );
+	for( size_t index = 0; index < indexCount; ++index )
+	{
+		const float32_t* pPosition =
+			reinterpret_cast< const float32_t* >( pPositionBytes + pIndices[ index ] * positionStride );
+		meshCentroid += Simd::Vector3( pPosition[ 0 ], pPosition[ 1 ], pPosition[ 2 ] );
+	}
+
+	meshCentroid *= Simd::Vector3( 1.0f / static_cast< float32_t >( indexCount ) );
+
+	// Compute the sort key for each cluster (dot product of the area-weighted cluster normal with the vector from the
+	// mesh centroid to the cluster centroid).
+	for( size_t clusterIndex = 0; clusterIndex < clusterCount; ++clusterIndex )
+	{
+		OverdrawCluster& rCluster = clusters[ clusterIndex ];
+
+		Simd::Vector3 clusterCentroid( 0.0f );
+		Simd::Vector3 clusterNormal( 0.0f );
+		float32_t clusterArea = 0.0f;
+
+		size_t triangleEnd = rCluster.startTriangle + rCluster.triangleCount;
+		for( size_t triangleIndex = rCluster.startTriangle; triangleIndex < triangleEnd; ++triangleIndex )
+		{
+			const uint16_t* pTriangle = pIndices + triangleIndex * 3;
+			const float32_t* pPosition0 =
+				reinterpret_cast< const float32_t* >( pPositionBytes + pTriangle[ 0 ] * positionStride );
+			const float32_t* pPosition1 =
+				reinterpret_cast< const float32_t* >( pPositionBytes + pTriangle[ 1 ] * positionStride );
+			const float32_t* pPosition2 =
+				reinterpret_cast< const float32_t* >( pPositionBytes + pTriangle[ 2 ] * positionStride );
+
+			Simd::Vector3 position0( pPosition0[ 0 ], pPosition0[ 1 ], pPosition0[ 2 ] );
+			Simd::Vector3 position1( pPosition1[ 0 ], pPosition1[ 1 ], pPosition1[ 2 ] );
+			Simd::Vector3 position2( pPosition2[ 0 ], pPosition2[ 1 ], pPosition2[ 2 ] );
+
+			Simd::Vector3 normal;
+			normal.CrossSet( position1 - position0, position2 - position0 );
+			float32_t area = normal.GetMagnitude();
+
+			clusterNormal += normal;
+			clusterCentroid += ( position0 + position1 + position2 ) * Simd::Vector3( area / 3.0f );
+			clusterArea += area;
+		}
+
+		if( clusterArea > HELIUM_EPSILON )
+		{
+			clusterCentroid *= Simd::Vector3( 1.0f / clusterArea );
+			clusterNormal.Normalize();
+			rCluster.sortKey = ( clusterCentroid - meshCentroid ).Dot( clusterNormal );
+		}
+	}
+
+	std::stable_sort( clusters.Begin(), clusters.End(), OverdrawClusterCompare );
+
+	DynamicArray< uint16_t > sourceIndices;
+	sourceIndices.Reserve( indexCount );
+	sourceIndices.AddArray( pIndices, indexCount );
+
+	uint16_t* pOutputIndices = pIndices;
+	for( size_t clusterIndex = 0; clusterIndex < clusterCount; ++clusterIndex )
+	{
+		const OverdrawCluster& rCluster = clusters[ clusterIndex ];
+		size_t clusterIndexCount = rCluster.triangleCount * 3;
+		MemoryCopy(
+			pOutputIndices,
+			&sourceIndices[ rCluster.startTriangle * 3 ],
+			clusterIndexCount * sizeof( uint16_t ) );
+		pOutputIndices += clusterIndexCount;
+	}
+
+	HELIUM_ASSERT( pOutputIndices == pIndices + indexCount );
+}
+
+/// Build a remap table that orders vertices by their first use in a triangle list.
+///
+/// This improves pre-transform vertex fetch locality once the index list has been optimized for the post-transform
+/// vertex cache.  Vertices not referenced by the index list are discarded.
+///
+/// @param[in]  pIndices     Triangle list indices.
+/// @param[in]  indexCount   Number of indices.
+/// @param[in]  vertexCount  Number of vertices addressed by the index list.
+/// @param[out] rRemap       Mapping from each source vertex index to its new vertex index (invalid for unreferenced
+///                          vertices).
+///
+/// @return  Number of referenced vertices.
+///
+/// @see RemapIndices(), RemapVertices()
+size_t MeshOptimizer::GenerateVertexFetchRemap(
+	const uint16_t* pIndices,
+	size_t indexCount,
+	size_t vertexCount,
+	DynamicArray< uint16_t >& rRemap )
+{
+	HELIUM_ASSERT( pIndices || indexCount == 0 );
+
+	rRemap.Resize( 0 );
+	rRemap.Reserve( vertexCount );
+	rRemap.Add( Invalid< uint16_t >(), vertexCount );
+
+	uint16_t nextVertex = 0;
+	for( size_t index = 0; index < indexCount; ++index )
+	{
+		uint16_t vertexIndex = pIndices[ index ];
+		HELIUM_ASSERT( vertexIndex < vertexCount );
+		if( IsInvalid( rRemap[ vertexIndex ] ) )
+		{
+			rRemap[ vertexIndex ] = nextVertex++;
+		}
+	}
+
+	return nextVertex;
+}
+
+/// Reduce the number of triangles in a triangle list using quadric error metric edge collapses.
+///
+/// Vertices are collapsed onto existing neighboring vertices, so the simplified index list addresses the same vertex
+/// data as the source list and can share its vertex buffer.  Vertices on open borders and vertices that share their
+/// position with another vertex (texture coordinate or normal seams) are never removed in order to preserve the mesh
+/// silhouette and attribute continuity.
+///
+/// @param[in]  pIndices          Source triangle list indices.
+/// @param[in]  indexCount        Number of source indices (must be a multiple of three).
+/// @param[in]  pPositions        Pointer to the position of the first vertex.
+/// @param[in]  positionStride    Byte stride between vertex positions.
+/// @param[in]  vertexCount       Number of vertices addressed by the index list.
+/// @param[in]  targetIndexCount  Desired number of indices.  The result may contain more indices if no further
+///                               collapses are possible.
+/// @param[out] rDestination      Simplified triangle list indices.
+///
+/// @return  Number of indices in the simplified triangle list.
+size_t MeshOptimizer::SimplifyMesh(
+	const uint16_t* pIndices,
+	size_t indexCount,
+	const float32_t* pPositions,
+	size_t positionStride,
+	size_t vertexCount,
+	size_t targetIndexCount,
+	DynamicArray< uint16_t >& rDestination )
+{
+	HELIUM_ASSERT( pIndices || indexCount == 0 );
+	HELIUM_ASSERT( pPositions || vertexCount == 0 );
+	HELIUM_ASSERT( indexCount % 3 == 0 );
+
+	rDestination.Resize( 0 );
+	rDestination.Reserve( indexCount );
+	rDestination.AddArray( pIndices, indexCount );
+
+	if( indexCount <= targetIndexCount || vertexCount == 0 )
+	{
+		return indexCount;
+	}
+
+	const uint8_t* pPositionBytes = reinterpret_cast< const uint8_t* >( pPositions );
+
+	// Lock vertices that share their position with another vertex (attribute seams).
+	DynamicArray< bool > lockedVertices;
+	lockedVertices.Reserve( vertexCount );
+	lockedVertices.Add( false, vertexCount );
+	{
+		// Positions may be interleaved with other vertex data, so build a tightly packed copy for welding.
+		DynamicArray< float32_t > packedPositions;
+		packedPositions.Reserve( vertexCount * 3 );
+		for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+		{
+			packedPositions.AddArray( GetSimplifyPosition( pPositionBytes, positionStride, vertexIndex ), 3 );
+		}
+
+		DynamicArray< uint16_t > positionRemap;
+		size_t uniquePositionCount = GenerateWeldRemap(
+			packedPositions.GetData(), sizeof( float32_t ) * 3, NULL, 0, vertexCount, positionRemap );
+
+		DynamicArray< uint16_t > positionUseCounts;
+		positionUseCounts.Reserve( uniquePositionCount );
+		positionUseCounts.Add( 0, uniquePositionCount );
+		for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+		{
+			++positionUseCounts[ positionRemap[ vertexIndex ] ];
+		}
+
+		for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+		{
+			lockedVertices[ vertexIndex ] = ( positionUseCounts[ positionRemap[ vertexIndex ] ] > 1 );
+		}
+	}
+
+	// Lock vertices on open borders (edges referenced by only one triangle).
+	{
+		DynamicArray< uint32_t > edges;
+		edges.Reserve( indexCount );
+		for( size_t index = 0; index < indexCount; index += 3 )
+		{
+			for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+			{
+				uint32_t vertex0 = pIndices[ index + cornerIndex ];
+				uint32_t vertex1 = pIndices[ index + ( cornerIndex + 1 ) % 3 ];
+				edges.Push( vertex0 < vertex1 ? ( ( vertex0 << 16 ) | vertex1 ) : ( ( vertex1 << 16 ) | vertex0 ) );
+			}
+		}
+
+		std::sort( edges.Begin(), edges.End() );
+
+		size_t edgeCount = edges.GetSize();
+		for( size_t edgeIndex = 0; edgeIndex < edgeCount; )
+		{
+			size_t runEnd = edgeIndex + 1;
+			while( runEnd < edgeCount && edges[ runEnd ] == edges[ edgeIndex ] )
+			{
+				++runEnd;
+			}
+
+			if( runEnd - edgeIndex == 1 )
+			{
+				lockedVertices[ edges[ edgeIndex ] >> 16 ] = true;
+				lockedVertices[ edges[ edgeIndex ] & 0xffff ] = true;
+			}
+
+			edgeIndex = runEnd;
+		}
+	}
+
+	// Build the initial vertex quadrics from the area-weighted planes of each triangle.
+	DynamicArray< SimplifyQuadric > quadrics;
+	quadrics.Reserve( vertexCount );
+	{
+		SimplifyQuadric zeroQuadric;
+		MemoryZero( &zeroQuadric, sizeof( zeroQuadric ) );
+		quadrics.Add( zeroQuadric, vertexCount );
+	}
+
+	for( size_t index = 0; index < indexCount; index += 3 )
+	{
+		const float32_t* pPosition0 = GetSimplifyPosition( pPositionBytes, positionStride, pIndices[ index ] );
+		const float32_t* pPosition1 = GetSimplifyPosition( pPositionBytes, positionStride, pIndices[ index + 1 ] );
+		const float32_t* pPosition2 = GetSimplifyPosition( pPositionBytes, positionStride, pIndices[ index + 2 ] );
+
+		float64_t normal[ 3 ];
+		ComputeSimplifyNormal( pPosition0, pPosition1, pPosition2, normal );
+		float64_t length = std::sqrt( normal[ 0 ] * normal[ 0 ] + normal[ 1 ] * normal[ 1 ] + normal[ 2 ] * normal[ 2 ] );
+		if( length <= 0.0 )
+		{
+			continue;
+		}
+
+		normal[ 0 ] /= length;
+		normal[ 1 ] /= length;
+		normal[ 2 ] /= length;
+		float64_t distance =
+			-( normal[ 0 ] * pPosition0[ 0 ] + normal[ 1 ] * pPosition0[ 1 ] + normal[ 2 ] * pPosition0[ 2 ] );
+		float64_t weight = length * 0.5;
+
+		for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+		{
+			AddSimplifyPlane(
+				quadrics[ pIndices[ index + cornerIndex ] ], normal[ 0 ], normal[ 1 ], normal[ 2 ], distance, weight );
+		}
+	}
+
+	DynamicArray< uint16_t > remap;
+	remap.Reserve( vertexCount );
+	for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		remap.Push( static_cast< uint16_t >( vertexIndex ) );
+	}
+
+	DynamicArray< SimplifyCollapse > collapses;
+	DynamicArray< bool > touchedVertices;
+	DynamicArray< uint32_t > adjacencyOffsets;
+	DynamicArray< uint32_t > adjacentTriangles;
+
+	size_t currentIndexCount = indexCount;
+	while( currentIndexCount > targetIndexCount )
+	{
+		uint16_t* pCurrentIndices = rDestination.GetData();
+
+		// Build the vertex-to-triangle adjacency for the current triangle list.
+		adjacencyOffsets.Resize( 0 );
+		adjacencyOffsets.Add( 0, vertexCount + 1 );
+		for( size_t index = 0; index < currentIndexCount; ++index )
+		{
+			++adjacencyOffsets[ pCurrentIndices[ index ] + 1 ];
+		}
+
+		for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+		{
+			adjacencyOffsets[ vertexIndex + 1 ] += adjacencyOffsets[ vertexIndex ];
+		}
+
+		adjacentTriangles.Resize( 0 );
+		adjacentTriangles.Add( 0, currentIndexCount );
+		for( size_t index = 0; index < currentIndexCount; ++index )
+		{
+			uint16_t vertexIndex = pCurrentIndices[ index ];
+			adjacentTriangles[ adjacencyOffsets[ vertexIndex ] ] = static_cast< uint32_t >( index / 3 );
+			++adjacencyOffsets[ vertexIndex ];
+		}
+
+		for( size_t vertexIndex = vertexCount; vertexIndex > 0; --vertexIndex )
+		{
+			adjacencyOffsets[ vertexIndex ] = adjacencyOffsets[ vertexIndex - 1 ];
+		}
+
+		adjacencyOffsets[ 0 ] = 0;
+
+		// Gather and sort the collapse candidates for each triangle edge.
+		collapses.Resize( 0 );
+		for( size_t index = 0; index < currentIndexCount; index += 3 )
+		{
+			for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+			{
+				uint16_t vertex0 = pCurrentIndices[ index + cornerIndex ];
+				uint16_t vertex1 = pCurrentIndices[ index + ( cornerIndex + 1 ) % 3 ];
+
+				for( size_t directionIndex = 0; directionIndex < 2; ++directionIndex )
+				{
+					uint16_t sourceVertex = ( directionIndex == 0 ? vertex0 : vertex1 );
+					uint16_t targetVertex = ( directionIndex == 0 ? vertex1 : vertex0 );
+					if( lockedVertices[ sourceVertex ] )
+					{
+						continue;
+					}
+
+					SimplifyCollapse* pCollapse = collapses.New();
+					HELIUM_ASSERT( pCollapse );
+					pCollapse->sourceVertex = sourceVertex;
+					pCollapse->targetVertex = targetVertex;
+					pCollapse->cost = static_cast< float32_t >( EvaluateSimplifyQuadrics(
+						quadrics[ sourceVertex ],
+						quadrics[ targetVertex ],
+						GetSimplifyPosition( pPositionBytes, positionStride, targetVertex ) ) );
+				}
+			}
+		}
+
+		if( collapses.IsEmpty() )
+		{
+			break;
+		}
+
+		std::sort( collapses.Begin(), collapses.End(), SimplifyCollapseCompare );
+
+		// Perform the cheapest independent collapses (collapses whose neighborhoods do not overlap).
+		touchedVertices.Resize( 0 );
+		touchedVertices.Add( false, vertexCount );
+
+		size_t removedIndexCount = 0;
+		size_t collapseCount = collapses.GetSize();
+		for( size_t collapseIndex = 0; collapseIndex < collapseCount; ++collapseIndex )
+		{
+			if( currentIndexCount - removedIndexCount <= targetIndexCount )
+			{
+				break;
+			}
+
+			const SimplifyCollapse& rCollapse = collapses[ collapseIndex ];
+			uint16_t sourceVertex = rCollapse.sourceVertex;
+			uint16_t targetVertex = rCollapse.targetVertex;
+			if( touchedVertices[ sourceVertex ] || touchedVertices[ targetVertex ] || remap[ sourceVertex ] != sourceVertex )
+			{
+				continue;
+			}
+
+			// Reject collapses that would flip the orientation of any of the remaining triangles.
+			const float32_t* pTargetPosition = GetSimplifyPosition( pPositionBytes, positionStride, targetVertex );
+
+			bool bFlipped = false;
+			size_t removedTriangleCount = 0;
+			uint32_t adjacencyEnd = adjacencyOffsets[ sourceVertex + 1 ];
+			for( uint32_t adjacencyIndex = adjacencyOffsets[ sourceVertex ];
+				adjacencyIndex < adjacencyEnd;
+				++adjacencyIndex )
+			{
+				const uint16_t* pTriangle = pCurrentIndices + adjacentTriangles[ adjacencyIndex ] * 3;
+				if( pTriangle[ 0 ] == targetVertex || pTriangle[ 1 ] == targetVertex || pTriangle[ 2 ] == targetVertex )
+				{
+					++removedTriangleCount;
+
+					continue;
+				}
+
+				const float32_t* pCornerPositions[ 3 ];
+				const float32_t* pCollapsedPositions[ 3 ];
+				for( size_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex )
+				{
+					pCornerPositions[ cornerIndex ] =
+						GetSimplifyPosition( pPositionBytes, positionStride, pTriangle[ cornerIndex ] );
+					pCollapsedPositions[ cornerIndex ] =
+						( pTriangle[ cornerIndex ] == sourceVertex ? pTargetPosition : pCornerPositions[ cornerIndex ] );
+				}
+
+				float64_t normalBefore[ 3 ];
+				float64_t normalAfter[ 3 ];
+				ComputeSimplifyNormal( pCornerPositions[ 0 ], pCornerPositions[ 1 ], pCornerPositions[ 2 ], normalBefore );
+				ComputeSimplifyNormal(
+					pCollapsedPositions[ 0 ], pCollapsedPositions[ 1 ], pCollapsedPositions[ 2 ], normalAfter );
+
+				float64_t dot =
+					normalBefore[ 0 ] * normalAfter[ 0 ] +
+					normalBefore[ 1 ] * normalAfter[ 1 ] +
+					normalBefore[ 2 ] * normalAfter[ 2 ];
+				float64_t lengthBefore = std::sqrt(
+					normalBefore[ 0 ] * normalBefore[ 0 ] +
+					normalBefore[ 1 ] * normalBefore[ 1 ] +
+					normalBefore[ 2 ] * normalBefore[ 2 ] );
+				float64_t lengthAfter = std::sqrt(
+					normalAfter[ 0 ] * normalAfter[ 0 ] +
+					normalAfter[ 1 ] * normalAfter[ 1 ] +
+					normalAfter[ 2 ] * normalAfter[ 2 ] );
+				if( dot <= 0.25 * lengthBefore * lengthAfter )
+				{
+					bFlipped = true;
+
+					break;
+				}
+			}
+
+			if( bFlipped )
+			{
+				continue;
+			}
+
+			// Lock the neighborhood of the collapsed vertex for the remainder of this pass.
+			for( uint32_t adjacencyIndex = adjacencyOffsets[ sourceVertex ];
+				adjacencyIndex < adjacencyEnd;
+				++adjacencyIndex )
+			{
+				const uint16_t* pTriangle = pCurrentIndices + adjacentTriangles[ adjacencyIndex ] * 3;
+				touchedVertices[ pTriangle[ 0 ] ] = true;
+				touchedVertices[ pTriangle[ 1 ] ] = true;
+				touchedVertices[ pTriangle[ 2 ] ] = true;
+			}
+
+			remap[ sourceVertex ] = targetVertex;
+			AddSimplifyQuadric( quadrics[ targetVertex ], quadrics[ sourceVertex ] );
+			removedIndexCount += removedTriangleCount * 3;
+		}
+
+		if( removedIndexCount == 0 )
+		{
+			break;
+		}
+
+		// Apply the collapses and remove degenerate triangles.
+		size_t writeIndex = 0;
+		for( size_t index = 0; index < currentIndexCount; index += 3 )
+		{
+			uint16_t vertex0 = remap[ pCurrentIndices[ index ] ];
+			uint16_t vertex1 = remap[ pCurrentIndices[ index + 1 ] ];
+			uint16_t vertex2 = remap[ pCurrentIndices[ index + 2 ] ];
+			if( vertex0 != vertex1 && vertex1 != vertex2 && vertex0 != vertex2 )
+			{
+				pCurrentIndices[ writeIndex++ ] = vertex0;
+				pCurrentIndices[ writeIndex++ ] = vertex1;
+				pCurrentIndices[ writeIndex++ ] = vertex2;
+			}
+		}
+
+		currentIndexCount = writeIndex;
+		rDestination.Resize( currentIndexCount );
+
+		// Collapsed vertices are now final, so point them at themselves again in case later passes collapse their
+		// targets.
+		for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+		{
+			if( remap[ vertexIndex ] != vertexIndex )
+			{
+				lockedVertices[ vertexIndex ] = true;
+				remap[ vertexIndex ] = static_cast< uint16_t >( vertexIndex );
+			}
+		}
+	}
+
+	return currentIndexCount;
+}
+
+/// Apply a vertex remap table to a triangle list.
+///
+/// @param[in,out] pIndices    Indices to remap.
+/// @param[in]     indexCount  Number of indices.
+/// @param[in]     rRemap      Vertex remap table.
+void MeshOptimizer::RemapIndices( uint16_t* pIndices, size_t indexCount, const DynamicArray< uint16_t >& rRemap )
+{
+	HELIUM_ASSERT( pIndices || indexCount == 0 );
+
+	for( size_t index = 0; index < indexCount; ++index )
+	{
+		HELIUM_ASSERT( pIndices[ index ] < rRemap.GetSize() );
+		pIndices[ index ] = rRemap[ pIndices[ index ] ];
+		HELIUM_ASSERT( IsValid( pIndices[ index ] ) );
+	}
+}
+
+/// Apply a vertex remap table to a vertex data stream in place.
+///
+/// @param[in,out] pVertices       Vertex data to remap.
+/// @param[in]     vertexStride    Size of each vertex, in bytes.
+/// @param[in]     vertexCount     Number of vertices prior to remapping.
+/// @param[in]     rRemap          Vertex remap table.
+/// @param[in]     newVertexCount  Number of vertices after remapping.  The data past this count is left undefined.
+void MeshOptimizer::RemapVertices(
+	void* pVertices,
+	size_t vertexStride,
+	size_t vertexCount,
+	const DynamicArray< uint16_t >& rRemap,
+	size_t newVertexCount )
+{
+	HELIUM_ASSERT( pVertices || vertexCount == 0 );
+	HELIUM_ASSERT( rRemap.GetSize() == vertexCount );
+	HELIUM_ASSERT( newVertexCount <= vertexCount );
+
+	uint8_t* pVertexBytes = static_cast< uint8_t* >( pVertices );
+
+	DynamicArray< uint8_t > sourceVertices;
+	sourceVertices.Reserve( vertexCount * vertexStride );
+	sourceVertices.AddArray( pVertexBytes, vertexCount * vertexStride );
+
+	for( size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex )
+	{
+		uint16_t newVertexIndex = rRemap[ vertexIndex ];
+		if( IsValid( newVertexIndex ) )
+		{
+			HELIUM_ASSERT( newVertexIndex < newVertexCount );
+			MemoryCopy(
+				pVertexBytes + newVertexIndex * vertexStride,
+				&sourceVertices[ vertexIndex * vertexStride ],
+				vertexStride );
+		}
+	}
+}
+
+/// Compute vertex cache statistics for a triangle list.
+///
+/// @param[in]  pIndices     Triangle list indices.
+/// @param[in]  indexCount   Number of indices (must be a multiple of three).
+/// @param[in]  vertexCount  Number of vertices addressed by the index list.
+/// @param[out] rStatistics  Computed statistics.
+void MeshOptimizer::ComputeStatistics(
+	const uint16_t* pIndices,
+	size_t indexCount,
+	size_t vertexCount,
+	Statistics& rStatistics )
+{
+	HELIUM_ASSERT( pIndices || indexCount == 0 );
+	HELIUM_ASSERT( indexCount % 3 == 0 );
+
+	size_t triangleCount = indexCount / 3;
+	rStatistics.vertexCount = static_cast< uint32_t >( vertexCount );
+	rStatistics.triangleCount = static_cast< uint32_t >( triangleCount );
+	rStatistics.acmr = 0.0f;
+	rStatistics.atvr = 0.0f;
+
+	if( triangleCount == 0 || vertexCount == 0 )
+	{
+		return;
+	}
+
+	// Simulate a FIFO cache using per-vertex timestamps.
+	DynamicArray< uint32_t > cacheTimestamps;
+	cacheTimestamps.Reserve( vertexCount );
+	cacheTimestamps.Add( 0, vertexCount );
+	uint32_t timestamp = STATISTICS_CACHE_SIZE + 1;
+
+	size_t missCount = 0;
+	for( size_t index = 0; index < indexCount; ++index )
+	{
+		uint16_t vertexIndex = pIndices[ index ];
+		HELIUM_ASSERT( vertexIndex < vertexCount );
+		if( timestamp - cacheTimestamps[ vertexIndex ] > STATISTICS_CACHE_SIZE )
+		{
+			cacheTimestamps[ vertexIndex ] = timestamp++;
+			++missCount;
+		}
+	}
+
+	rStatistics.acmr = static_cast< float32_t >( missCount ) / static_cast< float32_t >( triangleCount );
+	rStatistics.atvr = static_cast< float32_t >( missCount ) / static_cast< float32_t >( vertexCount );
+}
+
+#endif  // HELIUM_TOOLS
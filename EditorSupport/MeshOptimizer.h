@@ -0,0 +1,77 @@
+#pragma once
+
+#include "EditorSupport/EditorSupport.h"
+
+#if HELIUM_TOOLS
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+    /// Offline triangle mesh optimization routines used when caching mesh resources.
+    ///
+    /// All routines operate on a single mesh section at a time (a contiguous range of vertices addressed by a list of
+    /// 16-bit, section-relative triangle list indices).
+    class HELIUM_EDITOR_SUPPORT_API MeshOptimizer
+    {
+    public:
+        /// Size of the simulated post-transform vertex cache used for scoring triangles during vertex cache
+        /// optimization.
+        static const size_t VERTEX_CACHE_SIZE = 32;
+        /// Size of the FIFO vertex cache simulated when computing cache statistics.
+        static const size_t STATISTICS_CACHE_SIZE = 16;
+
+        /// Vertex cache and memory statistics for a triangle list.
+        struct Statistics
+        {
+            /// Average cache miss ratio (transformed vertices per triangle).
+            float32_t acmr;
+            /// Average transform to vertex ratio (transformed vertices per unique vertex).
+            float32_t atvr;
+            /// Number of vertices.
+            uint32_t vertexCount;
+            /// Number of triangles.
+            uint32_t triangleCount;
+        };
+
+        /// @name Vertex Welding
+        //@{
+        static size_t GenerateWeldRemap(
+            const void* pVertices, size_t vertexStride, const void* pExtraData, size_t extraDataStride,
+            size_t vertexCount, DynamicArray< uint16_t >& rRemap );
+        //@}
+
+        /// @name Index and Vertex Reordering
+        //@{
+        static void OptimizeVertexCache( uint16_t* pIndices, size_t indexCount, size_t vertexCount );
+        static void OptimizeOverdraw(
+            uint16_t* pIndices, size_t indexCount, const float32_t* pPositions, size_t positionStride,
+            size_t vertexCount, float32_t threshold = 1.05f );
+        static size_t GenerateVertexFetchRemap(
+            const uint16_t* pIndices, size_t indexCount, size_t vertexCount, DynamicArray< uint16_t >& rRemap );
+        //@}
+
+        /// @name Simplification
+        //@{
+        static size_t SimplifyMesh(
+            const uint16_t* pIndices, size_t indexCount, const float32_t* pPositions, size_t positionStride,
+            size_t vertexCount, size_t targetIndexCount, DynamicArray< uint16_t >& rDestination );
+        //@}
+
+        /// @name Remapping Support
+        //@{
+        static void RemapIndices( uint16_t* pIndices, size_t indexCount, const DynamicArray< uint16_t >& rRemap );
+        static void RemapVertices(
+            void* pVertices, size_t vertexStride, size_t vertexCount, const DynamicArray< uint16_t >& rRemap,
+            size_t newVertexCount );
+        //@}
+
+        /// @name Statistics
+        //@{
+        static void ComputeStatistics(
+            const uint16_t* pIndices, size_t indexCount, size_t vertexCount, Statistics& rStatistics );
+        //@}
+    };
+}
+
+#endif  // HELIUM_TOOLS
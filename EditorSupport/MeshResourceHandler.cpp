@@ -4,6 +4,7 @@
 
 #include "EditorSupport/MeshResourceHandler.h"
 
+#include "Platform/Timer.h"
 #include "Foundation/StringConverter.h"
 #include "MathSimd/Matrix44.h"
 #include "MathSimd/VectorConversion.h"
@@ -11,11 +12,291 @@
 #include "PcSupport/AssetPreprocessor.h"
 #include "PcSupport/PlatformPreprocessor.h"
 #include "EditorSupport/FbxSupport.h"
+#include "EditorSupport/MeshOptimizer.h"
 
 HELIUM_IMPLEMENT_ASSET( Helium::MeshResourceHandler, EditorSupport, 0 );
 
 using namespace Helium;
 
+/// Weld, reorder, and report statistics for each section of a mesh loaded from a source file.
+///
+/// Each mesh section is welded to remove duplicate vertices, its triangles are reordered for the post-transform vertex
+/// cache and to reduce overdraw, and its vertices are then reordered by first use for pre-transform fetch locality.
+///
+/// @param[in,out] rVertices             Mesh vertices.
+/// @param[in,out] rIndices              Section-relative triangle list indices.
+/// @param[in,out] rSectionVertexCounts  Number of vertices used by each mesh section.
+/// @param[in]     rSectionTriangleCounts  Number of triangles in each mesh section.
+/// @param[in,out] rVertexBlendData      Per-vertex skinning data (empty if the mesh is not skinned).
+/// @param[in]     rSourceFilePath       Path of the source file (for logging).
+static void OptimizeMeshSections(
+	DynamicArray< StaticMeshVertex< 1 > >& rVertices,
+	DynamicArray< uint16_t >& rIndices,
+	DynamicArray< uint16_t >& rSectionVertexCounts,
+	const DynamicArray< uint32_t >& rSectionTriangleCounts,
+	DynamicArray< FbxSupport::BlendData >& rVertexBlendData,
+	const String& rSourceFilePath )
+{
+	HELIUM_ASSERT( rSectionVertexCounts.GetSize() == rSectionTriangleCounts.GetSize() );
+	HELIUM_ASSERT( rVertexBlendData.IsEmpty() || rVertexBlendData.GetSize() == rVertices.GetSize() );
+
+	bool bSkinned = !rVertexBlendData.IsEmpty();
+
+	DynamicArray< StaticMeshVertex< 1 > > optimizedVertices;
+	optimizedVertices.Reserve( rVertices.GetSize() );
+	DynamicArray< FbxSupport::BlendData > optimizedBlendData;
+	optimizedBlendData.Reserve( rVertexBlendData.GetSize() );
+
+	DynamicArray< uint16_t > remap;
+	DynamicArray< StaticMeshVertex< 1 > > sectionVertices;
+	DynamicArray< FbxSupport::BlendData > sectionBlendData;
+
+	MeshOptimizer::Statistics totalSourceStatistics;
+	MemoryZero( &totalSourceStatistics, sizeof( totalSourceStatistics ) );
+	MeshOptimizer::Statistics totalOptimizedStatistics;
+	MemoryZero( &totalOptimizedStatistics, sizeof( totalOptimizedStatistics ) );
+	float32_t sourceMissCount = 0.0f;
+	float32_t optimizedMissCount = 0.0f;
+
+	SimpleTimer optimizeTimer;
+
+	size_t sectionStartVertex = 0;
+	size_t sectionStartIndex = 0;
+	size_t sectionCount = rSectionVertexCounts.GetSize();
+	for( size_t sectionIndex = 0; sectionIndex < sectionCount; ++sectionIndex )
+	{
+		size_t sectionVertexCount = rSectionVertexCounts[ sectionIndex ];
+		size_t sectionIndexCount = static_cast< size_t >( rSectionTriangleCounts[ sectionIndex ] ) * 3;
+		HELIUM_ASSERT( sectionStartVertex + sectionVertexCount <= rVertices.GetSize() );
+		HELIUM_ASSERT( sectionStartIndex + sectionIndexCount <= rIndices.GetSize() );
+
+		if( sectionVertexCount == 0 || sectionIndexCount == 0 )
+		{
+			rSectionVertexCounts[ sectionIndex ] = 0;
+			sectionStartVertex += sectionVertexCount;
+			sectionStartIndex += sectionIndexCount;
+
+			continue;
+		}
+
+		uint16_t* pSectionIndices = rIndices.GetData() + sectionStartIndex;
+
+		sectionVertices.Resize( 0 );
+		sectionVertices.AddArray( rVertices.GetData() + sectionStartVertex, sectionVertexCount );
+		sectionBlendData.Resize( 0 );
+		if( bSkinned )
+		{
+			sectionBlendData.AddArray( rVertexBlendData.GetData() + sectionStartVertex, sectionVertexCount );
+		}
+
+		MeshOptimizer::Statistics sourceStatistics;
+		MeshOptimizer::ComputeStatistics( pSectionIndices, sectionIndexCount, sectionVertexCount, sourceStatistics );
+
+		// Weld bitwise-identical vertices.
+		size_t weldedVertexCount = MeshOptimizer::GenerateWeldRemap(
+			sectionVertices.GetData(),
+			sizeof( StaticMeshVertex< 1 > ),
+			( bSkinned ? sectionBlendData.GetData() : NULL ),
+			sizeof( FbxSupport::BlendData ),
+			sectionVertexCount,
+			remap );
+		MeshOptimizer::RemapIndices( pSectionIndices, sectionIndexCount, remap );
+		MeshOptimizer::RemapVertices(
+			sectionVertices.GetData(), sizeof( StaticMeshVertex< 1 > ), sectionVertexCount, remap, weldedVertexCount );
+		if( bSkinned )
+		{
+			MeshOptimizer::RemapVertices(
+				sectionBlendData.GetData(),
+				sizeof( FbxSupport::BlendData ),
+				sectionVertexCount,
+				remap,
+				weldedVertexCount );
+		}
+
+		// Reorder triangles for the post-transform vertex cache, then reorder triangle clusters to reduce overdraw.
+		MeshOptimizer::OptimizeVertexCache( pSectionIndices, sectionIndexCount, weldedVertexCount );
+		MeshOptimizer::OptimizeOverdraw(
+			pSectionIndices,
+			sectionIndexCount,
+			sectionVertices[ 0 ].position,
+			sizeof( StaticMeshVertex< 1 > ),
+			weldedVertexCount );
+
+		// Reorder vertices by first use for pre-transform vertex fetch locality.
+		size_t fetchVertexCount = MeshOptimizer::GenerateVertexFetchRemap(
+			pSectionIndices, sectionIndexCount, weldedVertexCount, remap );
+		MeshOptimizer::RemapIndices( pSectionIndices, sectionIndexCount, remap );
+		MeshOptimizer::RemapVertices(
+			sectionVertices.GetData(), sizeof( StaticMeshVertex< 1 > ), weldedVertexCount, remap, fetchVertexCount );
+		if( bSkinned )
+		{
+			MeshOptimizer::RemapVertices(
+				sectionBlendData.GetData(),
+				sizeof( FbxSupport::BlendData ),
+				weldedVertexCount,
+				remap,
+				fetchVertexCount );
+		}
+
+		MeshOptimizer::Statistics optimizedStatistics;
+		MeshOptimizer::ComputeStatistics( pSectionIndices, sectionIndexCount, fetchVertexCount, optimizedStatistics );
+
+		HELIUM_TRACE(
+			TraceLevels::Debug,
+			( TXT( "MeshResourceHandler: \"%s\" section %" ) PRIuSZ TXT( ": vertices %" ) PRIuSZ TXT( " -> %" )
+			  PRIuSZ TXT( ", ACMR %.3f -> %.3f, ATVR %.3f -> %.3f.\n" ) ),
+			*rSourceFilePath,
+			sectionIndex,
+			sectionVertexCount,
+			fetchVertexCount,
+			sourceStatistics.acmr,
+			optimizedStatistics.acmr,
+			sourceStatistics.atvr,
+			optimizedStatistics.atvr );
+
+		sourceMissCount += sourceStatistics.acmr * static_cast< float32_t >( sourceStatistics.triangleCount );
+		optimizedMissCount += optimizedStatistics.acmr * static_cast< float32_t >( optimizedStatistics.triangleCount );
+		totalSourceStatistics.vertexCount += sourceStatistics.vertexCount;
+		totalSourceStatistics.triangleCount += sourceStatistics.triangleCount;
+		totalOptimizedStatistics.vertexCount += optimizedStatistics.vertexCount;
+		totalOptimizedStatistics.triangleCount += optimizedStatistics.triangleCount;
+
+		optimizedVertices.AddArray( sectionVertices.GetData(), fetchVertexCount );
+		if( bSkinned )
+		{
+			optimizedBlendData.AddArray( sectionBlendData.GetData(), fetchVertexCount );
+		}
+
+		HELIUM_ASSERT( fetchVertexCount <= UINT16_MAX );
+		rSectionVertexCounts[ sectionIndex ] = static_cast< uint16_t >( fetchVertexCount );
+
+		sectionStartVertex += sectionVertexCount;
+		sectionStartIndex += sectionIndexCount;
+	}
+
+	rVertices = optimizedVertices;
+	rVertexBlendData = optimizedBlendData;
+
+	if( totalSourceStatistics.triangleCount != 0 )
+	{
+		float32_t triangleCount = static_cast< float32_t >( totalSourceStatistics.triangleCount );
+		totalSourceStatistics.acmr = sourceMissCount / triangleCount;
+		totalOptimizedStatistics.acmr = optimizedMissCount / triangleCount;
+	}
+
+	if( totalSourceStatistics.vertexCount != 0 && totalOptimizedStatistics.vertexCount != 0 )
+	{
+		totalSourceStatistics.atvr = sourceMissCount / static_cast< float32_t >( totalSourceStatistics.vertexCount );
+		totalOptimizedStatistics.atvr =
+			optimizedMissCount / static_cast< float32_t >( totalOptimizedStatistics.vertexCount );
+	}
+
+	size_t vertexSize = ( bSkinned ? sizeof( SkinnedMeshVertex ) : sizeof( StaticMeshVertex< 1 > ) );
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		( TXT( "MeshResourceHandler: Optimized \"%s\" in %.2f ms: %" ) PRIu32 TXT( " -> %" ) PRIu32
+		  TXT( " vertices, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %" ) PRIuSZ TXT( " bytes per vertex.\n" ) ),
+		*rSourceFilePath,
+		optimizeTimer.Elapsed(),
+		totalSourceStatistics.vertexCount,
+		totalOptimizedStatistics.vertexCount,
+		totalSourceStatistics.acmr,
+		totalOptimizedStatistics.acmr,
+		totalSourceStatistics.atvr,
+		totalOptimizedStatistics.atvr,
+		vertexSize );
+}
+
+/// Generate simplified levels of detail for each section of an optimized mesh.
+///
+/// Each level of detail is simplified from the full detail index list and addresses the same vertices, so all levels
+/// share a single vertex buffer.  The resulting indices are stored by level of detail, then by mesh section.
+///
+/// @param[in]  rVertices               Mesh vertices.
+/// @param[in]  rIndices                Section-relative triangle list indices for the full detail mesh.
+/// @param[in]  rSectionVertexCounts    Number of vertices used by each mesh section.
+/// @param[in]  rSectionTriangleCounts  Number of triangles in each mesh section.
+/// @param[in]  rTriangleRatios         Fraction of the full detail triangle count to target for each level of detail.
+/// @param[out] rLodIndices             Section-relative triangle list indices for each simplified level of detail.
+/// @param[out] rLodSectionTriangleCounts  Number of triangles in each mesh section for each level of detail.
+/// @param[in]  rSourceFilePath         Path of the source file (for logging).
+static void GenerateMeshLods(
+	const DynamicArray< StaticMeshVertex< 1 > >& rVertices,
+	const DynamicArray< uint16_t >& rIndices,
+	const DynamicArray< uint16_t >& rSectionVertexCounts,
+	const DynamicArray< uint32_t >& rSectionTriangleCounts,
+	const DynamicArray< float32_t >& rTriangleRatios,
+	DynamicArray< uint16_t >& rLodIndices,
+	DynamicArray< uint32_t >& rLodSectionTriangleCounts,
+	const String& rSourceFilePath )
+{
+	rLodIndices.Resize( 0 );
+	rLodSectionTriangleCounts.Resize( 0 );
+
+	size_t lodCount = rTriangleRatios.GetSize();
+	size_t sectionCount = rSectionTriangleCounts.GetSize();
+	rLodSectionTriangleCounts.Reserve( lodCount * sectionCount );
+
+	DynamicArray< uint16_t > simplifiedIndices;
+
+	for( size_t lodIndex = 0; lodIndex < lodCount; ++lodIndex )
+	{
+		float32_t triangleRatio = Clamp( rTriangleRatios[ lodIndex ], 0.0f, 1.0f );
+
+		SimpleTimer lodTimer;
+		size_t lodTriangleCount = 0;
+		size_t fullTriangleCount = 0;
+
+		size_t sectionStartVertex = 0;
+		size_t sectionStartIndex = 0;
+		for( size_t sectionIndex = 0; sectionIndex < sectionCount; ++sectionIndex )
+		{
+			size_t sectionVertexCount = rSectionVertexCounts[ sectionIndex ];
+			size_t sectionIndexCount = static_cast< size_t >( rSectionTriangleCounts[ sectionIndex ] ) * 3;
+
+			size_t simplifiedIndexCount = 0;
+			if( sectionVertexCount != 0 && sectionIndexCount != 0 )
+			{
+				size_t targetIndexCount =
+					static_cast< size_t >( static_cast< float32_t >( sectionIndexCount / 3 ) * triangleRatio ) * 3;
+
+				simplifiedIndexCount = MeshOptimizer::SimplifyMesh(
+					rIndices.GetData() + sectionStartIndex,
+					sectionIndexCount,
+					rVertices[ sectionStartVertex ].position,
+					sizeof( StaticMeshVertex< 1 > ),
+					sectionVertexCount,
+					targetIndexCount,
+					simplifiedIndices );
+				MeshOptimizer::OptimizeVertexCache( simplifiedIndices.GetData(), simplifiedIndexCount, sectionVertexCount );
+
+				rLodIndices.AddArray( simplifiedIndices.GetData(), simplifiedIndexCount );
+			}
+
+			HELIUM_ASSERT( simplifiedIndexCount / 3 <= UINT32_MAX );
+			rLodSectionTriangleCounts.Push( static_cast< uint32_t >( simplifiedIndexCount / 3 ) );
+
+			lodTriangleCount += simplifiedIndexCount / 3;
+			fullTriangleCount += sectionIndexCount / 3;
+
+			sectionStartVertex += sectionVertexCount;
+			sectionStartIndex += sectionIndexCount;
+		}
+
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			( TXT( "MeshResourceHandler: Generated LOD %" ) PRIuSZ TXT( " for \"%s\" in %.2f ms: %" ) PRIuSZ
+			  TXT( " -> %" ) PRIuSZ TXT( " triangles (target ratio %.2f).\n" ) ),
+			lodIndex + 1,
+			*rSourceFilePath,
+			lodTimer.Elapsed(),
+			fullTriangleCount,
+			lodTriangleCount,
+			triangleRatio );
+	}
+}
+
 /// Constructor.
 MeshResourceHandler::MeshResourceHandler()
 : m_rFbxSupport( FbxSupport::StaticAcquire() )
@@ -52,6 +333,8 @@ bool MeshResourceHandler::CacheResource(
 	HELIUM_ASSERT( pAssetPreprocessor );
 	HELIUM_ASSERT( pResource );
 
+	Mesh* pMesh = Reflect::AssertCast< Mesh >( pResource );
+
 	StrongPtr< Mesh::PersistentResourceData > persistentResourceData( new Mesh::PersistentResourceData() );
 	persistentResourceData->GetRefCountProxy()->AddStrongRef(); // stack allocated object!!
 
@@ -83,6 +366,43 @@ bool MeshResourceHandler::CacheResource(
 		return false;
 	}
 
+	OptimizeMeshSections(
+		vertices,
+		indices,
+		persistentResourceData->m_sectionVertexCounts,
+		persistentResourceData->m_sectionTriangleCounts,
+		vertexBlendData,
+		rSourceFilePath );
+
+	// Generate the simplified levels of detail.  Any level of detail without a matching screen size threshold is
+	// ignored.
+	DynamicArray< float32_t > lodTriangleRatios( pMesh->GetLodTriangleRatioSettings() );
+	const DynamicArray< float32_t >& rLodScreenSizes = pMesh->GetLodScreenSizeSettings();
+	if( lodTriangleRatios.GetSize() > rLodScreenSizes.GetSize() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			( TXT( "MeshResourceHandler::CacheResource(): Mesh \"%s\" specifies more LOD triangle ratios than " )
+			  TXT( "LOD screen sizes.  Extra LODs will not be generated.\n" ) ),
+			*rSourceFilePath );
+
+		lodTriangleRatios.Resize( rLodScreenSizes.GetSize() );
+	}
+
+	DynamicArray< uint16_t > lodIndices;
+	GenerateMeshLods(
+		vertices,
+		indices,
+		persistentResourceData->m_sectionVertexCounts,
+		persistentResourceData->m_sectionTriangleCounts,
+		lodTriangleRatios,
+		lodIndices,
+		persistentResourceData->m_lodSectionTriangleCounts,
+		rSourceFilePath );
+
+	persistentResourceData->m_lodScreenSizes = rLodScreenSizes;
+	persistentResourceData->m_lodScreenSizes.Resize( lodTriangleRatios.GetSize() );
+
 	size_t vertexCountActual = vertices.GetSize();
 	HELIUM_ASSERT( vertexCountActual <= UINT32_MAX );
 	persistentResourceData->m_vertexCount = static_cast< uint32_t >( vertexCountActual );
@@ -241,9 +561,15 @@ bool MeshResourceHandler::CacheResource(
 			}
 		}
 		
+		// Simplified levels of detail are appended to the full detail indices so that they share one index buffer.
 		size_t indexDataSize = indexCount * sizeof(uint16_t);
-		rSubDataBuffers[ 1 ].Resize(indexDataSize);
+		size_t lodIndexDataSize = lodIndices.GetSize() * sizeof(uint16_t);
+		rSubDataBuffers[ 1 ].Resize(indexDataSize + lodIndexDataSize);
 		MemoryCopy(rSubDataBuffers[1].GetData(), indices.GetData(), indexDataSize);
+		if( lodIndexDataSize != 0 )
+		{
+			MemoryCopy(rSubDataBuffers[1].GetData() + indexDataSize, lodIndices.GetData(), lodIndexDataSize);
+		}
 
 		// Platform data is now loaded.
 		rPreprocessedData.bLoaded = true;
@@ -14,6 +14,8 @@
 #include "Rendering/ShaderProfiles.h"
 #include "PcSupport/AssetPreprocessor.h"
 
+#include <string.h>
+
 HELIUM_IMPLEMENT_ASSET( Helium::ShaderVariantResourceHandler, EditorSupport, 0 );
 
 using namespace Helium;
@@ -197,6 +199,21 @@ bool ShaderVariantResourceHandler::CacheResource(
 
 	delete pSourceFileStream;
 
+	// The variant needs to be recompiled if the shader options or any of the files included by the shader change.
+	pAssetPreprocessor->AddAssetDependency( pVariant->GetPath(), pShader->GetPath() );
+
+	FilePath includeDirectory;
+	includeDirectory.Set( FilePath( *rSourceFilePath ).Directory() );
+
+	DynamicArray< String > includeFilePaths;
+	AddIncludeDependencies(
+		pAssetPreprocessor,
+		pVariant->GetPath(),
+		includeDirectory,
+		static_cast< const char* >( pShaderSource ),
+		size,
+		includeFilePaths );
+
 	// Compile each variant of system options for each shader profile in each supported target platform.
 	const Shader::Options& rSystemOptions = pShader->GetSystemOptions();
 	size_t systemOptionSetCount = rSystemOptions.ComputeOptionSetCount( shaderType );
@@ -718,6 +735,143 @@ bool ShaderVariantResourceHandler::CompileShader(
 	return bCompileResult;
 }
 
+/// Helper function for recording every file included (directly or indirectly) by a block of shader source as an input
+/// of a shader variant.
+///
+/// Include file names are resolved relative to the shader directory, the same as when compiling.  Directives are not
+/// evaluated against the preprocessor state, so files that are only included conditionally are always recorded.
+///
+/// @param[in]     pAssetPreprocessor  Asset preprocessor with which to record the dependencies.
+/// @param[in]     variantPath         Path of the shader variant being preprocessed.
+/// @param[in]     rIncludeDirectory   Directory against which include file names are resolved.
+/// @param[in]     pSource             Shader source to scan.
+/// @param[in]     sourceSize          Size of the shader source, in bytes.
+/// @param[in,out] rVisitedFilePaths   Paths of the include files already recorded.
+void ShaderVariantResourceHandler::AddIncludeDependencies(
+	AssetPreprocessor* pAssetPreprocessor,
+	const AssetPath& variantPath,
+	const FilePath& rIncludeDirectory,
+	const char* pSource,
+	size_t sourceSize,
+	DynamicArray< String >& rVisitedFilePaths )
+{
+	HELIUM_ASSERT( pAssetPreprocessor );
+	HELIUM_ASSERT( pSource || sourceSize == 0 );
+
+	static const char includeDirective[] = "include";
+	static const size_t includeDirectiveLength = sizeof( includeDirective ) - 1;
+
+	const char* pSourceEnd = pSource + sourceSize;
+	const char* pLineEnd;
+	for( const char* pLine = pSource; pLine < pSourceEnd; pLine = pLineEnd + 1 )
+	{
+		pLineEnd = pLine;
+		while( pLineEnd < pSourceEnd && *pLineEnd != TXT( '\n' ) )
+		{
+			++pLineEnd;
+		}
+
+		// Match "#include" followed by a quoted or bracketed file name, allowing whitespace around the '#'.
+		const char* pCharacter = pLine;
+		while( pCharacter < pLineEnd && ( *pCharacter == TXT( ' ' ) || *pCharacter == TXT( '\t' ) ) )
+		{
+			++pCharacter;
+		}
+
+		if( pCharacter >= pLineEnd || *pCharacter != TXT( '#' ) )
+		{
+			continue;
+		}
+
+		++pCharacter;
+		while( pCharacter < pLineEnd && ( *pCharacter == TXT( ' ' ) || *pCharacter == TXT( '\t' ) ) )
+		{
+			++pCharacter;
+		}
+
+		if( static_cast< size_t >( pLineEnd - pCharacter ) <= includeDirectiveLength ||
+			strncmp( pCharacter, includeDirective, includeDirectiveLength ) != 0 )
+		{
+			continue;
+		}
+
+		pCharacter += includeDirectiveLength;
+		while( pCharacter < pLineEnd && ( *pCharacter == TXT( ' ' ) || *pCharacter == TXT( '\t' ) ) )
+		{
+			++pCharacter;
+		}
+
+		if( pCharacter >= pLineEnd || ( *pCharacter != TXT( '"' ) && *pCharacter != TXT( '<' ) ) )
+		{
+			continue;
+		}
+
+		char closingCharacter = ( *pCharacter == TXT( '"' ) ? TXT( '"' ) : TXT( '>' ) );
+		const char* pFileNameStart = ++pCharacter;
+		while( pCharacter < pLineEnd && *pCharacter != closingCharacter )
+		{
+			++pCharacter;
+		}
+
+		if( pCharacter >= pLineEnd || pCharacter == pFileNameStart )
+		{
+			continue;
+		}
+
+		std::string fileName( pFileNameStart, pCharacter - pFileNameStart );
+		FilePath includePath( rIncludeDirectory + fileName.c_str() );
+		String includePathString( includePath.c_str() );
+
+		size_t visitedFileCount = rVisitedFilePaths.GetSize();
+		size_t visitedFileIndex;
+		for( visitedFileIndex = 0; visitedFileIndex < visitedFileCount; ++visitedFileIndex )
+		{
+			if( CompareString( *rVisitedFilePaths[ visitedFileIndex ], *includePathString ) == 0 )
+			{
+				break;
+			}
+		}
+
+		if( visitedFileIndex < visitedFileCount )
+		{
+			continue;
+		}
+
+		rVisitedFilePaths.Push( includePathString );
+
+		// Missing include files are still recorded, so that the variant is compiled again once they are created.
+		pAssetPreprocessor->AddFileDependency( variantPath, includePathString );
+
+		FileStream* pIncludeFileStream = FileStream::OpenFileStream( includePathString, FileStream::MODE_READ );
+		if( !pIncludeFileStream )
+		{
+			continue;
+		}
+
+		int64_t includeSize = pIncludeFileStream->GetSize();
+		if( includeSize <= 0 || static_cast< uint64_t >( includeSize ) > static_cast< size_t >( -1 ) )
+		{
+			delete pIncludeFileStream;
+
+			continue;
+		}
+
+		DynamicArray< char > includeSource;
+		includeSource.Resize( static_cast< size_t >( includeSize ) );
+		size_t bytesRead = BufferedStream( pIncludeFileStream ).Read( includeSource.GetData(), 1, includeSource.GetSize() );
+
+		delete pIncludeFileStream;
+
+		AddIncludeDependencies(
+			pAssetPreprocessor,
+			variantPath,
+			rIncludeDirectory,
+			includeSource.GetData(),
+			bytesRead,
+			rVisitedFilePaths );
+	}
+}
+
 /// Compute a hash value for a shader variant load request.
 ///
 /// @param[in] pRequest  Load request.
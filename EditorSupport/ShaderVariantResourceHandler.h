@@ -97,6 +97,9 @@ namespace Helium
             size_t shaderProfileIndex, RShader::EType shaderType, const void* pShaderSourceData,
             size_t shaderSourceSize, const DynamicArray< PlatformPreprocessor::ShaderToken >& rTokens,
             DynamicArray< uint8_t >& rCompiledCodeBuffer );
+        static void AddIncludeDependencies(
+            AssetPreprocessor* pAssetPreprocessor, const AssetPath& variantPath, const FilePath& rIncludeDirectory,
+            const char* pSource, size_t sourceSize, DynamicArray< String >& rVisitedFilePaths );
         //@}
     };
 }
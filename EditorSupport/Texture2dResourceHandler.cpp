@@ -5,6 +5,7 @@
 #include "EditorSupport/Texture2dResourceHandler.h"
 
 #include "Engine/FileLocations.h"
+#include "Engine/WorkerPool.h"
 #include "Foundation/FilePath.h"
 #include "Foundation/FileStream.h"
 #include "Graphics/Texture2d.h"
@@ -14,6 +15,7 @@
 #include "EditorSupport/MemoryTextureOutputHandler.h"
 #include "EditorSupport/PngImageLoader.h"
 #include "EditorSupport/TgaImageLoader.h"
+#include "Platform/Timer.h"
 #include "Rendering/RendererTypes.h"
 
 #include <nvtt/nvtt.h>
@@ -22,14 +24,225 @@ HELIUM_IMPLEMENT_ASSET( Helium::Texture2dResourceHandler, EditorSupport, 0 );
 
 using namespace Helium;
 
+/// Minimum number of texel rows in each band of a mip level compressed as a separate job (must be a multiple of the
+/// 4x4 block size).
+static const uint32_t MIN_BAND_ROW_COUNT = 64;
+
+/// Horizontal band of texels from a single mip level, compressed as a separate job.
+struct TextureBand
+{
+    /// Source BGRA texel data for the first row in the band.
+    const uint8_t* pPixelData;
+    /// Band width, in texels.
+    uint32_t width;
+    /// Band height, in texels.
+    uint32_t height;
+    /// Index of the mip level containing the band.
+    uint32_t mipLevel;
+    /// Compressed band data.
+    MemoryTextureOutputHandler::MipDataArray output;
+    /// True if compression succeeded.
+    bool bSuccess;
+};
+
+/// Set of texture bands compressed with the same options.
+struct TextureBandSet
+{
+    /// Compression options.
+    const nvtt::CompressionOptions* pCompressionOptions;
+    /// Input gamma.
+    float gamma;
+    /// True if the texture is a normal map.
+    bool bNormalMap;
+    /// Bands to compress.
+    DynamicArray< TextureBand > bands;
+};
+
+/// WorkerPool job callback for compressing a single texture band.
+///
+/// @param[in] pData     TextureBandSet instance.
+/// @param[in] jobIndex  Index of the band to compress.
+static void CompressTextureBand( void* pData, size_t jobIndex )
+{
+    TextureBandSet* pBandSet = static_cast< TextureBandSet* >( pData );
+    HELIUM_ASSERT( pBandSet );
+
+    TextureBand& rBand = pBandSet->bands[ jobIndex ];
+
+    // Mip generation is disabled, so the band texels are passed to the block compressor as-is, exactly as they are
+    // when nvtt compresses a full image.
+    nvtt::InputOptions inputOptions;
+    inputOptions.setTextureLayout( nvtt::TextureType_2D, rBand.width, rBand.height );
+    inputOptions.setMipmapData( rBand.pPixelData, rBand.width, rBand.height );
+    inputOptions.setMipmapGeneration( false );
+    inputOptions.setWrapMode( nvtt::WrapMode_Repeat );
+    inputOptions.setGamma( pBandSet->gamma, pBandSet->gamma );
+    inputOptions.setNormalMap( pBandSet->bNormalMap );
+    inputOptions.setNormalizeMipmaps( pBandSet->bNormalMap );
+
+    MemoryTextureOutputHandler outputHandler( rBand.width, rBand.height, false, false );
+
+    nvtt::OutputOptions outputOptions;
+    outputOptions.setOutputHandler( &outputHandler );
+    outputOptions.setOutputHeader( false );
+
+    HELIUM_ASSERT( pBandSet->pCompressionOptions );
+
+    nvtt::Compressor compressor;
+    rBand.bSuccess = compressor.process( inputOptions, *pBandSet->pCompressionOptions, outputOptions );
+    if( rBand.bSuccess )
+    {
+        const MemoryTextureOutputHandler::MipLevelArray& rMipLevels = outputHandler.GetFace( 0 );
+        HELIUM_ASSERT( rMipLevels.GetSize() == 1 );
+        rBand.output = rMipLevels[ 0 ];
+    }
+}
+
+/// Split a mip level into bands of whole compression blocks and add them to a band set.
+///
+/// @param[in] rBandSet     Band set to update.
+/// @param[in] pPixelData   BGRA texel data for the mip level.
+/// @param[in] width        Mip level width, in texels.
+/// @param[in] height       Mip level height, in texels.
+/// @param[in] mipLevel     Mip level index.
+/// @param[in] targetCount  Number of bands into which to try to split the mip level.
+static void AddTextureBands(
+    TextureBandSet& rBandSet,
+    const uint8_t* pPixelData,
+    uint32_t width,
+    uint32_t height,
+    uint32_t mipLevel,
+    uint32_t targetCount )
+{
+    HELIUM_ASSERT( pPixelData );
+    HELIUM_ASSERT( targetCount != 0 );
+
+    // Blocks are compressed independently of each other and written out in row order, so as long as each band starts
+    // on a block boundary, the concatenated band data matches the data for the entire mip level.
+    uint32_t bandRowCount = ( height + targetCount - 1 ) / targetCount;
+    bandRowCount = ( bandRowCount + 3 ) & ~3;
+    bandRowCount = Max( bandRowCount, MIN_BAND_ROW_COUNT );
+
+    size_t pitch = static_cast< size_t >( width ) * 4;
+
+    for( uint32_t startRow = 0; startRow < height; startRow += bandRowCount )
+    {
+        TextureBand* pBand = rBandSet.bands.New();
+        HELIUM_ASSERT( pBand );
+        pBand->pPixelData = pPixelData + startRow * pitch;
+        pBand->width = width;
+        pBand->height = Min( bandRowCount, height - startRow );
+        pBand->mipLevel = mipLevel;
+        pBand->bSuccess = false;
+    }
+}
+
+/// Set up the compression options and renderer pixel format for a texture compression setting.
+///
+/// @param[in]  compression          Texture compression setting.
+/// @param[in]  bSrgb                True if the texture is in sRGB color space.
+/// @param[in]  bIgnoreAlpha         True if the texture alpha channel can be ignored.
+/// @param[out] rCompressionOptions  nvtt compression options to set up.
+/// @param[out] rPixelFormat         Renderer pixel format of the compressed data.
+static void SetUpCompressionOptions(
+    Texture::ECompression compression,
+    bool bSrgb,
+    bool bIgnoreAlpha,
+    nvtt::CompressionOptions& rCompressionOptions,
+    ERendererPixelFormat& rPixelFormat )
+{
+    nvtt::Format outputFormat = nvtt::Format_BC1;
+    rPixelFormat = RENDERER_PIXEL_FORMAT_BC1;
+
+    switch( compression )
+    {
+    case Texture::ECompression::NONE:
+        {
+            outputFormat = nvtt::Format_RGBA;
+#if HELIUM_ENDIAN_LITTLE
+            rCompressionOptions.setPixelFormat( 32, 0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff );
+#else
+            rCompressionOptions.setPixelFormat( 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000 );
+#endif
+            rPixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_R8G8B8A8_SRGB : RENDERER_PIXEL_FORMAT_R8G8B8A8 );
+
+            break;
+        }
+
+    case Texture::ECompression::COLOR:
+        {
+            outputFormat = ( bIgnoreAlpha ? nvtt::Format_BC1 : nvtt::Format_BC1a );
+            rPixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_BC1_SRGB : RENDERER_PIXEL_FORMAT_BC1 );
+
+            break;
+        }
+
+    case Texture::ECompression::COLOR_SHARP_ALPHA:
+        {
+            if( bIgnoreAlpha )
+            {
+                outputFormat = nvtt::Format_BC1;
+                rPixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_BC1_SRGB : RENDERER_PIXEL_FORMAT_BC1 );
+            }
+            else
+            {
+                outputFormat = nvtt::Format_BC2;
+                rPixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_BC2_SRGB : RENDERER_PIXEL_FORMAT_BC2 );
+            }
+
+            break;
+        }
+
+    case Texture::ECompression::COLOR_SMOOTH_ALPHA:
+        {
+            if( bIgnoreAlpha )
+            {
+                outputFormat = nvtt::Format_BC1;
+                rPixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_BC1_SRGB : RENDERER_PIXEL_FORMAT_BC1 );
+            }
+            else
+            {
+                outputFormat = nvtt::Format_BC3;
+                rPixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_BC3_SRGB : RENDERER_PIXEL_FORMAT_BC3 );
+            }
+
+            break;
+        }
+
+    case Texture::ECompression::NORMAL_MAP:
+        {
+            outputFormat = nvtt::Format_BC3n;
+            rPixelFormat = RENDERER_PIXEL_FORMAT_BC3;
+
+            break;
+        }
+
+    case Texture::ECompression::NORMAL_MAP_COMPACT:
+        {
+            outputFormat = nvtt::Format_BC1;
+            rPixelFormat = RENDERER_PIXEL_FORMAT_BC1;
+
+            break;
+        }
+
+    default:
+        break;
+    }
+
+    rCompressionOptions.setFormat( outputFormat );
+    rCompressionOptions.setQuality( nvtt::Quality_Normal );
+}
+
 /// Constructor.
 Texture2dResourceHandler::Texture2dResourceHandler()
 {
+    WorkerPool::Startup();
 }
 
 /// Destructor.
 Texture2dResourceHandler::~Texture2dResourceHandler()
 {
+    WorkerPool::Shutdown();
 }
 
 /// @copydoc ResourceHandler::GetResourceType()
@@ -163,167 +376,283 @@ bool Texture2dResourceHandler::CacheResource(
         }
     }
 
-    // Set up the input options for the texture compressor.
-    Texture::ECompression compression = pTexture->GetCompression();
-    HELIUM_ASSERT( static_cast< size_t >( compression ) < static_cast< size_t >( Texture::ECompression::MAX ) );
+    uint64_t compressStartTicks = Timer::GetTickCount();
 
-    bool bIsNormalMap = Texture::IsNormalMapCompression( compression );
+    MemoryTextureOutputHandler::MipLevelArray mipLevels;
+    ERendererPixelFormat pixelFormat = RENDERER_PIXEL_FORMAT_BC1;
+    size_t jobCount = 0;
+    if( !CompressTexture(
+        pImagePixelData,
+        imageWidth,
+        imageHeight,
+        pTexture->GetCompression(),
+        pTexture->GetSrgb(),
+        pTexture->GetCreateMipmaps(),
+        bIgnoreAlpha,
+        mipLevels,
+        pixelFormat,
+        jobCount ) )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            ( TXT( "Texture2dResourceHandler::CacheResource(): Texture compression failed for texture image " )
+            TXT( "\"%s\".\n" ) ),
+            *rSourceFilePath );
 
-    bool bSrgb = pTexture->GetSrgb();
-    bool bCreateMipmaps = pTexture->GetCreateMipmaps();
+        return false;
+    }
 
-    nvtt::InputOptions inputOptions;
-    inputOptions.setTextureLayout( nvtt::TextureType_2D, imageWidth, imageHeight );
-    inputOptions.setMipmapData( pImagePixelData, imageWidth, imageHeight );
-    inputOptions.setMipmapGeneration( bCreateMipmaps );
-    inputOptions.setMipmapFilter( nvtt::MipmapFilter_Box );
-    inputOptions.setWrapMode( nvtt::WrapMode_Repeat );
+    uint32_t mipLevelCount = static_cast< uint32_t >( mipLevels.GetSize() );
 
-    float gamma = ( bSrgb ? 2.2f : 1.0f );
-    inputOptions.setGamma( gamma, gamma );
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        ( TXT( "Texture2dResourceHandler::CacheResource(): Compressed \"%s\" (%" ) PRIu32 TXT( "x%" ) PRIu32
+          TXT( ", %" ) PRIu32 TXT( " mip levels) as %" ) PRIuSZ TXT( " jobs in %.2f ms.\n" ) ),
+        *rSourceFilePath,
+        imageWidth,
+        imageHeight,
+        mipLevelCount,
+        jobCount,
+        static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - compressStartTicks ) ) );
 
-    inputOptions.setNormalMap( bIsNormalMap );
-    inputOptions.setNormalizeMipmaps( bIsNormalMap );
+    int32_t pixelFormatIndex = static_cast< int32_t >( pixelFormat );
 
-    // Set up the output options for the texture compressor.
-    MemoryTextureOutputHandler outputHandler( imageWidth, imageHeight, false, bCreateMipmaps );
+    StrongPtr< Texture2d::PersistentResourceData > persistentResourceData( new Texture2d::PersistentResourceData() );
+    persistentResourceData->m_baseLevelWidth = imageWidth;
+    persistentResourceData->m_baseLevelHeight = imageHeight;
+    persistentResourceData->m_mipCount = mipLevelCount;
+    persistentResourceData->m_pixelFormatIndex = pixelFormatIndex;
 
-    nvtt::OutputOptions outputOptions;
-    outputOptions.setOutputHandler( &outputHandler );
-    outputOptions.setOutputHeader( false );
+    // Cache the data for each supported platform.
+    for ( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
+    {
+        PlatformPreprocessor* pPreprocessor = pAssetPreprocessor->GetPlatformPreprocessor(
+            static_cast< Cache::EPlatform >( platformIndex ) );
+        if ( !pPreprocessor )
+        {
+            continue;
+        }
 
-    // Set up the compression options for the texture compressor.
-    nvtt::CompressionOptions compressionOptions;
+        Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
+            static_cast< Cache::EPlatform >( platformIndex ) );
 
-    nvtt::Format outputFormat = nvtt::Format_BC1;
-    ERendererPixelFormat pixelFormat = RENDERER_PIXEL_FORMAT_BC1;
+        SaveObjectToPersistentDataBuffer(persistentResourceData.Get(), rPreprocessedData.persistentDataBuffer);
 
-    switch( compression )
+        rPreprocessedData.subDataBuffers = mipLevels;
+
+        rPreprocessedData.bLoaded = true;
+    }
+
+    return true;
+}
+
+/// @copydoc ResourceHandler::CanCacheResourceConcurrently()
+bool Texture2dResourceHandler::CanCacheResourceConcurrently() const
+{
+    // Each call only reads its own source image and writes to its own resource, and the shared worker pool
+    // accepts batches from multiple threads at once.
+    return true;
+}
+
+/// Compress a texture image and its mip chain, splitting each mip level into bands compressed in parallel on the
+/// shared worker pool.
+///
+/// The output is identical to that of CompressTextureReference(), which compresses the entire mip chain in a single
+/// job.
+///
+/// @param[in]  pPixelData      32-bit BGRA texel data for the base level.
+/// @param[in]  width           Base level width, in texels.
+/// @param[in]  height          Base level height, in texels.
+/// @param[in]  compression     Texture compression setting.
+/// @param[in]  bSrgb           True if the texture is in sRGB color space.
+/// @param[in]  bCreateMipmaps  True to generate the full mip chain, false to compress only the base level.
+/// @param[in]  bIgnoreAlpha    True if the texture alpha channel can be ignored.
+/// @param[out] rMipLevels      Compressed data for each mip level.
+/// @param[out] rPixelFormat    Renderer pixel format of the compressed data.
+/// @param[out] rJobCount       Number of compression jobs run.
+///
+/// @return  True if compression was successful, false if not.
+///
+/// @see CompressTextureReference()
+bool Texture2dResourceHandler::CompressTexture(
+    const void* pPixelData,
+    uint32_t width,
+    uint32_t height,
+    Texture::ECompression compression,
+    bool bSrgb,
+    bool bCreateMipmaps,
+    bool bIgnoreAlpha,
+    DynamicArray< DynamicArray< uint8_t > >& rMipLevels,
+    ERendererPixelFormat& rPixelFormat,
+    size_t& rJobCount )
+{
+    HELIUM_ASSERT( pPixelData );
+    HELIUM_ASSERT( static_cast< size_t >( compression ) < static_cast< size_t >( Texture::ECompression::MAX ) );
+
+    rMipLevels.Resize( 0 );
+    rJobCount = 0;
+
+    bool bIsNormalMap = Texture::IsNormalMapCompression( compression );
+    float gamma = ( bSrgb ? 2.2f : 1.0f );
+
+    // Generate the uncompressed mip chain up front.  nvtt quantizes each generated level to 8 bits per channel before
+    // handing it to the block compressor, so compressing these levels separately produces the same output as
+    // compressing the entire chain in a single pass.
+    MemoryTextureOutputHandler mipChainHandler( width, height, false, bCreateMipmaps );
+    if( bCreateMipmaps )
     {
-    case Texture::ECompression::NONE:
-        {
-            outputFormat = nvtt::Format_RGBA;
+        nvtt::InputOptions inputOptions;
+        inputOptions.setTextureLayout( nvtt::TextureType_2D, width, height );
+        inputOptions.setMipmapData( pPixelData, width, height );
+        inputOptions.setMipmapGeneration( true );
+        inputOptions.setMipmapFilter( nvtt::MipmapFilter_Box );
+        inputOptions.setWrapMode( nvtt::WrapMode_Repeat );
+        inputOptions.setGamma( gamma, gamma );
+        inputOptions.setNormalMap( bIsNormalMap );
+        inputOptions.setNormalizeMipmaps( bIsNormalMap );
+
+        nvtt::OutputOptions outputOptions;
+        outputOptions.setOutputHandler( &mipChainHandler );
+        outputOptions.setOutputHeader( false );
+
+        // Output the generated levels in the same layout as our BGRA source image.
+        nvtt::CompressionOptions compressionOptions;
+        compressionOptions.setFormat( nvtt::Format_RGBA );
 #if HELIUM_ENDIAN_LITTLE
-            compressionOptions.setPixelFormat( 32, 0xff000000, 0x00ff0000, 0x0000ff00, 0x000000ff );
+        compressionOptions.setPixelFormat( 32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000 );
 #else
-            compressionOptions.setPixelFormat( 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000 );
+        compressionOptions.setPixelFormat( 32, 0x0000ff00, 0x00ff0000, 0xff000000, 0x000000ff );
 #endif
-            pixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_R8G8B8A8_SRGB : RENDERER_PIXEL_FORMAT_R8G8B8A8 );
-
-            break;
-        }
+        compressionOptions.setQuality( nvtt::Quality_Normal );
 
-    case Texture::ECompression::COLOR:
+        nvtt::Compressor compressor;
+        if( !compressor.process( inputOptions, compressionOptions, outputOptions ) )
         {
-            outputFormat = ( bIgnoreAlpha ? nvtt::Format_BC1 : nvtt::Format_BC1a );
-            pixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_BC1_SRGB : RENDERER_PIXEL_FORMAT_BC1 );
-
-            break;
+            return false;
         }
+    }
 
-    case Texture::ECompression::COLOR_SHARP_ALPHA:
-        {
-            if( bIgnoreAlpha )
-            {
-                outputFormat = nvtt::Format_BC1;
-                pixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_BC1_SRGB : RENDERER_PIXEL_FORMAT_BC1 );
-            }
-            else
-            {
-                outputFormat = nvtt::Format_BC2;
-                pixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_BC2_SRGB : RENDERER_PIXEL_FORMAT_BC2 );
-            }
+    nvtt::CompressionOptions compressionOptions;
+    SetUpCompressionOptions( compression, bSrgb, bIgnoreAlpha, compressionOptions, rPixelFormat );
 
-            break;
-        }
+    // Split each mip level into bands and compress them in parallel on the shared worker pool.
+    WorkerPool* pWorkerPool = WorkerPool::GetStaticInstance();
+    HELIUM_ASSERT( pWorkerPool );
 
-    case Texture::ECompression::COLOR_SMOOTH_ALPHA:
-        {
-            if( bIgnoreAlpha )
-            {
-                outputFormat = nvtt::Format_BC1;
-                pixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_BC1_SRGB : RENDERER_PIXEL_FORMAT_BC1 );
-            }
-            else
-            {
-                outputFormat = nvtt::Format_BC3;
-                pixelFormat = ( bSrgb ? RENDERER_PIXEL_FORMAT_BC3_SRGB : RENDERER_PIXEL_FORMAT_BC3 );
-            }
+    uint32_t targetBandCount = static_cast< uint32_t >( pWorkerPool->GetWorkerCount() + 1 );
 
-            break;
-        }
+    TextureBandSet bandSet;
+    bandSet.pCompressionOptions = &compressionOptions;
+    bandSet.gamma = gamma;
+    bandSet.bNormalMap = bIsNormalMap;
 
-    case Texture::ECompression::NORMAL_MAP:
-        {
-            outputFormat = nvtt::Format_BC3n;
-            pixelFormat = RENDERER_PIXEL_FORMAT_BC3;
+    const MemoryTextureOutputHandler::MipLevelArray& rMipChain = mipChainHandler.GetFace( 0 );
+    uint32_t mipLevelCount = static_cast< uint32_t >( rMipChain.GetSize() );
+    HELIUM_ASSERT( mipLevelCount != 0 );
 
-            break;
-        }
+    for( uint32_t mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel )
+    {
+        uint32_t levelWidth = Max< uint32_t >( width >> mipLevel, 1 );
+        uint32_t levelHeight = Max< uint32_t >( height >> mipLevel, 1 );
 
-    case Texture::ECompression::NORMAL_MAP_COMPACT:
+        const uint8_t* pLevelPixelData = static_cast< const uint8_t* >( pPixelData );
+        if( mipLevel != 0 )
         {
-            outputFormat = nvtt::Format_BC1;
-            pixelFormat = RENDERER_PIXEL_FORMAT_BC1;
-
-            break;
+            const MemoryTextureOutputHandler::MipDataArray& rLevelData = rMipChain[ mipLevel ];
+            HELIUM_ASSERT( rLevelData.GetSize() == static_cast< size_t >( levelWidth ) * levelHeight * 4 );
+            pLevelPixelData = rLevelData.GetData();
         }
 
-    default:
-        break;
+        AddTextureBands( bandSet, pLevelPixelData, levelWidth, levelHeight, mipLevel, targetBandCount );
     }
 
-    compressionOptions.setFormat( outputFormat );
-    compressionOptions.setQuality( nvtt::Quality_Normal );
+    size_t bandCount = bandSet.bands.GetSize();
+    pWorkerPool->Run( CompressTextureBand, &bandSet, bandCount );
+    rJobCount = bandCount;
 
-    // Compress the texture.
-    nvtt::Compressor compressor;
-    bool bCompressSuccess = compressor.process( inputOptions, compressionOptions, outputOptions );
-    HELIUM_ASSERT( bCompressSuccess );
-    if( !bCompressSuccess )
+    // Assemble the compressed mip levels from the band data, in order.
+    rMipLevels.Resize( mipLevelCount );
+
+    for( size_t bandIndex = 0; bandIndex < bandCount; ++bandIndex )
     {
-        HELIUM_TRACE(
-            TraceLevels::Error,
-            ( TXT( "Texture2dResourceHandler::CacheResource(): Texture compression failed for texture image " )
-            TXT( "\"%s\".\n" ) ),
-            *rSourceFilePath );
+        const TextureBand& rBand = bandSet.bands[ bandIndex ];
+        HELIUM_ASSERT( rBand.bSuccess );
+        if( !rBand.bSuccess )
+        {
+            rMipLevels.Resize( 0 );
 
-        return false;
+            return false;
+        }
+
+        rMipLevels[ rBand.mipLevel ].AddArray( rBand.output.GetData(), rBand.output.GetSize() );
     }
 
-    // Cache the data for each supported platform.
-    const MemoryTextureOutputHandler::MipLevelArray& rMipLevels = outputHandler.GetFace( 0 );
-    uint32_t mipLevelCount = static_cast< uint32_t >( rMipLevels.GetSize() );
-    HELIUM_ASSERT( mipLevelCount != 0 );
+    return true;
+}
 
-    int32_t pixelFormatIndex = static_cast< int32_t >( pixelFormat );
+/// Compress a texture image and its mip chain in a single nvtt pass on the calling thread.
+///
+/// This is slower than CompressTexture(), and is provided for checking the banded compression output against.
+///
+/// @param[in]  pPixelData      32-bit BGRA texel data for the base level.
+/// @param[in]  width           Base level width, in texels.
+/// @param[in]  height          Base level height, in texels.
+/// @param[in]  compression     Texture compression setting.
+/// @param[in]  bSrgb           True if the texture is in sRGB color space.
+/// @param[in]  bCreateMipmaps  True to generate the full mip chain, false to compress only the base level.
+/// @param[in]  bIgnoreAlpha    True if the texture alpha channel can be ignored.
+/// @param[out] rMipLevels      Compressed data for each mip level.
+/// @param[out] rPixelFormat    Renderer pixel format of the compressed data.
+///
+/// @return  True if compression was successful, false if not.
+///
+/// @see CompressTexture()
+bool Texture2dResourceHandler::CompressTextureReference(
+    const void* pPixelData,
+    uint32_t width,
+    uint32_t height,
+    Texture::ECompression compression,
+    bool bSrgb,
+    bool bCreateMipmaps,
+    bool bIgnoreAlpha,
+    DynamicArray< DynamicArray< uint8_t > >& rMipLevels,
+    ERendererPixelFormat& rPixelFormat )
+{
+    HELIUM_ASSERT( pPixelData );
+    HELIUM_ASSERT( static_cast< size_t >( compression ) < static_cast< size_t >( Texture::ECompression::MAX ) );
 
-    StrongPtr< Texture2d::PersistentResourceData > persistentResourceData( new Texture2d::PersistentResourceData() );
-    persistentResourceData->m_baseLevelWidth = imageWidth;
-    persistentResourceData->m_baseLevelHeight = imageHeight;
-    persistentResourceData->m_mipCount = mipLevelCount;
-    persistentResourceData->m_pixelFormatIndex = pixelFormatIndex;
+    rMipLevels.Resize( 0 );
 
-    // Cache the data for each supported platform.
-    for ( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
-    {
-        PlatformPreprocessor* pPreprocessor = pAssetPreprocessor->GetPlatformPreprocessor(
-            static_cast< Cache::EPlatform >( platformIndex ) );
-        if ( !pPreprocessor )
-        {
-            continue;
-        }
+    bool bIsNormalMap = Texture::IsNormalMapCompression( compression );
+    float gamma = ( bSrgb ? 2.2f : 1.0f );
 
-        Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
-            static_cast< Cache::EPlatform >( platformIndex ) );
+    nvtt::InputOptions inputOptions;
+    inputOptions.setTextureLayout( nvtt::TextureType_2D, width, height );
+    inputOptions.setMipmapData( pPixelData, width, height );
+    inputOptions.setMipmapGeneration( bCreateMipmaps );
+    inputOptions.setMipmapFilter( nvtt::MipmapFilter_Box );
+    inputOptions.setWrapMode( nvtt::WrapMode_Repeat );
+    inputOptions.setGamma( gamma, gamma );
+    inputOptions.setNormalMap( bIsNormalMap );
+    inputOptions.setNormalizeMipmaps( bIsNormalMap );
 
-        SaveObjectToPersistentDataBuffer(persistentResourceData.Get(), rPreprocessedData.persistentDataBuffer);
+    nvtt::CompressionOptions compressionOptions;
+    SetUpCompressionOptions( compression, bSrgb, bIgnoreAlpha, compressionOptions, rPixelFormat );
 
-        rPreprocessedData.subDataBuffers = rMipLevels;
+    MemoryTextureOutputHandler outputHandler( width, height, false, bCreateMipmaps );
 
-        rPreprocessedData.bLoaded = true;
+    nvtt::OutputOptions outputOptions;
+    outputOptions.setOutputHandler( &outputHandler );
+    outputOptions.setOutputHeader( false );
+
+    nvtt::Compressor compressor;
+    if( !compressor.process( inputOptions, compressionOptions, outputOptions ) )
+    {
+        return false;
     }
 
+    rMipLevels = outputHandler.GetFace( 0 );
+
     return true;
 }
 
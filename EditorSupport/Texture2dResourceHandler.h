@@ -6,6 +6,8 @@
 
 #include "PcSupport/ResourceHandler.h"
 #include "Foundation/FilePath.h"
+#include "Graphics/Texture.h"
+#include "Rendering/RendererTypes.h"
 
 namespace Helium
 {
@@ -28,6 +30,19 @@ namespace Helium
 
         virtual bool CacheResource(
             AssetPreprocessor* pAssetPreprocessor, Resource* pResource, const String& rSourceFilePath );
+        virtual bool CanCacheResourceConcurrently() const;
+        //@}
+
+        /// @name Texture Compression
+        //@{
+        static bool CompressTexture(
+            const void* pPixelData, uint32_t width, uint32_t height, Texture::ECompression compression, bool bSrgb,
+            bool bCreateMipmaps, bool bIgnoreAlpha, DynamicArray< DynamicArray< uint8_t > >& rMipLevels,
+            ERendererPixelFormat& rPixelFormat, size_t& rJobCount );
+        static bool CompressTextureReference(
+            const void* pPixelData, uint32_t width, uint32_t height, Texture::ECompression compression, bool bSrgb,
+            bool bCreateMipmaps, bool bIgnoreAlpha, DynamicArray< DynamicArray< uint8_t > >& rMipLevels,
+            ERendererPixelFormat& rPixelFormat );
         //@}
     };
 }
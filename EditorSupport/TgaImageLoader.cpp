@@ -28,17 +28,13 @@ bool LoadImageData(
         rowStep = -rowStep;
     }
 
+    // Rows are handed to the reader whole so that runs of pixels can be read from the stream in bulk instead of one
+    // pixel at a time.
     for( uint32_t y = 0; y < height; ++y )
     {
-        uint8_t* pDestPixel = pRow;
-        for( uint32_t x = 0; x < width; ++x )
+        if( !rReader( pRow, width ) )
         {
-            if( !rReader( pDestPixel ) )
-            {
-                return false;
-            }
-
-            pDestPixel += bytesPerPixel;
+            return false;
         }
 
         pRow += rowStep;
@@ -59,11 +55,11 @@ public:
         HELIUM_ASSERT( bytesPerPixel != 0 );
     }
 
-    bool operator()( void* pDestPixel )
+    bool operator()( uint8_t* pDestPixels, uint32_t pixelCount )
     {
-        size_t readCount = m_pStream->Read( pDestPixel, m_bytesPerPixel, 1 );
+        size_t readCount = m_pStream->Read( pDestPixels, m_bytesPerPixel, pixelCount );
 
-        return ( readCount == 1 );
+        return ( readCount == pixelCount );
     }
 
 private:
@@ -87,43 +83,57 @@ public:
         MemoryZero( m_repeatColor, sizeof( m_repeatColor ) );
     }
 
-    bool operator()( void* pDestPixel )
+    bool operator()( uint8_t* pDestPixels, uint32_t pixelCount )
     {
-        uint8_t count = m_packetHeader.count;
-        if( count == 0 )
+        // Packets may span multiple rows, so the number of pixels remaining in the current packet is carried over
+        // between calls in the packet header count.
+        while( pixelCount != 0 )
         {
-            if( m_pStream->Read( &m_packetHeader, sizeof( m_packetHeader ), 1 ) != 1 )
+            uint32_t count = m_packetHeader.count;
+            if( count == 0 )
             {
-                return false;
+                if( m_pStream->Read( &m_packetHeader, sizeof( m_packetHeader ), 1 ) != 1 )
+                {
+                    return false;
+                }
+
+                if( m_packetHeader.bRun )
+                {
+                    if( m_pStream->Read( m_repeatColor, m_bytesPerPixel, 1 ) != 1 )
+                    {
+                        return false;
+                    }
+                }
+
+                // Count values in RLE packet headers are one less than the actual count, so add one to it here.
+                // Since at least one pixel is always consumed below, the remaining count always fits back into the
+                // header.
+                count = m_packetHeader.count + 1;
             }
 
+            uint32_t packetPixelCount = Min( count, pixelCount );
+
             if( m_packetHeader.bRun )
             {
-                if( m_pStream->Read( m_repeatColor, m_bytesPerPixel, 1 ) != 1 )
+                for( uint32_t pixelIndex = 0; pixelIndex < packetPixelCount; ++pixelIndex )
                 {
-                    return false;
+                    MemoryCopy( pDestPixels, m_repeatColor, m_bytesPerPixel );
+                    pDestPixels += m_bytesPerPixel;
                 }
             }
-
-            // Count values in RLE packet headers are one less than the actual count, so add one to it here.  Since
-            // we always decrement the count at the end of each iteration, we don't need to worry about the count
-            // wrapping to zero.
-            count = m_packetHeader.count + 1;
-        }
-
-        if( m_packetHeader.bRun )
-        {
-            MemoryCopy( pDestPixel, m_repeatColor, m_bytesPerPixel );
-        }
-        else
-        {
-            if( m_pStream->Read( pDestPixel, m_bytesPerPixel, 1 ) != 1 )
+            else
             {
-                return false;
+                if( m_pStream->Read( pDestPixels, m_bytesPerPixel, packetPixelCount ) != packetPixelCount )
+                {
+                    return false;
+                }
+
+                pDestPixels += static_cast< size_t >( packetPixelCount ) * m_bytesPerPixel;
             }
-        }
 
-        m_packetHeader.count = count - 1;
+            m_packetHeader.count = static_cast< uint8_t >( count - packetPixelCount );
+            pixelCount -= packetPixelCount;
+        }
 
         return true;
     }
@@ -111,7 +111,8 @@ void AssetAwareThreadSynchronizer::DecrementLockedThreadCount()
 //////////////////////////////////////////////////////////////////////////
 
 uint32_t Asset::s_DefaultPointerFlags = Reflect::FieldFlags::Share;
-SparseArray< AssetWPtr > Asset::sm_objects;
+Asset::ObjectTableShard Asset::sm_objectTableShards[ Asset::OBJECT_TABLE_SHARD_COUNT ];
+Asset::ChildLookupShard Asset::sm_childLookupShards[ Asset::CHILD_LOOKUP_SHARD_COUNT ];
 AssetWPtr Asset::sm_wpFirstTopLevelObject;
 
 Asset::ChildNameInstanceIndexMap* Asset::sm_pNameInstanceIndexMap = NULL;
@@ -308,20 +309,23 @@ bool Asset::Rename( const RenameParameters& rParameters )
 			}
 			else
 			{
-				// Check each child of the new owner for a name clash.
-				for( Asset* pChild = rwpOwnerFirstChild; pChild != NULL; pChild = pChild->m_wpNextSibling )
+				// Check the child lookup of the new owner for a name clash.
+				ChildLookupKey key;
+				key.pOwner = pOwner;
+				key.name = name;
+				key.instanceIndex = instanceIndex;
+
+				Asset* pExistingChild = FindChildLookup( key );
+				if( pExistingChild && pExistingChild != this )
 				{
-					if( pChild->m_name == name && pChild->m_instanceIndex == instanceIndex )
-					{
-						HELIUM_TRACE(
-							TraceLevels::Error,
-							( TXT( "Asset::Rename(): Object already exists with the specified owner (%s) and " )
-							  TXT( "name (%s).\n" ) ),
-							( pOwner ? *pOwner->GetPath().ToString() : TXT( "none" ) ),
-							*name );
-
-						return false;
-					}
+					HELIUM_TRACE(
+						TraceLevels::Error,
+						( TXT( "Asset::Rename(): Object already exists with the specified owner (%s) and " )
+						  TXT( "name (%s).\n" ) ),
+						( pOwner ? *pOwner->GetPath().ToString() : TXT( "none" ) ),
+						*name );
+
+					return false;
 				}
 			}
 		}
@@ -394,11 +398,22 @@ bool Asset::Rename( const RenameParameters& rParameters )
 			}
 		}
 
+		// Move the child lookup entry for this object to its new path name.
+		if( !m_name.IsEmpty() )
+		{
+			RemoveChildLookup( spOldOwner, this );
+		}
+
 		// Set the new path name.
 		m_name = name;
 		m_spOwner = pOwner;
 		m_instanceIndex = instanceIndex;
 
+		if( !name.IsEmpty() )
+		{
+			AddChildLookup( pOwner, this );
+		}
+
 		// Update path information for this object and its children.
 		UpdatePath();
 	}
@@ -686,42 +701,48 @@ void Asset::ReplaceAsset( Asset* pNewAsset, const AssetPath &objectToReplace )
 	DynamicArray<AssetFixup> fixups;
 
 	// For every asset in existence
-	for ( SparseArray< AssetWPtr >::Iterator iter = sm_objects.Begin();
-		iter != sm_objects.End(); ++iter)
+	for ( uint32_t shardIndex = 0; shardIndex < OBJECT_TABLE_SHARD_COUNT; ++shardIndex )
 	{
-		if ( !iter )
-		{
-			continue;
-		}
+		ObjectTableShard& rShard = sm_objectTableShards[ shardIndex ];
+		ScopeReadLock shardLock( rShard.lock );
 
-		Asset* pPossibleFixupAsset = iter->Get();
-		if ( !pPossibleFixupAsset || pPossibleFixupAsset->IsDefaultTemplate() )
+		for ( SparseArray< AssetWPtr >::Iterator iter = rShard.objects.Begin();
+			iter != rShard.objects.End(); ++iter)
 		{
-			continue;
-		}
+			if ( !iter )
+			{
+				continue;
+			}
 
-		// Ignore it if it's the asset we're swapping
-		if ( pPossibleFixupAsset->m_id == pNewAsset->m_id || pPossibleFixupAsset->m_id == pOldAsset->m_id )
-		{
-			continue;
-		}
-		
-		// If the asset has the old asset as a template (direct or indirect)
-		Asset *pTemplate = pPossibleFixupAsset->GetTemplateAsset().Get();
-		
-		while ( pTemplate && !pTemplate->IsDefaultTemplate() )
-		{
-			if ( pTemplate == pOldAsset )
+			Asset* pPossibleFixupAsset = iter->Get();
+			if ( !pPossibleFixupAsset || pPossibleFixupAsset->IsDefaultTemplate() )
 			{
-				// Then save it off
-				// TODO: Does order matter? Right now we probably want bases first so that changes ripple down the template
-				// tree but in future we should probably have a flag of some sort to say if a field is set or not. Maybe in tools only.
-				AssetFixup &fixup = *fixups.New();
-				fixup.pAsset = pPossibleFixupAsset;
-				break;
+				continue;
+			}
+
+			// Ignore it if it's the asset we're swapping
+			if ( pPossibleFixupAsset->m_id == pNewAsset->m_id || pPossibleFixupAsset->m_id == pOldAsset->m_id )
+			{
+				continue;
 			}
+			
+			// If the asset has the old asset as a template (direct or indirect)
+			Asset *pTemplate = pPossibleFixupAsset->GetTemplateAsset().Get();
+			
+			while ( pTemplate && !pTemplate->IsDefaultTemplate() )
+			{
+				if ( pTemplate == pOldAsset )
+				{
+					// Then save it off
+					// TODO: Does order matter? Right now we probably want bases first so that changes ripple down the template
+					// tree but in future we should probably have a flag of some sort to say if a field is set or not. Maybe in tools only.
+					AssetFixup &fixup = *fixups.New();
+					fixup.pAsset = pPossibleFixupAsset;
+					break;
+				}
 
-			pTemplate = pTemplate->GetTemplateAsset().Get();
+				pTemplate = pTemplate->GetTemplateAsset().Get();
+			}
 		}
 	}
 
@@ -787,6 +808,22 @@ void Asset::ReplaceAsset( Asset* pNewAsset, const AssetPath &objectToReplace )
 		}
 	}
 
+	// Pull both assets and their children out of the child lookup while their path names are swapped.
+	Asset* pSwapAssets[] = { pOldAsset, pNewAsset };
+	for ( size_t swapIndex = 0; swapIndex < HELIUM_ARRAY_COUNT( pSwapAssets ); ++swapIndex )
+	{
+		Asset* pSwapAsset = pSwapAssets[ swapIndex ];
+		if ( !pSwapAsset->m_name.IsEmpty() )
+		{
+			RemoveChildLookup( pSwapAsset->m_spOwner, pSwapAsset );
+		}
+
+		for ( Asset* pChild = pSwapAsset->m_wpFirstChild; pChild != NULL; pChild = pChild->m_wpNextSibling )
+		{
+			RemoveChildLookup( pSwapAsset, pChild );
+		}
+	}
+
 	pNewAsset->RefCountSwapProxies( pOldAsset );
 	Helium::Swap( pOldAsset->m_name, pNewAsset->m_name );
 	Helium::Swap( pOldAsset->m_instanceIndex, pNewAsset->m_instanceIndex );
@@ -795,6 +832,21 @@ void Asset::ReplaceAsset( Asset* pNewAsset, const AssetPath &objectToReplace )
 	Helium::Swap( pOldAsset->m_spOwner, pNewAsset->m_spOwner );
 	Helium::Swap( pOldAsset->m_wpFirstChild, pNewAsset->m_wpFirstChild );
 	Helium::Swap( pOldAsset->m_wpNextSibling, pNewAsset->m_wpNextSibling );
+
+	// Children are looked up through the asset whose child list they are now in.
+	for ( size_t swapIndex = 0; swapIndex < HELIUM_ARRAY_COUNT( pSwapAssets ); ++swapIndex )
+	{
+		Asset* pSwapAsset = pSwapAssets[ swapIndex ];
+		if ( !pSwapAsset->m_name.IsEmpty() )
+		{
+			AddChildLookup( pSwapAsset->m_spOwner, pSwapAsset );
+		}
+
+		for ( Asset* pChild = pSwapAsset->m_wpFirstChild; pChild != NULL; pChild = pChild->m_wpNextSibling )
+		{
+			AddChildLookup( pSwapAsset, pChild );
+		}
+	}
 }
 
 #endif  // HELIUM_TOOLS
@@ -1059,19 +1111,12 @@ Asset* Asset::FindChildOf( const Asset* pObject, Name name, uint32_t instanceInd
 		return NULL;
 	}
 
-	ScopeReadLock scopeLock( sm_objectListLock );
-
-	for( Asset* pChild = ( pObject ? pObject->m_wpFirstChild : sm_wpFirstTopLevelObject );
-		 pChild != NULL;
-		 pChild = pChild->m_wpNextSibling )
-	{
-		if( pChild->GetName() == name && pChild->GetInstanceIndex() == instanceIndex )
-		{
-			return pChild;
-		}
-	}
+	ChildLookupKey key;
+	key.pOwner = pObject;
+	key.name = name;
+	key.instanceIndex = instanceIndex;
 
-	return NULL;
+	return FindChildLookup( key );
 }
 
 /// Search for a child or grandchild of the given object with a relative path dictated by the given parameters.
@@ -1152,13 +1197,20 @@ bool Asset::RegisterObject( Asset* pObject )
 {
 	HELIUM_ASSERT( pObject );
 
-	ScopeWriteLock scopeLock( sm_objectListLock );
+	// Pick the object table shard from the object address so that concurrent registrations rarely contend.
+	uint32_t shardIndex = static_cast< uint32_t >(
+		( reinterpret_cast< uintptr_t >( pObject ) >> 6 ) & ( OBJECT_TABLE_SHARD_COUNT - 1 ) );
 
 	// Check if the object has already been registered.
 	if( IsValid( pObject->m_id ) )
 	{
-		HELIUM_ASSERT( sm_objects.IsElementValid( pObject->m_id ) );
-		HELIUM_ASSERT( sm_objects[ pObject->m_id ].Get() == pObject );
+#if HELIUM_ASSERT_ENABLED
+		ObjectTableShard& rRegisteredShard = sm_objectTableShards[ pObject->m_id & ( OBJECT_TABLE_SHARD_COUNT - 1 ) ];
+		ScopeReadLock registeredShardLock( rRegisteredShard.lock );
+		size_t registeredIndex = pObject->m_id / OBJECT_TABLE_SHARD_COUNT;
+		HELIUM_ASSERT( rRegisteredShard.objects.IsElementValid( registeredIndex ) );
+		HELIUM_ASSERT( rRegisteredShard.objects[ registeredIndex ].Get() == pObject );
+#endif
 
 		HELIUM_TRACE(
 			TraceLevels::Warning,
@@ -1172,11 +1224,14 @@ bool Asset::RegisterObject( Asset* pObject )
 	HELIUM_ASSERT( !pObject->m_spOwner );
 	HELIUM_ASSERT( IsInvalid( pObject->m_instanceIndex ) );
 
-	// Register the object.
-	size_t objectId = sm_objects.Add( AssetWPtr( pObject ) );
-	HELIUM_ASSERT( objectId < UINT32_MAX );
+	// Register the object.  Object IDs interleave the shards, so the shard index is kept in the lowest bits.
+	ObjectTableShard& rShard = sm_objectTableShards[ shardIndex ];
+	ScopeWriteLock shardLock( rShard.lock );
 
-	pObject->m_id = static_cast< uint32_t >( objectId );
+	size_t shardObjectIndex = rShard.objects.Add( AssetWPtr( pObject ) );
+	HELIUM_ASSERT( shardObjectIndex < UINT32_MAX / OBJECT_TABLE_SHARD_COUNT );
+
+	pObject->m_id = static_cast< uint32_t >( shardObjectIndex ) * OBJECT_TABLE_SHARD_COUNT + shardIndex;
 
 	return true;
 }
@@ -1190,8 +1245,6 @@ void Asset::UnregisterObject( Asset* pObject )
 {
 	HELIUM_ASSERT( pObject );
 
-	ScopeWriteLock scopeLock( sm_objectListLock );
-
 	// Check if the object has already been unregistered.
 	uint32_t objectId = pObject->m_id;
 	if( IsInvalid( objectId ) )
@@ -1204,17 +1257,21 @@ void Asset::UnregisterObject( Asset* pObject )
 		return;
 	}
 
-	if ( sm_objects.GetSize() ) // will be empty if already shutdown
+	ObjectTableShard& rShard = sm_objectTableShards[ objectId & ( OBJECT_TABLE_SHARD_COUNT - 1 ) ];
+	ScopeWriteLock shardLock( rShard.lock );
+
+	if ( rShard.objects.GetSize() ) // will be empty if already shutdown
 	{
-		HELIUM_ASSERT( sm_objects.IsElementValid( objectId ) );
-		HELIUM_ASSERT( sm_objects[ objectId ].HasObjectProxy( pObject ) );
+		size_t shardObjectIndex = objectId / OBJECT_TABLE_SHARD_COUNT;
+		HELIUM_ASSERT( rShard.objects.IsElementValid( shardObjectIndex ) );
+		HELIUM_ASSERT( rShard.objects[ shardObjectIndex ].HasObjectProxy( pObject ) );
 
 		HELIUM_ASSERT( pObject->m_name.IsEmpty() );
 		HELIUM_ASSERT( !pObject->m_spOwner );
 		HELIUM_ASSERT( IsInvalid( pObject->m_instanceIndex ) );
 
 		// Remove the object from the global list.
-		sm_objects.Remove( objectId );
+		rShard.objects.Remove( shardObjectIndex );
 	}
 
 	SetInvalid( pObject->m_id );
@@ -1231,7 +1288,12 @@ void Asset::Shutdown()
 	HELIUM_TRACE( TraceLevels::Info, TXT( "Shutting down Asset system.\n" ) );
 	
 #if !HELIUM_RELEASE
-	size_t objectCountActual = sm_objects.GetUsedSize();
+	size_t objectCountActual = 0;
+	for( uint32_t shardIndex = 0; shardIndex < OBJECT_TABLE_SHARD_COUNT; ++shardIndex )
+	{
+		objectCountActual += sm_objectTableShards[ shardIndex ].objects.GetUsedSize();
+	}
+
 	if( objectCountActual != 0 )
 	{
 		HELIUM_TRACE(
@@ -1239,39 +1301,55 @@ void Asset::Shutdown()
 			TXT( "%" ) PRIuSZ TXT( " asset(s) still referenced during shutdown!\n" ),
 			objectCountActual );
 
-		size_t objectCount = sm_objects.GetSize();
-		for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+		for( uint32_t shardIndex = 0; shardIndex < OBJECT_TABLE_SHARD_COUNT; ++shardIndex )
 		{
-			if( !sm_objects.IsElementValid( objectIndex ) )
-			{
-				continue;
-			}
+			SparseArray< AssetWPtr >& rObjects = sm_objectTableShards[ shardIndex ].objects;
 
-			Asset* pObject = sm_objects[ objectIndex ];
-			if( !pObject )
+			size_t objectCount = rObjects.GetSize();
+			for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
 			{
-				continue;
-			}
+				if( !rObjects.IsElementValid( objectIndex ) )
+				{
+					continue;
+				}
+
+				Asset* pObject = rObjects[ objectIndex ];
+				if( !pObject )
+				{
+					continue;
+				}
 			
 #if HELIUM_ENABLE_MEMORY_TRACKING
-			Helium::RefCountProxy<Reflect::Object> *pProxy = pObject->GetRefCountProxy();
-			HELIUM_ASSERT(pProxy);
-
-			HELIUM_TRACE(
-					TraceLevels::Error,
-					TXT( "   - 0x%p: %s (%" ) PRIu16 TXT( " strong ref(s), %" ) PRIu16 TXT( " weak ref(s))\n" ),
-					 pProxy,
-					( pObject ? *pObject->GetPath().ToString() : TXT( "(cleared reference)" ) ),
-					pProxy->GetStrongRefCount(),
-					pProxy->GetWeakRefCount() );
+				Helium::RefCountProxy<Reflect::Object> *pProxy = pObject->GetRefCountProxy();
+				HELIUM_ASSERT(pProxy);
+
+				HELIUM_TRACE(
+						TraceLevels::Error,
+						TXT( "   - 0x%p: %s (%" ) PRIu16 TXT( " strong ref(s), %" ) PRIu16 TXT( " weak ref(s))\n" ),
+						 pProxy,
+						( pObject ? *pObject->GetPath().ToString() : TXT( "(cleared reference)" ) ),
+						pProxy->GetStrongRefCount(),
+						pProxy->GetWeakRefCount() );
 #else
-			HELIUM_TRACE( TraceLevels::Error, TXT( "- %s\n" ), *pObject->GetPath().ToString() );
+				HELIUM_TRACE( TraceLevels::Error, TXT( "- %s\n" ), *pObject->GetPath().ToString() );
 #endif
+			}
 		}
 	}
 #endif  // !HELIUM_RELEASE
 
-	sm_objects.Clear();
+	for( uint32_t shardIndex = 0; shardIndex < OBJECT_TABLE_SHARD_COUNT; ++shardIndex )
+	{
+		sm_objectTableShards[ shardIndex ].objects.Clear();
+	}
+
+	for( uint32_t shardIndex = 0; shardIndex < CHILD_LOOKUP_SHARD_COUNT; ++shardIndex )
+	{
+		ChildLookupShard& rShard = sm_childLookupShards[ shardIndex ];
+		delete rShard.pMap;
+		rShard.pMap = NULL;
+	}
+
 	sm_wpFirstTopLevelObject.Release();
 
 	delete sm_pNameInstanceIndexMap;
@@ -1435,6 +1513,140 @@ Asset::ChildNameInstanceIndexMap& Asset::GetNameInstanceIndexMap()
 	return *sm_pNameInstanceIndexMap;
 }
 
+/// Get the child lookup shard responsible for a given key.
+///
+/// @param[in] rKey  Child lookup key.
+///
+/// @return  Reference to the child lookup shard.
+Asset::ChildLookupShard& Asset::GetChildLookupShard( const ChildLookupKey& rKey )
+{
+	// Use the upper bits of a scrambled hash so that shard selection is independent of the hash map bucket index.
+	size_t hash = ChildLookupKeyHash()( rKey ) * static_cast< size_t >( 2654435761U );
+	size_t shardIndex = ( hash >> 16 ) & ( CHILD_LOOKUP_SHARD_COUNT - 1 );
+
+	return sm_childLookupShards[ shardIndex ];
+}
+
+/// Look up an object by owner, name, and instance index.
+///
+/// @param[in] rKey  Child lookup key.
+///
+/// @return  Pointer to the object if found, null if not found.
+Asset* Asset::FindChildLookup( const ChildLookupKey& rKey )
+{
+	ChildLookupShard& rShard = GetChildLookupShard( rKey );
+	ScopeReadLock shardLock( rShard.lock );
+
+	ChildLookupMap* pMap = rShard.pMap;
+	if( !pMap )
+	{
+		return NULL;
+	}
+
+	ChildLookupMap::ConstIterator childIterator = pMap->Find( rKey );
+	if( childIterator == pMap->End() )
+	{
+		return NULL;
+	}
+
+	return childIterator->Second();
+}
+
+/// Add an object to the child lookup using its current name and instance index.
+///
+/// This should only be called while holding a write lock on the object list.
+///
+/// @param[in] pOwner   Owner in whose child list the object is stored (null for top-level objects).
+/// @param[in] pObject  Object to add.
+///
+/// @see RemoveChildLookup()
+void Asset::AddChildLookup( const Asset* pOwner, Asset* pObject )
+{
+	HELIUM_ASSERT( pObject );
+	HELIUM_ASSERT( !pObject->m_name.IsEmpty() );
+
+	ChildLookupKey key;
+	key.pOwner = pOwner;
+	key.name = pObject->m_name;
+	key.instanceIndex = pObject->m_instanceIndex;
+
+	ChildLookupShard& rShard = GetChildLookupShard( key );
+	ScopeWriteLock shardLock( rShard.lock );
+
+	if( !rShard.pMap )
+	{
+		rShard.pMap = new ChildLookupMap;
+		HELIUM_ASSERT( rShard.pMap );
+	}
+
+	ChildLookupMap::Iterator childIterator;
+	if( !rShard.pMap->Insert( childIterator, KeyValue< ChildLookupKey, Asset* >( key, pObject ) ) )
+	{
+		HELIUM_ASSERT_MSG(
+			childIterator->Second() == pObject,
+			TXT( "Asset::AddChildLookup(): Path name is already mapped to another object." ) );
+		childIterator->Second() = pObject;
+	}
+}
+
+/// Remove an object from the child lookup using its current name and instance index.
+///
+/// This should only be called while holding a write lock on the object list.  Nothing is removed if the lookup entry
+/// for the object's path name belongs to a different object.
+///
+/// @param[in] pOwner   Owner in whose child list the object is stored (null for top-level objects).
+/// @param[in] pObject  Object to remove.
+///
+/// @see AddChildLookup()
+void Asset::RemoveChildLookup( const Asset* pOwner, const Asset* pObject )
+{
+	HELIUM_ASSERT( pObject );
+
+	ChildLookupKey key;
+	key.pOwner = pOwner;
+	key.name = pObject->m_name;
+	key.instanceIndex = pObject->m_instanceIndex;
+
+	ChildLookupShard& rShard = GetChildLookupShard( key );
+	ScopeWriteLock shardLock( rShard.lock );
+
+	ChildLookupMap* pMap = rShard.pMap;
+	if( pMap )
+	{
+		ChildLookupMap::Iterator childIterator = pMap->Find( key );
+		if( childIterator != pMap->End() && childIterator->Second() == pObject )
+		{
+			pMap->Remove( key );
+		}
+	}
+}
+
+/// Equality comparison operator.
+///
+/// @param[in] rOther  Key with which to compare.
+///
+/// @return  True if this key and the given key match, false if not.
+bool Asset::ChildLookupKey::operator==( const ChildLookupKey& rOther ) const
+{
+	return ( pOwner == rOther.pOwner && name == rOther.name && instanceIndex == rOther.instanceIndex );
+}
+
+/// Compute a hash value for the given child lookup key.
+///
+/// Names are pooled, so the name string address is hashed instead of its contents.
+///
+/// @param[in] rKey  Child lookup key.
+///
+/// @return  Hash value for the given key.
+size_t Asset::ChildLookupKeyHash::operator()( const ChildLookupKey& rKey ) const
+{
+	size_t hash = static_cast< size_t >( reinterpret_cast< uintptr_t >( rKey.pOwner ) >> 4 );
+	hash = ( ( hash * 33 ) ^ static_cast< size_t >( reinterpret_cast< uintptr_t >( rKey.name.GetDirect() ) >> 2 ) );
+	hash = ( ( hash * 33 ) ^ rKey.instanceIndex );
+
+	return hash;
+}
+
 AssetRegistrar< Asset, void > Asset::s_Registrar(TXT("Helium::Asset"));
 
 
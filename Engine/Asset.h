@@ -379,6 +379,63 @@ namespace Helium
 		/// Child object name instance lookup map type.
 		typedef ConcurrentHashMap< AssetPath, NameInstanceIndexMap > ChildNameInstanceIndexMap;
 
+		/// Number of global object table shards (must be a power of two).
+		static const uint32_t OBJECT_TABLE_SHARD_COUNT = 16;
+		/// Number of child object lookup shards (must be a power of two).
+		static const uint32_t CHILD_LOOKUP_SHARD_COUNT = 64;
+
+		/// Child object lookup key.
+		struct ChildLookupKey
+		{
+			/// Owner object (null for top-level objects).
+			const Asset* pOwner;
+			/// Object name.
+			Name name;
+			/// Object instance index.
+			uint32_t instanceIndex;
+
+			/// @name Overloaded Operators
+			//@{
+			bool operator==( const ChildLookupKey& rOther ) const;
+			//@}
+		};
+
+		/// Child object lookup key hasher.
+		class ChildLookupKeyHash
+		{
+		public:
+			/// @name Hash Calculation
+			//@{
+			size_t operator()( const ChildLookupKey& rKey ) const;
+			//@}
+		};
+
+		/// Child object lookup map type.
+		typedef HashMap< ChildLookupKey, Asset*, ChildLookupKeyHash > ChildLookupMap;
+
+		/// Portion of the global object list, with its own lock.
+		struct ObjectTableShard
+		{
+			/// Objects registered in this shard.
+			SparseArray< AssetWPtr > objects;
+			/// Read-write lock for synchronizing access to this shard.
+			ReadWriteLock lock;
+		};
+
+		/// Portion of the child object lookup, with its own lock.
+		struct ChildLookupShard
+		{
+			/// Child object lookup map (allocated on first use).
+			ChildLookupMap* pMap;
+			/// Read-write lock for synchronizing access to this shard.
+			ReadWriteLock lock;
+
+			/// @name Construction/Destruction
+			//@{
+			ChildLookupShard() : pMap( NULL ) {}
+			//@}
+		};
+
 		/// Object name.
 		Name m_name;
 		/// Instance index.
@@ -404,8 +461,10 @@ namespace Helium
 		/// (provided for custom object allocation schemes).
 		CUSTOM_DESTROY_CALLBACK* m_pCustomDestroyCallback;
 
-		/// Global object list.
-		static SparseArray< AssetWPtr > sm_objects;
+		/// Global object list, split into shards by object address (object IDs interleave the shards).
+		static ObjectTableShard sm_objectTableShards[ OBJECT_TABLE_SHARD_COUNT ];
+		/// Child object lookup by owner, name, and instance index, split into shards by key hash.
+		static ChildLookupShard sm_childLookupShards[ CHILD_LOOKUP_SHARD_COUNT ];
 		/// First object in the list of top-level objects.
 		static AssetWPtr sm_wpFirstTopLevelObject;
 
@@ -416,7 +475,8 @@ namespace Helium
 		/// Empty name instance index lookup set.
 		static Pair< Name, InstanceIndexSet >* sm_pEmptyInstanceIndexSet;
 
-		/// Read-write lock for synchronizing access to the object lists.
+		/// Read-write lock for synchronizing changes to object names and owners (object registration and child object
+		/// lookups are synchronized by the object table and child lookup shard locks).
 		static ReadWriteLock sm_objectListLock;
 
 		/// Cached serialization buffer.
@@ -435,6 +495,11 @@ namespace Helium
 		/// @name Static Asset Management
 		//@{
 		static ChildNameInstanceIndexMap& GetNameInstanceIndexMap();
+
+		static ChildLookupShard& GetChildLookupShard( const ChildLookupKey& rKey );
+		static Asset* FindChildLookup( const ChildLookupKey& rKey );
+		static void AddChildLookup( const Asset* pOwner, Asset* pObject );
+		static void RemoveChildLookup( const Asset* pOwner, const Asset* pObject );
 		//@}
 	};
 
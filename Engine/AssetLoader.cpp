@@ -2,9 +2,12 @@
 #include "Engine/AssetLoader.h"
 
 #include "Platform/Thread.h"
+#include "Platform/Timer.h"
 #include "Engine/Asset.h"
+#include "Engine/AsyncLoader.h"
 #include "Engine/PackageLoader.h"
 #include "Engine/FileLocations.h"
+#include "Engine/FrameProfiler.h"
 
 /// Asset cache name.
 
@@ -12,6 +15,14 @@ using namespace Helium;
 
 AssetLoader* AssetLoader::sm_pInstance = NULL;
 
+const float32_t AssetLoader::DEFAULT_MAIN_THREAD_BUDGET = 2.0f;
+
+/// Maximum time the load thread sleeps while idle before synchronizing with other asset-aware threads, in milliseconds.
+static const uint32_t LOAD_THREAD_IDLE_WAIT_TIME = 100;
+/// Maximum time the load thread sleeps while requests are pending before checking on them again, in milliseconds (the
+/// thread is woken up sooner when a file read completes).
+static const uint32_t LOAD_THREAD_PENDING_WAIT_TIME = 1;
+
 #if HELIUM_TOOLS
 AssetTracker* AssetTracker::sm_pInstance = NULL;
 #endif
@@ -19,16 +30,27 @@ AssetTracker* AssetTracker::sm_pInstance = NULL;
 /// Constructor.
 AssetLoader::AssetLoader()
 : m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
+, m_loadThreadWakeUpCondition( false, false )
+, m_loadThreadStopCounter( 0 )
+, m_loadThreadRunningCounter( 0 )
+, m_mainThreadBudget( DEFAULT_MAIN_THREAD_BUDGET )
+, m_mainThreadTickOffset( 0 )
 {
 }
 
 /// Destructor.
 AssetLoader::~AssetLoader()
 {
+	// Subclasses should stop the load thread prior to releasing their package loaders.
+	HELIUM_ASSERT( m_loadThreadRunningCounter == 0 );
+	StopLoadThread();
 }
 
 /// Begin asynchronous loading of an object.
 ///
+/// This does not block on the background load thread.  While the load thread is running, a path with no matching
+/// package loader is reported as a failed load once the request completes instead of through the return value.
+///
 /// @param[in] path  Asset path.
 ///
 /// @return  ID for the load request if started successfully, invalid index if not.
@@ -73,9 +95,11 @@ size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
 				TXT( "AssetLoader::BeginLoadObject(): Object \"%s\" already loaded.\n" ),
 				*path.ToString() );
 	} 
-	else
+	else if( m_loadThreadRunningCounter == 0 )
 	{
-		// Get the package loader to use for the given object.
+		// Get the package loader to use for the given object.  While the load thread is running, it holds the package
+		// loader lock for the duration of deserialization, so the lookup is left to TickPreload() on the load thread
+		// instead of stalling the calling thread here.
 		pPackageLoader = GetPackageLoader( path );
 		if( !pPackageLoader )
 		{
@@ -104,9 +128,17 @@ size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
 	ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor requestAccessor;
 	if( m_loadRequestMap.Insert( requestAccessor, KeyValue< AssetPath, LoadRequest* >( path, pRequest ) ) )
 	{
-		// New load request was created, so tick it once to get the load process running.
+		// New load request was created, so tick it once to get the load process running (or let the load thread know
+		// it has work to do if it is handling the early load stages).
 		requestAccessor.Release();
-		TickLoadRequest( pRequest );
+		if( m_loadThreadRunningCounter != 0 )
+		{
+			m_loadThreadWakeUpCondition.Signal();
+		}
+		else
+		{
+			TickLoadRequest( pRequest );
+		}
 	}
 	else
 	{
@@ -240,9 +272,9 @@ bool AssetLoader::LoadObject( AssetPath path, AssetPtr& rspObject, bool forceRel
 #if HELIUM_TOOLS
 /// Cache an object if it has been modified on disk.
 ///
-/// The object will be cached based on the current timestamp of its source package file and, if one exists, its
+/// The object will be cached based on the current contents of its source package file and, if one exists, its
 /// source resource file.  As such, if changes have been made in memory to an object also stored in a source
-/// package, it is recommended to save the changes to the source package first so that its updated timestamp will be
+/// package, it is recommended to save the changes to the source package first so that its updated contents will be
 /// used in the cache.
 ///
 /// @param[in] pObject                                 Asset to cache.
@@ -263,63 +295,111 @@ bool AssetLoader::CacheObject( Asset* /*pObject*/, bool /*bEvictPlatformPreproce
 #endif  // HELIUM_TOOLS
 
 /// Update object loading.
+///
+/// If the background load thread is running, only the load stages that must be performed on the main thread
+/// (resource precaching and load finalization) are updated here, and only for as long as the main thread budget
+/// allows.  Otherwise, all package loaders and load stages are updated.
+///
+/// @see SetMainThreadBudget(), StartLoadThread()
 void AssetLoader::Tick()
 {
+	HELIUM_FRAME_PROFILE_SCOPE( "AssetLoader::Tick" );
+
+	if( m_loadThreadRunningCounter != 0 )
+	{
+		TickLoadRequests( LOAD_STAGE_MAIN_THREAD, m_mainThreadBudget );
+
+		return;
+	}
+
 	// Tick package loaders first.
 	TickPackageLoaders();
 
-	// Build the list of object load requests to update this tick, incrementing the request count on each to prevent
-	// them from being released while we don't have a lock on the request hash map.
-	//HELIUM_ASSERT( m_loadRequestTickArray.IsEmpty() );
-	/// List of load requests to update in the current tick.
-	DynamicArray< LoadRequest* > m_loadRequestTickArray;
+	TickLoadRequests( LOAD_STAGE_ALL, 0.0f );
+}
 
-	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor loadRequestConstAccessor;
-	if( m_loadRequestMap.First( loadRequestConstAccessor ) )
+/// Start the background load thread.
+///
+/// Once running, package loader updates, object deserialization, reference linking and pre-precaching work are
+/// performed on the load thread, while Tick() only performs the load stages that must run on the main thread.  Package
+/// loaders should not be accessed directly from other threads while the load thread is running.
+///
+/// @see StopLoadThread(), IsLoadThreadRunning()
+void AssetLoader::StartLoadThread()
+{
+	if( m_loadThreadRunningCounter != 0 )
 	{
-		do
-		{
-			LoadRequest* pRequest = loadRequestConstAccessor->Second();
-			HELIUM_ASSERT( pRequest );
-			AtomicIncrementUnsafe( pRequest->requestCount );
-			m_loadRequestTickArray.Add( pRequest );
+		return;
+	}
 
-			++loadRequestConstAccessor;
-		} while( loadRequestConstAccessor.IsValid() );
+	m_loadThreadStopCounter = 0;
+
+	// Wake up the load thread as soon as file reads it is waiting on complete.
+	AsyncLoader::GetStaticInstance().SetCompletionCondition( &m_loadThreadWakeUpCondition );
+
+	Helium::CallbackThread::Entry entry =
+		&Helium::CallbackThread::EntryHelper< AssetLoader, &AssetLoader::LoadThreadMain >;
+	if( !m_loadThread.Create( entry, this, TXT( "AssetLoader - asset loading" ) ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "AssetLoader::StartLoadThread(): Failed to create load thread; assets will be loaded on the main thread.\n" ) );
+		AsyncLoader::GetStaticInstance().SetCompletionCondition( NULL );
+
+		return;
 	}
 
-	// Tick object load requests.
-	size_t loadRequestCount = m_loadRequestTickArray.GetSize();
-	for( size_t requestIndex = 0; requestIndex < loadRequestCount; ++requestIndex )
+	AtomicExchangeRelease( m_loadThreadRunningCounter, 1 );
+}
+
+/// Stop the background load thread, returning all load processing to Tick().
+///
+/// @see StartLoadThread(), IsLoadThreadRunning()
+void AssetLoader::StopLoadThread()
+{
+	if( m_loadThreadRunningCounter == 0 )
 	{
-		LoadRequest* pRequest = m_loadRequestTickArray[ requestIndex ];
-		HELIUM_ASSERT( pRequest );
+		return;
+	}
 
-		TickLoadRequest( pRequest );
+	AtomicExchangeRelease( m_loadThreadStopCounter, 1 );
+	m_loadThreadWakeUpCondition.Signal();
+	m_loadThread.Join();
 
-		int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
-		if( newRequestCount == 0 )
-		{
-			ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor loadRequestAccessor;
-			if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
-			{
-				pRequest = loadRequestAccessor->Second();
-				HELIUM_ASSERT( pRequest );
-				if( pRequest->requestCount == 0 )
-				{
-					HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
+	AsyncLoader::GetStaticInstance().SetCompletionCondition( NULL );
+	AtomicExchangeRelease( m_loadThreadRunningCounter, 0 );
+}
 
-					pRequest->spObject.Release();
-					pRequest->resolver.Clear();
+/// Get whether the background load thread is running.
+///
+/// @return  True if the load thread is running, false if not.
+///
+/// @see StartLoadThread(), StopLoadThread()
+bool AssetLoader::IsLoadThreadRunning() const
+{
+	return ( m_loadThreadRunningCounter != 0 );
+}
 
-					m_loadRequestMap.Remove( loadRequestAccessor );
-					m_loadRequestPool.Release( pRequest );
-				}
-			}
-		}
-	}
+/// Set the time budget for load work performed during each Tick() while the background load thread is running.
+///
+/// At least one load request is always updated per tick, regardless of the budget.
+///
+/// @param[in] milliseconds  Time budget, in milliseconds (zero or less for no limit).
+///
+/// @see GetMainThreadBudget()
+void AssetLoader::SetMainThreadBudget( float32_t milliseconds )
+{
+	m_mainThreadBudget = milliseconds;
+}
 
-	//m_loadRequestTickArray.Resize( 0 );
+/// Get the time budget for load work performed during each Tick() while the background load thread is running.
+///
+/// @return  Time budget, in milliseconds (zero or less for no limit).
+///
+/// @see SetMainThreadBudget()
+float32_t AssetLoader::GetMainThreadBudget() const
+{
+	return m_mainThreadBudget;
 }
 
 /// Get the global object loader instance.
@@ -363,12 +443,165 @@ void AssetLoader::OnLoadComplete( const AssetPath & /*path*/, Asset* /*pObject*/
 {
 }
 
+/// Update the given load stages of all pending load requests.
+///
+/// @param[in] stageMask           Combination of ELoadStage flags specifying the load stages to update.
+/// @param[in] budgetMilliseconds  Maximum time to spend updating load requests, in milliseconds (zero or less for no
+///                                limit).  At least one request is always updated.
+///
+/// @return  Number of requests that still have background load stages to process.
+size_t AssetLoader::TickLoadRequests( uint32_t stageMask, float32_t budgetMilliseconds )
+{
+	// Build the list of object load requests to update this tick, incrementing the request count on each to prevent
+	// them from being released while we don't have a lock on the request hash map.
+	DynamicArray< LoadRequest* > loadRequestTickArray;
+
+	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor loadRequestConstAccessor;
+	if( m_loadRequestMap.First( loadRequestConstAccessor ) )
+	{
+		do
+		{
+			LoadRequest* pRequest = loadRequestConstAccessor->Second();
+			HELIUM_ASSERT( pRequest );
+			AtomicIncrementUnsafe( pRequest->requestCount );
+			loadRequestTickArray.Add( pRequest );
+
+			++loadRequestConstAccessor;
+		} while( loadRequestConstAccessor.IsValid() );
+	}
+
+	// When running on a budget, resume from where the previous tick ran out of time so that requests at the end of the
+	// list are not starved.
+	bool bBudgeted = ( budgetMilliseconds > 0.0f );
+	size_t loadRequestCount = loadRequestTickArray.GetSize();
+	HELIUM_FRAME_PROFILE_COUNTER_SET( "LoadsInFlight", static_cast< int32_t >( loadRequestCount ) );
+	size_t startIndex = ( bBudgeted && loadRequestCount != 0 ? m_mainThreadTickOffset % loadRequestCount : 0 );
+
+	SimpleTimer budgetTimer;
+	size_t tickedRequestCount = 0;
+	size_t pendingBackgroundCount = 0;
+
+	// Tick object load requests.
+	for( size_t requestIndexOffset = 0; requestIndexOffset < loadRequestCount; ++requestIndexOffset )
+	{
+		size_t requestIndex = ( startIndex + requestIndexOffset ) % loadRequestCount;
+		LoadRequest* pRequest = loadRequestTickArray[ requestIndex ];
+		HELIUM_ASSERT( pRequest );
+
+		if( bBudgeted && tickedRequestCount != 0 && budgetTimer.Elapsed() >= budgetMilliseconds )
+		{
+			if( tickedRequestCount == requestIndexOffset )
+			{
+				m_mainThreadTickOffset = requestIndex;
+			}
+		}
+		else
+		{
+			if( stageMask & LOAD_STAGE_BACKGROUND )
+			{
+				MutexScopeLock packageLoaderLock( m_packageLoaderLock );
+				TickLoadRequest( pRequest, stageMask );
+			}
+			else
+			{
+				TickLoadRequest( pRequest, stageMask );
+			}
+
+			++tickedRequestCount;
+		}
+
+		if( ( pRequest->stateFlags & ( LOAD_FLAG_PRECACHE_READY | LOAD_FLAG_PRECACHED ) ) == 0 )
+		{
+			++pendingBackgroundCount;
+		}
+
+		int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
+		if( newRequestCount == 0 )
+		{
+			ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor loadRequestAccessor;
+			if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
+			{
+				pRequest = loadRequestAccessor->Second();
+				HELIUM_ASSERT( pRequest );
+				if( pRequest->requestCount == 0 )
+				{
+					HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
+
+					pRequest->spObject.Release();
+					pRequest->resolver.Clear();
+
+					m_loadRequestMap.Remove( loadRequestAccessor );
+					m_loadRequestPool.Release( pRequest );
+				}
+			}
+		}
+	}
+
+	if( bBudgeted && tickedRequestCount < loadRequestCount )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Debug,
+			TXT( "AssetLoader: Main thread load budget of %f ms exhausted after %" ) PRIuSZ TXT( " of %" ) PRIuSZ
+			TXT( " requests (%f ms).\n" ),
+			budgetMilliseconds,
+			tickedRequestCount,
+			loadRequestCount,
+			budgetTimer.Elapsed() );
+	}
+
+	return pendingBackgroundCount;
+}
+
+/// Background load thread entry point.
+void AssetLoader::LoadThreadMain()
+{
+	HELIUM_FRAME_PROFILE_THREAD_SCOPE( "AssetLoader" );
+
+	AssetAwareThreadSynchronizer assetSync;
+
+	bool bTick = true;
+	while( m_loadThreadStopCounter == 0 )
+	{
+		assetSync.Sync();
+
+		// Periodic wake-ups while idle only synchronize with other asset-aware threads, so that they neither tick the
+		// load requests nor record a profile scope.
+		size_t pendingCount = 0;
+		if( bTick )
+		{
+			HELIUM_FRAME_PROFILE_SCOPE( "AssetLoader::LoadThreadTick" );
+
+			{
+				MutexScopeLock packageLoaderLock( m_packageLoaderLock );
+				TickPackageLoaders();
+			}
+
+			pendingCount = TickLoadRequests( LOAD_STAGE_BACKGROUND, 0.0f );
+		}
+
+		if( pendingCount == 0 )
+		{
+			// Nothing left to do until more requests are added, so sleep until notified (waking up periodically so that
+			// threads requesting exclusive asset access are not blocked indefinitely).
+			bTick = m_loadThreadWakeUpCondition.Wait( LOAD_THREAD_IDLE_WAIT_TIME );
+		}
+		else
+		{
+			// Requests are still waiting on file I/O or other requests, so sleep until a file read completes (or
+			// briefly, for requests waiting on the main thread).
+			m_loadThreadWakeUpCondition.Wait( LOAD_THREAD_PENDING_WAIT_TIME );
+			bTick = true;
+		}
+	}
+}
+
 /// Update the given load request.
 ///
-/// @param[in] pRequest  Load request to update.
+/// @param[in] pRequest   Load request to update.
+/// @param[in] stageMask  Combination of ELoadStage flags specifying the load stages to update.
 ///
 /// @return  True if the load request has completed, false if it still requires time to process.
-bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
+bool AssetLoader::TickLoadRequest( LoadRequest* pRequest, uint32_t stageMask )
 {
 	HELIUM_ASSERT( pRequest );
 
@@ -388,8 +621,20 @@ bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
 
 #define UNLOCK_TICK() AtomicAndRelease( pRequest->stateFlags, ~LOAD_FLAG_IN_TICK )
 
+#define REQUIRE_STAGE( STAGE ) \
+	if( !( stageMask & ( STAGE ) ) ) \
+	{ \
+	if( bLockedTick ) \
+	{ \
+	UNLOCK_TICK(); \
+	} \
+	\
+	return false; \
+	}
+
 	if( !( pRequest->stateFlags & LOAD_FLAG_PRELOADED ) )
 	{
+		REQUIRE_STAGE( LOAD_STAGE_BACKGROUND );
 		LOCK_TICK();
 
 		if( !TickPreload( pRequest ) )
@@ -406,6 +651,7 @@ bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
 
 	if( !( pRequest->stateFlags & LOAD_FLAG_LINKED ) )
 	{
+		REQUIRE_STAGE( LOAD_STAGE_BACKGROUND );
 		LOCK_TICK();
 
 		if( !TickLink( pRequest ) )
@@ -420,8 +666,22 @@ bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
 		}
 	}
 
+	if( !( pRequest->stateFlags & ( LOAD_FLAG_PRECACHE_READY | LOAD_FLAG_PRECACHED ) ) )
+	{
+		REQUIRE_STAGE( LOAD_STAGE_BACKGROUND );
+		LOCK_TICK();
+
+		if( !TickPrecacheReady( pRequest ) )
+		{
+			UNLOCK_TICK();
+
+			return false;
+		}
+	}
+
 	if( !( pRequest->stateFlags & LOAD_FLAG_PRECACHED ) )
 	{
+		REQUIRE_STAGE( LOAD_STAGE_MAIN_THREAD );
 		LOCK_TICK();
 
 		if( !TickPrecache( pRequest ) )
@@ -438,6 +698,7 @@ bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
 
 	if( !( pRequest->stateFlags & LOAD_FLAG_LOADED ) )
 	{
+		REQUIRE_STAGE( LOAD_STAGE_MAIN_THREAD );
 		LOCK_TICK();
 
 		if( !TickFinalizeLoad( pRequest ) )
@@ -459,6 +720,7 @@ bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
 
 #undef LOCK_TICK
 #undef UNLOCK_TICK
+#undef REQUIRE_STAGE
 
 	return true;
 }
@@ -474,7 +736,24 @@ bool AssetLoader::TickPreload( LoadRequest* pRequest )
 	HELIUM_ASSERT( !( pRequest->stateFlags & ( LOAD_FLAG_LINKED | LOAD_FLAG_PRECACHED | LOAD_FLAG_LOADED ) ) );
 
 	PackageLoader* pPackageLoader = pRequest->pPackageLoader;
-	HELIUM_ASSERT( pPackageLoader );
+	if( !pPackageLoader )
+	{
+		// Requests made while the load thread is running have their package loader resolved here.
+		pPackageLoader = GetPackageLoader( pRequest->path );
+		if( !pPackageLoader )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "AssetLoader: Failed to locate package loader for \"%s\".\n" ),
+				*pRequest->path.ToString() );
+
+			AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_FULLY_LOADED | LOAD_FLAG_ERROR );
+
+			return true;
+		}
+
+		pRequest->pPackageLoader = pPackageLoader;
+	}
 
 	if( IsInvalid( pRequest->packageLoadRequestId ) )
 	{
@@ -565,6 +844,37 @@ bool AssetLoader::TickLink( LoadRequest* pRequest )
 	return true;
 }
 
+/// Wait for the dependencies of the given object load request to finish loading and perform any work required prior
+/// to resource precaching.
+///
+/// This does not touch any render resources, so it can be performed on the background load thread.
+///
+/// @param[in] pRequest  Load request to update.
+///
+/// @return  True if the request is ready for resource precaching, false if it still requires processing.
+bool AssetLoader::TickPrecacheReady( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !( pRequest->stateFlags & ( LOAD_FLAG_PRECACHED | LOAD_FLAG_LOADED ) ) );
+
+	Asset* pAsset = pRequest->spObject;
+	if( pAsset )
+	{
+		if( !pRequest->resolver.ReadyToPrecache() )
+		{
+			return false;
+		}
+
+		// Perform any pre-precaching work (note that we don't precache anything for the default template object for
+		// a given type).
+		OnPrecacheReady( pAsset, pRequest->pPackageLoader );
+	}
+
+	AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_PRECACHE_READY );
+
+	return true;
+}
+
 /// Update resource precaching for the given object load request.
 ///
 /// @param[in] pRequest  Load request to update.
@@ -586,10 +896,6 @@ bool AssetLoader::TickPrecache( LoadRequest* pRequest )
 
 		pRequest->resolver.Clear();
 
-		// Perform any pre-precaching work (note that we don't precache anything for the default template object for
-		// a given type).
-		OnPrecacheReady( pAsset, pRequest->pPackageLoader );
-
 		if( !pAsset->GetAnyFlagSet( Asset::FLAG_BROKEN ) &&
 			!pAsset->IsDefaultTemplate() &&
 			pAsset->NeedsPrecacheResourceData() )
@@ -764,6 +1070,34 @@ void Helium::AssetResolver::ApplyFixups()
 	}
 }
 
+/// Get whether all objects referenced by the object being loaded have been fully loaded.
+///
+/// Unlike TryFinishPrecachingDependencies(), this does not release the dependency load requests, so it can be safely
+/// polled from the background load thread.
+///
+/// @return  True if all dependencies have finished loading, false if not.
+bool Helium::AssetResolver::ReadyToPrecache()
+{
+	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
+		iter != m_Fixups.End(); ++iter)
+	{
+		if ( IsInvalid( iter->m_LoadRequestId ) )
+		{
+			continue;
+		}
+
+		AssetLoader::LoadRequest* pRequest = AssetLoader::GetStaticInstance()->m_loadRequestPool.GetObject( iter->m_LoadRequestId );
+		HELIUM_ASSERT( pRequest );
+
+		if ( ( pRequest->stateFlags & AssetLoader::LOAD_FLAG_FULLY_LOADED ) != AssetLoader::LOAD_FLAG_FULLY_LOADED )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void Helium::AssetResolver::Clear()
 {
 	m_Fixups.Clear();
@@ -2,6 +2,9 @@
 
 #include "Engine/Engine.h"
 
+#include "Platform/Condition.h"
+#include "Platform/Locks.h"
+#include "Platform/Thread.h"
 #include "Reflect/Translator.h"
 #include "Foundation/ConcurrentHashMap.h"
 #include "Foundation/ObjectPool.h"
@@ -30,6 +33,7 @@ namespace Helium
 		// Called by AssetLoader
 		bool ReadyToApplyFixups();
 		void ApplyFixups();
+		bool ReadyToPrecache();
 		bool TryFinishPrecachingDependencies();
 		void Clear();
 
@@ -61,6 +65,8 @@ namespace Helium
 	public:
 		/// Number of request objects to allocate in each block of the request pool.
 		static const size_t LOAD_REQUEST_POOL_BLOCK_SIZE = 64;
+		/// Default time budget per Tick() for load work performed on the main thread, in milliseconds.
+		static const float32_t DEFAULT_MAIN_THREAD_BUDGET;
 
 		friend AssetIdentifier;
 		friend AssetResolver;
@@ -98,6 +104,16 @@ namespace Helium
 		virtual void Tick();
 		//@}
 
+		/// @name Background Loading
+		//@{
+		void StartLoadThread();
+		void StopLoadThread();
+		bool IsLoadThreadRunning() const;
+
+		void SetMainThreadBudget( float32_t milliseconds );
+		float32_t GetMainThreadBudget() const;
+		//@}
+
 		/// @name Static Access
 		//@{
 		static AssetLoader* GetStaticInstance();
@@ -132,6 +148,21 @@ namespace Helium
 
 			/// Set if ticking is in progress.
 			LOAD_FLAG_IN_TICK = 1 << 6,
+
+			/// Set once dependencies have finished loading and pre-precaching work has been performed.
+			LOAD_FLAG_PRECACHE_READY = 1 << 7,
+		};
+
+		/// Load process stages to update when ticking load requests.
+		enum ELoadStage
+		{
+			/// Preloading, linking and pre-precaching work (safe to run on the load thread).
+			LOAD_STAGE_BACKGROUND  = 1 << 0,
+			/// Resource precaching and load finalization (must run on the main thread).
+			LOAD_STAGE_MAIN_THREAD = 1 << 1,
+
+			/// All load stages.
+			LOAD_STAGE_ALL = LOAD_STAGE_BACKGROUND | LOAD_STAGE_MAIN_THREAD
 		};
 
 		/// Asset load request information.
@@ -163,6 +194,24 @@ namespace Helium
 		/// Load request pool.
 		ObjectPool< LoadRequest > m_loadRequestPool;
 
+		/// Background load thread.
+		CallbackThread m_loadThread;
+		/// Condition used to wake up the load thread when new requests are added (or when it should shut down).
+		Condition m_loadThreadWakeUpCondition;
+		/// Lock synchronizing package loader access between the load thread and other threads (recursive, as
+		/// deserialization on the load thread may begin loading referenced objects).  BeginLoadObject() never takes
+		/// this lock while the load thread is running.
+		Mutex m_packageLoaderLock;
+		/// Non-zero if the load thread should stop when next possible, zero if it should continue.
+		volatile int32_t m_loadThreadStopCounter;
+		/// Non-zero if the load thread has been started (read from any thread requesting a load).
+		volatile int32_t m_loadThreadRunningCounter;
+
+		/// Time budget per Tick() for load work performed on the main thread, in milliseconds.
+		float32_t m_mainThreadBudget;
+		/// Index of the load request at which to resume main thread ticking after running out of budget.
+		size_t m_mainThreadTickOffset;
+
 		/// Singleton instance.
 		static AssetLoader* sm_pInstance;
 
@@ -179,12 +228,19 @@ namespace Helium
 
 		/// @name Load Process Updating
 		//@{
-		bool TickLoadRequest( LoadRequest* pRequest );
+		size_t TickLoadRequests( uint32_t stageMask, float32_t budgetMilliseconds );
+		bool TickLoadRequest( LoadRequest* pRequest, uint32_t stageMask = LOAD_STAGE_ALL );
 		bool TickPreload( LoadRequest* pRequest );
 		bool TickLink( LoadRequest* pRequest );
+		bool TickPrecacheReady( LoadRequest* pRequest );
 		bool TickPrecache( LoadRequest* pRequest );
 		bool TickFinalizeLoad( LoadRequest* pRequest );
 		//@}
+
+		/// @name Background Loading Implementation
+		//@{
+		void LoadThreadMain();
+		//@}
 	};
 
 	///////////////////////////////////////////////////////////////////////////
@@ -1,6 +1,8 @@
 #include "EnginePch.h"
 #include "Engine/AssetPath.h"
 
+#include "Platform/Atomic.h"
+#include "Platform/Thread.h"
 #include "Foundation/FilePath.h"
 
 #include "Foundation/ReferenceCounting.h"
@@ -15,12 +17,79 @@ struct Helium::AssetPath::PendingLink
 	AssetPtr *rpPointerToLink;
 };
 
+/// Asset path hash table.
+///
+/// Slots only ever transition from null to an entry (or to the frozen marker while the table is being migrated to a
+/// larger table), so lookups and insertions can be performed without locking.
+struct Helium::AssetPath::Table
+{
+	/// Table slots.
+	Entry* volatile* pSlots;
+	/// Number of slots (always a power of two).
+	size_t capacity;
+	/// Number of entries stored in the table.
+	volatile int32_t entryCount;
+	/// Non-zero once a thread has started migrating this table to a larger table.
+	volatile int32_t growCounter;
+	/// Previous (smaller) table, retained until shutdown for threads that may still be reading it.
+	Table* pPrevious;
+};
+
+/// Block of asset path entries allocated by a single thread.
+struct Helium::AssetPath::EntryBlock
+{
+	/// Previously filled block owned by the same arena.
+	EntryBlock* pPrevious;
+	/// Number of entries allocated from this block.
+	size_t usedCount;
+	/// Entry storage.
+	Entry entries[ ENTRY_BLOCK_SIZE ];
+};
+
+/// Per-thread asset path entry allocator.
+struct Helium::AssetPath::EntryArena
+{
+	/// Next arena in the global list of arenas.
+	EntryArena* pNext;
+	/// Block from which entries are currently being allocated.
+	EntryBlock* pBlock;
+};
+
 using namespace Helium;
 
-AssetPath::TableBucket* AssetPath::sm_pTable = NULL;
-StackMemoryHeap<>* AssetPath::sm_pEntryMemoryHeap = NULL;
+/// Marker stored in empty table slots once a table has been migrated to a larger table.
+static const uintptr_t FROZEN_SLOT_VALUE = 1;
+
+/// Entry arena for the current thread.
+static ThreadLocalPointer s_entryArenaPointer;
+/// Arena generation in which the current thread's entry arena was created (stored as a pointer-sized integer).
+static ThreadLocalPointer s_entryArenaGenerationPointer;
+/// Current arena generation.  Shutdown() frees every arena and advances the generation, so arena pointers left behind
+/// in the thread-local storage of other threads are never used again.
+static uintptr_t s_entryArenaGeneration = 1;
+
+AssetPath::Table* volatile AssetPath::sm_pTable = NULL;
+AssetPath::EntryArena* volatile AssetPath::sm_pEntryArenas = NULL;
 ObjectPool<AssetPath::PendingLink> *AssetPath::sm_pPendingLinksPool = NULL;
 
+/// Get whether the character at the given offset in an object path string ends a path component.
+///
+/// @param[in] pString  Asset path string.
+/// @param[in] offset   Character offset to test.
+///
+/// @return  True if the character is a path delimiter or the string null terminator, false if not.
+static bool IsPathComponentEnd( const char* pString, size_t offset )
+{
+	char character = pString[ offset ];
+
+	// Adjacent colons (i.e. like in /Types:Helium::ConfigAsset) are part of the name, as with AssetPath::Parse().
+	return ( character == TXT( '\0' ) ||
+		character == HELIUM_PACKAGE_PATH_CHAR ||
+		( character == HELIUM_OBJECT_PATH_CHAR &&
+		pString[ offset + 1 ] != HELIUM_OBJECT_PATH_CHAR &&
+		( offset == 0 || pString[ offset - 1 ] != HELIUM_OBJECT_PATH_CHAR ) ) );
+}
+
 /// Parse the object path in the specified string and store it in this object.
 ///
 /// @param[in] pString  Asset path string to set.  If this is null or empty, the path will be cleared.
@@ -470,7 +539,7 @@ void AssetPath::ToString( String& rString ) const
 		return;
 	}
 
-	EntryToString( *m_pEntry, rString );
+	rString += GetEntryString( *m_pEntry );
 }
 
 /// Generate a string representation of this object path with all package and object delimiters converted to valid
@@ -499,16 +568,50 @@ void AssetPath::Clear()
 
 /// Release the object path table and free all allocated memory.
 ///
-/// This should only be called immediately prior to application exit.
+/// This should only be called immediately prior to application exit, while no other thread is using asset paths.
+/// Threads that used asset paths before shutdown allocate new entry arenas if they use asset paths again.
 void AssetPath::Shutdown()
 {
 	HELIUM_TRACE( TraceLevels::Info, TXT( "Shutting down AssetPath table.\n" ) );
 
-	delete [] sm_pTable;
+	Table* pTable = sm_pTable;
+	while( pTable )
+	{
+		Table* pPreviousTable = pTable->pPrevious;
+		delete [] pTable->pSlots;
+		delete pTable;
+		pTable = pPreviousTable;
+	}
+
 	sm_pTable = NULL;
 
-	delete sm_pEntryMemoryHeap;
-	sm_pEntryMemoryHeap = NULL;
+	EntryArena* pArena = sm_pEntryArenas;
+	while( pArena )
+	{
+		EntryBlock* pBlock = pArena->pBlock;
+		while( pBlock )
+		{
+			size_t usedCount = pBlock->usedCount;
+			for( size_t entryIndex = 0; entryIndex < usedCount; ++entryIndex )
+			{
+				delete [] pBlock->entries[ entryIndex ].pString;
+			}
+
+			EntryBlock* pPreviousBlock = pBlock->pPrevious;
+			delete pBlock;
+			pBlock = pPreviousBlock;
+		}
+
+		EntryArena* pNextArena = pArena->pNext;
+		delete pArena;
+		pArena = pNextArena;
+	}
+
+	// Other threads still reference the freed arenas from their thread-local storage, so invalidate the arena pointers
+	// of all threads at once.
+	sm_pEntryArenas = NULL;
+	++s_entryArenaGeneration;
+	s_entryArenaPointer.SetPointer( NULL );
 
 	delete sm_pPendingLinksPool;
 	sm_pPendingLinksPool = NULL;
@@ -516,6 +619,155 @@ void AssetPath::Shutdown()
 	HELIUM_TRACE( TraceLevels::Info, TXT( "AssetPath table shutdown complete.\n" ) );
 }
 
+/// Parse and intern a batch of object path strings.
+///
+/// This is intended for bulk loading of paths, such as when reading a cache table of contents.  Leading path
+/// components shared with the previous string in the batch are reused directly instead of being parsed and looked up
+/// again, so sorting the strings beforehand (as paths are when written to a cache) makes interning considerably
+/// faster.
+///
+/// @param[in]  ppStrings    Array of path strings to parse.  Null or empty strings result in empty paths.
+/// @param[in]  stringCount  Number of strings to parse.
+/// @param[out] pPaths       Array in which to store the resulting paths.  Paths for strings that fail to parse are
+///                          cleared.
+///
+/// @return  True if all strings were parsed successfully, false if any strings were invalid.
+bool AssetPath::InternPaths( const char* const* ppStrings, size_t stringCount, AssetPath* pPaths )
+{
+	HELIUM_ASSERT( ppStrings || stringCount == 0 );
+	HELIUM_ASSERT( pPaths || stringCount == 0 );
+
+	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
+
+	bool bAllParsed = true;
+
+	// Offset of the end of each component in the previous string and the table entry for the path up to that point.
+	DynamicArray< size_t > componentEndOffsets;
+	DynamicArray< Entry* > componentEntries;
+	const char* pPreviousString = NULL;
+
+	for( size_t stringIndex = 0; stringIndex < stringCount; ++stringIndex )
+	{
+		const char* pString = ppStrings[ stringIndex ];
+		AssetPath& rPath = pPaths[ stringIndex ];
+		rPath.m_pEntry = NULL;
+
+		if( !pString || pString[ 0 ] == TXT( '\0' ) )
+		{
+			pPreviousString = NULL;
+			componentEndOffsets.Resize( 0 );
+			componentEntries.Resize( 0 );
+
+			continue;
+		}
+
+		// Determine how many leading components are shared with the previous path.
+		size_t reusedCount = 0;
+		if( pPreviousString )
+		{
+			size_t commonLength = 0;
+			while( pString[ commonLength ] != TXT( '\0' ) && pString[ commonLength ] == pPreviousString[ commonLength ] )
+			{
+				++commonLength;
+			}
+
+			size_t componentCount = componentEndOffsets.GetSize();
+			while( reusedCount < componentCount )
+			{
+				size_t endOffset = componentEndOffsets[ reusedCount ];
+				if( endOffset > commonLength || !IsPathComponentEnd( pString, endOffset ) )
+				{
+					break;
+				}
+
+				++reusedCount;
+			}
+		}
+
+		componentEndOffsets.Resize( reusedCount );
+		componentEntries.Resize( reusedCount );
+
+		size_t suffixOffset = ( reusedCount != 0 ? componentEndOffsets[ reusedCount - 1 ] : 0 );
+		Entry* pEntry = ( reusedCount != 0 ? componentEntries[ reusedCount - 1 ] : NULL );
+
+		const char* pSuffix = pString + suffixOffset;
+		if( pSuffix[ 0 ] == TXT( '\0' ) )
+		{
+			// The path matches one of the previous path's parents.
+			rPath.m_pEntry = pEntry;
+			pPreviousString = pString;
+
+			continue;
+		}
+
+		// Parse the remaining components.
+		StackMemoryHeap<>::Marker stackMarker( rStackHeap );
+
+		Name* pEntryNames;
+		uint32_t* pInstanceIndices;
+		size_t nameCount;
+		size_t packageCount;
+		bool bParsed = Parse( pSuffix, rStackHeap, pEntryNames, pInstanceIndices, nameCount, packageCount );
+		if( bParsed && packageCount != 0 && pEntry && !pEntry->bPackage )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "AssetPath: Unexpected package path separator in path string \"%s\".\n" ),
+				pString );
+
+			bParsed = false;
+		}
+
+		if( !bParsed )
+		{
+			bAllParsed = false;
+
+			pPreviousString = NULL;
+			componentEndOffsets.Resize( 0 );
+			componentEntries.Resize( 0 );
+
+			continue;
+		}
+
+		for( size_t characterOffset = suffixOffset + 1; ; ++characterOffset )
+		{
+			if( IsPathComponentEnd( pString, characterOffset ) )
+			{
+				componentEndOffsets.Push( characterOffset );
+				if( pString[ characterOffset ] == TXT( '\0' ) )
+				{
+					break;
+				}
+			}
+		}
+
+		HELIUM_ASSERT( componentEndOffsets.GetSize() == reusedCount + nameCount );
+
+		// Look up/add the entries for each new component (names are stored from the bottom level on up).
+		size_t nameIndex = nameCount;
+		while( nameIndex != 0 )
+		{
+			--nameIndex;
+
+			Entry entry;
+			entry.pParent = pEntry;
+			entry.name = pEntryNames[ nameIndex ];
+			entry.instanceIndex = pInstanceIndices[ nameIndex ];
+			entry.bPackage = ( nameIndex >= nameCount - packageCount );
+
+			pEntry = Add( entry );
+			HELIUM_ASSERT( pEntry );
+
+			componentEntries.Push( pEntry );
+		}
+
+		rPath.m_pEntry = pEntry;
+		pPreviousString = pString;
+	}
+
+	return bAllParsed;
+}
+
 /// Convert the path separator characters in the given object path to valid directory delimiters for the current
 /// platform.
 ///
@@ -849,7 +1101,7 @@ bool AssetPath::Parse(
 
 /// Look up a table entry, adding it if it does not exist.
 ///
-/// This also handles lazy initialization of the path table and allocator.
+/// This also handles lazy initialization of the path table.
 ///
 /// @param[in] rEntry  Entry to locate or add.
 ///
@@ -858,51 +1110,278 @@ AssetPath::Entry* AssetPath::Add( const Entry& rEntry )
 {
 	// Lazily initialize the hash table.  Note that this is not inherently thread-safe, but there should always be
 	// at least one path created before any sub-threads are spawned.
-	if( !sm_pEntryMemoryHeap )
+	if( !sm_pTable )
 	{
-		sm_pEntryMemoryHeap = new StackMemoryHeap<>( STACK_HEAP_BLOCK_SIZE );
-		HELIUM_ASSERT( sm_pEntryMemoryHeap );
-
 		sm_pPendingLinksPool = new ObjectPool<PendingLink>( PENDING_LINKS_POOL_BLOCK_SIZE );
 		HELIUM_ASSERT( sm_pPendingLinksPool );
 
-		HELIUM_ASSERT( !sm_pTable );
-		sm_pTable = new TableBucket [ TABLE_BUCKET_COUNT ];
-		HELIUM_ASSERT( sm_pTable );
+		sm_pTable = CreateTable( INITIAL_TABLE_CAPACITY );
+	}
+
+	size_t hash = ComputeEntryHash( rEntry );
+
+	// Spread the upper hash bits into the slot index, as the low bits of the string hash are not well distributed.
+	size_t hashSlotIndex = hash ^ ( hash >> 15 ) ^ ( hash >> 27 );
+
+	// Entry allocated for insertion, kept across retries if the table needs to grow.
+	Entry* pNewEntry = NULL;
+
+	for( ; ; )
+	{
+		Table* pTable = sm_pTable;
+		HELIUM_ASSERT( pTable );
+
+		size_t slotMask = pTable->capacity - 1;
+		size_t slotIndex = hashSlotIndex & slotMask;
+
+		for( ; ; )
+		{
+			Entry* pTableEntry = pTable->pSlots[ slotIndex ];
+			if( !pTableEntry )
+			{
+				// Entry does not exist, so claim this slot unless the table needs to grow first.
+				if( static_cast< size_t >( pTable->entryCount ) >= pTable->capacity / 4 * 3 )
+				{
+					GrowTable( pTable );
+
+					break;
+				}
+
+				if( !pNewEntry )
+				{
+					pNewEntry = AllocateEntry( rEntry, hash );
+					HELIUM_ASSERT( pNewEntry );
+				}
+
+				pTableEntry = AtomicCompareExchangeRelease(
+					pTable->pSlots[ slotIndex ],
+					pNewEntry,
+					static_cast< Entry* >( NULL ) );
+				if( !pTableEntry )
+				{
+					AtomicIncrementRelease( pTable->entryCount );
+
+					return pNewEntry;
+				}
+
+				// Another thread claimed the slot first, so check what it stored.
+			}
+
+			if( reinterpret_cast< uintptr_t >( pTableEntry ) == FROZEN_SLOT_VALUE )
+			{
+				// The table is being migrated, so wait for the new table and try again.
+				GrowTable( pTable );
+
+				break;
+			}
+
+			if( pTableEntry->hash == hash && EntryContentsMatch( rEntry, *pTableEntry ) )
+			{
+				if( pNewEntry )
+				{
+					FreeLastEntry( pNewEntry );
+				}
+
+				return pTableEntry;
+			}
+
+			slotIndex = ( slotIndex + 1 ) & slotMask;
+		}
 	}
+}
 
-	HELIUM_ASSERT( sm_pTable );
+/// Allocate a hash table with the given number of slots.
+///
+/// @param[in] capacity  Number of slots (must be a power of two).
+///
+/// @return  Newly allocated table.
+AssetPath::Table* AssetPath::CreateTable( size_t capacity )
+{
+	HELIUM_ASSERT( capacity != 0 && ( capacity & ( capacity - 1 ) ) == 0 );
 
-	// Compute the entry's hash table index and retrieve the corresponding bucket.
-	uint32_t bucketIndex = ComputeEntryStringHash( rEntry ) % TABLE_BUCKET_COUNT;
-	TableBucket& rBucket = sm_pTable[ bucketIndex ];
+	Table* pTable = new Table;
+	HELIUM_ASSERT( pTable );
 
-	// Locate the entry in the table.  If it does not exist, add it.
-	size_t entryCount = 0;
-	Entry* pTableEntry = rBucket.Find( rEntry, entryCount );
-	if( !pTableEntry )
+	pTable->pSlots = new Entry* volatile [ capacity ];
+	HELIUM_ASSERT( pTable->pSlots );
+	for( size_t slotIndex = 0; slotIndex < capacity; ++slotIndex )
 	{
-		pTableEntry = rBucket.Add( rEntry, entryCount );
-		HELIUM_ASSERT( pTableEntry );
+		pTable->pSlots[ slotIndex ] = NULL;
 	}
 
-	return pTableEntry;
+	pTable->capacity = capacity;
+	pTable->entryCount = 0;
+	pTable->growCounter = 0;
+	pTable->pPrevious = NULL;
+
+	return pTable;
 }
 
-/// Recursive function for building the string representation of an object path entry.
+/// Migrate the given table to a table with twice the capacity, or wait for another thread to finish doing so.
 ///
-/// @param[in]  rEntry   FilePath entry.
-/// @param[out] rString  FilePath string.
-void AssetPath::EntryToString( const Entry& rEntry, String& rString )
+/// Each empty slot in the old table is frozen as it is visited, so any thread attempting to insert into the old table
+/// after migration has started will fail to claim a slot and wait for the new table instead.  Old tables are kept
+/// around until shutdown, as other threads may still be reading from them.
+///
+/// @param[in] pTable  Table that needs to grow.
+void AssetPath::GrowTable( Table* pTable )
+{
+	HELIUM_ASSERT( pTable );
+
+	if( AtomicCompareExchangeAcquire( pTable->growCounter, 1, 0 ) != 0 )
+	{
+		// Another thread is already migrating the table.
+		while( sm_pTable == pTable )
+		{
+			Thread::Yield();
+		}
+
+		return;
+	}
+
+	size_t capacity = pTable->capacity;
+
+	Table* pNewTable = CreateTable( capacity * 2 );
+	HELIUM_ASSERT( pNewTable );
+	pNewTable->pPrevious = pTable;
+
+	size_t newSlotMask = pNewTable->capacity - 1;
+	int32_t entryCount = 0;
+
+	Entry* pFrozenSlot = reinterpret_cast< Entry* >( FROZEN_SLOT_VALUE );
+	for( size_t slotIndex = 0; slotIndex < capacity; ++slotIndex )
+	{
+		Entry* pTableEntry = AtomicCompareExchangeAcquire(
+			pTable->pSlots[ slotIndex ],
+			pFrozenSlot,
+			static_cast< Entry* >( NULL ) );
+		if( !pTableEntry )
+		{
+			continue;
+		}
+
+		// Only this thread can write to the new table until it is published, so no atomic operations are needed.
+		size_t hash = pTableEntry->hash;
+		size_t newSlotIndex = ( hash ^ ( hash >> 15 ) ^ ( hash >> 27 ) ) & newSlotMask;
+		while( pNewTable->pSlots[ newSlotIndex ] )
+		{
+			newSlotIndex = ( newSlotIndex + 1 ) & newSlotMask;
+		}
+
+		pNewTable->pSlots[ newSlotIndex ] = pTableEntry;
+		++entryCount;
+	}
+
+	pNewTable->entryCount = entryCount;
+
+	AtomicExchangeRelease( sm_pTable, pNewTable );
+}
+
+/// Allocate a new table entry from the current thread's entry arena.
+///
+/// @param[in] rEntry  Entry contents to copy.
+/// @param[in] hash    Precomputed entry hash.
+///
+/// @return  Newly allocated entry.
+///
+/// @see FreeLastEntry()
+AssetPath::Entry* AssetPath::AllocateEntry( const Entry& rEntry, size_t hash )
+{
+	// Arenas created before the last shutdown have been freed.
+	EntryArena* pArena = static_cast< EntryArena* >( s_entryArenaPointer.GetPointer() );
+	if( pArena &&
+		reinterpret_cast< uintptr_t >( s_entryArenaGenerationPointer.GetPointer() ) != s_entryArenaGeneration )
+	{
+		pArena = NULL;
+	}
+
+	if( !pArena )
+	{
+		pArena = new EntryArena;
+		HELIUM_ASSERT( pArena );
+		pArena->pBlock = NULL;
+
+		// Register the arena so that its memory can be released on shutdown.
+		EntryArena* pNextArena;
+		do
+		{
+			pNextArena = sm_pEntryArenas;
+			pArena->pNext = pNextArena;
+		} while( AtomicCompareExchangeRelease( sm_pEntryArenas, pArena, pNextArena ) != pNextArena );
+
+		s_entryArenaPointer.SetPointer( pArena );
+		s_entryArenaGenerationPointer.SetPointer( reinterpret_cast< void* >( s_entryArenaGeneration ) );
+	}
+
+	EntryBlock* pBlock = pArena->pBlock;
+	if( !pBlock || pBlock->usedCount >= ENTRY_BLOCK_SIZE )
+	{
+		EntryBlock* pNewBlock = new EntryBlock;
+		HELIUM_ASSERT( pNewBlock );
+		pNewBlock->pPrevious = pBlock;
+		pNewBlock->usedCount = 0;
+
+		pArena->pBlock = pNewBlock;
+		pBlock = pNewBlock;
+	}
+
+	Entry* pEntry = &pBlock->entries[ pBlock->usedCount ];
+	++pBlock->usedCount;
+
+	pEntry->pParent = rEntry.pParent;
+	pEntry->name = rEntry.name;
+	pEntry->instanceIndex = rEntry.instanceIndex;
+	pEntry->bPackage = rEntry.bPackage;
+	pEntry->hash = hash;
+	pEntry->pString = NULL;
+
+	return pEntry;
+}
+
+/// Release an entry allocated by AllocateEntry() that was never added to the table.
+///
+/// @param[in] pEntry  Entry to release (must be the last entry allocated by the current thread).
+///
+/// @see AllocateEntry()
+void AssetPath::FreeLastEntry( Entry* pEntry )
 {
+	HELIUM_ASSERT( pEntry );
+
+	EntryArena* pArena = static_cast< EntryArena* >( s_entryArenaPointer.GetPointer() );
+	HELIUM_ASSERT( pArena );
+
+	EntryBlock* pBlock = pArena->pBlock;
+	HELIUM_ASSERT( pBlock );
+	HELIUM_ASSERT( pBlock->usedCount != 0 );
+	HELIUM_ASSERT( pEntry == &pBlock->entries[ pBlock->usedCount - 1 ] );
+	HELIUM_UNREF( pEntry );
+
+	--pBlock->usedCount;
+}
+
+/// Get the string representation of an object path entry, building and caching it if necessary.
+///
+/// @param[in] rEntry  FilePath entry.
+///
+/// @return  FilePath string.
+const char* AssetPath::GetEntryString( Entry& rEntry )
+{
+	const char* pString = rEntry.pString;
+	if( pString )
+	{
+		return pString;
+	}
+
+	String entryString;
+
 	Entry* pParent = rEntry.pParent;
 	if( pParent )
 	{
-		EntryToString( *pParent, rString );
+		entryString += GetEntryString( *pParent );
 	}
 
-	rString += ( rEntry.bPackage ? HELIUM_PACKAGE_PATH_CHAR : HELIUM_OBJECT_PATH_CHAR );
-	rString += rEntry.name.Get();
+	entryString += ( rEntry.bPackage ? HELIUM_PACKAGE_PATH_CHAR : HELIUM_OBJECT_PATH_CHAR );
+	entryString += rEntry.name.Get();
 	if( IsValid( rEntry.instanceIndex ) )
 	{
 		char instanceIndexString[ 16 ];
@@ -912,8 +1391,28 @@ void AssetPath::EntryToString( const Entry& rEntry, String& rString )
 			rEntry.instanceIndex );
 		instanceIndexString[ HELIUM_ARRAY_COUNT( instanceIndexString ) - 1 ] = TXT( '\0' );
 
-		rString += instanceIndexString;
+		entryString += instanceIndexString;
 	}
+
+	size_t stringSize = entryString.GetSize();
+	char* pNewString = new char [ stringSize + 1 ];
+	HELIUM_ASSERT( pNewString );
+	ArrayCopy( pNewString, *entryString, stringSize );
+	pNewString[ stringSize ] = TXT( '\0' );
+
+	// Another thread may have cached the string at the same time, in which case we use its copy instead.
+	const char* pExistingString = AtomicCompareExchangeRelease(
+		rEntry.pString,
+		static_cast< const char* >( pNewString ),
+		static_cast< const char* >( NULL ) );
+	if( pExistingString )
+	{
+		delete [] pNewString;
+
+		return pExistingString;
+	}
+
+	return pNewString;
 }
 
 /// Recursive function for building the file path string representation of an object path entry.
@@ -932,13 +1431,14 @@ void AssetPath::EntryToFilePathString( const Entry& rEntry, String& rString )
 	rString += rEntry.name.Get();
 }
 
-/// Compute a hash value for an object path entry based on the contents of the name strings (slow, should only be
-/// used internally when a string comparison is needed).
+/// Compute a hash value for an object path entry based on the contents of the name strings.
+///
+/// The parent entry, if any, must already be in the table (its hash is used directly rather than being recomputed).
 ///
 /// @param[in] rEntry  Asset path entry.
 ///
 /// @return  Hash value.
-size_t AssetPath::ComputeEntryStringHash( const Entry& rEntry )
+size_t AssetPath::ComputeEntryHash( const Entry& rEntry )
 {
 	size_t hash = StringHash( rEntry.name.GetDirect() );
 	hash = ( ( hash * 33 ) ^ rEntry.instanceIndex );
@@ -950,8 +1450,7 @@ size_t AssetPath::ComputeEntryStringHash( const Entry& rEntry )
 	Entry* pParent = rEntry.pParent;
 	if( pParent )
 	{
-		size_t parentHash = ComputeEntryStringHash( *pParent );
-		hash = ( ( hash * 33 ) ^ parentHash );
+		hash = ( ( hash * 33 ) ^ pParent->hash );
 	}
 
 	return hash;
@@ -970,73 +1469,3 @@ bool AssetPath::EntryContentsMatch( const Entry& rEntry0, const Entry& rEntry1 )
 		( rEntry0.bPackage ? rEntry1.bPackage : !rEntry1.bPackage ) &&
 		rEntry0.pParent == rEntry1.pParent );
 }
-
-/// Find an existing object path entry in this table.
-///
-/// @param[in]  rEntry       Externally defined entry to match.
-/// @param[out] rEntryCount  Number of entries in this bucket when the search was performed.
-///
-/// @return  Table entry if found, null if not found.
-///
-/// @see Add()
-AssetPath::Entry* AssetPath::TableBucket::Find( const Entry& rEntry, size_t& rEntryCount )
-{
-	ScopeReadLock readLock( m_lock );
-
-	Entry* const * ppTableEntries = m_entries.GetData();
-	size_t entryCount = m_entries.GetSize();
-	HELIUM_ASSERT( ppTableEntries || entryCount == 0 );
-
-	rEntryCount = entryCount;
-
-	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
-	{
-		Entry* pTableEntry = ppTableEntries[ entryIndex ];
-		HELIUM_ASSERT( pTableEntry );
-		if( EntryContentsMatch( rEntry, *pTableEntry ) )
-		{
-			return pTableEntry;
-		}
-	}
-
-	return NULL;
-}
-
-/// Add an object path entry to this table if it does not already exist.
-///
-/// @param[in] rEntry              Externally defined entry to locate or add.
-/// @param[in] previousEntryCount  Number of entries already checked during a previous Find() call (existing entries
-///                                are not expected to change).  In other words, the entry index from which to start
-///                                checking for any additional string entries that may have been added since the
-///                                previous Find() call.
-///
-/// @return  Pointer to the object path table entry.
-///
-/// @see Find()
-AssetPath::Entry* AssetPath::TableBucket::Add( const Entry& rEntry, size_t previousEntryCount )
-{
-	ScopeWriteLock writeLock( m_lock );
-
-	Entry* const * ppTableEntries = m_entries.GetData();
-	size_t entryCount = m_entries.GetSize();
-	HELIUM_ASSERT( ppTableEntries || entryCount == 0 );
-	HELIUM_ASSERT( previousEntryCount <= entryCount );
-	for( size_t entryIndex = previousEntryCount; entryIndex < entryCount; ++entryIndex )
-	{
-		Entry* pTableEntry = ppTableEntries[ entryIndex ];
-		HELIUM_ASSERT( pTableEntry );
-		if( EntryContentsMatch( rEntry, *pTableEntry ) )
-		{
-			return pTableEntry;
-		}
-	}
-
-	HELIUM_ASSERT( sm_pEntryMemoryHeap );
-	Entry* pNewEntry = static_cast< Entry* >( sm_pEntryMemoryHeap->Allocate( sizeof( Entry ) ) );
-	HELIUM_ASSERT( pNewEntry );
-	new( pNewEntry ) Entry( rEntry );
-
-	m_entries.Push( pNewEntry );
-
-	return pNewEntry;
-}
@@ -35,10 +35,10 @@ namespace Helium
 	class HELIUM_ENGINE_API AssetPath
 	{
 	public:
-		/// Number of object path hash table buckets (prime numbers are recommended).
-		static const size_t TABLE_BUCKET_COUNT = 37;
-		/// Asset path stack memory heap block size.
-		static const size_t STACK_HEAP_BLOCK_SIZE = sizeof( char ) * 8192;
+		/// Initial number of object path hash table slots (must be a power of two).
+		static const size_t INITIAL_TABLE_CAPACITY = 4096;
+		/// Number of entries allocated at a time by each thread's entry arena.
+		static const size_t ENTRY_BLOCK_SIZE = 512;
 		/// Block size for pool of pending links
 		static const size_t PENDING_LINKS_POOL_BLOCK_SIZE = 64;
 
@@ -92,6 +92,11 @@ namespace Helium
 		static void Shutdown();
 		//@}
 
+		/// @name Bulk Interning
+		//@{
+		static bool InternPaths( const char* const* ppStrings, size_t stringCount, AssetPath* pPaths );
+		//@}
+
 		/// @name File Support
 		//@{
 		static void ConvertStringToFilePath( String& rFilePath, const String& rPackagePath );
@@ -100,6 +105,9 @@ namespace Helium
 	private:
 
 		struct PendingLink;
+		struct Table;
+		struct EntryBlock;
+		struct EntryArena;
 
 		/// Asset path entry.
 		struct Entry
@@ -112,32 +120,20 @@ namespace Helium
 			uint32_t instanceIndex;
 			/// True if the object is a package.
 			bool bPackage;
-		};
 
-		/// Asset path hash table bucket.
-		class TableBucket
-		{
-		public:
-			/// @name Access
-			//@{
-			Entry* Find( const Entry& rEntry, size_t& rEntryCount );
-			Entry* Add( const Entry& rEntry, size_t previousEntryCount );
-			//@}
-
-		private:
-			/// Array of entry pointers.
-			DynamicArray< Entry* > m_entries;
-			/// Read-write lock for synchronizing access.
-			ReadWriteLock m_lock;
+			/// Hash of the full path contents (computed when the entry is added to the table).
+			size_t hash;
+			/// Cached string representation of the full path (built on demand).
+			const char* volatile pString;
 		};
 
 		/// Asset path entry.
 		Entry* m_pEntry;
 
-		/// Asset path hash table.
-		static TableBucket* sm_pTable;
-		/// Stack-based memory heap for object path entry allocations.
-		static StackMemoryHeap<>* sm_pEntryMemoryHeap;
+		/// Current asset path hash table (open addressing, insert-only).
+		static Table* volatile sm_pTable;
+		/// Per-thread entry arenas.
+		static EntryArena* volatile sm_pEntryArenas;
 		static ObjectPool<PendingLink> *sm_pPendingLinksPool;
 
 		/// @name Private Utility Functions
@@ -152,11 +148,16 @@ namespace Helium
 			size_t& rNameCount, size_t& rPackageCount );
 
 		static Entry* Add( const Entry& rEntry );
+		static Table* CreateTable( size_t capacity );
+		static void GrowTable( Table* pTable );
+
+		static Entry* AllocateEntry( const Entry& rEntry, size_t hash );
+		static void FreeLastEntry( Entry* pEntry );
 
-		static void EntryToString( const Entry& rEntry, String& rString );
+		static const char* GetEntryString( Entry& rEntry );
 		static void EntryToFilePathString( const Entry& rEntry, String& rString );
 
-		static size_t ComputeEntryStringHash( const Entry& rEntry );
+		static size_t ComputeEntryHash( const Entry& rEntry );
 		static bool EntryContentsMatch( const Entry& rEntry0, const Entry& rEntry1 );
 		//@}
 	};
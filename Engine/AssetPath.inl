@@ -154,14 +154,15 @@ bool Helium::AssetPath::IsEmpty() const
 	return ( m_pEntry == NULL );
 }
 
-/// Compute a hash value for this object path (fast, should only be used with entries already in the object path
-/// table).
+/// Compute a hash value for this object path.
+///
+/// The hash of each path is computed from its contents once when the path is first added to the object path table, so
+/// this only needs to return the stored value.
 ///
 /// @return  Hash value.
 size_t Helium::AssetPath::ComputeHash() const
 {
-	// Each AssetPath entry has a unique Entry pointer, so we can use the address itself as a hash.
-	return static_cast< size_t >( reinterpret_cast< uintptr_t >( m_pEntry ) );
+	return ( m_pEntry ? m_pEntry->hash : 0 );
 }
 
 /// Equality comparison operator.
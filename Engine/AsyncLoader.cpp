@@ -2,6 +2,7 @@
 #include "Engine/AsyncLoader.h"
 
 #include "Engine/FileLocations.h"
+#include "Engine/FrameProfiler.h"
 #include "Foundation/FileStream.h"
 
 using namespace Helium;
@@ -203,6 +204,21 @@ void AsyncLoader::Unlock()
 	}
 }
 
+/// Set a condition to signal each time a request has finished processing.
+///
+/// This allows a thread waiting on file I/O to sleep until a read completes instead of polling.  Only one condition can
+/// be set at a time.
+///
+/// @param[in] pCondition  Condition to signal, or null to stop signaling the previously set condition.  Once this
+///                        returns, the previous condition will no longer be accessed.
+void AsyncLoader::SetCompletionCondition( Condition* pCondition )
+{
+	if( m_pWorker )
+	{
+		m_pWorker->SetCompletionCondition( pCondition );
+	}
+}
+
 /// Get the singleton AsyncLoader instance, creating it if necessary.
 ///
 /// @return  Reference to the AsyncLoader instance.
@@ -235,6 +251,7 @@ void AsyncLoader::DestroyStaticInstance()
 /// Constructor.
 AsyncLoader::LoadWorker::LoadWorker()
 	: m_wakeUpCondition( false, false )
+	, m_pCompletionCondition( NULL )
 	, m_stopCounter( 0 )
 	, m_processingCounter( 0 )
 {
@@ -248,6 +265,8 @@ AsyncLoader::LoadWorker::~LoadWorker()
 /// Execute the async loading work.
 void AsyncLoader::LoadWorker::Run()
 {
+	HELIUM_FRAME_PROFILE_THREAD_SCOPE( "AsyncLoader" );
+
 	BufferedStream* pBufferedStream = new BufferedStream;
 	HELIUM_ASSERT( pBufferedStream );
 
@@ -271,29 +290,43 @@ void AsyncLoader::LoadWorker::Run()
 
 		HELIUM_ASSERT( pRequest );
 
-		FileStream* pFileStream = FileStream::OpenFileStream( pRequest->fileName, FileStream::MODE_READ );
-		if( !pFileStream )
-		{
-			SetInvalid( pRequest->bytesRead );
-		}
-		else
 		{
-			pRequest->bytesRead = 0;
+			HELIUM_FRAME_PROFILE_SCOPE( "AsyncLoader::Read" );
 
-			pBufferedStream->Open( pFileStream );
-			int64_t offset = pBufferedStream->Seek( pRequest->offset, SeekOrigins::Begin );
-			if( static_cast< uint64_t >( offset ) == pRequest->offset )
+			FileStream* pFileStream = FileStream::OpenFileStream( pRequest->fileName, FileStream::MODE_READ );
+			if( !pFileStream )
 			{
-				pRequest->bytesRead = pBufferedStream->Read( pRequest->pBuffer, 1, pRequest->size );
+				SetInvalid( pRequest->bytesRead );
 			}
+			else
+			{
+				pRequest->bytesRead = 0;
+
+				pBufferedStream->Open( pFileStream );
+				int64_t offset = pBufferedStream->Seek( pRequest->offset, SeekOrigins::Begin );
+				if( static_cast< uint64_t >( offset ) == pRequest->offset )
+				{
+					pRequest->bytesRead = pBufferedStream->Read( pRequest->pBuffer, 1, pRequest->size );
+				}
 
-			pBufferedStream->Open( NULL );
+				pBufferedStream->Open( NULL );
 
-			delete pFileStream;
+				delete pFileStream;
+
+				HELIUM_FRAME_PROFILE_COUNTER_ADD( "AsyncBytesRead", static_cast< int32_t >( pRequest->bytesRead ) );
+			}
 		}
 
 		AtomicExchangeRelease( pRequest->processedCounter, 1 );
 
+		{
+			MutexScopeLock completionConditionLock( m_completionConditionLock );
+			if( m_pCompletionCondition )
+			{
+				m_pCompletionCondition->Signal();
+			}
+		}
+
 		Thread::Yield();
 	}
 
@@ -367,3 +400,14 @@ void AsyncLoader::LoadWorker::Unlock()
 {
 	m_writeLock.UnlockWrite();
 }
+
+/// Set the condition to signal each time a request has been processed.
+///
+/// @param[in] pCondition  Condition to signal, or null to stop signaling.
+///
+/// @see AsyncLoader::SetCompletionCondition()
+void AsyncLoader::LoadWorker::SetCompletionCondition( Condition* pCondition )
+{
+	MutexScopeLock completionConditionLock( m_completionConditionLock );
+	m_pCompletionCondition = pCondition;
+}
@@ -62,6 +62,8 @@ namespace Helium
 
 		void Lock();
 		void Unlock();
+
+		void SetCompletionCondition( Condition* pCondition );
 		//@}
 
 		/// @name Static Access
@@ -118,6 +120,8 @@ namespace Helium
 
 			void Lock();
 			void Unlock();
+
+			void SetCompletionCondition( Condition* pCondition );
 			//@}
 
 		private:
@@ -129,6 +133,11 @@ namespace Helium
 			/// Read-write lock used for synchronization of external file writes.
 			ReadWriteLock m_writeLock;
 
+			/// Condition signaled each time a request has been processed (can be null).
+			Condition* m_pCompletionCondition;
+			/// Lock synchronizing changes to the completion condition with its use by the worker thread.
+			Mutex m_completionConditionLock;
+
 			/// Non-zero if this thread should stop when next possible, zero if it should continue.
 			volatile int32_t m_stopCounter;
 			/// Non-zero if this thread is currently processing a load request.
@@ -0,0 +1,636 @@
+#include "EnginePch.h"
+#include "Engine/BootSnapshot.h"
+
+#include "Platform/File.h"
+#include "Foundation/FileStream.h"
+#include "Engine/AsyncLoader.h"
+#include "Engine/CacheManager.h"
+
+using namespace Helium;
+
+/// Snapshot header magic number.
+static const uint32_t BOOT_SNAPSHOT_MAGIC = 0xb0075a9c;
+/// Snapshot format version number.
+const uint32_t BootSnapshot::sm_Version = 0;
+/// Maximum amount of entry data recorded for a snapshot, in bytes (recording stops once this is reached, in case boot
+/// completion is never reported).
+static const size_t MAX_RECORDED_DATA_SIZE = 64 * 1024 * 1024;
+
+BootSnapshot* BootSnapshot::sm_pInstance = NULL;
+
+/// Read a value from the snapshot buffer, checking the buffer bounds in the process.
+///
+/// @param[out] rValue      Read value.
+/// @param[in]  rpCurrent   Pointer to the current offset within the snapshot buffer.
+/// @param[in]  pMax        Pointer to the end of the snapshot buffer.
+///
+/// @return  True if the value was read successfully, false if not.
+template< typename T >
+static bool CheckedSnapshotRead( T& rValue, const uint8_t*& rpCurrent, const uint8_t* pMax )
+{
+	if( rpCurrent + sizeof( rValue ) > pMax )
+	{
+		return false;
+	}
+
+	MemoryCopy( &rValue, rpCurrent, sizeof( rValue ) );
+	rpCurrent += sizeof( rValue );
+
+	return true;
+}
+
+/// Read a null-terminated string from the snapshot buffer, checking the buffer bounds in the process.
+///
+/// @param[out] rpString   Pointer to the string within the snapshot buffer.
+/// @param[in]  rpCurrent  Pointer to the current offset within the snapshot buffer.
+/// @param[in]  pMax       Pointer to the end of the snapshot buffer.
+///
+/// @return  True if the string was read successfully, false if not.
+static bool CheckedSnapshotStringRead( const char*& rpString, const uint8_t*& rpCurrent, const uint8_t* pMax )
+{
+	uint16_t stringSize;
+	if( !CheckedSnapshotRead( stringSize, rpCurrent, pMax ) )
+	{
+		return false;
+	}
+
+	if( static_cast< size_t >( pMax - rpCurrent ) <= stringSize || rpCurrent[ stringSize ] != 0 )
+	{
+		return false;
+	}
+
+	rpString = reinterpret_cast< const char* >( rpCurrent );
+	rpCurrent += stringSize + 1;
+
+	return true;
+}
+
+/// Write a string to the snapshot file, including its null terminator.
+///
+/// @param[in] pStream  Stream to which the string should be written.
+/// @param[in] rString  String to write.
+static void WriteSnapshotString( Stream* pStream, const String& rString )
+{
+	HELIUM_ASSERT( pStream );
+	HELIUM_ASSERT( rString.GetSize() < UINT16_MAX );
+
+	uint16_t stringSize = static_cast< uint16_t >( rString.GetSize() );
+	pStream->Write( &stringSize, sizeof( stringSize ), 1 );
+	pStream->Write( *rString, sizeof( char ), stringSize );
+
+	char terminator = TXT( '\0' );
+	pStream->Write( &terminator, sizeof( terminator ), 1 );
+}
+
+/// Constructor.
+BootSnapshot::BootSnapshot()
+: m_asyncLoadId( Invalid< size_t >() )
+, m_hitCount( 0 )
+, m_bLoaded( false )
+, m_bRecording( false )
+{
+}
+
+/// Destructor.
+BootSnapshot::~BootSnapshot()
+{
+	if( IsValid( m_asyncLoadId ) )
+	{
+		AsyncLoader::GetStaticInstance().SyncRequest( m_asyncLoadId );
+		SetInvalid( m_asyncLoadId );
+	}
+}
+
+/// Begin asynchronous loading of the boot snapshot.
+///
+/// If the snapshot file does not exist, loading completes immediately and the cache entries read during boot are
+/// recorded so that a snapshot can be written once boot has finished.
+///
+/// @param[in] rFileName  Snapshot file path name.
+///
+/// @return  True if loading was started successfully, false if not.
+///
+/// @see TryFinishLoad(), FinishBoot()
+bool BootSnapshot::BeginLoad( const String& rFileName )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	if( m_bLoaded || IsValid( m_asyncLoadId ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "BootSnapshot::BeginLoad(): Snapshot \"%s\" has already been loaded.\n" ),
+			*m_fileName );
+
+		return false;
+	}
+
+	m_fileName = rFileName;
+
+	Status status;
+	status.Read( *m_fileName );
+	int64_t fileSize = status.m_Size;
+	if( fileSize <= 0 || static_cast< uint64_t >( fileSize ) >= UINT32_MAX )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "BootSnapshot: No usable snapshot found at \"%s\"; recording assets loaded during boot.\n" ),
+			*m_fileName );
+
+		m_bLoaded = true;
+		m_bRecording = true;
+
+		return false;
+	}
+
+	m_data.Resize( static_cast< size_t >( fileSize ) );
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+	m_asyncLoadId = rLoader.QueueRequest( m_data.GetData(), m_fileName, 0, m_data.GetSize(), AsyncLoader::PRIORITY_HIGH );
+	HELIUM_ASSERT( IsValid( m_asyncLoadId ) );
+	if( IsInvalid( m_asyncLoadId ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "BootSnapshot::BeginLoad(): Failed to begin asynchronous load of \"%s\".\n" ),
+			*m_fileName );
+
+		Clear();
+		m_bLoaded = true;
+		m_bRecording = true;
+
+		return false;
+	}
+
+	return true;
+}
+
+/// Test for and finalize asynchronous loading of the boot snapshot in a non-blocking fashion.
+///
+/// Once the snapshot has been read, each entry is checked against the table of contents of its cache, waiting for
+/// the tables of contents to load if necessary.  If any entry is missing from its cache or has changed since the
+/// snapshot was recorded, the entire snapshot is discarded and a new one is recorded during this boot.
+///
+/// @return  True if loading has completed or is not in progress, false if loading is still in progress.
+///
+/// @see BeginLoad(), IsLoaded()
+bool BootSnapshot::TryFinishLoad()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	if( m_bLoaded )
+	{
+		return true;
+	}
+
+	// Nothing to wait for if no snapshot load was started.
+	if( m_fileName.IsEmpty() )
+	{
+		m_bLoaded = true;
+
+		return true;
+	}
+
+	if( IsValid( m_asyncLoadId ) )
+	{
+		AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+
+		size_t bytesRead = 0;
+		if( !rLoader.TrySyncRequest( m_asyncLoadId, bytesRead ) )
+		{
+			return false;
+		}
+
+		SetInvalid( m_asyncLoadId );
+
+		if( bytesRead != m_data.GetSize() || !ReadSnapshot() )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "BootSnapshot: Failed to read snapshot \"%s\"; recording a new snapshot during boot.\n" ),
+				*m_fileName );
+
+			Clear();
+			m_bLoaded = true;
+			m_bRecording = true;
+
+			return true;
+		}
+	}
+
+	// Wait for the tables of contents of all caches referenced by the snapshot.
+	CacheManager& rCacheManager = CacheManager::GetStaticInstance();
+
+	size_t entryCount = m_entries.GetSize();
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		Cache* pCache = rCacheManager.GetCache( m_entries[ entryIndex ].cacheName );
+		if( pCache && !pCache->IsTocLoaded() && !pCache->TryFinishLoadToc() )
+		{
+			return false;
+		}
+	}
+
+	if( !ValidateSnapshot() )
+	{
+		Clear();
+		m_bRecording = true;
+	}
+	else
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "BootSnapshot: Loaded %" ) PRIuSZ TXT( " entries (%" ) PRIuSZ TXT( " bytes) from \"%s\".\n" ),
+			m_entries.GetSize(),
+			m_data.GetSize(),
+			*m_fileName );
+	}
+
+	m_bLoaded = true;
+
+	return true;
+}
+
+/// Copy the data for a cache entry out of the snapshot.
+///
+/// @param[in]  pEntry   Cache entry to look up.
+/// @param[out] pBuffer  Buffer to fill with the entry data (must be at least as large as the entry size).
+///
+/// @return  True if the entry data was copied, false if the entry is not in the snapshot (in which case it should be
+///          read from its cache file).
+bool BootSnapshot::CopyEntryData( const Cache::Entry* pEntry, void* pBuffer )
+{
+	HELIUM_ASSERT( pEntry );
+	HELIUM_ASSERT( pBuffer );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	if( !m_bLoaded || m_bRecording )
+	{
+		return false;
+	}
+
+	HashMap< AssetPath, size_t >::ConstIterator entryIterator = m_entryMap.Find( pEntry->path );
+	if( entryIterator == m_entryMap.End() )
+	{
+		return false;
+	}
+
+	const Entry& rEntry = m_entries[ entryIterator->Second() ];
+	if( rEntry.pCacheEntry != pEntry )
+	{
+		return false;
+	}
+
+	HELIUM_ASSERT( rEntry.dataOffset + rEntry.size <= m_data.GetSize() );
+	MemoryCopy( pBuffer, m_data.GetData() + rEntry.dataOffset, rEntry.size );
+	++m_hitCount;
+
+	return true;
+}
+
+/// Record a cache entry read during boot for inclusion in a new snapshot.
+///
+/// Nothing is recorded if no snapshot is being recorded, if the entry has already been recorded, or if the data read
+/// does not cover the entire entry.  If the recorded data would exceed MAX_RECORDED_DATA_SIZE, recording is abandoned
+/// and everything recorded so far is released, so that no snapshot is written for this launch.
+///
+/// @param[in] pCache  Cache from which the entry was read.
+/// @param[in] pEntry  Cache entry that was read.
+/// @param[in] pData   Entry data.
+/// @param[in] size    Number of bytes of entry data that were read.
+///
+/// @see IsRecording(), FinishBoot()
+void BootSnapshot::RecordEntry( const Cache* pCache, const Cache::Entry* pEntry, const void* pData, uint32_t size )
+{
+	HELIUM_ASSERT( pCache );
+	HELIUM_ASSERT( pEntry );
+	HELIUM_ASSERT( pData || size == 0 );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	if( !m_bRecording || size != pEntry->size )
+	{
+		return;
+	}
+
+	size_t dataOffset = m_data.GetSize();
+	if( size > MAX_RECORDED_DATA_SIZE - dataOffset )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "BootSnapshot: Recorded data limit of %" ) PRIuSZ TXT( " bytes reached after %" ) PRIuSZ
+			TXT( " entries; abandoning the snapshot.\n" ),
+			MAX_RECORDED_DATA_SIZE,
+			m_entries.GetSize() );
+
+		m_bRecording = false;
+		Clear();
+
+		return;
+	}
+
+	HashMap< AssetPath, size_t >::Iterator entryIterator;
+	if( !m_entryMap.Insert( entryIterator, KeyValue< AssetPath, size_t >( pEntry->path, m_entries.GetSize() ) ) )
+	{
+		return;
+	}
+
+	m_data.Resize( dataOffset + size );
+	MemoryCopy( m_data.GetData() + dataOffset, pData, size );
+
+	Entry* pSnapshotEntry = m_entries.New();
+	HELIUM_ASSERT( pSnapshotEntry );
+	pSnapshotEntry->cacheName = pCache->GetName();
+	pSnapshotEntry->path = pEntry->path;
+	pSnapshotEntry->subDataIndex = pEntry->subDataIndex;
+	pSnapshotEntry->timestamp = pEntry->timestamp;
+	pSnapshotEntry->cacheOffset = pEntry->offset;
+	pSnapshotEntry->dataOffset = dataOffset;
+	pSnapshotEntry->size = size;
+	pSnapshotEntry->pCacheEntry = pEntry;
+}
+
+/// Notify the snapshot that boot has completed.
+///
+/// If a new snapshot was being recorded, it is written out.  In either case, all snapshot data is released, as any
+/// further loads use the normal cache load path.
+///
+/// @return  True if no snapshot needed to be written or it was written successfully, false if writing failed.
+bool BootSnapshot::FinishBoot()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	if( IsValid( m_asyncLoadId ) )
+	{
+		AsyncLoader::GetStaticInstance().SyncRequest( m_asyncLoadId );
+		SetInvalid( m_asyncLoadId );
+	}
+
+	bool bResult = true;
+	if( m_bRecording )
+	{
+		if( !m_entries.IsEmpty() )
+		{
+			bResult = WriteSnapshot();
+		}
+
+		m_bRecording = false;
+	}
+	else if( !m_entries.IsEmpty() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "BootSnapshot: %" ) PRIuSZ TXT( " of %" ) PRIuSZ TXT( " snapshot entries used during boot.\n" ),
+			m_hitCount,
+			m_entries.GetSize() );
+	}
+
+	Clear();
+	m_bLoaded = true;
+
+	return bResult;
+}
+
+/// Stop recording and release all snapshot data without writing a snapshot.
+///
+/// This is called when the cache asset loader shuts down, so that hosts that never report boot completion through
+/// FinishBoot() stop recording the entries they read.  It has no effect once FinishBoot() has been called.
+///
+/// @see FinishBoot()
+void BootSnapshot::Cancel()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	if( IsValid( m_asyncLoadId ) )
+	{
+		AsyncLoader::GetStaticInstance().SyncRequest( m_asyncLoadId );
+		SetInvalid( m_asyncLoadId );
+	}
+
+	m_bRecording = false;
+
+	Clear();
+	m_bLoaded = true;
+}
+
+/// Get the singleton BootSnapshot instance, creating it if necessary.
+///
+/// @return  Reference to the BootSnapshot instance.
+///
+/// @see DestroyStaticInstance()
+BootSnapshot& BootSnapshot::GetStaticInstance()
+{
+	if( !sm_pInstance )
+	{
+		sm_pInstance = new BootSnapshot;
+		HELIUM_ASSERT( sm_pInstance );
+	}
+
+	return *sm_pInstance;
+}
+
+/// Destroy the singleton BootSnapshot instance.
+///
+/// @see GetStaticInstance()
+void BootSnapshot::DestroyStaticInstance()
+{
+	delete sm_pInstance;
+	sm_pInstance = NULL;
+}
+
+/// Parse the entry table of a snapshot file loaded into the data buffer.
+///
+/// Entry data is left in place, with each entry's data offset pointing into the loaded file contents.
+///
+/// @return  True if the snapshot was parsed successfully, false if not.
+bool BootSnapshot::ReadSnapshot()
+{
+	const uint8_t* pCurrent = m_data.GetData();
+	const uint8_t* pMax = pCurrent + m_data.GetSize();
+
+	uint32_t magic;
+	uint32_t version;
+	uint32_t entryCount;
+	if( !CheckedSnapshotRead( magic, pCurrent, pMax ) ||
+		!CheckedSnapshotRead( version, pCurrent, pMax ) ||
+		!CheckedSnapshotRead( entryCount, pCurrent, pMax ) )
+	{
+		return false;
+	}
+
+	if( magic != BOOT_SNAPSHOT_MAGIC || version != sm_Version )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "BootSnapshot: Snapshot \"%s\" was written by a different version of the engine.\n" ),
+			*m_fileName );
+
+		return false;
+	}
+
+	m_entries.Reserve( entryCount );
+
+	uint64_t dataSize = 0;
+	for( uint32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		const char* pCacheName;
+		const char* pPath;
+		if( !CheckedSnapshotStringRead( pCacheName, pCurrent, pMax ) ||
+			!CheckedSnapshotStringRead( pPath, pCurrent, pMax ) )
+		{
+			return false;
+		}
+
+		Entry* pEntry = m_entries.New();
+		HELIUM_ASSERT( pEntry );
+		pEntry->cacheName.Set( pCacheName );
+		pEntry->pCacheEntry = NULL;
+
+		if( !pEntry->path.Set( pPath ) ||
+			!CheckedSnapshotRead( pEntry->subDataIndex, pCurrent, pMax ) ||
+			!CheckedSnapshotRead( pEntry->timestamp, pCurrent, pMax ) ||
+			!CheckedSnapshotRead( pEntry->cacheOffset, pCurrent, pMax ) ||
+			!CheckedSnapshotRead( pEntry->size, pCurrent, pMax ) )
+		{
+			return false;
+		}
+
+		pEntry->dataOffset = dataSize;
+		dataSize += pEntry->size;
+	}
+
+	// Entry data follows the entry table.
+	size_t dataStart = static_cast< size_t >( pCurrent - m_data.GetData() );
+	if( static_cast< uint64_t >( pMax - pCurrent ) != dataSize )
+	{
+		return false;
+	}
+
+	for( uint32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		m_entries[ entryIndex ].dataOffset += dataStart;
+	}
+
+	return true;
+}
+
+/// Match each snapshot entry to its cache entry and build the entry lookup map.
+///
+/// The tables of contents of all caches referenced by the snapshot must have been loaded.
+///
+/// @return  True if every entry matches its cache entry, false if any entry is missing or stale.
+bool BootSnapshot::ValidateSnapshot()
+{
+	CacheManager& rCacheManager = CacheManager::GetStaticInstance();
+
+	size_t entryCount = m_entries.GetSize();
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		Entry& rEntry = m_entries[ entryIndex ];
+
+		Cache* pCache = rCacheManager.GetCache( rEntry.cacheName );
+		const Cache::Entry* pCacheEntry = ( pCache ? pCache->FindEntry( rEntry.path, rEntry.subDataIndex ) : NULL );
+		if( !pCacheEntry ||
+			pCacheEntry->timestamp != rEntry.timestamp ||
+			pCacheEntry->offset != rEntry.cacheOffset ||
+			pCacheEntry->size != rEntry.size )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Info,
+				TXT( "BootSnapshot: Snapshot \"%s\" is stale (\"%s\" in cache \"%s\" has changed); recording a new snapshot during boot.\n" ),
+				*m_fileName,
+				*rEntry.path.ToString(),
+				*rEntry.cacheName );
+
+			return false;
+		}
+
+		rEntry.pCacheEntry = pCacheEntry;
+
+		HashMap< AssetPath, size_t >::Iterator entryIterator;
+		if( !m_entryMap.Insert( entryIterator, KeyValue< AssetPath, size_t >( rEntry.path, entryIndex ) ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "BootSnapshot: Duplicate entry for \"%s\" in snapshot \"%s\".\n" ),
+				*rEntry.path.ToString(),
+				*m_fileName );
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// Write out all recorded entries as a new snapshot file.
+///
+/// @return  True if the snapshot was written successfully, false if not.
+bool BootSnapshot::WriteSnapshot()
+{
+	HELIUM_ASSERT( !m_fileName.IsEmpty() );
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+	rLoader.Lock();
+
+	FileStream* pFileStream = FileStream::OpenFileStream( m_fileName, FileStream::MODE_WRITE, true );
+	if( !pFileStream )
+	{
+		rLoader.Unlock();
+
+		HELIUM_TRACE( TraceLevels::Warning, TXT( "BootSnapshot: Failed to open \"%s\" for writing.\n" ), *m_fileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pFileStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	pBufferedStream->Write( &BOOT_SNAPSHOT_MAGIC, sizeof( BOOT_SNAPSHOT_MAGIC ), 1 );
+	pBufferedStream->Write( &sm_Version, sizeof( sm_Version ), 1 );
+
+	uint32_t entryCount = static_cast< uint32_t >( m_entries.GetSize() );
+	pBufferedStream->Write( &entryCount, sizeof( entryCount ), 1 );
+
+	String pathString;
+	for( uint32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		const Entry& rEntry = m_entries[ entryIndex ];
+
+		WriteSnapshotString( pBufferedStream, String( *rEntry.cacheName ) );
+
+		rEntry.path.ToString( pathString );
+		WriteSnapshotString( pBufferedStream, pathString );
+
+		pBufferedStream->Write( &rEntry.subDataIndex, sizeof( rEntry.subDataIndex ), 1 );
+		pBufferedStream->Write( &rEntry.timestamp, sizeof( rEntry.timestamp ), 1 );
+		pBufferedStream->Write( &rEntry.cacheOffset, sizeof( rEntry.cacheOffset ), 1 );
+		pBufferedStream->Write( &rEntry.size, sizeof( rEntry.size ), 1 );
+	}
+
+	// Entries are recorded in the order in which they were read, so the data can be written out as a single block.
+	pBufferedStream->Write( m_data.GetData(), 1, m_data.GetSize() );
+
+	delete pBufferedStream;
+	delete pFileStream;
+
+	rLoader.Unlock();
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "BootSnapshot: Wrote %" ) PRIu32 TXT( " entries (%" ) PRIuSZ TXT( " bytes of data) to \"%s\".\n" ),
+		entryCount,
+		m_data.GetSize(),
+		*m_fileName );
+
+	return true;
+}
+
+/// Release all entries and entry data.
+void BootSnapshot::Clear()
+{
+	m_entries.Clear();
+	m_entryMap.Clear();
+	m_data.Clear();
+}
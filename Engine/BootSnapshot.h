@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+#include "Platform/Locks.h"
+#include "Foundation/HashMap.h"
+#include "Engine/AssetPath.h"
+#include "Engine/Cache.h"
+
+/// Boot snapshot file base name.
+#define HELIUM_BOOT_SNAPSHOT_NAME TXT( "Boot" )
+/// Boot snapshot file extension.
+#define HELIUM_BOOT_SNAPSHOT_EXTENSION TXT( "bootsnapshot" )
+
+namespace Helium
+{
+	/// Snapshot of the cached data read while booting the engine.
+	///
+	/// Without a snapshot, each asset loaded during boot (configuration, default render resources, system and world
+	/// definitions, etc.) issues its own cache lookup and file read.  While no valid snapshot exists, the cache entries
+	/// read during boot are recorded, and once the first frame has finished they are written out back-to-back in a
+	/// single file.  On later launches, the whole snapshot is read in one request and CachePackageLoader copies entry
+	/// data out of it instead of reading from the cache file.  The snapshot is only used if every entry in it still
+	/// matches its cache entry; otherwise it is discarded in favor of the normal load path and recorded again.
+	class HELIUM_ENGINE_API BootSnapshot : NonCopyable
+	{
+	public:
+		/// Current snapshot file format version number.
+		static const uint32_t sm_Version;
+
+		/// @name Loading
+		//@{
+		bool BeginLoad( const String& rFileName );
+		bool TryFinishLoad();
+		inline bool IsLoaded() const;
+
+		bool CopyEntryData( const Cache::Entry* pEntry, void* pBuffer );
+		//@}
+
+		/// @name Recording
+		//@{
+		inline bool IsRecording() const;
+		void RecordEntry( const Cache* pCache, const Cache::Entry* pEntry, const void* pData, uint32_t size );
+		//@}
+
+		/// @name Boot Completion
+		//@{
+		bool FinishBoot();
+		void Cancel();
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline const String& GetFileName() const;
+		inline size_t GetEntryCount() const;
+		inline size_t GetHitCount() const;
+		//@}
+
+		/// @name Static Access
+		//@{
+		static BootSnapshot& GetStaticInstance();
+		static void DestroyStaticInstance();
+		//@}
+
+	private:
+		/// Snapshot entry information.
+		struct Entry
+		{
+			/// Name of the cache containing the entry.
+			Name cacheName;
+			/// Entry path name.
+			AssetPath path;
+			/// Sub-data index.
+			uint32_t subDataIndex;
+
+			/// Timestamp of the cache entry when the snapshot was recorded.
+			int64_t timestamp;
+			/// Offset of the entry within the cache file when the snapshot was recorded.
+			uint64_t cacheOffset;
+			/// Offset of the entry data within the snapshot data.
+			uint64_t dataOffset;
+			/// Entry size.
+			uint32_t size;
+
+			/// Cache entry matching this entry (only valid once the snapshot has been loaded and validated).
+			const Cache::Entry* pCacheEntry;
+		};
+
+		/// Snapshot file name.
+		String m_fileName;
+
+		/// Snapshot entries, in the order in which they were recorded.
+		DynamicArray< Entry > m_entries;
+		/// Snapshot entry lookup by path.
+		HashMap< AssetPath, size_t > m_entryMap;
+		/// Snapshot data (the entire file contents once loaded, or the recorded entry data while recording).
+		DynamicArray< uint8_t > m_data;
+
+		/// Lock synchronizing entry access between the load thread and the main thread.
+		Mutex m_lock;
+
+		/// Asynchronous snapshot load ID.
+		size_t m_asyncLoadId;
+		/// Number of entries served from the snapshot.
+		size_t m_hitCount;
+
+		/// True once the load process has completed (whether or not a valid snapshot was found).
+		bool m_bLoaded;
+		/// True if the cache entries read during boot are being recorded.
+		bool m_bRecording;
+
+		/// Singleton instance.
+		static BootSnapshot* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		BootSnapshot();
+		~BootSnapshot();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		bool ReadSnapshot();
+		bool ValidateSnapshot();
+		bool WriteSnapshot();
+		void Clear();
+		//@}
+	};
+}
+
+#include "Engine/BootSnapshot.inl"
@@ -0,0 +1,43 @@
+/// Get whether the snapshot load process has completed.
+///
+/// @return  True if loading has completed (whether or not a valid snapshot was found), false if not.
+///
+/// @see BeginLoad(), TryFinishLoad()
+bool Helium::BootSnapshot::IsLoaded() const
+{
+	return m_bLoaded;
+}
+
+/// Get whether the cache entries read during boot are being recorded for a new snapshot.
+///
+/// @return  True if recording, false if not.
+///
+/// @see RecordEntry(), FinishBoot()
+bool Helium::BootSnapshot::IsRecording() const
+{
+	return m_bRecording;
+}
+
+/// Get the path name of the snapshot file.
+///
+/// @return  Snapshot file path name.
+const Helium::String& Helium::BootSnapshot::GetFileName() const
+{
+	return m_fileName;
+}
+
+/// Get the number of entries in the loaded snapshot, or the number of entries recorded so far while recording.
+///
+/// @return  Entry count.
+size_t Helium::BootSnapshot::GetEntryCount() const
+{
+	return m_entries.GetSize();
+}
+
+/// Get the number of cache entries served from the snapshot instead of being read from their cache files.
+///
+/// @return  Snapshot hit count.
+size_t Helium::BootSnapshot::GetHitCount() const
+{
+	return m_hitCount;
+}
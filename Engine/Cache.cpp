@@ -40,6 +40,8 @@ Cache::Cache()
 : m_name( NULL_NAME )
 , m_platform( PLATFORM_INVALID )
 , m_bTocLoaded( false )
+, m_bBatchUpdate( false )
+, m_bTocDirty( false )
 , m_asyncLoadId( Invalid< size_t >() )
 , m_pTocBuffer( NULL )
 , m_tocSize( Invalid< uint32_t >() )
@@ -110,6 +112,12 @@ bool Cache::Initialize( Name name, EPlatform platform, const char* pTocFileName,
 /// @see Initialize()
 void Cache::Shutdown()
 {
+	// Don't lose any entries cached during an unfinished batch update.
+	if( m_bBatchUpdate )
+	{
+		EndBatchUpdate();
+	}
+
 	m_name = NULL_NAME;
 	m_platform = PLATFORM_INVALID;
 
@@ -127,6 +135,8 @@ void Cache::Shutdown()
 	SetInvalid( m_tocSize );
 
 	m_bTocLoaded = false;
+	m_bBatchUpdate = false;
+	m_bTocDirty = false;
 
 	m_entries.Clear();
 	m_entryMap.Clear();
@@ -300,6 +310,42 @@ void Cache::EnforceTocLoad()
 	}
 }
 
+/// Begin a batch of cache updates.
+///
+/// Normally, the table of contents is rewritten every time an entry is cached, which becomes the dominant cost when
+/// caching large numbers of entries at once.  Between calls to BeginBatchUpdate() and EndBatchUpdate(), the TOC is
+/// only written once, when the batch ends.  Note that entries cached during a batch will not be visible to other
+/// processes reading the cache until the batch has ended.
+///
+/// @see EndBatchUpdate(), IsBatchUpdating()
+void Cache::BeginBatchUpdate()
+{
+	m_bBatchUpdate = true;
+}
+
+/// End a batch of cache updates, writing out the table of contents if any entries were cached during the batch.
+///
+/// @return  True if the TOC was written successfully or did not need to be written, false if writing failed.
+///
+/// @see BeginBatchUpdate(), IsBatchUpdating()
+bool Cache::EndBatchUpdate()
+{
+	m_bBatchUpdate = false;
+
+	if( !m_bTocDirty )
+	{
+		return true;
+	}
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+
+	rLoader.Lock();
+	bool bResult = WriteToc();
+	rLoader.Unlock();
+
+	return bResult;
+}
+
 /// Search for a cache entry with the given object path name.
 ///
 /// @param[in] path          Asset path.
@@ -473,57 +519,76 @@ bool Cache::CacheEntry(
 			}
 			else
 			{
-				HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Rewriting TOC file \"%s\".\n" ), *m_tocFileName );
-
-				FileStream* pTocStream = FileStream::OpenFileStream( m_tocFileName, FileStream::MODE_WRITE, true );
-				if( !pTocStream )
+				// During a batch update, the TOC is written once when the batch ends instead of after every entry.
+				m_bTocDirty = true;
+				if( !m_bBatchUpdate )
 				{
-					HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *m_tocFileName );
+					WriteToc();
 				}
-				else
-				{
-					BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
-					HELIUM_ASSERT( pBufferedStream );
+			}
+		}
+
+		delete pCacheStream;
+	}
 
-					pBufferedStream->Write( &TOC_MAGIC, sizeof( TOC_MAGIC ), 1 );
-					pBufferedStream->Write( &sm_Version, sizeof( sm_Version ), 1 );
+	rLoader.Unlock();
 
-					uint32_t entryCount = static_cast< uint32_t >( m_entries.GetSize() );
-					pBufferedStream->Write( &entryCount, sizeof( entryCount ), 1 );
+	return bCacheSuccess;
+}
 
-					String entryPath;
-					uint_fast32_t entryCountFast = entryCount;
-					for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
-					{
-						Entry* pEntry = m_entries[ entryIndex ];
-						HELIUM_ASSERT( pEntry );
+/// Write out the table of contents for all current cache entries.
+///
+/// The AsyncLoader lock must be held by the caller.
+///
+/// @return  True if the TOC was written successfully, false if not.
+bool Cache::WriteToc()
+{
+	HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Rewriting TOC file \"%s\".\n" ), *m_tocFileName );
 
-						pEntry->path.ToString( entryPath );
-						HELIUM_ASSERT( entryPath.GetSize() < UINT16_MAX );
-						uint16_t pathSize = static_cast< uint16_t >( entryPath.GetSize() );
-						pBufferedStream->Write( &pathSize, sizeof( pathSize ), 1 );
+	FileStream* pTocStream = FileStream::OpenFileStream( m_tocFileName, FileStream::MODE_WRITE, true );
+	if( !pTocStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *m_tocFileName );
 
-						pBufferedStream->Write( *entryPath, sizeof( char ), pathSize );
+		return false;
+	}
 
-						pBufferedStream->Write( &pEntry->subDataIndex, sizeof( pEntry->subDataIndex ), 1 );
+	BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
+	HELIUM_ASSERT( pBufferedStream );
 
-						pBufferedStream->Write( &pEntry->offset, sizeof( pEntry->offset ), 1 );
-						pBufferedStream->Write( &pEntry->timestamp, sizeof( pEntry->timestamp ), 1 );
-						pBufferedStream->Write( &pEntry->size, sizeof( pEntry->size ), 1 );
-					}
+	pBufferedStream->Write( &TOC_MAGIC, sizeof( TOC_MAGIC ), 1 );
+	pBufferedStream->Write( &sm_Version, sizeof( sm_Version ), 1 );
 
-					delete pBufferedStream;
-					delete pTocStream;
-				}
-			}
-		}
+	uint32_t entryCount = static_cast< uint32_t >( m_entries.GetSize() );
+	pBufferedStream->Write( &entryCount, sizeof( entryCount ), 1 );
 
-		delete pCacheStream;
+	String entryPath;
+	uint_fast32_t entryCountFast = entryCount;
+	for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
+	{
+		Entry* pEntry = m_entries[ entryIndex ];
+		HELIUM_ASSERT( pEntry );
+
+		pEntry->path.ToString( entryPath );
+		HELIUM_ASSERT( entryPath.GetSize() < UINT16_MAX );
+		uint16_t pathSize = static_cast< uint16_t >( entryPath.GetSize() );
+		pBufferedStream->Write( &pathSize, sizeof( pathSize ), 1 );
+
+		pBufferedStream->Write( *entryPath, sizeof( char ), pathSize );
+
+		pBufferedStream->Write( &pEntry->subDataIndex, sizeof( pEntry->subDataIndex ), 1 );
+
+		pBufferedStream->Write( &pEntry->offset, sizeof( pEntry->offset ), 1 );
+		pBufferedStream->Write( &pEntry->timestamp, sizeof( pEntry->timestamp ), 1 );
+		pBufferedStream->Write( &pEntry->size, sizeof( pEntry->size ), 1 );
 	}
 
-	rLoader.Unlock();
+	delete pBufferedStream;
+	delete pTocStream;
 
-	return bCacheSuccess;
+	m_bTocDirty = false;
+
+	return true;
 }
 
 /// Finalize the TOC loading process.
@@ -538,8 +603,6 @@ bool Cache::FinalizeTocLoad()
 	const uint8_t* pTocCurrent = m_pTocBuffer;
 	const uint8_t* pTocMax = pTocCurrent + m_tocSize;
 
-	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
-
 	// Validate the TOC header.
 	uint32_t magic;
 	if( !CheckedTocRead( MemoryCopy, magic, TXT( "the header magic" ), pTocCurrent, pTocMax ) )
@@ -612,11 +675,15 @@ bool Cache::FinalizeTocLoad()
 		return false;
 	}
 
-	// Load the entry information.
-	EntryKey key;
-
+	// Load the entry information.  Entry path strings are gathered first so that they can all be interned in a single
+	// batch.
 	uint_fast32_t entryCountFast = entryCount;
 	m_entries.Reserve( entryCountFast );
+
+	DynamicArray< char > pathStringBuffer;
+	DynamicArray< size_t > pathStringOffsets;
+	pathStringOffsets.Reserve( entryCountFast );
+
 	for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
 	{
 		uint16_t entryPathSize;
@@ -633,10 +700,11 @@ bool Cache::FinalizeTocLoad()
 
 		uint_fast16_t entryPathSizeFast = entryPathSize;
 
-		StackMemoryHeap<>::Marker stackMarker( rStackHeap );
-		char* pPathString = static_cast< char* >( rStackHeap.Allocate(
-			sizeof( char ) * ( entryPathSizeFast + 1 ) ) );
-		HELIUM_ASSERT( pPathString );
+		size_t pathStringOffset = pathStringBuffer.GetSize();
+		pathStringOffsets.Push( pathStringOffset );
+		pathStringBuffer.Resize( pathStringOffset + entryPathSizeFast + 1 );
+
+		char* pPathString = &pathStringBuffer[ pathStringOffset ];
 		pPathString[ entryPathSizeFast ] = TXT( '\0' );
 
 		for( uint_fast16_t characterIndex = 0; characterIndex < entryPathSizeFast; ++characterIndex )
@@ -653,17 +721,6 @@ bool Cache::FinalizeTocLoad()
 			}
 		}
 
-		AssetPath entryPath;
-		if( !entryPath.Set( pPathString ) )
-		{
-			HELIUM_TRACE(
-				TraceLevels::Error,
-				TXT( "Cache::FinalizeTocLoad(): Failed to set AssetPath for entry %" ) PRIuFAST16 TXT( ".\n" ),
-				entryIndex );
-
-			return false;
-		}
-
 		uint32_t entrySubDataIndex;
 		bReadResult = CheckedTocRead(
 			pLoadFunction,
@@ -676,22 +733,6 @@ bool Cache::FinalizeTocLoad()
 			return false;
 		}
 
-		key.path = entryPath;
-		key.subDataIndex = entrySubDataIndex;
-
-		EntryMapType::ConstAccessor entryAccessor;
-		if( m_entryMap.Find( entryAccessor, key ) )
-		{
-			HELIUM_TRACE(
-				TraceLevels::Error,
-				( TXT( "Cache::FinalizeTocLoad(): Duplicate entry found for AssetPath \"%s\", sub-data %" ) PRIu32
-				TXT( ".\n" ) ),
-				pPathString,
-				entrySubDataIndex );
-
-			return false;
-		}
-
 		uint64_t entryOffset;
 		if( !CheckedTocRead( pLoadFunction, entryOffset, TXT( "entry offset" ), pTocCurrent, pTocMax ) )
 		{
@@ -712,13 +753,61 @@ bool Cache::FinalizeTocLoad()
 
 		Entry* pEntry = m_pEntryPool->Allocate();
 		HELIUM_ASSERT( pEntry );
-		pEntry->path = entryPath;
 		pEntry->subDataIndex = entrySubDataIndex;
 		pEntry->offset = entryOffset;
 		pEntry->timestamp = entryTimestamp;
 		pEntry->size = entrySize;
 
 		m_entries.Add( pEntry );
+	}
+
+	// Intern all entry paths.
+	DynamicArray< const char* > pathStrings;
+	pathStrings.Reserve( entryCountFast );
+	for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
+	{
+		pathStrings.Push( &pathStringBuffer[ pathStringOffsets[ entryIndex ] ] );
+	}
+
+	DynamicArray< AssetPath > entryPaths;
+	entryPaths.Resize( entryCountFast );
+	AssetPath::InternPaths( pathStrings.GetData(), entryCountFast, entryPaths.GetData() );
+
+	// Build the entry lookup map.
+	EntryKey key;
+
+	for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
+	{
+		AssetPath entryPath = entryPaths[ entryIndex ];
+		if( entryPath.IsEmpty() )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "Cache::FinalizeTocLoad(): Failed to set AssetPath for entry %" ) PRIuFAST16 TXT( ".\n" ),
+				entryIndex );
+
+			return false;
+		}
+
+		Entry* pEntry = m_entries[ entryIndex ];
+		HELIUM_ASSERT( pEntry );
+		pEntry->path = entryPath;
+
+		key.path = entryPath;
+		key.subDataIndex = pEntry->subDataIndex;
+
+		EntryMapType::ConstAccessor entryAccessor;
+		if( m_entryMap.Find( entryAccessor, key ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				( TXT( "Cache::FinalizeTocLoad(): Duplicate entry found for AssetPath \"%s\", sub-data %" ) PRIu32
+				TXT( ".\n" ) ),
+				pathStrings[ entryIndex ],
+				pEntry->subDataIndex );
+
+			return false;
+		}
 
 		HELIUM_VERIFY( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) );
 	}
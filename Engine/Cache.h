@@ -39,7 +39,7 @@ namespace Helium
 		{
 			/// Entry offset.
 			uint64_t offset;
-			/// Entry timestamp.
+			/// Entry timestamp (for cooked data, the input stamp of the asset it was built from).
 			int64_t timestamp;
 
 			/// Entry path name.
@@ -70,6 +70,10 @@ namespace Helium
 		inline bool IsTocLoaded() const;
 
 		void EnforceTocLoad();
+
+		void BeginBatchUpdate();
+		bool EndBatchUpdate();
+		inline bool IsBatchUpdating() const;
 		//@}
 
 		/// @name Data Access
@@ -137,6 +141,10 @@ namespace Helium
 		/// True if a TOC load request has been fully processed and synced (not indicative of whether the cache files
 		/// actually exist, though).
 		bool m_bTocLoaded;
+		/// True if TOC writes are being deferred until EndBatchUpdate() is called.
+		bool m_bBatchUpdate;
+		/// True if entries have been updated since the TOC was last written.
+		bool m_bTocDirty;
 
 		/// Asynchronous TOC load ID.
 		size_t m_asyncLoadId;
@@ -157,6 +165,11 @@ namespace Helium
 		bool FinalizeTocLoad();
 		//@}
 
+		/// @name Saving Utility Functions
+		//@{
+		bool WriteToc();
+		//@}
+
 		/// @name Private Static Utility Functions
 		//@{
 		template< typename T > static bool CheckedTocRead(
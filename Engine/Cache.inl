@@ -8,6 +8,16 @@ bool Helium::Cache::IsTocLoaded() const
     return m_bTocLoaded;
 }
 
+/// Get whether TOC writes are currently being deferred as part of a batch update.
+///
+/// @return  True if a batch update is in progress, false if not.
+///
+/// @see BeginBatchUpdate(), EndBatchUpdate()
+bool Helium::Cache::IsBatchUpdating() const
+{
+    return m_bBatchUpdate;
+}
+
 /// Get the name used to identify this cache.
 ///
 /// @return  Cache name.
@@ -1,6 +1,8 @@
 #include "EnginePch.h"
 #include "Engine/CacheAssetLoader.h"
 #include "Engine/CachePackageLoader.h"
+#include "Engine/CacheManager.h"
+#include "Engine/BootSnapshot.h"
 #include "Engine/Config.h"
 
 using namespace Helium;
@@ -19,11 +21,21 @@ CacheAssetLoader::CacheAssetLoader()
 	HELIUM_VERIFY( m_pConfigPackageLoader->Initialize( Name( TXT("Config") ) ) );
 
 	HELIUM_VERIFY( m_pConfigPackageLoader->BeginPreload() );
+
+	// Read the boot snapshot alongside the cache tables of contents (a new snapshot is recorded if none exists).
+	String bootSnapshotFileName = CacheManager::GetStaticInstance().GetPlatformDataDirectory();
+	bootSnapshotFileName += HELIUM_BOOT_SNAPSHOT_NAME TXT( "." ) HELIUM_BOOT_SNAPSHOT_EXTENSION;
+	BootSnapshot::GetStaticInstance().BeginLoad( bootSnapshotFileName );
 }
 
 /// Destructor.
 CacheAssetLoader::~CacheAssetLoader()
 {
+	StopLoadThread();
+
+	// Stop recording the boot snapshot if boot completion was never reported.
+	BootSnapshot::GetStaticInstance().Cancel();
+
 	delete m_pAssetPackageLoader;
 	m_pAssetPackageLoader = NULL;
 
@@ -13,6 +13,7 @@ CacheManager* CacheManager::sm_pInstance = NULL;
 /// Constructor.
 CacheManager::CacheManager( const FilePath& rBaseDirectory )
 	: m_cachePool( CACHE_POOL_BLOCK_SIZE )
+	, m_bBatchUpdate( false )
 {
 	m_platformDataDirectories[ Cache::PLATFORM_PC ] = rBaseDirectory.c_str();
 	m_platformDataDirectories[ Cache::PLATFORM_PC ] += TXT( "DataPC/" );
@@ -89,10 +90,62 @@ Cache* CacheManager::GetCache( Name name, Cache::EPlatform platform )
 		pCache = cacheAccessor->Second();
 		HELIUM_ASSERT( pCache );
 	}
+	else
+	{
+		// Caches created in the middle of a batch update need to join the batch.
+		MutexScopeLock scopeLock( m_cacheListLock );
+		m_caches.Push( pCache );
+		if( m_bBatchUpdate )
+		{
+			pCache->BeginBatchUpdate();
+		}
+	}
 
 	return pCache;
 }
 
+/// Begin a batch update on all caches, including any caches created before EndBatchUpdate() is called.
+///
+/// @see EndBatchUpdate(), Cache::BeginBatchUpdate()
+void CacheManager::BeginBatchUpdate()
+{
+	MutexScopeLock scopeLock( m_cacheListLock );
+
+	m_bBatchUpdate = true;
+
+	size_t cacheCount = m_caches.GetSize();
+	for( size_t cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex )
+	{
+		Cache* pCache = m_caches[ cacheIndex ];
+		HELIUM_ASSERT( pCache );
+		pCache->BeginBatchUpdate();
+	}
+}
+
+/// End a batch update on all caches, writing out the table of contents of each cache that was modified.
+///
+/// @return  True if all modified TOC files were written successfully, false if any failed to write.
+///
+/// @see BeginBatchUpdate(), Cache::EndBatchUpdate()
+bool CacheManager::EndBatchUpdate()
+{
+	MutexScopeLock scopeLock( m_cacheListLock );
+
+	m_bBatchUpdate = false;
+
+	bool bSuccess = true;
+
+	size_t cacheCount = m_caches.GetSize();
+	for( size_t cacheIndex = 0; cacheIndex < cacheCount; ++cacheIndex )
+	{
+		Cache* pCache = m_caches[ cacheIndex ];
+		HELIUM_ASSERT( pCache );
+		bSuccess &= pCache->EndBatchUpdate();
+	}
+
+	return bSuccess;
+}
+
 /// Get the cache data directory for the specified platform.
 ///
 /// @param[in] platform  Target platform, or Cache::PLATFORM_INVALID name to use the current platform.
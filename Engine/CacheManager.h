@@ -2,6 +2,7 @@
 
 #include "Engine/Cache.h"
 
+#include "Platform/Locks.h"
 #include "Foundation/FilePath.h"
 
 /// Cache table of contents file extension.
@@ -23,6 +24,12 @@ namespace Helium
 		Cache* GetCache( Name name, Cache::EPlatform platform = Cache::PLATFORM_INVALID );
 		//@}
 
+		/// @name Batch Updates
+		//@{
+		void BeginBatchUpdate();
+		bool EndBatchUpdate();
+		//@}
+
 		/// @name Filesystem Information
 		//@{
 		const String& GetPlatformDataDirectory( Cache::EPlatform platform = Cache::PLATFORM_INVALID );
@@ -48,6 +55,12 @@ namespace Helium
 		ObjectPool< Cache > m_cachePool;
 		/// Cache lookup tables.
 		ConcurrentHashMap< Name, Cache* > m_cacheMaps[ Cache::PLATFORM_MAX ];
+		/// All cache instances created so far.
+		DynamicArray< Cache* > m_caches;
+		/// Lock for synchronizing access to the cache list and batch update state.
+		Mutex m_cacheListLock;
+		/// True if a batch update is in progress.
+		bool m_bBatchUpdate;
 
 		/// Singleton instance.
 		static CacheManager* sm_pInstance;
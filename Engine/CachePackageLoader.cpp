@@ -4,6 +4,7 @@
 #include "Engine/Asset.h"
 #include "Engine/AssetLoader.h"
 #include "Engine/AsyncLoader.h"
+#include "Engine/BootSnapshot.h"
 #include "Engine/CacheManager.h"
 #include "Engine/Resource.h"
 
@@ -109,6 +110,9 @@ bool CachePackageLoader::BeginPreload()
 }
 
 /// @copydoc PackageLoader::TryFinishPreload()
+///
+/// Preloading also waits for the boot snapshot to finish loading, so that entries it contains are never read from
+/// the cache file separately.
 bool CachePackageLoader::TryFinishPreload()
 {
 	HELIUM_ASSERT( m_pCache );
@@ -117,6 +121,7 @@ bool CachePackageLoader::TryFinishPreload()
 	if( !bResult )
 	{
 		bResult = ( m_pCache->IsTocLoaded() || m_pCache->TryFinishLoadToc() );
+		bResult = bResult && BootSnapshot::GetStaticInstance().TryFinishLoad();
 		m_bFinishedCacheTocLoad = bResult;
 	}
 
@@ -235,22 +240,35 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	{
 		HELIUM_ASSERT( !pObject || !pObject->GetAnyFlagSet( Asset::FLAG_LOADED | Asset::FLAG_LINKED ) );
 
-		HELIUM_TRACE(
-			TraceLevels::Debug,
-			TXT( "CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n" ),
-			*path.ToString() );
-
 		size_t entrySize = pEntry->size;
 		pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
 		HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
 
-		AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
-		pRequest->asyncLoadId = rLoader.QueueRequest(
-			pRequest->pAsyncLoadBuffer,
-			m_pCache->GetCacheFileName(),
-			pEntry->offset,
-			entrySize );
-		HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+		// Use the copy of the property data in the boot snapshot if there is one.
+		if( BootSnapshot::GetStaticInstance().CopyEntryData( pEntry, pRequest->pAsyncLoadBuffer ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Debug,
+				TXT( "CachePackageLoader::BeginLoadObject(): Using boot snapshot property data for \"%s\".\n" ),
+				*path.ToString() );
+
+			pRequest->flags = LOAD_FLAG_BOOT_SNAPSHOT;
+		}
+		else
+		{
+			HELIUM_TRACE(
+				TraceLevels::Debug,
+				TXT( "CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n" ),
+				*path.ToString() );
+
+			AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+			pRequest->asyncLoadId = rLoader.QueueRequest(
+				pRequest->pAsyncLoadBuffer,
+				m_pCache->GetCacheFileName(),
+				pEntry->offset,
+				entrySize );
+			HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+		}
 	}
 
 	size_t requestId = m_loadRequests.Add( pRequest );
@@ -348,7 +366,7 @@ void CachePackageLoader::Tick()
 
 		if( !( pRequest->flags & LOAD_FLAG_PRELOADED ) )
 		{
-			if( IsValid( pRequest->asyncLoadId ) )
+			if( IsValid( pRequest->asyncLoadId ) || ( pRequest->flags & LOAD_FLAG_BOOT_SNAPSHOT ) )
 			{
 				if( !TickCacheLoad( pRequest ) )
 				{
@@ -392,6 +410,9 @@ AssetPath CachePackageLoader::GetAssetPath( size_t index ) const
 
 /// Tick the async loading of binary serialized data from the object cache for the given load request.
 ///
+/// If the data was copied from the boot snapshot, it is processed immediately.  Otherwise, once the data has been
+/// read from the cache, it is recorded for the boot snapshot if one is being recorded.
+///
 /// @param[in] pRequest  Load request.
 ///
 /// @return  True if the cache load process has completed, false if it still requires processing.
@@ -399,16 +420,34 @@ bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
 {
 	HELIUM_ASSERT( pRequest );
 	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
-
-	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+	HELIUM_ASSERT( pRequest->pEntry );
 
 	size_t bytesRead = 0;
-	if( !rAsyncLoader.TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+	if( pRequest->flags & LOAD_FLAG_BOOT_SNAPSHOT )
 	{
-		return false;
+		bytesRead = pRequest->pEntry->size;
+		pRequest->flags &= ~LOAD_FLAG_BOOT_SNAPSHOT;
 	}
+	else
+	{
+		AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+		if( !rAsyncLoader.TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+		{
+			return false;
+		}
 
-	SetInvalid( pRequest->asyncLoadId );
+		SetInvalid( pRequest->asyncLoadId );
+
+		BootSnapshot& rBootSnapshot = BootSnapshot::GetStaticInstance();
+		if( rBootSnapshot.IsRecording() && IsValid( bytesRead ) )
+		{
+			rBootSnapshot.RecordEntry(
+				m_pCache,
+				pRequest->pEntry,
+				pRequest->pAsyncLoadBuffer,
+				static_cast< uint32_t >( bytesRead ) );
+		}
+	}
 
 	if( bytesRead == 0 || IsInvalid( bytesRead ) )
 	{
@@ -52,7 +52,9 @@ namespace Helium
 			/// Set once object preloading has completed.
 			LOAD_FLAG_PRELOADED = 1 << 0,
 			/// Set when an error has occurred in the load process.
-			LOAD_FLAG_ERROR = 1 << 1
+			LOAD_FLAG_ERROR = 1 << 1,
+			/// Set if the cached data was copied from the boot snapshot and has not been processed yet.
+			LOAD_FLAG_BOOT_SNAPSHOT = 1 << 2
 		};
 
 		/// Asset load request data.
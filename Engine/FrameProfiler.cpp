@@ -0,0 +1,539 @@
+#include "EnginePch.h"
+#include "Engine/FrameProfiler.h"
+
+#if HELIUM_FRAME_PROFILER
+
+#include "Platform/Atomic.h"
+#include "Platform/Thread.h"
+#include "Foundation/FileStream.h"
+
+#include <cstring>
+
+using namespace Helium;
+
+/// Size at which buffered Chrome trace output is flushed to disk.
+static const size_t CHROME_TRACE_FLUSH_SIZE = 64 * 1024;
+
+volatile int32_t FrameProfiler::sm_captureEnabled = 0;
+
+/// Thread-local pointer to the ring buffer of the current thread.
+static ThreadLocalPointer s_threadBufferPointer;
+/// Registered thread ring buffers.
+static void* volatile s_pThreadBuffers[ FrameProfiler::MAX_THREAD_COUNT ];
+/// Number of thread ring buffers allocated (may exceed MAX_THREAD_COUNT if too many threads recorded events at once).
+static volatile int32_t s_threadBufferCount = 0;
+
+/// Counter names.
+static const char* s_counterNames[ FrameProfiler::MAX_COUNTER_COUNT ];
+/// Current counter values.
+static volatile int32_t s_counterValues[ FrameProfiler::MAX_COUNTER_COUNT ];
+/// Counter values sampled at the end of the previous frame.
+static int32_t s_counterFrameValues[ FrameProfiler::MAX_COUNTER_COUNT ];
+/// True for each counter that is reset at the end of each frame.
+static bool s_counterResetFlags[ FrameProfiler::MAX_COUNTER_COUNT ];
+/// Number of registered counters.
+static volatile int32_t s_counterCount = 0;
+/// Lock for counter registration.
+static Mutex s_counterRegistrationLock;
+
+/// Frame time history, in milliseconds.
+static float32_t s_frameTimes[ FrameProfiler::FRAME_HISTORY_SIZE ];
+/// Total number of frames recorded.
+static size_t s_frameCount = 0;
+/// Timer ticks at the end of the previous frame.
+static uint64_t s_lastFrameTicks = 0;
+
+/// Get the number of microseconds per timer tick.
+///
+/// @return  Microseconds per tick.
+static float64_t GetMicrosecondsPerTick()
+{
+	static const uint64_t sampleTicks = 1000000000;
+	static const float64_t microsecondsPerTick =
+		static_cast< float64_t >( Timer::TicksToMilliseconds( sampleTicks ) ) * 1000.0 /
+		static_cast< float64_t >( sampleTicks );
+
+	return microsecondsPerTick;
+}
+
+/// Append a JSON string literal to a string, escaping characters as needed.
+///
+/// @param[in] rOutput  String to which the literal should be appended.
+/// @param[in] pString  String to append (null is written as an empty string).
+static void AppendJsonString( String& rOutput, const char* pString )
+{
+	rOutput += TXT( '"' );
+
+	if( pString )
+	{
+		for( const char* pCharacter = pString; *pCharacter != TXT( '\0' ); ++pCharacter )
+		{
+			char character = *pCharacter;
+			if( character == TXT( '"' ) || character == TXT( '\\' ) )
+			{
+				rOutput += TXT( '\\' );
+			}
+			else if( static_cast< unsigned char >( character ) < 0x20 )
+			{
+				character = TXT( ' ' );
+			}
+
+			rOutput += character;
+		}
+	}
+
+	rOutput += TXT( '"' );
+}
+
+/// Flush buffered Chrome trace output to a file.
+///
+/// @param[in] pStream  File stream to which the output should be written.
+/// @param[in] rOutput  Buffered output (cleared after writing).
+///
+/// @return  True if the data was written successfully, false if not.
+static bool FlushChromeTraceOutput( FileStream* pStream, String& rOutput )
+{
+	HELIUM_ASSERT( pStream );
+
+	size_t size = rOutput.GetSize();
+	bool bSuccess = ( size == 0 || pStream->Write( rOutput.GetData(), sizeof( char ), size ) == size );
+	rOutput.Clear();
+
+	return bSuccess;
+}
+
+/// Enable or disable event capture.
+///
+/// Frame time tracking is always performed, even while event capture is disabled.
+///
+/// @param[in] bEnabled  True to record scopes and counter samples, false to ignore them.
+///
+/// @see IsCaptureEnabled()
+void FrameProfiler::SetCaptureEnabled( bool bEnabled )
+{
+	AtomicExchangeRelease( sm_captureEnabled, bEnabled ? 1 : 0 );
+}
+
+/// Set the name used for the current thread in the profiler output.
+///
+/// @param[in] pName  Thread name (must be a string with static lifetime).
+void FrameProfiler::SetThreadName( const char* pName )
+{
+	ThreadBuffer* pBuffer = GetThreadBuffer();
+	if( pBuffer )
+	{
+		pBuffer->pName = pName;
+	}
+}
+
+/// Release the ring buffer of the current thread so that it can be reused by a thread started later.
+///
+/// Events already in the buffer remain available for WriteChromeTrace() until another thread takes over the buffer.
+/// This should be called when a thread that recorded events is about to exit (see ThreadScope).
+void FrameProfiler::ReleaseThreadBuffer()
+{
+	ThreadBuffer* pBuffer = static_cast< ThreadBuffer* >( s_threadBufferPointer.GetPointer() );
+	if( pBuffer )
+	{
+		s_threadBufferPointer.SetPointer( NULL );
+		AtomicExchangeRelease( pBuffer->inUse, 0 );
+	}
+}
+
+/// Record a timed scope on the current thread.
+///
+/// @param[in] pName       Scope name (must be a string with static lifetime).
+/// @param[in] startTicks  Scope start time, in timer ticks.
+/// @param[in] endTicks    Scope end time, in timer ticks.
+void FrameProfiler::RecordScope( const char* pName, uint64_t startTicks, uint64_t endTicks )
+{
+	if( sm_captureEnabled == 0 )
+	{
+		return;
+	}
+
+	ThreadBuffer* pBuffer = GetThreadBuffer();
+	if( !pBuffer )
+	{
+		return;
+	}
+
+	Event event;
+	event.pName = pName;
+	event.startTicks = startTicks;
+	event.endTicksOrValue = endTicks;
+	event.type = EVENT_TYPE_SCOPE;
+	WriteEvent( pBuffer, event );
+}
+
+/// Register a counter, or look up an existing counter with the same name.
+///
+/// @param[in] pName            Counter name (must be a string with static lifetime).
+/// @param[in] bResetEachFrame  True if the counter should be reset to zero at the end of each frame, false if its
+///                             value should persist until changed.
+///
+/// @return  Index of the counter, or an invalid index if the counter table is full.
+size_t FrameProfiler::RegisterCounter( const char* pName, bool bResetEachFrame )
+{
+	HELIUM_ASSERT( pName );
+
+	MutexScopeLock lock( s_counterRegistrationLock );
+
+	size_t counterCount = static_cast< size_t >( s_counterCount );
+	for( size_t counterIndex = 0; counterIndex < counterCount; ++counterIndex )
+	{
+		if( s_counterNames[ counterIndex ] == pName || strcmp( s_counterNames[ counterIndex ], pName ) == 0 )
+		{
+			return counterIndex;
+		}
+	}
+
+	if( counterCount >= MAX_COUNTER_COUNT )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "FrameProfiler::RegisterCounter(): Counter table full, ignoring counter \"%s\".\n" ),
+			pName );
+
+		return Invalid< size_t >();
+	}
+
+	s_counterNames[ counterCount ] = pName;
+	s_counterValues[ counterCount ] = 0;
+	s_counterFrameValues[ counterCount ] = 0;
+	s_counterResetFlags[ counterCount ] = bResetEachFrame;
+	AtomicExchangeRelease( s_counterCount, static_cast< int32_t >( counterCount + 1 ) );
+
+	return counterCount;
+}
+
+/// Add a value to a counter.
+///
+/// @param[in] counterIndex  Counter index returned by RegisterCounter().
+/// @param[in] value         Value to add.
+///
+/// @see SetCounter(), RegisterCounter()
+void FrameProfiler::AddCounter( size_t counterIndex, int32_t value )
+{
+	if( counterIndex < MAX_COUNTER_COUNT )
+	{
+		AtomicAddUnsafe( s_counterValues[ counterIndex ], value );
+	}
+}
+
+/// Set the value of a counter.
+///
+/// @param[in] counterIndex  Counter index returned by RegisterCounter().
+/// @param[in] value         New counter value.
+///
+/// @see AddCounter(), RegisterCounter()
+void FrameProfiler::SetCounter( size_t counterIndex, int32_t value )
+{
+	if( counterIndex < MAX_COUNTER_COUNT )
+	{
+		AtomicExchangeUnsafe( s_counterValues[ counterIndex ], value );
+	}
+}
+
+/// Mark the end of the current frame.
+///
+/// This updates the rolling frame time summary and samples all counters, resetting per-frame counters.  It should be
+/// called once per frame from the main thread.
+void FrameProfiler::EndFrame()
+{
+	uint64_t frameTicks = Timer::GetTickCount();
+
+	if( s_lastFrameTicks != 0 )
+	{
+		RecordScope( "Frame", s_lastFrameTicks, frameTicks );
+
+		s_frameTimes[ s_frameCount % FRAME_HISTORY_SIZE ] = Timer::TicksToMilliseconds( frameTicks - s_lastFrameTicks );
+		++s_frameCount;
+
+		if( s_frameCount % FRAME_HISTORY_SIZE == 0 )
+		{
+			FrameSummary summary;
+			GetFrameSummary( summary );
+
+			HELIUM_TRACE(
+				TraceLevels::Info,
+				TXT( "FrameProfiler: %" ) PRIuSZ TXT( " frames: %.2f ms average, %.2f ms min, %.2f ms max.\n" ),
+				summary.frameCount,
+				summary.averageMilliseconds,
+				summary.minimumMilliseconds,
+				summary.maximumMilliseconds );
+		}
+	}
+
+	s_lastFrameTicks = frameTicks;
+
+	// Sample counters.
+	ThreadBuffer* pBuffer = ( sm_captureEnabled != 0 ? GetThreadBuffer() : NULL );
+
+	size_t counterCount = static_cast< size_t >( s_counterCount );
+	for( size_t counterIndex = 0; counterIndex < counterCount; ++counterIndex )
+	{
+		int32_t value = ( s_counterResetFlags[ counterIndex ]
+			? AtomicExchangeUnsafe( s_counterValues[ counterIndex ], 0 )
+			: s_counterValues[ counterIndex ] );
+		s_counterFrameValues[ counterIndex ] = value;
+
+		if( pBuffer )
+		{
+			Event event;
+			event.pName = s_counterNames[ counterIndex ];
+			event.startTicks = frameTicks;
+			event.endTicksOrValue = static_cast< uint64_t >( static_cast< int64_t >( value ) );
+			event.type = EVENT_TYPE_COUNTER;
+			WriteEvent( pBuffer, event );
+		}
+	}
+}
+
+/// Get the rolling frame time summary.
+///
+/// @param[out] rSummary  Frame time statistics for up to the last FRAME_HISTORY_SIZE frames.
+void FrameProfiler::GetFrameSummary( FrameSummary& rSummary )
+{
+	size_t frameCount = Min( s_frameCount, FRAME_HISTORY_SIZE );
+
+	rSummary.frameCount = frameCount;
+	rSummary.averageMilliseconds = 0.0f;
+	rSummary.minimumMilliseconds = 0.0f;
+	rSummary.maximumMilliseconds = 0.0f;
+	rSummary.lastMilliseconds = 0.0f;
+
+	if( frameCount == 0 )
+	{
+		return;
+	}
+
+	float32_t total = 0.0f;
+	float32_t minimum = s_frameTimes[ 0 ];
+	float32_t maximum = s_frameTimes[ 0 ];
+	for( size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex )
+	{
+		float32_t frameTime = s_frameTimes[ frameIndex ];
+		total += frameTime;
+		minimum = Min( minimum, frameTime );
+		maximum = Max( maximum, frameTime );
+	}
+
+	rSummary.averageMilliseconds = total / static_cast< float32_t >( frameCount );
+	rSummary.minimumMilliseconds = minimum;
+	rSummary.maximumMilliseconds = maximum;
+	rSummary.lastMilliseconds = s_frameTimes[ ( s_frameCount - 1 ) % FRAME_HISTORY_SIZE ];
+}
+
+/// Get the value of a counter sampled at the end of the previous frame.
+///
+/// @param[in] counterIndex  Counter index returned by RegisterCounter().
+///
+/// @return  Counter value.
+int32_t FrameProfiler::GetCounterValue( size_t counterIndex )
+{
+	return ( counterIndex < MAX_COUNTER_COUNT ? s_counterFrameValues[ counterIndex ] : 0 );
+}
+
+/// Write the events currently held in all thread ring buffers to a file in the Chrome trace event format.
+///
+/// Threads may continue recording while the trace is written, in which case the oldest events of a busy thread may be
+/// overwritten while being read.  For a consistent capture, disable capture with SetCaptureEnabled() first.
+///
+/// @param[in] rFileName  Output file name.
+///
+/// @return  True if the trace was written successfully, false if not.
+bool FrameProfiler::WriteChromeTrace( const String& rFileName )
+{
+	FileStream* pStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_WRITE, true );
+	if( !pStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "FrameProfiler::WriteChromeTrace(): Failed to open \"%s\" for writing.\n" ),
+			*rFileName );
+
+		return false;
+	}
+
+	float64_t microsecondsPerTick = GetMicrosecondsPerTick();
+
+	// Use the earliest recorded event as the time origin to keep timestamps small.
+	uint64_t baseTicks = Invalid< uint64_t >();
+
+	size_t threadCount = Min( static_cast< size_t >( s_threadBufferCount ), MAX_THREAD_COUNT );
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+	{
+		ThreadBuffer* pBuffer = static_cast< ThreadBuffer* >( s_pThreadBuffers[ threadIndex ] );
+		if( !pBuffer )
+		{
+			continue;
+		}
+
+		uint32_t writeCount = static_cast< uint32_t >( pBuffer->writeCount );
+		uint32_t eventCount = Min( writeCount, static_cast< uint32_t >( EVENT_BUFFER_SIZE ) );
+		for( uint32_t eventIndex = writeCount - eventCount; eventIndex != writeCount; ++eventIndex )
+		{
+			baseTicks = Min( baseTicks, pBuffer->events[ eventIndex & ( EVENT_BUFFER_SIZE - 1 ) ].startTicks );
+		}
+	}
+
+	String output;
+	output.Reserve( CHROME_TRACE_FLUSH_SIZE + 1024 );
+	output += TXT( "{\"traceEvents\":[\n" );
+
+	bool bSuccess = true;
+	bool bFirstEvent = true;
+	String line;
+
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+	{
+		ThreadBuffer* pBuffer = static_cast< ThreadBuffer* >( s_pThreadBuffers[ threadIndex ] );
+		if( !pBuffer )
+		{
+			continue;
+		}
+
+		// Thread name metadata.
+		if( !bFirstEvent )
+		{
+			output += TXT( ",\n" );
+		}
+
+		bFirstEvent = false;
+
+		line.Format(
+			TXT( "{\"ph\":\"M\",\"pid\":0,\"tid\":%" ) PRIuSZ TXT( ",\"name\":\"thread_name\",\"args\":{\"name\":" ),
+			threadIndex );
+		output += line;
+		if( pBuffer->pName )
+		{
+			AppendJsonString( output, pBuffer->pName );
+		}
+		else
+		{
+			line.Format( TXT( "\"Thread %" ) PRIuSZ TXT( "\"" ), threadIndex );
+			output += line;
+		}
+		output += TXT( "}}" );
+
+		uint32_t writeCount = static_cast< uint32_t >( pBuffer->writeCount );
+		uint32_t eventCount = Min( writeCount, static_cast< uint32_t >( EVENT_BUFFER_SIZE ) );
+		for( uint32_t eventIndex = writeCount - eventCount; eventIndex != writeCount; ++eventIndex )
+		{
+			const Event& rEvent = pBuffer->events[ eventIndex & ( EVENT_BUFFER_SIZE - 1 ) ];
+
+			float64_t timestamp = static_cast< float64_t >( rEvent.startTicks - baseTicks ) * microsecondsPerTick;
+
+			output += TXT( ",\n{\"name\":" );
+			AppendJsonString( output, rEvent.pName );
+
+			if( rEvent.type == EVENT_TYPE_COUNTER )
+			{
+				line.Format(
+					TXT( ",\"ph\":\"C\",\"pid\":0,\"tid\":%" ) PRIuSZ TXT( ",\"ts\":%.3f,\"args\":{\"value\":%" ) PRId64
+					TXT( "}}" ),
+					threadIndex,
+					timestamp,
+					static_cast< int64_t >( rEvent.endTicksOrValue ) );
+			}
+			else
+			{
+				float64_t duration =
+					static_cast< float64_t >( rEvent.endTicksOrValue - rEvent.startTicks ) * microsecondsPerTick;
+				line.Format(
+					TXT( ",\"ph\":\"X\",\"pid\":0,\"tid\":%" ) PRIuSZ TXT( ",\"ts\":%.3f,\"dur\":%.3f}" ),
+					threadIndex,
+					timestamp,
+					duration );
+			}
+
+			output += line;
+
+			if( output.GetSize() >= CHROME_TRACE_FLUSH_SIZE )
+			{
+				bSuccess &= FlushChromeTraceOutput( pStream, output );
+			}
+		}
+	}
+
+	output += TXT( "\n]}\n" );
+	bSuccess &= FlushChromeTraceOutput( pStream, output );
+
+	delete pStream;
+
+	if( !bSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "FrameProfiler::WriteChromeTrace(): Failed to write trace data to \"%s\".\n" ),
+			*rFileName );
+
+		return false;
+	}
+
+	HELIUM_TRACE( TraceLevels::Info, TXT( "FrameProfiler: Wrote Chrome trace to \"%s\".\n" ), *rFileName );
+
+	return true;
+}
+
+/// Get the ring buffer for the current thread, reusing a buffer released by an exited thread or allocating a new one if
+/// necessary.
+///
+/// @return  Ring buffer for the current thread, or null if the maximum number of threads has been exceeded.
+FrameProfiler::ThreadBuffer* FrameProfiler::GetThreadBuffer()
+{
+	ThreadBuffer* pBuffer = static_cast< ThreadBuffer* >( s_threadBufferPointer.GetPointer() );
+	if( pBuffer )
+	{
+		return pBuffer;
+	}
+
+	size_t threadCount = Min( static_cast< size_t >( s_threadBufferCount ), MAX_THREAD_COUNT );
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+	{
+		pBuffer = static_cast< ThreadBuffer* >( s_pThreadBuffers[ threadIndex ] );
+		if( pBuffer && AtomicCompareExchangeAcquire( pBuffer->inUse, 1, 0 ) == 0 )
+		{
+			pBuffer->pName = NULL;
+			AtomicExchangeRelease( pBuffer->writeCount, 0 );
+			s_threadBufferPointer.SetPointer( pBuffer );
+
+			return pBuffer;
+		}
+	}
+
+	size_t threadIndex = static_cast< size_t >( AtomicIncrementAcquire( s_threadBufferCount ) - 1 );
+	if( threadIndex >= MAX_THREAD_COUNT )
+	{
+		return NULL;
+	}
+
+	pBuffer = new ThreadBuffer;
+	HELIUM_ASSERT( pBuffer );
+	pBuffer->pName = NULL;
+	pBuffer->writeCount = 0;
+	pBuffer->inUse = 1;
+
+	s_pThreadBuffers[ threadIndex ] = pBuffer;
+	s_threadBufferPointer.SetPointer( pBuffer );
+
+	return pBuffer;
+}
+
+/// Write an event to a thread ring buffer.
+///
+/// Only the thread owning the buffer may write to it, so no locking is required.
+///
+/// @param[in] pBuffer  Ring buffer of the current thread.
+/// @param[in] rEvent   Event to write.
+void FrameProfiler::WriteEvent( ThreadBuffer* pBuffer, const Event& rEvent )
+{
+	HELIUM_ASSERT( pBuffer );
+
+	uint32_t writeCount = static_cast< uint32_t >( pBuffer->writeCount );
+	pBuffer->events[ writeCount & ( EVENT_BUFFER_SIZE - 1 ) ] = rEvent;
+	AtomicExchangeRelease( pBuffer->writeCount, static_cast< int32_t >( writeCount + 1 ) );
+}
+
+#endif  // HELIUM_FRAME_PROFILER
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+#include "Platform/Locks.h"
+#include "Platform/Timer.h"
+#include "Foundation/String.h"
+
+/// Non-zero to compile in frame profiler instrumentation, zero to strip all instrumentation macros.
+#ifndef HELIUM_FRAME_PROFILER
+# define HELIUM_FRAME_PROFILER ( !HELIUM_RELEASE )
+#endif
+
+#define HELIUM_FRAME_PROFILER_CONCAT_IMPL( A, B ) A##B
+#define HELIUM_FRAME_PROFILER_CONCAT( A, B ) HELIUM_FRAME_PROFILER_CONCAT_IMPL( A, B )
+
+#if HELIUM_FRAME_PROFILER
+/// Record the time spent in the enclosing scope under the given name (must be a string with static lifetime).
+# define HELIUM_FRAME_PROFILE_SCOPE( NAME ) \
+	Helium::FrameProfiler::ScopeTimer HELIUM_FRAME_PROFILER_CONCAT( frameProfileScope, __LINE__ )( NAME )
+/// Add a value to a counter that is reset at the end of each frame (i.e. draw calls, bytes read).
+# define HELIUM_FRAME_PROFILE_COUNTER_ADD( NAME, VALUE ) \
+	{ \
+		static const size_t HELIUM_FRAME_PROFILER_CONCAT( frameProfileCounter, __LINE__ ) = \
+			Helium::FrameProfiler::RegisterCounter( NAME, true ); \
+		Helium::FrameProfiler::AddCounter( HELIUM_FRAME_PROFILER_CONCAT( frameProfileCounter, __LINE__ ), VALUE ); \
+	}
+/// Set the value of a counter that persists across frames (i.e. loads in flight).
+# define HELIUM_FRAME_PROFILE_COUNTER_SET( NAME, VALUE ) \
+	{ \
+		static const size_t HELIUM_FRAME_PROFILER_CONCAT( frameProfileCounter, __LINE__ ) = \
+			Helium::FrameProfiler::RegisterCounter( NAME, false ); \
+		Helium::FrameProfiler::SetCounter( HELIUM_FRAME_PROFILER_CONCAT( frameProfileCounter, __LINE__ ), VALUE ); \
+	}
+/// Set the name used for the current thread in profiler output (must be a string with static lifetime).
+# define HELIUM_FRAME_PROFILE_THREAD_NAME( NAME ) Helium::FrameProfiler::SetThreadName( NAME )
+/// Name the current thread in profiler output and release its event buffer for reuse by later threads when the
+/// enclosing scope exits (place at the top of a thread entry point).
+# define HELIUM_FRAME_PROFILE_THREAD_SCOPE( NAME ) \
+	Helium::FrameProfiler::ThreadScope HELIUM_FRAME_PROFILER_CONCAT( frameProfileThreadScope, __LINE__ )( NAME )
+/// Mark the end of the current frame.
+# define HELIUM_FRAME_PROFILE_END_FRAME() Helium::FrameProfiler::EndFrame()
+#else
+# define HELIUM_FRAME_PROFILE_SCOPE( NAME )
+# define HELIUM_FRAME_PROFILE_COUNTER_ADD( NAME, VALUE )
+# define HELIUM_FRAME_PROFILE_COUNTER_SET( NAME, VALUE )
+# define HELIUM_FRAME_PROFILE_THREAD_NAME( NAME )
+# define HELIUM_FRAME_PROFILE_THREAD_SCOPE( NAME )
+# define HELIUM_FRAME_PROFILE_END_FRAME()
+#endif
+
+#if HELIUM_FRAME_PROFILER
+
+namespace Helium
+{
+	/// Low-overhead, thread-aware frame profiler.
+	///
+	/// Each thread records timed scopes into its own fixed-size ring buffer without taking any locks, so only the most
+	/// recent EVENT_BUFFER_SIZE events of each thread are retained.  Threads that exit release their buffer through
+	/// ThreadScope so that it can be reused by threads started later, and event capture is disabled until enabled with
+	/// SetCaptureEnabled() (i.e. by the "-profile" command-line option).  Counters are stored in a shared table updated with
+	/// atomic operations and sampled once per frame by EndFrame().  Recorded data can be exported in the Chrome trace
+	/// event format (viewable through chrome://tracing), and a rolling frame time summary is kept for in-game display.
+	///
+	/// All names passed to the profiler are stored by pointer and must remain valid for the lifetime of the program.
+	class HELIUM_ENGINE_API FrameProfiler : NonCopyable
+	{
+	public:
+		/// Number of events retained in each thread's ring buffer (must be a power of two).
+		static const size_t EVENT_BUFFER_SIZE = 16384;
+		/// Maximum number of threads that can record events at the same time.
+		static const size_t MAX_THREAD_COUNT = 32;
+		/// Maximum number of counters.
+		static const size_t MAX_COUNTER_COUNT = 64;
+		/// Number of frames used for the rolling frame time summary.
+		static const size_t FRAME_HISTORY_SIZE = 128;
+
+		/// Recorded event types.
+		enum EEventType
+		{
+			/// Timed scope.
+			EVENT_TYPE_SCOPE,
+			/// Counter sample.
+			EVENT_TYPE_COUNTER
+		};
+
+		/// Recorded profiler event.
+		struct Event
+		{
+			/// Event name.
+			const char* pName;
+			/// Start time, in timer ticks.
+			uint64_t startTicks;
+			/// End time (scopes) or counter value (counters).
+			uint64_t endTicksOrValue;
+			/// Event type.
+			uint32_t type;
+		};
+
+		/// Rolling frame time statistics.
+		struct FrameSummary
+		{
+			/// Number of frames included in the summary.
+			size_t frameCount;
+			/// Average frame time, in milliseconds.
+			float32_t averageMilliseconds;
+			/// Shortest frame time, in milliseconds.
+			float32_t minimumMilliseconds;
+			/// Longest frame time, in milliseconds.
+			float32_t maximumMilliseconds;
+			/// Most recent frame time, in milliseconds.
+			float32_t lastMilliseconds;
+		};
+
+		/// Scope timer for recording the time spent in a block of code.
+		class ScopeTimer : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			inline explicit ScopeTimer( const char* pName );
+			inline ~ScopeTimer();
+			//@}
+
+		private:
+			/// Scope name.
+			const char* m_pName;
+			/// Scope start time, in timer ticks.
+			uint64_t m_startTicks;
+		};
+
+		/// Scope covering the lifetime of a thread that records events.
+		class ThreadScope : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			inline explicit ThreadScope( const char* pName );
+			inline ~ThreadScope();
+			//@}
+		};
+
+		/// @name Capture Control
+		//@{
+		static void SetCaptureEnabled( bool bEnabled );
+		static inline bool IsCaptureEnabled();
+		//@}
+
+		/// @name Event Recording
+		//@{
+		static void SetThreadName( const char* pName );
+		static void ReleaseThreadBuffer();
+		static void RecordScope( const char* pName, uint64_t startTicks, uint64_t endTicks );
+
+		static size_t RegisterCounter( const char* pName, bool bResetEachFrame );
+		static void AddCounter( size_t counterIndex, int32_t value );
+		static void SetCounter( size_t counterIndex, int32_t value );
+
+		static void EndFrame();
+		//@}
+
+		/// @name Data Access
+		//@{
+		static void GetFrameSummary( FrameSummary& rSummary );
+		static int32_t GetCounterValue( size_t counterIndex );
+
+		static bool WriteChromeTrace( const String& rFileName );
+		//@}
+
+	private:
+		/// Per-thread event ring buffer.
+		struct ThreadBuffer
+		{
+			/// Thread name.
+			const char* pName;
+			/// Total number of events written (the write position is this value modulo EVENT_BUFFER_SIZE).
+			volatile int32_t writeCount;
+			/// Non-zero while the buffer is owned by a running thread.
+			volatile int32_t inUse;
+			/// Event ring buffer.
+			Event events[ EVENT_BUFFER_SIZE ];
+		};
+
+		/// Counter information.
+		struct Counter
+		{
+			/// Counter name.
+			const char* pName;
+			/// Current value.
+			volatile int32_t value;
+			/// True if the counter is reset at the end of each frame.
+			bool bResetEachFrame;
+		};
+
+		/// Non-zero if event capture is enabled.
+		static volatile int32_t sm_captureEnabled;
+
+		/// @name Private Utility Functions
+		//@{
+		static ThreadBuffer* GetThreadBuffer();
+		static void WriteEvent( ThreadBuffer* pBuffer, const Event& rEvent );
+		//@}
+	};
+}
+
+#include "Engine/FrameProfiler.inl"
+
+#endif  // HELIUM_FRAME_PROFILER
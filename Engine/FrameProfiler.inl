@@ -0,0 +1,38 @@
+/// Constructor.
+///
+/// @param[in] pName  Scope name (must be a string with static lifetime).
+Helium::FrameProfiler::ScopeTimer::ScopeTimer( const char* pName )
+: m_pName( pName )
+, m_startTicks( Timer::GetTickCount() )
+{
+}
+
+/// Destructor.
+Helium::FrameProfiler::ScopeTimer::~ScopeTimer()
+{
+	RecordScope( m_pName, m_startTicks, Timer::GetTickCount() );
+}
+
+/// Constructor.
+///
+/// @param[in] pName  Thread name (must be a string with static lifetime).
+Helium::FrameProfiler::ThreadScope::ThreadScope( const char* pName )
+{
+	SetThreadName( pName );
+}
+
+/// Destructor.
+Helium::FrameProfiler::ThreadScope::~ThreadScope()
+{
+	ReleaseThreadBuffer();
+}
+
+/// Get whether event capture is currently enabled.
+///
+/// @return  True if scopes and counter samples are being recorded, false if not.
+///
+/// @see SetCaptureEnabled()
+bool Helium::FrameProfiler::IsCaptureEnabled()
+{
+	return ( sm_captureEnabled != 0 );
+}
@@ -0,0 +1,308 @@
+#include "EnginePch.h"
+#include "Engine/WorkerPool.h"
+
+#include "Platform/Atomic.h"
+#include "Engine/FrameProfiler.h"
+
+#if HELIUM_OS_WIN
+# include <stdlib.h>
+#else
+# include <unistd.h>
+#endif
+
+using namespace Helium;
+
+WorkerPool* WorkerPool::sm_pInstance = NULL;
+int32_t WorkerPool::sm_initCount = 0;
+
+/// Lock serializing Startup() and Shutdown(), which systems call from whichever thread creates or destroys them.
+static Mutex s_startupLock;
+
+/// Constructor.
+///
+/// @param[in] pFunction  Job callback.
+/// @param[in] pData      User data passed to each job.
+/// @param[in] jobCount   Total number of jobs.
+WorkerPool::Batch::Batch( JobFunction pFunction, void* pData, size_t jobCount )
+	: pFunction( pFunction )
+	, pData( pData )
+	, jobCount( jobCount )
+	, nextJobIndex( 0 )
+	, pendingJobCount( static_cast< int32_t >( jobCount ) )
+	, completeCondition( false, false )
+{
+}
+
+/// Constructor.
+///
+/// @param[in] workerCount  Number of worker threads to create.
+WorkerPool::WorkerPool( size_t workerCount )
+	: m_stopCounter( 0 )
+{
+	Helium::CallbackThread::Entry entry =
+		&Helium::CallbackThread::EntryHelper< WorkerPool, &WorkerPool::WorkerThreadProc >;
+
+	m_workers.Reserve( workerCount );
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		CallbackThread* pThread = new CallbackThread;
+		HELIUM_ASSERT( pThread );
+		if( !pThread->Create( entry, this, TXT( "Worker pool" ) ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				( TXT( "WorkerPool: Failed to create worker thread %" ) PRIuSZ TXT( "; continuing with %" )
+				  PRIuSZ TXT( " worker threads.\n" ) ),
+				workerIndex,
+				workerIndex );
+
+			delete pThread;
+
+			break;
+		}
+
+		m_workers.Push( pThread );
+	}
+}
+
+/// Destructor.
+WorkerPool::~WorkerPool()
+{
+	HELIUM_ASSERT( m_batches.IsEmpty() );
+
+	AtomicExchangeRelease( m_stopCounter, 1 );
+
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		m_workSemaphore.Increment();
+	}
+
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		CallbackThread* pThread = m_workers[ workerIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
+	}
+
+	m_workers.Clear();
+}
+
+/// Execute a set of independent jobs, returning once they have all completed.
+///
+/// Jobs are distributed across the worker threads, with the calling thread taking part as well.  Jobs must not depend
+/// on each other or on the order in which they are executed.
+///
+/// @param[in] pFunction  Job callback.
+/// @param[in] pData      User data passed to each job.
+/// @param[in] jobCount   Number of jobs to execute.
+void WorkerPool::Run( JobFunction pFunction, void* pData, size_t jobCount )
+{
+	HELIUM_ASSERT( pFunction );
+
+	// Don't bother with synchronization if no other threads will be able to help.
+	size_t workerCount = m_workers.GetSize();
+	if( jobCount <= 1 || workerCount == 0 )
+	{
+		for( size_t jobIndex = 0; jobIndex < jobCount; ++jobIndex )
+		{
+			pFunction( pData, jobIndex );
+		}
+
+		return;
+	}
+
+	Batch batch( pFunction, pData, jobCount );
+
+	{
+		MutexScopeLock scopeLock( m_batchLock );
+		m_batches.Push( &batch );
+	}
+
+	// Wake up enough workers to handle every job other than the one this thread will pick up.
+	size_t wakeCount = Min( jobCount - 1, workerCount );
+	for( size_t wakeIndex = 0; wakeIndex < wakeCount; ++wakeIndex )
+	{
+		m_workSemaphore.Increment();
+	}
+
+	size_t jobIndex;
+	while( AcquireJob( &batch, jobIndex ) )
+	{
+		ExecuteJob( &batch, jobIndex );
+	}
+
+	batch.completeCondition.Wait();
+
+	// The thread that finished the last job signals the condition while holding the batch lock (see ExecuteJob()), so
+	// once the lock can be acquired here, no thread is still using the batch and it can go out of scope.
+	MutexScopeLock scopeLock( m_batchLock );
+}
+
+/// Initialize the shared pool instance, or add a reference to it if it has already been initialized.
+///
+/// @see Shutdown(), GetStaticInstance()
+void WorkerPool::Startup()
+{
+	MutexScopeLock scopeLock( s_startupLock );
+
+	if( sm_initCount++ == 0 )
+	{
+		HELIUM_ASSERT( !sm_pInstance );
+		sm_pInstance = new WorkerPool( GetDefaultWorkerCount() );
+		HELIUM_ASSERT( sm_pInstance );
+
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "WorkerPool: Started %" ) PRIuSZ TXT( " worker threads.\n" ),
+			sm_pInstance->GetWorkerCount() );
+	}
+}
+
+/// Release a reference to the shared pool instance, destroying it once all references have been released.
+///
+/// @see Startup(), GetStaticInstance()
+void WorkerPool::Shutdown()
+{
+	MutexScopeLock scopeLock( s_startupLock );
+
+	HELIUM_ASSERT( sm_initCount > 0 );
+	if( --sm_initCount == 0 )
+	{
+		delete sm_pInstance;
+		sm_pInstance = NULL;
+	}
+}
+
+/// Get the shared pool instance.
+///
+/// @return  Pool instance, or null if Startup() has not been called.
+///
+/// @see Startup(), Shutdown()
+WorkerPool* WorkerPool::GetStaticInstance()
+{
+	return sm_pInstance;
+}
+
+/// Hand out the next job that has not yet been started.
+///
+/// @param[in]  pBatch     Batch from which to acquire a job, or null to acquire a job from the oldest batch with jobs
+///                        remaining.
+/// @param[out] rJobIndex  Index of the acquired job within its batch.
+///
+/// @return  Batch containing the acquired job, or null if no jobs are available.
+WorkerPool::Batch* WorkerPool::AcquireJob( Batch* pBatch, size_t& rJobIndex )
+{
+	MutexScopeLock scopeLock( m_batchLock );
+
+	size_t batchCount = m_batches.GetSize();
+	size_t batchIndex = 0;
+	if( pBatch )
+	{
+		while( batchIndex < batchCount && m_batches[ batchIndex ] != pBatch )
+		{
+			++batchIndex;
+		}
+	}
+
+	if( batchIndex >= batchCount )
+	{
+		return NULL;
+	}
+
+	Batch* pAcquiredBatch = m_batches[ batchIndex ];
+	HELIUM_ASSERT( pAcquiredBatch );
+	HELIUM_ASSERT( pAcquiredBatch->nextJobIndex < pAcquiredBatch->jobCount );
+
+	// Batches are removed from the list as soon as their last job is handed out, so the thread that submitted a batch
+	// can safely release it once the batch completes.
+	rJobIndex = pAcquiredBatch->nextJobIndex++;
+	if( pAcquiredBatch->nextJobIndex >= pAcquiredBatch->jobCount )
+	{
+		m_batches.Remove( batchIndex );
+	}
+
+	return pAcquiredBatch;
+}
+
+/// Execute a single job and signal its batch if it was the last job to finish.
+///
+/// @param[in] pBatch    Batch containing the job.
+/// @param[in] jobIndex  Index of the job within the batch.
+void WorkerPool::ExecuteJob( Batch* pBatch, size_t jobIndex )
+{
+	HELIUM_ASSERT( pBatch );
+
+	{
+		HELIUM_FRAME_PROFILE_SCOPE( "WorkerPool::ExecuteJob" );
+		pBatch->pFunction( pBatch->pData, jobIndex );
+	}
+
+	// The batch lives on the stack of the thread waiting in Run(), which may return as soon as the condition is
+	// signaled.  Signaling under the batch lock makes Run() wait until this thread is done with the batch.
+	if( AtomicDecrementRelease( pBatch->pendingJobCount ) == 0 )
+	{
+		MutexScopeLock scopeLock( m_batchLock );
+		pBatch->completeCondition.Signal();
+	}
+}
+
+/// Worker thread entry point.
+void WorkerPool::WorkerThreadProc()
+{
+	HELIUM_FRAME_PROFILE_THREAD_SCOPE( "WorkerPool" );
+
+	for( ; ; )
+	{
+		m_workSemaphore.Decrement();
+		if( m_stopCounter != 0 )
+		{
+			break;
+		}
+
+		// The submitting thread may have already picked up the job this worker was woken for, in which case there is
+		// nothing to do until the next wake-up.
+		size_t jobIndex;
+		Batch* pBatch;
+		while( ( pBatch = AcquireJob( NULL, jobIndex ) ) != NULL )
+		{
+			ExecuteJob( pBatch, jobIndex );
+		}
+	}
+}
+
+/// Get the number of worker threads to create for the shared pool.
+///
+/// @return  One less than the number of logical processors (leaving a processor for the thread submitting jobs),
+///          clamped to MAX_WORKER_COUNT.
+size_t WorkerPool::GetDefaultWorkerCount()
+{
+	size_t processorCount = GetProcessorCount();
+	size_t workerCount = processorCount - 1;
+
+	return ( workerCount < MAX_WORKER_COUNT ? workerCount : MAX_WORKER_COUNT );
+}
+
+/// Get the number of logical processors available to this process.
+///
+/// This is the processor count used to size the shared pool, and the one that should be used anywhere else a thread
+/// count is derived from the processor count, so that all systems agree on it.
+///
+/// @return  Logical processor count (always at least one).
+size_t WorkerPool::GetProcessorCount()
+{
+	long processorCount = 1;
+
+#if HELIUM_OS_WIN
+	const char* pProcessorCountString = getenv( "NUMBER_OF_PROCESSORS" );
+	if( pProcessorCountString )
+	{
+		processorCount = atol( pProcessorCountString );
+	}
+#else
+	processorCount = sysconf( _SC_NPROCESSORS_ONLN );
+#endif
+
+	return ( processorCount > 1 ? static_cast< size_t >( processorCount ) : 1 );
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+#include "Platform/Condition.h"
+#include "Platform/Locks.h"
+#include "Platform/Semaphore.h"
+#include "Platform/Thread.h"
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+	/// Worker thread pool shared by every system that splits its work into independent jobs (skeleton evaluation and
+	/// parallel world updates at runtime, and texture compression and image conversion in the tools), so that each system
+	/// does not start its own set of threads competing for the same processors.
+	///
+	/// Jobs are submitted in batches through Run(), which blocks until every job in the batch has completed.  The
+	/// calling thread also processes jobs from its own batch while waiting, so batches can be submitted from several
+	/// threads at once without starving each other.  Since each job writes only to its own output, the results of a
+	/// batch do not depend on the order in which its jobs are executed.
+	class HELIUM_ENGINE_API WorkerPool : NonCopyable
+	{
+	public:
+		/// Job callback.
+		///
+		/// @param[in] pData     User data passed to Run().
+		/// @param[in] jobIndex  Index of the job to execute.
+		typedef void ( *JobFunction )( void* pData, size_t jobIndex );
+
+		/// Maximum number of worker threads.
+		static const size_t MAX_WORKER_COUNT = 16;
+
+		/// @name Job Execution
+		//@{
+		void Run( JobFunction pFunction, void* pData, size_t jobCount );
+
+		inline size_t GetWorkerCount() const;
+		//@}
+
+		/// @name Static Initialization
+		//@{
+		static void Startup();
+		static void Shutdown();
+
+		static WorkerPool* GetStaticInstance();
+		//@}
+
+		/// @name Processor Information
+		//@{
+		static size_t GetProcessorCount();
+		//@}
+
+	private:
+		/// Set of jobs submitted through a single call to Run().
+		struct Batch
+		{
+			/// Job callback.
+			JobFunction pFunction;
+			/// User data passed to each job.
+			void* pData;
+			/// Total number of jobs.
+			size_t jobCount;
+			/// Index of the next job to hand out.
+			size_t nextJobIndex;
+			/// Number of jobs that have not finished executing.
+			volatile int32_t pendingJobCount;
+			/// Condition signaled when the last job finishes.
+			Condition completeCondition;
+
+			/// @name Construction/Destruction
+			//@{
+			Batch( JobFunction pFunction, void* pData, size_t jobCount );
+			//@}
+		};
+
+		/// Worker threads.
+		DynamicArray< CallbackThread* > m_workers;
+
+		/// Batches with jobs that have not yet been handed out.
+		DynamicArray< Batch* > m_batches;
+		/// Lock for synchronizing access to the batch list.
+		Mutex m_batchLock;
+		/// Semaphore incremented for each job a worker thread may be able to pick up.
+		Semaphore m_workSemaphore;
+		/// Non-zero if the worker threads should exit.
+		volatile int32_t m_stopCounter;
+
+		/// Pool instance.
+		static WorkerPool* sm_pInstance;
+		/// Number of Startup() calls that have not been matched by a Shutdown() call (guarded by the startup lock).
+		static int32_t sm_initCount;
+
+		/// @name Construction/Destruction
+		//@{
+		explicit WorkerPool( size_t workerCount );
+		~WorkerPool();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		Batch* AcquireJob( Batch* pBatch, size_t& rJobIndex );
+		void ExecuteJob( Batch* pBatch, size_t jobIndex );
+		void WorkerThreadProc();
+
+		static size_t GetDefaultWorkerCount();
+		//@}
+	};
+}
+
+#include "Engine/WorkerPool.inl"
@@ -0,0 +1,7 @@
+/// Get the number of worker threads in this pool.
+///
+/// @return  Worker thread count (not including threads calling Run()).
+size_t Helium::WorkerPool::GetWorkerCount() const
+{
+	return m_workers.GetSize();
+}
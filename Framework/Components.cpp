@@ -3,6 +3,7 @@
 #include "Framework/Components.h"
 #include "Framework/SystemDefinition.h"
 
+#include "Platform/Locks.h"
 #include "Foundation/Numeric.h"
 #include "Reflect/TranslatorDeduction.h"
 #include "Engine/Asset.h"
@@ -27,12 +28,21 @@ namespace
 	DynamicArray<TypeData *>   g_ComponentTypes;
 	ComponentPtrBase*          g_ComponentPtrRegistry[COMPONENT_PTR_CHECK_FREQUENCY];
 	uint16_t                   g_ComponentProcessPendingDeletesCallCount = 0;
+
+	// Component pointers may be registered and unlinked from multiple threads when worlds are updated in parallel
+	Mutex                      g_ComponentPtrRegistryLock;
+
+	// Set while worlds are updated in parallel, during which the global type registry and component manager list must
+	// not change (only the component pointer registry above is guarded)
+	bool                       g_ComponentsParallelUpdate = false;
 }
 
 ComponentRegistrar<Helium::Component, void> Helium::Component::s_ComponentRegistrar("Helium::Component");
 
 void Components::Initialize( SystemDefinition *pSystemDefinition )
 {
+	HELIUM_ASSERT( !g_ComponentsParallelUpdate );
+
 	// Register base component with reflect
 	if ( !g_ComponentsInitCount )
 	{
@@ -72,6 +82,8 @@ void Components::Initialize( SystemDefinition *pSystemDefinition )
 
 void Components::Cleanup()
 {
+	HELIUM_ASSERT( !g_ComponentsParallelUpdate );
+
 	--g_ComponentsInitCount;
 
 	if ( !g_ComponentsInitCount )
@@ -101,6 +113,7 @@ TypeId Components::RegisterType(
 	uint16_t defaultCount )
 {
 	// Some validation of parameters/state
+	HELIUM_ASSERT( !g_ComponentsParallelUpdate );
 	HELIUM_ASSERT( pStructure );
 	HELIUM_ASSERT( defaultCount >= 0 );
 	HELIUM_ASSERT( !pBaseType || pBaseType->m_TypeId != Invalid<Components::TypeId>() );
@@ -154,6 +167,7 @@ const TypeData* Components::GetTypeData( TypeId type )
 
 ComponentManager *Components::CreateManager( World *pWorld )
 {
+	HELIUM_ASSERT( !g_ComponentsParallelUpdate );
 	HELIUM_ASSERT( g_ComponentsInitCount );
 	++g_ComponentsInitCount;
 	ComponentManagerPtr return_value( new ComponentManager(pWorld) );
@@ -423,6 +437,8 @@ void Helium::Components::Pool::SpewRosterToTty()
 Helium::ComponentManager::ComponentManager(World *pWorld)
 	: m_World(pWorld)
 {
+	HELIUM_ASSERT( !g_ComponentsParallelUpdate );
+
 	for (DynamicArray<TypeData *>::Iterator iter = g_ComponentTypes.Begin();
 		iter != g_ComponentTypes.End(); ++iter)
 	{
@@ -434,6 +450,8 @@ Helium::ComponentManager::ComponentManager(World *pWorld)
 
 Helium::ComponentManager::~ComponentManager()
 {
+	HELIUM_ASSERT( !g_ComponentsParallelUpdate );
+
 	Tick(); // Process pending deletes if necessary
 
 	for (DynamicArray<Pool *>::Iterator iter = m_Pools.Begin();
@@ -459,6 +477,8 @@ Helium::ComponentManager::~ComponentManager()
 
 void Helium::Components::Tick()
 {
+	HELIUM_ASSERT( !g_ComponentsParallelUpdate );
+
 	++g_ComponentProcessPendingDeletesCallCount;
 
 	// Look at our registry of component ptrs, we may need to force some of them to invalidate (a ptr must be checked
@@ -485,8 +505,24 @@ void Helium::Components::Tick()
 		g_ComponentPtrRegistry[registry_index]->m_ComponentPtrRegistryHeadIndex == registry_index);
 }
 
+// Mark the start of a parallel world update.  Until EndParallelUpdate() is called, component types, component managers
+// and the component pointer check in Tick() may not be touched, as they are shared by all worlds.
+void Helium::Components::BeginParallelUpdate()
+{
+	HELIUM_ASSERT( !g_ComponentsParallelUpdate );
+	g_ComponentsParallelUpdate = true;
+}
+
+void Helium::Components::EndParallelUpdate()
+{
+	HELIUM_ASSERT( g_ComponentsParallelUpdate );
+	g_ComponentsParallelUpdate = false;
+}
+
 void Helium::ComponentManager::RegisterComponentPtr( ComponentPtrBase &pPtr )
 {
+	MutexScopeLock registryLock( g_ComponentPtrRegistryLock );
+
 	uint16_t registry_index = g_ComponentProcessPendingDeletesCallCount % COMPONENT_PTR_CHECK_FREQUENCY;
 	pPtr.m_Next = g_ComponentPtrRegistry[registry_index];
 	
@@ -518,6 +554,8 @@ size_t Helium::ComponentManager::CountAllocatedComponentsThatImplement( Componen
 
 void Helium::ComponentPtrBase::Unlink() const
 {
+	MutexScopeLock registryLock( g_ComponentPtrRegistryLock );
+
 	// If we are the head node in the component ptr registry, we need to point it to the new head
 	if (m_ComponentPtrRegistryHeadIndex != Helium::Invalid<uint16_t>())
 	{
@@ -224,6 +224,9 @@ namespace Helium
 		HELIUM_FRAMEWORK_API void                Initialize( SystemDefinition *pSystemDefinition );
 		HELIUM_FRAMEWORK_API void                Cleanup();
 		HELIUM_FRAMEWORK_API void                Tick();
+
+		HELIUM_FRAMEWORK_API void                BeginParallelUpdate();
+		HELIUM_FRAMEWORK_API void                EndParallelUpdate();
 		
 		HELIUM_FRAMEWORK_API TypeId              RegisterType(
 			const Reflect::MetaStruct *_structure, 
@@ -2,6 +2,7 @@
 #include "Framework/GameSystem.h"
 
 #include "Engine/AsyncLoader.h"
+#include "Engine/BootSnapshot.h"
 #include "Engine/FileLocations.h"
 #include "Foundation/FilePath.h"
 #include "Foundation/DirectoryIterator.h"
@@ -10,6 +11,7 @@
 #include "Platform/Process.h"
 #include "Engine/Config.h"
 #include "Engine/CacheManager.h"
+#include "Engine/FrameProfiler.h"
 #include "Framework/CommandLineInitialization.h"
 #include "Framework/MemoryHeapPreInitialization.h"
 #include "Framework/AssetLoaderInitialization.h"
@@ -23,10 +25,16 @@
 
 using namespace Helium;
 
+const float32_t GameSystem::DEFAULT_SERVER_FRAME_RATE = 30.0f;
+
 /// Constructor.
 GameSystem::GameSystem()
 : m_pAssetLoaderInitialization( NULL )
 , m_bStopRunning( false )
+, m_serverFrameRate( 0.0f )
+, m_bootPhaseStartTickCount( 0 )
+, m_timeToFirstFrame( 0.0f )
+, m_bBootComplete( false )
 {
 }
 
@@ -58,6 +66,12 @@ bool GameSystem::Initialize(
 	RendererInitialization& rRendererInitialization,
 	AssetPath &rSystemDefinitionPath)
 {
+	// Time each phase of booting until the end of the first frame.
+	m_bootPhases.Clear();
+	m_bootPhaseStartTickCount = Timer::GetTickCount();
+	m_timeToFirstFrame = 0.0f;
+	m_bBootComplete = false;
+
 	// Initialize command-line parameters.
 	bool bCommandLineInitSuccess = rCommandLineInitialization.Initialize( m_moduleName, m_arguments );
 	HELIUM_ASSERT( bCommandLineInitSuccess );
@@ -78,6 +92,20 @@ bool GameSystem::Initialize(
 	}
 #endif
 
+#if HELIUM_FRAME_PROFILER
+	// Profiler event capture is off unless requested with "-profile" (the trace is written out on shutdown).
+	size_t profileArgumentCount = m_arguments.GetSize();
+	for( size_t argumentIndex = 0; argumentIndex < profileArgumentCount; ++argumentIndex )
+	{
+		if( strcmp( *m_arguments[ argumentIndex ], TXT( "-profile" ) ) == 0 )
+		{
+			FrameProfiler::SetCaptureEnabled( true );
+
+			break;
+		}
+	}
+#endif
+
 #if HELIUM_SHARED
 	// Initialize sibling dynamically loaded modules.
 	FilePath path ( *m_moduleName );
@@ -95,6 +123,8 @@ bool GameSystem::Initialize(
 	HELIUM_ASSERT( false );
 #endif
 
+	EndBootPhase( TXT( "Modules" ) );
+
 	// Initialize the async loading thread.
 	bool bAsyncLoaderInitSuccess = AsyncLoader::GetStaticInstance().Initialize();
 	HELIUM_ASSERT( bAsyncLoaderInitSuccess );
@@ -133,6 +163,14 @@ bool GameSystem::Initialize(
 
 	m_pAssetLoaderInitialization = &rAssetLoaderInitialization;
 
+#if !HELIUM_TOOLS
+	// Move package loading, deserialization and linking off the main thread.  Tools builds keep loading on the main
+	// thread, as loose package loaders are also accessed directly by the preprocessing and file watching code.
+	pAssetLoader->StartLoadThread();
+#endif
+
+	EndBootPhase( TXT( "Asset loader" ) );
+
 	// Initialize system configuration.
 	bool bConfigInitSuccess = rConfigInitialization.Initialize();
 	HELIUM_ASSERT( bConfigInitSuccess );
@@ -143,6 +181,8 @@ bool GameSystem::Initialize(
 		return false;
 	}
 
+	EndBootPhase( TXT( "Config" ) );
+
 	if ( !rSystemDefinitionPath.IsEmpty() )
 	{
 		pAssetLoader->LoadObject<SystemDefinition>( rSystemDefinitionPath, m_spSystemDefinition );
@@ -160,6 +200,8 @@ bool GameSystem::Initialize(
 
 	TaskScheduler::CalculateSchedule( TickTypes::RenderingGame, m_Schedule );
 
+	EndBootPhase( TXT( "System definition" ) );
+
 	// Create and initialize the window manager (note that we need a window manager for message loop processing, so
 	// the instance cannot be left null).
 	bool bWindowManagerInitSuccess = rWindowManagerInitialization.Initialize();
@@ -170,6 +212,8 @@ bool GameSystem::Initialize(
 
 		return false;
 	}
+
+	EndBootPhase( TXT( "Window manager" ) );
 	
 	// Create and initialize the renderer.
 	bool bRendererInitSuccess = rRendererInitialization.Initialize();
@@ -182,6 +226,8 @@ bool GameSystem::Initialize(
 	}
 
 	m_pRendererInitialization = &rRendererInitialization;
+
+	EndBootPhase( TXT( "Renderer" ) );
 	
 	// Initialize the world manager and main game world.
 	WorldManager& rWorldManager = WorldManager::GetStaticInstance();
@@ -194,6 +240,39 @@ bool GameSystem::Initialize(
 		return false;
 	}
 
+	EndBootPhase( TXT( "World manager" ) );
+
+	// Check for dedicated server mode ("-server [-tickrate <frames per second>]").
+	bool bServerMode = false;
+	float32_t serverFrameRate = DEFAULT_SERVER_FRAME_RATE;
+
+	size_t serverArgumentCount = m_arguments.GetSize();
+	for( size_t argumentIndex = 0; argumentIndex < serverArgumentCount; ++argumentIndex )
+	{
+		const char* pArgument = *m_arguments[ argumentIndex ];
+		const char* pValue = ( argumentIndex + 1 < serverArgumentCount ? *m_arguments[ argumentIndex + 1 ] : NULL );
+
+		if( strcmp( pArgument, TXT( "-server" ) ) == 0 )
+		{
+			bServerMode = true;
+		}
+		else if( pValue && strcmp( pArgument, TXT( "-tickrate" ) ) == 0 )
+		{
+			if( StringScan( pValue, TXT( "%f" ), &serverFrameRate ) != 1 || serverFrameRate <= 0.0f )
+			{
+				HELIUM_TRACE( TraceLevels::Warning, TXT( "GameSystem::Initialize(): Invalid tick rate \"%s\".\n" ), pValue );
+				serverFrameRate = DEFAULT_SERVER_FRAME_RATE;
+			}
+
+			++argumentIndex;
+		}
+	}
+
+	if( bServerMode && !EnableServerMode( serverFrameRate ) )
+	{
+		return false;
+	}
+
 	// Initialization complete.
 	return true;
 }
@@ -203,6 +282,25 @@ bool GameSystem::Initialize(
 /// @see Initialize()
 void GameSystem::Shutdown()
 {
+#if HELIUM_FRAME_PROFILER
+	// Dump the captured profile data if requested on the command line.
+	size_t argumentCount = m_arguments.GetSize();
+	for( size_t argumentIndex = 0; argumentIndex < argumentCount; ++argumentIndex )
+	{
+		if( strcmp( *m_arguments[ argumentIndex ], TXT( "-profile" ) ) == 0 )
+		{
+			FilePath profilePath;
+			if( FileLocations::GetUserDataDirectory( profilePath ) )
+			{
+				profilePath += TXT( "FrameProfile.json" );
+				FrameProfiler::WriteChromeTrace( String( profilePath.c_str() ) );
+			}
+
+			break;
+		}
+	}
+#endif
+
 	WorldManager::DestroyStaticInstance();
 
 	if( m_pRendererInitialization )
@@ -223,10 +321,18 @@ void GameSystem::Shutdown()
 
 	if( m_pAssetLoaderInitialization )
 	{
+		AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+		if( pAssetLoader )
+		{
+			pAssetLoader->StopLoadThread();
+		}
+
 		m_pAssetLoaderInitialization->Shutdown();
 		m_pAssetLoaderInitialization = NULL;
 	}
 
+	BootSnapshot::DestroyStaticInstance();
+
 	Reflect::Cleanup();
 	AssetType::Shutdown();
 	Asset::Shutdown();
@@ -251,6 +357,16 @@ void GameSystem::Shutdown()
 /// @return  Result code of application execution.
 int32_t GameSystem::Run()
 {
+	if( IsServerMode() )
+	{
+		return RunServer();
+	}
+
+	if( !m_bBootComplete )
+	{
+		EndBootPhase( TXT( "Application setup" ) );
+	}
+
 	while ( !m_bStopRunning )
 	{
 		AssetLoader::GetStaticInstance()->Tick();
@@ -258,6 +374,13 @@ int32_t GameSystem::Run()
 
 		WorldManager& rWorldManager = WorldManager::GetStaticInstance();
 		rWorldManager.Update( m_Schedule );
+
+		HELIUM_FRAME_PROFILE_END_FRAME();
+
+		if( !m_bBootComplete )
+		{
+			FinishBoot();
+		}
 	}
 
 	m_bStopRunning = false;
@@ -295,4 +418,227 @@ World *GameSystem::LoadScene( SceneDefinition *pSceneDefinition )
 void GameSystem::StopRunning()
 {
 	m_bStopRunning = true;
-}
\ No newline at end of file
+}
+
+/// Switch this system to dedicated server mode.
+///
+/// In dedicated server mode, only tasks required for gameplay are scheduled, worlds are updated independently of each
+/// other across the shared worker pool, and Run() steps the simulation at a fixed rate, sleeping between frames
+/// instead of running as fast as possible.  Per-world tick times are reported periodically to help determine how many
+/// worlds can be hosted by each process.
+///
+/// @param[in] framesPerSecond  Simulation rate, in frames per second.
+///
+/// @return  True if dedicated server mode was enabled, false if not.
+///
+/// @see IsServerMode()
+bool GameSystem::EnableServerMode( float32_t framesPerSecond )
+{
+	HELIUM_ASSERT( framesPerSecond > 0.0f );
+
+	TaskSchedule schedule;
+	if( !TaskScheduler::CalculateSchedule( TickTypes::HeadlessGame, schedule ) )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "GameSystem::EnableServerMode(): Failed to calculate the headless task schedule.\n" ) );
+
+		return false;
+	}
+
+	WorldManager& rWorldManager = WorldManager::GetStaticInstance();
+	rWorldManager.EnableParallelUpdate();
+	rWorldManager.SetFixedFrameRate( framesPerSecond );
+
+	m_Schedule = schedule;
+	m_serverFrameRate = framesPerSecond;
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "GameSystem: Running as a dedicated server at %.1f frames per second with %" ) PRIuSZ TXT( " world thread(s).\n" ),
+		framesPerSecond,
+		rWorldManager.GetWorkerThreadCount() + 1 );
+
+	return true;
+}
+
+/// Run the dedicated server application loop.
+///
+/// @return  Result code of application execution.
+///
+/// @see Run(), EnableServerMode()
+int32_t GameSystem::RunServer()
+{
+	HELIUM_ASSERT( m_serverFrameRate > 0.0f );
+
+	uint64_t frameTickCount = Max< uint64_t >(
+		static_cast< uint64_t >( static_cast< float64_t >( Timer::GetTicksPerSecond() ) / m_serverFrameRate ),
+		1 );
+	float32_t frameMilliseconds = 1000.0f / m_serverFrameRate;
+	uint32_t reportFrameCount = Max< uint32_t >(
+		static_cast< uint32_t >( m_serverFrameRate * static_cast< float32_t >( SERVER_STATS_REPORT_INTERVAL ) ),
+		1 );
+
+	WorldManager& rWorldManager = WorldManager::GetStaticInstance();
+	rWorldManager.ResetWorldTickStats();
+
+	uint64_t nextFrameTickCount = Timer::GetTickCount();
+	uint32_t framesUntilReport = reportFrameCount;
+
+	if( !m_bBootComplete )
+	{
+		EndBootPhase( TXT( "Application setup" ) );
+	}
+
+	while ( !m_bStopRunning )
+	{
+		AssetLoader::GetStaticInstance()->Tick();
+		m_AssetSyncUtility.Sync();
+
+		rWorldManager.Update( m_Schedule );
+
+		HELIUM_FRAME_PROFILE_END_FRAME();
+
+		if( !m_bBootComplete )
+		{
+			FinishBoot();
+		}
+
+		if( --framesUntilReport == 0 )
+		{
+			ReportServerStats( frameMilliseconds );
+			framesUntilReport = reportFrameCount;
+		}
+
+		// Sleep until the next frame is due.  If the server has fallen too far behind, drop the missed frames rather
+		// than running back-to-back frames trying to catch up.
+		nextFrameTickCount += frameTickCount;
+
+		uint64_t currentTickCount = Timer::GetTickCount();
+		if( currentTickCount < nextFrameTickCount )
+		{
+			uint32_t sleepMilliseconds = static_cast< uint32_t >( Timer::TicksToMilliseconds( nextFrameTickCount - currentTickCount ) );
+			if( sleepMilliseconds != 0 )
+			{
+				Thread::Sleep( sleepMilliseconds );
+			}
+		}
+		else if( currentTickCount - nextFrameTickCount > frameTickCount * MAX_SERVER_FRAME_LAG )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "GameSystem: Server frame overran by %.2f ms; dropping missed frames.\n" ),
+				static_cast< float32_t >( Timer::TicksToMilliseconds( currentTickCount - nextFrameTickCount ) ) );
+
+			nextFrameTickCount = currentTickCount;
+		}
+	}
+
+	m_bStopRunning = false;
+
+	return 0;
+}
+
+/// Log the tick time statistics of each world along with the overall world thread utilization.
+///
+/// @param[in] frameMilliseconds  Time available for each frame, in milliseconds.
+void GameSystem::ReportServerStats( float32_t frameMilliseconds )
+{
+	WorldManager& rWorldManager = WorldManager::GetStaticInstance();
+
+	float32_t totalAverageMilliseconds = 0.0f;
+
+	size_t worldCount = rWorldManager.GetWorldCount();
+	for( size_t worldIndex = 0; worldIndex < worldCount; ++worldIndex )
+	{
+		const WorldManager::WorldTickStats& rTickStats = rWorldManager.GetWorldTickStats( worldIndex );
+		totalAverageMilliseconds += rTickStats.averageMilliseconds;
+
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			( TXT( "GameSystem: World %" ) PRIuSZ TXT( ": %.3f ms average, %.3f ms last, %.3f ms max over %" ) PRIu64
+			TXT( " ticks.\n" ) ),
+			worldIndex,
+			rTickStats.averageMilliseconds,
+			rTickStats.lastMilliseconds,
+			rTickStats.maximumMilliseconds,
+			rTickStats.tickCount );
+	}
+
+	// Estimate how much of the available world thread time is in use, which indicates how many more worlds can fit.
+	size_t threadCount = rWorldManager.GetWorkerThreadCount() + 1;
+	float32_t utilization = totalAverageMilliseconds / ( frameMilliseconds * static_cast< float32_t >( threadCount ) );
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		( TXT( "GameSystem: %" ) PRIuSZ TXT( " world(s) using %.3f ms per %.3f ms frame across %" ) PRIuSZ
+		TXT( " thread(s) (%.1f%% utilization).\n" ) ),
+		worldCount,
+		totalAverageMilliseconds,
+		frameMilliseconds,
+		threadCount,
+		utilization * 100.0f );
+}
+
+/// Record the time spent in the current boot phase and start timing the next one.
+///
+/// @param[in] pName  Name of the phase that just ended.
+///
+/// @see FinishBoot()
+void GameSystem::EndBootPhase( const char* pName )
+{
+	HELIUM_ASSERT( pName );
+	HELIUM_ASSERT( !m_bBootComplete );
+
+	uint64_t tickCount = Timer::GetTickCount();
+
+	BootPhase* pPhase = m_bootPhases.New();
+	HELIUM_ASSERT( pPhase );
+	pPhase->pName = pName;
+	pPhase->milliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( tickCount - m_bootPhaseStartTickCount ) );
+
+	m_bootPhaseStartTickCount = tickCount;
+}
+
+/// Finish booting once the first frame has ended, reporting the time to first frame broken down by boot phase and
+/// writing out the boot snapshot if one was recorded.
+///
+/// @see EndBootPhase()
+void GameSystem::FinishBoot()
+{
+	EndBootPhase( TXT( "First frame" ) );
+
+	m_bBootComplete = true;
+
+	m_timeToFirstFrame = 0.0f;
+	size_t phaseCount = m_bootPhases.GetSize();
+	for( size_t phaseIndex = 0; phaseIndex < phaseCount; ++phaseIndex )
+	{
+		m_timeToFirstFrame += m_bootPhases[ phaseIndex ].milliseconds;
+	}
+
+	HELIUM_TRACE( TraceLevels::Info, TXT( "GameSystem: Time to first frame: %.2f ms.\n" ), m_timeToFirstFrame );
+	for( size_t phaseIndex = 0; phaseIndex < phaseCount; ++phaseIndex )
+	{
+		const BootPhase& rPhase = m_bootPhases[ phaseIndex ];
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "GameSystem: * %s: %.2f ms (%.1f%%).\n" ),
+			rPhase.pName,
+			rPhase.milliseconds,
+			( m_timeToFirstFrame > 0.0f ? rPhase.milliseconds * 100.0f / m_timeToFirstFrame : 0.0f ) );
+	}
+
+	BootSnapshot& rBootSnapshot = BootSnapshot::GetStaticInstance();
+	size_t snapshotEntryCount = rBootSnapshot.GetEntryCount();
+	bool bRecorded = rBootSnapshot.IsRecording();
+	if( !rBootSnapshot.FinishBoot() )
+	{
+		HELIUM_TRACE( TraceLevels::Warning, TXT( "GameSystem: Failed to write the boot snapshot.\n" ) );
+	}
+	else if( bRecorded && snapshotEntryCount != 0 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "GameSystem: Recorded a boot snapshot of %" ) PRIuSZ TXT( " assets for the next launch.\n" ),
+			snapshotEntryCount );
+	}
+}
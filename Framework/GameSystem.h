@@ -24,6 +24,22 @@ namespace Helium
 	class HELIUM_FRAMEWORK_API GameSystem : public System
 	{
 	public:
+		/// Default dedicated server simulation rate, in frames per second.
+		static const float32_t DEFAULT_SERVER_FRAME_RATE;
+		/// Number of frames a dedicated server can fall behind its simulation rate before it stops trying to catch up.
+		static const uint32_t MAX_SERVER_FRAME_LAG = 5;
+		/// Interval between dedicated server world tick time reports, in seconds.
+		static const uint32_t SERVER_STATS_REPORT_INTERVAL = 10;
+
+		/// Time spent in one phase of booting up to the end of the first frame.
+		struct BootPhase
+		{
+			/// Phase name.
+			const char* pName;
+			/// Time spent in the phase, in milliseconds.
+			float32_t milliseconds;
+		};
+
 		/// @name Construction/Destruction
 		//@{
 		GameSystem();
@@ -50,6 +66,20 @@ namespace Helium
 		virtual int32_t Run();
 		//@}
 
+		/// @name Dedicated Server Support
+		//@{
+		bool EnableServerMode( float32_t framesPerSecond );
+		inline bool IsServerMode() const;
+		//@}
+
+		/// @name Boot Timing
+		//@{
+		inline bool IsBootComplete() const;
+		inline size_t GetBootPhaseCount() const;
+		inline const BootPhase& GetBootPhase( size_t index ) const;
+		inline float32_t GetTimeToFirstFrame() const;
+		//@}
+
 		/// @name Static Initialization
 		//@{
 		static GameSystem* CreateStaticInstance();
@@ -65,5 +95,31 @@ namespace Helium
 		AssetAwareThreadSynchronizer m_AssetSyncUtility;
 		TaskSchedule                 m_Schedule;
 		bool                         m_bStopRunning;
+
+		/// Dedicated server simulation rate, in frames per second (zero if not running as a dedicated server).
+		float32_t                    m_serverFrameRate;
+
+		/// Time spent in each boot phase completed so far.
+		DynamicArray< BootPhase >    m_bootPhases;
+		/// Tick count at which the current boot phase started.
+		uint64_t                     m_bootPhaseStartTickCount;
+		/// Total time from the start of initialization to the end of the first frame, in milliseconds.
+		float32_t                    m_timeToFirstFrame;
+		/// True once the first frame has finished.
+		bool                         m_bBootComplete;
+
+		/// @name Dedicated Server Support
+		//@{
+		int32_t RunServer();
+		void ReportServerStats( float32_t frameMilliseconds );
+		//@}
+
+		/// @name Boot Timing
+		//@{
+		void EndBootPhase( const char* pName );
+		void FinishBoot();
+		//@}
 	};
 }
+
+#include "Framework/GameSystem.inl"
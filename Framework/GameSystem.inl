@@ -0,0 +1,54 @@
+namespace Helium
+{
+	/// Get whether this system is running as a dedicated server.
+	///
+	/// @return  True if running in dedicated server mode, false if not.
+	///
+	/// @see EnableServerMode()
+	bool GameSystem::IsServerMode() const
+	{
+		return ( m_serverFrameRate > 0.0f );
+	}
+
+	/// Get whether booting has completed (the first frame has finished).
+	///
+	/// @return  True if the first frame has finished, false if not.
+	///
+	/// @see GetTimeToFirstFrame()
+	bool GameSystem::IsBootComplete() const
+	{
+		return m_bBootComplete;
+	}
+
+	/// Get the number of boot phases timed so far.
+	///
+	/// @return  Boot phase count.
+	///
+	/// @see GetBootPhase()
+	size_t GameSystem::GetBootPhaseCount() const
+	{
+		return m_bootPhases.GetSize();
+	}
+
+	/// Get the timing of a boot phase.
+	///
+	/// @param[in] index  Boot phase index.
+	///
+	/// @return  Boot phase timing.
+	///
+	/// @see GetBootPhaseCount()
+	const GameSystem::BootPhase& GameSystem::GetBootPhase( size_t index ) const
+	{
+		return m_bootPhases[ index ];
+	}
+
+	/// Get the total time from the start of initialization to the end of the first frame.
+	///
+	/// @return  Time to first frame, in milliseconds (zero if the first frame has not finished yet).
+	///
+	/// @see IsBootComplete()
+	float32_t GameSystem::GetTimeToFirstFrame() const
+	{
+		return m_timeToFirstFrame;
+	}
+}
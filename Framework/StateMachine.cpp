@@ -45,6 +45,8 @@ void StateMachineDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
 
 /// Constructor.
 StateMachineDefinition::StateMachineDefinition()
+: m_InitialState(NULL)
+, m_InitialStateIndex(Invalid< uint32_t >())
 {
 }
 
@@ -175,6 +177,83 @@ void StateMachineDefinition::FinalizeLoad()
 			*GetPath().ToString(),
 			*m_InitialStateName);
 	}
+
+	CompileStates();
+}
+
+/// Replace the states of this state machine.
+///
+/// This is intended for state machines built in code rather than loaded.  FinalizeLoad() must be called afterwards to
+/// resolve the state names and compile the transition tables.
+///
+/// @param[in] rStates            States to copy.
+/// @param[in] initialStateName  Name of the state in which new instances start.
+void StateMachineDefinition::SetStates( const DynamicArray< State >& rStates, Name initialStateName )
+{
+	m_States = rStates;
+	m_InitialStateName = initialStateName;
+	m_InitialState = NULL;
+
+	m_CompiledStates.Clear();
+	m_CompiledTransitions.Clear();
+	SetInvalid( m_InitialStateIndex );
+}
+
+/// Build the flat state and transition tables used by StateMachineBatch.
+///
+/// This must be called after the state names have been resolved.  Transitions to states that could not be resolved
+/// are left out.
+void StateMachineDefinition::CompileStates()
+{
+	m_CompiledStates.Resize( 0 );
+	m_CompiledTransitions.Resize( 0 );
+	SetInvalid( m_InitialStateIndex );
+
+	size_t stateCount = m_States.GetSize();
+	m_CompiledStates.Reserve( stateCount );
+
+	for ( size_t stateIndex = 0; stateIndex < stateCount; ++stateIndex )
+	{
+		const State& rState = m_States[ stateIndex ];
+
+		CompiledState compiledState;
+		compiledState.firstTransitionIndex = static_cast< uint32_t >( m_CompiledTransitions.GetSize() );
+		compiledState.earliestTransitionTime = NumericLimits< float32_t >::Maximum;
+		compiledState.stateBitmask = rState.m_StateBitmask;
+		compiledState.pOnEnterAction = rState.m_OnEnterAction;
+		compiledState.pOnExitAction = rState.m_OnExitAction;
+
+		for ( DynamicArray<StateTransition>::ConstIterator transitionIter = rState.m_Transitions.Begin();
+			transitionIter != rState.m_Transitions.End(); ++transitionIter )
+		{
+			if ( !transitionIter->m_NextState )
+			{
+				// We gave an error message for this already
+				continue;
+			}
+
+			CompiledTransition compiledTransition;
+			compiledTransition.minimumTimeInState = transitionIter->m_MinimumTimeInState;
+			compiledTransition.nextStateIndex = static_cast< uint32_t >( transitionIter->m_NextState - m_States.GetData() );
+			compiledTransition.pRequiredPredicate = transitionIter->m_RequiredPredicate;
+			compiledTransition.bRequiredPredicateResult = transitionIter->m_RequiredPredicateResult;
+			m_CompiledTransitions.Push( compiledTransition );
+
+			if ( compiledTransition.minimumTimeInState < compiledState.earliestTransitionTime )
+			{
+				compiledState.earliestTransitionTime = compiledTransition.minimumTimeInState;
+			}
+		}
+
+		compiledState.transitionCount =
+			static_cast< uint32_t >( m_CompiledTransitions.GetSize() ) - compiledState.firstTransitionIndex;
+		m_CompiledStates.Push( compiledState );
+	}
+
+	if ( m_InitialState )
+	{
+		m_InitialStateIndex = static_cast< uint32_t >( m_InitialState - m_States.GetData() );
+	}
 }
 
 void StateMachineInstance::Initialize( World &world, const StateMachineDefinition *pStateMachineDefinition )
@@ -189,8 +268,15 @@ void StateMachineInstance::Tick( World &world, float dt )
 {
 	float timeInTick = dt;
 
-	while ( timeInTick > 0.0f )
+	for ( uint32_t transitionCount = 0; timeInTick > 0.0f; ++transitionCount )
 	{
+		// Same guard as StateMachineBatch against cycles of transitions that do not consume any time.
+		if ( transitionCount >= StateMachineBatch::TRANSITION_COUNT_MAX_PER_TICK )
+		{
+			m_TimeInState += timeInTick;
+			break;
+		}
+
 		bool m_Transitioned = false;
 		for ( DynamicArray<StateTransition>::Iterator iter = m_CurrentState->m_Transitions.Begin();
 			iter != m_CurrentState->m_Transitions.End(); ++iter )
@@ -224,13 +310,15 @@ bool StateMachineInstance::EvaluateTransition( World &world, StateTransition &tr
 	}
 
 	// Do additional checking
-	if ( transition.m_RequiredPredicate && !transition.m_RequiredPredicate->Evaluate( world, NULL ) )
+	if ( transition.m_RequiredPredicate &&
+		transition.m_RequiredPredicate->Evaluate( world, NULL ) != transition.m_RequiredPredicateResult )
 	{
 		return false;
 	}
 
-	timeToConsume = transition.m_MinimumTimeInState - m_TimeInState;
-	HELIUM_ASSERT(timeToConsume >= 0.0f);
+	// Transitions whose minimum time has already passed (because a predicate held them back) take effect
+	// immediately.
+	timeToConsume = Max( transition.m_MinimumTimeInState - m_TimeInState, 0.0f );
 	HELIUM_ASSERT(timeToConsume <= dt);
 	return true;
 }
@@ -273,3 +361,192 @@ void StateMachineInstance::OnExitState( World &world, State *pState )
 		pState->m_OnExitAction->PerformAction( world, NULL );
 	}
 }
+
+/// Constructor.
+StateMachineBatch::StateMachineBatch()
+{
+}
+
+/// Destructor.
+StateMachineBatch::~StateMachineBatch()
+{
+}
+
+/// Set the definition shared by all instances in this batch.
+///
+/// @param[in] pStateMachineDefinition  State machine definition, which must have been finalized.
+///
+/// @see Shutdown()
+void StateMachineBatch::Initialize( const StateMachineDefinition *pStateMachineDefinition )
+{
+	HELIUM_ASSERT( pStateMachineDefinition );
+	HELIUM_ASSERT( m_CurrentStateIndices.IsEmpty() );
+
+	m_Definition = pStateMachineDefinition;
+}
+
+/// Remove all instances and release the definition.
+///
+/// @see Initialize()
+void StateMachineBatch::Shutdown()
+{
+	m_CurrentStateIndices.Clear();
+	m_TimesInState.Clear();
+	m_Definition.Release();
+}
+
+/// Add an instance in the initial state of the definition.
+///
+/// @param[in] world  World in which the on-enter action of the initial state is performed.
+///
+/// @return  Index of the new instance.
+///
+/// @see RemoveInstance()
+uint32_t StateMachineBatch::AddInstance( World &world )
+{
+	HELIUM_ASSERT( m_Definition );
+
+	uint32_t instanceIndex = static_cast< uint32_t >( m_CurrentStateIndices.GetSize() );
+	uint32_t stateIndex = m_Definition->m_InitialStateIndex;
+
+	m_CurrentStateIndices.Push( stateIndex );
+	m_TimesInState.Push( 0.0f );
+
+	if ( IsValid( stateIndex ) )
+	{
+		Action* pOnEnterAction = m_Definition->m_CompiledStates[ stateIndex ].pOnEnterAction;
+		if ( pOnEnterAction )
+		{
+			pOnEnterAction->PerformAction( world, NULL );
+		}
+	}
+
+	return instanceIndex;
+}
+
+/// Remove an instance.
+///
+/// The last instance is moved into the slot of the removed instance, so its index changes to the given index.
+///
+/// @param[in] instanceIndex  Index of the instance to remove.
+///
+/// @see AddInstance()
+void StateMachineBatch::RemoveInstance( uint32_t instanceIndex )
+{
+	HELIUM_ASSERT( instanceIndex < m_CurrentStateIndices.GetSize() );
+
+	m_CurrentStateIndices.RemoveSwap( instanceIndex );
+	m_TimesInState.RemoveSwap( instanceIndex );
+}
+
+/// Advance all instances in this batch.
+///
+/// Instances are processed in order and take transitions with the same rules as StateMachineInstance::Tick().
+///
+/// @param[in] world  World in which predicates are evaluated and actions are performed.
+/// @param[in] dt     Time step, in seconds.
+void StateMachineBatch::Tick( World &world, float dt )
+{
+	if ( dt <= 0.0f || !m_Definition )
+	{
+		return;
+	}
+
+	const StateMachineDefinition::CompiledState* pStates = m_Definition->m_CompiledStates.GetData();
+	const uint32_t* pCurrentStateIndices = m_CurrentStateIndices.GetData();
+	float* pTimesInState = m_TimesInState.GetData();
+
+	uint32_t instanceCount = static_cast< uint32_t >( m_CurrentStateIndices.GetSize() );
+	for ( uint32_t instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex )
+	{
+		uint32_t stateIndex = pCurrentStateIndices[ instanceIndex ];
+		if ( IsInvalid( stateIndex ) )
+		{
+			continue;
+		}
+
+		// Most instances are waiting out a timer and cannot take any transition this tick.
+		float timeInState = pTimesInState[ instanceIndex ] + dt;
+		if ( timeInState < pStates[ stateIndex ].earliestTransitionTime )
+		{
+			pTimesInState[ instanceIndex ] = timeInState;
+			continue;
+		}
+
+		AdvanceInstance( world, instanceIndex, dt );
+	}
+}
+
+/// Evaluate the transitions of a single instance, taking as many as the time step allows.
+///
+/// @param[in] world          World in which predicates are evaluated and actions are performed.
+/// @param[in] instanceIndex  Instance index.
+/// @param[in] dt             Time step, in seconds.
+void StateMachineBatch::AdvanceInstance( World &world, uint32_t instanceIndex, float dt )
+{
+	const StateMachineDefinition::CompiledState* pStates = m_Definition->m_CompiledStates.GetData();
+	const StateMachineDefinition::CompiledTransition* pTransitions = m_Definition->m_CompiledTransitions.GetData();
+
+	uint32_t stateIndex = m_CurrentStateIndices[ instanceIndex ];
+	float timeInState = m_TimesInState[ instanceIndex ];
+	float timeInTick = dt;
+
+	for ( uint32_t transitionCount = 0; timeInTick > 0.0f; ++transitionCount )
+	{
+		const StateMachineDefinition::CompiledState& rState = pStates[ stateIndex ];
+		if ( transitionCount >= TRANSITION_COUNT_MAX_PER_TICK || timeInState + timeInTick < rState.earliestTransitionTime )
+		{
+			timeInState += timeInTick;
+			break;
+		}
+
+		const StateMachineDefinition::CompiledTransition* pTransition = pTransitions + rState.firstTransitionIndex;
+		const StateMachineDefinition::CompiledTransition* pTransitionEnd = pTransition + rState.transitionCount;
+		for ( ; pTransition != pTransitionEnd; ++pTransition )
+		{
+			if ( timeInState + timeInTick < pTransition->minimumTimeInState )
+			{
+				continue;
+			}
+
+			if ( pTransition->pRequiredPredicate &&
+				pTransition->pRequiredPredicate->Evaluate( world, NULL ) != pTransition->bRequiredPredicateResult )
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		if ( pTransition == pTransitionEnd )
+		{
+			timeInState += timeInTick;
+			break;
+		}
+
+		// Transitions whose minimum time has already passed (because a predicate held them back) take effect
+		// immediately.
+		float timeToConsume = pTransition->minimumTimeInState - timeInState;
+		if ( timeToConsume > 0.0f )
+		{
+			timeInTick -= timeToConsume;
+		}
+
+		if ( rState.pOnExitAction )
+		{
+			rState.pOnExitAction->PerformAction( world, NULL );
+		}
+
+		stateIndex = pTransition->nextStateIndex;
+		timeInState = 0.0f;
+
+		Action* pOnEnterAction = pStates[ stateIndex ].pOnEnterAction;
+		if ( pOnEnterAction )
+		{
+			pOnEnterAction->PerformAction( world, NULL );
+		}
+	}
+
+	m_CurrentStateIndices[ instanceIndex ] = stateIndex;
+	m_TimesInState[ instanceIndex ] = timeInState;
+}
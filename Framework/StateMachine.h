@@ -12,6 +12,7 @@ namespace Helium
 {
 	class State;
 	class StateMachineInstance;
+	class StateMachineBatch;
 
 	typedef uint32_t StateBitmask;
 
@@ -75,14 +76,62 @@ namespace Helium
 
 		virtual void FinalizeLoad();
 
+		/// @name Definition Building
+		//@{
+		void SetStates( const DynamicArray< State >& rStates, Name initialStateName );
+		//@}
+
 	private:
 		friend StateMachineInstance;
+		friend StateMachineBatch;
+
+		/// Flattened state, referencing a contiguous range of compiled transitions.
+		struct CompiledState
+		{
+			/// Index of the first transition out of this state.
+			uint32_t firstTransitionIndex;
+			/// Number of transitions out of this state.
+			uint32_t transitionCount;
+			/// Smallest minimum time in state of any transition (instances that have not reached this time can skip
+			/// evaluating transitions entirely).
+			float earliestTransitionTime;
+			/// State flags.
+			StateBitmask stateBitmask;
+
+			/// Action to perform when entering this state.
+			Action* pOnEnterAction;
+			/// Action to perform when leaving this state.
+			Action* pOnExitAction;
+		};
+
+		/// Flattened state transition.
+		struct CompiledTransition
+		{
+			/// Minimum time that must be spent in the current state before this transition can be taken.
+			float minimumTimeInState;
+			/// Index of the state to enter.
+			uint32_t nextStateIndex;
+
+			/// Predicate that must be satisfied for this transition to be taken (null if none).
+			Predicate* pRequiredPredicate;
+			/// Result required from the predicate.
+			bool bRequiredPredicateResult;
+		};
+
+		void CompileStates();
 
 		DynamicArray<State> m_States;
 		FlagSetDefinitionPtr m_StateFlagSet;
 		Name m_InitialStateName;
 
 		State *m_InitialState; // Generated based on name
+
+		/// Compiled states, indexed in the same order as m_States (generated).
+		DynamicArray<CompiledState> m_CompiledStates;
+		/// Compiled transitions of all states, stored contiguously per state (generated).
+		DynamicArray<CompiledTransition> m_CompiledTransitions;
+		/// Index of the initial compiled state (generated).
+		uint32_t m_InitialStateIndex;
 	};
 	typedef Helium::StrongPtr<StateMachineDefinition> StateMachineDefinitionPtr;
 	typedef Helium::StrongPtr<const StateMachineDefinition> ConstStateMachineDefinitionPtr;
@@ -113,6 +162,63 @@ namespace Helium
 
 		DynamicArray<StateMachineInstance> m_SubStateMachines;
 	};
+
+	/// Set of state machine instances sharing a single definition, ticked together.
+	///
+	/// Instead of a separate object per instance, the current state index and time in state of each instance are
+	/// stored in parallel arrays and advanced in a single pass using the compiled transition tables of the definition.
+	/// Instances that have not been in their current state long enough for any transition to be taken only have their
+	/// timer updated, so the cost of ticking mostly idle agents is a linear walk over two arrays.
+	class HELIUM_FRAMEWORK_API StateMachineBatch
+	{
+	public:
+		/// Maximum number of transitions an instance can take in a single tick (guards against cycles of transitions
+		/// that do not consume any time).
+		static const uint32_t TRANSITION_COUNT_MAX_PER_TICK = 16;
+
+		/// @name Construction/Destruction
+		//@{
+		StateMachineBatch();
+		~StateMachineBatch();
+		//@}
+
+		/// @name Initialization
+		//@{
+		void Initialize( const StateMachineDefinition* pStateMachineDefinition );
+		void Shutdown();
+		//@}
+
+		/// @name Instance Management
+		//@{
+		uint32_t AddInstance( World &world );
+		void RemoveInstance( uint32_t instanceIndex );
+		inline uint32_t GetInstanceCount() const;
+		//@}
+
+		/// @name Updating
+		//@{
+		void Tick( World &world, float dt );
+		//@}
+
+		/// @name Instance Data Access
+		//@{
+		inline uint32_t GetCurrentStateIndex( uint32_t instanceIndex ) const;
+		inline float GetTimeInState( uint32_t instanceIndex ) const;
+		inline StateBitmask GetCurrentFlags( uint32_t instanceIndex ) const;
+		inline const StateMachineDefinition* GetDefinition() const;
+		//@}
+
+	private:
+		void AdvanceInstance( World &world, uint32_t instanceIndex, float dt );
+
+		/// State machine definition.
+		ConstStateMachineDefinitionPtr m_Definition;
+
+		/// Current state index of each instance.
+		DynamicArray<uint32_t> m_CurrentStateIndices;
+		/// Time spent in the current state by each instance.
+		DynamicArray<float> m_TimesInState;
+	};
 }
 
 #include "Framework/StateMachine.inl"
\ No newline at end of file
@@ -26,4 +26,52 @@ namespace Helium
 	{
 		return !( *this == _rhs );
 	}
+
+	/// Get the number of instances in this batch.
+	///
+	/// @return  Instance count.
+	uint32_t StateMachineBatch::GetInstanceCount() const
+	{
+		return static_cast< uint32_t >( m_CurrentStateIndices.GetSize() );
+	}
+
+	/// Get the index of the current state of an instance within the states of the definition.
+	///
+	/// @param[in] instanceIndex  Instance index.
+	///
+	/// @return  Current state index, or an invalid index if the definition has no valid initial state.
+	uint32_t StateMachineBatch::GetCurrentStateIndex( uint32_t instanceIndex ) const
+	{
+		return m_CurrentStateIndices[ instanceIndex ];
+	}
+
+	/// Get the time an instance has spent in its current state.
+	///
+	/// @param[in] instanceIndex  Instance index.
+	///
+	/// @return  Time in state, in seconds.
+	float StateMachineBatch::GetTimeInState( uint32_t instanceIndex ) const
+	{
+		return m_TimesInState[ instanceIndex ];
+	}
+
+	/// Get the flags of the current state of an instance.
+	///
+	/// @param[in] instanceIndex  Instance index.
+	///
+	/// @return  Current state flags.
+	StateBitmask StateMachineBatch::GetCurrentFlags( uint32_t instanceIndex ) const
+	{
+		uint32_t stateIndex = m_CurrentStateIndices[ instanceIndex ];
+
+		return ( IsValid( stateIndex ) ? m_Definition->m_CompiledStates[ stateIndex ].stateBitmask : 0 );
+	}
+
+	/// Get the definition shared by all instances in this batch.
+	///
+	/// @return  State machine definition.
+	const StateMachineDefinition* StateMachineBatch::GetDefinition() const
+	{
+		return m_Definition;
+	}
 }
\ No newline at end of file
@@ -285,7 +285,10 @@ void TaskScheduler::ExecuteSchedule( const TaskSchedule &schedule, DynamicArray<
 	int i = 0;
 	for (DynamicArray<TaskFunc>::ConstIterator iter = schedule.m_ScheduleFunc.Begin(); iter != schedule.m_ScheduleFunc.End(); ++iter)
 	{
-		(*iter)( rWorlds );
+		{
+			HELIUM_FRAME_PROFILE_SCOPE( schedule.m_ScheduleInfo[i]->m_Name );
+			(*iter)( rWorlds );
+		}
 		HELIUM_ASSERT(schedule.m_ScheduleInfo[i++]->m_Func == *iter);
 	}
 }
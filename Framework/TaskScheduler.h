@@ -6,6 +6,8 @@
 #include "Foundation/DynamicArray.h"
 #include "Foundation/ReferenceCounting.h"
 
+#include "Engine/FrameProfiler.h"
+
 #define HELIUM_DECLARE_TASK(__Type)                         \
 		__Type();                                           \
 		static __Type m_This; 
@@ -145,7 +147,7 @@ namespace Helium
 			: m_DependencyReverseLookup(rDependency)
 			, m_Func(pFunc)
 			, m_Next(s_FirstTaskDefinition)
-#if HELIUM_TOOLS
+#if HELIUM_TOOLS || HELIUM_FRAME_PROFILER
 			, m_Name(pName)
 #endif
 		{
@@ -164,8 +166,8 @@ namespace Helium
 		// We build this list of tasks that must execute before us in TaskScheduler::CalculateSchedule()
 		DynamicArray<const TaskDefinition *> m_RequiredTasks;
 
-#if HELIUM_TOOLS
-		// Task name useful for debug purposes
+#if HELIUM_TOOLS || HELIUM_FRAME_PROFILER
+		// Task name useful for debug purposes and profiling
 		const char *m_Name;
 #endif
 
@@ -3,6 +3,8 @@
 #include "Framework/WorldDefinition.h"
 
 #include "Platform/Timer.h"
+#include "Engine/FrameProfiler.h"
+#include "Engine/WorkerPool.h"
 #include "Framework/Slice.h"
 #include "Framework/Entity.h"
 #include "Framework/SceneDefinition.h"
@@ -12,6 +14,8 @@ using namespace Helium;
 
 WorldManager* WorldManager::sm_pInstance = NULL;
 
+const float32_t WorldManager::WORLD_TICK_TIME_SMOOTHING = 0.05f;
+
 /// Constructor.
 WorldManager::WorldManager()
 : m_actualFrameTickCount( 0 )
@@ -19,12 +23,18 @@ WorldManager::WorldManager()
 , m_frameDeltaTickCount( 0 )
 , m_frameDeltaSeconds( 0.0f )
 , m_bProcessedFirstFrame( false )
+, m_fixedFrameRate( 0.0f )
+, m_fixedFrameDeltaTickCount( 0 )
+, m_bParallelUpdate( false )
+, m_bUpdatingWorlds( false )
+, m_pUpdateSchedule( NULL )
 {
 }
 
 /// Destructor.
 WorldManager::~WorldManager()
 {
+	DisableParallelUpdate();
 }
 
 /// Initialize this manager.
@@ -74,6 +84,8 @@ bool WorldManager::Initialize()
 /// @see Initialize()
 void WorldManager::Shutdown()
 {
+	DisableParallelUpdate();
+
 	size_t worldCount = m_worlds.GetSize();
 	for( size_t worldIndex = 0; worldIndex < worldCount; ++worldIndex )
 	{
@@ -83,6 +95,7 @@ void WorldManager::Shutdown()
 	}
 
 	m_worlds.Clear();
+	m_worldTickStats.Clear();
 }
 
 /// Get the path to the package containing all world instances.
@@ -136,9 +149,16 @@ Helium::World* WorldManager::CreateWorld( SceneDefinition* pSceneDefinition )
 	}
 
 	HELIUM_ASSERT(spWorld.Get());
+	HELIUM_ASSERT( !m_bUpdatingWorlds );
 
 	m_worlds.Push( spWorld );
 
+	WorldTickStats& rTickStats = *m_worldTickStats.New();
+	rTickStats.tickCount = 0;
+	rTickStats.lastMilliseconds = 0.0f;
+	rTickStats.averageMilliseconds = 0.0f;
+	rTickStats.maximumMilliseconds = 0.0f;
+
 	if ( pSceneDefinition && spWorld )
 	{
 		Slice *pRootSlice = spWorld->GetRootSlice();
@@ -162,11 +182,14 @@ Helium::World* WorldManager::CreateWorld( SceneDefinition* pSceneDefinition )
 /// @return True if world was found and released, otherwise false.
 bool WorldManager::ReleaseWorld( World* pWorld )
 {
+	HELIUM_ASSERT( !m_bUpdatingWorlds );
+
 	for ( size_t i = 0; i < m_worlds.GetSize(); ++i )
 	{
 		if ( m_worlds.GetElement(i).Get() == pWorld )
 		{
 			m_worlds.Remove(i);
+			m_worldTickStats.Remove(i);
 			return true;
 		}
 	}
@@ -175,13 +198,44 @@ bool WorldManager::ReleaseWorld( World* pWorld )
 }
 
 /// Update all worlds for the current frame.
+///
+/// By default, each task in the schedule is run across all worlds before moving on to the next task.  When parallel
+/// updating is enabled, the full schedule is instead run for each world separately as a job on the shared WorkerPool,
+/// with the calling thread taking part.  A world is only ever updated by one thread at a time, and all worlds finish
+/// updating before component pointer maintenance and deferred entity destruction are performed on the calling thread.
+///
+/// @param[in] schedule  Task schedule to run.
+///
+/// @see EnableParallelUpdate()
 void WorldManager::Update( TaskSchedule &schedule )
 {
 	// Update the world time.
 	UpdateTime();
-	
-	Helium::TaskScheduler::ExecuteSchedule( schedule, m_worlds );
-	
+
+	m_bUpdatingWorlds = true;
+
+	if( !m_bParallelUpdate )
+	{
+		Helium::TaskScheduler::ExecuteSchedule( schedule, m_worlds );
+	}
+	else
+	{
+		WorkerPool* pWorkerPool = WorkerPool::GetStaticInstance();
+		HELIUM_ASSERT( pWorkerPool );
+
+		// Shared component state must be left alone until every world has finished updating.
+		Components::BeginParallelUpdate();
+
+		m_pUpdateSchedule = &schedule;
+		m_updateWorldArrays.Resize( m_worlds.GetSize() );
+		pWorkerPool->Run( UpdateWorldCallback, this, m_worlds.GetSize() );
+		m_pUpdateSchedule = NULL;
+
+		Components::EndParallelUpdate();
+	}
+
+	m_bUpdatingWorlds = false;
+
 	Components::Tick();
 
 	// TODO: I plan to do a "flag system" - components that are super lightweight.. like bitflags.. that carry no data
@@ -206,6 +260,100 @@ void WorldManager::Update( TaskSchedule &schedule )
 	}
 }
 
+/// Enable updating each world separately, distributing worlds across the shared WorkerPool.
+///
+/// This is intended for dedicated servers hosting many independent worlds in the same process.  Tasks in the schedule
+/// may be run for different worlds concurrently, so they must only access state belonging to the world they are
+/// given (along with thread-safe engine services).  Worlds cannot be created or released while an update is in
+/// progress, and global component state (component types and managers) is asserted to be left untouched.
+///
+/// @see DisableParallelUpdate(), GetWorldTickStats()
+void WorldManager::EnableParallelUpdate()
+{
+	HELIUM_ASSERT( !m_bUpdatingWorlds );
+
+	if( m_bParallelUpdate )
+	{
+		return;
+	}
+
+	WorkerPool::Startup();
+	m_bParallelUpdate = true;
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "WorldManager: Parallel world updates enabled with %" ) PRIuSZ TXT( " worker thread(s).\n" ),
+		GetWorkerThreadCount() );
+}
+
+/// Disable parallel world updating, releasing the reference to the shared worker pool.
+///
+/// @see EnableParallelUpdate()
+void WorldManager::DisableParallelUpdate()
+{
+	HELIUM_ASSERT( !m_bUpdatingWorlds );
+
+	if( !m_bParallelUpdate )
+	{
+		return;
+	}
+
+	m_updateWorldArrays.Clear();
+
+	m_bParallelUpdate = false;
+	WorkerPool::Shutdown();
+}
+
+/// Get the number of worker threads updating worlds alongside the thread calling Update().
+///
+/// @return  Worker count of the shared worker pool while parallel updating is enabled, zero if it is disabled.
+///
+/// @see EnableParallelUpdate()
+size_t WorldManager::GetWorkerThreadCount() const
+{
+	WorkerPool* pWorkerPool = ( m_bParallelUpdate ? WorkerPool::GetStaticInstance() : NULL );
+
+	return ( pWorkerPool ? pWorkerPool->GetWorkerCount() : 0 );
+}
+
+/// Reset the tick time statistics of all worlds.
+///
+/// @see GetWorldTickStats()
+void WorldManager::ResetWorldTickStats()
+{
+	size_t worldCount = m_worldTickStats.GetSize();
+	for( size_t worldIndex = 0; worldIndex < worldCount; ++worldIndex )
+	{
+		WorldTickStats& rTickStats = m_worldTickStats[ worldIndex ];
+		rTickStats.tickCount = 0;
+		rTickStats.lastMilliseconds = 0.0f;
+		rTickStats.averageMilliseconds = 0.0f;
+		rTickStats.maximumMilliseconds = 0.0f;
+	}
+}
+
+/// Set a fixed simulation rate for frame timing.
+///
+/// When set, each frame advances the world time by exactly one simulation step regardless of how much real time has
+/// elapsed, and the caller is expected to pace calls to Update() accordingly.
+///
+/// @param[in] framesPerSecond  Simulation rate, in frames per second, or zero to use the actual elapsed time.
+///
+/// @see GetFixedFrameRate()
+void WorldManager::SetFixedFrameRate( float32_t framesPerSecond )
+{
+	HELIUM_ASSERT( framesPerSecond >= 0.0f );
+
+	m_fixedFrameRate = Max( framesPerSecond, 0.0f );
+	m_fixedFrameDeltaTickCount = 0;
+	if( m_fixedFrameRate > 0.0f )
+	{
+		m_fixedFrameDeltaTickCount = Max< uint64_t >(
+			static_cast< uint64_t >( static_cast< float64_t >( Timer::GetTicksPerSecond() ) / m_fixedFrameRate ),
+			1 );
+	}
+}
+
 /// Get the singleton WorldManager instance, creating it if necessary.
 ///
 /// @return  Reference to the WorldManager instance.
@@ -259,7 +407,11 @@ void WorldManager::UpdateTime()
 	m_actualFrameTickCount = newFrameTickCount;
 
 	// Clamp the timer delta based on the timer limit settings.
-	if( deltaTickCount == 0 )
+	if( m_fixedFrameDeltaTickCount != 0 )
+	{
+		deltaTickCount = m_fixedFrameDeltaTickCount;
+	}
+	else if( deltaTickCount == 0 )
 	{
 		deltaTickCount = 1;
 	}
@@ -279,3 +431,45 @@ void WorldManager::UpdateTime()
 	m_frameDeltaSeconds =
 		static_cast< float32_t >( static_cast< float64_t >( deltaTickCount ) * Timer::GetSecondsPerTick() );
 }
+
+/// Run the current update schedule for a single world and record its tick time.
+///
+/// @param[in] worldIndex  Index of the world to update.
+void WorldManager::UpdateWorld( size_t worldIndex )
+{
+	HELIUM_ASSERT( m_pUpdateSchedule );
+	HELIUM_ASSERT( worldIndex < m_worlds.GetSize() );
+
+	HELIUM_FRAME_PROFILE_SCOPE( "WorldManager::UpdateWorld" );
+
+	uint64_t startTickCount = Timer::GetTickCount();
+
+	DynamicArray< WorldPtr >& rWorldArray = m_updateWorldArrays[ worldIndex ];
+	rWorldArray.Resize( 1 );
+	rWorldArray[ 0 ] = m_worlds[ worldIndex ];
+	Helium::TaskScheduler::ExecuteSchedule( *m_pUpdateSchedule, rWorldArray );
+	rWorldArray[ 0 ].Release();
+
+	float32_t milliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - startTickCount ) );
+
+	// Each world is only updated by one job per frame, so its statistics can be updated without synchronization.
+	WorldTickStats& rTickStats = m_worldTickStats[ worldIndex ];
+	rTickStats.averageMilliseconds = ( rTickStats.tickCount == 0
+		? milliseconds
+		: rTickStats.averageMilliseconds + ( milliseconds - rTickStats.averageMilliseconds ) * WORLD_TICK_TIME_SMOOTHING );
+	rTickStats.lastMilliseconds = milliseconds;
+	rTickStats.maximumMilliseconds = Max( rTickStats.maximumMilliseconds, milliseconds );
+	++rTickStats.tickCount;
+}
+
+/// WorkerPool job callback for updating a single world.
+///
+/// @param[in] pData     World manager performing the update.
+/// @param[in] jobIndex  Index of the world to update.
+void WorldManager::UpdateWorldCallback( void* pData, size_t jobIndex )
+{
+	WorldManager* pManager = static_cast< WorldManager* >( pData );
+	HELIUM_ASSERT( pManager );
+
+	pManager->UpdateWorld( jobIndex );
+}
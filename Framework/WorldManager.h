@@ -5,8 +5,6 @@
 #include "Framework/World.h"
 #include "Framework/TaskScheduler.h"
 
-#include "Platform/Thread.h"
-
 /// Non-zero to enable debug verification of methods called on EntityDefinition-based instances during world updates.
 #define HELIUM_ENABLE_WORLD_UPDATE_SAFETY_CHECKING ( !HELIUM_RELEASE )
 
@@ -18,6 +16,22 @@ namespace Helium
     class HELIUM_FRAMEWORK_API WorldManager : NonCopyable
     {
     public:
+        /// Smoothing factor applied to the average world tick time each time a world is updated.
+        static const float32_t WORLD_TICK_TIME_SMOOTHING;
+
+        /// World tick time statistics.
+        struct WorldTickStats
+        {
+            /// Number of times the world has been updated.
+            uint64_t tickCount;
+            /// Time taken by the most recent update, in milliseconds.
+            float32_t lastMilliseconds;
+            /// Smoothed average update time, in milliseconds.
+            float32_t averageMilliseconds;
+            /// Longest update time, in milliseconds.
+            float32_t maximumMilliseconds;
+        };
+
         /// @name Initialization
         //@{
         bool Initialize();
@@ -36,6 +50,19 @@ namespace Helium
         /// @name Updating
         //@{
         void Update( TaskSchedule &schedule );
+
+        void EnableParallelUpdate();
+        void DisableParallelUpdate();
+        inline bool IsParallelUpdateEnabled() const;
+        size_t GetWorkerThreadCount() const;
+        //@}
+
+        /// @name World Statistics
+        //@{
+        inline size_t GetWorldCount() const;
+        inline World* GetWorld( size_t worldIndex ) const;
+        inline const WorldTickStats& GetWorldTickStats( size_t worldIndex ) const;
+        void ResetWorldTickStats();
         //@}
 
         /// @name Timing
@@ -43,6 +70,9 @@ namespace Helium
         inline uint64_t GetFrameTickCount() const;
         inline uint64_t GetFrameDeltaTickCount() const;
         inline float32_t GetFrameDeltaSeconds() const;
+
+        void SetFixedFrameRate( float32_t framesPerSecond );
+        inline float32_t GetFixedFrameRate() const;
         //@}
 
         /// @name Static Access
@@ -69,6 +99,25 @@ namespace Helium
         /// True if the first frame has been processed.
         bool m_bProcessedFirstFrame;
 
+        /// Fixed simulation rate, in frames per second (zero to use the actual elapsed time).
+        float32_t m_fixedFrameRate;
+        /// Tick count for each frame when running at a fixed simulation rate.
+        uint64_t m_fixedFrameDeltaTickCount;
+
+        /// Tick time statistics for each world (parallel to m_worlds).
+        DynamicArray< WorldTickStats > m_worldTickStats;
+
+        /// True if each world is updated separately, with worlds distributed across the shared worker pool.
+        bool m_bParallelUpdate;
+        /// True while worlds are being updated (worlds cannot be created or released during this time).
+        bool m_bUpdatingWorlds;
+
+        /// Schedule being executed by the current parallel update.
+        TaskSchedule* m_pUpdateSchedule;
+        /// Single-world arrays used to pass each world to the task schedule during a parallel update (parallel to
+        /// m_worlds, kept between updates so that they are not reallocated every frame).
+        DynamicArray< DynamicArray< WorldPtr > > m_updateWorldArrays;
+
         /// Singleton instance.
         static WorldManager* sm_pInstance;
 
@@ -82,6 +131,13 @@ namespace Helium
         //@{
         void UpdateTime();
         //@}
+
+        /// @name Parallel Updating
+        //@{
+        void UpdateWorld( size_t worldIndex );
+
+        static void UpdateWorldCallback( void* pData, size_t jobIndex );
+        //@}
     };
 }
 
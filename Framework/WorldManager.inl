@@ -35,4 +35,64 @@ namespace Helium
     {
         return m_frameDeltaSeconds;
     }
+
+    /// Get the fixed simulation rate used for frame timing.
+    ///
+    /// @return  Fixed simulation rate, in frames per second, or zero if the actual elapsed time is used.
+    ///
+    /// @see SetFixedFrameRate()
+    float32_t WorldManager::GetFixedFrameRate() const
+    {
+        return m_fixedFrameRate;
+    }
+
+    /// Get whether each world is updated separately on the shared worker pool.
+    ///
+    /// @return  True if parallel updating is enabled, false if not.
+    ///
+    /// @see EnableParallelUpdate(), DisableParallelUpdate()
+    bool WorldManager::IsParallelUpdateEnabled() const
+    {
+        return m_bParallelUpdate;
+    }
+
+    /// Get the number of managed worlds.
+    ///
+    /// @return  World count.
+    ///
+    /// @see GetWorld(), GetWorldTickStats()
+    size_t WorldManager::GetWorldCount() const
+    {
+        return m_worlds.GetSize();
+    }
+
+    /// Get the world with the given index.
+    ///
+    /// @param[in] worldIndex  World index.
+    ///
+    /// @return  World instance.
+    ///
+    /// @see GetWorldCount()
+    World* WorldManager::GetWorld( size_t worldIndex ) const
+    {
+        HELIUM_ASSERT( worldIndex < m_worlds.GetSize() );
+
+        return m_worlds[ worldIndex ];
+    }
+
+    /// Get the tick time statistics for the world with the given index.
+    ///
+    /// Statistics are only gathered while parallel updating is enabled, as worlds are otherwise updated together.
+    ///
+    /// @param[in] worldIndex  World index.
+    ///
+    /// @return  World tick time statistics.
+    ///
+    /// @see GetWorldCount(), ResetWorldTickStats()
+    const WorldManager::WorldTickStats& WorldManager::GetWorldTickStats( size_t worldIndex ) const
+    {
+        HELIUM_ASSERT( worldIndex < m_worldTickStats.GetSize() );
+
+        return m_worldTickStats[ worldIndex ];
+    }
 }
\ No newline at end of file
@@ -12,6 +12,7 @@
 
 #include "Graphics/RenderResourceManager.h"
 #include "Graphics/DynamicDrawer.h"
+#include "Graphics/AnimationEvaluator.h"
 
 using namespace Helium;
 
@@ -134,6 +135,9 @@ void RendererInitializationImpl::OnMainWindowDestroyed( Window* pWindow )
 
 void Helium::RendererInitializationImpl::Shutdown()
 {
+#if !HELIUM_USE_GRANNY_ANIMATION
+	AnimationEvaluator::DestroyStaticInstance();
+#endif
 	DynamicDrawer::DestroyStaticInstance();
 	RenderResourceManager::DestroyStaticInstance();
 
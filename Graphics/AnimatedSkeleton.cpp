@@ -0,0 +1,420 @@
+#include "GraphicsPch.h"
+#include "Graphics/AnimatedSkeleton.h"
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+
+#include <math.h>
+
+using namespace Helium;
+
+/// Constructor.
+AnimatedSkeleton::AnimatedSkeleton()
+: m_pParentBoneIndices( NULL )
+, m_pBoneNames( NULL )
+, m_pReferencePose( NULL )
+, m_boneCount( 0 )
+{
+    for( size_t layerIndex = 0; layerIndex < LAYER_COUNT_MAX; ++layerIndex )
+    {
+        Layer& rLayer = m_layers[ layerIndex ];
+        rLayer.pClip = NULL;
+        rLayer.time = 0.0f;
+        rLayer.playbackRate = 1.0f;
+        rLayer.weight = 1.0f;
+        rLayer.bLoop = true;
+    }
+}
+
+/// Destructor.
+AnimatedSkeleton::~AnimatedSkeleton()
+{
+}
+
+/// Set up this skeleton for a given bone hierarchy.
+///
+/// Bones must be ordered so that each bone follows its parent.  Any animation layers that are already active are
+/// rebound to the new hierarchy.
+///
+/// @param[in] boneCount           Number of bones.
+/// @param[in] pBoneNames          Name of each bone (used to match bones with animation tracks).
+/// @param[in] pParentBoneIndices  Parent index of each bone (invalid index for root bones).
+/// @param[in] pReferencePose      Parent-relative reference pose transform of each bone.
+///
+/// @see Shutdown()
+void AnimatedSkeleton::Initialize(
+    uint8_t boneCount,
+    const Name* pBoneNames,
+    const uint8_t* pParentBoneIndices,
+    const Simd::Matrix44* pReferencePose )
+{
+    HELIUM_ASSERT( boneCount == 0 || ( pBoneNames && pParentBoneIndices && pReferencePose ) );
+
+    m_pBoneNames = pBoneNames;
+    m_pParentBoneIndices = pParentBoneIndices;
+    m_pReferencePose = pReferencePose;
+    m_boneCount = boneCount;
+
+    m_blendedKeys.Resize( 0 );
+    m_blendedKeys.Reserve( static_cast< size_t >( boneCount ) * Animation::KEY_VALUE_COUNT );
+    m_blendedKeys.Add( 0.0f, static_cast< size_t >( boneCount ) * Animation::KEY_VALUE_COUNT );
+    m_blendWeights.Resize( 0 );
+    m_blendWeights.Reserve( boneCount );
+    m_blendWeights.Add( 0.0f, boneCount );
+
+    // Start out in the reference pose, which also gives us the mesh-space reference transforms to invert.
+    m_bonePalette.Resize( boneCount );
+    m_inverseReferencePose.Resize( boneCount );
+    for( size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+    {
+        uint8_t parentBoneIndex = pParentBoneIndices[ boneIndex ];
+        HELIUM_ASSERT( IsInvalid( parentBoneIndex ) || parentBoneIndex < boneIndex );
+        if( IsValid( parentBoneIndex ) && parentBoneIndex < boneIndex )
+        {
+            m_bonePalette[ boneIndex ].MultiplySet( pReferencePose[ boneIndex ], m_bonePalette[ parentBoneIndex ] );
+        }
+        else
+        {
+            m_bonePalette[ boneIndex ] = pReferencePose[ boneIndex ];
+        }
+
+        m_bonePalette[ boneIndex ].GetInverse( m_inverseReferencePose[ boneIndex ] );
+    }
+
+    for( size_t layerIndex = 0; layerIndex < LAYER_COUNT_MAX; ++layerIndex )
+    {
+        BindLayerTracks( m_layers[ layerIndex ] );
+    }
+}
+
+/// Release all skeleton data and deactivate all animation layers.
+///
+/// @see Initialize()
+void AnimatedSkeleton::Shutdown()
+{
+    for( size_t layerIndex = 0; layerIndex < LAYER_COUNT_MAX; ++layerIndex )
+    {
+        Layer& rLayer = m_layers[ layerIndex ];
+        rLayer.pClip = NULL;
+        rLayer.boneTracks.Clear();
+    }
+
+    m_pBoneNames = NULL;
+    m_pParentBoneIndices = NULL;
+    m_pReferencePose = NULL;
+    m_boneCount = 0;
+
+    m_blendedKeys.Clear();
+    m_blendWeights.Clear();
+    m_bonePalette.Clear();
+    m_inverseReferencePose.Clear();
+}
+
+/// Set the clip played on an animation layer, restarting playback from the beginning of the clip.
+///
+/// @param[in] layerIndex  Layer index.
+/// @param[in] pClip       Clip data to play, or null to deactivate the layer.
+/// @param[in] bLoop       True to wrap playback around at the end of the clip, false to hold the last sample.
+///
+/// @see GetLayerClip()
+void AnimatedSkeleton::SetLayerClip( size_t layerIndex, const Animation::PersistentResourceData* pClip, bool bLoop )
+{
+    HELIUM_ASSERT( layerIndex < LAYER_COUNT_MAX );
+
+    Layer& rLayer = m_layers[ layerIndex ];
+    rLayer.pClip = pClip;
+    rLayer.time = 0.0f;
+    rLayer.bLoop = bLoop;
+
+    BindLayerTracks( rLayer );
+}
+
+/// Set the current playback time of an animation layer.
+///
+/// @param[in] layerIndex  Layer index.
+/// @param[in] time        Playback time, in seconds.
+///
+/// @see GetLayerTime(), AdvanceTime()
+void AnimatedSkeleton::SetLayerTime( size_t layerIndex, float32_t time )
+{
+    HELIUM_ASSERT( layerIndex < LAYER_COUNT_MAX );
+
+    m_layers[ layerIndex ].time = time;
+}
+
+/// Set the playback rate of an animation layer.
+///
+/// @param[in] layerIndex    Layer index.
+/// @param[in] playbackRate  Playback rate (1 for normal speed, negative values to play in reverse).
+///
+/// @see GetLayerPlaybackRate()
+void AnimatedSkeleton::SetLayerPlaybackRate( size_t layerIndex, float32_t playbackRate )
+{
+    HELIUM_ASSERT( layerIndex < LAYER_COUNT_MAX );
+
+    m_layers[ layerIndex ].playbackRate = playbackRate;
+}
+
+/// Set the blend weight of an animation layer.
+///
+/// Weights are relative to the other layers driving the same bone, so they do not need to add up to one.
+///
+/// @param[in] layerIndex  Layer index.
+/// @param[in] weight      Blend weight.
+///
+/// @see GetLayerWeight()
+void AnimatedSkeleton::SetLayerWeight( size_t layerIndex, float32_t weight )
+{
+    HELIUM_ASSERT( layerIndex < LAYER_COUNT_MAX );
+
+    m_layers[ layerIndex ].weight = Max( weight, 0.0f );
+}
+
+/// Advance the playback time of every active animation layer.
+///
+/// @param[in] deltaSeconds  Elapsed time, in seconds.
+void AnimatedSkeleton::AdvanceTime( float32_t deltaSeconds )
+{
+    for( size_t layerIndex = 0; layerIndex < LAYER_COUNT_MAX; ++layerIndex )
+    {
+        Layer& rLayer = m_layers[ layerIndex ];
+        if( !rLayer.pClip )
+        {
+            continue;
+        }
+
+        float32_t duration = rLayer.pClip->GetDuration();
+        float32_t time = rLayer.time + deltaSeconds * rLayer.playbackRate;
+        if( duration <= 0.0f )
+        {
+            time = 0.0f;
+        }
+        else if( rLayer.bLoop )
+        {
+            time = fmodf( time, duration );
+            if( time < 0.0f )
+            {
+                time += duration;
+            }
+        }
+        else
+        {
+            time = Clamp( time, 0.0f, duration );
+        }
+
+        rLayer.time = time;
+    }
+}
+
+/// Sample and blend all active animation layers and update the bone palette.
+///
+/// @see GetBonePalette()
+void AnimatedSkeleton::Evaluate()
+{
+    size_t boneCount = m_boneCount;
+    if( boneCount == 0 )
+    {
+        return;
+    }
+
+    MemoryZero( m_blendedKeys.GetData(), m_blendedKeys.GetSize() * sizeof( float32_t ) );
+    MemoryZero( m_blendWeights.GetData(), m_blendWeights.GetSize() * sizeof( float32_t ) );
+
+    for( size_t layerIndex = 0; layerIndex < LAYER_COUNT_MAX; ++layerIndex )
+    {
+        const Layer& rLayer = m_layers[ layerIndex ];
+        if( rLayer.pClip && rLayer.pClip->m_sampleCount != 0 && rLayer.weight > 0.0f )
+        {
+            BlendLayer( rLayer );
+        }
+    }
+
+    // Build the parent-relative transform of each bone from its blended key and concatenate it with its parent's
+    // transform.  Bones follow their parents, so parent transforms are always up-to-date by the time they are used.
+    const float32_t* pBlendedKey = m_blendedKeys.GetData();
+    Simd::Matrix44 localTransform;
+    for( size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex, pBlendedKey += Animation::KEY_VALUE_COUNT )
+    {
+        const Simd::Matrix44* pLocalTransform = &m_pReferencePose[ boneIndex ];
+
+        float32_t weight = m_blendWeights[ boneIndex ];
+        if( weight > 0.0f )
+        {
+            float32_t inverseWeight = 1.0f / weight;
+            const float32_t* pTranslation = pBlendedKey + Animation::KEY_TRANSLATION_OFFSET;
+            const float32_t* pRotation = pBlendedKey + Animation::KEY_ROTATION_OFFSET;
+            const float32_t* pScale = pBlendedKey + Animation::KEY_SCALE_OFFSET;
+
+            // Rotations were accumulated in the same hemisphere, so normalizing the sum gives the blended rotation.
+            float32_t x = pRotation[ 0 ];
+            float32_t y = pRotation[ 1 ];
+            float32_t z = pRotation[ 2 ];
+            float32_t w = pRotation[ 3 ];
+            float32_t lengthSquared = x * x + y * y + z * z + w * w;
+            if( lengthSquared > 1.0e-12f )
+            {
+                float32_t inverseLength = 1.0f / sqrtf( lengthSquared );
+                x *= inverseLength;
+                y *= inverseLength;
+                z *= inverseLength;
+                w *= inverseLength;
+            }
+            else
+            {
+                x = 0.0f;
+                y = 0.0f;
+                z = 0.0f;
+                w = 1.0f;
+            }
+
+            float32_t scaleX = pScale[ 0 ] * inverseWeight;
+            float32_t scaleY = pScale[ 1 ] * inverseWeight;
+            float32_t scaleZ = pScale[ 2 ] * inverseWeight;
+
+            // Each row holds a scaled basis vector, with the translation in the last row (transforms apply to row
+            // vectors, matching the skinning palette layout).
+            localTransform.SetElement( 0, ( 1.0f - 2.0f * ( y * y + z * z ) ) * scaleX );
+            localTransform.SetElement( 1, ( 2.0f * ( x * y + z * w ) ) * scaleX );
+            localTransform.SetElement( 2, ( 2.0f * ( x * z - y * w ) ) * scaleX );
+            localTransform.SetElement( 3, 0.0f );
+            localTransform.SetElement( 4, ( 2.0f * ( x * y - z * w ) ) * scaleY );
+            localTransform.SetElement( 5, ( 1.0f - 2.0f * ( x * x + z * z ) ) * scaleY );
+            localTransform.SetElement( 6, ( 2.0f * ( y * z + x * w ) ) * scaleY );
+            localTransform.SetElement( 7, 0.0f );
+            localTransform.SetElement( 8, ( 2.0f * ( x * z + y * w ) ) * scaleZ );
+            localTransform.SetElement( 9, ( 2.0f * ( y * z - x * w ) ) * scaleZ );
+            localTransform.SetElement( 10, ( 1.0f - 2.0f * ( x * x + y * y ) ) * scaleZ );
+            localTransform.SetElement( 11, 0.0f );
+            localTransform.SetElement( 12, pTranslation[ 0 ] * inverseWeight );
+            localTransform.SetElement( 13, pTranslation[ 1 ] * inverseWeight );
+            localTransform.SetElement( 14, pTranslation[ 2 ] * inverseWeight );
+            localTransform.SetElement( 15, 1.0f );
+
+            pLocalTransform = &localTransform;
+        }
+
+        uint8_t parentBoneIndex = m_pParentBoneIndices[ boneIndex ];
+        if( IsValid( parentBoneIndex ) && parentBoneIndex < boneIndex )
+        {
+            m_bonePalette[ boneIndex ].MultiplySet( *pLocalTransform, m_bonePalette[ parentBoneIndex ] );
+        }
+        else
+        {
+            m_bonePalette[ boneIndex ] = *pLocalTransform;
+        }
+    }
+}
+
+/// Map each bone of the skeleton to the track that drives it in the clip played on a given layer.
+///
+/// @param[in] rLayer  Layer to update.
+void AnimatedSkeleton::BindLayerTracks( Layer& rLayer )
+{
+    rLayer.boneTracks.Resize( 0 );
+
+    const Animation::PersistentResourceData* pClip = rLayer.pClip;
+    if( !pClip || m_boneCount == 0 )
+    {
+        return;
+    }
+
+    size_t boneCount = m_boneCount;
+    size_t trackCount = Min< size_t >( pClip->GetTrackCount(), Invalid< uint8_t >() );
+    const Name* pTrackNames = pClip->m_trackNames.GetData();
+
+    rLayer.boneTracks.Reserve( boneCount );
+    rLayer.boneTracks.Add( Invalid< uint8_t >(), boneCount );
+
+    for( size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex )
+    {
+        Name boneName = m_pBoneNames[ boneIndex ];
+        for( size_t trackIndex = 0; trackIndex < trackCount; ++trackIndex )
+        {
+            if( pTrackNames[ trackIndex ] == boneName )
+            {
+                rLayer.boneTracks[ boneIndex ] = static_cast< uint8_t >( trackIndex );
+                break;
+            }
+        }
+    }
+}
+
+/// Sample the clip played on a given layer and add its weighted contribution to the blended bone keys.
+///
+/// @param[in] rLayer  Layer to blend.
+void AnimatedSkeleton::BlendLayer( const Layer& rLayer )
+{
+    const Animation::PersistentResourceData* pClip = rLayer.pClip;
+    HELIUM_ASSERT( pClip );
+    HELIUM_ASSERT( rLayer.boneTracks.GetSize() == m_boneCount );
+
+    // Find the pair of samples surrounding the current time.
+    size_t lastSampleIndex = pClip->m_sampleCount - 1;
+    float32_t sampleTime = Max( rLayer.time * pClip->m_samplesPerSecond, 0.0f );
+    size_t sampleIndex0 = Min( static_cast< size_t >( sampleTime ), lastSampleIndex );
+    size_t sampleIndex1 = Min( sampleIndex0 + 1, lastSampleIndex );
+    float32_t alpha = Clamp( sampleTime - static_cast< float32_t >( sampleIndex0 ), 0.0f, 1.0f );
+
+    const float32_t* pSampleKeys0 = pClip->GetSampleKeys( sampleIndex0 );
+    const float32_t* pSampleKeys1 = pClip->GetSampleKeys( sampleIndex1 );
+
+    float32_t weight = rLayer.weight;
+    float32_t weight0 = weight * ( 1.0f - alpha );
+    float32_t weight1 = weight * alpha;
+
+    const uint8_t* pBoneTracks = rLayer.boneTracks.GetData();
+    float32_t* pBlendedKey = m_blendedKeys.GetData();
+    float32_t* pBlendWeights = m_blendWeights.GetData();
+
+    size_t boneCount = m_boneCount;
+    for( size_t boneIndex = 0; boneIndex < boneCount; ++boneIndex, pBlendedKey += Animation::KEY_VALUE_COUNT )
+    {
+        uint8_t trackIndex = pBoneTracks[ boneIndex ];
+        if( IsInvalid( trackIndex ) )
+        {
+            continue;
+        }
+
+        const float32_t* pKey0 = pSampleKeys0 + static_cast< size_t >( trackIndex ) * Animation::KEY_VALUE_COUNT;
+        const float32_t* pKey1 = pSampleKeys1 + static_cast< size_t >( trackIndex ) * Animation::KEY_VALUE_COUNT;
+
+        // Translation and scale are blended linearly.
+        for( size_t valueIndex = 0; valueIndex < 3; ++valueIndex )
+        {
+            size_t translationIndex = Animation::KEY_TRANSLATION_OFFSET + valueIndex;
+            pBlendedKey[ translationIndex ] += pKey0[ translationIndex ] * weight0 + pKey1[ translationIndex ] * weight1;
+
+            size_t scaleIndex = Animation::KEY_SCALE_OFFSET + valueIndex;
+            pBlendedKey[ scaleIndex ] += pKey0[ scaleIndex ] * weight0 + pKey1[ scaleIndex ] * weight1;
+        }
+
+        // Rotations are blended as a weighted sum that is normalized once all layers have been added, flipping each
+        // quaternion into the same hemisphere as the running sum so that blends take the shortest path.
+        const float32_t* pRotation0 = pKey0 + Animation::KEY_ROTATION_OFFSET;
+        const float32_t* pRotation1 = pKey1 + Animation::KEY_ROTATION_OFFSET;
+        float32_t* pBlendedRotation = pBlendedKey + Animation::KEY_ROTATION_OFFSET;
+
+        float32_t dot01 =
+            pRotation0[ 0 ] * pRotation1[ 0 ] + pRotation0[ 1 ] * pRotation1[ 1 ] +
+            pRotation0[ 2 ] * pRotation1[ 2 ] + pRotation0[ 3 ] * pRotation1[ 3 ];
+        float32_t sampleWeight1 = ( dot01 < 0.0f ? -weight1 : weight1 );
+
+        float32_t rotation[ 4 ];
+        for( size_t valueIndex = 0; valueIndex < 4; ++valueIndex )
+        {
+            rotation[ valueIndex ] = pRotation0[ valueIndex ] * weight0 + pRotation1[ valueIndex ] * sampleWeight1;
+        }
+
+        float32_t dotBlended =
+            rotation[ 0 ] * pBlendedRotation[ 0 ] + rotation[ 1 ] * pBlendedRotation[ 1 ] +
+            rotation[ 2 ] * pBlendedRotation[ 2 ] + rotation[ 3 ] * pBlendedRotation[ 3 ];
+        float32_t sign = ( dotBlended < 0.0f ? -1.0f : 1.0f );
+        for( size_t valueIndex = 0; valueIndex < 4; ++valueIndex )
+        {
+            pBlendedRotation[ valueIndex ] += rotation[ valueIndex ] * sign;
+        }
+
+        pBlendWeights[ boneIndex ] += weight;
+    }
+}
+
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
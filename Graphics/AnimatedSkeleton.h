@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+#include "Graphics/Animation.h"
+
+#include "MathSimd/Matrix44.h"
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+
+namespace Helium
+{
+    /// Skeleton instance posed by blending the built-in animation clips.
+    ///
+    /// Each skeleton has a fixed number of layers, each of which plays a single clip with its own time, playback rate,
+    /// and blend weight.  Evaluate() samples every active layer, blends the resulting parent-relative bone transforms
+    /// (bones not driven by any layer keep their reference pose), and produces the mesh-space bone palette consumed by
+    /// GraphicsSceneObject::SetBonePalette().
+    ///
+    /// Evaluating a skeleton only writes to state owned by that skeleton, so different skeletons can be evaluated
+    /// concurrently (see AnimationEvaluator).  Clip data and skeleton hierarchy data are referenced, not copied, and
+    /// must remain valid for as long as they are in use.
+    class HELIUM_GRAPHICS_API AnimatedSkeleton : NonCopyable
+    {
+    public:
+        /// Maximum number of blended animation layers.
+        static const size_t LAYER_COUNT_MAX = 4;
+
+        /// @name Construction/Destruction
+        //@{
+        AnimatedSkeleton();
+        ~AnimatedSkeleton();
+        //@}
+
+        /// @name Skeleton Setup
+        //@{
+        void Initialize(
+            uint8_t boneCount, const Name* pBoneNames, const uint8_t* pParentBoneIndices,
+            const Simd::Matrix44* pReferencePose );
+        void Shutdown();
+
+        inline uint8_t GetBoneCount() const;
+        //@}
+
+        /// @name Animation Layers
+        //@{
+        void SetLayerClip( size_t layerIndex, const Animation::PersistentResourceData* pClip, bool bLoop = true );
+        void SetLayerTime( size_t layerIndex, float32_t time );
+        void SetLayerPlaybackRate( size_t layerIndex, float32_t playbackRate );
+        void SetLayerWeight( size_t layerIndex, float32_t weight );
+
+        inline const Animation::PersistentResourceData* GetLayerClip( size_t layerIndex ) const;
+        inline float32_t GetLayerTime( size_t layerIndex ) const;
+        inline float32_t GetLayerPlaybackRate( size_t layerIndex ) const;
+        inline float32_t GetLayerWeight( size_t layerIndex ) const;
+
+        void AdvanceTime( float32_t deltaSeconds );
+        //@}
+
+        /// @name Evaluation
+        //@{
+        void Evaluate();
+
+        inline const Simd::Matrix44* GetBonePalette() const;
+        inline const Simd::Matrix44* GetInverseReferencePose() const;
+        //@}
+
+    private:
+        /// Animation layer state.
+        struct Layer
+        {
+            /// Clip played on this layer (null if the layer is inactive).
+            const Animation::PersistentResourceData* pClip;
+            /// Track index in the clip for each bone (invalid if the clip does not drive the bone).
+            DynamicArray< uint8_t > boneTracks;
+            /// Current playback time, in seconds.
+            float32_t time;
+            /// Playback rate (1 for normal speed).
+            float32_t playbackRate;
+            /// Blend weight.
+            float32_t weight;
+            /// True if playback wraps around at the end of the clip, false if it stops at the last sample.
+            bool bLoop;
+        };
+
+        /// Bone hierarchy (parent index of each bone).
+        const uint8_t* m_pParentBoneIndices;
+        /// Bone names.
+        const Name* m_pBoneNames;
+        /// Parent-relative reference pose transforms.
+        const Simd::Matrix44* m_pReferencePose;
+        /// Bone count.
+        uint8_t m_boneCount;
+
+        /// Animation layers.
+        Layer m_layers[ LAYER_COUNT_MAX ];
+
+        /// Blended key values for each bone (Animation::KEY_VALUE_COUNT values per bone).
+        DynamicArray< float32_t > m_blendedKeys;
+        /// Total blend weight applied to each bone.
+        DynamicArray< float32_t > m_blendWeights;
+
+        /// Mesh-space transform of each bone in its current pose.
+        DynamicArray< Simd::Matrix44 > m_bonePalette;
+        /// Inverse mesh-space transform of each bone in its reference pose.
+        DynamicArray< Simd::Matrix44 > m_inverseReferencePose;
+
+        /// @name Private Utility Functions
+        //@{
+        void BindLayerTracks( Layer& rLayer );
+        void BlendLayer( const Layer& rLayer );
+        //@}
+    };
+}
+
+#include "Graphics/AnimatedSkeleton.inl"
+
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
@@ -0,0 +1,86 @@
+namespace Helium
+{
+    /// Get the number of bones in this skeleton.
+    ///
+    /// @return  Bone count.
+    uint8_t AnimatedSkeleton::GetBoneCount() const
+    {
+        return m_boneCount;
+    }
+
+    /// Get the clip played on an animation layer.
+    ///
+    /// @param[in] layerIndex  Layer index.
+    ///
+    /// @return  Clip data, or null if the layer is inactive.
+    ///
+    /// @see SetLayerClip()
+    const Animation::PersistentResourceData* AnimatedSkeleton::GetLayerClip( size_t layerIndex ) const
+    {
+        HELIUM_ASSERT( layerIndex < LAYER_COUNT_MAX );
+
+        return m_layers[ layerIndex ].pClip;
+    }
+
+    /// Get the current playback time of an animation layer.
+    ///
+    /// @param[in] layerIndex  Layer index.
+    ///
+    /// @return  Playback time, in seconds.
+    ///
+    /// @see SetLayerTime(), AdvanceTime()
+    float32_t AnimatedSkeleton::GetLayerTime( size_t layerIndex ) const
+    {
+        HELIUM_ASSERT( layerIndex < LAYER_COUNT_MAX );
+
+        return m_layers[ layerIndex ].time;
+    }
+
+    /// Get the playback rate of an animation layer.
+    ///
+    /// @param[in] layerIndex  Layer index.
+    ///
+    /// @return  Playback rate.
+    ///
+    /// @see SetLayerPlaybackRate()
+    float32_t AnimatedSkeleton::GetLayerPlaybackRate( size_t layerIndex ) const
+    {
+        HELIUM_ASSERT( layerIndex < LAYER_COUNT_MAX );
+
+        return m_layers[ layerIndex ].playbackRate;
+    }
+
+    /// Get the blend weight of an animation layer.
+    ///
+    /// @param[in] layerIndex  Layer index.
+    ///
+    /// @return  Blend weight.
+    ///
+    /// @see SetLayerWeight()
+    float32_t AnimatedSkeleton::GetLayerWeight( size_t layerIndex ) const
+    {
+        HELIUM_ASSERT( layerIndex < LAYER_COUNT_MAX );
+
+        return m_layers[ layerIndex ].weight;
+    }
+
+    /// Get the bone palette produced by the most recent call to Evaluate().
+    ///
+    /// @return  Mesh-space transform of each bone, or null if the skeleton has no bones.
+    ///
+    /// @see Evaluate(), GetInverseReferencePose()
+    const Simd::Matrix44* AnimatedSkeleton::GetBonePalette() const
+    {
+        return ( m_bonePalette.IsEmpty() ? NULL : m_bonePalette.GetData() );
+    }
+
+    /// Get the inverse mesh-space reference pose transform of each bone.
+    ///
+    /// @return  Inverse reference pose transforms, or null if the skeleton has no bones.
+    ///
+    /// @see GetBonePalette()
+    const Simd::Matrix44* AnimatedSkeleton::GetInverseReferencePose() const
+    {
+        return ( m_inverseReferencePose.IsEmpty() ? NULL : m_inverseReferencePose.GetData() );
+    }
+}
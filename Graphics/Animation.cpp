@@ -1,12 +1,17 @@
 #include "GraphicsPch.h"
 #include "Graphics/Animation.h"
 
+#include "Reflect/TranslatorDeduction.h"
+
 #if HELIUM_USE_GRANNY_ANIMATION
 #include "GrannyAnimationInterface.h"
 #include "GrannyAnimationInterface.cpp.inl"
 #endif
 
 HELIUM_IMPLEMENT_ASSET( Helium::Animation, Graphics, AssetType::FLAG_NO_TEMPLATE );
+#if !HELIUM_USE_GRANNY_ANIMATION
+HELIUM_DEFINE_CLASS( Helium::Animation::PersistentResourceData );
+#endif
 
 using namespace Helium;
 
@@ -20,6 +25,57 @@ Animation::~Animation()
 {
 }
 
+#if !HELIUM_USE_GRANNY_ANIMATION
+Animation::PersistentResourceData::PersistentResourceData()
+: m_sampleCount( 0 )
+, m_samplesPerSecond( 0.0f )
+{
+}
+
+void Animation::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+    comp.AddField( &PersistentResourceData::m_sampleCount,      TXT( "m_sampleCount" ) );
+    comp.AddField( &PersistentResourceData::m_samplesPerSecond, TXT( "m_samplesPerSecond" ) );
+    comp.AddField( &PersistentResourceData::m_trackNames,       TXT( "m_trackNames" ) );
+    comp.AddField( &PersistentResourceData::m_keys,             TXT( "m_keys" ) );
+}
+#endif
+
+/// @copydoc Resource::LoadPersistentResourceObject()
+bool Animation::LoadPersistentResourceObject( Reflect::ObjectPtr& _object )
+{
+#if HELIUM_USE_GRANNY_ANIMATION
+    HELIUM_UNREF( _object );
+
+    return false;
+#else
+    HELIUM_ASSERT( _object.ReferencesObject() );
+    if( !_object.ReferencesObject() )
+    {
+        return false;
+    }
+
+    _object->CopyTo( &m_persistentResourceData );
+
+    size_t expectedKeyCount =
+        static_cast< size_t >( m_persistentResourceData.m_sampleCount ) * m_persistentResourceData.GetTrackCount() *
+        KEY_VALUE_COUNT;
+    if( m_persistentResourceData.m_keys.GetSize() != expectedKeyCount )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            TXT( "Animation::LoadPersistentResourceObject(): Key data for animation \"%s\" is inconsistent and will be ignored.\n" ),
+            *GetPath().ToString() );
+
+        m_persistentResourceData.m_sampleCount = 0;
+        m_persistentResourceData.m_trackNames.Clear();
+        m_persistentResourceData.m_keys.Clear();
+    }
+
+    return true;
+#endif
+}
+
 /// @copydoc Resource::GetCacheName()
 Name Animation::GetCacheName() const
 {
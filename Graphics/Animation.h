@@ -17,12 +17,57 @@ namespace Helium
         HELIUM_DECLARE_ASSET( Animation, Resource );
 
     public:
+#if !HELIUM_USE_GRANNY_ANIMATION
+        /// Number of values stored for each key (translation, rotation quaternion, and scale).
+        static const size_t KEY_VALUE_COUNT = 10;
+        /// Offset of the translation within each key.
+        static const size_t KEY_TRANSLATION_OFFSET = 0;
+        /// Offset of the rotation quaternion (x, y, z, w) within each key.
+        static const size_t KEY_ROTATION_OFFSET = 3;
+        /// Offset of the scale within each key.
+        static const size_t KEY_SCALE_OFFSET = 7;
+
+        /// Built-in animation clip data.
+        ///
+        /// Each track drives the parent-relative transform of the skeleton bone with the same name.  Tracks are sampled
+        /// at a fixed rate, and keys are stored by sample and then by track so that evaluating a skeleton at a given
+        /// time only touches two contiguous runs of key data.
+        struct HELIUM_GRAPHICS_API PersistentResourceData : public Object
+        {
+            HELIUM_DECLARE_CLASS( Animation::PersistentResourceData, Reflect::Object );
+
+            PersistentResourceData();
+            static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+            /// Number of samples stored for each track.
+            uint32_t m_sampleCount;
+            /// Sampling rate, in samples per second.
+            float32_t m_samplesPerSecond;
+            /// Name of the bone driven by each track.
+            DynamicArray< Name > m_trackNames;
+            /// Key data (KEY_VALUE_COUNT values for each track, for each sample).
+            DynamicArray< float32_t > m_keys;
+
+            /// @name Data Access
+            //@{
+            inline size_t GetTrackCount() const;
+            inline float32_t GetDuration() const;
+            inline const float32_t* GetSampleKeys( size_t sampleIndex ) const;
+            //@}
+        };
+#endif
+
         /// @name Construction/Destruction
         //@{
         Animation();
         virtual ~Animation();
         //@}
 
+        /// @name Resource Serialization
+        //@{
+        virtual bool LoadPersistentResourceObject( Reflect::ObjectPtr& _object );
+        //@}
+
         /// @name Resource Caching Support
         //@{
         virtual Name GetCacheName() const;
@@ -32,6 +77,8 @@ namespace Helium
         //@{
 #if HELIUM_USE_GRANNY_ANIMATION
         inline const Granny::AnimationData& GetGrannyData() const;
+#else
+        inline const PersistentResourceData& GetClipData() const;
 #endif
         //@}
 
@@ -39,6 +86,9 @@ namespace Helium
 #if HELIUM_USE_GRANNY_ANIMATION
         /// Granny-specific animation data.
         Granny::AnimationData m_grannyData;
+#else
+        /// Built-in animation clip data.
+        PersistentResourceData m_persistentResourceData;
 #endif
     };
 }
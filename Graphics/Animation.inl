@@ -8,5 +8,46 @@ namespace Helium
     {
         return m_grannyData;
     }
+#else  // HELIUM_USE_GRANNY_ANIMATION
+    /// Get the built-in animation clip data.
+    ///
+    /// @return  Animation clip data.
+    const Animation::PersistentResourceData& Animation::GetClipData() const
+    {
+        return m_persistentResourceData;
+    }
+
+    /// Get the number of tracks in the clip.
+    ///
+    /// @return  Track count.
+    size_t Animation::PersistentResourceData::GetTrackCount() const
+    {
+        return m_trackNames.GetSize();
+    }
+
+    /// Get the length of the clip.
+    ///
+    /// @return  Time between the first and last samples, in seconds.
+    float32_t Animation::PersistentResourceData::GetDuration() const
+    {
+        if( m_sampleCount <= 1 || m_samplesPerSecond <= 0.0f )
+        {
+            return 0.0f;
+        }
+
+        return static_cast< float32_t >( m_sampleCount - 1 ) / m_samplesPerSecond;
+    }
+
+    /// Get the keys of every track for a given sample.
+    ///
+    /// @param[in] sampleIndex  Sample index.
+    ///
+    /// @return  Key data for the first track at the specified sample, followed by the keys for the remaining tracks.
+    const float32_t* Animation::PersistentResourceData::GetSampleKeys( size_t sampleIndex ) const
+    {
+        HELIUM_ASSERT( sampleIndex < m_sampleCount );
+
+        return m_keys.GetData() + sampleIndex * m_trackNames.GetSize() * KEY_VALUE_COUNT;
+    }
 #endif  // HELIUM_USE_GRANNY_ANIMATION
 }
@@ -0,0 +1,182 @@
+#include "GraphicsPch.h"
+#include "Graphics/AnimationEvaluator.h"
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+
+#include "Platform/Atomic.h"
+#include "Platform/Timer.h"
+#include "Engine/FrameProfiler.h"
+#include "Engine/WorkerPool.h"
+
+using namespace Helium;
+
+AnimationEvaluator* AnimationEvaluator::sm_pInstance = NULL;
+
+/// Constructor.
+AnimationEvaluator::AnimationEvaluator()
+: m_ppSkeletons( NULL )
+, m_skeletonCount( 0 )
+, m_nextGroupIndex( 0 )
+, m_maxThreadCount( 0 )
+, m_lastSkeletonCount( 0 )
+, m_lastBoneCount( 0 )
+, m_lastEvaluationMilliseconds( 0.0f )
+{
+    WorkerPool::Startup();
+}
+
+/// Destructor.
+AnimationEvaluator::~AnimationEvaluator()
+{
+    WorkerPool::Shutdown();
+}
+
+/// Limit the number of threads on which skeletons are evaluated.
+///
+/// @param[in] maxThreadCount  Maximum number of threads, including the thread calling Evaluate().  If this is one,
+///                            skeletons are evaluated on the calling thread only.  If this is zero, every worker in
+///                            the shared pool is used.
+///
+/// @see GetMaxThreadCount(), GetThreadCount()
+void AnimationEvaluator::SetMaxThreadCount( size_t maxThreadCount )
+{
+    MutexScopeLock scopeLock( m_evaluateLock );
+
+    m_maxThreadCount = maxThreadCount;
+}
+
+/// Get the number of threads on which skeletons are evaluated.
+///
+/// @return  Number of threads taking part in each evaluation (including the thread calling Evaluate()), given the
+///          size of the shared worker pool and the thread count limit.
+///
+/// @see SetMaxThreadCount()
+size_t AnimationEvaluator::GetThreadCount() const
+{
+    WorkerPool* pWorkerPool = WorkerPool::GetStaticInstance();
+    HELIUM_ASSERT( pWorkerPool );
+
+    size_t threadCount = pWorkerPool->GetWorkerCount() + 1;
+    if( m_maxThreadCount != 0 )
+    {
+        threadCount = Min( threadCount, m_maxThreadCount );
+    }
+
+    return threadCount;
+}
+
+/// Evaluate a set of skeletons, returning once all of them have been evaluated.
+///
+/// Calls from different threads are serialized.
+///
+/// @param[in] ppSkeletons    Skeletons to evaluate.
+/// @param[in] skeletonCount  Number of skeletons.
+///
+/// @see AnimatedSkeleton::Evaluate()
+void AnimationEvaluator::Evaluate( AnimatedSkeleton* const* ppSkeletons, size_t skeletonCount )
+{
+    HELIUM_ASSERT( ppSkeletons || skeletonCount == 0 );
+
+    HELIUM_FRAME_PROFILE_SCOPE( "AnimationEvaluator::Evaluate" );
+
+    MutexScopeLock scopeLock( m_evaluateLock );
+
+    uint64_t startTickCount = Timer::GetTickCount();
+
+    m_ppSkeletons = ppSkeletons;
+    m_skeletonCount = skeletonCount;
+    AtomicExchangeRelease( m_nextGroupIndex, 0 );
+
+    // Each job claims groups until none are left, so only submit as many jobs as there are threads to run them (and no
+    // more than there are groups).  Jobs picked up late by a busy worker simply find no groups left.
+    size_t groupCount = ( skeletonCount + SKELETON_GROUP_SIZE - 1 ) / SKELETON_GROUP_SIZE;
+    size_t jobCount = Min( GetThreadCount(), groupCount );
+    if( jobCount <= 1 )
+    {
+        EvaluateGroups();
+    }
+    else
+    {
+        WorkerPool* pWorkerPool = WorkerPool::GetStaticInstance();
+        HELIUM_ASSERT( pWorkerPool );
+        pWorkerPool->Run( EvaluateGroupsCallback, this, jobCount );
+    }
+
+    size_t boneCount = 0;
+    for( size_t skeletonIndex = 0; skeletonIndex < skeletonCount; ++skeletonIndex )
+    {
+        boneCount += ppSkeletons[ skeletonIndex ]->GetBoneCount();
+    }
+
+    m_ppSkeletons = NULL;
+    m_skeletonCount = 0;
+
+    m_lastSkeletonCount = skeletonCount;
+    m_lastBoneCount = boneCount;
+    m_lastEvaluationMilliseconds = static_cast< float32_t >(
+        Timer::TicksToMilliseconds( Timer::GetTickCount() - startTickCount ) );
+}
+
+/// Get the evaluator instance, creating it (and starting the shared worker pool) if it does not exist.
+///
+/// @return  Evaluator instance.
+///
+/// @see DestroyStaticInstance()
+AnimationEvaluator& AnimationEvaluator::GetStaticInstance()
+{
+    if( !sm_pInstance )
+    {
+        sm_pInstance = new AnimationEvaluator;
+        HELIUM_ASSERT( sm_pInstance );
+    }
+
+    return *sm_pInstance;
+}
+
+/// Destroy the evaluator instance, releasing its reference to the shared worker pool.
+///
+/// @see GetStaticInstance()
+void AnimationEvaluator::DestroyStaticInstance()
+{
+    delete sm_pInstance;
+    sm_pInstance = NULL;
+}
+
+/// Evaluate skeleton groups from the current evaluation until none are left.
+void AnimationEvaluator::EvaluateGroups()
+{
+    AnimatedSkeleton* const* ppSkeletons = m_ppSkeletons;
+    size_t skeletonCount = m_skeletonCount;
+    for( ; ; )
+    {
+        size_t groupIndex = static_cast< size_t >( AtomicIncrementAcquire( m_nextGroupIndex ) - 1 );
+        size_t skeletonIndex = groupIndex * SKELETON_GROUP_SIZE;
+        if( skeletonIndex >= skeletonCount )
+        {
+            break;
+        }
+
+        size_t skeletonIndexEnd = Min( skeletonIndex + SKELETON_GROUP_SIZE, skeletonCount );
+        for( ; skeletonIndex < skeletonIndexEnd; ++skeletonIndex )
+        {
+            AnimatedSkeleton* pSkeleton = ppSkeletons[ skeletonIndex ];
+            HELIUM_ASSERT( pSkeleton );
+            pSkeleton->Evaluate();
+        }
+    }
+}
+
+/// WorkerPool job callback for evaluating skeleton groups.
+///
+/// @param[in] pData     AnimationEvaluator instance.
+/// @param[in] jobIndex  Index of the job (unused, as each job claims groups until none are left).
+void AnimationEvaluator::EvaluateGroupsCallback( void* pData, size_t /*jobIndex*/ )
+{
+    AnimationEvaluator* pEvaluator = static_cast< AnimationEvaluator* >( pData );
+    HELIUM_ASSERT( pEvaluator );
+
+    HELIUM_FRAME_PROFILE_SCOPE( "AnimationEvaluator::EvaluateGroups" );
+    pEvaluator->EvaluateGroups();
+}
+
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
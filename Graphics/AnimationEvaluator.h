@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+#include "Graphics/AnimatedSkeleton.h"
+
+#include "Platform/Locks.h"
+
+#if !HELIUM_USE_GRANNY_ANIMATION
+
+namespace Helium
+{
+    /// Evaluates batches of animated skeletons in parallel on the shared worker pool.
+    ///
+    /// Each call to Evaluate() splits its skeletons into fixed-size groups that the pool workers and the calling
+    /// thread claim until none are left, returning once every skeleton has been evaluated.  Skeletons are independent
+    /// of each other, so the results do not depend on how the groups are distributed.
+    class HELIUM_GRAPHICS_API AnimationEvaluator : NonCopyable
+    {
+    public:
+        /// Number of skeletons claimed by a thread at a time.
+        static const size_t SKELETON_GROUP_SIZE = 16;
+
+        /// @name Threading
+        //@{
+        void SetMaxThreadCount( size_t maxThreadCount );
+        inline size_t GetMaxThreadCount() const;
+
+        size_t GetThreadCount() const;
+        //@}
+
+        /// @name Evaluation
+        //@{
+        void Evaluate( AnimatedSkeleton* const* ppSkeletons, size_t skeletonCount );
+        //@}
+
+        /// @name Statistics
+        //@{
+        inline size_t GetLastSkeletonCount() const;
+        inline size_t GetLastBoneCount() const;
+        inline float32_t GetLastEvaluationMilliseconds() const;
+        //@}
+
+        /// @name Static Access
+        //@{
+        static AnimationEvaluator& GetStaticInstance();
+        static void DestroyStaticInstance();
+        //@}
+
+    private:
+        /// Lock serializing calls to Evaluate() from different threads.
+        Mutex m_evaluateLock;
+
+        /// Skeletons being evaluated.
+        AnimatedSkeleton* const* m_ppSkeletons;
+        /// Number of skeletons being evaluated.
+        size_t m_skeletonCount;
+        /// Index of the next skeleton group to evaluate.
+        volatile int32_t m_nextGroupIndex;
+
+        /// Maximum number of threads (including the thread calling Evaluate()) to evaluate skeletons on, or zero to
+        /// use every worker in the shared pool.
+        size_t m_maxThreadCount;
+
+        /// Number of skeletons evaluated by the most recent call to Evaluate().
+        size_t m_lastSkeletonCount;
+        /// Number of bones evaluated by the most recent call to Evaluate().
+        size_t m_lastBoneCount;
+        /// Time taken by the most recent call to Evaluate(), in milliseconds.
+        float32_t m_lastEvaluationMilliseconds;
+
+        /// Singleton instance.
+        static AnimationEvaluator* sm_pInstance;
+
+        /// @name Construction/Destruction
+        //@{
+        AnimationEvaluator();
+        ~AnimationEvaluator();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        void EvaluateGroups();
+
+        static void EvaluateGroupsCallback( void* pData, size_t jobIndex );
+        //@}
+    };
+}
+
+#include "Graphics/AnimationEvaluator.inl"
+
+#endif  // !HELIUM_USE_GRANNY_ANIMATION
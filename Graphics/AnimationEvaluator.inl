@@ -0,0 +1,43 @@
+namespace Helium
+{
+    /// Get the maximum number of threads on which skeletons are evaluated.
+    ///
+    /// @return  Maximum thread count (including the thread calling Evaluate()), or zero if every worker in the shared
+    ///          pool is used.
+    ///
+    /// @see SetMaxThreadCount(), GetThreadCount()
+    size_t AnimationEvaluator::GetMaxThreadCount() const
+    {
+        return m_maxThreadCount;
+    }
+
+    /// Get the number of skeletons evaluated by the most recent call to Evaluate().
+    ///
+    /// @return  Skeleton count.
+    ///
+    /// @see GetLastBoneCount(), GetLastEvaluationMilliseconds()
+    size_t AnimationEvaluator::GetLastSkeletonCount() const
+    {
+        return m_lastSkeletonCount;
+    }
+
+    /// Get the total number of bones evaluated by the most recent call to Evaluate().
+    ///
+    /// @return  Bone count.
+    ///
+    /// @see GetLastSkeletonCount(), GetLastEvaluationMilliseconds()
+    size_t AnimationEvaluator::GetLastBoneCount() const
+    {
+        return m_lastBoneCount;
+    }
+
+    /// Get the time taken by the most recent call to Evaluate().
+    ///
+    /// @return  Evaluation time, in milliseconds.
+    ///
+    /// @see GetLastSkeletonCount(), GetLastBoneCount()
+    float32_t AnimationEvaluator::GetLastEvaluationMilliseconds() const
+    {
+        return m_lastEvaluationMilliseconds;
+    }
+}
@@ -171,6 +171,7 @@ void BufferedDrawer::Shutdown()
 		m_texturedBufferDrawCalls[ stateIndex ].Clear();
 
 		m_worldTextDrawCalls[ stateIndex ].Clear();
+		m_worldDistanceFieldTextDrawCalls[ stateIndex ].Clear();
 	}
 
 	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_pointDrawCalls ); ++stateIndex )
@@ -1249,6 +1250,7 @@ void BufferedDrawer::EndDrawing()
 	for( size_t stateIndex = 0; stateIndex < HELIUM_ARRAY_COUNT( m_untexturedDrawCalls ); ++stateIndex )
 	{
 		m_worldTextDrawCalls[ stateIndex ].RemoveAll();
+		m_worldDistanceFieldTextDrawCalls[ stateIndex ].RemoveAll();
 
 		m_texturedBufferDrawCalls[ stateIndex ].RemoveAll();
 		m_untexturedBufferDrawCalls[ stateIndex ].RemoveAll();
@@ -1422,6 +1424,31 @@ void BufferedDrawer::DrawWorldElements( const Simd::Matrix44& rInverseViewProjec
 	HELIUM_ASSERT( !pShaderResource || pShaderResource->GetType() == RShader::TYPE_PIXEL );
 	worldResources.spTextureAlphaPixelShader = static_cast< RPixelShader* >( pShaderResource );
 
+	static const Shader::SelectPair textureDistanceFieldSelectOptions[] =
+	{
+		Shader::SelectPair( Name( TXT( "TEXTURING" ) ), Name( TXT( "TEXTURING_DISTANCE_FIELD" ) ) ),
+	};
+
+	optionSetIndex = rSystemOptions.GetOptionSetIndex(
+		RShader::TYPE_VERTEX,
+		NULL,
+		0,
+		textureDistanceFieldSelectOptions,
+		HELIUM_ARRAY_COUNT( textureDistanceFieldSelectOptions ) );
+	pShaderResource = pVertexShaderVariant->GetRenderResource( optionSetIndex );
+	HELIUM_ASSERT( !pShaderResource || pShaderResource->GetType() == RShader::TYPE_VERTEX );
+	worldResources.spTextureDistanceFieldVertexShader = static_cast< RVertexShader* >( pShaderResource );
+
+	optionSetIndex = rSystemOptions.GetOptionSetIndex(
+		RShader::TYPE_PIXEL,
+		NULL,
+		0,
+		textureDistanceFieldSelectOptions,
+		HELIUM_ARRAY_COUNT( textureDistanceFieldSelectOptions ) );
+	pShaderResource = pPixelShaderVariant->GetRenderResource( optionSetIndex );
+	HELIUM_ASSERT( !pShaderResource || pShaderResource->GetType() == RShader::TYPE_PIXEL );
+	worldResources.spTextureDistanceFieldPixelShader = static_cast< RPixelShader* >( pShaderResource );
+
 	// Get the vertex description resources for the untextured and textured vertex types.
 	worldResources.spSimpleVertexDescription = rRenderResourceManager.GetSimpleVertexDescription();
 	HELIUM_ASSERT( worldResources.spSimpleVertexDescription );
@@ -1536,6 +1563,18 @@ void BufferedDrawer::DrawScreenElements()
 	HELIUM_ASSERT( !pShaderResource || pShaderResource->GetType() == RShader::TYPE_PIXEL );
 	RPixelShaderPtr spScreenTextPixelShader = static_cast< RPixelShader* >( pShaderResource );
 
+	static const Name distanceFieldToggles[] = { Name( TXT( "DISTANCE_FIELD" ) ) };
+
+	optionSetIndex = rSystemOptions.GetOptionSetIndex(
+		RShader::TYPE_PIXEL,
+		distanceFieldToggles,
+		HELIUM_ARRAY_COUNT( distanceFieldToggles ),
+		NULL,
+		0 );
+	pShaderResource = pPixelShaderVariant->GetRenderResource( optionSetIndex );
+	HELIUM_ASSERT( !pShaderResource || pShaderResource->GetType() == RShader::TYPE_PIXEL );
+	RPixelShaderPtr spDistanceFieldTextPixelShader = static_cast< RPixelShader* >( pShaderResource );
+
 	static const Name projectToggles[] = { Name( TXT( "PROJECT" ) ) };
 
 	optionSetIndex = rSystemOptions.GetOptionSetIndex(
@@ -1557,7 +1596,6 @@ void BufferedDrawer::DrawScreenElements()
 	if( pScreenSpaceTextVertexBuffer && screenTextDrawCount != 0 && spScreenTextVertexShader )
 	{
 		stateCache.SetVertexShader( spScreenTextVertexShader );
-		stateCache.SetPixelShader( spScreenTextPixelShader );
 
 		stateCache.SetVertexBuffer( pScreenSpaceTextVertexBuffer, static_cast< uint32_t >( sizeof( ScreenVertex ) ) );
 		stateCache.SetIndexBuffer( m_spScreenSpaceTextIndexBuffer );
@@ -1583,6 +1621,12 @@ void BufferedDrawer::DrawScreenElements()
 				continue;
 			}
 
+			// Fonts with signed distance field texture sheets need to rebuild glyph edges in the pixel shader.
+			stateCache.SetPixelShader(
+				pFont->GetDistanceField() && spDistanceFieldTextPixelShader
+				? spDistanceFieldTextPixelShader
+				: spScreenTextPixelShader );
+
 			uint32_t fontCharacterCount = pFont->GetCharacterCount();
 
 			for( uint_fast32_t drawCallGlyphIndex = 0; drawCallGlyphIndex < drawCallGlyphCount; ++drawCallGlyphIndex )
@@ -1615,7 +1659,6 @@ void BufferedDrawer::DrawScreenElements()
 	if( pProjectedTextVertexBuffer && projectedTextDrawCount != 0 && spProjectedTextVertexShader )
 	{
 		stateCache.SetVertexShader( spProjectedTextVertexShader );
-		stateCache.SetPixelShader( spScreenTextPixelShader );
 
 		stateCache.SetVertexBuffer( pProjectedTextVertexBuffer, static_cast< uint32_t >( sizeof( ProjectedVertex ) ) );
 		stateCache.SetIndexBuffer( m_spScreenSpaceTextIndexBuffer );
@@ -1641,6 +1684,12 @@ void BufferedDrawer::DrawScreenElements()
 				continue;
 			}
 
+			// Fonts with signed distance field texture sheets need to rebuild glyph edges in the pixel shader.
+			stateCache.SetPixelShader(
+				pFont->GetDistanceField() && spDistanceFieldTextPixelShader
+				? spDistanceFieldTextPixelShader
+				: spScreenTextPixelShader );
+
 			uint32_t fontCharacterCount = pFont->GetCharacterCount();
 
 			for( uint_fast32_t drawCallGlyphIndex = 0; drawCallGlyphIndex < drawCallGlyphCount; ++drawCallGlyphIndex )
@@ -1784,9 +1833,9 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 		if( rResourceSet.spTexturedVertexBuffer )
 		{
 			const DynamicArray< TexturedDrawCall >& rTexturedDrawCalls = m_texturedDrawCalls[ stateIndex ];
-			const DynamicArray< TexturedDrawCall >& rWorldTextDrawCalls = m_worldTextDrawCalls[ stateIndex ];
 			size_t texturedDrawCallCount = rTexturedDrawCalls.GetSize();
-			size_t worldTextDrawCallCount = rWorldTextDrawCalls.GetSize();
+			size_t worldTextDrawCallCount =
+				m_worldTextDrawCalls[ stateIndex ].GetSize() + m_worldDistanceFieldTextDrawCalls[ stateIndex ].GetSize();
 
 			if( ( texturedDrawCallCount | worldTextDrawCallCount ) != 0 )
 			{
@@ -1858,20 +1907,44 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 					}
 				}
 
-				if( worldTextDrawCallCount != 0 && rWorldResources.spTextureAlphaVertexShader )
+				// Text using regular glyph bitmaps and text using signed distance fields only differ by shader.
+				const DynamicArray< TexturedDrawCall >* textDrawCallSets[] =
 				{
+					&m_worldTextDrawCalls[ stateIndex ],
+					&m_worldDistanceFieldTextDrawCalls[ stateIndex ]
+				};
+				RVertexShader* textVertexShaders[] =
+				{
+					rWorldResources.spTextureAlphaVertexShader,
+					rWorldResources.spTextureDistanceFieldVertexShader
+				};
+				RPixelShader* textPixelShaders[] =
+				{
+					rWorldResources.spTextureAlphaPixelShader,
+					rWorldResources.spTextureDistanceFieldPixelShader
+				};
+
+				for( size_t textSetIndex = 0; textSetIndex < HELIUM_ARRAY_COUNT( textDrawCallSets ); ++textSetIndex )
+				{
+					const DynamicArray< TexturedDrawCall >& rWorldTextDrawCalls = *textDrawCallSets[ textSetIndex ];
+					size_t textDrawCallCount = rWorldTextDrawCalls.GetSize();
+					RVertexShader* pTextVertexShader = textVertexShaders[ textSetIndex ];
+					if( textDrawCallCount == 0 || !pTextVertexShader )
+					{
+						continue;
+					}
+
 					pStateCache->SetRasterizerState( pRasterizerState );
 					pStateCache->SetBlendState( pBlendStateTransparent );
 					pStateCache->SetDepthStencilState( pDepthStencilState, 0 );
 
-					pStateCache->SetVertexShader( rWorldResources.spTextureAlphaVertexShader );
-					pStateCache->SetPixelShader( rWorldResources.spTextureAlphaPixelShader );
+					pStateCache->SetVertexShader( pTextVertexShader );
+					pStateCache->SetPixelShader( textPixelShaders[ textSetIndex ] );
 
-					rWorldResources.spTextureAlphaVertexShader->CacheDescription(
+					pTextVertexShader->CacheDescription(
 						pRenderer,
 						rWorldResources.spSimpleTexturedVertexDescription );
-					RVertexInputLayout* pVertexInputLayout =
-						rWorldResources.spTextureAlphaVertexShader->GetCachedInputLayout();
+					RVertexInputLayout* pVertexInputLayout = pTextVertexShader->GetCachedInputLayout();
 					HELIUM_ASSERT( pVertexInputLayout );
 					pStateCache->SetVertexInputLayout( pVertexInputLayout );
 
@@ -1883,7 +1956,7 @@ void BufferedDrawer::DrawDepthStencilStateWorldElements(
 					HELIUM_ASSERT( pConstantBuffer );
 					pStateCache->SetVertexConstantBuffer( pConstantBuffer );
 
-					for( size_t drawCallIndex = 0; drawCallIndex < worldTextDrawCallCount; ++drawCallIndex )
+					for( size_t drawCallIndex = 0; drawCallIndex < textDrawCallCount; ++drawCallIndex )
 					{
 						const TexturedDrawCall& rDrawCall = rWorldTextDrawCalls[ drawCallIndex ];
 
@@ -2644,7 +2717,10 @@ void BufferedDrawer::WorldSpaceTextGlyphHandler::operator()( const Font::Charact
 	m_pDrawer->m_texturedVertices.AddArray( vertices, 4 );
 	m_pDrawer->m_texturedIndices.AddArray( m_quadIndices, 6 );
 
-	TexturedDrawCall* pDrawCall = m_pDrawer->m_worldTextDrawCalls[ m_stateIndex ].New();
+	DynamicArray< TexturedDrawCall >& rDrawCalls = ( m_pFont->GetDistanceField()
+		? m_pDrawer->m_worldDistanceFieldTextDrawCalls[ m_stateIndex ]
+		: m_pDrawer->m_worldTextDrawCalls[ m_stateIndex ] );
+	TexturedDrawCall* pDrawCall = rDrawCalls.New();
 	HELIUM_ASSERT( pDrawCall );
 	pDrawCall->primitiveType = RENDERER_PRIMITIVE_TYPE_TRIANGLE_LIST;
 	pDrawCall->baseVertexIndex = baseVertexIndex;
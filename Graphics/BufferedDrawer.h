@@ -366,6 +366,11 @@ namespace Helium
 			/// Pixel shader for textured rendering blending the vertex color with the texture alpha.
 			RPixelShaderPtr spTextureAlphaPixelShader;
 
+			/// Vertex shader for rendering text from signed distance field font texture sheets.
+			RVertexShaderPtr spTextureDistanceFieldVertexShader;
+			/// Pixel shader for rendering text from signed distance field font texture sheets.
+			RPixelShaderPtr spTextureDistanceFieldPixelShader;
+
 			/// Cached reference to the vertex description for SimpleVertex.
 			RVertexDescriptionPtr spSimpleVertexDescription;
 			/// Cached reference to the vertex description for SimpleTexturedVertex;
@@ -518,6 +523,8 @@ namespace Helium
 
 		/// World-space text draw call data.
 		DynamicArray< TexturedDrawCall > m_worldTextDrawCalls[ RenderResourceManager::RASTERIZER_STATE_MAX * RenderResourceManager::DEPTH_STENCIL_STATE_MAX ];
+		/// World-space text draw call data for fonts with signed distance field texture sheets.
+		DynamicArray< TexturedDrawCall > m_worldDistanceFieldTextDrawCalls[ RenderResourceManager::RASTERIZER_STATE_MAX * RenderResourceManager::DEPTH_STENCIL_STATE_MAX ];
 
 		/// Screen-space text draw call data.
 		DynamicArray< ScreenTextDrawCall > m_screenTextDrawCalls;
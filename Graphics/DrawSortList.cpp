@@ -0,0 +1,239 @@
+#include "GraphicsPch.h"
+#include "Graphics/DrawSortList.h"
+
+using namespace Helium;
+
+/// Number of bits in each radix sort digit.
+static const uint32_t RADIX_DIGIT_BITS = 8;
+/// Number of buckets for each radix sort digit.
+static const uint32_t RADIX_BUCKET_COUNT = 1 << RADIX_DIGIT_BITS;
+/// Number of radix sort digits in a sort key.
+static const uint32_t RADIX_DIGIT_COUNT = 64 / RADIX_DIGIT_BITS;
+
+/// Constructor.
+DrawSortList::DrawSortList()
+{
+    Clear();
+}
+
+/// Remove all entries from the list.
+///
+/// Allocated memory is retained for reuse.
+void DrawSortList::Clear()
+{
+    m_keys.Resize( 0 );
+    m_subMeshIndices.Resize( 0 );
+
+    MemoryZero( m_passCounts, sizeof( m_passCounts ) );
+    MemoryZero( m_passOffsets, sizeof( m_passOffsets ) );
+}
+
+/// Sort all entries in the list by their keys and compute the range of entries for each pass.
+///
+/// Entries are sorted with a least-significant-digit radix sort, skipping any digit that is the same for all keys (as
+/// with unused shader and material rank bits in depth-only passes).  The sort is stable, so entries with equal keys
+/// keep the order in which they were added.
+///
+/// @see Add(), GetPassRange()
+void DrawSortList::Sort()
+{
+    uint32_t offset = 0;
+    for( size_t pass = 0; pass < PASS_MAX; ++pass )
+    {
+        m_passOffsets[ pass ] = offset;
+        offset += m_passCounts[ pass ];
+    }
+
+    m_passOffsets[ PASS_MAX ] = offset;
+
+    size_t entryCount = m_keys.GetSize();
+    HELIUM_ASSERT( entryCount == offset );
+    if( entryCount < 2 )
+    {
+        return;
+    }
+
+    // Build the histograms for all digits in a single pass over the keys.
+    uint32_t histograms[ RADIX_DIGIT_COUNT ][ RADIX_BUCKET_COUNT ];
+    MemoryZero( histograms, sizeof( histograms ) );
+
+    const uint64_t* pKeys = m_keys.GetData();
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        uint64_t key = pKeys[ entryIndex ];
+        for( uint32_t digitIndex = 0; digitIndex < RADIX_DIGIT_COUNT; ++digitIndex )
+        {
+            ++histograms[ digitIndex ][ static_cast< size_t >( key >> ( digitIndex * RADIX_DIGIT_BITS ) ) & 0xff ];
+        }
+    }
+
+    m_scratchKeys.Resize( entryCount );
+    m_scratchSubMeshIndices.Resize( entryCount );
+
+    uint64_t* pSourceKeys = m_keys.GetData();
+    uint32_t* pSourceSubMeshIndices = m_subMeshIndices.GetData();
+    uint64_t* pTargetKeys = m_scratchKeys.GetData();
+    uint32_t* pTargetSubMeshIndices = m_scratchSubMeshIndices.GetData();
+
+    for( uint32_t digitIndex = 0; digitIndex < RADIX_DIGIT_COUNT; ++digitIndex )
+    {
+        uint32_t shift = digitIndex * RADIX_DIGIT_BITS;
+        uint32_t* pHistogram = histograms[ digitIndex ];
+
+        // Skip digits that would not change the order.
+        if( pHistogram[ static_cast< size_t >( pSourceKeys[ 0 ] >> shift ) & 0xff ] == entryCount )
+        {
+            continue;
+        }
+
+        uint32_t bucketOffset = 0;
+        for( uint32_t bucketIndex = 0; bucketIndex < RADIX_BUCKET_COUNT; ++bucketIndex )
+        {
+            uint32_t bucketCount = pHistogram[ bucketIndex ];
+            pHistogram[ bucketIndex ] = bucketOffset;
+            bucketOffset += bucketCount;
+        }
+
+        for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+        {
+            uint64_t key = pSourceKeys[ entryIndex ];
+            uint32_t targetIndex = pHistogram[ static_cast< size_t >( key >> shift ) & 0xff ]++;
+            pTargetKeys[ targetIndex ] = key;
+            pTargetSubMeshIndices[ targetIndex ] = pSourceSubMeshIndices[ entryIndex ];
+        }
+
+        uint64_t* pSwapKeys = pSourceKeys;
+        pSourceKeys = pTargetKeys;
+        pTargetKeys = pSwapKeys;
+
+        uint32_t* pSwapSubMeshIndices = pSourceSubMeshIndices;
+        pSourceSubMeshIndices = pTargetSubMeshIndices;
+        pTargetSubMeshIndices = pSwapSubMeshIndices;
+    }
+
+    // Make sure the sorted entries end up in the main arrays.
+    if( pSourceKeys != m_keys.GetData() )
+    {
+        m_keys.Swap( m_scratchKeys );
+        m_subMeshIndices.Swap( m_scratchSubMeshIndices );
+    }
+}
+
+/// Build a sort key.
+///
+/// @param[in] pass              Render pass in which the sub-mesh is drawn.
+/// @param[in] vertexShaderRank  Rank of the vertex shader variant (zero if not relevant for the pass).
+/// @param[in] pixelShaderRank   Rank of the pixel shader variant (zero if not relevant for the pass).
+/// @param[in] bSkinned          True if the sub-mesh is drawn using the skinned system shader option.
+/// @param[in] materialRank      Rank of the material (zero if not relevant for the pass).
+/// @param[in] depth             Distance along the sorting direction (entries with smaller values are sorted first).
+///
+/// @return  Packed sort key.
+///
+/// @see Add()
+uint64_t DrawSortList::MakeKey(
+    EPass pass,
+    uint32_t vertexShaderRank,
+    uint32_t pixelShaderRank,
+    bool bSkinned,
+    uint32_t materialRank,
+    float32_t depth )
+{
+    HELIUM_ASSERT( static_cast< size_t >( pass ) < PASS_MAX );
+
+    // Map the floating-point depth onto an unsigned integer with the same ordering, then keep the upper bits.  This
+    // keeps a roughly constant relative precision over any range of depths without having to know the range up front.
+    union
+    {
+        float32_t f;
+        uint32_t u;
+    } depthBits;
+    depthBits.f = depth;
+
+    uint32_t orderedDepth = ( ( depthBits.u & 0x80000000 ) ? ~depthBits.u : ( depthBits.u | 0x80000000 ) );
+
+    vertexShaderRank = ( vertexShaderRank < SHADER_RANK_MAX ? vertexShaderRank : SHADER_RANK_MAX );
+    pixelShaderRank = ( pixelShaderRank < SHADER_RANK_MAX ? pixelShaderRank : SHADER_RANK_MAX );
+    materialRank = ( materialRank < MATERIAL_RANK_MAX ? materialRank : MATERIAL_RANK_MAX );
+
+    return ( static_cast< uint64_t >( pass ) << 61 ) |
+        ( static_cast< uint64_t >( vertexShaderRank ) << 51 ) |
+        ( static_cast< uint64_t >( pixelShaderRank ) << 41 ) |
+        ( static_cast< uint64_t >( bSkinned ? 1 : 0 ) << 40 ) |
+        ( static_cast< uint64_t >( materialRank ) << 28 ) |
+        static_cast< uint64_t >( orderedDepth >> 4 );
+}
+
+/// Constructor.
+///
+/// @param[in] rankMax  Maximum rank to assign.  Objects encountered after all ranks up to this value have been
+///                     assigned share this rank.
+DrawSortList::PointerRankTable::PointerRankTable( uint32_t rankMax )
+: m_rankCount( 0 )
+, m_rankMax( rankMax )
+{
+    // Size the hash table to at most half full.
+    size_t tableSize = 16;
+    while( tableSize < static_cast< size_t >( rankMax ) * 2 )
+    {
+        tableSize *= 2;
+    }
+
+    m_objects.Add( static_cast< const void* >( NULL ), tableSize );
+    m_ranks.Add( 0, tableSize );
+}
+
+/// Forget all assigned ranks.
+void DrawSortList::PointerRankTable::Clear()
+{
+    if( m_rankCount != 0 )
+    {
+        MemoryZero( m_objects.GetData(), m_objects.GetSize() * sizeof( const void* ) );
+        m_rankCount = 0;
+    }
+}
+
+/// Get the rank for an object, assigning the next available rank if the object has not been seen since the table was
+/// last cleared.
+///
+/// @param[in] pObject  Object for which to get the rank.
+///
+/// @return  Object rank.  Null objects always have a rank of zero, while other objects are ranked from one in the
+///          order in which they are first encountered.
+uint32_t DrawSortList::PointerRankTable::GetRank( const void* pObject )
+{
+    if( !pObject )
+    {
+        return 0;
+    }
+
+    size_t tableMask = m_objects.GetSize() - 1;
+    size_t slotIndex = ( static_cast< size_t >( reinterpret_cast< uintptr_t >( pObject ) >> 4 ) * 2654435761U ) &
+        tableMask;
+    for( ; ; )
+    {
+        const void* pSlotObject = m_objects[ slotIndex ];
+        if( pSlotObject == pObject )
+        {
+            return m_ranks[ slotIndex ];
+        }
+
+        if( !pSlotObject )
+        {
+            break;
+        }
+
+        slotIndex = ( slotIndex + 1 ) & tableMask;
+    }
+
+    if( m_rankCount >= m_rankMax )
+    {
+        return m_rankMax;
+    }
+
+    ++m_rankCount;
+    m_objects[ slotIndex ] = pObject;
+    m_ranks[ slotIndex ] = m_rankCount;
+
+    return m_rankCount;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+
+namespace Helium
+{
+    /// List of sub-mesh draws for one or more render passes, ordered using packed 64-bit sort keys.
+    ///
+    /// Each entry pairs a sort key with the index of the sub-mesh to draw.  Keys are built once for each pass a
+    /// sub-mesh is drawn in and sorted together using a radix sort, after which each pass walks its own contiguous
+    /// range of entries.  From the most significant bits down, a key contains:
+    /// - the pass index (3 bits),
+    /// - the vertex and pixel shader variant ranks (10 bits each),
+    /// - whether the skinned system shader option is used (1 bit),
+    /// - the material rank (12 bits),
+    /// - the quantized sort depth (28 bits, ordered from front to back).
+    ///
+    /// Ranks are small integers assigned to shader variants and materials by PointerRankTable so that entries sharing
+    /// the same shaders and material end up next to each other without comparing any of the objects themselves.
+    class HELIUM_GRAPHICS_API DrawSortList : NonCopyable
+    {
+    public:
+        /// Render passes, in the order in which their entries are sorted.
+        enum EPass
+        {
+            PASS_FIRST   =  0,
+            PASS_INVALID = -1,
+
+            /// First shadow depth cascade pass (each cascade uses a separate pass index).
+            PASS_SHADOW_DEPTH_FIRST,
+            /// Last shadow depth cascade pass.
+            PASS_SHADOW_DEPTH_LAST = PASS_SHADOW_DEPTH_FIRST + 3,
+            /// Depth-only pre-pass.
+            PASS_DEPTH_PRE,
+            /// Base pass.
+            PASS_BASE,
+
+            PASS_MAX,
+            PASS_LAST = PASS_MAX - 1
+        };
+
+        /// Maximum shader variant rank (higher ranks are clamped to this value).
+        static const uint32_t SHADER_RANK_MAX = ( 1 << 10 ) - 1;
+        /// Maximum material rank (higher ranks are clamped to this value).
+        static const uint32_t MATERIAL_RANK_MAX = ( 1 << 12 ) - 1;
+
+        /// Assignment of small integer ranks to objects, used to group sort keys by object identity.
+        class HELIUM_GRAPHICS_API PointerRankTable : NonCopyable
+        {
+        public:
+            /// @name Construction/Destruction
+            //@{
+            explicit PointerRankTable( uint32_t rankMax );
+            //@}
+
+            /// @name Rank Assignment
+            //@{
+            void Clear();
+            uint32_t GetRank( const void* pObject );
+            //@}
+
+        private:
+            /// Hash table of objects with assigned ranks (null entries are unused).
+            DynamicArray< const void* > m_objects;
+            /// Rank assigned to each object in the hash table.
+            DynamicArray< uint32_t > m_ranks;
+            /// Number of ranks assigned.
+            uint32_t m_rankCount;
+            /// Maximum rank to assign.
+            uint32_t m_rankMax;
+        };
+
+        /// @name Construction/Destruction
+        //@{
+        DrawSortList();
+        //@}
+
+        /// @name List Building
+        //@{
+        void Clear();
+        inline void Add( uint64_t key, uint32_t subMeshIndex );
+        void Sort();
+
+        static uint64_t MakeKey(
+            EPass pass, uint32_t vertexShaderRank, uint32_t pixelShaderRank, bool bSkinned, uint32_t materialRank,
+            float32_t depth );
+        //@}
+
+        /// @name Data Access
+        //@{
+        inline size_t GetSize() const;
+        inline uint32_t GetSubMeshIndex( size_t index ) const;
+        inline void GetPassRange( EPass pass, size_t& rStart, size_t& rEnd ) const;
+        //@}
+
+    private:
+        /// Sort keys.
+        DynamicArray< uint64_t > m_keys;
+        /// Sub-mesh index for each sort key.
+        DynamicArray< uint32_t > m_subMeshIndices;
+        /// Radix sort scratch space for sort keys.
+        DynamicArray< uint64_t > m_scratchKeys;
+        /// Radix sort scratch space for sub-mesh indices.
+        DynamicArray< uint32_t > m_scratchSubMeshIndices;
+
+        /// Number of entries added for each pass.
+        uint32_t m_passCounts[ PASS_MAX ];
+        /// Offset of the first entry of each pass once sorted.
+        uint32_t m_passOffsets[ PASS_MAX + 1 ];
+    };
+}
+
+#include "Graphics/DrawSortList.inl"
@@ -0,0 +1,53 @@
+namespace Helium
+{
+    /// Add an entry to the list.
+    ///
+    /// @param[in] key           Sort key, as built using MakeKey().
+    /// @param[in] subMeshIndex  Index of the sub-mesh to draw.
+    ///
+    /// @see Sort(), MakeKey()
+    void DrawSortList::Add( uint64_t key, uint32_t subMeshIndex )
+    {
+        size_t pass = static_cast< size_t >( key >> 61 );
+        HELIUM_ASSERT( pass < PASS_MAX );
+        ++m_passCounts[ pass ];
+
+        m_keys.Push( key );
+        m_subMeshIndices.Push( subMeshIndex );
+    }
+
+    /// Get the number of entries in the list.
+    ///
+    /// @return  Entry count.
+    size_t DrawSortList::GetSize() const
+    {
+        return m_keys.GetSize();
+    }
+
+    /// Get the sub-mesh index of an entry.
+    ///
+    /// @param[in] index  Entry index.
+    ///
+    /// @return  Index of the sub-mesh to draw.
+    uint32_t DrawSortList::GetSubMeshIndex( size_t index ) const
+    {
+        return m_subMeshIndices[ index ];
+    }
+
+    /// Get the range of sorted entries for a given pass.
+    ///
+    /// This is only valid once Sort() has been called.
+    ///
+    /// @param[in]  pass    Pass to look up.
+    /// @param[out] rStart  Index of the first entry for the pass.
+    /// @param[out] rEnd    One past the index of the last entry for the pass.
+    ///
+    /// @see Sort()
+    void DrawSortList::GetPassRange( EPass pass, size_t& rStart, size_t& rEnd ) const
+    {
+        HELIUM_ASSERT( static_cast< size_t >( pass ) < PASS_MAX );
+
+        rStart = m_passOffsets[ pass ];
+        rEnd = m_passOffsets[ pass + 1 ];
+    }
+}
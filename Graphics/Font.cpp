@@ -35,6 +35,7 @@ Font::PersistentResourceData::PersistentResourceData()
 , m_descender( 0 )
 , m_height( 0 )
 , m_maxAdvance( 0 )
+, m_distanceFieldSpread( 0 )
 , m_pspTextures( NULL )
 , m_pTextureLoadIds( NULL )
 , m_textureCount( 0 )
@@ -48,6 +49,7 @@ void Font::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &PersistentResourceData::m_descender,        TXT( "m_descender" ) );
     comp.AddField( &PersistentResourceData::m_height,           TXT( "m_height" ) );
     comp.AddField( &PersistentResourceData::m_maxAdvance,       TXT( "m_maxAdvance" ) );
+    comp.AddField( &PersistentResourceData::m_distanceFieldSpread, TXT( "m_distanceFieldSpread" ) );
     comp.AddField( &PersistentResourceData::m_characters,       TXT( "m_characters" ) );
     comp.AddField( &PersistentResourceData::m_textureCount,     TXT( "m_textureCount" ) );
 }
@@ -60,6 +62,8 @@ Font::Font()
     , m_textureSheetHeight( DEFAULT_TEXTURE_SHEET_HEIGHT )
     , m_textureCompression( DEFAULT_TEXTURE_COMPRESSION )
     , m_bAntialiased( true )
+    , m_bDistanceField( false )
+    , m_characterLookupEndIndex( 0 )
 {
 }
 
@@ -79,6 +83,7 @@ void Font::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &Font::m_textureSheetHeight,   TXT( "m_textureSheetHeight" ) );
     comp.AddField( &Font::m_textureCompression,   TXT( "m_textureCompression" ) );
     comp.AddField( &Font::m_bAntialiased,         TXT( "m_bAntialiased" ) );
+    comp.AddField( &Font::m_bDistanceField,       TXT( "m_bDistanceField" ) );
 }
 
 /// @copydoc Asset::NeedsPrecacheResourceData()
@@ -107,8 +112,12 @@ bool Font::BeginPrecacheResourceData()
     }
 
     // Allocate and begin loading texture resources.
+    // Distance field texture sheets are always stored uncompressed, as block compression artifacts distort the glyph
+    // edges reconstructed from them.
     ERendererPixelFormat format =
-        ( m_textureCompression == ECompression::COLOR_COMPRESSED ? RENDERER_PIXEL_FORMAT_BC1 : RENDERER_PIXEL_FORMAT_R8 );
+        ( m_textureCompression == ECompression::COLOR_COMPRESSED && m_persistentResourceData.m_distanceFieldSpread == 0
+          ? RENDERER_PIXEL_FORMAT_BC1
+          : RENDERER_PIXEL_FORMAT_R8 );
     size_t blockRowCount = RendererUtil::PixelToBlockRowCount( m_textureSheetHeight, format );
 
     uint16_t textureSheetWidth = Max< uint16_t >( m_textureSheetWidth, 1 );
@@ -220,7 +229,8 @@ bool Helium::Font::LoadPersistentResourceObject( Reflect::ObjectPtr &_object )
 
     _object->CopyTo(&m_persistentResourceData);
 
-    uint_fast32_t characterCount = static_cast<uint_fast32_t>(m_persistentResourceData.m_characters.GetSize());
+    BuildCharacterLookup();
+
     uint_fast8_t textureCount = m_persistentResourceData.m_textureCount;
 
     delete [] m_persistentResourceData.m_pspTextures;
@@ -262,6 +272,33 @@ bool Helium::Font::LoadPersistentResourceObject( Reflect::ObjectPtr &_object )
     return true;
 }
 
+/// Build the table for directly looking up characters with code points below CHARACTER_LOOKUP_SIZE.
+///
+/// @see FindCharacter()
+void Font::BuildCharacterLookup()
+{
+    m_characterLookup.Resize( 0 );
+    m_characterLookup.Add( 0xffff, CHARACTER_LOOKUP_SIZE );
+
+    // Characters are sorted by code point, so all characters covered by the table are at the start of the array.
+    uint32_t characterCount = static_cast< uint32_t >( m_persistentResourceData.m_characters.GetSize() );
+    uint32_t characterIndex;
+    for( characterIndex = 0; characterIndex < characterCount; ++characterIndex )
+    {
+        uint32_t codePoint = m_persistentResourceData.m_characters[ characterIndex ].codePoint;
+        if( codePoint >= CHARACTER_LOOKUP_SIZE )
+        {
+            break;
+        }
+
+        HELIUM_ASSERT(
+            characterIndex == 0 || m_persistentResourceData.m_characters[ characterIndex - 1 ].codePoint < codePoint );
+        m_characterLookup[ codePoint ] = static_cast< uint16_t >( characterIndex );
+    }
+
+    m_characterLookupEndIndex = characterIndex;
+}
+
 /// @copydoc Resource::GetCacheName()
 Name Font::GetCacheName() const
 {
@@ -50,6 +50,10 @@ namespace Helium
         /// Default texture compression scheme.
         static const ECompression::Enum DEFAULT_TEXTURE_COMPRESSION;
 
+        /// Number of code points (starting from zero) that can be looked up directly in the character lookup table
+        /// without searching.
+        static const uint32_t CHARACTER_LOOKUP_SIZE = 0x800;
+
         /// Character information.
         struct HELIUM_GRAPHICS_API Character : Reflect::Struct
         {
@@ -122,6 +126,10 @@ namespace Helium
             /// Maximum advance width when rendering text, in pixels (26.6 fixed-point value).
             int32_t m_maxAdvance;
 
+            /// Distance, in pixels, covered by the full range of values in signed distance field texture sheets, or
+            /// zero if the texture sheets contain regular glyph bitmaps.
+            uint8_t m_distanceFieldSpread;
+
             /// Array of characters (ordered by code point value to allow for binary searching).
             //DynamicArray<CharacterPtr> m_characters;
             DynamicArray<Character> m_characters;
@@ -171,6 +179,7 @@ namespace Helium
         inline ECompression GetTextureCompression() const;
 
         inline bool GetAntialiased() const;
+        inline bool GetDistanceField() const;
 
         inline int32_t GetAscenderFixed() const;
         inline int32_t GetDescenderFixed() const;
@@ -181,6 +190,8 @@ namespace Helium
         inline float32_t GetDescenderFloat() const;
         inline float32_t GetHeightFloat() const;
         inline float32_t GetMaxAdvanceFloat() const;
+
+        inline uint8_t GetDistanceFieldSpread() const;
         //@}
 
         /// @name Character Information
@@ -232,6 +243,20 @@ namespace Helium
         
         /// True if this font should use anti-aliasing to smooth edges, false if not.
         bool m_bAntialiased;
+        /// True if texture sheets should store signed distance fields instead of glyph bitmaps (allowing text to be
+        /// scaled to any size from the same texture sheets).
+        bool m_bDistanceField;
+
+        /// Index of the character for each code point below CHARACTER_LOOKUP_SIZE (or 0xffff if the font does not
+        /// contain the code point).
+        DynamicArray< uint16_t > m_characterLookup;
+        /// Index of the first character with a code point not covered by the character lookup table.
+        uint32_t m_characterLookupEndIndex;
+
+        /// @name Private Utility Functions
+        //@{
+        void BuildCharacterLookup();
+        //@}
 
         /// @name Text Processing Support, Private
         //@{
@@ -60,6 +60,17 @@ bool Helium::Font::GetAntialiased() const
     return m_bAntialiased;
 }
 
+/// Get whether the texture sheets for this font should be generated as signed distance fields.
+///
+/// @return  True if signed distance field texture sheets should be generated, false if glyph bitmaps should be
+///          generated.
+///
+/// @see GetDistanceFieldSpread()
+bool Helium::Font::GetDistanceField() const
+{
+    return m_bDistanceField;
+}
+
 /// Get the maximum ascender height of this font in pixels, as a 26.6 fixed-point value.
 ///
 /// @return  Maximum ascender height from the baseline, in pixels.
@@ -140,6 +151,20 @@ float32_t Helium::Font::GetMaxAdvanceFloat() const
     return Fixed26x6ToFloat32( m_persistentResourceData.m_maxAdvance );
 }
 
+/// Get the distance covered by the range of values stored in the signed distance field texture sheets of this font.
+///
+/// Distance field texels store 0.5 on glyph edges, increasing to 1.0 at this distance inside a glyph and decreasing to
+/// 0.0 at this distance outside a glyph.  Character images include this much padding on each side.
+///
+/// @return  Distance field spread, in pixels at the cached font size, or zero if the texture sheets contain regular
+///          glyph bitmaps.
+///
+/// @see GetDistanceField()
+uint8_t Helium::Font::GetDistanceFieldSpread() const
+{
+    return m_persistentResourceData.m_distanceFieldSpread;
+}
+
 /// Get the number of characters in this font.
 ///
 /// @return  Character count.
@@ -178,7 +203,8 @@ uint32_t Helium::Font::GetCharacterIndex( const Character* pCharacter ) const
 
 /// Find the character data for the given Unicode character code point.
 ///
-/// This will perform a binary search for the character with the given code point.
+/// Code points below CHARACTER_LOOKUP_SIZE are resolved directly through a lookup table.  All other code points are
+/// located using a binary search over the remaining characters.
 ///
 /// @param[in] codePoint  Unicode code point value.
 ///
@@ -190,6 +216,20 @@ const Helium::Font::Character* Helium::Font::FindCharacter( uint32_t codePoint )
 {
     uint32_t baseIndex = 0;
     uint32_t searchCount = static_cast<uint32_t>(m_persistentResourceData.m_characters.GetSize());
+
+    if( !m_characterLookup.IsEmpty() )
+    {
+        if( codePoint < CHARACTER_LOOKUP_SIZE )
+        {
+            uint16_t characterIndex = m_characterLookup[ codePoint ];
+
+            return ( characterIndex != 0xffff ? &m_persistentResourceData.m_characters[ characterIndex ] : NULL );
+        }
+
+        baseIndex = m_characterLookupEndIndex;
+        searchCount -= baseIndex;
+    }
+
     while( searchCount != 0 )
     {
         uint32_t testOffset = searchCount / 2;
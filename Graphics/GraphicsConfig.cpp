@@ -17,6 +17,8 @@ GraphicsConfig::GraphicsConfig()
 , m_maxAnisotropy( 0 )
 , m_shadowMode( EShadowMode::PCF_DITHERED )
 , m_shadowBufferSize( DEFAULT_SHADOW_BUFFER_SIZE )
+, m_shadowCascadeCount( DEFAULT_SHADOW_CASCADE_COUNT )
+, m_bOcclusionCulling( true )
 , m_bFullscreen( false )
 , m_bVsync( true )
 {
@@ -37,4 +39,6 @@ void GraphicsConfig::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &GraphicsConfig::m_maxAnisotropy, TXT( "m_MaxAnisotropy" ) );
     comp.AddField( &GraphicsConfig::m_shadowMode, TXT( "m_ShadowMode" ) );
     comp.AddField( &GraphicsConfig::m_shadowBufferSize, TXT( "m_ShadowBufferSize" ) );
+    comp.AddField( &GraphicsConfig::m_shadowCascadeCount, TXT( "m_ShadowCascadeCount" ) );
+    comp.AddField( &GraphicsConfig::m_bOcclusionCulling, TXT( "m_bOcclusionCulling" ) );
 }
@@ -61,6 +61,10 @@ namespace Helium
 
         /// Default shadow buffer size.
         static const uint32_t DEFAULT_SHADOW_BUFFER_SIZE = 1024;
+        /// Maximum number of shadow cascades (must match the cascade array sizes in the shader constant buffers).
+        static const uint32_t SHADOW_CASCADE_COUNT_MAX = 4;
+        /// Default number of shadow cascades.
+        static const uint32_t DEFAULT_SHADOW_CASCADE_COUNT = 4;
 
         /// @name Construction/Destruction
         //@{
@@ -80,6 +84,9 @@ namespace Helium
 
         inline EShadowMode GetShadowMode() const;
         inline uint32_t GetShadowBufferSize() const;
+        inline uint32_t GetShadowCascadeCount() const;
+
+        inline bool GetOcclusionCulling() const;
 
         inline bool GetFullscreen() const;
         inline bool GetVsync() const;
@@ -100,6 +107,11 @@ namespace Helium
         EShadowMode m_shadowMode;
         /// Shadow buffer size (width/height, in texels).
         uint32_t m_shadowBufferSize;
+        /// Number of shadow map cascades.
+        uint32_t m_shadowCascadeCount;
+
+        /// True to cull objects hidden behind large occluders on the CPU.
+        bool m_bOcclusionCulling;
 
         /// True to run in fullscreen mode, false to run in windowed mode.
         bool m_bFullscreen;
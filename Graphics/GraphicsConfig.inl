@@ -52,6 +52,22 @@ namespace Helium
         return m_shadowBufferSize;
     }
 
+    /// Get the number of shadow map cascades.
+    ///
+    /// @return  Shadow cascade count.
+    uint32_t GraphicsConfig::GetShadowCascadeCount() const
+    {
+        return m_shadowCascadeCount;
+    }
+
+    /// Get whether CPU occlusion culling is enabled.
+    ///
+    /// @return  True if occlusion culling is enabled, false if not.
+    bool GraphicsConfig::GetOcclusionCulling() const
+    {
+        return m_bOcclusionCulling;
+    }
+
     /// Get whether fullscreen mode is enabled.
     ///
     /// @return  True if fullscreen mode is enabled, false if not.
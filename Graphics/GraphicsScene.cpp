@@ -2,15 +2,14 @@
 #include "Graphics/GraphicsScene.h"
 
 #include "MathSimd/Plane.h"
-#include "MathSimd/Vector3Soa.h"
 #include "MathSimd/VectorConversion.h"
-#include "EngineJobs/EngineJobsInterface.h"
 #include "Rendering/RConstantBuffer.h"
 #include "Rendering/RIndexBuffer.h"
 #include "Rendering/RPixelShader.h"
 #include "Rendering/RRenderCommandProxy.h"
 #include "Rendering/RRenderContext.h"
 #include "Rendering/Renderer.h"
+#include "Rendering/RStateFilterCommandProxy.h"
 #include "Rendering/RSurface.h"
 #include "Rendering/RVertexBuffer.h"
 #include "Rendering/RVertexInputLayout.h"
@@ -26,6 +25,9 @@
 #include "Framework/Slice.h"
 #include "Framework/EntityDefinition.h"
 #include "Framework/WorldDefinition.h"
+#include "Engine/FrameProfiler.h"
+
+#include <math.h>
 
 HELIUM_DEFINE_CLASS( Helium::GraphicsScene );
 
@@ -37,6 +39,61 @@ HELIUM_DEFINE_COMPONENT(Helium::SceneObjectTransform, 32);
 static const size_t SCENE_VIEW_BUFFERED_DRAWER_POOL_BLOCK_SIZE = 4;
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
+/// Hysteresis factor applied to level of detail screen size thresholds to avoid switching levels of detail every
+/// frame for objects near a threshold.
+static const float32_t LOD_SCREEN_SIZE_HYSTERESIS = 0.1f;
+
+/// Maximum number of occluders rasterized for each view when occlusion culling.
+static const size_t OCCLUDER_COUNT_MAX = 32;
+/// Minimum projected screen size (bounding sphere radius relative to half the viewport width) of an object for it to
+/// be used as an occluder.
+static const float32_t OCCLUDER_SCREEN_SIZE_MIN = 0.1f;
+
+/// Weight of the logarithmic split scheme when blending it with a uniform split scheme to compute shadow cascade
+/// split distances.
+static const float32_t SHADOW_CASCADE_SPLIT_LOG_WEIGHT = 0.75f;
+/// Granularity to which shadow cascade bounding sphere radii are rounded up, in world units (keeps cascade extents from
+/// changing due to numerical noise as the view rotates).
+static const float32_t SHADOW_CASCADE_RADIUS_GRANULARITY = 1.0f / 16.0f;
+/// Factor by which the extent of cacheable shadow cascades is enlarged so that their coarsely snapped placement still
+/// covers the view.
+static const float32_t SHADOW_CASCADE_CACHED_EXTENT_SCALE = 1.25f;
+/// Number of steps across the extent of a cacheable shadow cascade to which its placement is snapped.
+static const uint32_t SHADOW_CASCADE_CACHED_SNAP_STEPS = 8;
+/// Border around each shadow cascade within which pixels use the next cascade instead, in texels (keeps filtering from
+/// sampling neighboring cascade tiles).
+static const float32_t SHADOW_CASCADE_BORDER_TEXELS = 3.0f;
+/// Distance from the shadow view plane to the light-space origin of each cascade (centers the depth range on the
+/// scene).
+static const float32_t SHADOW_VIEW_DEPTH_OFFSET = 32767.0f;
+/// Depth range covered by each shadow cascade.
+static const float32_t SHADOW_VIEW_DEPTH_RANGE = 65536.0f;
+
+/// Width of the light cluster texture (one texel per cluster, with depth slices laid out side by side).
+static const uint32_t LIGHT_CLUSTER_TEXTURE_WIDTH =
+    LightClusterGrid::CLUSTER_COUNT_X * LightClusterGrid::CLUSTER_COUNT_Z;
+/// Height of the light cluster texture.
+static const uint32_t LIGHT_CLUSTER_TEXTURE_HEIGHT = LightClusterGrid::CLUSTER_COUNT_Y;
+/// Width of the light index texture.
+static const uint32_t LIGHT_INDEX_TEXTURE_WIDTH = 256;
+/// Height of the light index texture.
+static const uint32_t LIGHT_INDEX_TEXTURE_HEIGHT = LightClusterGrid::LIGHT_INDEX_COUNT_MAX / LIGHT_INDEX_TEXTURE_WIDTH;
+/// Width of the light data texture (one column per clustered light).
+static const uint32_t LIGHT_DATA_TEXTURE_WIDTH = LightClusterGrid::VISIBLE_LIGHT_COUNT_MAX;
+/// Height of the light data texture (position, color, and direction rows, padded to a power of two).
+static const uint32_t LIGHT_DATA_TEXTURE_HEIGHT = 4;
+/// Minimum light radius used when computing the light falloff (keeps the inverse squared radius within half-float
+/// range).
+static const float32_t LIGHT_RADIUS_MIN = 1.0f / 64.0f;
+/// Minimum difference between the cosines of the inner and outer spot light cone angles used when computing the spot
+/// cone falloff.
+static const float32_t LIGHT_SPOT_COS_RANGE_MIN = 1.0f / 1024.0f;
+
+/// FNV-1a 64-bit offset basis (used for shadow caster signatures).
+static const uint64_t SHADOW_CASTER_HASH_OFFSET_BASIS = 0xcbf29ce484222325ull;
+/// FNV-1a 64-bit prime (used for shadow caster signatures).
+static const uint64_t SHADOW_CASTER_HASH_PRIME = 0x100000001b3ull;
+
 namespace Helium
 {
     HELIUM_DECLARE_RPTR( RRenderCommandProxy );
@@ -49,7 +106,10 @@ GraphicsScene::GraphicsScene()
       m_viewBufferedDrawerPool( SCENE_VIEW_BUFFERED_DRAWER_POOL_BLOCK_SIZE )
     ,
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
-      m_ambientLightTopColor( 0xffffffff )
+      m_vertexShaderRanks( DrawSortList::SHADER_RANK_MAX )
+    , m_pixelShaderRanks( DrawSortList::SHADER_RANK_MAX )
+    , m_materialRanks( DrawSortList::MATERIAL_RANK_MAX )
+    , m_ambientLightTopColor( 0xffffffff )
     , m_ambientLightTopBrightness( 0.25f )
     , m_ambientLightBottomColor( 0xff000000 )
     , m_ambientLightBottomBrightness( 0.0f )
@@ -57,11 +117,19 @@ GraphicsScene::GraphicsScene()
     , m_directionalLightColor( 0xffffffff )
     , m_directionalLightBrightness( 1.0f )
     , m_activeViewId( Invalid< uint32_t >() )
+    , m_shadowCascadeCount( 0 )
+    , m_shadowViewRight( 1.0f, 0.0f, 0.0f )
+    , m_shadowViewUp( 0.0f, 1.0f, 0.0f )
+    , m_clusteredLightCount( 0 )
+    , m_shadowCascadeCacheGeneration( Invalid< uint32_t >() )
+    , m_sceneObjectSetRevision( 0 )
     , m_constantBufferSetIndex( 0 )
 {
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
     HELIUM_VERIFY( m_sceneBufferedDrawer.Initialize() );
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+    InvalidateShadowCascadeCache();
 }
 
 /// Destructor.
@@ -72,6 +140,8 @@ GraphicsScene::~GraphicsScene()
 /// Update this graphics scene for the current frame.
 void GraphicsScene::Update( World *pWorld )
 {
+    HELIUM_FRAME_PROFILE_SCOPE( "GraphicsScene::Update" );
+
     // Check for lost devices.
     Renderer* pRenderer = Renderer::GetStaticInstance();
     if( !pRenderer )
@@ -84,7 +154,16 @@ void GraphicsScene::Update( World *pWorld )
     {
         if( rendererStatus == Renderer::STATUS_NOT_RESET )
         {
+            // Dynamic textures must be released before the device can be reset.
+            m_spLightClusterTexture.Release();
+            m_spLightIndexTexture.Release();
+            m_spLightDataTexture.Release();
+
             rendererStatus = pRenderer->Reset();
+
+            // Shadow depth texture contents are lost when the device is reset, and the texture is shared by all scenes.
+            RenderResourceManager::GetStaticInstance().InvalidateShadowDepthTextureContents();
+            InvalidateShadowCascadeCache();
         }
 
         if( rendererStatus != Renderer::STATUS_READY )
@@ -108,14 +187,18 @@ void GraphicsScene::Update( World *pWorld )
         return;
     }
 
-    // Prepare the array of inverse view/projection matrices for each view's shadow depth pass.
-    if( m_shadowViewInverseViewProjectionMatrices.GetSize() < sceneViewCount )
+    // Prepare the array of shadow cascades for each view's shadow depth pass.
+    m_shadowCascadeCount = rRenderResourceManager.GetShadowCascadeCount();
+    HELIUM_ASSERT( m_shadowCascadeCount <= GraphicsConfig::SHADOW_CASCADE_COUNT_MAX );
+
+    size_t shadowCascadeArraySize = sceneViewCount * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX;
+    if( m_shadowCascades.GetSize() < shadowCascadeArraySize )
     {
-        m_shadowViewInverseViewProjectionMatrices.Reserve( sceneViewCount );
-        m_shadowViewInverseViewProjectionMatrices.Resize( sceneViewCount );
+        m_shadowCascades.Reserve( shadowCascadeArraySize );
+        m_shadowCascades.Resize( shadowCascadeArraySize );
     }
 
-    // Update each scene view as necessary and compute their inverse view/projection matrices.
+    // Update each scene view as necessary and compute their shadow cascades.
     for( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
     {
         if( !m_sceneViews.IsElementValid( viewIndex ) )
@@ -124,7 +207,7 @@ void GraphicsScene::Update( World *pWorld )
         }
 
         m_sceneViews[ viewIndex ].ConditionalUpdate();
-        UpdateShadowInverseViewProjectionMatrixSimple( viewIndex );
+        UpdateShadowCascades( viewIndex );
     }
 
     // Update each scene object as necessary.
@@ -151,6 +234,32 @@ void GraphicsScene::Update( World *pWorld )
     m_visibleSceneObjects.Reserve( sceneObjectCount );
     m_visibleSceneObjects.Resize( sceneObjectCount );
 
+    // Resize the per-view level of detail selection arrays as necessary.
+    if( m_viewSceneObjectLods.GetSize() < sceneViewCount )
+    {
+        m_viewSceneObjectLods.Reserve( sceneViewCount );
+        m_viewSceneObjectLods.Resize( sceneViewCount );
+        m_viewSceneObjectShadowLods.Reserve( sceneViewCount );
+        m_viewSceneObjectShadowLods.Resize( sceneViewCount );
+    }
+
+    for( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
+    {
+        DynamicArray< uint8_t >& rSceneObjectLods = m_viewSceneObjectLods[ viewIndex ];
+        size_t lodEntryCount = rSceneObjectLods.GetSize();
+        if( lodEntryCount < sceneObjectCount )
+        {
+            rSceneObjectLods.Add( 0, sceneObjectCount - lodEntryCount );
+        }
+
+        DynamicArray< uint8_t >& rSceneObjectShadowLods = m_viewSceneObjectShadowLods[ viewIndex ];
+        lodEntryCount = rSceneObjectShadowLods.GetSize();
+        if( lodEntryCount < sceneObjectCount )
+        {
+            rSceneObjectShadowLods.Add( 0, sceneObjectCount - lodEntryCount );
+        }
+    }
+
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
     // Set up the scene's buffered drawer for the current frame.
     m_sceneBufferedDrawer.BeginDrawing();
@@ -261,7 +370,28 @@ size_t GraphicsScene::AllocateSceneObject()
     GraphicsSceneObject* pSceneObject = m_sceneObjects.New();
     HELIUM_ASSERT( pSceneObject );
 
-    return m_sceneObjects.GetElementIndex( pSceneObject );
+    ++m_sceneObjectSetRevision;
+
+    size_t id = m_sceneObjects.GetElementIndex( pSceneObject );
+
+    // Don't let the new object inherit the level of detail selected for the previous occupant of its slot.
+    size_t viewCount = m_viewSceneObjectLods.GetSize();
+    for( size_t viewIndex = 0; viewIndex < viewCount; ++viewIndex )
+    {
+        DynamicArray< uint8_t >& rSceneObjectLods = m_viewSceneObjectLods[ viewIndex ];
+        if( id < rSceneObjectLods.GetSize() )
+        {
+            rSceneObjectLods[ id ] = 0;
+        }
+
+        DynamicArray< uint8_t >& rSceneObjectShadowLods = m_viewSceneObjectShadowLods[ viewIndex ];
+        if( id < rSceneObjectShadowLods.GetSize() )
+        {
+            rSceneObjectShadowLods[ id ] = 0;
+        }
+    }
+
+    return id;
 }
 
 /// Detach and release a previously allocated scene object.
@@ -275,6 +405,8 @@ void GraphicsScene::ReleaseSceneObject( size_t id )
     HELIUM_ASSERT( m_sceneObjects.IsElementValid( id ) );
 
     m_sceneObjects.Remove( id );
+
+    ++m_sceneObjectSetRevision;
 }
 
 /// Allocate new scene object sub-mesh data and add it to the scene.
@@ -293,6 +425,8 @@ size_t GraphicsScene::AllocateSceneObjectSubMeshData( size_t sceneObjectId )
     GraphicsSceneObject::SubMeshData* pSubMeshData = m_sceneObjectSubMeshes.New( sceneObjectId );
     HELIUM_ASSERT( pSubMeshData );
 
+    ++m_sceneObjectSetRevision;
+
     return m_sceneObjectSubMeshes.GetElementIndex( pSubMeshData );
 }
 
@@ -307,6 +441,34 @@ void GraphicsScene::ReleaseSceneObjectSubMeshData( size_t id )
     HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( id ) );
 
     m_sceneObjectSubMeshes.Remove( id );
+
+    ++m_sceneObjectSetRevision;
+}
+
+/// Allocate a new scene light and add it to the scene.
+///
+/// @return  ID of the newly allocated light.
+///
+/// @see ReleaseSceneLight(), GetSceneLight()
+size_t GraphicsScene::AllocateSceneLight()
+{
+    GraphicsSceneLight* pSceneLight = m_sceneLights.New();
+    HELIUM_ASSERT( pSceneLight );
+
+    return m_sceneLights.GetElementIndex( pSceneLight );
+}
+
+/// Detach and release a previously allocated scene light.
+///
+/// @param[in] id  ID of the light to release.
+///
+/// @see AllocateSceneLight(), GetSceneLight()
+void GraphicsScene::ReleaseSceneLight( size_t id )
+{
+    HELIUM_ASSERT( id < m_sceneLights.GetSize() );
+    HELIUM_ASSERT( m_sceneLights.IsElementValid( id ) );
+
+    m_sceneLights.Remove( id );
 }
 
 /// Set the properties for the scene's ambient lighting.
@@ -425,14 +587,64 @@ Name GraphicsScene::GetShadowMapTextureName()
     return shadowMapTextureName;
 }
 
-/// Update the shadow depth pass inverse view/projection matrix for a given scene view.
+/// Get the reserved name for the light cluster texture in material shaders.
+///
+/// @return  Light cluster shader texture input name.
+///
+/// @see GetLightIndexTextureName(), GetLightDataTextureName()
+Name GraphicsScene::GetLightClusterTextureName()
+{
+    static Name lightClusterTextureName( TXT( "_LightClusters" ) );
+
+    return lightClusterTextureName;
+}
+
+/// Get the reserved name for the light index texture in material shaders.
+///
+/// @return  Light index shader texture input name.
+///
+/// @see GetLightClusterTextureName(), GetLightDataTextureName()
+Name GraphicsScene::GetLightIndexTextureName()
+{
+    static Name lightIndexTextureName( TXT( "_LightIndices" ) );
+
+    return lightIndexTextureName;
+}
+
+/// Get the reserved name for the clustered light data texture in material shaders.
+///
+/// @return  Light data shader texture input name.
+///
+/// @see GetLightClusterTextureName(), GetLightIndexTextureName()
+Name GraphicsScene::GetLightDataTextureName()
+{
+    static Name lightDataTextureName( TXT( "_LightData" ) );
+
+    return lightDataTextureName;
+}
+
+/// Update the shadow cascades for a given scene view.
+///
+/// The shadowed region of the view frustum (up to the view's shadow cutoff distance) is split into slices using a blend
+/// of logarithmic and uniform split distances.  Each cascade covers the bounding sphere of its slice, so its extent
+/// does not change as the view rotates, and its placement is snapped to whole shadow map texels to keep shadow edges
+/// from shimmering as the view moves.  Cacheable cascades are enlarged and snapped to a coarser grid so that they only
+/// move occasionally.
+///
+/// @param[in] viewIndex  Index of the scene view for which to update the shadow cascades.
 ///
-/// @param[in] viewIndex  Index of the scene view for which to update the shadow depth pass transform matrix.
-void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIndex )
+/// @see DrawShadowDepthPass()
+void GraphicsScene::UpdateShadowCascades( size_t viewIndex )
 {
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
     HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
-    HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
+    HELIUM_ASSERT( ( viewIndex + 1 ) * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX <= m_shadowCascades.GetSize() );
+
+    uint32_t cascadeCount = m_shadowCascadeCount;
+    if( cascadeCount == 0 )
+    {
+        return;
+    }
 
     // Compute the scene directional light's view basis for shadow calculation.
     Simd::Vector3 shadowViewForward = m_directionalLightDirection;
@@ -440,19 +652,32 @@ void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIn
 
     Simd::Vector3 shadowViewRight;
     shadowViewRight.CrossSet( shadowViewUp, shadowViewForward );
+    if( shadowViewRight.GetMagnitude() < HELIUM_EPSILON )
+    {
+        // Light is pointing straight up or down, so any horizontal axis will do.
+        shadowViewRight = Simd::Vector3( 1.0f, 0.0f, 0.0f );
+    }
+
     shadowViewRight.Normalize();
 
     shadowViewUp.CrossSet( shadowViewForward, shadowViewRight );
 
+    m_shadowViewRight = shadowViewRight;
+    m_shadowViewUp = shadowViewUp;
+
     // Compute the corners of the view frustum region affected by shadowing.
     GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
 
     float32_t shadowCutoffDistance = rView.GetShadowCutoffDistance();
 
     const Simd::Matrix44& rViewMatrix = rView.GetViewMatrix();
-    Simd::Vector3 shadowClipNormal = Vector4ToVector3( rViewMatrix.GetRow( 2 ) );
-    Simd::Vector3 shadowClipPoint = Vector4ToVector3( rViewMatrix.GetRow( 3 ) ) +
-        shadowClipNormal * shadowCutoffDistance;
+    Simd::Vector3 viewRight = Vector4ToVector3( rViewMatrix.GetRow( 0 ) );
+    Simd::Vector3 viewUp = Vector4ToVector3( rViewMatrix.GetRow( 1 ) );
+    Simd::Vector3 viewForward = Vector4ToVector3( rViewMatrix.GetRow( 2 ) );
+    Simd::Vector3 viewOrigin = Vector4ToVector3( rViewMatrix.GetRow( 3 ) );
+
+    Simd::Vector3 shadowClipNormal = viewForward;
+    Simd::Vector3 shadowClipPoint = viewOrigin + shadowClipNormal * shadowCutoffDistance;
     shadowClipNormal.Negate();
 
     Simd::Plane shadowClipPlane( shadowClipNormal, shadowClipNormal.Dot( shadowClipPoint ) );
@@ -477,103 +702,156 @@ void GraphicsScene::UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIn
     HELIUM_ASSERT( cornerCount == 8 );
     HELIUM_UNREF( cornerCount );
 
-    // Project the view frustum corners onto the shadow viewing plane and compute the bounds needed to
-    // contain the frustum points.
-    Simd::Vector3Soa shadowViewXSoa( shadowViewRight );
-    Simd::Vector3Soa shadowViewYSoa( shadowViewUp );
-
-#if HELIUM_SIMD_SSE
-    Simd::Vector3Soa points;
-
-    points.m_x = Helium::Simd::LoadAligned( shadowFrustumPointsX );
-    points.m_y = Helium::Simd::LoadAligned( shadowFrustumPointsY );
-    points.m_z = Helium::Simd::LoadAligned( shadowFrustumPointsZ );
-
-    Helium::Simd::Register projectedMinX = shadowViewXSoa.Dot( points );
-    Helium::Simd::Register projectedMinY = shadowViewYSoa.Dot( points );
-    Helium::Simd::Register projectedMaxX = projectedMinX;
-    Helium::Simd::Register projectedMaxY = projectedMinY;
-
-    points.m_x = Helium::Simd::LoadAligned( shadowFrustumPointsX + 4 );
-    points.m_y = Helium::Simd::LoadAligned( shadowFrustumPointsY + 4 );
-    points.m_z = Helium::Simd::LoadAligned( shadowFrustumPointsZ + 4 );
-
-    Helium::Simd::Register projectedX = shadowViewXSoa.Dot( points );
-    Helium::Simd::Register projectedY = shadowViewYSoa.Dot( points );
-
-    projectedMinX = Helium::Simd::MinF32( projectedMinX, projectedX );
-    projectedMinY = Helium::Simd::MinF32( projectedMinY, projectedY );
-    projectedMaxX = Helium::Simd::MaxF32( projectedMaxX, projectedX );
-    projectedMaxY = Helium::Simd::MaxF32( projectedMaxY, projectedY );
-
-    Helium::Simd::Register projectedMinXYLo = _mm_unpacklo_ps( projectedMinX, projectedMinY );
-    Helium::Simd::Register projectedMinXYHi = _mm_unpackhi_ps( projectedMinX, projectedMinY );
-    Helium::Simd::Register projectedMinXY = Helium::Simd::MinF32( projectedMinXYLo, projectedMinXYHi );
-    projectedMinXY = Helium::Simd::MinF32( projectedMinXY, _mm_movehl_ps( projectedMinXY, projectedMinXY ) );
-
-    Helium::Simd::Register projectedMaxXYLo = _mm_unpacklo_ps( projectedMaxX, projectedMaxY );
-    Helium::Simd::Register projectedMaxXYHi = _mm_unpackhi_ps( projectedMaxX, projectedMaxY );
-    Helium::Simd::Register projectedMaxXY = Helium::Simd::MaxF32( projectedMaxXYLo, projectedMaxXYHi );
-    projectedMaxXY = Helium::Simd::MaxF32( projectedMaxXY, _mm_movehl_ps( projectedMaxXY, projectedMaxXY ) );
-
-    Helium::Simd::Register halfVec = Helium::Simd::SetSplatF32( 0.5f );
-
-    Helium::Simd::Register projectedCenter = Helium::Simd::MultiplyF32(
-        Helium::Simd::AddF32( projectedMinXY, projectedMaxXY ),
-        halfVec );
-    Helium::Simd::Register projectedWidthHeight = Helium::Simd::SubtractF32( projectedMaxXY, projectedMinXY );
-
-    Helium::Simd::Register projectedCenterX = _mm_shuffle_ps(
-        projectedCenter,
-        projectedCenter,
-        _MM_SHUFFLE( 0, 0, 0, 0 ) );
-    Helium::Simd::Register projectedCenterY = _mm_shuffle_ps(
-        projectedCenter,
-        projectedCenter,
-        _MM_SHUFFLE( 1, 1, 1, 1 ) );
-    Helium::Simd::Register projectedCenterZ = Helium::Simd::SetSplatF32( -32767.0f );
-
-    Simd::Vector3 shadowViewOrigin = shadowViewRight * Simd::Vector3( projectedCenterX ) +
-        shadowViewUp * Simd::Vector3( projectedCenterY ) +
-        shadowViewForward * Simd::Vector3( projectedCenterZ );
-
-    HELIUM_SIMD_ALIGN_PRE float32_t shadowViewWidthHeight[ 4 ] HELIUM_SIMD_ALIGN_POST;
-    Helium::Simd::StoreAligned( shadowViewWidthHeight, projectedWidthHeight );
-
-    Simd::Matrix44 projection(
-        Simd::Matrix44::INIT_ORTHOGONAL_PROJECTION,
-        shadowViewWidthHeight[ 0 ],
-        shadowViewWidthHeight[ 1 ],
-        0.0f,
-        65536.0f );
-#else
-#error Implement for other SIMD architectures.
-#endif  // HELIUM_SIMD_SSE
-
-    // Compute the inverse view matrix.
-    Simd::Matrix44 inverseView(
-        RayToVector4( shadowViewRight ),
-        RayToVector4( shadowViewUp ),
-        RayToVector4( shadowViewForward ),
-        PointToVector4( shadowViewOrigin ) );
-    inverseView.Invert();
-
-    // Compute the combined inverse view/projection matrix.
-    m_shadowViewInverseViewProjectionMatrices[ viewIndex ].MultiplySet( inverseView, projection );
+    // Pair each corner on the near clip plane with the far corner along the same frustum edge, matching them up based
+    // on which side of the view axes they lie (this works for both perspective and orthographic views).
+    float32_t cornerDepths[ 8 ];
+    float32_t nearDepth = NumericLimits< float32_t >::Maximum;
+    float32_t farDepth = -NumericLimits< float32_t >::Maximum;
+    for( size_t cornerIndex = 0; cornerIndex < 8; ++cornerIndex )
+    {
+        Simd::Vector3 corner(
+            shadowFrustumPointsX[ cornerIndex ],
+            shadowFrustumPointsY[ cornerIndex ],
+            shadowFrustumPointsZ[ cornerIndex ] );
+        float32_t depth = viewForward.Dot( corner - viewOrigin );
+        cornerDepths[ cornerIndex ] = depth;
+        nearDepth = Min( nearDepth, depth );
+        farDepth = Max( farDepth, depth );
+    }
+
+    float32_t midDepth = ( nearDepth + farDepth ) * 0.5f;
+
+    Simd::Vector3 nearCorners[ 4 ];
+    Simd::Vector3 farCorners[ 4 ];
+    for( size_t cornerIndex = 0; cornerIndex < 8; ++cornerIndex )
+    {
+        Simd::Vector3 corner(
+            shadowFrustumPointsX[ cornerIndex ],
+            shadowFrustumPointsY[ cornerIndex ],
+            shadowFrustumPointsZ[ cornerIndex ] );
+        Simd::Vector3 offset = corner - viewOrigin;
+        size_t edgeIndex =
+            ( viewRight.Dot( offset ) >= 0.0f ? 1 : 0 ) | ( viewUp.Dot( offset ) >= 0.0f ? 2 : 0 );
+        if( cornerDepths[ cornerIndex ] < midDepth )
+        {
+            nearCorners[ edgeIndex ] = corner;
+        }
+        else
+        {
+            farCorners[ edgeIndex ] = corner;
+        }
+    }
+
+    // Compute the cascade split distances.
+    float32_t splitDepths[ GraphicsConfig::SHADOW_CASCADE_COUNT_MAX + 1 ];
+    splitDepths[ 0 ] = nearDepth;
+    splitDepths[ cascadeCount ] = farDepth;
+    for( uint32_t splitIndex = 1; splitIndex < cascadeCount; ++splitIndex )
+    {
+        float32_t splitFraction = static_cast< float32_t >( splitIndex ) / static_cast< float32_t >( cascadeCount );
+        float32_t uniformSplit = nearDepth + ( farDepth - nearDepth ) * splitFraction;
+        float32_t logSplit = uniformSplit;
+        if( nearDepth > HELIUM_EPSILON )
+        {
+            logSplit = nearDepth * powf( farDepth / nearDepth, splitFraction );
+        }
+
+        splitDepths[ splitIndex ] = uniformSplit + ( logSplit - uniformSplit ) * SHADOW_CASCADE_SPLIT_LOG_WEIGHT;
+    }
+
+    float32_t depthRange = Max( farDepth - nearDepth, HELIUM_EPSILON );
+
+    // Compute the placement of each cascade.
+    uint32_t shadowDepthTextureUsableSize =
+        RenderResourceManager::GetStaticInstance().GetShadowDepthTextureUsableSize();
+
+    ShadowCascade* pCascades = m_shadowCascades.GetData() + viewIndex * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX;
+    for( uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex )
+    {
+        ShadowCascade& rCascade = pCascades[ cascadeIndex ];
+
+        // Compute the bounding sphere of the view frustum slice covered by this cascade.
+        float32_t sliceStart = ( splitDepths[ cascadeIndex ] - nearDepth ) / depthRange;
+        float32_t sliceEnd = ( splitDepths[ cascadeIndex + 1 ] - nearDepth ) / depthRange;
+
+        Simd::Vector3 slicePoints[ 8 ];
+        Simd::Vector3 sliceCenter( 0.0f, 0.0f, 0.0f );
+        for( size_t edgeIndex = 0; edgeIndex < 4; ++edgeIndex )
+        {
+            Simd::Vector3 edge = farCorners[ edgeIndex ] - nearCorners[ edgeIndex ];
+            slicePoints[ edgeIndex ] = nearCorners[ edgeIndex ] + edge * sliceStart;
+            slicePoints[ edgeIndex + 4 ] = nearCorners[ edgeIndex ] + edge * sliceEnd;
+            sliceCenter = sliceCenter + slicePoints[ edgeIndex ] + slicePoints[ edgeIndex + 4 ];
+        }
+
+        sliceCenter = sliceCenter * 0.125f;
+
+        float32_t sliceRadius = 0.0f;
+        for( size_t pointIndex = 0; pointIndex < 8; ++pointIndex )
+        {
+            sliceRadius = Max( sliceRadius, ( slicePoints[ pointIndex ] - sliceCenter ).GetMagnitude() );
+        }
+
+        sliceRadius =
+            ( Floor( sliceRadius / SHADOW_CASCADE_RADIUS_GRANULARITY ) + 1.0f ) * SHADOW_CASCADE_RADIUS_GRANULARITY;
+
+        // Snap the cascade placement to whole texels, or to a coarse grid for cascades that can be cached (cascades in
+        // the far half of the view, which cover large areas and are least affected by the extra coverage).
+        uint32_t tileX, tileY, tileSize;
+        GetShadowCascadeTile( shadowDepthTextureUsableSize, cascadeCount, cascadeIndex, tileX, tileY, tileSize );
+        tileSize = Max( tileSize, static_cast< uint32_t >( 1 ) );
+
+        bool bCacheable = ( cascadeIndex >= ( cascadeCount + 1 ) / 2 );
+
+        float32_t extent = sliceRadius * 2.0f;
+        float32_t snapStep = extent / static_cast< float32_t >( tileSize );
+        if( bCacheable )
+        {
+            extent *= SHADOW_CASCADE_CACHED_EXTENT_SCALE;
+            snapStep = extent / static_cast< float32_t >( SHADOW_CASCADE_CACHED_SNAP_STEPS );
+        }
+
+        float32_t centerX = shadowViewRight.Dot( sliceCenter );
+        float32_t centerY = shadowViewUp.Dot( sliceCenter );
+        centerX = Floor( centerX / snapStep + 0.5f ) * snapStep;
+        centerY = Floor( centerY / snapStep + 0.5f ) * snapStep;
+
+        Simd::Vector3 shadowViewOrigin = shadowViewRight * centerX + shadowViewUp * centerY +
+            shadowViewForward * -SHADOW_VIEW_DEPTH_OFFSET;
+
+        Simd::Matrix44 projection(
+            Simd::Matrix44::INIT_ORTHOGONAL_PROJECTION,
+            extent,
+            extent,
+            0.0f,
+            SHADOW_VIEW_DEPTH_RANGE );
+
+        // Compute the inverse view matrix.
+        Simd::Matrix44 inverseView(
+            RayToVector4( shadowViewRight ),
+            RayToVector4( shadowViewUp ),
+            RayToVector4( shadowViewForward ),
+            PointToVector4( shadowViewOrigin ) );
+        inverseView.Invert();
+
+        // Compute the combined inverse view/projection matrix.
+        rCascade.inverseViewProjection.MultiplySet( inverseView, projection );
+        rCascade.centerX = centerX;
+        rCascade.centerY = centerY;
+        rCascade.extent = extent;
+        rCascade.bCacheable = bCacheable;
+    }
 }
 
-/// Update the shadow depth pass inverse view/projection matrix for a given scene view, using light-space
-/// perspective shadow mapping.
+/// Invalidate all cached shadow cascade tiles, forcing them to be rendered again the next time they are used.
 ///
-/// @param[in] viewIndex  Index of the scene view for which to update the shadow depth pass transform matrix.
-void GraphicsScene::UpdateShadowInverseViewProjectionMatrixLspsm( size_t viewIndex )
+/// @see DrawShadowDepthPass()
+void GraphicsScene::InvalidateShadowCascadeCache()
 {
-    HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
-    HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
-    HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
-
-    // XXX TMC TODO: Implement!!
-    UpdateShadowInverseViewProjectionMatrixSimple( viewIndex );
+    for( size_t cascadeIndex = 0; cascadeIndex < HELIUM_ARRAY_COUNT( m_shadowCascadeCache ); ++cascadeIndex )
+    {
+        m_shadowCascadeCache[ cascadeIndex ].bValid = false;
+    }
 }
 
 /// Swap the dynamic constant buffers for view and instance data and push the current frame's data into the new
@@ -587,10 +865,12 @@ void GraphicsScene::SwapDynamicConstantBuffers()
         return;
     }
 
-    // Pre-compute the inverse shadow map resolution and the transformation matrix from shadow view projection to UV
-    // space for use when applying shadows to the scene.
+    // Pre-compute the inverse shadow map resolution, the transformation matrix from shadow view projection to the
+    // first cascade's normalized [0, 1] coordinate space, and the placement of each cascade tile within the shadow
+    // depth texture for use when applying shadows to the scene.
     float32_t inverseShadowMapResolutionX = 1.0f;
     float32_t inverseShadowMapResolutionY = 1.0f;
+    float32_t shadowCascadeBorder = 0.0f;
 
     Simd::Matrix44 shadowMapUvTransform(
         Simd::Vector4( 0.5f,  0.0f, 0.0f, 0.0f ),
@@ -598,6 +878,10 @@ void GraphicsScene::SwapDynamicConstantBuffers()
         Simd::Vector4( 0.0f,  0.0f, 1.0f, 0.0f ),
         Simd::Vector4( 0.5f,  0.5f, 0.0f, 1.0f ) );
 
+    uint32_t shadowCascadeCount = 0;
+    float32_t shadowCascadeTiles[ GraphicsConfig::SHADOW_CASCADE_COUNT_MAX ][ 4 ];
+    MemoryZero( shadowCascadeTiles, sizeof( shadowCascadeTiles ) );
+
     RenderResourceManager& rRenderResourceManager = RenderResourceManager::GetStaticInstance();
     RTexture2d* pShadowDepthTexture = rRenderResourceManager.GetShadowDepthTexture();
     if( pShadowDepthTexture )
@@ -605,18 +889,24 @@ void GraphicsScene::SwapDynamicConstantBuffers()
         inverseShadowMapResolutionX = 1.0f / static_cast< float32_t >( pShadowDepthTexture->GetWidth() );
         inverseShadowMapResolutionY = 1.0f / static_cast< float32_t >( pShadowDepthTexture->GetHeight() );
 
-        float32_t shadowMapUsableSize =
-            static_cast< float32_t >( rRenderResourceManager.GetShadowDepthTextureUsableSize() );
-        float32_t shadowMapUsableX = shadowMapUsableSize * inverseShadowMapResolutionX;
-        float32_t shadowMapUsableY = shadowMapUsableSize * inverseShadowMapResolutionY;
+        uint32_t shadowMapUsableSize = rRenderResourceManager.GetShadowDepthTextureUsableSize();
+        shadowCascadeCount = m_shadowCascadeCount;
+        for( uint32_t cascadeIndex = 0; cascadeIndex < shadowCascadeCount; ++cascadeIndex )
+        {
+            uint32_t tileX, tileY, tileSize;
+            GetShadowCascadeTile( shadowMapUsableSize, shadowCascadeCount, cascadeIndex, tileX, tileY, tileSize );
 
-        float32_t halfShadowMapUsableX = shadowMapUsableX * 0.5f;
-        float32_t negHalfShadowMapUsableY = shadowMapUsableY * -0.5f;
+            float32_t* pTile = shadowCascadeTiles[ cascadeIndex ];
+            pTile[ 0 ] = static_cast< float32_t >( tileSize ) * inverseShadowMapResolutionX;
+            pTile[ 1 ] = static_cast< float32_t >( tileSize ) * inverseShadowMapResolutionY;
+            pTile[ 2 ] = static_cast< float32_t >( tileX ) * inverseShadowMapResolutionX;
+            pTile[ 3 ] = static_cast< float32_t >( tileY ) * inverseShadowMapResolutionY;
 
-        shadowMapUvTransform.SetElement( 0, halfShadowMapUsableX );
-        shadowMapUvTransform.SetElement( 5, negHalfShadowMapUsableY );
-        shadowMapUvTransform.SetElement( 12, halfShadowMapUsableX );
-        shadowMapUvTransform.SetElement( 13, negHalfShadowMapUsableY + 1.0f );
+            if( tileSize != 0 )
+            {
+                shadowCascadeBorder = SHADOW_CASCADE_BORDER_TEXELS / static_cast< float32_t >( tileSize );
+            }
+        }
     }
 
     // Swap buffer sets.
@@ -635,7 +925,6 @@ void GraphicsScene::SwapDynamicConstantBuffers()
     HELIUM_ASSERT( rViewVertexBasePassDataBuffers.GetSize() == viewBufferCount );
     HELIUM_ASSERT( rViewVertexScreenDataBuffers.GetSize() == viewBufferCount );
     HELIUM_ASSERT( rViewPixelBasePassDataBuffers.GetSize() == viewBufferCount );
-    HELIUM_ASSERT( rShadowViewVertexDataBuffers.GetSize() == viewBufferCount );
     if( viewBufferCount < sceneViewCount )
     {
         size_t additionalBufferCount = sceneViewCount - viewBufferCount;
@@ -643,7 +932,13 @@ void GraphicsScene::SwapDynamicConstantBuffers()
         rViewVertexBasePassDataBuffers.Add( NULL, additionalBufferCount );
         rViewVertexScreenDataBuffers.Add( NULL, additionalBufferCount );
         rViewPixelBasePassDataBuffers.Add( NULL, additionalBufferCount );
-        rShadowViewVertexDataBuffers.Add( NULL, additionalBufferCount );
+    }
+
+    size_t shadowViewBufferCount = rShadowViewVertexDataBuffers.GetSize();
+    size_t shadowViewBufferCountNeeded = sceneViewCount * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX;
+    if( shadowViewBufferCount < shadowViewBufferCountNeeded )
+    {
+        rShadowViewVertexDataBuffers.Add( NULL, shadowViewBufferCountNeeded - shadowViewBufferCount );
     }
 
     for( size_t viewIndex = 0; viewIndex < sceneViewCount; ++viewIndex )
@@ -736,11 +1031,16 @@ void GraphicsScene::SwapDynamicConstantBuffers()
             float32_t* pMappedData = static_cast< float32_t* >( spBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
             HELIUM_ASSERT( pMappedData );
 
-            HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
-            Simd::Matrix44 shadowViewInvViewProj;
-            shadowViewInvViewProj.MultiplySet(
-                m_shadowViewInverseViewProjectionMatrices[ viewIndex ],
-                shadowMapUvTransform );
+            // Shadow coordinates are computed relative to the first cascade, with the pixel shader selecting and
+            // offsetting into the appropriate cascade tile.
+            Simd::Matrix44 shadowViewInvViewProj = shadowMapUvTransform;
+            if( shadowCascadeCount != 0 )
+            {
+                HELIUM_ASSERT( viewIndex * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX < m_shadowCascades.GetSize() );
+                shadowViewInvViewProj.MultiplySet(
+                    m_shadowCascades[ viewIndex * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX ].inverseViewProjection,
+                    shadowMapUvTransform );
+            }
 
             GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
             const Simd::Matrix44& rInverseViewMatrix = rView.GetInverseViewMatrix();
@@ -835,7 +1135,7 @@ void GraphicsScene::SwapDynamicConstantBuffers()
         spBuffer = rViewPixelBasePassDataBuffers[ viewIndex ];
         if( !spBuffer )
         {
-            spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 16, RENDERER_BUFFER_USAGE_DYNAMIC );
+            spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 56, RENDERER_BUFFER_USAGE_DYNAMIC );
             if( !spBuffer )
             {
                 HELIUM_TRACE(
@@ -869,35 +1169,103 @@ void GraphicsScene::SwapDynamicConstantBuffers()
 
             *( pMappedData++ ) = inverseShadowMapResolutionX;
             *( pMappedData++ ) = inverseShadowMapResolutionY;
+            *( pMappedData++ ) = shadowCascadeBorder;
+            *( pMappedData++ ) = 1.0f - shadowCascadeBorder;
+
+            // Transform from the first cascade's normalized coordinates to each cascade's normalized coordinates
+            // (unused cascades map everything out of range).
+            const ShadowCascade* pCascades =
+                m_shadowCascades.GetData() + viewIndex * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX;
+            for( uint32_t cascadeIndex = 0; cascadeIndex < GraphicsConfig::SHADOW_CASCADE_COUNT_MAX; ++cascadeIndex )
+            {
+                if( cascadeIndex < shadowCascadeCount )
+                {
+                    const ShadowCascade& rBaseCascade = pCascades[ 0 ];
+                    const ShadowCascade& rCascade = pCascades[ cascadeIndex ];
+
+                    float32_t scale = rBaseCascade.extent / rCascade.extent;
+                    float32_t inverseExtent = 1.0f / rCascade.extent;
+                    float32_t offset = 0.5f - 0.5f * scale;
+
+                    pMappedData[ 0 ] = scale;
+                    pMappedData[ 1 ] = scale;
+                    pMappedData[ 2 ] = offset + ( rBaseCascade.centerX - rCascade.centerX ) * inverseExtent;
+                    pMappedData[ 3 ] = offset - ( rBaseCascade.centerY - rCascade.centerY ) * inverseExtent;
+                }
+                else
+                {
+                    pMappedData[ 0 ] = 0.0f;
+                    pMappedData[ 1 ] = 0.0f;
+                    pMappedData[ 2 ] = -1.0f;
+                    pMappedData[ 3 ] = -1.0f;
+                }
+
+                pMappedData += 4;
+            }
+
+            // Placement of each cascade tile within the shadow depth texture.
+            for( uint32_t cascadeIndex = 0; cascadeIndex < GraphicsConfig::SHADOW_CASCADE_COUNT_MAX; ++cascadeIndex )
+            {
+                const float32_t* pTile = shadowCascadeTiles[ cascadeIndex ];
+                pMappedData[ 0 ] = pTile[ 0 ];
+                pMappedData[ 1 ] = pTile[ 1 ];
+                pMappedData[ 2 ] = pTile[ 2 ];
+                pMappedData[ 3 ] = pTile[ 3 ];
+
+                pMappedData += 4;
+            }
+
+            // Projection and depth slicing parameters for locating the light cluster containing each pixel.
+            GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
+            const Simd::Matrix44& rProjectionMatrix = rView.GetProjectionMatrix();
+
+            float32_t lightClusterSliceScale, lightClusterSliceBias;
+            LightClusterGrid::ComputeSliceParameters(
+                rView.GetNearClip(),
+                rView.GetFarClip(),
+                lightClusterSliceScale,
+                lightClusterSliceBias );
+
+            *( pMappedData++ ) = rProjectionMatrix.GetElement( 0 );
+            *( pMappedData++ ) = rProjectionMatrix.GetElement( 5 );
+            *( pMappedData++ ) = rProjectionMatrix.GetElement( 11 );
+            *( pMappedData++ ) = rProjectionMatrix.GetElement( 15 );
+
+            *( pMappedData++ ) = lightClusterSliceScale;
+            *( pMappedData++ ) = lightClusterSliceBias;
             *( pMappedData++ ) = 0.0f;
             *pMappedData       = 0.0f;
 
             spBuffer->Unmap();
         }
 
-        // Update the shadow depth pass vertex shader constants.
-        spBuffer = rShadowViewVertexDataBuffers[ viewIndex ];
-        if( !spBuffer )
+        // Update the shadow depth pass vertex shader constants for each cascade.
+        for( uint32_t cascadeIndex = 0; cascadeIndex < shadowCascadeCount; ++cascadeIndex )
         {
-            spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 32, RENDERER_BUFFER_USAGE_DYNAMIC );
+            size_t shadowViewBufferIndex = viewIndex * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX + cascadeIndex;
+            spBuffer = rShadowViewVertexDataBuffers[ shadowViewBufferIndex ];
             if( !spBuffer )
             {
-                HELIUM_TRACE(
-                    TraceLevels::Error,
-                    ( TXT( "GraphicsScene::SwapDynamicConstantBuffers(): Shadow view vertex data constant buffer " )
-                    TXT( "creation failed!\n" ) ) );
-            }
+                spBuffer = pRenderer->CreateConstantBuffer( sizeof( float32_t ) * 32, RENDERER_BUFFER_USAGE_DYNAMIC );
+                if( !spBuffer )
+                {
+                    HELIUM_TRACE(
+                        TraceLevels::Error,
+                        ( TXT( "GraphicsScene::SwapDynamicConstantBuffers(): Shadow view vertex data constant " )
+                        TXT( "buffer creation failed!\n" ) ) );
 
-            rShadowViewVertexDataBuffers[ viewIndex ] = spBuffer;
-        }
+                    continue;
+                }
+
+                rShadowViewVertexDataBuffers[ shadowViewBufferIndex ] = spBuffer;
+            }
 
-        if( spBuffer )
-        {
             float32_t* pMappedData = static_cast< float32_t* >( spBuffer->Map( RENDERER_BUFFER_MAP_HINT_DISCARD ) );
             HELIUM_ASSERT( pMappedData );
 
-            HELIUM_ASSERT( viewIndex < m_shadowViewInverseViewProjectionMatrices.GetSize() );
-            const Simd::Matrix44& rShadowViewInvViewProj = m_shadowViewInverseViewProjectionMatrices[ viewIndex ];
+            HELIUM_ASSERT( shadowViewBufferIndex < m_shadowCascades.GetSize() );
+            const Simd::Matrix44& rShadowViewInvViewProj =
+                m_shadowCascades[ shadowViewBufferIndex ].inverseViewProjection;
 
             *( pMappedData++ ) = rShadowViewInvViewProj.GetElement( 0 );
             *( pMappedData++ ) = rShadowViewInvViewProj.GetElement( 4 );
@@ -1134,6 +1502,8 @@ void GraphicsScene::SwapDynamicConstantBuffers()
 ///                       of the scene view sparse array).
 void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 {
+    HELIUM_FRAME_PROFILE_SCOPE( "GraphicsScene::DrawSceneView" );
+
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
 
     if( !m_sceneViews.IsElementValid( viewIndex ) )
@@ -1160,7 +1530,21 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 
     const Simd::Frustum& rViewFrustum = rView.GetFrustum();
 
+    const Simd::Vector3& rViewOrigin = rView.GetOrigin();
+    float32_t halfFovTangent = Tan( rView.GetHorizontalFov() * static_cast< float32_t >( HELIUM_DEG_TO_RAD ) * 0.5f );
+    halfFovTangent = Max( halfFovTangent, HELIUM_EPSILON );
+
+    HELIUM_ASSERT( viewIndex < m_viewSceneObjectLods.GetSize() );
+    DynamicArray< uint8_t >& rSceneObjectLods = m_viewSceneObjectLods[ viewIndex ];
+
+    // Visible occluders with the largest projected size, sorted from largest to smallest.
+    bool bOcclusionCulling = RenderResourceManager::GetStaticInstance().GetOcclusionCullingEnabled();
+    size_t occluderIndices[ OCCLUDER_COUNT_MAX ];
+    float32_t occluderScreenSizes[ OCCLUDER_COUNT_MAX ];
+    size_t occluderCount = 0;
+
     size_t sceneObjectCount = m_sceneObjects.GetSize();
+    HELIUM_ASSERT( sceneObjectCount <= rSceneObjectLods.GetSize() );
     for( size_t sceneObjectIndex = 0; sceneObjectIndex < sceneObjectCount; ++sceneObjectIndex )
     {
         if( m_sceneObjects.IsElementValid( sceneObjectIndex ) )
@@ -1170,27 +1554,161 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
             if( rViewFrustum.Intersects( rObjectBounds ) )
             {
                 m_visibleSceneObjects.SetElement( sceneObjectIndex );
+
+                const GraphicsSceneObject& rSceneObject = m_sceneObjects[ sceneObjectIndex ];
+                bool bOccluder = ( bOcclusionCulling && rSceneObject.IsOccluder() );
+                if( rSceneObject.GetLodCount() <= 1 && !bOccluder )
+                {
+                    rSceneObjectLods[ sceneObjectIndex ] = 0;
+
+                    continue;
+                }
+
+                Simd::Vector3 offset = rObjectBounds.GetCenter() - rViewOrigin;
+                float32_t distance = offset.GetMagnitude();
+                float32_t screenSize = ( distance > HELIUM_EPSILON
+                    ? rObjectBounds.GetRadius() / ( distance * halfFovTangent )
+                    : NumericLimits< float32_t >::Maximum );
+
+                // Select the level of detail to render based on the projected size of the object's bounds.
+                uint8_t& rLod = rSceneObjectLods[ sceneObjectIndex ];
+                rLod = rSceneObject.SelectLod( screenSize, rLod, LOD_SCREEN_SIZE_HYSTERESIS );
+
+                // Keep track of the largest occluders in view.
+                if( bOccluder && screenSize >= OCCLUDER_SCREEN_SIZE_MIN &&
+                    ( occluderCount < OCCLUDER_COUNT_MAX || screenSize > occluderScreenSizes[ occluderCount - 1 ] ) )
+                {
+                    size_t insertIndex = Min( occluderCount, OCCLUDER_COUNT_MAX - 1 );
+                    for( ; insertIndex > 0 && occluderScreenSizes[ insertIndex - 1 ] < screenSize; --insertIndex )
+                    {
+                        occluderIndices[ insertIndex ] = occluderIndices[ insertIndex - 1 ];
+                        occluderScreenSizes[ insertIndex ] = occluderScreenSizes[ insertIndex - 1 ];
+                    }
+
+                    occluderIndices[ insertIndex ] = sceneObjectIndex;
+                    occluderScreenSizes[ insertIndex ] = screenSize;
+                    occluderCount = Min( occluderCount + 1, OCCLUDER_COUNT_MAX );
+                }
+            }
+        }
+    }
+
+    // Rasterize the occluders into a low-resolution depth buffer and cull any other visible objects whose bounds are
+    // completely hidden behind them.
+    uint32_t occlusionTestedCount = 0;
+    uint32_t occlusionRejectedCount = 0;
+    if( occluderCount != 0 && ( m_occlusionBuffer.IsInitialized() || m_occlusionBuffer.Initialize() ) )
+    {
+        HELIUM_FRAME_PROFILE_SCOPE( "GraphicsScene::OcclusionCulling" );
+
+        m_occlusionBuffer.Clear( rView.GetInverseViewProjectionMatrix() );
+        for( size_t occluderIndex = 0; occluderIndex < occluderCount; ++occluderIndex )
+        {
+            const GraphicsSceneObject& rOccluder = m_sceneObjects[ occluderIndices[ occluderIndex ] ];
+            m_occlusionBuffer.RasterizeOccluder( rOccluder.GetOccluderBox(), rOccluder.GetTransform() );
+        }
+
+        for( size_t sceneObjectIndex = 0; sceneObjectIndex < sceneObjectCount; ++sceneObjectIndex )
+        {
+            if( !m_visibleSceneObjects[ sceneObjectIndex ] )
+            {
+                continue;
+            }
+
+            // Occluders are never tested against themselves, as their boxes may coincide with their bounds.
+            size_t occluderIndex = 0;
+            while( occluderIndex < occluderCount && occluderIndices[ occluderIndex ] != sceneObjectIndex )
+            {
+                ++occluderIndex;
+            }
+
+            if( occluderIndex < occluderCount )
+            {
+                continue;
+            }
+
+            ++occlusionTestedCount;
+            if( !m_occlusionBuffer.IsVisible( m_sceneObjects[ sceneObjectIndex ].GetWorldBox() ) )
+            {
+                m_visibleSceneObjects.UnsetElement( sceneObjectIndex );
+                ++occlusionRejectedCount;
             }
         }
+
+        HELIUM_FRAME_PROFILE_COUNTER_ADD( "OcclusionTested", static_cast< int32_t >( occlusionTestedCount ) );
+        HELIUM_FRAME_PROFILE_COUNTER_ADD( "OcclusionRejected", static_cast< int32_t >( occlusionRejectedCount ) );
     }
 
-    // Build a list of indices for each visible sub-mesh for sorting.
-    m_sceneObjectSubMeshIndices.Resize( 0 );
+    rView.SetOcclusionStats(
+        static_cast< uint32_t >( occluderCount ),
+        occlusionTestedCount,
+        occlusionRejectedCount );
+
+    // Assign the local lights visible in this view to light clusters for the base pass.
+    UpdateLightClusters( viewIndex );
+
+    // Build the sort keys for the depth-only pre-pass (front to back) and the base pass (by shaders and material,
+    // then front to back) in a single sweep over the visible sub-meshes, and sort both passes together.
+    m_drawSortList.Clear();
+    m_vertexShaderRanks.Clear();
+    m_pixelShaderRanks.Clear();
+    m_materialRanks.Clear();
+
+    const Simd::Vector3& rViewOrigin = rView.GetOrigin();
+    const Simd::Vector3& rViewForward = rView.GetForward();
 
     size_t subMeshCount = m_sceneObjectSubMeshes.GetSize();
     for( size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex )
     {
-        if( m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) )
+        if( !m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) )
         {
-            size_t sceneObjectId = m_sceneObjectSubMeshes[ subMeshIndex ].GetSceneObjectId();
-            HELIUM_ASSERT( sceneObjectId < m_visibleSceneObjects.GetSize() );
-            if( m_visibleSceneObjects[ sceneObjectId ] )
-            {
-                m_sceneObjectSubMeshIndices.Push( subMeshIndex );
-            }
+            continue;
+        }
+
+        const GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ subMeshIndex ];
+        size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
+        HELIUM_ASSERT( sceneObjectId < m_visibleSceneObjects.GetSize() );
+        if( !m_visibleSceneObjects[ sceneObjectId ] )
+        {
+            continue;
         }
+
+        HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+        const GraphicsSceneObject& rSceneObject = m_sceneObjects[ sceneObjectId ];
+
+        Simd::Vector3 objectPos = Simd::Vector4ToVector3( rSceneObject.GetTransform().GetRow( 3 ) );
+        float32_t depth = ( objectPos - rViewOrigin ).Dot( rViewForward );
+        bool bSkinned = ( rSceneObject.GetBoneCount() != 0 && rSceneObject.GetBonePalette() );
+
+        uint32_t vertexShaderRank = 0;
+        uint32_t pixelShaderRank = 0;
+        uint32_t materialRank = 0;
+
+        Material* pMaterial = rSubMeshData.GetMaterial();
+        if( pMaterial )
+        {
+            vertexShaderRank = m_vertexShaderRanks.GetRank( pMaterial->GetShaderVariant( RShader::TYPE_VERTEX ) );
+            pixelShaderRank = m_pixelShaderRanks.GetRank( pMaterial->GetShaderVariant( RShader::TYPE_PIXEL ) );
+            materialRank = m_materialRanks.GetRank( pMaterial );
+        }
+
+        uint32_t sortSubMeshIndex = static_cast< uint32_t >( subMeshIndex );
+        m_drawSortList.Add(
+            DrawSortList::MakeKey( DrawSortList::PASS_DEPTH_PRE, 0, 0, bSkinned, 0, depth ),
+            sortSubMeshIndex );
+        m_drawSortList.Add(
+            DrawSortList::MakeKey(
+                DrawSortList::PASS_BASE,
+                vertexShaderRank,
+                pixelShaderRank,
+                bSkinned,
+                materialRank,
+                depth ),
+            sortSubMeshIndex );
     }
 
+    m_drawSortList.Sort();
+
     // Get the renderer interface and the main command proxy for the renderer.
     Renderer* pRenderer = Renderer::GetStaticInstance();
     HELIUM_ASSERT( pRenderer );
@@ -1343,85 +1861,358 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
 
     spCommandProxy->EndScene();
 
+    // Report how many of this frame's state binds reached the renderer.
+    RStateFilterCommandProxy* pCommandFilter = pRenderer->GetImmediateCommandFilter();
+    if( pCommandFilter )
+    {
+        HELIUM_FRAME_PROFILE_COUNTER_ADD(
+            "StateBindsIssued", static_cast< int32_t >( pCommandFilter->GetIssuedBindCount() ) );
+        HELIUM_FRAME_PROFILE_COUNTER_ADD(
+            "StateBindsFiltered", static_cast< int32_t >( pCommandFilter->GetFilteredBindCount() ) );
+        pCommandFilter->ResetBindCounts();
+    }
+
     spCommandProxy->UnbindResources();
 
     pRenderContext->Swap();
 }
 
-/// Draw the shadow depth render pass.
+/// Assign the local lights visible in a given scene view to light clusters and upload the cluster data for the base
+/// pass.
 ///
-/// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
-///   meshes.  This function will sort by depth if rendering is performed.
-/// - Default rasterizer and depth states should be already set.
+/// Lights are culled against the view frustum before being assigned to clusters, and only the lights that pass are
+/// uploaded, so the cost of both the assignment and the shading in the base pass scales with the number of visible
+/// lights.  If more lights are visible than the grid can hold, the grid keeps those with the largest projected size.
+/// Light positions and directions are uploaded in view space.
 ///
-/// @param[in] viewIndex  Index of the view for which the shadow depth pass is being rendered.
+/// @param[in] viewIndex  Index of the scene view for which to update the light clusters.
 ///
-/// @see DrawDepthPrePass(), DrawBasePass()
-void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
+/// @see DrawBasePass()
+void GraphicsScene::UpdateLightClusters( uint_fast32_t viewIndex )
 {
+    HELIUM_FRAME_PROFILE_SCOPE( "GraphicsScene::UpdateLightClusters" );
+
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
     HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
 
-    RenderResourceManager& rRenderResourceManager = RenderResourceManager::GetStaticInstance();
+    m_clusteredLightCount = 0;
 
-    // Check whether shadows are enabled.
-    GraphicsConfig::EShadowMode shadowMode = rRenderResourceManager.GetShadowMode();
-    if( shadowMode == GraphicsConfig::EShadowMode::INVALID || shadowMode == GraphicsConfig::EShadowMode::NONE )
+    size_t sceneLightCount = m_sceneLights.GetSize();
+    if( sceneLightCount == 0 )
     {
         return;
     }
 
-    // Make sure the pre-pass vertex shader resources exist.
-    ShaderVariant* pPrePassVertexShaderVariant = rRenderResourceManager.GetPrePassVertexShader();
-    if( !pPrePassVertexShaderVariant )
-    {
-        return;
-    }
+    GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
+    const Simd::Frustum& rViewFrustum = rView.GetFrustum();
+    const Simd::Matrix44& rInverseViewMatrix = rView.GetInverseViewMatrix();
 
-    Shader* pPrePassShader = pPrePassVertexShaderVariant->GetShader();
-    HELIUM_ASSERT( pPrePassShader );
-    const Shader::Options& rPrePassShaderSysOptions = pPrePassShader->GetSystemOptions();
+    // Assign each visible light to the clusters it overlaps.
+    m_lightClusterGrid.Begin( rView.GetProjectionMatrix(), rView.GetNearClip(), rView.GetFarClip() );
 
-    Shader::SelectPair optionSelectPair = Shader::SelectPair( GetSkinningSysSelectName(), GetNoneOptionName() );
-    size_t optionSetIndex = rPrePassShaderSysOptions.GetOptionSetIndex(
-        RShader::TYPE_VERTEX,
-        NULL,
-        0,
-        &optionSelectPair,
-        1 );
-    RShader* pPrePassShaderResource = pPrePassVertexShaderVariant->GetRenderResource( optionSetIndex );
-    if( !pPrePassShaderResource )
+    m_lightClusterCandidateIds.Resize( 0 );
+
+    for( size_t lightIndex = 0; lightIndex < sceneLightCount; ++lightIndex )
     {
-        return;
-    }
+        if( !m_sceneLights.IsElementValid( lightIndex ) )
+        {
+            continue;
+        }
 
-    HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
-    RVertexShader* pPrePassNoSkinningVertexShader = static_cast< RVertexShader* >( pPrePassShaderResource );
+        const GraphicsSceneLight& rLight = m_sceneLights[ lightIndex ];
+        if( rLight.GetRadius() <= 0.0f || rLight.GetBrightness() <= 0.0f )
+        {
+            continue;
+        }
 
-    optionSelectPair.choice = GetSkinningSmoothOptionName();
-    optionSetIndex = rPrePassShaderSysOptions.GetOptionSetIndex(
+        if( !rViewFrustum.Intersects( rLight.GetWorldSphere() ) )
+        {
+            continue;
+        }
+
+        Simd::Vector3 viewPosition;
+        rInverseViewMatrix.TransformPoint( viewPosition, rLight.GetPosition() );
+        if( m_lightClusterGrid.AddLight( viewPosition, rLight.GetRadius() ) )
+        {
+            m_lightClusterCandidateIds.Push( lightIndex );
+        }
+    }
+
+    m_lightClusterGrid.End();
+
+    uint32_t clusteredLightCount = m_lightClusterGrid.GetLightCount();
+
+    HELIUM_FRAME_PROFILE_COUNTER_ADD( "LightsVisible", static_cast< int32_t >( clusteredLightCount ) );
+    HELIUM_FRAME_PROFILE_COUNTER_ADD(
+        "LightsDropped",
+        static_cast< int32_t >( m_lightClusterGrid.GetDroppedLightCount() ) );
+    HELIUM_FRAME_PROFILE_COUNTER_ADD(
+        "LightClusterEntries",
+        static_cast< int32_t >( m_lightClusterGrid.GetLightIndexCount() ) );
+
+    if( clusteredLightCount == 0 )
+    {
+        return;
+    }
+
+    // Create the light cluster textures the first time they are needed.
+    Renderer* pRenderer = Renderer::GetStaticInstance();
+    HELIUM_ASSERT( pRenderer );
+
+    if( !m_spLightClusterTexture )
+    {
+        m_spLightClusterTexture = pRenderer->CreateTexture2d(
+            LIGHT_CLUSTER_TEXTURE_WIDTH,
+            LIGHT_CLUSTER_TEXTURE_HEIGHT,
+            1,
+            RENDERER_PIXEL_FORMAT_R8G8B8A8,
+            RENDERER_BUFFER_USAGE_DYNAMIC );
+    }
+
+    if( !m_spLightIndexTexture )
+    {
+        m_spLightIndexTexture = pRenderer->CreateTexture2d(
+            LIGHT_INDEX_TEXTURE_WIDTH,
+            LIGHT_INDEX_TEXTURE_HEIGHT,
+            1,
+            RENDERER_PIXEL_FORMAT_R8,
+            RENDERER_BUFFER_USAGE_DYNAMIC );
+    }
+
+    if( !m_spLightDataTexture )
+    {
+        m_spLightDataTexture = pRenderer->CreateTexture2d(
+            LIGHT_DATA_TEXTURE_WIDTH,
+            LIGHT_DATA_TEXTURE_HEIGHT,
+            1,
+            RENDERER_PIXEL_FORMAT_R16G16B16A16_FLOAT,
+            RENDERER_BUFFER_USAGE_DYNAMIC );
+    }
+
+    if( !m_spLightClusterTexture || !m_spLightIndexTexture || !m_spLightDataTexture )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "GraphicsScene::UpdateLightClusters(): Light cluster texture creation failed!\n" ) );
+
+        return;
+    }
+
+    // Upload the offset (red and green) and light count (blue) of each cluster.
+    size_t pitch = 0;
+    uint8_t* pClusterTexels = static_cast< uint8_t* >(
+        m_spLightClusterTexture->Map( 0, pitch, RENDERER_BUFFER_MAP_HINT_DISCARD ) );
+    if( !pClusterTexels )
+    {
+        return;
+    }
+
+    const uint16_t* pClusterOffsets = m_lightClusterGrid.GetClusterOffsets();
+    const uint8_t* pClusterCounts = m_lightClusterGrid.GetClusterCounts();
+    for( uint32_t y = 0; y < LightClusterGrid::CLUSTER_COUNT_Y; ++y )
+    {
+        uint8_t* pTexel = pClusterTexels + y * pitch;
+        for( uint32_t z = 0; z < LightClusterGrid::CLUSTER_COUNT_Z; ++z )
+        {
+            for( uint32_t x = 0; x < LightClusterGrid::CLUSTER_COUNT_X; ++x, pTexel += 4 )
+            {
+                uint32_t clusterIndex = LightClusterGrid::GetClusterIndex( x, y, z );
+                uint16_t clusterOffset = pClusterOffsets[ clusterIndex ];
+
+                pTexel[ 0 ] = static_cast< uint8_t >( clusterOffset & 0xff );
+                pTexel[ 1 ] = static_cast< uint8_t >( clusterOffset >> 8 );
+                pTexel[ 2 ] = pClusterCounts[ clusterIndex ];
+                pTexel[ 3 ] = 0;
+            }
+        }
+    }
+
+    m_spLightClusterTexture->Unmap( 0 );
+
+    // Upload the light index list (only the rows referenced by any cluster).
+    uint8_t* pIndexTexels = static_cast< uint8_t* >(
+        m_spLightIndexTexture->Map( 0, pitch, RENDERER_BUFFER_MAP_HINT_DISCARD ) );
+    if( !pIndexTexels )
+    {
+        return;
+    }
+
+    const uint8_t* pLightIndices = m_lightClusterGrid.GetLightIndices();
+    uint32_t lightIndexCount = m_lightClusterGrid.GetLightIndexCount();
+    for( uint32_t rowStart = 0; rowStart < lightIndexCount; rowStart += LIGHT_INDEX_TEXTURE_WIDTH )
+    {
+        MemoryCopy(
+            pIndexTexels,
+            pLightIndices + rowStart,
+            Min( lightIndexCount - rowStart, LIGHT_INDEX_TEXTURE_WIDTH ) );
+        pIndexTexels += pitch;
+    }
+
+    m_spLightIndexTexture->Unmap( 0 );
+
+    // Upload the view-space position and inverse squared radius, color and spot cone offset, and view-space direction
+    // and spot cone scale of each light as half-precision floats.
+    uint8_t* pDataTexels = static_cast< uint8_t* >(
+        m_spLightDataTexture->Map( 0, pitch, RENDERER_BUFFER_MAP_HINT_DISCARD ) );
+    if( !pDataTexels )
+    {
+        return;
+    }
+
+    uint16_t* pPositionRow = reinterpret_cast< uint16_t* >( pDataTexels );
+    uint16_t* pColorRow = reinterpret_cast< uint16_t* >( pDataTexels + pitch );
+    uint16_t* pDirectionRow = reinterpret_cast< uint16_t* >( pDataTexels + pitch * 2 );
+
+    Float32 floatPacker;
+    for( uint32_t clusteredLightIndex = 0; clusteredLightIndex < clusteredLightCount; ++clusteredLightIndex )
+    {
+        size_t lightId = m_lightClusterCandidateIds[ m_lightClusterGrid.GetAddedLightIndex( clusteredLightIndex ) ];
+        const GraphicsSceneLight& rLight = m_sceneLights[ lightId ];
+
+        Simd::Vector3 viewPosition;
+        rInverseViewMatrix.TransformPoint( viewPosition, rLight.GetPosition() );
+
+        float32_t radius = Max( rLight.GetRadius(), LIGHT_RADIUS_MIN );
+        float32_t brightness = rLight.GetBrightness();
+        const Color& rColor = rLight.GetColor();
+
+        float32_t spotScale = 0.0f;
+        float32_t spotOffset = 1.0f;
+        Simd::Vector3 viewDirection( 0.0f, 0.0f, 1.0f );
+        if( rLight.GetType() == GraphicsSceneLight::TYPE_SPOT )
+        {
+            float32_t cosOuter = rLight.GetSpotCosOuter();
+            spotScale = 1.0f / Max( rLight.GetSpotCosInner() - cosOuter, LIGHT_SPOT_COS_RANGE_MIN );
+            spotOffset = -cosOuter * spotScale;
+            viewDirection = rInverseViewMatrix.TransformVector( rLight.GetDirection() );
+        }
+
+        const float32_t texelValues[ 3 ][ 4 ] =
+        {
+            {
+                viewPosition.GetElement( 0 ),
+                viewPosition.GetElement( 1 ),
+                viewPosition.GetElement( 2 ),
+                1.0f / ( radius * radius )
+            },
+            {
+                rColor.GetFloatR() * brightness,
+                rColor.GetFloatG() * brightness,
+                rColor.GetFloatB() * brightness,
+                spotOffset
+            },
+            {
+                viewDirection.GetElement( 0 ),
+                viewDirection.GetElement( 1 ),
+                viewDirection.GetElement( 2 ),
+                spotScale
+            }
+        };
+
+        uint16_t* pTexels[ 3 ] =
+        {
+            pPositionRow + clusteredLightIndex * 4,
+            pColorRow + clusteredLightIndex * 4,
+            pDirectionRow + clusteredLightIndex * 4
+        };
+
+        for( size_t rowIndex = 0; rowIndex < HELIUM_ARRAY_COUNT( pTexels ); ++rowIndex )
+        {
+            for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+            {
+                floatPacker.value = texelValues[ rowIndex ][ componentIndex ];
+                pTexels[ rowIndex ][ componentIndex ] = Float32To16( floatPacker ).packed;
+            }
+        }
+    }
+
+    m_spLightDataTexture->Unmap( 0 );
+
+    m_clusteredLightCount = clusteredLightCount;
+}
+
+/// Draw the shadow depth render pass.
+///
+/// Each shadow cascade is rendered into its own tile of the shadow depth texture, using all scene objects whose bounds
+/// overlap the cascade as shadow casters (not just those visible in the view).  The level of detail of each caster is
+/// selected here rather than reusing the one selected for the view, based on the caster's size relative to the
+/// smallest cascade it overlaps, so casters outside the view frustum never draw with a stale level of detail.  Cacheable cascades are skipped if the
+/// tile still holds the same cascade placement, light direction, and set of caster revisions that were last rendered
+/// into it and none of their casters are skinned, so far cascades containing only static geometry are only redrawn
+/// when the light, those casters, or the cascade placement changes.  Since the shadow depth texture is shared, cached
+/// tiles are also discarded whenever another scene renders into it (see
+/// RenderResourceManager::GetShadowDepthTextureGeneration()).
+///
+/// - Default rasterizer and depth states should be already set.
+///
+/// @param[in] viewIndex  Index of the view for which the shadow depth pass is being rendered.
+///
+/// @see DrawDepthPrePass(), DrawBasePass(), UpdateShadowCascades(), InvalidateShadowCascadeCache()
+void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
+{
+    HELIUM_FRAME_PROFILE_SCOPE( "GraphicsScene::DrawShadowDepthPass" );
+
+    HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
+    HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
+
+    RenderResourceManager& rRenderResourceManager = RenderResourceManager::GetStaticInstance();
+
+    // Check whether shadows are enabled.
+    GraphicsConfig::EShadowMode shadowMode = rRenderResourceManager.GetShadowMode();
+    if( shadowMode == GraphicsConfig::EShadowMode::INVALID || shadowMode == GraphicsConfig::EShadowMode::NONE )
+    {
+        return;
+    }
+
+    uint32_t cascadeCount = m_shadowCascadeCount;
+    if( cascadeCount == 0 )
+    {
+        return;
+    }
+
+    // Make sure the pre-pass vertex shader resources exist.
+    ShaderVariant* pPrePassVertexShaderVariant = rRenderResourceManager.GetPrePassVertexShader();
+    if( !pPrePassVertexShaderVariant )
+    {
+        return;
+    }
+
+    Shader* pPrePassShader = pPrePassVertexShaderVariant->GetShader();
+    HELIUM_ASSERT( pPrePassShader );
+    const Shader::Options& rPrePassShaderSysOptions = pPrePassShader->GetSystemOptions();
+
+    Shader::SelectPair optionSelectPair = Shader::SelectPair( GetSkinningSysSelectName(), GetNoneOptionName() );
+    size_t optionSetIndex = rPrePassShaderSysOptions.GetOptionSetIndex(
         RShader::TYPE_VERTEX,
         NULL,
         0,
         &optionSelectPair,
         1 );
-    pPrePassShaderResource = pPrePassVertexShaderVariant->GetRenderResource( optionSetIndex );
+    RShader* pPrePassShaderResource = pPrePassVertexShaderVariant->GetRenderResource( optionSetIndex );
     if( !pPrePassShaderResource )
     {
         return;
     }
 
     HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
-    RVertexShader* pPrePassSmoothSkinningVertexShader = static_cast< RVertexShader* >( pPrePassShaderResource );
+    RVertexShader* pPrePassNoSkinningVertexShader = static_cast< RVertexShader* >( pPrePassShaderResource );
 
-    // Make sure the shadow depth pass constant buffer exists.
-    RConstantBuffer* pShadowViewVertexDataBuffer =
-        m_shadowViewVertexDataBuffers[ m_constantBufferSetIndex ][ viewIndex ];
-    if( !pShadowViewVertexDataBuffer )
+    optionSelectPair.choice = GetSkinningSmoothOptionName();
+    optionSetIndex = rPrePassShaderSysOptions.GetOptionSetIndex(
+        RShader::TYPE_VERTEX,
+        NULL,
+        0,
+        &optionSelectPair,
+        1 );
+    pPrePassShaderResource = pPrePassVertexShaderVariant->GetRenderResource( optionSetIndex );
+    if( !pPrePassShaderResource )
     {
         return;
     }
 
+    HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
+    RVertexShader* pPrePassSmoothSkinningVertexShader = static_cast< RVertexShader* >( pPrePassShaderResource );
+
     // Retrieve the shadow depth texture resource (this should exist if shadows are enabled).
     RTexture2d* pShadowDepthTexture = rRenderResourceManager.GetShadowDepthTexture();
     HELIUM_ASSERT( pShadowDepthTexture );
@@ -1433,24 +2224,141 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
     RSurfacePtr spShadowDepthTextureSurface = pShadowDepthTexture->GetSurface( 0 );
     HELIUM_ASSERT( spShadowDepthTextureSurface );
 
-    // Sort meshes based on distance from front to back in order to reduce overdraw.
-    size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
+    // The shadow depth texture is shared by all scenes, so cached cascade tiles are only valid if no other scene has
+    // rendered into the texture (and the texture has not been recreated or lost) since this scene last claimed it.
+    if( rRenderResourceManager.GetShadowDepthTextureGeneration() != m_shadowCascadeCacheGeneration )
+    {
+        InvalidateShadowCascadeCache();
+    }
+
+    // Determine which cascades each scene object casts shadows into, building a signature of the casters in each
+    // cascade for detecting whether cached cascades need to be rendered again.
+    HELIUM_ASSERT( ( viewIndex + 1 ) * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX <= m_shadowCascades.GetSize() );
+    const ShadowCascade* pCascades = m_shadowCascades.GetData() + viewIndex * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX;
+
+    HELIUM_ASSERT( viewIndex < m_viewSceneObjectShadowLods.GetSize() );
+    DynamicArray< uint8_t >& rSceneObjectLods = m_viewSceneObjectShadowLods[ viewIndex ];
 
+    uint64_t casterSignatures[ GraphicsConfig::SHADOW_CASCADE_COUNT_MAX ];
+    bool dynamicCasterFlags[ GraphicsConfig::SHADOW_CASCADE_COUNT_MAX ];
+    for( uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex )
     {
-		SortJob< size_t, SubMeshFrontToBackCompare > job;
+        casterSignatures[ cascadeIndex ] =
+            ( SHADOW_CASTER_HASH_OFFSET_BASIS ^ m_sceneObjectSetRevision ) * SHADOW_CASTER_HASH_PRIME;
+        dynamicCasterFlags[ cascadeIndex ] = false;
+    }
+
+    size_t sceneObjectCount = m_sceneObjects.GetSize();
+    HELIUM_ASSERT( sceneObjectCount <= rSceneObjectLods.GetSize() );
 
-        SortJob< size_t, SubMeshFrontToBackCompare >::Parameters& rParameters = job.GetParameters();
-        rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-        rParameters.count = subMeshIndexCount;
-        rParameters.compare = SubMeshFrontToBackCompare(
-            m_directionalLightDirection,
-            m_sceneObjects,
-            m_sceneObjectSubMeshes );
-        rParameters.singleJobCount = 100;
+    m_shadowCasterCascadeMasks.Resize( 0 );
+    m_shadowCasterCascadeMasks.Add( 0, sceneObjectCount );
 
-		job.Run();
+    for( size_t sceneObjectIndex = 0; sceneObjectIndex < sceneObjectCount; ++sceneObjectIndex )
+    {
+        if( !m_sceneObjects.IsElementValid( sceneObjectIndex ) )
+        {
+            continue;
+        }
+
+        const GraphicsSceneObject& rSceneObject = m_sceneObjects[ sceneObjectIndex ];
+        const Simd::Sphere& rObjectBounds = rSceneObject.GetWorldSphere();
+        Simd::Vector3 objectCenter = rObjectBounds.GetCenter();
+        float32_t objectRadius = rObjectBounds.GetRadius();
+        float32_t objectX = m_shadowViewRight.Dot( objectCenter );
+        float32_t objectY = m_shadowViewUp.Dot( objectCenter );
+
+        bool bDynamic = ( rSceneObject.GetBoneCount() != 0 && rSceneObject.GetBonePalette() );
+
+        // Find the cascades overlapped by the object, along with its size relative to the smallest one.
+        uint8_t cascadeMask = 0;
+        float32_t screenSize = 0.0f;
+        for( uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex )
+        {
+            const ShadowCascade& rCascade = pCascades[ cascadeIndex ];
+            float32_t halfExtent = rCascade.extent * 0.5f;
+            float32_t reach = halfExtent + objectRadius;
+            if( Abs( objectX - rCascade.centerX ) > reach || Abs( objectY - rCascade.centerY ) > reach )
+            {
+                continue;
+            }
+
+            cascadeMask |= static_cast< uint8_t >( 1 << cascadeIndex );
+            screenSize = Max( screenSize, objectRadius / Max( halfExtent, HELIUM_EPSILON ) );
+        }
+
+        m_shadowCasterCascadeMasks[ sceneObjectIndex ] = cascadeMask;
+        if( !cascadeMask )
+        {
+            continue;
+        }
+
+        uint8_t& rLod = rSceneObjectLods[ sceneObjectIndex ];
+        rLod = rSceneObject.SelectLod( screenSize, rLod, LOD_SCREEN_SIZE_HYSTERESIS );
+
+        uint64_t objectKey = ( static_cast< uint64_t >( sceneObjectIndex ) << 40 ) ^
+            ( static_cast< uint64_t >( rSceneObject.GetRevision() ) << 8 ) ^ rLod;
+
+        for( uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex )
+        {
+            if( cascadeMask & ( 1 << cascadeIndex ) )
+            {
+                casterSignatures[ cascadeIndex ] =
+                    ( casterSignatures[ cascadeIndex ] ^ objectKey ) * SHADOW_CASTER_HASH_PRIME;
+                if( bDynamic )
+                {
+                    dynamicCasterFlags[ cascadeIndex ] = true;
+                }
+            }
+        }
     }
 
+    // Build the sort keys for all cascades in a single sweep over the sub-meshes, ordering each cascade's casters from
+    // front to back along the light direction in order to reduce overdraw.
+    HELIUM_COMPILE_ASSERT(
+        GraphicsConfig::SHADOW_CASCADE_COUNT_MAX <=
+        DrawSortList::PASS_SHADOW_DEPTH_LAST - DrawSortList::PASS_SHADOW_DEPTH_FIRST + 1 );
+
+    m_shadowDrawSortList.Clear();
+
+    size_t subMeshCount = m_sceneObjectSubMeshes.GetSize();
+    for( size_t subMeshIndex = 0; subMeshIndex < subMeshCount; ++subMeshIndex )
+    {
+        if( !m_sceneObjectSubMeshes.IsElementValid( subMeshIndex ) )
+        {
+            continue;
+        }
+
+        size_t sceneObjectId = m_sceneObjectSubMeshes[ subMeshIndex ].GetSceneObjectId();
+        HELIUM_ASSERT( sceneObjectId < m_shadowCasterCascadeMasks.GetSize() );
+        uint8_t cascadeMask = m_shadowCasterCascadeMasks[ sceneObjectId ];
+        if( !cascadeMask )
+        {
+            continue;
+        }
+
+        HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+        const GraphicsSceneObject& rSceneObject = m_sceneObjects[ sceneObjectId ];
+
+        Simd::Vector3 objectPos = Simd::Vector4ToVector3( rSceneObject.GetTransform().GetRow( 3 ) );
+        float32_t depth = objectPos.Dot( m_directionalLightDirection );
+        bool bSkinned = ( rSceneObject.GetBoneCount() != 0 && rSceneObject.GetBonePalette() );
+
+        for( uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex )
+        {
+            if( cascadeMask & ( 1 << cascadeIndex ) )
+            {
+                DrawSortList::EPass pass = static_cast< DrawSortList::EPass >(
+                    DrawSortList::PASS_SHADOW_DEPTH_FIRST + cascadeIndex );
+                m_shadowDrawSortList.Add(
+                    DrawSortList::MakeKey( pass, 0, 0, bSkinned, 0, depth ),
+                    static_cast< uint32_t >( subMeshIndex ) );
+            }
+        }
+    }
+
+    m_shadowDrawSortList.Sort();
+
     // Prepare the shadow depth pass scene for rendering.
     Renderer* pRenderer = Renderer::GetStaticInstance();
     HELIUM_ASSERT( pRenderer );
@@ -1464,7 +2372,6 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
     HELIUM_ASSERT( spSceneTextureSurface );
 
     spCommandProxy->SetRenderSurfaces( spSceneTextureSurface, spShadowDepthTextureSurface );
-    spCommandProxy->SetViewport( 0, 0, shadowDepthTextureUsableSize, shadowDepthTextureUsableSize );
 
     RRasterizerState* pRasterizerStateShadowDepth = rRenderResourceManager.GetRasterizerState(
         RenderResourceManager::RASTERIZER_STATE_SHADOW_DEPTH );
@@ -1474,103 +2381,187 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
         RenderResourceManager::BLEND_STATE_NO_COLOR );
     spCommandProxy->SetBlendState( pBlendStateNoColor );
 
-    // Draw the scene.
+    // Draw each cascade.
     spCommandProxy->BeginScene();
-    spCommandProxy->Clear( RENDERER_CLEAR_FLAG_DEPTH );
-
-    spCommandProxy->SetVertexConstantBuffers( 0, 1, &pShadowViewVertexDataBuffer );
     spCommandProxy->SetPixelShader( NULL );
 
     RVertexShader* pPreviousVertexShader = NULL;
 
-    for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+    float32_t lightDirection[ 3 ] =
     {
-        size_t meshIndex = m_sceneObjectSubMeshIndices[ meshIndexIndex ];
-        HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
-
-        GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ meshIndex ];
+        m_directionalLightDirection.GetElement( 0 ),
+        m_directionalLightDirection.GetElement( 1 ),
+        m_directionalLightDirection.GetElement( 2 )
+    };
 
-        size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
-        HELIUM_ASSERT( IsValid( sceneObjectId ) );
-        HELIUM_ASSERT( sceneObjectId < m_sceneObjects.GetSize() );
-        HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
+    for( uint32_t cascadeIndex = 0; cascadeIndex < cascadeCount; ++cascadeIndex )
+    {
+        const ShadowCascade& rCascade = pCascades[ cascadeIndex ];
+        ShadowCascadeCacheEntry& rCacheEntry = m_shadowCascadeCache[ cascadeIndex ];
+
+        uint32_t tileX, tileY, tileSize;
+        GetShadowCascadeTile( shadowDepthTextureUsableSize, cascadeCount, cascadeIndex, tileX, tileY, tileSize );
+
+        // Skip cascades whose cached contents are still valid.
+        bool bCacheable = ( rCascade.bCacheable && !dynamicCasterFlags[ cascadeIndex ] );
+        if( bCacheable &&
+            rCacheEntry.bValid &&
+            rCacheEntry.viewIndex == viewIndex &&
+            rCacheEntry.tileSize == tileSize &&
+            rCacheEntry.centerX == rCascade.centerX &&
+            rCacheEntry.centerY == rCascade.centerY &&
+            rCacheEntry.extent == rCascade.extent &&
+            rCacheEntry.lightDirection[ 0 ] == lightDirection[ 0 ] &&
+            rCacheEntry.lightDirection[ 1 ] == lightDirection[ 1 ] &&
+            rCacheEntry.lightDirection[ 2 ] == lightDirection[ 2 ] &&
+            rCacheEntry.casterSignature == casterSignatures[ cascadeIndex ] )
+        {
+            HELIUM_FRAME_PROFILE_COUNTER_ADD( "ShadowCascadesCached", 1 );
 
-        HELIUM_ASSERT( meshIndex < m_subMeshVertexGlobalDataBuffers.GetSize() );
-        RConstantBuffer* pInstanceVertexGlobalDataBuffer = m_subMeshVertexGlobalDataBuffers[ meshIndex ];
-        if( !pInstanceVertexGlobalDataBuffer )
-        {
-            HELIUM_ASSERT( sceneObjectId < m_objectVertexGlobalDataBuffers.GetSize() );
-            pInstanceVertexGlobalDataBuffer = m_objectVertexGlobalDataBuffers[ sceneObjectId ];
-            if( !pInstanceVertexGlobalDataBuffer )
-            {
-                continue;
-            }
+            continue;
         }
 
-        GraphicsSceneObject& rSceneObject = m_sceneObjects[ sceneObjectId ];
+        rCacheEntry.bValid = false;
 
-        RVertexBuffer* pVertexBuffer = rSceneObject.GetVertexBuffer();
-        if( !pVertexBuffer )
+        // Make sure the shadow depth pass constant buffer for this cascade exists.
+        RConstantBuffer* pShadowViewVertexDataBuffer = m_shadowViewVertexDataBuffers[ m_constantBufferSetIndex ][
+            viewIndex * GraphicsConfig::SHADOW_CASCADE_COUNT_MAX + cascadeIndex ];
+        if( !pShadowViewVertexDataBuffer )
         {
             continue;
         }
 
-        RVertexDescription* pVertexDescription = rSceneObject.GetVertexDescription();
-        if( !pVertexDescription )
-        {
-            continue;
-        }
+        HELIUM_FRAME_PROFILE_COUNTER_ADD( "ShadowCascadesRendered", 1 );
 
-        RIndexBuffer* pIndexBuffer = rSceneObject.GetIndexBuffer();
-        if( !pIndexBuffer )
+        // Claim the shadow depth texture before overwriting any of its tiles, invalidating the tiles cached by other
+        // scenes while keeping this scene's remaining tiles valid.
+        if( rRenderResourceManager.GetShadowDepthTextureGeneration() != m_shadowCascadeCacheGeneration )
         {
-            continue;
+            m_shadowCascadeCacheGeneration = rRenderResourceManager.InvalidateShadowDepthTextureContents();
         }
 
-        RVertexShader* pVertexShader;
-        if( rSceneObject.GetBoneCount() == 0 || !rSceneObject.GetBonePalette() )
-        {
-            pVertexShader = pPrePassNoSkinningVertexShader;
-        }
-        else
-        {
-            pVertexShader = pPrePassSmoothSkinningVertexShader;
-        }
+        spCommandProxy->SetViewport( tileX, tileY, tileSize, tileSize );
+        spCommandProxy->Clear( RENDERER_CLEAR_FLAG_DEPTH );
 
-        pVertexShader->CacheDescription( pRenderer, pVertexDescription );
-        RVertexInputLayout* pInputLayout = pVertexShader->GetCachedInputLayout();
-        if( !pInputLayout )
+        spCommandProxy->SetVertexConstantBuffers( 0, 1, &pShadowViewVertexDataBuffer );
+
+        // Draw the sub-meshes cast into this cascade (already sorted from front to back).
+        size_t sortIndexStart, sortIndexEnd;
+        m_shadowDrawSortList.GetPassRange(
+            static_cast< DrawSortList::EPass >( DrawSortList::PASS_SHADOW_DEPTH_FIRST + cascadeIndex ),
+            sortIndexStart,
+            sortIndexEnd );
+
+        for( size_t sortIndex = sortIndexStart; sortIndex < sortIndexEnd; ++sortIndex )
         {
-            continue;
-        }
+            size_t meshIndex = m_shadowDrawSortList.GetSubMeshIndex( sortIndex );
+            HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
 
-        uint32_t vertexStride = rSceneObject.GetVertexStride();
-        uint32_t offset = 0;
+            GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ meshIndex ];
 
-        ERendererPrimitiveType primitiveType = rSubMeshData.GetPrimitiveType();
-        uint32_t primitiveCount = rSubMeshData.GetPrimitiveCount();
-        uint32_t startVertex = rSubMeshData.GetStartVertex();
-        uint32_t vertexRange = rSubMeshData.GetVertexRange();
-        uint32_t startIndex = rSubMeshData.GetStartIndex();
+            size_t sceneObjectId = rSubMeshData.GetSceneObjectId();
+            HELIUM_ASSERT( IsValid( sceneObjectId ) );
+            HELIUM_ASSERT( sceneObjectId < m_sceneObjects.GetSize() );
+            HELIUM_ASSERT( m_sceneObjects.IsElementValid( sceneObjectId ) );
 
-        if( pPreviousVertexShader != pVertexShader )
-        {
-            spCommandProxy->SetVertexShader( pVertexShader );
-            pPreviousVertexShader = pVertexShader;
-        }
+            HELIUM_ASSERT( meshIndex < m_subMeshVertexGlobalDataBuffers.GetSize() );
+            RConstantBuffer* pInstanceVertexGlobalDataBuffer = m_subMeshVertexGlobalDataBuffers[ meshIndex ];
+            if( !pInstanceVertexGlobalDataBuffer )
+            {
+                HELIUM_ASSERT( sceneObjectId < m_objectVertexGlobalDataBuffers.GetSize() );
+                pInstanceVertexGlobalDataBuffer = m_objectVertexGlobalDataBuffers[ sceneObjectId ];
+                if( !pInstanceVertexGlobalDataBuffer )
+                {
+                    continue;
+                }
+            }
 
-        spCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
-        spCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
-        spCommandProxy->SetIndexBuffer( pIndexBuffer );
-        spCommandProxy->SetVertexInputLayout( pInputLayout );
+            GraphicsSceneObject& rSceneObject = m_sceneObjects[ sceneObjectId ];
 
-        spCommandProxy->DrawIndexed(
-            primitiveType,
-            startVertex,
-            0,
-            vertexRange,
-            startIndex,
-            primitiveCount );
+            RVertexBuffer* pVertexBuffer = rSceneObject.GetVertexBuffer();
+            if( !pVertexBuffer )
+            {
+                continue;
+            }
+
+            RVertexDescription* pVertexDescription = rSceneObject.GetVertexDescription();
+            if( !pVertexDescription )
+            {
+                continue;
+            }
+
+            RIndexBuffer* pIndexBuffer = rSceneObject.GetIndexBuffer();
+            if( !pIndexBuffer )
+            {
+                continue;
+            }
+
+            RVertexShader* pVertexShader;
+            if( rSceneObject.GetBoneCount() == 0 || !rSceneObject.GetBonePalette() )
+            {
+                pVertexShader = pPrePassNoSkinningVertexShader;
+            }
+            else
+            {
+                pVertexShader = pPrePassSmoothSkinningVertexShader;
+            }
+
+            pVertexShader->CacheDescription( pRenderer, pVertexDescription );
+            RVertexInputLayout* pInputLayout = pVertexShader->GetCachedInputLayout();
+            if( !pInputLayout )
+            {
+                continue;
+            }
+
+            uint32_t vertexStride = rSceneObject.GetVertexStride();
+            uint32_t offset = 0;
+
+            ERendererPrimitiveType primitiveType = rSubMeshData.GetPrimitiveType();
+            HELIUM_ASSERT( sceneObjectId < rSceneObjectLods.GetSize() );
+            size_t lodIndex = rSceneObjectLods[ sceneObjectId ];
+
+            uint32_t primitiveCount = rSubMeshData.GetLodPrimitiveCount( lodIndex );
+            uint32_t startVertex = rSubMeshData.GetStartVertex();
+            uint32_t vertexRange = rSubMeshData.GetVertexRange();
+            uint32_t startIndex = rSubMeshData.GetLodStartIndex( lodIndex );
+
+            if( pPreviousVertexShader != pVertexShader )
+            {
+                spCommandProxy->SetVertexShader( pVertexShader );
+                pPreviousVertexShader = pVertexShader;
+            }
+
+            spCommandProxy->SetVertexConstantBuffers( 1, 1, &pInstanceVertexGlobalDataBuffer );
+            spCommandProxy->SetVertexBuffers( 0, 1, &pVertexBuffer, &vertexStride, &offset );
+            spCommandProxy->SetIndexBuffer( pIndexBuffer );
+            spCommandProxy->SetVertexInputLayout( pInputLayout );
+
+            spCommandProxy->DrawIndexed(
+                primitiveType,
+                startVertex,
+                0,
+                vertexRange,
+                startIndex,
+                primitiveCount );
+
+            HELIUM_FRAME_PROFILE_COUNTER_ADD( "DrawCalls", 1 );
+            HELIUM_FRAME_PROFILE_COUNTER_ADD( "ShadowDrawCalls", 1 );
+        }
+
+        // Record the tile contents so that the cascade can be reused if nothing affecting it changes.
+        if( bCacheable )
+        {
+            rCacheEntry.centerX = rCascade.centerX;
+            rCacheEntry.centerY = rCascade.centerY;
+            rCacheEntry.extent = rCascade.extent;
+            rCacheEntry.lightDirection[ 0 ] = lightDirection[ 0 ];
+            rCacheEntry.lightDirection[ 1 ] = lightDirection[ 1 ];
+            rCacheEntry.lightDirection[ 2 ] = lightDirection[ 2 ];
+            rCacheEntry.casterSignature = casterSignatures[ cascadeIndex ];
+            rCacheEntry.tileSize = tileSize;
+            rCacheEntry.viewIndex = static_cast< uint32_t >( viewIndex );
+            rCacheEntry.bValid = true;
+        }
     }
 
     spCommandProxy->EndScene();
@@ -1578,8 +2569,8 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 
 /// Draw the depth-only pre-pass for the given scene view.
 ///
-/// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
-///   meshes.  This function will sort by depth if rendering is performed.
+/// - The m_drawSortList entries should already be built and sorted for the view, with the pre-pass entries ordered
+///   from front to back.
 /// - Standard viewport render surfaces are expected to have already been set, with the depth buffer cleared.
 /// - Default rasterizer and depth states should be already set.
 /// - Global per-view constant buffers should be already set.
@@ -1589,6 +2580,8 @@ void GraphicsScene::DrawShadowDepthPass( uint_fast32_t viewIndex )
 /// @see DrawShadowDepthPass(), DrawBasePass()
 void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
 {
+    HELIUM_FRAME_PROFILE_SCOPE( "GraphicsScene::DrawDepthPrePass" );
+
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
     HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
 
@@ -1637,22 +2630,6 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
     HELIUM_ASSERT( pPrePassShaderResource->GetType() == RShader::TYPE_VERTEX );
     RVertexShader* pPrePassSmoothSkinningVertexShader = static_cast< RVertexShader* >( pPrePassShaderResource );
 
-    // Sort meshes based on distance from front to back in order to reduce overdraw.
-    GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
-    const Simd::Vector3& rViewDirection = rView.GetForward();
-
-    size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
-
-    {
-		SortJob< size_t, SubMeshFrontToBackCompare > job;
-        SortJob< size_t, SubMeshFrontToBackCompare >::Parameters& rParameters = job.GetParameters();
-        rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-        rParameters.count = subMeshIndexCount;
-        rParameters.compare = SubMeshFrontToBackCompare( rViewDirection, m_sceneObjects, m_sceneObjectSubMeshes );
-        rParameters.singleJobCount = 100;
-		job.Run();
-    }
-
     // Initialize the blend state and shaders for performing no color writes.
     Renderer* pRenderer = Renderer::GetStaticInstance();
     HELIUM_ASSERT( pRenderer );
@@ -1669,9 +2646,15 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
     // Draw each visible mesh instance.
     RVertexShader* pPreviousVertexShader = NULL;
 
-    for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+    HELIUM_ASSERT( viewIndex < m_viewSceneObjectLods.GetSize() );
+    const DynamicArray< uint8_t >& rSceneObjectLods = m_viewSceneObjectLods[ viewIndex ];
+
+    size_t sortIndexStart, sortIndexEnd;
+    m_drawSortList.GetPassRange( DrawSortList::PASS_DEPTH_PRE, sortIndexStart, sortIndexEnd );
+
+    for( size_t sortIndex = sortIndexStart; sortIndex < sortIndexEnd; ++sortIndex )
     {
-        size_t meshIndex = m_sceneObjectSubMeshIndices[ meshIndexIndex ];
+        size_t meshIndex = m_drawSortList.GetSubMeshIndex( sortIndex );
         HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
 
         GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ meshIndex ];
@@ -1734,10 +2717,13 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
         uint32_t offset = 0;
 
         ERendererPrimitiveType primitiveType = rSubMeshData.GetPrimitiveType();
-        uint32_t primitiveCount = rSubMeshData.GetPrimitiveCount();
+        HELIUM_ASSERT( sceneObjectId < rSceneObjectLods.GetSize() );
+        size_t lodIndex = rSceneObjectLods[ sceneObjectId ];
+
+        uint32_t primitiveCount = rSubMeshData.GetLodPrimitiveCount( lodIndex );
         uint32_t startVertex = rSubMeshData.GetStartVertex();
         uint32_t vertexRange = rSubMeshData.GetVertexRange();
-        uint32_t startIndex = rSubMeshData.GetStartIndex();
+        uint32_t startIndex = rSubMeshData.GetLodStartIndex( lodIndex );
 
         if( pPreviousVertexShader != pVertexShader )
         {
@@ -1757,24 +2743,29 @@ void GraphicsScene::DrawDepthPrePass( uint_fast32_t viewIndex )
             vertexRange,
             startIndex,
             primitiveCount );
+
+        HELIUM_FRAME_PROFILE_COUNTER_ADD( "DrawCalls", 1 );
     }
 }
 
 /// Draw the base pass for the given scene view.
 ///
-/// - The m_sceneObjectSubMeshIndices array should already be prepared with the (unsorted) list of visible sub
-///   meshes.  This function will sort as appropriate if rendering is performed.
+/// - The m_drawSortList entries should already be built and sorted for the view, with the base pass entries grouped
+///   by shaders and material.
 /// - Standard viewport render surfaces are expected to have already been set, with the depth buffer either cleared
 ///   or prepared by the depth-only pre-pass.
 /// - Default rasterizer and depth states should be already set.
 /// - Global per-view constant buffers should be already set (buffers specific to the base pass will be set by this
 ///   function).
+/// - Light clusters should already be updated for the view by UpdateLightClusters().
 ///
 /// @param[in] viewIndex  Index of the view for which the base pass is being rendered.
 ///
-/// @see DrawShadowDepthPass(), DrawDepthPrePass()
+/// @see DrawShadowDepthPass(), DrawDepthPrePass(), UpdateLightClusters()
 void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
 {
+    HELIUM_FRAME_PROFILE_SCOPE( "GraphicsScene::DrawBasePass" );
+
     HELIUM_ASSERT( viewIndex < m_sceneViews.GetSize() );
     HELIUM_ASSERT( m_sceneViews.IsElementValid( viewIndex ) );
 
@@ -1803,10 +2794,13 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
         Name( TXT( "SHADOWS_PCF_DITHERED" ) )
     };
 
+    static const Name localLightsClusteredOptionName( TXT( "LOCAL_LIGHTS_CLUSTERED" ) );
+
     Shader::SelectPair systemSelections[] =
     {
         Shader::SelectPair( Name( TXT( "SHADOWS" ) ), Name( NULL_NAME ) ),
-        Shader::SelectPair( GetSkinningSysSelectName(), Name( NULL_NAME ) )
+        Shader::SelectPair( GetSkinningSysSelectName(), Name( NULL_NAME ) ),
+        Shader::SelectPair( Name( TXT( "LOCAL_LIGHTS" ) ), Name( NULL_NAME ) )
     };
 
     HELIUM_COMPILE_ASSERT( HELIUM_ARRAY_COUNT( shadowSelectOptions ) == GraphicsConfig::EShadowMode::MAX );
@@ -1820,20 +2814,8 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
     }
 
     systemSelections[ 0 ].choice = shadowSelectOptions[ shadowMode ];
-
-    // Sort meshes based on material in order to reduce shader switches.
-    size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
-
-	{
-		SortJob< size_t, SubMeshMaterialCompare > job;
-        SortJob< size_t, SubMeshMaterialCompare >::Parameters& rParameters = job.GetParameters();
-        rParameters.pBase = m_sceneObjectSubMeshIndices.GetData();
-        rParameters.count = subMeshIndexCount;
-        rParameters.compare = SubMeshMaterialCompare( m_sceneObjectSubMeshes );
-        rParameters.singleJobCount = 100;
-
-		job.Run();
-    }
+    systemSelections[ 2 ].choice =
+        ( m_clusteredLightCount != 0 ? localLightsClusteredOptionName : GetNoneOptionName() );
 
     // Set the opaque rendering blend state and per-view constant buffers for this pass.
     Renderer* pRenderer = Renderer::GetStaticInstance();
@@ -1853,6 +2835,9 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
     Name defaultSamplerStateName = GetDefaultSamplerStateName();
     Name shadowSamplerStateName = GetShadowSamplerStateName();
     Name shadowMapTextureName = GetShadowMapTextureName();
+    Name lightClusterTextureName = GetLightClusterTextureName();
+    Name lightIndexTextureName = GetLightIndexTextureName();
+    Name lightDataTextureName = GetLightDataTextureName();
 
     RSamplerState* pSamplerStateDefault = rRenderResourceManager.GetSamplerState(
         RenderResourceManager::TEXTURE_FILTER_LINEAR,
@@ -1860,17 +2845,31 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
     RSamplerState* pSamplerStateShadowMap = rRenderResourceManager.GetSamplerState(
         RenderResourceManager::TEXTURE_FILTER_LINEAR,
         RENDERER_TEXTURE_ADDRESS_MODE_CLAMP );
+    RSamplerState* pSamplerStatePointClamp = rRenderResourceManager.GetSamplerState(
+        RenderResourceManager::TEXTURE_FILTER_POINT,
+        RENDERER_TEXTURE_ADDRESS_MODE_CLAMP );
 
     RTexture2d* pShadowDepthTexture = rRenderResourceManager.GetShadowDepthTexture();
 
     RVertexShader* pPreviousVertexShader = NULL;
     RPixelShader* pPreviousPixelShader = NULL;
     RConstantBuffer* pPreviousMaterialVertexConstantBuffer = NULL;
+
+    // System option masks for the non-skinned and skinned variants of the most recently used shader (sub-meshes are
+    // sorted by shader variant, so the masks rarely need to be rebuilt).
+    Shader* pOptionMaskShader = NULL;
+    Shader::Options::OptionMask systemOptionMasks[ 2 ] = { 0, 0 };
     RConstantBuffer* pPreviousMaterialPixelConstantBuffer = NULL;
 
-    for( size_t meshIndexIndex = 0; meshIndexIndex < subMeshIndexCount; ++meshIndexIndex )
+    HELIUM_ASSERT( viewIndex < m_viewSceneObjectLods.GetSize() );
+    const DynamicArray< uint8_t >& rSceneObjectLods = m_viewSceneObjectLods[ viewIndex ];
+
+    size_t sortIndexStart, sortIndexEnd;
+    m_drawSortList.GetPassRange( DrawSortList::PASS_BASE, sortIndexStart, sortIndexEnd );
+
+    for( size_t sortIndex = sortIndexStart; sortIndex < sortIndexEnd; ++sortIndex )
     {
-        size_t meshIndex = m_sceneObjectSubMeshIndices[ meshIndexIndex ];
+        size_t meshIndex = m_drawSortList.GetSubMeshIndex( sortIndex );
         HELIUM_ASSERT( m_sceneObjectSubMeshes.IsElementValid( meshIndex ) );
 
         GraphicsSceneObject::SubMeshData& rSubMeshData = m_sceneObjectSubMeshes[ meshIndex ];
@@ -1936,28 +2935,31 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
             continue;
         }
 
-        if( rSceneObject.GetBoneCount() == 0 || !rSceneObject.GetBonePalette() )
+        const Shader::Options& rSystemOptions = pShaderResource->GetSystemOptions();
+        if( pShaderResource != pOptionMaskShader )
         {
             systemSelections[ 1 ].choice = GetNoneOptionName();
-        }
-        else
-        {
+            systemOptionMasks[ 0 ] = rSystemOptions.GetOptionMask(
+                NULL,
+                0,
+                systemSelections,
+                HELIUM_ARRAY_COUNT( systemSelections ) );
+
             systemSelections[ 1 ].choice = GetSkinningSmoothOptionName();
+            systemOptionMasks[ 1 ] = rSystemOptions.GetOptionMask(
+                NULL,
+                0,
+                systemSelections,
+                HELIUM_ARRAY_COUNT( systemSelections ) );
+
+            pOptionMaskShader = pShaderResource;
         }
 
-        const Shader::Options& rSystemOptions = pShaderResource->GetSystemOptions();
-        size_t vertexShaderIndex = rSystemOptions.GetOptionSetIndex(
-            RShader::TYPE_VERTEX,
-            NULL,
-            0,
-            systemSelections,
-            HELIUM_ARRAY_COUNT( systemSelections ) );
-        size_t pixelShaderIndex = rSystemOptions.GetOptionSetIndex(
-            RShader::TYPE_PIXEL,
-            NULL,
-            0,
-            systemSelections,
-            HELIUM_ARRAY_COUNT( systemSelections ) );
+        bool bSkinned = ( rSceneObject.GetBoneCount() != 0 && rSceneObject.GetBonePalette() );
+        Shader::Options::OptionMask systemOptionMask = systemOptionMasks[ bSkinned ? 1 : 0 ];
+
+        size_t vertexShaderIndex = rSystemOptions.GetOptionSetIndex( RShader::TYPE_VERTEX, systemOptionMask );
+        size_t pixelShaderIndex = rSystemOptions.GetOptionSetIndex( RShader::TYPE_PIXEL, systemOptionMask );
 
         RVertexShader* pVertexShader =
             static_cast< RVertexShader* >( pVertexShaderVariant->GetRenderResource( vertexShaderIndex ) );
@@ -1989,10 +2991,13 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
         uint32_t offset = 0;
 
         ERendererPrimitiveType primitiveType = rSubMeshData.GetPrimitiveType();
-        uint32_t primitiveCount = rSubMeshData.GetPrimitiveCount();
+        HELIUM_ASSERT( sceneObjectId < rSceneObjectLods.GetSize() );
+        size_t lodIndex = rSceneObjectLods[ sceneObjectId ];
+
+        uint32_t primitiveCount = rSubMeshData.GetLodPrimitiveCount( lodIndex );
         uint32_t startVertex = rSubMeshData.GetStartVertex();
         uint32_t vertexRange = rSubMeshData.GetVertexRange();
-        uint32_t startIndex = rSubMeshData.GetStartIndex();
+        uint32_t startIndex = rSubMeshData.GetLodStartIndex( lodIndex );
 
         spCommandProxy->SetVertexConstantBuffers( 2, 1, &pInstanceVertexGlobalDataBuffer );
 
@@ -2045,6 +3050,12 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
                 {
                     pSamplerState = pSamplerStateShadowMap;
                 }
+                else if( samplerName == lightClusterTextureName ||  // Light cluster lookups (older shader versions)
+                    samplerName == lightIndexTextureName ||
+                    samplerName == lightDataTextureName )
+                {
+                    pSamplerState = pSamplerStatePointClamp;
+                }
 
                 spCommandProxy->SetSamplerStates( rInputInfo.bindIndex, 1, &pSamplerState );
             }
@@ -2068,6 +3079,18 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
                 {
                     pTextureResource = pShadowDepthTexture;
                 }
+                else if( textureName == lightClusterTextureName )
+                {
+                    pTextureResource = m_spLightClusterTexture;
+                }
+                else if( textureName == lightIndexTextureName )
+                {
+                    pTextureResource = m_spLightIndexTexture;
+                }
+                else if( textureName == lightDataTextureName )
+                {
+                    pTextureResource = m_spLightDataTexture;
+                }
                 else
                 {
                     for( size_t materialTextureIndex = 0;
@@ -2100,6 +3123,8 @@ void GraphicsScene::DrawBasePass( uint_fast32_t viewIndex )
             vertexRange,
             startIndex,
             primitiveCount );
+
+        HELIUM_FRAME_PROFILE_COUNTER_ADD( "DrawCalls", 1 );
     }
 }
 
@@ -2149,111 +3174,32 @@ Name GraphicsScene::GetSkinningRigidOptionName()
     return skinningRigidOptionName;
 }
 
-/// Constructor.
-GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare()
-: m_cameraDirection( 0.0f )
-, m_pSceneObjects( NULL )
-, m_pSubMeshes( NULL )
-{
-}
-
-/// Constructor.
-///
-/// @param[in] rCameraDirection  Camera world direction.
-/// @param[in] rSceneObjects     List of graphics scene objects in the scene.
-/// @param[in] rSubMeshes        List of scene object sub-meshes in the scene.
-GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare(
-    const Simd::Vector3& rCameraDirection,
-    const SparseArray< GraphicsSceneObject >& rSceneObjects,
-    const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes )
-    : m_cameraDirection( rCameraDirection )
-    , m_pSceneObjects( &rSceneObjects )
-    , m_pSubMeshes( &rSubMeshes )
-{
-}
-
-/// Compare two sub-meshes for sorting.
-///
-/// @param[in] subMeshIndex0  Index of the first sub-mesh to compare.
-/// @param[in] subMeshIndex1  Index of the second sub-mesh to compare.
-///
-/// @return  True if the first sub-mesh should be sorted before the second, false if it should be sorted after or if
-///          they share the same sorting priority.
-bool GraphicsScene::SubMeshFrontToBackCompare::operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const
-{
-    const GraphicsSceneObject::SubMeshData& rSubMesh0 = m_pSubMeshes->GetElement( subMeshIndex0 );
-    const GraphicsSceneObject::SubMeshData& rSubMesh1 = m_pSubMeshes->GetElement( subMeshIndex1 );
-
-    size_t sceneObjectIndex0 = rSubMesh0.GetSceneObjectId();
-    HELIUM_ASSERT( m_pSceneObjects->IsElementValid( sceneObjectIndex0 ) );
-    size_t sceneObjectIndex1 = rSubMesh1.GetSceneObjectId();
-    HELIUM_ASSERT( m_pSceneObjects->IsElementValid( sceneObjectIndex1 ) );
-
-    const GraphicsSceneObject& rSceneObject0 = m_pSceneObjects->GetElement( sceneObjectIndex0 );
-    const GraphicsSceneObject& rSceneObject1 = m_pSceneObjects->GetElement( sceneObjectIndex1 );
-
-    Simd::Vector3 object0Pos = Simd::Vector4ToVector3( rSceneObject0.GetTransform().GetRow( 3 ) );
-    Simd::Vector3 object1Pos = Simd::Vector4ToVector3( rSceneObject1.GetTransform().GetRow( 3 ) );
-
-    float distance0 = object0Pos.Dot( m_cameraDirection );
-    float distance1 = object1Pos.Dot( m_cameraDirection );
-
-    return ( distance0 < distance1 );
-}
-
-/// Constructor.
-GraphicsScene::SubMeshMaterialCompare::SubMeshMaterialCompare()
-: m_pSubMeshes( NULL )
-{
-}
-
-/// Constructor.
-///
-/// @param[in] rSubMeshes  List of scene object sub-meshes in the scene.
-GraphicsScene::SubMeshMaterialCompare::SubMeshMaterialCompare(
-    const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes )
-    : m_pSubMeshes( &rSubMeshes )
-{
-}
-
-/// Compare two sub-meshes for sorting.
+/// Get the area of the shadow depth texture into which a given shadow cascade is rendered.
 ///
-/// @param[in] subMeshIndex0  Index of the first sub-mesh to compare.
-/// @param[in] subMeshIndex1  Index of the second sub-mesh to compare.
+/// Cascades are packed into equally sized square tiles within the usable area of the shadow depth texture (a single
+/// tile covering the entire usable area when only one cascade is used, or a 2x2 grid of tiles otherwise).
 ///
-/// @return  True if the first sub-mesh should be sorted before the second, false if it should be sorted after or if
-///          they share the same sorting priority.
-bool GraphicsScene::SubMeshMaterialCompare::operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const
+/// @param[in]  usableSize    Usable size of the shadow depth texture, in texels.
+/// @param[in]  cascadeCount  Number of shadow cascades.
+/// @param[in]  cascadeIndex  Index of the cascade for which to get the tile.
+/// @param[out] rTileX        Horizontal offset of the tile, in texels.
+/// @param[out] rTileY        Vertical offset of the tile, in texels.
+/// @param[out] rTileSize     Width and height of the tile, in texels.
+void GraphicsScene::GetShadowCascadeTile(
+    uint32_t usableSize,
+    uint32_t cascadeCount,
+    uint32_t cascadeIndex,
+    uint32_t& rTileX,
+    uint32_t& rTileY,
+    uint32_t& rTileSize )
 {
-    const GraphicsSceneObject::SubMeshData& rSubMesh0 = m_pSubMeshes->GetElement( subMeshIndex0 );
-    const GraphicsSceneObject::SubMeshData& rSubMesh1 = m_pSubMeshes->GetElement( subMeshIndex1 );
-
-    Material* pMaterial0 = rSubMesh0.GetMaterial();
-    Material* pMaterial1 = rSubMesh1.GetMaterial();
-    if( pMaterial0 == pMaterial1 )
-    {
-        return false;
-    }
-
-    if( !pMaterial0 )
-    {
-        return true;
-    }
-
-    if( !pMaterial1 )
-    {
-        return false;
-    }
-
-    ShaderVariant* pVariant0 = pMaterial0->GetShaderVariant( RShader::TYPE_VERTEX );
-    ShaderVariant* pVariant1 = pMaterial1->GetShaderVariant( RShader::TYPE_VERTEX );
-    if( pVariant0 != pVariant1 )
-    {
-        return ( pVariant0 < pVariant1 );
-    }
+    HELIUM_COMPILE_ASSERT( GraphicsConfig::SHADOW_CASCADE_COUNT_MAX <= 4 );
+    HELIUM_ASSERT( cascadeCount <= GraphicsConfig::SHADOW_CASCADE_COUNT_MAX );
+    HELIUM_ASSERT( cascadeIndex < cascadeCount );
 
-    pVariant0 = pMaterial0->GetShaderVariant( RShader::TYPE_PIXEL );
-    pVariant1 = pMaterial1->GetShaderVariant( RShader::TYPE_PIXEL );
+    uint32_t tilesPerRow = ( cascadeCount > 1 ? 2 : 1 );
 
-    return ( pVariant0 < pVariant1 );
+    rTileSize = usableSize / tilesPerRow;
+    rTileX = ( cascadeIndex % tilesPerRow ) * rTileSize;
+    rTileY = ( cascadeIndex / tilesPerRow ) * rTileSize;
 }
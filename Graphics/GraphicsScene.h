@@ -6,6 +6,11 @@
 
 #include "Foundation/BitArray.h"
 #include "Rendering/RRenderResource.h"
+#include "Graphics/GraphicsConfig.h"
+#include "Graphics/DrawSortList.h"
+#include "Graphics/LightClusterGrid.h"
+#include "Graphics/OcclusionBuffer.h"
+#include "GraphicsTypes/GraphicsSceneLight.h"
 #include "GraphicsTypes/GraphicsSceneObject.h"
 #include "GraphicsTypes/GraphicsSceneView.h"
 
@@ -17,6 +22,7 @@
 namespace Helium
 {
     HELIUM_DECLARE_RPTR( RConstantBuffer );
+    HELIUM_DECLARE_RPTR( RTexture2d );
 
     class HELIUM_GRAPHICS_API SceneObjectTransform : public Helium::Component
     {
@@ -65,6 +71,13 @@ namespace Helium
         inline GraphicsSceneObject::SubMeshData* GetSceneObjectSubMeshData( size_t id );
         //@}
 
+        /// @name Scene Light Allocation
+        //@{
+        size_t AllocateSceneLight();
+        void ReleaseSceneLight( size_t id );
+        inline GraphicsSceneLight* GetSceneLight( size_t id );
+        //@}
+
         /// @name Lighting
         //@{
         void SetAmbientLight(
@@ -93,53 +106,46 @@ namespace Helium
         static Name GetDefaultSamplerStateName();
         static Name GetShadowSamplerStateName();
         static Name GetShadowMapTextureName();
+        static Name GetLightClusterTextureName();
+        static Name GetLightIndexTextureName();
+        static Name GetLightDataTextureName();
         //@}
 
     private:
-        /// Front-to-back sub-mesh sort comparison function
-        class HELIUM_GRAPHICS_API SubMeshFrontToBackCompare
+        /// Shadow map cascade placement for a scene view.
+        struct ShadowCascade
         {
-        public:
-            /// @name Construction/Destruction
-            //@{
-            SubMeshFrontToBackCompare();
-            SubMeshFrontToBackCompare(
-                const Simd::Vector3& rCameraDirection, const SparseArray< GraphicsSceneObject >& rSceneObjects,
-                const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes );
-            //@}
-
-            /// @name Overloaded Operators
-            //@{
-            bool operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const;
-            //@}
-
-        private:
-            /// Camera direction.
-            Simd::Vector3 m_cameraDirection;
-            /// Scene object list.
-            const SparseArray< GraphicsSceneObject >* m_pSceneObjects;
-            /// Scene object sub-mesh list.
-            const SparseArray< GraphicsSceneObject::SubMeshData >* m_pSubMeshes;
+            /// Light-space inverse view/projection matrix used to render the cascade.
+            Simd::Matrix44 inverseViewProjection;
+            /// Cascade center along the light-space horizontal axis.
+            float32_t centerX;
+            /// Cascade center along the light-space vertical axis.
+            float32_t centerY;
+            /// Width and height of the area covered by the cascade, in world units.
+            float32_t extent;
+            /// True if the cascade can be reused across frames while it contains only static shadow casters.
+            bool bCacheable;
         };
 
-        /// Material-based sub-mesh sort comparison function
-        class HELIUM_GRAPHICS_API SubMeshMaterialCompare
+        /// Shadow depth texture tile state retained for caching cascades across frames.
+        struct ShadowCascadeCacheEntry
         {
-        public:
-            /// @name Construction/Destruction
-            //@{
-            SubMeshMaterialCompare();
-            explicit SubMeshMaterialCompare( const SparseArray< GraphicsSceneObject::SubMeshData >& rSubMeshes );
-            //@}
-
-            /// @name Overloaded Operators
-            //@{
-            bool operator()( size_t subMeshIndex0, size_t subMeshIndex1 ) const;
-            //@}
-
-        private:
-            /// Scene object sub-mesh list.
-            const SparseArray< GraphicsSceneObject::SubMeshData >* m_pSubMeshes;
+            /// Cascade center along the light-space horizontal axis when the tile was last rendered.
+            float32_t centerX;
+            /// Cascade center along the light-space vertical axis when the tile was last rendered.
+            float32_t centerY;
+            /// Cascade extent when the tile was last rendered.
+            float32_t extent;
+            /// Directional light direction when the tile was last rendered.
+            float32_t lightDirection[ 3 ];
+            /// Hash of the shadow casters (and their revisions and levels of detail) rendered into the tile.
+            uint64_t casterSignature;
+            /// Size of the tile, in texels.
+            uint32_t tileSize;
+            /// Index of the scene view for which the tile was last rendered.
+            uint32_t viewIndex;
+            /// True if the tile contents are valid and can be reused.
+            bool bValid;
         };
 
         /// Scene view list.
@@ -148,6 +154,8 @@ namespace Helium
         SparseArray< GraphicsSceneObject > m_sceneObjects;
         /// Scene object sub-data list.
         SparseArray< GraphicsSceneObject::SubMeshData > m_sceneObjectSubMeshes;
+        /// Scene light list.
+        SparseArray< GraphicsSceneLight > m_sceneLights;
 
 #if GRAPHICS_SCENE_BUFFERED_DRAWER
         /// Buffered drawing support for the entire scene (presented in all views).
@@ -160,8 +168,34 @@ namespace Helium
 
         /// Visible scene objects for the current view.
         BitArray<> m_visibleSceneObjects;
-        /// Scene object sub-data index list (for sorting during rendering).
-        DynamicArray< size_t > m_sceneObjectSubMeshIndices;
+        /// Sorted depth pre-pass and base pass sub-mesh draws for the current view.
+        DrawSortList m_drawSortList;
+        /// Vertex shader variant ranks used when building sort keys.
+        DrawSortList::PointerRankTable m_vertexShaderRanks;
+        /// Pixel shader variant ranks used when building sort keys.
+        DrawSortList::PointerRankTable m_pixelShaderRanks;
+        /// Material ranks used when building sort keys.
+        DrawSortList::PointerRankTable m_materialRanks;
+        /// Level of detail selected for each scene object in each scene view (retained between frames for hysteresis).
+        DynamicArray< DynamicArray< uint8_t > > m_viewSceneObjectLods;
+        /// Level of detail selected for each shadow caster in each scene view's shadow depth pass, based on its size in
+        /// the shadow cascades it is drawn into (retained between frames for hysteresis).
+        DynamicArray< DynamicArray< uint8_t > > m_viewSceneObjectShadowLods;
+        /// Software depth buffer used for occlusion culling (reused for each view).
+        OcclusionBuffer m_occlusionBuffer;
+
+        /// Assignment of visible scene lights to light clusters (reused for each view).
+        LightClusterGrid m_lightClusterGrid;
+        /// Scene light IDs of the lights added to the light cluster grid, in the order in which they were added.
+        DynamicArray< size_t > m_lightClusterCandidateIds;
+        /// Number of scene lights assigned to light clusters for the view being rendered.
+        uint32_t m_clusteredLightCount;
+        /// Offset and light count of each light cluster.
+        RTexture2dPtr m_spLightClusterTexture;
+        /// Light indices referenced by the light clusters.
+        RTexture2dPtr m_spLightIndexTexture;
+        /// View-space position, color, and spot cone parameters of each clustered light.
+        RTexture2dPtr m_spLightDataTexture;
 
         /// Ambient light top color.
         Color m_ambientLightTopColor;
@@ -182,8 +216,27 @@ namespace Helium
         /// ID of the currently active scene view.
         uint32_t m_activeViewId;
 
-        /// Pre-computed shadow depth pass inverse view/projection matrices.
-        DynamicArray< Simd::Matrix44 > m_shadowViewInverseViewProjectionMatrices;
+        /// Number of shadow cascades rendered for each view.
+        uint32_t m_shadowCascadeCount;
+        /// Pre-computed shadow cascades (GraphicsConfig::SHADOW_CASCADE_COUNT_MAX entries for each view).
+        DynamicArray< ShadowCascade > m_shadowCascades;
+        /// Directional light shadow view horizontal axis.
+        Simd::Vector3 m_shadowViewRight;
+        /// Directional light shadow view vertical axis.
+        Simd::Vector3 m_shadowViewUp;
+
+        /// Cached state of each shadow cascade tile in the shadow depth texture.
+        ShadowCascadeCacheEntry m_shadowCascadeCache[ GraphicsConfig::SHADOW_CASCADE_COUNT_MAX ];
+        /// Shadow depth texture generation at which this scene last claimed the texture, for detecting when another
+        /// scene has rendered into the shared texture or its contents have been lost.
+        uint32_t m_shadowCascadeCacheGeneration;
+        /// Counter incremented whenever scene objects or sub-meshes are added or removed.
+        uint32_t m_sceneObjectSetRevision;
+
+        /// Cascade mask for each scene object while rendering the shadow depth pass.
+        DynamicArray< uint8_t > m_shadowCasterCascadeMasks;
+        /// Sorted shadow caster sub-mesh draws for all cascades of the view being rendered.
+        DrawSortList m_shadowDrawSortList;
 
         /// Per-view global vertex constant buffers.
         DynamicArray< RConstantBufferPtr > m_viewVertexGlobalDataBuffers[ 2 ];
@@ -195,7 +248,7 @@ namespace Helium
         /// Per-view base-pass pixel constant buffers.
         DynamicArray< RConstantBufferPtr > m_viewPixelBasePassDataBuffers[ 2 ];
 
-        /// Per-view vertex constant buffers for shadow depth rendering.
+        /// Per-view, per-cascade vertex constant buffers for shadow depth rendering.
         DynamicArray< RConstantBufferPtr > m_shadowViewVertexDataBuffers[ 2 ];
 
         /// Pool of per-instance vertex constant buffers for non-skinned meshes.
@@ -218,12 +271,13 @@ namespace Helium
 
         /// @name Rendering
         //@{
-        void UpdateShadowInverseViewProjectionMatrixSimple( size_t viewIndex );
-        void UpdateShadowInverseViewProjectionMatrixLspsm( size_t viewIndex );
+        void UpdateShadowCascades( size_t viewIndex );
+        void InvalidateShadowCascadeCache();
 
         void SwapDynamicConstantBuffers();
 
         void DrawSceneView( uint_fast32_t viewIndex );
+        void UpdateLightClusters( uint_fast32_t viewIndex );
 
         void DrawShadowDepthPass( uint_fast32_t viewIndex );
         void DrawDepthPrePass( uint_fast32_t viewIndex );
@@ -237,6 +291,10 @@ namespace Helium
         static Name GetSkinningSysSelectName();
         static Name GetSkinningSmoothOptionName();
         static Name GetSkinningRigidOptionName();
+
+        static void GetShadowCascadeTile(
+            uint32_t usableSize, uint32_t cascadeCount, uint32_t cascadeIndex, uint32_t& rTileX, uint32_t& rTileY,
+            uint32_t& rTileSize );
         //@}
     };
 }
@@ -45,6 +45,21 @@ namespace Helium
         return &m_sceneObjectSubMeshes[ id ];
     }
 
+    /// Access the scene light with the specified ID.
+    ///
+    /// @param[in] id  ID of the light to retrieve.
+    ///
+    /// @return  Pointer to the specified scene light.
+    ///
+    /// @see AllocateSceneLight(), ReleaseSceneLight()
+    GraphicsSceneLight* GraphicsScene::GetSceneLight( size_t id )
+    {
+        HELIUM_ASSERT( id < m_sceneLights.GetSize() );
+        HELIUM_ASSERT( m_sceneLights.IsElementValid( id ) );
+
+        return &m_sceneLights[ id ];
+    }
+
     /// Get the ambient light color for upward-facing normals.
     ///
     /// @return  Ambient light color for upward-facing normals.
@@ -0,0 +1,337 @@
+#include "GraphicsPch.h"
+#include "Graphics/LightClusterGrid.h"
+
+#include <algorithm>
+#include <math.h>
+
+using namespace Helium;
+
+/// Far clip distance used for slicing the view depth when the view has no far clip plane.
+static const float32_t INFINITE_FAR_CLIP_SLICE_DISTANCE = 10000.0f;
+/// Reciprocal of the natural logarithm of 2, for computing base-2 logarithms.
+static const float32_t INVERSE_LN_2 = 1.4426950408889634f;
+
+/// Ordering of added light indices by decreasing priority.
+struct LightPriorityGreater
+{
+    /// Priority of each added light.
+    const float32_t* pPriorities;
+
+    /// Constructor.
+    ///
+    /// @param[in] pLightPriorities  Priority of each added light.
+    explicit LightPriorityGreater( const float32_t* pLightPriorities )
+        : pPriorities( pLightPriorities )
+    {
+    }
+
+    /// Compare two added lights.
+    ///
+    /// @param[in] index0  Index of the first light.
+    /// @param[in] index1  Index of the second light.
+    ///
+    /// @return  True if the first light has a higher priority than the second, false if not.
+    bool operator()( uint32_t index0, uint32_t index1 ) const
+    {
+        return ( pPriorities[ index0 ] > pPriorities[ index1 ] );
+    }
+};
+
+/// Constructor.
+LightClusterGrid::LightClusterGrid()
+: m_projectionScaleX( 1.0f )
+, m_projectionScaleY( 1.0f )
+, m_projectionDepthScale( 1.0f )
+, m_projectionDepthOffset( 0.0f )
+, m_nearClip( 1.0f )
+, m_farClip( INFINITE_FAR_CLIP_SLICE_DISTANCE )
+, m_sliceScale( 0.0f )
+, m_sliceBias( 0.0f )
+, m_lightCount( 0 )
+, m_lightIndexCount( 0 )
+, m_occupiedClusterCount( 0 )
+{
+    MemoryZero( m_clusterOffsets, sizeof( m_clusterOffsets ) );
+    MemoryZero( m_clusterCounts, sizeof( m_clusterCounts ) );
+}
+
+/// Begin assigning lights to clusters for a view.
+///
+/// @param[in] rProjection  View projection matrix.
+/// @param[in] nearClip     Near clip distance.
+/// @param[in] farClip      Far clip distance, or a negative value if the far clip plane is at infinity.
+///
+/// @see AddLight(), End()
+void LightClusterGrid::Begin( const Simd::Matrix44& rProjection, float32_t nearClip, float32_t farClip )
+{
+    m_projectionScaleX = rProjection.GetElement( 0 );
+    m_projectionScaleY = rProjection.GetElement( 5 );
+    m_projectionDepthScale = rProjection.GetElement( 11 );
+    m_projectionDepthOffset = rProjection.GetElement( 15 );
+
+    m_nearClip = nearClip;
+    m_farClip = farClip;
+    ClampDepthRange( m_nearClip, m_farClip );
+    ComputeSliceParameters( m_nearClip, m_farClip, m_sliceScale, m_sliceBias );
+
+    m_lightCount = 0;
+    m_lightIndexCount = 0;
+    m_occupiedClusterCount = 0;
+
+    m_addedLightBounds.Resize( 0 );
+    m_addedLightPriorities.Resize( 0 );
+}
+
+/// Add a light to the grid.
+///
+/// @param[in] rViewCenter  View-space center of the light's bounding sphere.
+/// @param[in] radius       Radius of the light's bounding sphere.
+///
+/// @return  True if the light was added, false if it lies outside the view.  Any number of lights can be added; if more
+///          than VISIBLE_LIGHT_COUNT_MAX are added, End() keeps those with the largest projected size.
+///
+/// @see Begin(), End(), GetAddedLightIndex()
+bool LightClusterGrid::AddLight( const Simd::Vector3& rViewCenter, float32_t radius )
+{
+    float32_t centerX = rViewCenter.GetElement( 0 );
+    float32_t centerY = rViewCenter.GetElement( 1 );
+    float32_t centerZ = rViewCenter.GetElement( 2 );
+
+    float32_t depthMin = centerZ - radius;
+    float32_t depthMax = centerZ + radius;
+    if( depthMax < m_nearClip || depthMin > m_farClip )
+    {
+        return false;
+    }
+
+    LightBounds bounds;
+    bounds.minZ = static_cast< uint8_t >( GetSlice( depthMin ) );
+    bounds.maxZ = static_cast< uint8_t >( GetSlice( depthMax ) );
+
+    if( depthMin <= m_nearClip && m_projectionDepthScale != 0.0f )
+    {
+        // The sphere crosses the near clip plane, so it can cover any part of the screen.
+        bounds.minX = 0;
+        bounds.maxX = static_cast< uint8_t >( CLUSTER_COUNT_X - 1 );
+        bounds.minY = 0;
+        bounds.maxY = static_cast< uint8_t >( CLUSTER_COUNT_Y - 1 );
+    }
+    else
+    {
+        // The screen-space extents of the box around the sphere are reached at its corners.
+        float32_t ndcMinX = NumericLimits< float32_t >::Maximum;
+        float32_t ndcMaxX = -NumericLimits< float32_t >::Maximum;
+        float32_t ndcMinY = NumericLimits< float32_t >::Maximum;
+        float32_t ndcMaxY = -NumericLimits< float32_t >::Maximum;
+
+        float32_t depths[ 2 ] = { Max( depthMin, m_nearClip ), depthMax };
+        for( size_t depthIndex = 0; depthIndex < HELIUM_ARRAY_COUNT( depths ); ++depthIndex )
+        {
+            float32_t inverseW = 1.0f / ( depths[ depthIndex ] * m_projectionDepthScale + m_projectionDepthOffset );
+
+            float32_t x0 = ( centerX - radius ) * m_projectionScaleX * inverseW;
+            float32_t x1 = ( centerX + radius ) * m_projectionScaleX * inverseW;
+            float32_t y0 = ( centerY - radius ) * m_projectionScaleY * inverseW;
+            float32_t y1 = ( centerY + radius ) * m_projectionScaleY * inverseW;
+
+            ndcMinX = Min( ndcMinX, Min( x0, x1 ) );
+            ndcMaxX = Max( ndcMaxX, Max( x0, x1 ) );
+            ndcMinY = Min( ndcMinY, Min( y0, y1 ) );
+            ndcMaxY = Max( ndcMaxY, Max( y0, y1 ) );
+        }
+
+        if( ndcMaxX < -1.0f || ndcMinX > 1.0f || ndcMaxY < -1.0f || ndcMinY > 1.0f )
+        {
+            return false;
+        }
+
+        bounds.minX = static_cast< uint8_t >( GetTile( ndcMinX, CLUSTER_COUNT_X ) );
+        bounds.maxX = static_cast< uint8_t >( GetTile( ndcMaxX, CLUSTER_COUNT_X ) );
+        bounds.minY = static_cast< uint8_t >( GetTile( ndcMinY, CLUSTER_COUNT_Y ) );
+        bounds.maxY = static_cast< uint8_t >( GetTile( ndcMaxY, CLUSTER_COUNT_Y ) );
+    }
+
+    // Rank the light by its approximate projected size (lights containing the camera get the largest size).
+    float32_t priority = radius / Max( depthMin, m_nearClip );
+
+    m_addedLightBounds.Push( bounds );
+    m_addedLightPriorities.Push( priority );
+
+    return true;
+}
+
+/// Finish assigning lights to clusters and build the per-cluster light lists.
+///
+/// If more than VISIBLE_LIGHT_COUNT_MAX lights were added, only the lights with the largest projected size are kept
+/// (in the order in which they were added).  Clusters overlapped by more than CLUSTER_LIGHT_COUNT_MAX lights keep only
+/// the first lights kept, and clusters are truncated once LIGHT_INDEX_COUNT_MAX indices have been written.
+///
+/// @see Begin(), AddLight(), GetDroppedLightCount()
+void LightClusterGrid::End()
+{
+    MemoryZero( m_clusterCounts, sizeof( m_clusterCounts ) );
+
+    // Select the lights to keep.
+    uint32_t addedLightCount = static_cast< uint32_t >( m_addedLightBounds.GetSize() );
+    if( addedLightCount > VISIBLE_LIGHT_COUNT_MAX )
+    {
+        m_lightCount = VISIBLE_LIGHT_COUNT_MAX;
+
+        m_addedLightOrder.Resize( addedLightCount );
+        uint32_t* pOrder = m_addedLightOrder.GetData();
+        for( uint32_t addedLightIndex = 0; addedLightIndex < addedLightCount; ++addedLightIndex )
+        {
+            pOrder[ addedLightIndex ] = addedLightIndex;
+        }
+
+        std::nth_element(
+            pOrder,
+            pOrder + VISIBLE_LIGHT_COUNT_MAX,
+            pOrder + addedLightCount,
+            LightPriorityGreater( m_addedLightPriorities.GetData() ) );
+        std::sort( pOrder, pOrder + VISIBLE_LIGHT_COUNT_MAX );
+
+        MemoryCopy( m_addedLightIndices, pOrder, VISIBLE_LIGHT_COUNT_MAX * sizeof( uint32_t ) );
+    }
+    else
+    {
+        m_lightCount = addedLightCount;
+        for( uint32_t addedLightIndex = 0; addedLightIndex < addedLightCount; ++addedLightIndex )
+        {
+            m_addedLightIndices[ addedLightIndex ] = addedLightIndex;
+        }
+    }
+
+    for( uint32_t lightIndex = 0; lightIndex < m_lightCount; ++lightIndex )
+    {
+        m_lightBounds[ lightIndex ] = m_addedLightBounds[ m_addedLightIndices[ lightIndex ] ];
+    }
+
+    // Count the lights overlapping each cluster.
+    uint32_t lightCount = m_lightCount;
+    for( uint32_t lightIndex = 0; lightIndex < lightCount; ++lightIndex )
+    {
+        const LightBounds& rBounds = m_lightBounds[ lightIndex ];
+        for( uint32_t z = rBounds.minZ; z <= rBounds.maxZ; ++z )
+        {
+            for( uint32_t y = rBounds.minY; y <= rBounds.maxY; ++y )
+            {
+                uint8_t* pCount = &m_clusterCounts[ GetClusterIndex( rBounds.minX, y, z ) ];
+                for( uint32_t x = rBounds.minX; x <= rBounds.maxX; ++x, ++pCount )
+                {
+                    if( *pCount < CLUSTER_LIGHT_COUNT_MAX )
+                    {
+                        ++( *pCount );
+                    }
+                }
+            }
+        }
+    }
+
+    // Lay out each cluster's light list.
+    uint32_t indexOffset = 0;
+    uint32_t occupiedClusterCount = 0;
+    for( uint32_t clusterIndex = 0; clusterIndex < CLUSTER_COUNT; ++clusterIndex )
+    {
+        uint32_t count = Min< uint32_t >( m_clusterCounts[ clusterIndex ], LIGHT_INDEX_COUNT_MAX - indexOffset );
+        m_clusterCounts[ clusterIndex ] = static_cast< uint8_t >( count );
+        m_clusterOffsets[ clusterIndex ] = static_cast< uint16_t >( indexOffset );
+        indexOffset += count;
+        occupiedClusterCount += ( count != 0 ? 1 : 0 );
+    }
+
+    m_lightIndexCount = indexOffset;
+    m_occupiedClusterCount = occupiedClusterCount;
+
+    // Fill in the light lists, using the counts as write cursors.
+    uint8_t clusterFill[ CLUSTER_COUNT ];
+    MemoryZero( clusterFill, sizeof( clusterFill ) );
+
+    for( uint32_t lightIndex = 0; lightIndex < lightCount; ++lightIndex )
+    {
+        const LightBounds& rBounds = m_lightBounds[ lightIndex ];
+        for( uint32_t z = rBounds.minZ; z <= rBounds.maxZ; ++z )
+        {
+            for( uint32_t y = rBounds.minY; y <= rBounds.maxY; ++y )
+            {
+                uint32_t clusterIndex = GetClusterIndex( rBounds.minX, y, z );
+                for( uint32_t x = rBounds.minX; x <= rBounds.maxX; ++x, ++clusterIndex )
+                {
+                    uint8_t& rFill = clusterFill[ clusterIndex ];
+                    if( rFill < m_clusterCounts[ clusterIndex ] )
+                    {
+                        uint32_t writeIndex = m_clusterOffsets[ clusterIndex ] + rFill;
+                        m_lightIndices[ writeIndex ] = static_cast< uint8_t >( lightIndex );
+                        ++rFill;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Compute the parameters mapping view depth to depth slices for a given view depth range.
+///
+/// A view depth z lies in the depth slice floor( log2( z ) * scale + bias ), so that the depth range is split into
+/// CLUSTER_COUNT_Z logarithmically spaced slices.
+///
+/// @param[in]  nearClip     Near clip distance.
+/// @param[in]  farClip      Far clip distance, or a negative value if the far clip plane is at infinity.
+/// @param[out] rSliceScale  Scale applied to the base-2 logarithm of the view depth.
+/// @param[out] rSliceBias   Bias added to the scaled base-2 logarithm of the view depth.
+///
+/// @see GetSliceScale(), GetSliceBias()
+void LightClusterGrid::ComputeSliceParameters(
+    float32_t nearClip,
+    float32_t farClip,
+    float32_t& rSliceScale,
+    float32_t& rSliceBias )
+{
+    ClampDepthRange( nearClip, farClip );
+
+    float32_t logNear = logf( nearClip ) * INVERSE_LN_2;
+    float32_t logFar = logf( farClip ) * INVERSE_LN_2;
+    rSliceScale = static_cast< float32_t >( CLUSTER_COUNT_Z ) / ( logFar - logNear );
+    rSliceBias = -logNear * rSliceScale;
+}
+
+/// Get the depth slice containing a given view depth.
+///
+/// @param[in] viewDepth  View-space depth.
+///
+/// @return  Depth slice index, clamped to the grid.
+uint32_t LightClusterGrid::GetSlice( float32_t viewDepth ) const
+{
+    viewDepth = Clamp( viewDepth, m_nearClip, m_farClip );
+    float32_t slice = Floor( logf( viewDepth ) * INVERSE_LN_2 * m_sliceScale + m_sliceBias );
+
+    return static_cast< uint32_t >( Clamp( slice, 0.0f, static_cast< float32_t >( CLUSTER_COUNT_Z - 1 ) ) );
+}
+
+/// Get the screen tile containing a given normalized device coordinate.
+///
+/// @param[in] ndc        Normalized device coordinate along one screen axis.
+/// @param[in] tileCount  Number of tiles along the axis.
+///
+/// @return  Tile index, clamped to the grid.
+uint32_t LightClusterGrid::GetTile( float32_t ndc, uint32_t tileCount )
+{
+    float32_t tile = Floor( ( ndc * 0.5f + 0.5f ) * static_cast< float32_t >( tileCount ) );
+
+    return static_cast< uint32_t >( Clamp( tile, 0.0f, static_cast< float32_t >( tileCount - 1 ) ) );
+}
+
+/// Clamp a view depth range to the finite, non-empty range split into depth slices.
+///
+/// @param[in,out] rNearClip  Near clip distance.
+/// @param[in,out] rFarClip   Far clip distance, or a negative value if the far clip plane is at infinity.
+void LightClusterGrid::ClampDepthRange( float32_t& rNearClip, float32_t& rFarClip )
+{
+    rNearClip = Max( rNearClip, HELIUM_EPSILON );
+    if( rFarClip < 0.0f )
+    {
+        rFarClip = INFINITE_FAR_CLIP_SLICE_DISTANCE;
+    }
+
+    rFarClip = Max( rFarClip, rNearClip * 2.0f );
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/Matrix44.h"
+#include "MathSimd/Vector3.h"
+
+namespace Helium
+{
+    /// View-space grid of light clusters used for clustered shading of local lights.
+    ///
+    /// The view frustum is split into CLUSTER_COUNT_X by CLUSTER_COUNT_Y screen tiles and CLUSTER_COUNT_Z depth
+    /// slices spaced logarithmically between the near and far clip planes.  Each visible light's bounding sphere is
+    /// assigned to the range of clusters overlapping its screen-space and depth extents, and the resulting per-cluster
+    /// light lists are packed into a single compact index list for upload to the GPU.  Building the grid only touches
+    /// the clusters overlapped by each visible light, so its cost scales with the number of visible lights rather than
+    /// the number of lights in the scene.  If more than VISIBLE_LIGHT_COUNT_MAX lights are visible, only the lights with
+    /// the largest projected size are kept.
+    class HELIUM_GRAPHICS_API LightClusterGrid : NonCopyable
+    {
+    public:
+        /// Number of clusters along the horizontal screen axis.
+        static const uint32_t CLUSTER_COUNT_X = 16;
+        /// Number of clusters along the vertical screen axis.
+        static const uint32_t CLUSTER_COUNT_Y = 8;
+        /// Number of clusters along the view depth axis.
+        static const uint32_t CLUSTER_COUNT_Z = 16;
+        /// Total number of clusters.
+        static const uint32_t CLUSTER_COUNT = CLUSTER_COUNT_X * CLUSTER_COUNT_Y * CLUSTER_COUNT_Z;
+
+        /// Maximum number of lights kept in the grid (light indices are stored as single bytes).
+        static const uint32_t VISIBLE_LIGHT_COUNT_MAX = 256;
+        /// Maximum number of lights assigned to a single cluster.
+        static const uint32_t CLUSTER_LIGHT_COUNT_MAX = 32;
+        /// Maximum number of light indices across all clusters.
+        static const uint32_t LIGHT_INDEX_COUNT_MAX = 16384;
+
+        /// @name Construction/Destruction
+        //@{
+        LightClusterGrid();
+        //@}
+
+        /// @name Cluster Assignment
+        //@{
+        void Begin( const Simd::Matrix44& rProjection, float32_t nearClip, float32_t farClip );
+        bool AddLight( const Simd::Vector3& rViewCenter, float32_t radius );
+        void End();
+        //@}
+
+        /// @name Data Access
+        //@{
+        inline uint32_t GetLightCount() const;
+        inline uint32_t GetAddedLightCount() const;
+        inline uint32_t GetDroppedLightCount() const;
+        inline uint32_t GetAddedLightIndex( uint32_t lightIndex ) const;
+        inline uint32_t GetLightIndexCount() const;
+        inline uint32_t GetOccupiedClusterCount() const;
+
+        inline const uint16_t* GetClusterOffsets() const;
+        inline const uint8_t* GetClusterCounts() const;
+        inline const uint8_t* GetLightIndices() const;
+
+        inline float32_t GetSliceScale() const;
+        inline float32_t GetSliceBias() const;
+
+        inline static uint32_t GetClusterIndex( uint32_t x, uint32_t y, uint32_t z );
+        //@}
+
+        /// @name Static Utility Functions
+        //@{
+        static void ComputeSliceParameters(
+            float32_t nearClip, float32_t farClip, float32_t& rSliceScale, float32_t& rSliceBias );
+        //@}
+
+    private:
+        /// Range of clusters overlapped by a light.
+        struct LightBounds
+        {
+            /// First horizontal tile.
+            uint8_t minX;
+            /// Last horizontal tile.
+            uint8_t maxX;
+            /// First vertical tile.
+            uint8_t minY;
+            /// Last vertical tile.
+            uint8_t maxY;
+            /// First depth slice.
+            uint8_t minZ;
+            /// Last depth slice.
+            uint8_t maxZ;
+        };
+
+        /// Horizontal projection scale.
+        float32_t m_projectionScaleX;
+        /// Vertical projection scale.
+        float32_t m_projectionScaleY;
+        /// Factor applied to the view depth to compute the clip-space w coordinate.
+        float32_t m_projectionDepthScale;
+        /// Offset added to compute the clip-space w coordinate.
+        float32_t m_projectionDepthOffset;
+        /// Near clip distance.
+        float32_t m_nearClip;
+        /// Far clip distance (finite).
+        float32_t m_farClip;
+
+        /// Scale applied to the base-2 logarithm of the view depth to compute the depth slice.
+        float32_t m_sliceScale;
+        /// Bias added to the scaled base-2 logarithm of the view depth to compute the depth slice.
+        float32_t m_sliceBias;
+
+        /// Number of lights kept in the grid.
+        uint32_t m_lightCount;
+        /// Number of light indices written.
+        uint32_t m_lightIndexCount;
+        /// Number of clusters with at least one light.
+        uint32_t m_occupiedClusterCount;
+
+        /// Cluster ranges of all lights added since the last call to Begin().
+        DynamicArray< LightBounds > m_addedLightBounds;
+        /// Projected size of all lights added since the last call to Begin(), used to pick the lights to keep.
+        DynamicArray< float32_t > m_addedLightPriorities;
+        /// Scratch buffer for ranking the added lights.
+        DynamicArray< uint32_t > m_addedLightOrder;
+
+        /// Cluster ranges for each light kept in the grid.
+        LightBounds m_lightBounds[ VISIBLE_LIGHT_COUNT_MAX ];
+        /// Index (in the order in which lights were added) of each light kept in the grid.
+        uint32_t m_addedLightIndices[ VISIBLE_LIGHT_COUNT_MAX ];
+        /// Offset of the first light index of each cluster.
+        uint16_t m_clusterOffsets[ CLUSTER_COUNT ];
+        /// Number of lights in each cluster.
+        uint8_t m_clusterCounts[ CLUSTER_COUNT ];
+        /// Light indices for all clusters.
+        uint8_t m_lightIndices[ LIGHT_INDEX_COUNT_MAX ];
+
+        /// @name Private Utility Functions
+        //@{
+        uint32_t GetSlice( float32_t viewDepth ) const;
+        static uint32_t GetTile( float32_t ndc, uint32_t tileCount );
+        static void ClampDepthRange( float32_t& rNearClip, float32_t& rFarClip );
+        //@}
+    };
+}
+
+#include "Graphics/LightClusterGrid.inl"
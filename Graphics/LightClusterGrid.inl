@@ -0,0 +1,135 @@
+namespace Helium
+{
+    /// Get the number of lights kept in the grid by the last call to End().
+    ///
+    /// @return  Light count.
+    ///
+    /// @see GetAddedLightCount(), GetAddedLightIndex(), GetLightIndexCount()
+    uint32_t LightClusterGrid::GetLightCount() const
+    {
+        return m_lightCount;
+    }
+
+    /// Get the number of lights successfully added since the last call to Begin().
+    ///
+    /// @return  Added light count.
+    ///
+    /// @see AddLight(), GetLightCount(), GetDroppedLightCount()
+    uint32_t LightClusterGrid::GetAddedLightCount() const
+    {
+        return static_cast< uint32_t >( m_addedLightBounds.GetSize() );
+    }
+
+    /// Get the number of added lights left out of the grid by the last call to End() because more than
+    /// VISIBLE_LIGHT_COUNT_MAX lights were added.
+    ///
+    /// @return  Dropped light count.
+    ///
+    /// @see GetAddedLightCount(), GetLightCount()
+    uint32_t LightClusterGrid::GetDroppedLightCount() const
+    {
+        return GetAddedLightCount() - m_lightCount;
+    }
+
+    /// Get the index, in the order in which lights were added, of a light kept in the grid.
+    ///
+    /// @param[in] lightIndex  Index of the light in the grid (as referenced by the light index list).
+    ///
+    /// @return  Index of the light among the lights successfully added since the last call to Begin().
+    ///
+    /// @see GetLightCount(), AddLight()
+    uint32_t LightClusterGrid::GetAddedLightIndex( uint32_t lightIndex ) const
+    {
+        HELIUM_ASSERT( lightIndex < m_lightCount );
+
+        return m_addedLightIndices[ lightIndex ];
+    }
+
+    /// Get the total number of light indices written across all clusters by the last call to End().
+    ///
+    /// @return  Light index count.
+    ///
+    /// @see GetLightIndices(), GetOccupiedClusterCount()
+    uint32_t LightClusterGrid::GetLightIndexCount() const
+    {
+        return m_lightIndexCount;
+    }
+
+    /// Get the number of clusters containing at least one light after the last call to End().
+    ///
+    /// @return  Occupied cluster count.
+    ///
+    /// @see GetLightIndexCount()
+    uint32_t LightClusterGrid::GetOccupiedClusterCount() const
+    {
+        return m_occupiedClusterCount;
+    }
+
+    /// Get the offset of the first light index of each cluster within the light index list.
+    ///
+    /// @return  Array of CLUSTER_COUNT cluster offsets.
+    ///
+    /// @see GetClusterCounts(), GetLightIndices(), GetClusterIndex()
+    const uint16_t* LightClusterGrid::GetClusterOffsets() const
+    {
+        return m_clusterOffsets;
+    }
+
+    /// Get the number of lights assigned to each cluster.
+    ///
+    /// @return  Array of CLUSTER_COUNT light counts.
+    ///
+    /// @see GetClusterOffsets(), GetLightIndices(), GetClusterIndex()
+    const uint8_t* LightClusterGrid::GetClusterCounts() const
+    {
+        return m_clusterCounts;
+    }
+
+    /// Get the light index list for all clusters.
+    ///
+    /// @return  Light indices (see GetAddedLightIndex() for mapping them back to the lights added).
+    ///
+    /// @see GetClusterOffsets(), GetClusterCounts(), GetLightIndexCount()
+    const uint8_t* LightClusterGrid::GetLightIndices() const
+    {
+        return m_lightIndices;
+    }
+
+    /// Get the scale applied to the base-2 logarithm of the view depth to compute a depth slice.
+    ///
+    /// @return  Depth slice scale.
+    ///
+    /// @see GetSliceBias()
+    float32_t LightClusterGrid::GetSliceScale() const
+    {
+        return m_sliceScale;
+    }
+
+    /// Get the bias added to the scaled base-2 logarithm of the view depth to compute a depth slice.
+    ///
+    /// @return  Depth slice bias.
+    ///
+    /// @see GetSliceScale()
+    float32_t LightClusterGrid::GetSliceBias() const
+    {
+        return m_sliceBias;
+    }
+
+    /// Get the index of a cluster in the cluster offset and count arrays.
+    ///
+    /// @param[in] x  Horizontal tile index.
+    /// @param[in] y  Vertical tile index.
+    /// @param[in] z  Depth slice index.
+    ///
+    /// @return  Cluster index.
+    ///
+    /// @see GetClusterOffsets(), GetClusterCounts()
+    uint32_t LightClusterGrid::GetClusterIndex( uint32_t x, uint32_t y, uint32_t z )
+    {
+        HELIUM_ASSERT( x < CLUSTER_COUNT_X );
+        HELIUM_ASSERT( y < CLUSTER_COUNT_Y );
+        HELIUM_ASSERT( z < CLUSTER_COUNT_Z );
+
+        return ( z * CLUSTER_COUNT_Y + y ) * CLUSTER_COUNT_X + x;
+    }
+}
@@ -135,7 +135,11 @@ bool Material::BeginPrecacheResourceData()
 		Shader* pShader = m_spShader;
 		if( pShader )
 		{
+			// Resolve the option names once and reuse the resulting mask for each shader type.
 			const Shader::Options& rUserOptions = pShader->GetUserOptions();
+			Shader::Options::OptionMask userOptionMask = rUserOptions.GetOptionMask(
+				m_userOptions.GetData(),
+				m_userOptions.GetSize() );
 
 			for( size_t shaderTypeIndex = 0;
 				shaderTypeIndex < HELIUM_ARRAY_COUNT( m_persistentResourceData.m_shaderVariantIndices );
@@ -143,8 +147,7 @@ bool Material::BeginPrecacheResourceData()
 			{
 				m_persistentResourceData.m_shaderVariantIndices[ shaderTypeIndex ] = static_cast< uint32_t >( rUserOptions.GetOptionSetIndex(
 					static_cast< RShader::EType >( shaderTypeIndex ),
-					m_userOptions.GetData(),
-					m_userOptions.GetSize() ) );
+					userOptionMask ) );
 			}
 		}
 
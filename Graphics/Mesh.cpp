@@ -49,6 +49,8 @@ void Mesh::RefCountPreDestroy()
 void Mesh::PopulateMetaType(Reflect::MetaStruct& comp)
 {
     comp.AddField(&Mesh::m_materials, TXT( "m_materials" ));
+    comp.AddField(&Mesh::m_lodTriangleRatios, TXT( "m_lodTriangleRatios" ));
+    comp.AddField(&Mesh::m_lodScreenSizes, TXT( "m_lodScreenSizes" ));
 }
 
 /// @copydoc Asset::NeedsPrecacheResourceData()
@@ -235,6 +237,8 @@ void Mesh::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &PersistentResourceData::m_vertexCount,              TXT( "m_vertexCount" ) );
     comp.AddField( &PersistentResourceData::m_triangleCount,            TXT( "m_triangleCount" ) );
     comp.AddField( &PersistentResourceData::m_bounds,                   TXT( "m_bounds" ) );
+    comp.AddField( &PersistentResourceData::m_lodSectionTriangleCounts, TXT( "m_lodSectionTriangleCounts" ) );
+    comp.AddField( &PersistentResourceData::m_lodScreenSizes,           TXT( "m_lodScreenSizes" ) );
 #if !HELIUM_USE_GRANNY_ANIMATION
     comp.AddField( &PersistentResourceData::m_boneCount,                TXT( "m_boneCount" ) );
     comp.AddField( &PersistentResourceData::m_pBoneNames,               TXT( "m_pBoneNames" ) );
@@ -256,9 +260,57 @@ bool Helium::Mesh::LoadPersistentResourceObject( Reflect::ObjectPtr &_object )
 
     _object->CopyTo(&m_persistentResourceData);
 
+    BuildLodTables();
+
     return true;
 }
 
+/// Build the per-section index buffer offsets and triangle counts for each level of detail.
+///
+/// Simplified levels of detail are stored in the index buffer after the full detail mesh, each laid out with one
+/// contiguous range of indices per mesh section.
+void Mesh::BuildLodTables()
+{
+    size_t sectionCount = m_persistentResourceData.m_sectionTriangleCounts.GetSize();
+    size_t lodCount = m_persistentResourceData.m_lodScreenSizes.GetSize() + 1;
+
+    if( m_persistentResourceData.m_lodSectionTriangleCounts.GetSize() != ( lodCount - 1 ) * sectionCount )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            TXT( "Mesh::BuildLodTables(): Level of detail data for mesh \"%s\" is inconsistent and will be ignored.\n" ),
+            *GetPath().ToString() );
+
+        m_persistentResourceData.m_lodSectionTriangleCounts.Clear();
+        m_persistentResourceData.m_lodScreenSizes.Clear();
+        lodCount = 1;
+    }
+
+    m_sectionLodStartIndices.Resize( 0 );
+    m_sectionLodStartIndices.Reserve( sectionCount * lodCount );
+    m_sectionLodStartIndices.Add( 0, sectionCount * lodCount );
+    m_sectionLodTriangleCounts.Resize( 0 );
+    m_sectionLodTriangleCounts.Reserve( sectionCount * lodCount );
+    m_sectionLodTriangleCounts.Add( 0, sectionCount * lodCount );
+
+    uint32_t startIndex = 0;
+    for( size_t lodIndex = 0; lodIndex < lodCount; ++lodIndex )
+    {
+        for( size_t sectionIndex = 0; sectionIndex < sectionCount; ++sectionIndex )
+        {
+            uint32_t triangleCount = ( lodIndex == 0
+                ? m_persistentResourceData.m_sectionTriangleCounts[ sectionIndex ]
+                : m_persistentResourceData.m_lodSectionTriangleCounts[ ( lodIndex - 1 ) * sectionCount + sectionIndex ] );
+
+            size_t tableIndex = sectionIndex * lodCount + lodIndex;
+            m_sectionLodStartIndices[ tableIndex ] = startIndex;
+            m_sectionLodTriangleCounts[ tableIndex ] = triangleCount;
+
+            startIndex += triangleCount * 3;
+        }
+    }
+}
+
 /// @copydoc Resource::GetCacheName()
 Name Mesh::GetCacheName() const
 {
@@ -58,6 +58,12 @@ namespace Helium
         
             /// Mesh bounds.
             Simd::AaBox m_bounds;
+
+            /// Number of triangles in each mesh section for each simplified level of detail (stored by level of
+            /// detail, then by section, excluding the full detail mesh).
+            DynamicArray< uint32_t > m_lodSectionTriangleCounts;
+            /// Projected screen size below which each simplified level of detail is used.
+            DynamicArray< float32_t > m_lodScreenSizes;
         
 #if !HELIUM_USE_GRANNY_ANIMATION
             /// Bone count (if the mesh is a skinned mesh).  Note we place this variable separate from the other skinned
@@ -103,6 +109,9 @@ namespace Helium
         /// @name Resource Caching Support
         //@{
         virtual Name GetCacheName() const;
+
+        inline const DynamicArray< float32_t >& GetLodTriangleRatioSettings() const;
+        inline const DynamicArray< float32_t >& GetLodScreenSizeSettings() const;
         //@}
 
         /// @name Data Access
@@ -112,6 +121,11 @@ namespace Helium
         inline uint32_t GetSectionTriangleCount( size_t sectionIndex ) const;
         const uint8_t* GetSectionSkinningPaletteMap( size_t sectionIndex ) const;
 
+        inline size_t GetLodCount() const;
+        inline const float32_t* GetLodScreenSizes() const;
+        inline const uint32_t* GetSectionLodStartIndices( size_t sectionIndex ) const;
+        inline const uint32_t* GetSectionLodTriangleCounts( size_t sectionIndex ) const;
+
         inline bool IsSkinned() const;
 #if HELIUM_USE_GRANNY_ANIMATION
         inline const Granny::MeshData& GetGrannyData() const;
@@ -143,6 +157,19 @@ namespace Helium
 
         /// Default material set.
         DynamicArray< MaterialPtr > m_materials;
+
+        /// Fraction of the full detail triangle count targeted by each simplified level of detail.
+        DynamicArray< float32_t > m_lodTriangleRatios;
+        /// Projected screen size (bounding sphere radius relative to half the viewport width) below which each
+        /// simplified level of detail is used.
+        DynamicArray< float32_t > m_lodScreenSizes;
+
+        /// Offset of the first index of each mesh section for each level of detail (stored by section, then by
+        /// level of detail).
+        DynamicArray< uint32_t > m_sectionLodStartIndices;
+        /// Number of triangles in each mesh section for each level of detail (stored by section, then by level of
+        /// detail).
+        DynamicArray< uint32_t > m_sectionLodTriangleCounts;
         
         /// Vertex buffer.
         RVertexBufferPtr m_spVertexBuffer;
@@ -154,6 +181,10 @@ namespace Helium
         /// Asynchronous load ID for the index buffer data.
         size_t m_indexBufferLoadId;
 
+        /// @name Level of Detail Support
+        //@{
+        void BuildLodTables();
+        //@}
     };
 }
 
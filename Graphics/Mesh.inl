@@ -46,6 +46,54 @@ namespace Helium
         return m_persistentResourceData.m_sectionTriangleCounts[ sectionIndex ];
     }
 
+    /// Get the number of levels of detail available for this mesh, including the full detail mesh.
+    ///
+    /// @return  Level of detail count.
+    ///
+    /// @see GetLodScreenSizes(), GetSectionLodStartIndices(), GetSectionLodTriangleCounts()
+    size_t Mesh::GetLodCount() const
+    {
+        return m_persistentResourceData.m_lodScreenSizes.GetSize() + 1;
+    }
+
+    /// Get the projected screen size thresholds below which each simplified level of detail is used.
+    ///
+    /// @return  Array of screen size thresholds, one for each level of detail after the full detail mesh.
+    ///
+    /// @see GetLodCount()
+    const float32_t* Mesh::GetLodScreenSizes() const
+    {
+        return m_persistentResourceData.m_lodScreenSizes.GetData();
+    }
+
+    /// Get the offset of the first index of a mesh section within the index buffer for each level of detail.
+    ///
+    /// @param[in] sectionIndex  Mesh section index.
+    ///
+    /// @return  Array of start indices, one for each level of detail.
+    ///
+    /// @see GetSectionLodTriangleCounts(), GetLodCount()
+    const uint32_t* Mesh::GetSectionLodStartIndices( size_t sectionIndex ) const
+    {
+        HELIUM_ASSERT( ( sectionIndex + 1 ) * GetLodCount() <= m_sectionLodStartIndices.GetSize() );
+
+        return m_sectionLodStartIndices.GetData() + sectionIndex * GetLodCount();
+    }
+
+    /// Get the number of triangles in a mesh section for each level of detail.
+    ///
+    /// @param[in] sectionIndex  Mesh section index.
+    ///
+    /// @return  Array of triangle counts, one for each level of detail.
+    ///
+    /// @see GetSectionLodStartIndices(), GetLodCount()
+    const uint32_t* Mesh::GetSectionLodTriangleCounts( size_t sectionIndex ) const
+    {
+        HELIUM_ASSERT( ( sectionIndex + 1 ) * GetLodCount() <= m_sectionLodTriangleCounts.GetSize() );
+
+        return m_sectionLodTriangleCounts.GetData() + sectionIndex * GetLodCount();
+    }
+
     /// Get whether this mesh is a skinned mesh.
     ///
     /// @return  True if this is a skinned mesh, false if not.
@@ -190,4 +238,25 @@ namespace Helium
     {
         return m_spIndexBuffer;
     }
+
+    /// Get the fraction of the full detail triangle count targeted by each simplified level of detail when caching
+    /// this mesh.
+    ///
+    /// @return  Triangle ratio for each level of detail after the full detail mesh.
+    ///
+    /// @see GetLodScreenSizeSettings()
+    const DynamicArray< float32_t >& Mesh::GetLodTriangleRatioSettings() const
+    {
+        return m_lodTriangleRatios;
+    }
+
+    /// Get the projected screen size thresholds to use for each simplified level of detail when caching this mesh.
+    ///
+    /// @return  Screen size threshold for each level of detail after the full detail mesh.
+    ///
+    /// @see GetLodTriangleRatioSettings()
+    const DynamicArray< float32_t >& Mesh::GetLodScreenSizeSettings() const
+    {
+        return m_lodScreenSizes;
+    }
 }
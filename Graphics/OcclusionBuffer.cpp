@@ -0,0 +1,479 @@
+#include "GraphicsPch.h"
+#include "Graphics/OcclusionBuffer.h"
+
+#if HELIUM_SIMD_SSE
+# include <emmintrin.h>
+#endif
+
+using namespace Helium;
+
+/// Box corner indices for each face of an axis-aligned box (bits 0, 1, and 2 of a corner index select the maximum X, Y,
+/// and Z coordinates, respectively).
+static const uint8_t BOX_FACE_CORNERS[ 6 ][ 4 ] =
+{
+    { 0, 2, 6, 4 },
+    { 1, 5, 7, 3 },
+    { 0, 4, 5, 1 },
+    { 2, 3, 7, 6 },
+    { 0, 1, 3, 2 },
+    { 4, 6, 7, 5 }
+};
+
+/// Maximum number of vertices in a box face after clipping it against the near plane.
+static const size_t CLIPPED_FACE_VERTEX_COUNT_MAX = 5;
+
+// Copy the elements of a matrix into a float array.
+static void GetMatrixElements( const Simd::Matrix44& rMatrix, float32_t* pElements )
+{
+    for( size_t elementIndex = 0; elementIndex < 16; ++elementIndex )
+    {
+        pElements[ elementIndex ] = rMatrix.GetElement( elementIndex );
+    }
+}
+
+// Transform the corners of an axis-aligned box into clip space.
+static void TransformBoxCorners( const Simd::AaBox& rBox, const float32_t* pMatrix, float32_t ( *pCorners )[ 4 ] )
+{
+    const Simd::Vector3& rMinimum = rBox.GetMinimum();
+    const Simd::Vector3& rMaximum = rBox.GetMaximum();
+
+    const float32_t bounds[ 2 ][ 3 ] =
+    {
+        { rMinimum.GetElement( 0 ), rMinimum.GetElement( 1 ), rMinimum.GetElement( 2 ) },
+        { rMaximum.GetElement( 0 ), rMaximum.GetElement( 1 ), rMaximum.GetElement( 2 ) }
+    };
+
+    for( size_t cornerIndex = 0; cornerIndex < 8; ++cornerIndex )
+    {
+        float32_t x = bounds[ cornerIndex & 1 ][ 0 ];
+        float32_t y = bounds[ ( cornerIndex >> 1 ) & 1 ][ 1 ];
+        float32_t z = bounds[ ( cornerIndex >> 2 ) & 1 ][ 2 ];
+
+        float32_t* pCorner = pCorners[ cornerIndex ];
+        for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+        {
+            pCorner[ componentIndex ] =
+                x * pMatrix[ componentIndex ] +
+                y * pMatrix[ 4 + componentIndex ] +
+                z * pMatrix[ 8 + componentIndex ] +
+                pMatrix[ 12 + componentIndex ];
+        }
+    }
+}
+
+/// Constructor.
+OcclusionBuffer::OcclusionBuffer()
+: m_viewProjection( Simd::Matrix44::IDENTITY )
+, m_pDepth( NULL )
+, m_width( 0 )
+, m_height( 0 )
+{
+}
+
+/// Destructor.
+OcclusionBuffer::~OcclusionBuffer()
+{
+    Shutdown();
+}
+
+/// Allocate the depth buffer.
+///
+/// @param[in] width   Buffer width, in pixels (rounded up to a multiple of four).
+/// @param[in] height  Buffer height, in pixels.
+///
+/// @return  True if the buffer was allocated successfully, false if not.
+///
+/// @see Shutdown(), IsInitialized()
+bool OcclusionBuffer::Initialize( uint32_t width, uint32_t height )
+{
+    HELIUM_ASSERT( width != 0 );
+    HELIUM_ASSERT( height != 0 );
+
+    Shutdown();
+
+    width = ( width + 3 ) & ~static_cast< uint32_t >( 3 );
+
+    m_pDepth = static_cast< float32_t* >( DefaultAllocator().AllocateAligned(
+        HELIUM_SIMD_ALIGNMENT,
+        sizeof( float32_t ) * width * height ) );
+    if( !m_pDepth )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Error,
+            TXT( "OcclusionBuffer::Initialize(): Failed to allocate a %" ) PRIu32 TXT( "x%" ) PRIu32
+            TXT( " depth buffer.\n" ),
+            width,
+            height );
+
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+
+    Clear( Simd::Matrix44::IDENTITY );
+
+    return true;
+}
+
+/// Free the depth buffer.
+///
+/// @see Initialize(), IsInitialized()
+void OcclusionBuffer::Shutdown()
+{
+    if( m_pDepth )
+    {
+        DefaultAllocator().FreeAligned( m_pDepth );
+        m_pDepth = NULL;
+    }
+
+    m_width = 0;
+    m_height = 0;
+}
+
+/// Clear the depth buffer in preparation for rasterizing a new set of occluders.
+///
+/// @param[in] rViewProjection  World-to-clip space transform used for rasterizing occluders and testing visibility.
+///
+/// @see RasterizeOccluder(), IsVisible()
+void OcclusionBuffer::Clear( const Simd::Matrix44& rViewProjection )
+{
+    HELIUM_ASSERT( m_pDepth );
+
+    m_viewProjection = rViewProjection;
+
+    float32_t clearDepth = NumericLimits< float32_t >::Maximum;
+    size_t pixelCount = static_cast< size_t >( m_width ) * m_height;
+    for( size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex )
+    {
+        m_pDepth[ pixelIndex ] = clearDepth;
+    }
+}
+
+/// Rasterize the faces of a box-shaped occluder into the depth buffer.
+///
+/// The box should lie entirely within the solid geometry of the occluding object.  Faces are clipped against the near
+/// plane, so occluders surrounding the camera are handled correctly.
+///
+/// @param[in] rLocalBox   Occluder bounds in the local space of the occluding object.
+/// @param[in] rTransform  Local-to-world space transform of the occluding object.
+///
+/// @see Clear(), IsVisible()
+void OcclusionBuffer::RasterizeOccluder( const Simd::AaBox& rLocalBox, const Simd::Matrix44& rTransform )
+{
+    HELIUM_ASSERT( m_pDepth );
+
+    Simd::Matrix44 localToClip;
+    localToClip.MultiplySet( rTransform, m_viewProjection );
+
+    float32_t matrix[ 16 ];
+    GetMatrixElements( localToClip, matrix );
+
+    float32_t corners[ 8 ][ 4 ];
+    TransformBoxCorners( rLocalBox, matrix, corners );
+
+    float32_t halfWidth = static_cast< float32_t >( m_width ) * 0.5f;
+    float32_t halfHeight = static_cast< float32_t >( m_height ) * 0.5f;
+
+    // Faces are rasterized regardless of their orientation; back faces are always farther than the front faces covering
+    // them, so they never affect the final depth.
+    for( size_t faceIndex = 0; faceIndex < HELIUM_ARRAY_COUNT( BOX_FACE_CORNERS ); ++faceIndex )
+    {
+        const uint8_t* pFaceCorners = BOX_FACE_CORNERS[ faceIndex ];
+
+        // Clip the face against the near plane (z >= 0 in clip space).
+        float32_t clipped[ CLIPPED_FACE_VERTEX_COUNT_MAX ][ 4 ];
+        size_t clippedCount = 0;
+        for( size_t edgeIndex = 0; edgeIndex < 4; ++edgeIndex )
+        {
+            const float32_t* pStart = corners[ pFaceCorners[ edgeIndex ] ];
+            const float32_t* pEnd = corners[ pFaceCorners[ ( edgeIndex + 1 ) & 3 ] ];
+
+            bool bStartInside = ( pStart[ 2 ] >= 0.0f );
+            bool bEndInside = ( pEnd[ 2 ] >= 0.0f );
+            if( bStartInside )
+            {
+                HELIUM_ASSERT( clippedCount < CLIPPED_FACE_VERTEX_COUNT_MAX );
+                MemoryCopy( clipped[ clippedCount ], pStart, sizeof( clipped[ 0 ] ) );
+                ++clippedCount;
+            }
+
+            if( bStartInside != bEndInside )
+            {
+                HELIUM_ASSERT( clippedCount < CLIPPED_FACE_VERTEX_COUNT_MAX );
+                float32_t t = pStart[ 2 ] / ( pStart[ 2 ] - pEnd[ 2 ] );
+                for( size_t componentIndex = 0; componentIndex < 4; ++componentIndex )
+                {
+                    clipped[ clippedCount ][ componentIndex ] =
+                        pStart[ componentIndex ] + ( pEnd[ componentIndex ] - pStart[ componentIndex ] ) * t;
+                }
+
+                ++clippedCount;
+            }
+        }
+
+        if( clippedCount < 3 )
+        {
+            continue;
+        }
+
+        // Project the clipped face into screen space and rasterize it as a triangle fan.
+        float32_t screen[ CLIPPED_FACE_VERTEX_COUNT_MAX ][ 3 ];
+        for( size_t vertexIndex = 0; vertexIndex < clippedCount; ++vertexIndex )
+        {
+            const float32_t* pClip = clipped[ vertexIndex ];
+            float32_t inverseW = 1.0f / Max( pClip[ 3 ], HELIUM_EPSILON );
+
+            float32_t* pScreen = screen[ vertexIndex ];
+            pScreen[ 0 ] = ( pClip[ 0 ] * inverseW + 1.0f ) * halfWidth;
+            pScreen[ 1 ] = ( 1.0f - pClip[ 1 ] * inverseW ) * halfHeight;
+            pScreen[ 2 ] = pClip[ 2 ] * inverseW;
+        }
+
+        for( size_t vertexIndex = 2; vertexIndex < clippedCount; ++vertexIndex )
+        {
+            RasterizeTriangle( screen[ 0 ], screen[ vertexIndex - 1 ], screen[ vertexIndex ] );
+        }
+    }
+}
+
+/// Test whether an object may be visible given the occluders rasterized since the buffer was last cleared.
+///
+/// @param[in] rWorldBox  World-space bounds of the object to test.
+///
+/// @return  False if the object is completely hidden by the occluders or lies outside the screen, true if it may be
+///          visible.
+///
+/// @see Clear(), RasterizeOccluder()
+bool OcclusionBuffer::IsVisible( const Simd::AaBox& rWorldBox ) const
+{
+    HELIUM_ASSERT( m_pDepth );
+
+    float32_t matrix[ 16 ];
+    GetMatrixElements( m_viewProjection, matrix );
+
+    float32_t corners[ 8 ][ 4 ];
+    TransformBoxCorners( rWorldBox, matrix, corners );
+
+    float32_t halfWidth = static_cast< float32_t >( m_width ) * 0.5f;
+    float32_t halfHeight = static_cast< float32_t >( m_height ) * 0.5f;
+
+    float32_t minX = NumericLimits< float32_t >::Maximum;
+    float32_t minY = NumericLimits< float32_t >::Maximum;
+    float32_t minZ = NumericLimits< float32_t >::Maximum;
+    float32_t maxX = -NumericLimits< float32_t >::Maximum;
+    float32_t maxY = -NumericLimits< float32_t >::Maximum;
+    for( size_t cornerIndex = 0; cornerIndex < 8; ++cornerIndex )
+    {
+        const float32_t* pCorner = corners[ cornerIndex ];
+
+        // Objects crossing the near plane are always treated as visible.
+        if( pCorner[ 2 ] < 0.0f || pCorner[ 3 ] <= HELIUM_EPSILON )
+        {
+            return true;
+        }
+
+        float32_t inverseW = 1.0f / pCorner[ 3 ];
+        float32_t x = ( pCorner[ 0 ] * inverseW + 1.0f ) * halfWidth;
+        float32_t y = ( 1.0f - pCorner[ 1 ] * inverseW ) * halfHeight;
+        float32_t z = pCorner[ 2 ] * inverseW;
+
+        minX = Min( minX, x );
+        minY = Min( minY, y );
+        minZ = Min( minZ, z );
+        maxX = Max( maxX, x );
+        maxY = Max( maxY, y );
+    }
+
+    minX = Max( minX, 0.0f );
+    minY = Max( minY, 0.0f );
+    maxX = Min( maxX, static_cast< float32_t >( m_width ) );
+    maxY = Min( maxY, static_cast< float32_t >( m_height ) );
+    if( minX >= maxX || minY >= maxY )
+    {
+        return false;
+    }
+
+    // Test every pixel touched by the projected bounds, stopping at the first one that is not covered by an occluder
+    // closer than the nearest point of the object.
+    uint32_t startX = static_cast< uint32_t >( minX ) & ~static_cast< uint32_t >( 3 );
+    uint32_t endX = Min( static_cast< uint32_t >( maxX ) + 1, m_width );
+    uint32_t startY = static_cast< uint32_t >( minY );
+    uint32_t endY = Min( static_cast< uint32_t >( maxY ) + 1, m_height );
+
+#if HELIUM_SIMD_SSE
+    __m128 nearestDepth = _mm_set1_ps( minZ );
+#endif
+
+    for( uint32_t y = startY; y < endY; ++y )
+    {
+        const float32_t* pRow = m_pDepth + static_cast< size_t >( y ) * m_width;
+
+#if HELIUM_SIMD_SSE
+        for( uint32_t x = startX; x < endX; x += 4 )
+        {
+            __m128 depth = _mm_load_ps( pRow + x );
+            if( _mm_movemask_ps( _mm_cmpge_ps( depth, nearestDepth ) ) != 0 )
+            {
+                return true;
+            }
+        }
+#else
+        for( uint32_t x = startX; x < endX; ++x )
+        {
+            if( pRow[ x ] >= minZ )
+            {
+                return true;
+            }
+        }
+#endif
+    }
+
+    return false;
+}
+
+/// Rasterize a screen-space triangle into the depth buffer.
+///
+/// Only pixels completely covered by the triangle are written, using the farthest depth of the triangle within each
+/// pixel.  Triangles are rasterized regardless of their winding order.
+///
+/// @param[in] pVertex0  Screen-space position and depth of the first vertex.
+/// @param[in] pVertex1  Screen-space position and depth of the second vertex.
+/// @param[in] pVertex2  Screen-space position and depth of the third vertex.
+void OcclusionBuffer::RasterizeTriangle(
+    const float32_t* pVertex0,
+    const float32_t* pVertex1,
+    const float32_t* pVertex2 )
+{
+    float32_t x0 = pVertex0[ 0 ];
+    float32_t y0 = pVertex0[ 1 ];
+    float32_t z0 = pVertex0[ 2 ];
+    float32_t x1 = pVertex1[ 0 ];
+    float32_t y1 = pVertex1[ 1 ];
+    float32_t z1 = pVertex1[ 2 ];
+    float32_t x2 = pVertex2[ 0 ];
+    float32_t y2 = pVertex2[ 1 ];
+    float32_t z2 = pVertex2[ 2 ];
+
+    float32_t area = ( x1 - x0 ) * ( y2 - y0 ) - ( x2 - x0 ) * ( y1 - y0 );
+    if( Abs( area ) <= HELIUM_EPSILON )
+    {
+        return;
+    }
+
+    // Compute the range of pixels that may be completely covered by the triangle.
+    float32_t minX = Max( Min( x0, Min( x1, x2 ) ), 0.0f );
+    float32_t minY = Max( Min( y0, Min( y1, y2 ) ), 0.0f );
+    float32_t maxX = Min( Max( x0, Max( x1, x2 ) ), static_cast< float32_t >( m_width ) );
+    float32_t maxY = Min( Max( y0, Max( y1, y2 ) ), static_cast< float32_t >( m_height ) );
+    if( minX >= maxX || minY >= maxY )
+    {
+        return;
+    }
+
+    uint32_t startX = static_cast< uint32_t >( minX ) & ~static_cast< uint32_t >( 3 );
+    uint32_t endX = static_cast< uint32_t >( maxX );
+    uint32_t startY = static_cast< uint32_t >( minY );
+    uint32_t endY = static_cast< uint32_t >( maxY );
+
+    // Set up the edge functions so that they are non-negative inside the triangle, then offset them so that they are
+    // only non-negative at pixel centers whose entire pixel lies inside the triangle.
+    float32_t edgeSign = ( area > 0.0f ? 1.0f : -1.0f );
+
+    float32_t edgeA[ 3 ] =
+    {
+        ( y1 - y2 ) * edgeSign,
+        ( y2 - y0 ) * edgeSign,
+        ( y0 - y1 ) * edgeSign
+    };
+    float32_t edgeB[ 3 ] =
+    {
+        ( x2 - x1 ) * edgeSign,
+        ( x0 - x2 ) * edgeSign,
+        ( x1 - x0 ) * edgeSign
+    };
+    float32_t edgeC[ 3 ] =
+    {
+        ( x1 * y2 - y1 * x2 ) * edgeSign,
+        ( x2 * y0 - y2 * x0 ) * edgeSign,
+        ( x0 * y1 - y0 * x1 ) * edgeSign
+    };
+
+    for( size_t edgeIndex = 0; edgeIndex < 3; ++edgeIndex )
+    {
+        edgeC[ edgeIndex ] -= 0.5f * ( Abs( edgeA[ edgeIndex ] ) + Abs( edgeB[ edgeIndex ] ) );
+    }
+
+    // Set up the depth plane, offset to give the farthest depth within each pixel (clamped to the farthest vertex to
+    // guard against precision issues with sliver triangles).
+    float32_t inverseArea = 1.0f / area;
+    float32_t depthDx = ( ( z1 - z0 ) * ( y2 - y0 ) - ( z2 - z0 ) * ( y1 - y0 ) ) * inverseArea;
+    float32_t depthDy = ( ( z2 - z0 ) * ( x1 - x0 ) - ( z1 - z0 ) * ( x2 - x0 ) ) * inverseArea;
+    float32_t depthC = z0 - depthDx * x0 - depthDy * y0 + 0.5f * ( Abs( depthDx ) + Abs( depthDy ) );
+    float32_t depthMax = Max( z0, Max( z1, z2 ) );
+
+#if HELIUM_SIMD_SSE
+    __m128 zero = _mm_setzero_ps();
+    __m128 laneOffsets = _mm_set_ps( 3.5f, 2.5f, 1.5f, 0.5f );
+    __m128 stepX = _mm_set1_ps( 4.0f );
+
+    __m128 edgeA0 = _mm_set1_ps( edgeA[ 0 ] );
+    __m128 edgeA1 = _mm_set1_ps( edgeA[ 1 ] );
+    __m128 edgeA2 = _mm_set1_ps( edgeA[ 2 ] );
+    __m128 depthA = _mm_set1_ps( depthDx );
+    __m128 depthMaxVector = _mm_set1_ps( depthMax );
+#endif
+
+    for( uint32_t y = startY; y < endY; ++y )
+    {
+        float32_t centerY = static_cast< float32_t >( y ) + 0.5f;
+        float32_t* pRow = m_pDepth + static_cast< size_t >( y ) * m_width;
+
+        float32_t rowEdge0 = edgeB[ 0 ] * centerY + edgeC[ 0 ];
+        float32_t rowEdge1 = edgeB[ 1 ] * centerY + edgeC[ 1 ];
+        float32_t rowEdge2 = edgeB[ 2 ] * centerY + edgeC[ 2 ];
+        float32_t rowDepth = depthDy * centerY + depthC;
+
+#if HELIUM_SIMD_SSE
+        // The buffer width is a multiple of four, so groups of four pixels never run past the end of a row.
+        __m128 rowEdge0Vector = _mm_set1_ps( rowEdge0 );
+        __m128 rowEdge1Vector = _mm_set1_ps( rowEdge1 );
+        __m128 rowEdge2Vector = _mm_set1_ps( rowEdge2 );
+        __m128 rowDepthVector = _mm_set1_ps( rowDepth );
+
+        __m128 centerX = _mm_add_ps( _mm_set1_ps( static_cast< float32_t >( startX ) ), laneOffsets );
+        for( uint32_t x = startX; x < endX; x += 4 )
+        {
+            __m128 edge0 = _mm_add_ps( _mm_mul_ps( edgeA0, centerX ), rowEdge0Vector );
+            __m128 edge1 = _mm_add_ps( _mm_mul_ps( edgeA1, centerX ), rowEdge1Vector );
+            __m128 edge2 = _mm_add_ps( _mm_mul_ps( edgeA2, centerX ), rowEdge2Vector );
+
+            __m128 mask = _mm_and_ps(
+                _mm_and_ps( _mm_cmpge_ps( edge0, zero ), _mm_cmpge_ps( edge1, zero ) ),
+                _mm_cmpge_ps( edge2, zero ) );
+            if( _mm_movemask_ps( mask ) != 0 )
+            {
+                __m128 depth = _mm_add_ps( _mm_mul_ps( depthA, centerX ), rowDepthVector );
+                depth = _mm_min_ps( depth, depthMaxVector );
+                __m128 currentDepth = _mm_load_ps( pRow + x );
+                depth = _mm_min_ps( depth, currentDepth );
+                _mm_store_ps( pRow + x, _mm_or_ps( _mm_and_ps( mask, depth ), _mm_andnot_ps( mask, currentDepth ) ) );
+            }
+
+            centerX = _mm_add_ps( centerX, stepX );
+        }
+#else
+        for( uint32_t x = startX; x < endX; ++x )
+        {
+            float32_t centerX = static_cast< float32_t >( x ) + 0.5f;
+            if( edgeA[ 0 ] * centerX + rowEdge0 >= 0.0f &&
+                edgeA[ 1 ] * centerX + rowEdge1 >= 0.0f &&
+                edgeA[ 2 ] * centerX + rowEdge2 >= 0.0f )
+            {
+                float32_t depth = Min( depthDx * centerX + rowDepth, depthMax );
+                pRow[ x ] = Min( pRow[ x ], depth );
+            }
+        }
+#endif
+    }
+}
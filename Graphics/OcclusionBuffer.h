@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "MathSimd/AaBox.h"
+#include "MathSimd/Matrix44.h"
+
+namespace Helium
+{
+    /// Low-resolution software depth buffer used for CPU occlusion culling.
+    ///
+    /// Occluders are rasterized conservatively: only pixels completely covered by an occluder are written, and each
+    /// pixel receives the farthest depth of the occluder within it.  An object reported as hidden by IsVisible() is
+    /// therefore hidden at any higher resolution as well.
+    HELIUM_SIMD_ALIGN_PRE class HELIUM_GRAPHICS_API OcclusionBuffer : NonCopyable
+    {
+    public:
+        /// Default buffer width, in pixels.
+        static const uint32_t DEFAULT_WIDTH = 256;
+        /// Default buffer height, in pixels.
+        static const uint32_t DEFAULT_HEIGHT = 128;
+
+        /// @name Construction/Destruction
+        //@{
+        OcclusionBuffer();
+        ~OcclusionBuffer();
+        //@}
+
+        /// @name Initialization
+        //@{
+        bool Initialize( uint32_t width = DEFAULT_WIDTH, uint32_t height = DEFAULT_HEIGHT );
+        void Shutdown();
+
+        inline bool IsInitialized() const;
+        inline uint32_t GetWidth() const;
+        inline uint32_t GetHeight() const;
+        //@}
+
+        /// @name Rendering
+        //@{
+        void Clear( const Simd::Matrix44& rViewProjection );
+        void RasterizeOccluder( const Simd::AaBox& rLocalBox, const Simd::Matrix44& rTransform );
+        //@}
+
+        /// @name Visibility Testing
+        //@{
+        bool IsVisible( const Simd::AaBox& rWorldBox ) const;
+        //@}
+
+    private:
+        /// World-to-clip space transform for the current contents.
+        Simd::Matrix44 m_viewProjection;
+
+        /// Depth buffer (post-projection depth, one value per pixel).
+        float32_t* m_pDepth;
+        /// Buffer width, in pixels (always a multiple of four).
+        uint32_t m_width;
+        /// Buffer height, in pixels.
+        uint32_t m_height;
+
+        /// @name Private Utility Functions
+        //@{
+        void RasterizeTriangle( const float32_t* pVertex0, const float32_t* pVertex1, const float32_t* pVertex2 );
+        //@}
+    } HELIUM_SIMD_ALIGN_POST;
+}
+
+#include "Graphics/OcclusionBuffer.inl"
@@ -0,0 +1,32 @@
+namespace Helium
+{
+    /// Get whether the depth buffer has been allocated.
+    ///
+    /// @return  True if Initialize() has been called successfully, false if not.
+    ///
+    /// @see Initialize(), Shutdown()
+    bool OcclusionBuffer::IsInitialized() const
+    {
+        return ( m_pDepth != NULL );
+    }
+
+    /// Get the width of the depth buffer.
+    ///
+    /// @return  Buffer width, in pixels.
+    ///
+    /// @see GetHeight()
+    uint32_t OcclusionBuffer::GetWidth() const
+    {
+        return m_width;
+    }
+
+    /// Get the height of the depth buffer.
+    ///
+    /// @return  Buffer height, in pixels.
+    ///
+    /// @see GetWidth()
+    uint32_t OcclusionBuffer::GetHeight() const
+    {
+        return m_height;
+    }
+}
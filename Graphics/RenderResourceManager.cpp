@@ -24,6 +24,9 @@ RenderResourceManager::RenderResourceManager()
     , m_viewportWidthMax( 0 )
     , m_viewportHeightMax( 0 )
     , m_shadowDepthTextureUsableSize( 0 )
+    , m_shadowCascadeCount( 0 )
+    , m_shadowDepthTextureGeneration( 0 )
+    , m_bOcclusionCulling( false )
 {
 }
 
@@ -519,6 +522,8 @@ void RenderResourceManager::PostConfigUpdate()
 
     m_shadowMode = GraphicsConfig::EShadowMode::NONE;
     m_shadowDepthTextureUsableSize = 0;
+    m_shadowCascadeCount = 0;
+    m_bOcclusionCulling = false;
 
     // Get the renderer and graphics configuration.
     Renderer* pRenderer = Renderer::GetStaticInstance();
@@ -582,6 +587,7 @@ void RenderResourceManager::PostConfigUpdate()
     // Store shadow buffer settings.
     GraphicsConfig::EShadowMode shadowMode = GraphicsConfig::EShadowMode::NONE;
     uint32_t shadowBufferUsableSize = 0;
+    uint32_t shadowCascadeCount = 0;
 
     if( pRenderer->SupportsAnyFeature( RENDERER_FEATURE_FLAG_DEPTH_TEXTURE ) )
     {
@@ -589,11 +595,18 @@ void RenderResourceManager::PostConfigUpdate()
         if( shadowMode != GraphicsConfig::EShadowMode::INVALID && shadowMode != GraphicsConfig::EShadowMode::NONE )
         {
             shadowBufferUsableSize = spGraphicsConfig->GetShadowBufferSize();
+            shadowCascadeCount = Clamp(
+                spGraphicsConfig->GetShadowCascadeCount(),
+                static_cast< uint32_t >( 1 ),
+                GraphicsConfig::SHADOW_CASCADE_COUNT_MAX );
         }
     }
 
     m_shadowMode = shadowMode;
     m_shadowDepthTextureUsableSize = shadowBufferUsableSize;
+    m_shadowCascadeCount = shadowCascadeCount;
+
+    m_bOcclusionCulling = spGraphicsConfig->GetOcclusionCulling();
 
     // Recreate render and depth targets.
     UpdateMaxViewportSize( spGraphicsConfig->m_width, spGraphicsConfig->m_height );
@@ -617,6 +630,8 @@ void RenderResourceManager::UpdateMaxViewportSize( uint32_t width, uint32_t heig
     m_spShadowDepthTexture.Release();
     m_spSceneTexture.Release();
 
+    InvalidateShadowDepthTextureContents();
+
     Renderer* pRenderer = Renderer::GetStaticInstance();
     if( !pRenderer )
     {
@@ -624,6 +639,7 @@ void RenderResourceManager::UpdateMaxViewportSize( uint32_t width, uint32_t heig
         m_viewportHeightMax = 0;
         m_shadowMode = GraphicsConfig::EShadowMode::NONE;
         m_shadowDepthTextureUsableSize = 0;
+        m_shadowCascadeCount = 0;
 
         return;
     }
@@ -932,6 +948,20 @@ Font* RenderResourceManager::GetDebugFont( EDebugFontSize size ) const
     return m_debugFonts[ size ];
 }
 
+/// Invalidate the contents of the shared shadow depth texture for every user other than the caller.
+///
+/// This should be called before rendering into the shadow depth texture, as well as whenever its contents are lost.
+/// Any shadow cascade tiles cached by other scenes or views against the previous generation can no longer be reused.
+///
+/// @return  New shadow depth texture generation, which the caller can compare against GetShadowDepthTextureGeneration()
+///          later on to determine whether its own tiles are still intact.
+///
+/// @see GetShadowDepthTextureGeneration()
+uint32_t RenderResourceManager::InvalidateShadowDepthTextureContents()
+{
+    return ++m_shadowDepthTextureGeneration;
+}
+
 /// Get the singleton RenderResourceManager instance, creating it if necessary.
 ///
 /// @return  Reference to the RenderResourceManager instance.
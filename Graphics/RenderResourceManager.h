@@ -171,6 +171,10 @@ namespace Helium
 
         inline GraphicsConfig::EShadowMode GetShadowMode() const;
         inline uint32_t GetShadowDepthTextureUsableSize() const;
+        inline uint32_t GetShadowCascadeCount() const;
+        inline uint32_t GetShadowDepthTextureGeneration() const;
+        uint32_t InvalidateShadowDepthTextureContents();
+        inline bool GetOcclusionCullingEnabled() const;
         //@}
 
         /// @name Static Access
@@ -238,6 +242,12 @@ namespace Helium
 
         /// Shadow depth texture usable size (cached from graphics config object value).
         uint32_t m_shadowDepthTextureUsableSize;
+        /// Number of shadow cascades packed into the usable area of the shadow depth texture.
+        uint32_t m_shadowCascadeCount;
+        /// Counter incremented whenever the shadow depth texture is created, lost, or rendered into by a new owner.
+        uint32_t m_shadowDepthTextureGeneration;
+        /// True if CPU occlusion culling is enabled (cached from graphics config object value).
+        bool m_bOcclusionCulling;
 
         /// Singleton instance.
         static RenderResourceManager* sm_pInstance;
@@ -18,4 +18,38 @@ namespace Helium
     {
         return m_shadowDepthTextureUsableSize;
     }
+
+    /// Get the number of shadow map cascades rendered for each view.
+    ///
+    /// @return  Shadow cascade count (between 1 and GraphicsConfig::SHADOW_CASCADE_COUNT_MAX), or zero if shadows are
+    ///          disabled.
+    ///
+    /// @see GetShadowDepthTextureUsableSize()
+    uint32_t RenderResourceManager::GetShadowCascadeCount() const
+    {
+        return m_shadowCascadeCount;
+    }
+
+    /// Get the current generation of the shadow depth texture contents.
+    ///
+    /// The shadow depth texture is shared by all graphics scenes and views.  A scene that caches shadow cascade tiles
+    /// across frames can only reuse them if the generation still matches the one returned when it last claimed the
+    /// texture for rendering.
+    ///
+    /// @return  Shadow depth texture generation.
+    ///
+    /// @see InvalidateShadowDepthTextureContents(), GetShadowDepthTexture()
+    uint32_t RenderResourceManager::GetShadowDepthTextureGeneration() const
+    {
+        return m_shadowDepthTextureGeneration;
+    }
+
+    /// Get whether objects hidden behind large occluders should be culled on the CPU.
+    ///
+    /// @return  True if occlusion culling is enabled, false if not.  This is cached from the graphics configuration
+    ///          settings for easy access.
+    bool RenderResourceManager::GetOcclusionCullingEnabled() const
+    {
+        return m_bOcclusionCulling;
+    }
 }
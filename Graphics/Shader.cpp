@@ -31,6 +31,28 @@ Shader::BEGIN_LOAD_VARIANT_FUNC* Shader::sm_pBeginLoadVariantOverride = NULL;
 Shader::TRY_FINISH_LOAD_VARIANT_FUNC* Shader::sm_pTryFinishLoadVariantOverride = NULL;
 void* Shader::sm_pVariantLoadOverrideData = NULL;
 
+/// Get whether a toggle value in a mixed toggle/selection option pair list disables the toggle.
+///
+/// @param[in] value  Toggle value.
+///
+/// @return  True if the value disables the toggle, false if it enables it.
+static bool IsDisabledToggleValue( Name value )
+{
+    static const Name disabledToggleValues[] = { Name( NULL_NAME ), Name( TXT( "0" ) ), Name( TXT( "false" ) ) };
+
+    for( size_t disabledValueIndex = 0;
+        disabledValueIndex < HELIUM_ARRAY_COUNT( disabledToggleValues );
+        ++disabledValueIndex )
+    {
+        if( value == disabledToggleValues[ disabledValueIndex ] )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 
 CompiledShaderData::CompiledShaderData()
 {
@@ -143,6 +165,13 @@ void Shader::Options::PopulateMetaType( Reflect::MetaStruct& comp )
     comp.AddField( &Shader::Options::m_selects,  TXT( "m_selects" ) );
 }
 
+/// Constructor.
+Shader::Options::Options()
+: m_bOptionMasksCompiled( false )
+{
+    MemoryZero( m_maskBaseIndices, sizeof( m_maskBaseIndices ) );
+}
+
 /// Constructor.
 Shader::Shader()
 : m_bPrecacheAllVariants( false )
@@ -357,6 +386,8 @@ void Shader::SetVariantLoadOverride(
 /// @param[in] selectPairCount  Number of shader selection pair values in the given array.
 ///
 /// @return  Index to use for the specified options.
+///
+/// @see GetOptionMask()
 size_t Shader::Options::GetOptionSetIndex(
     RShader::EType shaderType,
     const Name* pToggleNames,
@@ -459,6 +490,8 @@ size_t Shader::Options::GetOptionSetIndex(
 /// @param[in] optionPairCount  Number of options in the option pair array.
 ///
 /// @return  Index to use for the specified options.
+///
+/// @see GetOptionMask()
 size_t Shader::Options::GetOptionSetIndex(
     RShader::EType shaderType,
     const SelectPair* pOptionPairs,
@@ -472,8 +505,6 @@ size_t Shader::Options::GetOptionSetIndex(
     size_t optionIndex = 0;
     size_t optionIndexMultiplier = 1;
 
-    static const Name disabledToggleValues[] = { Name( NULL_NAME ), Name( TXT( "0" ) ), Name( TXT( "false" ) ) };
-
     size_t shaderToggleCount = m_toggles.GetSize();
     for( size_t shaderToggleIndex = 0; shaderToggleIndex < shaderToggleCount; ++shaderToggleIndex )
     {
@@ -490,20 +521,7 @@ size_t Shader::Options::GetOptionSetIndex(
             const SelectPair& rOptionPair = pOptionPairs[ optionPairIndex ];
             if( rOptionPair.name == shaderToggleName )
             {
-                Name value = rOptionPair.choice;
-
-                size_t disabledValueIndex;
-                for( disabledValueIndex = 0;
-                    disabledValueIndex < HELIUM_ARRAY_COUNT( disabledToggleValues );
-                    ++disabledValueIndex )
-                {
-                    if( value == disabledToggleValues[ disabledValueIndex ] )
-                    {
-                        break;
-                    }
-                }
-
-                if( disabledValueIndex >= HELIUM_ARRAY_COUNT( disabledToggleValues ) )
+                if( !IsDisabledToggleValue( rOptionPair.choice ) )
                 {
                     optionIndex |= optionIndexMultiplier;
                 }
@@ -672,6 +690,282 @@ size_t Shader::Options::ComputeOptionSetCount( RShader::EType shaderType ) const
     return optionSetCount;
 }
 
+/// Build the tables used to convert option masks to option set indices.
+///
+/// This must be called whenever the toggle or selection lists are modified, and is performed automatically when a
+/// shader's persistent resource data is loaded.  Each toggle and selection choice is assigned an option mask bit in
+/// declaration order, and the option set index contributed by every combination of each group of four bits is
+/// precomputed for each shader type, so that resolving an index only requires one table lookup per group.
+///
+/// @see GetOptionMask(), GetOptionSetIndex()
+void Shader::Options::CompileOptionMasks()
+{
+    size_t optionBitCount = 0;
+
+    for( size_t shaderTypeIndex = 0; shaderTypeIndex < static_cast< size_t >( RShader::TYPE_MAX ); ++shaderTypeIndex )
+    {
+        uint32_t shaderTypeMask = ( 1 << shaderTypeIndex );
+
+        // Compute the option set index offset for each individual bit.  Selection choice offsets are relative to
+        // the index used when no choice is made, which is included in the base index.
+        uint32_t bitIndexOffsets[ OPTION_MASK_BIT_COUNT ];
+        MemoryZero( bitIndexOffsets, sizeof( bitIndexOffsets ) );
+
+        uint32_t baseIndex = 0;
+        uint32_t optionIndexMultiplier = 1;
+        size_t bitIndex = 0;
+
+        size_t shaderToggleCount = m_toggles.GetSize();
+        for( size_t shaderToggleIndex = 0; shaderToggleIndex < shaderToggleCount; ++shaderToggleIndex, ++bitIndex )
+        {
+            const Toggle& rShaderToggle = m_toggles[ shaderToggleIndex ];
+            if( !( rShaderToggle.shaderTypeFlags & shaderTypeMask ) )
+            {
+                continue;
+            }
+
+            if( bitIndex < OPTION_MASK_BIT_COUNT )
+            {
+                bitIndexOffsets[ bitIndex ] = optionIndexMultiplier;
+            }
+
+            optionIndexMultiplier <<= 1;
+        }
+
+        size_t shaderSelectCount = m_selects.GetSize();
+        for( size_t shaderSelectIndex = 0; shaderSelectIndex < shaderSelectCount; ++shaderSelectIndex )
+        {
+            const Select& rShaderSelect = m_selects[ shaderSelectIndex ];
+            uint32_t shaderSelectChoiceCount = static_cast< uint32_t >( rShaderSelect.choices.GetSize() );
+
+            if( rShaderSelect.shaderTypeFlags & shaderTypeMask )
+            {
+                uint32_t unsetIndexOffset =
+                    ( rShaderSelect.bOptional ? shaderSelectChoiceCount * optionIndexMultiplier : 0 );
+                baseIndex += unsetIndexOffset;
+
+                for( uint32_t choiceIndex = 0; choiceIndex < shaderSelectChoiceCount; ++choiceIndex )
+                {
+                    if( bitIndex + choiceIndex < OPTION_MASK_BIT_COUNT )
+                    {
+                        // Relies on unsigned wrap-around for choices that come before the unset index.
+                        bitIndexOffsets[ bitIndex + choiceIndex ] =
+                            choiceIndex * optionIndexMultiplier - unsetIndexOffset;
+                    }
+                }
+
+                optionIndexMultiplier *= shaderSelectChoiceCount + rShaderSelect.bOptional;
+            }
+
+            bitIndex += shaderSelectChoiceCount;
+        }
+
+        optionBitCount = bitIndex;
+
+        // Expand the per-bit offsets into lookup tables for each group of four bits.
+        size_t usedBitCount = bitIndex;
+        if( usedBitCount > OPTION_MASK_BIT_COUNT )
+        {
+            usedBitCount = OPTION_MASK_BIT_COUNT;
+        }
+
+        size_t nibbleCount = ( usedBitCount + 3 ) / 4;
+
+        DynamicArray< uint32_t >& rNibbleIndexOffsets = m_maskNibbleIndexOffsets[ shaderTypeIndex ];
+        rNibbleIndexOffsets.Resize( nibbleCount * 16 );
+        rNibbleIndexOffsets.Trim();
+
+        for( size_t nibbleIndex = 0; nibbleIndex < nibbleCount; ++nibbleIndex )
+        {
+            const uint32_t* pNibbleBitOffsets = bitIndexOffsets + nibbleIndex * 4;
+            for( uint32_t nibbleValue = 0; nibbleValue < 16; ++nibbleValue )
+            {
+                uint32_t indexOffset = 0;
+                for( uint32_t nibbleBit = 0; nibbleBit < 4; ++nibbleBit )
+                {
+                    if( nibbleValue & ( 1 << nibbleBit ) )
+                    {
+                        indexOffset += pNibbleBitOffsets[ nibbleBit ];
+                    }
+                }
+
+                rNibbleIndexOffsets[ nibbleIndex * 16 + nibbleValue ] = indexOffset;
+            }
+        }
+
+        m_maskBaseIndices[ shaderTypeIndex ] = baseIndex;
+    }
+
+    if( optionBitCount > OPTION_MASK_BIT_COUNT )
+    {
+        HELIUM_TRACE(
+            TraceLevels::Warning,
+            ( TXT( "Shader::Options::CompileOptionMasks(): %" ) PRIuSZ TXT( " toggles and selection choices " )
+            TXT( "specified, but only the first %" ) PRIuSZ TXT( " can be represented in option masks.\n" ) ),
+            optionBitCount,
+            OPTION_MASK_BIT_COUNT );
+    }
+
+    m_bOptionMasksCompiled = true;
+}
+
+/// Build the option mask for a specific set of shader preprocessor options.
+///
+/// Option masks can be computed once and reused for any number of option set index lookups using
+/// GetOptionSetIndex().  Unknown options are ignored, and only the first matching choice is used for each selection.
+///
+/// @param[in] pToggleNames     List of enabled shader toggles.
+/// @param[in] toggleNameCount  Number of names in the toggle name array.
+/// @param[in] pSelectPairs     List of shader selection pair values.
+/// @param[in] selectPairCount  Number of shader selection pair values in the given array.
+///
+/// @return  Option mask for the specified options.
+///
+/// @see CompileOptionMasks(), GetOptionSetIndex()
+Shader::Options::OptionMask Shader::Options::GetOptionMask(
+    const Name* pToggleNames,
+    size_t toggleNameCount,
+    const SelectPair* pSelectPairs,
+    size_t selectPairCount ) const
+{
+    HELIUM_ASSERT( pToggleNames || toggleNameCount == 0 );
+    HELIUM_ASSERT( pSelectPairs || selectPairCount == 0 );
+
+    OptionMask optionMask = 0;
+    size_t bitIndex = 0;
+
+    size_t shaderToggleCount = m_toggles.GetSize();
+    for( size_t shaderToggleIndex = 0; shaderToggleIndex < shaderToggleCount; ++shaderToggleIndex, ++bitIndex )
+    {
+        Name shaderToggleName = m_toggles[ shaderToggleIndex ].name;
+        for( size_t enabledToggleIndex = 0; enabledToggleIndex < toggleNameCount; ++enabledToggleIndex )
+        {
+            if( pToggleNames[ enabledToggleIndex ] == shaderToggleName )
+            {
+                if( bitIndex < OPTION_MASK_BIT_COUNT )
+                {
+                    optionMask |= static_cast< OptionMask >( 1 ) << bitIndex;
+                }
+
+                break;
+            }
+        }
+    }
+
+    size_t shaderSelectCount = m_selects.GetSize();
+    for( size_t shaderSelectIndex = 0; shaderSelectIndex < shaderSelectCount; ++shaderSelectIndex )
+    {
+        const Select& rShaderSelect = m_selects[ shaderSelectIndex ];
+        const DynamicArray< Name >& rShaderSelectChoices = rShaderSelect.choices;
+        size_t shaderSelectChoiceCount = rShaderSelectChoices.GetSize();
+
+        for( size_t selectPairIndex = 0; selectPairIndex < selectPairCount; ++selectPairIndex )
+        {
+            const SelectPair& rPair = pSelectPairs[ selectPairIndex ];
+            if( rPair.name == rShaderSelect.name )
+            {
+                Name targetChoiceName = rPair.choice;
+                if( !targetChoiceName.IsEmpty() )
+                {
+                    for( size_t choiceIndex = 0; choiceIndex < shaderSelectChoiceCount; ++choiceIndex )
+                    {
+                        if( rShaderSelectChoices[ choiceIndex ] == targetChoiceName )
+                        {
+                            if( bitIndex + choiceIndex < OPTION_MASK_BIT_COUNT )
+                            {
+                                optionMask |= static_cast< OptionMask >( 1 ) << ( bitIndex + choiceIndex );
+                            }
+
+                            break;
+                        }
+                    }
+                }
+
+                break;
+            }
+        }
+
+        bitIndex += shaderSelectChoiceCount;
+    }
+
+    return optionMask;
+}
+
+/// Build the option mask for a specific set of shader preprocessor options.
+///
+/// Option masks can be computed once and reused for any number of option set index lookups using
+/// GetOptionSetIndex().  Unknown options are ignored, and only the first matching choice is used for each selection.
+///
+/// @param[in] pOptionPairs     Mixed list of shader toggle states and shader selection pair values.
+/// @param[in] optionPairCount  Number of options in the option pair array.
+///
+/// @return  Option mask for the specified options.
+///
+/// @see CompileOptionMasks(), GetOptionSetIndex()
+Shader::Options::OptionMask Shader::Options::GetOptionMask(
+    const SelectPair* pOptionPairs,
+    size_t optionPairCount ) const
+{
+    HELIUM_ASSERT( pOptionPairs || optionPairCount == 0 );
+
+    OptionMask optionMask = 0;
+    size_t bitIndex = 0;
+
+    size_t shaderToggleCount = m_toggles.GetSize();
+    for( size_t shaderToggleIndex = 0; shaderToggleIndex < shaderToggleCount; ++shaderToggleIndex, ++bitIndex )
+    {
+        Name shaderToggleName = m_toggles[ shaderToggleIndex ].name;
+        for( size_t optionPairIndex = 0; optionPairIndex < optionPairCount; ++optionPairIndex )
+        {
+            const SelectPair& rOptionPair = pOptionPairs[ optionPairIndex ];
+            if( rOptionPair.name == shaderToggleName )
+            {
+                if( bitIndex < OPTION_MASK_BIT_COUNT && !IsDisabledToggleValue( rOptionPair.choice ) )
+                {
+                    optionMask |= static_cast< OptionMask >( 1 ) << bitIndex;
+                }
+
+                break;
+            }
+        }
+    }
+
+    // Selection pairs are handled the same way in both forms of option lists.
+    optionMask |= GetOptionMask( NULL, 0, pOptionPairs, optionPairCount );
+
+    return optionMask;
+}
+
+/// Get the unique option set index associated with an option mask.
+///
+/// This produces the same index as the name-based GetOptionSetIndex() overloads for the options used to build the
+/// mask, but only requires a table lookup for each group of four option bits in use.
+///
+/// @param[in] shaderType  Type of shader.
+/// @param[in] optionMask  Option mask, as built using GetOptionMask().
+///
+/// @return  Index to use for the specified options.
+///
+/// @see CompileOptionMasks(), GetOptionMask()
+size_t Shader::Options::GetOptionSetIndex( RShader::EType shaderType, OptionMask optionMask ) const
+{
+    HELIUM_ASSERT( static_cast< size_t >( shaderType ) < static_cast< size_t >( RShader::TYPE_MAX ) );
+    HELIUM_ASSERT( m_bOptionMasksCompiled );
+
+    const DynamicArray< uint32_t >& rNibbleIndexOffsets = m_maskNibbleIndexOffsets[ shaderType ];
+    const uint32_t* pNibbleIndexOffsets = rNibbleIndexOffsets.GetData();
+    const uint32_t* pNibbleIndexOffsetsEnd = pNibbleIndexOffsets + rNibbleIndexOffsets.GetSize();
+
+    uint32_t optionIndex = m_maskBaseIndices[ shaderType ];
+    for( ; pNibbleIndexOffsets != pNibbleIndexOffsetsEnd && optionMask != 0; pNibbleIndexOffsets += 16 )
+    {
+        optionIndex += pNibbleIndexOffsets[ static_cast< size_t >( optionMask & 0xf ) ];
+        optionMask >>= 4;
+    }
+
+    return optionIndex;
+}
+
 /// Constructor.
 ShaderVariant::ShaderVariant()
 : m_pRenderResourceLoadBuffer( NULL )
@@ -921,6 +1215,9 @@ bool Helium::Shader::LoadPersistentResourceObject( Reflect::ObjectPtr &_object )
 
     _object->CopyTo(&m_persistentResourceData);
 
+    m_persistentResourceData.GetSystemOptions().CompileOptionMasks();
+    m_persistentResourceData.GetUserOptions().CompileOptionMasks();
+
     return true;
 }
 
@@ -218,6 +218,18 @@ namespace Helium
 		public:
 			HELIUM_DECLARE_BASE_STRUCT(Shader::Options);
 			static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+			/// Mask of enabled toggles and chosen selection options (one bit for each toggle and each selection
+			/// choice, in declaration order).
+			typedef uint64_t OptionMask;
+
+			/// Number of toggles and selection choices that can be represented in an option mask.
+			static const size_t OPTION_MASK_BIT_COUNT = 64;
+
+			/// @name Construction/Destruction
+			//@{
+			Options();
+			//@}
 			
 			inline bool operator==( const Options& _rhs ) const;
 			inline bool operator!=( const Options& _rhs ) const;
@@ -246,11 +258,31 @@ namespace Helium
 			size_t ComputeOptionSetCount( RShader::EType shaderType ) const;
 			//@}
 
+			/// @name Option Mask Support
+			//@{
+			void CompileOptionMasks();
+
+			OptionMask GetOptionMask(
+				const Name* pToggleNames, size_t toggleNameCount, const SelectPair* pSelectPairs,
+				size_t selectPairCount ) const;
+			OptionMask GetOptionMask( const SelectPair* pOptionPairs, size_t optionPairCount ) const;
+
+			size_t GetOptionSetIndex( RShader::EType shaderType, OptionMask optionMask ) const;
+			//@}
+
 		private:
 			/// Preprocessor toggles.
 			DynamicArray< Toggle > m_toggles;
 			/// Preprocessor selections.
 			DynamicArray< Select > m_selects;
+
+			/// Option set index offsets for each 4-bit group of an option mask, for each shader type (16 entries
+			/// for each group).
+			DynamicArray< uint32_t > m_maskNibbleIndexOffsets[ RShader::TYPE_MAX ];
+			/// Option set index for an empty option mask, for each shader type.
+			uint32_t m_maskBaseIndices[ RShader::TYPE_MAX ];
+			/// True if CompileOptionMasks() has been called since the options were loaded.
+			bool m_bOptionMasksCompiled;
 		};
 
 		/// Persistent shader resource data.
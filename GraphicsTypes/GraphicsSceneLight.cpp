@@ -0,0 +1,80 @@
+#include "GraphicsTypesPch.h"
+#include "GraphicsTypes/GraphicsSceneLight.h"
+
+using namespace Helium;
+
+/// Constructor.
+GraphicsSceneLight::GraphicsSceneLight()
+: m_position( 0.0f )
+, m_direction( 0.0f, 0.0f, 1.0f )
+, m_color( 0xffffffff )
+, m_brightness( 1.0f )
+, m_radius( 0.0f )
+, m_spotCosInner( -1.0f )
+, m_spotCosOuter( -1.0f )
+, m_type( static_cast< uint8_t >( TYPE_POINT ) )
+{
+    m_worldSphere.Set( m_position, m_radius );
+}
+
+/// Place this light as an omnidirectional point light.
+///
+/// @param[in] rPosition  World-space light position.
+/// @param[in] radius     Distance at which the light's contribution falls off to zero.
+///
+/// @see SetSpotLight(), SetColor()
+void GraphicsSceneLight::SetPointLight( const Simd::Vector3& rPosition, float32_t radius )
+{
+    HELIUM_ASSERT( radius >= 0.0f );
+
+    m_position = rPosition;
+    m_radius = radius;
+    m_spotCosInner = -1.0f;
+    m_spotCosOuter = -1.0f;
+    m_type = static_cast< uint8_t >( TYPE_POINT );
+
+    m_worldSphere.Set( rPosition, radius );
+}
+
+/// Place this light as a spot light.
+///
+/// @param[in] rPosition   World-space light position.
+/// @param[in] rDirection  World-space direction in which the light points.
+/// @param[in] radius      Distance at which the light's contribution falls off to zero.
+/// @param[in] innerAngle  Half-angle of the cone inside which the light is at full intensity, in radians.
+/// @param[in] outerAngle  Half-angle of the cone outside which the light has no contribution, in radians.
+///
+/// @see SetPointLight(), SetColor()
+void GraphicsSceneLight::SetSpotLight(
+    const Simd::Vector3& rPosition, const Simd::Vector3& rDirection, float32_t radius, float32_t innerAngle,
+    float32_t outerAngle )
+{
+    HELIUM_ASSERT( radius >= 0.0f );
+
+    outerAngle = Clamp( outerAngle, 0.0f, static_cast< float32_t >( HELIUM_PI ) );
+    innerAngle = Clamp( innerAngle, 0.0f, outerAngle );
+
+    m_position = rPosition;
+    m_direction = rDirection;
+    m_direction.Normalize();
+    m_radius = radius;
+    m_spotCosInner = Cos( innerAngle );
+    m_spotCosOuter = Cos( outerAngle );
+    m_type = static_cast< uint8_t >( TYPE_SPOT );
+
+    // Spot lights are bounded by the same sphere as point lights; tighter cone bounds are not worth the extra cost
+    // during cluster assignment.
+    m_worldSphere.Set( rPosition, radius );
+}
+
+/// Set the light color.
+///
+/// @param[in] rColor      Light color.
+/// @param[in] brightness  Light brightness factor.
+///
+/// @see GetColor(), GetBrightness()
+void GraphicsSceneLight::SetColor( const Color& rColor, float32_t brightness )
+{
+    m_color = rColor;
+    m_brightness = brightness;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "GraphicsTypes/GraphicsTypes.h"
+
+#include "MathSimd/Color.h"
+#include "MathSimd/Sphere.h"
+#include "MathSimd/Vector3.h"
+
+namespace Helium
+{
+    /// Information related to a single local (point or spot) light attached to the graphics scene.
+    HELIUM_SIMD_ALIGN_PRE class HELIUM_GRAPHICS_TYPES_API GraphicsSceneLight
+    {
+    public:
+        /// Light type identifiers.
+        enum EType
+        {
+            TYPE_FIRST   =  0,
+            TYPE_INVALID = -1,
+
+            /// Omnidirectional point light.
+            TYPE_POINT,
+            /// Cone-shaped spot light.
+            TYPE_SPOT,
+
+            TYPE_MAX,
+            TYPE_LAST = TYPE_MAX - 1
+        };
+
+        /// @name Construction/Destruction
+        //@{
+        GraphicsSceneLight();
+        //@}
+
+        /// @name Data Access
+        //@{
+        void SetPointLight( const Simd::Vector3& rPosition, float32_t radius );
+        void SetSpotLight(
+            const Simd::Vector3& rPosition, const Simd::Vector3& rDirection, float32_t radius, float32_t innerAngle,
+            float32_t outerAngle );
+        void SetColor( const Color& rColor, float32_t brightness );
+
+        inline EType GetType() const;
+        inline const Simd::Vector3& GetPosition() const;
+        inline const Simd::Vector3& GetDirection() const;
+        inline float32_t GetRadius() const;
+        inline const Simd::Sphere& GetWorldSphere() const;
+        inline float32_t GetSpotCosInner() const;
+        inline float32_t GetSpotCosOuter() const;
+        inline const Color& GetColor() const;
+        inline float32_t GetBrightness() const;
+        //@}
+
+    private:
+        /// World-space light position.
+        Simd::Vector3 m_position;
+        /// World-space spot light direction (normalized, unused for point lights).
+        Simd::Vector3 m_direction;
+        /// World-space sphere bounding the light's area of influence.
+        Simd::Sphere m_worldSphere;
+
+        /// Light color.
+        Color m_color;
+        /// Light brightness factor.
+        float32_t m_brightness;
+        /// Distance at which the light's contribution falls off to zero.
+        float32_t m_radius;
+        /// Cosine of the spot cone angle inside which the light is at full intensity.
+        float32_t m_spotCosInner;
+        /// Cosine of the spot cone angle outside which the light has no contribution.
+        float32_t m_spotCosOuter;
+
+        /// Light type.
+        uint8_t m_type;
+    } HELIUM_SIMD_ALIGN_POST;
+}
+
+#include "GraphicsTypes/GraphicsSceneLight.inl"
@@ -0,0 +1,92 @@
+namespace Helium
+{
+    /// Get the light type.
+    ///
+    /// @return  Light type.
+    ///
+    /// @see SetPointLight(), SetSpotLight()
+    GraphicsSceneLight::EType GraphicsSceneLight::GetType() const
+    {
+        return static_cast< EType >( static_cast< int8_t >( m_type ) );
+    }
+
+    /// Get the world-space light position.
+    ///
+    /// @return  Light position.
+    ///
+    /// @see GetDirection(), GetRadius()
+    const Simd::Vector3& GraphicsSceneLight::GetPosition() const
+    {
+        return m_position;
+    }
+
+    /// Get the world-space direction in which a spot light points.
+    ///
+    /// @return  Normalized spot light direction (undefined for point lights).
+    ///
+    /// @see GetPosition(), GetSpotCosInner(), GetSpotCosOuter()
+    const Simd::Vector3& GraphicsSceneLight::GetDirection() const
+    {
+        return m_direction;
+    }
+
+    /// Get the distance at which the light's contribution falls off to zero.
+    ///
+    /// @return  Light radius.
+    ///
+    /// @see GetPosition(), GetWorldSphere()
+    float32_t GraphicsSceneLight::GetRadius() const
+    {
+        return m_radius;
+    }
+
+    /// Get the world-space sphere bounding the light's area of influence.
+    ///
+    /// @return  Light bounding sphere.
+    ///
+    /// @see GetPosition(), GetRadius()
+    const Simd::Sphere& GraphicsSceneLight::GetWorldSphere() const
+    {
+        return m_worldSphere;
+    }
+
+    /// Get the cosine of the spot cone half-angle inside which the light is at full intensity.
+    ///
+    /// @return  Cosine of the inner cone angle (-1 for point lights).
+    ///
+    /// @see GetSpotCosOuter(), SetSpotLight()
+    float32_t GraphicsSceneLight::GetSpotCosInner() const
+    {
+        return m_spotCosInner;
+    }
+
+    /// Get the cosine of the spot cone half-angle outside which the light has no contribution.
+    ///
+    /// @return  Cosine of the outer cone angle (-1 for point lights).
+    ///
+    /// @see GetSpotCosInner(), SetSpotLight()
+    float32_t GraphicsSceneLight::GetSpotCosOuter() const
+    {
+        return m_spotCosOuter;
+    }
+
+    /// Get the light color.
+    ///
+    /// @return  Light color.
+    ///
+    /// @see GetBrightness(), SetColor()
+    const Color& GraphicsSceneLight::GetColor() const
+    {
+        return m_color;
+    }
+
+    /// Get the light brightness factor.
+    ///
+    /// @return  Light brightness.
+    ///
+    /// @see GetColor(), SetColor()
+    float32_t GraphicsSceneLight::GetBrightness() const
+    {
+        return m_brightness;
+    }
+}
@@ -16,9 +16,13 @@ GraphicsSceneObject::GraphicsSceneObject()
 : m_pInverseReferencePose( NULL )
 #endif
 , m_pBonePalette( NULL )
+, m_pLodScreenSizes( NULL )
 , m_vertexStride( 0 )
+, m_revision( 0 )
 , m_boneCount( 0 )
+, m_lodCount( 1 )
 , m_updateMode( static_cast< uint8_t >( UPDATE_INVALID ) )
+, m_bOccluder( false )
 {
 }
 
@@ -30,6 +34,7 @@ GraphicsSceneObject::GraphicsSceneObject()
 void GraphicsSceneObject::SetTransform( const Simd::Matrix44& rTransform )
 {
     m_transform = rTransform;
+    ++m_revision;
 }
 
 /// Set the world-space axis-aligned bounding box for this instance.
@@ -58,6 +63,7 @@ void GraphicsSceneObject::SetVertexData(
     m_spVertexBuffer = pVertexBuffer;
     m_spVertexDescription = pVertexDescription;
     m_vertexStride = vertexStride;
+    ++m_revision;
 }
 
 /// Set the index buffer used for rendering.
@@ -68,6 +74,7 @@ void GraphicsSceneObject::SetVertexData(
 void GraphicsSceneObject::SetIndexBuffer( RIndexBuffer* pIndexBuffer )
 {
     m_spIndexBuffer = pIndexBuffer;
+    ++m_revision;
 }
 
 #if HELIUM_USE_GRANNY_ANIMATION
@@ -84,6 +91,7 @@ void GraphicsSceneObject::SetBoneData( const void* pBoneData, uint8_t boneCount
 
     m_pBoneData = pBoneData;
     m_boneCount = boneCount;
+    ++m_revision;
 }
 
 #else  // HELIUM_USE_GRANNY_ANIMATION
@@ -100,6 +108,7 @@ void GraphicsSceneObject::SetBoneData( const Simd::Matrix44* pInverseReferencePo
 
     m_pInverseReferencePose = pInverseReferencePose;
     m_boneCount = boneCount;
+    ++m_revision;
 }
 
 #endif  // HELIUM_USE_GRANNY_ANIMATION
@@ -113,6 +122,7 @@ void GraphicsSceneObject::SetBoneData( const Simd::Matrix44* pInverseReferencePo
 void GraphicsSceneObject::SetBonePalette( const Simd::Matrix44* pTransforms )
 {
     m_pBonePalette = pTransforms;
+    ++m_revision;
 }
 
 /// Flag this object as needing an update prior to the next scene update.
@@ -130,6 +140,82 @@ void GraphicsSceneObject::SetNeedsUpdate( EUpdate updateMode )
     }
 }
 
+/// Set the projected screen size thresholds used to select the level of detail to render.
+///
+/// @param[in] pScreenSizes  Array of screen size thresholds (bounding sphere radius relative to half the viewport
+///                          width) below which each simplified level of detail is used, one for each level of detail
+///                          after the full detail mesh.  This must remain valid while assigned.
+/// @param[in] lodCount      Number of levels of detail, including the full detail mesh.
+///
+/// @see GetLodScreenSizes(), GetLodCount(), SelectLod()
+void GraphicsSceneObject::SetLodScreenSizes( const float32_t* pScreenSizes, uint8_t lodCount )
+{
+    HELIUM_ASSERT( pScreenSizes || lodCount <= 1 );
+
+    m_pLodScreenSizes = pScreenSizes;
+    m_lodCount = ( lodCount != 0 ? lodCount : 1 );
+}
+
+/// Select the level of detail to render for a given projected screen size.
+///
+/// A hysteresis band around each threshold prevents objects near a threshold from switching between levels of
+/// detail every frame: an object only moves to a coarser level once it drops below the threshold scaled down by the
+/// hysteresis factor, and only moves back once it grows past the threshold scaled up by the same factor.
+///
+/// @param[in] screenSize   Projected screen size of the object's bounding sphere.
+/// @param[in] currentLod   Level of detail selected for the object during the previous frame.
+/// @param[in] hysteresis   Hysteresis factor (i.e. 0.1 for a 10% band around each threshold).
+///
+/// @return  Index of the level of detail to render.
+uint8_t GraphicsSceneObject::SelectLod( float32_t screenSize, uint8_t currentLod, float32_t hysteresis ) const
+{
+    if( m_lodCount <= 1 || !m_pLodScreenSizes )
+    {
+        return 0;
+    }
+
+    if( currentLod >= m_lodCount )
+    {
+        currentLod = static_cast< uint8_t >( m_lodCount - 1 );
+    }
+
+    uint8_t lod = currentLod;
+
+    // Move to coarser levels of detail while below the lowered threshold of the next level.
+    while( lod + 1 < m_lodCount && screenSize < m_pLodScreenSizes[ lod ] * ( 1.0f - hysteresis ) )
+    {
+        ++lod;
+    }
+
+    // Move to finer levels of detail while above the raised threshold of the current level.
+    while( lod > 0 && screenSize > m_pLodScreenSizes[ lod - 1 ] * ( 1.0f + hysteresis ) )
+    {
+        --lod;
+    }
+
+    return lod;
+}
+
+/// Set the box used to represent this instance when rasterizing occluders for occlusion culling.
+///
+/// @param[in] rLocalBox  Occluder box, in the local space of this instance.  This must lie entirely within the solid
+///                       geometry of the instance, as anything hidden behind it may be culled.
+///
+/// @see ClearOccluderBox(), GetOccluderBox(), IsOccluder()
+void GraphicsSceneObject::SetOccluderBox( const Simd::AaBox& rLocalBox )
+{
+    m_occluderBox = rLocalBox;
+    m_bOccluder = true;
+}
+
+/// Stop using this instance as an occluder for occlusion culling.
+///
+/// @see SetOccluderBox(), IsOccluder()
+void GraphicsSceneObject::ClearOccluderBox()
+{
+    m_bOccluder = false;
+}
+
 /// Constructor.
 ///
 /// @param[in] sceneObjectId  ID of the parent graphics scene object used to control the placement of this object as
@@ -142,6 +228,9 @@ GraphicsSceneObject::SubMeshData::SubMeshData( size_t sceneObjectId )
 , m_startVertex( 0 )
 , m_vertexRange( 0 )
 , m_startIndex( 0 )
+, m_pLodStartIndices( NULL )
+, m_pLodPrimitiveCounts( NULL )
+, m_lodCount( 1 )
 {
     HELIUM_ASSERT( IsValid( sceneObjectId ) );
 }
@@ -218,3 +307,24 @@ void GraphicsSceneObject::SubMeshData::SetStartIndex( uint32_t startIndex )
 {
     m_startIndex = startIndex;
 }
+
+/// Set the index buffer ranges to use for each level of detail.
+///
+/// @param[in] pLodStartIndices     Offset of the first index for each level of detail.  This must remain valid while
+///                                 assigned.
+/// @param[in] pLodPrimitiveCounts  Number of primitives for each level of detail.  This must remain valid while
+///                                 assigned.
+/// @param[in] lodCount             Number of levels of detail, including the full detail primitives.
+///
+/// @see GetLodCount(), GetLodStartIndex(), GetLodPrimitiveCount()
+void GraphicsSceneObject::SubMeshData::SetLodData(
+    const uint32_t* pLodStartIndices,
+    const uint32_t* pLodPrimitiveCounts,
+    uint8_t lodCount )
+{
+    HELIUM_ASSERT( ( pLodStartIndices && pLodPrimitiveCounts ) || lodCount <= 1 );
+
+    m_pLodStartIndices = pLodStartIndices;
+    m_pLodPrimitiveCounts = pLodPrimitiveCounts;
+    m_lodCount = ( lodCount != 0 ? lodCount : 1 );
+}
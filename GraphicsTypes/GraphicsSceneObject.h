@@ -60,6 +60,7 @@ namespace Helium
             void SetStartVertex( uint32_t startVertex );
             void SetVertexRange( uint32_t count );
             void SetStartIndex( uint32_t startIndex );
+            void SetLodData( const uint32_t* pLodStartIndices, const uint32_t* pLodPrimitiveCounts, uint8_t lodCount );
 
             inline size_t GetSceneObjectId() const;
 
@@ -70,6 +71,10 @@ namespace Helium
             inline uint32_t GetStartVertex() const;
             inline uint32_t GetVertexRange() const;
             inline uint32_t GetStartIndex() const;
+
+            inline uint8_t GetLodCount() const;
+            inline uint32_t GetLodStartIndex( size_t lodIndex ) const;
+            inline uint32_t GetLodPrimitiveCount( size_t lodIndex ) const;
             //@}
 
         private:
@@ -90,6 +95,13 @@ namespace Helium
             uint32_t m_vertexRange;
             /// Offset of the first index to use within the index buffer.
             uint32_t m_startIndex;
+            /// Offset of the first index to use within the index buffer for each level of detail (null if only the
+            /// full detail primitives are available).
+            const uint32_t* m_pLodStartIndices;
+            /// Number of primitives to render for each level of detail.
+            const uint32_t* m_pLodPrimitiveCounts;
+            /// Number of levels of detail, including the full detail primitives.
+            uint8_t m_lodCount;
         };
 
         /// @name Construction/Destruction
@@ -110,6 +122,9 @@ namespace Helium
         void SetBoneData( const Simd::Matrix44* pInverseReferencePose, uint8_t boneCount );
 #endif
         void SetBonePalette( const Simd::Matrix44* pTransforms );
+        void SetLodScreenSizes( const float32_t* pScreenSizes, uint8_t lodCount );
+        void SetOccluderBox( const Simd::AaBox& rLocalBox );
+        void ClearOccluderBox();
 
         inline const Simd::Matrix44& GetTransform() const;
         inline const Simd::AaBox& GetWorldBox() const;
@@ -126,6 +141,15 @@ namespace Helium
 #endif
         inline uint8_t GetBoneCount() const;
         inline const Simd::Matrix44* GetBonePalette() const;
+
+        inline uint8_t GetLodCount() const;
+        inline const float32_t* GetLodScreenSizes() const;
+        uint8_t SelectLod( float32_t screenSize, uint8_t currentLod, float32_t hysteresis ) const;
+
+        inline bool IsOccluder() const;
+        inline const Simd::AaBox& GetOccluderBox() const;
+
+        inline uint32_t GetRevision() const;
         //@}
         
         void SetNeedsUpdate( EUpdate updateMode = UPDATE_FULL );
@@ -140,6 +164,8 @@ namespace Helium
         Simd::AaBox m_worldBox;
         /// World-space bounding sphere.
         Simd::Sphere m_worldSphere;
+        /// Local-space box lying entirely within the solid geometry of this object, used for occlusion culling.
+        Simd::AaBox m_occluderBox;
 
         /// Vertex buffer.
         RVertexBufferPtr m_spVertexBuffer;
@@ -157,15 +183,23 @@ namespace Helium
 #endif
         /// Bone palette.
         const Simd::Matrix44* m_pBonePalette;
+        /// Projected screen size thresholds below which each simplified level of detail is used.
+        const float32_t* m_pLodScreenSizes;
         
         /// Vertex stride, in bytes.
         uint32_t m_vertexStride;
+        /// Counter incremented whenever the transform or geometry changes.
+        uint32_t m_revision;
 
         /// Number of bones in the bone palette.
         uint8_t m_boneCount;
+        /// Number of levels of detail, including the full detail mesh.
+        uint8_t m_lodCount;
 
         /// Update mode.
         uint8_t m_updateMode;
+        /// True if this object occludes other objects using its occluder box.
+        bool m_bOccluder;
     } HELIUM_SIMD_ALIGN_POST;
 }
 
@@ -116,6 +116,59 @@ namespace Helium
         return m_pBonePalette;
     }
 
+    /// Get the number of levels of detail available for this scene object.
+    ///
+    /// @return  Level of detail count, including the full detail mesh.
+    ///
+    /// @see SetLodScreenSizes(), GetLodScreenSizes(), SelectLod()
+    uint8_t GraphicsSceneObject::GetLodCount() const
+    {
+        return m_lodCount;
+    }
+
+    /// Get the projected screen size thresholds used to select the level of detail to render.
+    ///
+    /// @return  Array of screen size thresholds, one for each level of detail after the full detail mesh.
+    ///
+    /// @see SetLodScreenSizes(), GetLodCount(), SelectLod()
+    const float32_t* GraphicsSceneObject::GetLodScreenSizes() const
+    {
+        return m_pLodScreenSizes;
+    }
+
+    /// Get the revision counter for this scene object.
+    ///
+    /// The revision is incremented whenever the transform, vertex data, index buffer, or bone data is changed, allowing
+    /// cached results derived from this object (such as static shadow map cascades) to detect when they are stale.
+    /// Bone palette contents can change without any call being made, so skinned objects should not be treated as
+    /// static based on this value alone.
+    ///
+    /// @return  Revision counter.
+    uint32_t GraphicsSceneObject::GetRevision() const
+    {
+        return m_revision;
+    }
+
+    /// Get whether this instance is used as an occluder for occlusion culling.
+    ///
+    /// @return  True if an occluder box has been set, false if not.
+    ///
+    /// @see SetOccluderBox(), ClearOccluderBox(), GetOccluderBox()
+    bool GraphicsSceneObject::IsOccluder() const
+    {
+        return m_bOccluder;
+    }
+
+    /// Get the box used to represent this instance when rasterizing occluders.
+    ///
+    /// @return  Local-space occluder box (only valid if IsOccluder() returns true).
+    ///
+    /// @see SetOccluderBox(), IsOccluder()
+    const Simd::AaBox& GraphicsSceneObject::GetOccluderBox() const
+    {
+        return m_occluderBox;
+    }
+
     /// Get whether this scene object needs to be updated prior to the next scene update.
     ///
     /// @return  True if an update is needed, false if not.
@@ -217,4 +270,48 @@ namespace Helium
     {
         return m_startIndex;
     }
+
+    /// Get the number of levels of detail available for this sub-mesh.
+    ///
+    /// @return  Level of detail count, including the full detail primitives.
+    ///
+    /// @see SetLodData(), GetLodStartIndex(), GetLodPrimitiveCount()
+    uint8_t GraphicsSceneObject::SubMeshData::GetLodCount() const
+    {
+        return m_lodCount;
+    }
+
+    /// Get the offset of the first index to use within the index buffer for a given level of detail.
+    ///
+    /// @param[in] lodIndex  Level of detail index.  Indices past the last level of detail use the coarsest level.
+    ///
+    /// @return  Offset of the first index.
+    ///
+    /// @see SetLodData(), GetLodPrimitiveCount(), GetStartIndex()
+    uint32_t GraphicsSceneObject::SubMeshData::GetLodStartIndex( size_t lodIndex ) const
+    {
+        if( !m_pLodStartIndices )
+        {
+            return m_startIndex;
+        }
+
+        return m_pLodStartIndices[ lodIndex < m_lodCount ? lodIndex : m_lodCount - 1 ];
+    }
+
+    /// Get the number of primitives to render for a given level of detail.
+    ///
+    /// @param[in] lodIndex  Level of detail index.  Indices past the last level of detail use the coarsest level.
+    ///
+    /// @return  Primitive count.
+    ///
+    /// @see SetLodData(), GetLodStartIndex(), GetPrimitiveCount()
+    uint32_t GraphicsSceneObject::SubMeshData::GetLodPrimitiveCount( size_t lodIndex ) const
+    {
+        if( !m_pLodPrimitiveCounts )
+        {
+            return m_primitiveCount;
+        }
+
+        return m_pLodPrimitiveCounts[ lodIndex < m_lodCount ? lodIndex : m_lodCount - 1 ];
+    }
 }
@@ -35,6 +35,9 @@ GraphicsSceneView::GraphicsSceneView()
 	, m_farClip( DEFAULT_FAR_CLIP )
 	, m_shadowCutoffDistance( DEFAULT_SHADOW_CUTOFF_DISTANCE )
 	, m_shadowFadeDistance( DEFAULT_SHADOW_FADE_DISTANCE )
+	, m_occluderCount( 0 )
+	, m_occlusionTestedCount( 0 )
+	, m_occlusionRejectedCount( 0 )
 	, m_bDirtyView( true )
 {
 	MemoryZero( &m_frustum, sizeof( m_frustum ) );
@@ -241,3 +244,19 @@ void GraphicsSceneView::ConvertNormalizedScreenCoordinatesToRaycast( const Simd:
 		m_viewMatrix.TransformPoint(to, rayDestination);
 	}
 }
+
+/// Record the results of occlusion culling for the most recent draw of this view.
+///
+/// @param[in] occluderCount  Number of occluders rasterized.
+/// @param[in] testedCount    Number of objects tested against the occluders.
+/// @param[in] rejectedCount  Number of objects found to be hidden by the occluders.
+///
+/// @see GetOccluderCount(), GetOcclusionTestedCount(), GetOcclusionRejectedCount()
+void GraphicsSceneView::SetOcclusionStats( uint32_t occluderCount, uint32_t testedCount, uint32_t rejectedCount )
+{
+	HELIUM_ASSERT( rejectedCount <= testedCount );
+
+	m_occluderCount = occluderCount;
+	m_occlusionTestedCount = testedCount;
+	m_occlusionRejectedCount = rejectedCount;
+}
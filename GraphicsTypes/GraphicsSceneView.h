@@ -79,8 +79,13 @@ namespace Helium
 		inline const Simd::Vector3& GetForward() const;
 		inline const Simd::Vector3& GetUp() const;
 
+		inline float32_t GetHorizontalFov() const;
+		inline float32_t GetNearClip() const;
+		inline float32_t GetFarClip() const;
+
 		inline const Simd::Matrix44& GetViewMatrix() const;
 		inline const Simd::Matrix44& GetInverseViewMatrix() const;
+		inline const Simd::Matrix44& GetProjectionMatrix() const;
 		inline const Simd::Matrix44& GetInverseViewProjectionMatrix() const;
 
 		inline const Simd::Frustum& GetFrustum() const;
@@ -93,6 +98,14 @@ namespace Helium
 		void ConvertNormalizedScreenCoordinatesToRaycast( const Simd::Vector2 &normalizedScreenCoordinates, Simd::Vector3 &rayOrigin, Simd::Vector3 &rayDestination );
 		//@}
 
+		/// @name Occlusion Culling Statistics
+		//@{
+		void SetOcclusionStats( uint32_t occluderCount, uint32_t testedCount, uint32_t rejectedCount );
+		inline uint32_t GetOccluderCount() const;
+		inline uint32_t GetOcclusionTestedCount() const;
+		inline uint32_t GetOcclusionRejectedCount() const;
+		//@}
+
 	private:
 		/// View transform matrix.
 		Simd::Matrix44 m_viewMatrix;
@@ -144,6 +157,13 @@ namespace Helium
 		/// Distance at which shadows begin to fade out.
 		float32_t m_shadowFadeDistance;
 
+		/// Number of occluders rasterized when this view was last drawn.
+		uint32_t m_occluderCount;
+		/// Number of objects tested against the occluders when this view was last drawn.
+		uint32_t m_occlusionTestedCount;
+		/// Number of objects rejected as hidden by the occluders when this view was last drawn.
+		uint32_t m_occlusionRejectedCount;
+
 		/// True if the view and projection matrices need to be updated.
 		bool m_bDirtyView;
 
@@ -115,6 +115,36 @@ namespace Helium
         return m_up;
     }
 
+    /// Get the horizontal field-of-view angle.
+    ///
+    /// @return  Horizontal field-of-view angle, in degrees.
+    ///
+    /// @see SetHorizontalFov()
+    float32_t GraphicsSceneView::GetHorizontalFov() const
+    {
+        return m_horizontalFov;
+    }
+
+    /// Get the distance to the near clip plane.
+    ///
+    /// @return  Near clip distance.
+    ///
+    /// @see GetFarClip(), SetNearClip()
+    float32_t GraphicsSceneView::GetNearClip() const
+    {
+        return m_nearClip;
+    }
+
+    /// Get the distance to the far clip plane.
+    ///
+    /// @return  Far clip distance, or a negative value if the far clip plane is at infinity.
+    ///
+    /// @see GetNearClip(), SetFarClip()
+    float32_t GraphicsSceneView::GetFarClip() const
+    {
+        return m_farClip;
+    }
+
     /// Get the view matrix for this scene view.
     ///
     /// @return  View matrix.
@@ -131,6 +161,14 @@ namespace Helium
         return m_inverseViewMatrix;
     }
 
+    /// Get the projection matrix for this scene view.
+    ///
+    /// @return  Projection matrix.
+    const Simd::Matrix44& GraphicsSceneView::GetProjectionMatrix() const
+    {
+        return m_projectionMatrix;
+    }
+
     /// Get the combined inverse view/projection matrix for this scene view.
     ///
     /// @return  Inverse view/projection matrix.
@@ -166,4 +204,34 @@ namespace Helium
     {
         return m_shadowFadeDistance;
     }
+
+    /// Get the number of occluders rasterized for occlusion culling when this view was last drawn.
+    ///
+    /// @return  Occluder count.
+    ///
+    /// @see GetOcclusionTestedCount(), GetOcclusionRejectedCount(), SetOcclusionStats()
+    uint32_t GraphicsSceneView::GetOccluderCount() const
+    {
+        return m_occluderCount;
+    }
+
+    /// Get the number of objects tested against the occluders when this view was last drawn.
+    ///
+    /// @return  Number of objects tested.
+    ///
+    /// @see GetOccluderCount(), GetOcclusionRejectedCount(), SetOcclusionStats()
+    uint32_t GraphicsSceneView::GetOcclusionTestedCount() const
+    {
+        return m_occlusionTestedCount;
+    }
+
+    /// Get the number of objects culled as hidden by the occluders when this view was last drawn.
+    ///
+    /// @return  Number of objects rejected.
+    ///
+    /// @see GetOccluderCount(), GetOcclusionTestedCount(), SetOcclusionStats()
+    uint32_t GraphicsSceneView::GetOcclusionRejectedCount() const
+    {
+        return m_occlusionRejectedCount;
+    }
 }
@@ -2,6 +2,8 @@
 #include "AssetPreprocessor.h"
 
 #include "Platform/File.h"
+#include "Platform/Thread.h"
+#include "Platform/Timer.h"
 #include "Foundation/FilePath.h"
 #include "Foundation/FileStream.h"
 #include "Foundation/MemoryStream.h"
@@ -11,23 +13,72 @@
 #include "Engine/AssetLoader.h"
 #include "Engine/Resource.h"
 #include "Engine/Config.h"
+#include "Engine/Asset.h"
 #include "PcSupport/PlatformPreprocessor.h"
 #include "PcSupport/ResourceHandler.h"
 #include "Engine/PackageLoader.h"
 
+#include <algorithm>
+
 using namespace Helium;
 
 AssetPreprocessor* AssetPreprocessor::sm_pInstance = NULL;
 
+#if HELIUM_TOOLS
+/// Sort predicate for writing deferred objects in order of their path names.
+template< typename T >
+static bool DeferredObjectPathLess( const T& rObject0, const T& rObject1 )
+{
+	return ( CompareString( *rObject0.pathString, *rObject1.pathString ) < 0 );
+}
+
+/// Sort predicate for listing batch cook statistics in order of their resource type names.
+template< typename T >
+static bool ResourceTypeStatisticsNameLess( const T& rStatistics0, const T& rStatistics1 )
+{
+	return ( CompareString( *rStatistics0.pType->GetName(), *rStatistics1.pType->GetName() ) < 0 );
+}
+
+/// Get the path of the file from which an asset was loaded.
+///
+/// @param[in] path  Asset path.
+///
+/// @return  Asset file path, or an empty string if the asset was not loaded from a file.
+static String GetAssetFilePath( const AssetPath &path )
+{
+	Package* pPackage = Asset::Find< Package >( path.GetParentPackage() );
+	PackageLoader* pLoader = ( pPackage ? pPackage->GetLoader() : NULL );
+	if( !pLoader || !pLoader->HasAssetFileState() )
+	{
+		return String();
+	}
+
+	return String( pLoader->GetAssetFileSystemPath( path ).c_str() );
+}
+#endif
+
 /// Constructor.
 AssetPreprocessor::AssetPreprocessor()
 {
 	MemoryZero( m_pPlatformPreprocessors, sizeof( m_pPlatformPreprocessors ) );
+
+#if HELIUM_TOOLS
+	m_bCookDatabaseLoaded = false;
+	m_bBatchCooking = false;
+	m_nextDeferredResourceIndex = 0;
+	m_upToDateResourceCount = 0;
+	m_batchCookStartTicks = 0;
+	m_batchCookEndTicks = 0;
+#endif
 }
 
 /// Destructor.
 AssetPreprocessor::~AssetPreprocessor()
 {
+#if HELIUM_TOOLS
+	SaveCookDatabase();
+#endif
+
 	for( size_t platformIndex = 0; platformIndex < HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ); ++platformIndex )
 	{
 		delete m_pPlatformPreprocessors[ platformIndex ];
@@ -53,7 +104,9 @@ void AssetPreprocessor::SetPlatformPreprocessor( Cache::EPlatform platform, Plat
 /// Cache an object for all registered platforms.
 ///
 /// @param[in] pObject                                 Asset to cache.
-/// @param[in] timestamp                               Asset timestamp.
+/// @param[in] timestamp                               Input stamp of the asset (see GetObjectInputStamp()).  This is
+///                                                    ignored during a batch cook, as the stamp is computed again
+///                                                    once all deferred resources have been preprocessed.
 /// @param[in] bEvictPlatformPreprocessedResourceData  If the object being cached is a Resource-based object,
 ///                                                    specifying true will free the raw preprocessed resource data
 ///                                                    for the current platform after caching, while false will keep
@@ -73,6 +126,35 @@ bool AssetPreprocessor::CacheObject(
 
 	HELIUM_ASSERT( pObject );
 
+	// Objects are not written out until the end of a batch cook, once all of their resource data is available.  This
+	// also lets the batch cook write every cache in a deterministic order regardless of the order in which objects
+	// finished loading.
+	if( m_bBatchCooking )
+	{
+		HashMap< AssetPath, size_t >::Iterator indexIterator = m_deferredObjectIndices.Find( objectPath );
+		DeferredObject* pDeferredObject;
+		if( indexIterator != m_deferredObjectIndices.End() )
+		{
+			pDeferredObject = &m_deferredObjects[ indexIterator->Second() ];
+		}
+		else
+		{
+			m_deferredObjectIndices.Insert(
+				indexIterator,
+				KeyValue< AssetPath, size_t >( objectPath, m_deferredObjects.GetSize() ) );
+
+			pDeferredObject = m_deferredObjects.New();
+			HELIUM_ASSERT( pDeferredObject );
+			pDeferredObject->path = objectPath;
+			objectPath.ToString( pDeferredObject->pathString );
+		}
+
+		pDeferredObject->spObject = pObject;
+		pDeferredObject->bEvictPlatformPreprocessedResourceData = bEvictPlatformPreprocessedResourceData;
+
+		return true;
+	}
+
 	bool bCacheFailure = false;
 
 	DynamicArray< uint8_t > objectStreamBuffer;
@@ -341,13 +423,10 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 
 	sourceFilePath += baseResourcePath.ToFilePathString().GetData();
 
-	Helium::Status stat;
-	stat.Read( sourceFilePath );
-
-	int64_t sourceFileTimestamp = stat.m_ModifiedTime;
-	int64_t assetFileTimestamp = AssetLoader::GetAssetFileTimestamp( baseResourcePath );
-
-	int64_t timestamp = Max( assetFileTimestamp, sourceFileTimestamp );
+	// Cached data is up-to-date if it was built from the same inputs as those recorded in the cook database.  The
+	// stamp is zero if no inputs have been recorded for the resource, in which case it is always preprocessed.
+	ConditionalLoadCookDatabase();
+	int64_t timestamp = m_cookDatabase.GetInputStamp( resourcePath );
 
 	// Check if data is loaded for each supported platform, attempting to load the data from the cache if it exists
 	// and is up-to-date.
@@ -381,7 +460,7 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 		pCache->EnforceTocLoad();
 
 		const Cache::Entry* pCacheEntry = pCache->FindEntry( resourcePath, 0 );
-		if( !pCacheEntry || pCacheEntry->timestamp != timestamp )
+		if( timestamp == 0 || !pCacheEntry || pCacheEntry->timestamp != timestamp )
 		{
 			HELIUM_TRACE(
 				TraceLevels::Info,
@@ -408,16 +487,35 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 	if( platformIndex >= HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ) )
 	{
 		// All supported platforms loaded successfully, so nothing else needs to be done.
+		if( m_bBatchCooking )
+		{
+			++m_upToDateResourceCount;
+		}
+
+		return;
+	}
+
+	// Record the files and assets the resource is about to be preprocessed from.  Resource handlers add any other
+	// inputs they read while preprocessing.
+	String sourceFilePathString( sourceFilePath.c_str() );
+	RecordBaseDependencies( resourcePath, pResource, sourceFilePathString );
+
+	// Resources that can be preprocessed independently are left for the worker threads at the end of a batch cook.
+	if( m_bBatchCooking && DeferResourcePreprocessing( resourcePath, pResource, sourceFilePathString ) )
+	{
 		return;
 	}
 
 	// Preprocess all resources for each supported platform.
-	if( !PreprocessResource( resourcePath, pResource, String( sourceFilePath.c_str() ) ) )
+	if( !PreprocessResource( resourcePath, pResource, sourceFilePathString ) )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
 			TXT( "AssetPreprocessor::LoadResourceData(): Preprocessing of resource \"%s\" failed.\n" ),
 			*resourcePath.ToString() );
+
+		// Make sure the resource is attempted again the next time it is loaded.
+		m_cookDatabase.RemoveAsset( resourcePath );
 	}
 
 #else  // HELIUM_TOOLS
@@ -680,6 +778,296 @@ AssetPreprocessor* AssetPreprocessor::GetStaticInstance()
 }
 
 #if HELIUM_TOOLS
+/// Begin a batch cook.
+///
+/// While a batch cook is in progress, resources whose handlers support concurrent caching are queued instead of being
+/// preprocessed as they are loaded, and all object caching is deferred.  Resource types that other resources depend on
+/// during preprocessing (i.e. shaders) keep being preprocessed immediately, in the order the asset loader resolves
+/// them, so the queued resources can always be processed independently of each other.  The queued work is performed
+/// when EndBatchCook() is called.
+///
+/// @see EndBatchCook(), IsBatchCooking()
+void AssetPreprocessor::BeginBatchCook()
+{
+	HELIUM_ASSERT( !m_bBatchCooking );
+
+	ConditionalLoadCookDatabase();
+	m_cookDatabase.ResetStatistics();
+	m_cookDatabase.BeginCook();
+	m_upToDateResourceCount = 0;
+
+	m_deferredResources.Clear();
+	m_nextDeferredResourceIndex = 0;
+	m_deferredObjects.Clear();
+	m_deferredObjectIndices.Clear();
+
+	{
+		MutexScopeLock scopeLock( m_statisticsLock );
+		m_resourceTypeStatistics.Clear();
+	}
+
+	m_batchCookStartTicks = Timer::GetTickCount();
+	m_batchCookEndTicks = m_batchCookStartTicks;
+
+	CacheManager::GetStaticInstance().BeginBatchUpdate();
+
+	m_bBatchCooking = true;
+}
+
+/// Finish a batch cook, preprocessing all queued resources in parallel and writing out all deferred objects.
+///
+/// Objects are written in order of their path names, and each cache's table of contents is written once at the end,
+/// so the resulting cache files do not depend on the number of worker threads or the order in which assets finished
+/// loading.
+///
+/// @param[in] workerCount  Number of worker threads to create in addition to the calling thread.
+///
+/// @return  True if all resources were preprocessed and all objects were cached successfully, false if not.
+///
+/// @see BeginBatchCook(), IsBatchCooking(), TraceBatchCookSummary()
+bool AssetPreprocessor::EndBatchCook( size_t workerCount )
+{
+	HELIUM_ASSERT( m_bBatchCooking );
+
+	m_bBatchCooking = false;
+
+	bool bSuccess = true;
+
+	// Preprocess the queued resources.
+	size_t deferredResourceCount = m_deferredResources.GetSize();
+	workerCount = Min( workerCount, ( deferredResourceCount != 0 ? deferredResourceCount - 1 : 0 ) );
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		( TXT( "AssetPreprocessor::EndBatchCook(): Preprocessing %" ) PRIuSZ TXT( " resources using %" ) PRIuSZ
+		TXT( " worker threads.\n" ) ),
+		deferredResourceCount,
+		workerCount + 1 );
+
+	m_nextDeferredResourceIndex = 0;
+
+	Helium::CallbackThread::Entry entry =
+		&Helium::CallbackThread::EntryHelper< AssetPreprocessor, &AssetPreprocessor::BatchCookThreadProc >;
+
+	DynamicArray< CallbackThread* > workerThreads;
+	workerThreads.Reserve( workerCount );
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		CallbackThread* pThread = new CallbackThread;
+		HELIUM_ASSERT( pThread );
+		if( !pThread->Create( entry, this, TXT( "Batch cook" ), ThreadPriorities::Normal ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "AssetPreprocessor::EndBatchCook(): Failed to create worker thread %" ) PRIuSZ TXT( ".\n" ),
+				workerIndex );
+
+			delete pThread;
+
+			break;
+		}
+
+		workerThreads.Push( pThread );
+	}
+
+	BatchCookThreadProc();
+
+	size_t workerThreadCount = workerThreads.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerThreadCount; ++workerIndex )
+	{
+		CallbackThread* pThread = workerThreads[ workerIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
+	}
+
+	for( size_t resourceIndex = 0; resourceIndex < deferredResourceCount; ++resourceIndex )
+	{
+		DeferredResource& rDeferredResource = m_deferredResources[ resourceIndex ];
+		if( !rDeferredResource.bSuccess )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "AssetPreprocessor::EndBatchCook(): Preprocessing of resource \"%s\" failed.\n" ),
+				*rDeferredResource.path.ToString() );
+
+			m_cookDatabase.RemoveAsset( rDeferredResource.path );
+			bSuccess = false;
+
+			continue;
+		}
+
+		LoadPreprocessedPersistentResourceData(
+			Reflect::AssertCast< Resource >( rDeferredResource.spResource.Get() ) );
+	}
+
+	m_deferredResources.Clear();
+
+	// Write out all deferred objects in a deterministic order.  Input stamps are only computed now, as the worker threads
+	// may have recorded additional dependencies for the deferred resources.
+	std::sort( m_deferredObjects.Begin(), m_deferredObjects.End(), DeferredObjectPathLess< DeferredObject > );
+
+	size_t deferredObjectCount = m_deferredObjects.GetSize();
+	for( size_t objectIndex = 0; objectIndex < deferredObjectCount; ++objectIndex )
+	{
+		DeferredObject& rDeferredObject = m_deferredObjects[ objectIndex ];
+		bSuccess &= CacheObject(
+			rDeferredObject.path,
+			rDeferredObject.spObject,
+			GetObjectInputStamp( rDeferredObject.path, rDeferredObject.spObject ),
+			rDeferredObject.bEvictPlatformPreprocessedResourceData );
+	}
+
+	m_deferredObjects.Clear();
+	m_deferredObjectIndices.Clear();
+
+	m_cookDatabase.EndCook();
+
+	bSuccess &= CacheManager::GetStaticInstance().EndBatchUpdate();
+	bSuccess &= SaveCookDatabase();
+
+	m_batchCookEndTicks = Timer::GetTickCount();
+
+	return bSuccess;
+}
+
+/// Write a summary of the resources preprocessed during the last batch cook to the trace output, broken down by
+/// resource type.
+///
+/// @see BeginBatchCook(), EndBatchCook()
+void AssetPreprocessor::TraceBatchCookSummary() const
+{
+	DynamicArray< ResourceTypeStatistics > typeStatistics;
+
+	{
+		MutexScopeLock scopeLock( m_statisticsLock );
+		typeStatistics = m_resourceTypeStatistics;
+	}
+
+	std::sort( typeStatistics.Begin(), typeStatistics.End(), ResourceTypeStatisticsNameLess< ResourceTypeStatistics > );
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "Batch cook summary (%.2f ms total):\n" ),
+		static_cast< float32_t >( Timer::TicksToMilliseconds( m_batchCookEndTicks - m_batchCookStartTicks ) ) );
+
+	uint32_t totalResourceCount = 0;
+	uint32_t totalFailureCount = 0;
+	uint64_t totalTicks = 0;
+
+	size_t typeCount = typeStatistics.GetSize();
+	for( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+	{
+		const ResourceTypeStatistics& rStatistics = typeStatistics[ typeIndex ];
+		HELIUM_ASSERT( rStatistics.pType );
+		HELIUM_ASSERT( rStatistics.resourceCount != 0 );
+
+		float32_t milliseconds = static_cast< float32_t >( Timer::TicksToMilliseconds( rStatistics.ticks ) );
+
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			( TXT( "  %-32s %6" ) PRIu32 TXT( " resources (%" ) PRIu32 TXT( " parallel, %" ) PRIu32
+			TXT( " failed) %12.2f ms (%.2f ms average)\n" ) ),
+			*rStatistics.pType->GetName(),
+			rStatistics.resourceCount,
+			rStatistics.concurrentResourceCount,
+			rStatistics.failureCount,
+			milliseconds,
+			milliseconds / static_cast< float32_t >( rStatistics.resourceCount ) );
+
+		totalResourceCount += rStatistics.resourceCount;
+		totalFailureCount += rStatistics.failureCount;
+		totalTicks += rStatistics.ticks;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		( TXT( "  %-32s %6" ) PRIu32 TXT( " resources (%" ) PRIu32 TXT( " failed) %12.2f ms preprocessing time\n" ) ),
+		TXT( "Total" ),
+		totalResourceCount,
+		totalFailureCount,
+		static_cast< float32_t >( Timer::TicksToMilliseconds( totalTicks ) ) );
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		( TXT( "  %" ) PRIu32 TXT( " resources were up-to-date; %" ) PRIu32 TXT( " input file checks, %" ) PRIu32
+		TXT( " files rehashed.\n" ) ),
+		m_upToDateResourceCount,
+		m_cookDatabase.GetFileHashCount(),
+		m_cookDatabase.GetFileRehashCount() );
+}
+
+/// Get the input stamp of an object to store with its cached data.
+///
+/// The stamp is computed from the content of every file the object was cooked from, combined with the stamps of the
+/// assets whose cooked data it used, so it only changes when something the object transitively depends on actually
+/// changes.  The inputs of a resource are recorded when it is preprocessed, while for any other object, only its own
+/// asset file and template are recorded here.
+///
+/// @param[in] path     Object path.
+/// @param[in] pObject  Object instance.
+///
+/// @return  Input stamp.
+///
+/// @see CacheObject()
+int64_t AssetPreprocessor::GetObjectInputStamp( const AssetPath &path, Asset* pObject )
+{
+	HELIUM_ASSERT( pObject );
+
+	ConditionalLoadCookDatabase();
+
+	Resource* pResource = ( !pObject->IsDefaultTemplate() ? Reflect::SafeCast< Resource >( pObject ) : NULL );
+	if( !pResource || !m_cookDatabase.HasAsset( path ) )
+	{
+		RecordBaseDependencies( path, pObject, String() );
+	}
+
+	return m_cookDatabase.GetInputStamp( path );
+}
+
+/// Record a file read while preprocessing a resource, so that the resource will be preprocessed again if the file
+/// changes.
+///
+/// This may be called by resource handlers from batch cook worker threads.
+///
+/// @param[in] path       Resource path.
+/// @param[in] rFilePath  Path of the file on which the resource depends.
+///
+/// @see AddAssetDependency()
+void AssetPreprocessor::AddFileDependency( const AssetPath &path, const String& rFilePath )
+{
+	m_cookDatabase.AddFileDependency( path, rFilePath );
+}
+
+/// Record an asset whose data was used while preprocessing a resource, so that the resource will be preprocessed
+/// again if any of the inputs of that asset change.
+///
+/// This may be called by resource handlers from batch cook worker threads.
+///
+/// @param[in] path            Resource path.
+/// @param[in] dependencyPath  Path of the asset on which the resource depends.
+///
+/// @see AddFileDependency()
+void AssetPreprocessor::AddAssetDependency( const AssetPath &path, const AssetPath &dependencyPath )
+{
+	m_cookDatabase.AddAssetDependency( path, dependencyPath );
+}
+
+/// Write the cook database to disk if it has been modified.
+///
+/// This is done automatically at the end of a batch cook and when the preprocessor is destroyed.
+///
+/// @return  True if the database was written successfully or did not need to be written, false if not.
+bool AssetPreprocessor::SaveCookDatabase()
+{
+	if( !m_bCookDatabaseLoaded )
+	{
+		return true;
+	}
+
+	return m_cookDatabase.Save();
+}
+
 /// Helper function for loading the cached resource data for a specific platform.
 ///
 /// @param[in] pResource  Resource to load.  The data will be loaded into the proper Resource::PreprocessedData
@@ -830,6 +1218,35 @@ bool AssetPreprocessor::LoadCachedResourceData( const AssetPath &path, Resource*
 ///
 /// @return  True if preprocessing was successful, false if not.
 bool AssetPreprocessor::PreprocessResource( const AssetPath &path, Resource* pResource, const String& rSourceFilePath )
+{
+	if( !PreprocessResourceData( path, pResource, rSourceFilePath, false ) )
+	{
+		return false;
+	}
+
+	LoadPreprocessedPersistentResourceData( pResource );
+
+	return true;
+}
+
+/// Run the resource handler for a resource, storing the preprocessed data for all enabled platforms in memory with the
+/// resource.
+///
+/// This does not touch any state shared with other resources, so it may be called from batch cook worker threads for
+/// resources whose handlers support concurrent caching.
+///
+/// @param[in] pResource        Resource to preprocess.
+/// @param[in] rSourceFilePath  FilePath name of the source resource data file.
+/// @param[in] bConcurrent      True if this is being called from a batch cook worker thread (for statistics only).
+///
+/// @return  True if preprocessing was successful, false if not.
+///
+/// @see LoadPreprocessedPersistentResourceData()
+bool AssetPreprocessor::PreprocessResourceData(
+	const AssetPath &path,
+	Resource* pResource,
+	const String& rSourceFilePath,
+	bool bConcurrent )
 {
 	HELIUM_ASSERT( pResource );
 	HELIUM_ASSERT( !pResource->IsDefaultTemplate() );
@@ -839,6 +1256,8 @@ bool AssetPreprocessor::PreprocessResource( const AssetPath &path, Resource* pRe
 		TXT( "AssetPreprocessor::PreprocessResource(): Preprocessing resource \"%s\".\n" ),
 		*path.ToString() );
 
+	uint64_t startTicks = Timer::GetTickCount();
+
 	// Clear out all existing resource data.
 	for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
 	{
@@ -862,6 +1281,8 @@ bool AssetPreprocessor::PreprocessResource( const AssetPath &path, Resource* pRe
 			*path.ToString(),
 			*pResourceType->GetName() );
 
+		AddResourceTypeStatistics( pResourceType, Timer::GetTickCount() - startTicks, false, bConcurrent );
+
 		return false;
 	}
 
@@ -873,10 +1294,25 @@ bool AssetPreprocessor::PreprocessResource( const AssetPath &path, Resource* pRe
 			TXT( "AssetPreprocessor::PreprocessResource(): Failed to preprocess resource \"%s\".\n" ),
 			*path.ToString() );
 
+		AddResourceTypeStatistics( pResourceType, Timer::GetTickCount() - startTicks, false, bConcurrent );
+
 		return false;
 	}
 
-	// Reserialize the current platform's persistent resource data.
+	AddResourceTypeStatistics( pResourceType, Timer::GetTickCount() - startTicks, true, bConcurrent );
+
+	return true;
+}
+
+/// Reserialize the current platform's persistent resource data into a freshly preprocessed resource.
+///
+/// @param[in] pResource  Resource that has just been preprocessed.
+///
+/// @see PreprocessResourceData()
+void AssetPreprocessor::LoadPreprocessedPersistentResourceData( Resource* pResource )
+{
+	HELIUM_ASSERT( pResource );
+
 	CacheManager& rCacheManager = CacheManager::GetStaticInstance();
 	Cache::EPlatform platform = rCacheManager.GetCurrentPlatform();
 	HELIUM_ASSERT( static_cast< size_t >( platform ) < HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ) );
@@ -896,7 +1332,167 @@ bool AssetPreprocessor::PreprocessResource( const AssetPath &path, Resource* pRe
 			}
 		}
 	}
+}
+
+/// Queue a resource to be preprocessed on the worker threads at the end of the current batch cook.
+///
+/// @param[in] pResource        Resource to preprocess.
+/// @param[in] rSourceFilePath  FilePath name of the source resource data file.
+///
+/// @return  True if the resource was queued, false if its resource handler does not support concurrent caching (in
+///          which case it should be preprocessed immediately).
+bool AssetPreprocessor::DeferResourcePreprocessing(
+	const AssetPath &path,
+	Resource* pResource,
+	const String& rSourceFilePath )
+{
+	HELIUM_ASSERT( m_bBatchCooking );
+	HELIUM_ASSERT( pResource );
+
+	const AssetType* pResourceType = pResource->GetAssetType();
+	HELIUM_ASSERT( pResourceType );
+	ResourceHandler* pResourceHandler = ResourceHandler::FindResourceHandlerForType( pResourceType );
+	if( !pResourceHandler || !pResourceHandler->CanCacheResourceConcurrently() )
+	{
+		return false;
+	}
+
+	size_t deferredResourceCount = m_deferredResources.GetSize();
+	for( size_t resourceIndex = 0; resourceIndex < deferredResourceCount; ++resourceIndex )
+	{
+		if( m_deferredResources[ resourceIndex ].spResource.Get() == pResource )
+		{
+			return true;
+		}
+	}
+
+	DeferredResource* pDeferredResource = m_deferredResources.New();
+	HELIUM_ASSERT( pDeferredResource );
+	pDeferredResource->path = path;
+	pDeferredResource->spResource = pResource;
+	pDeferredResource->sourceFilePath = rSourceFilePath;
+	pDeferredResource->bSuccess = false;
 
 	return true;
 }
+
+/// Batch cook worker thread entry point (also run on the thread ending the batch cook).
+void AssetPreprocessor::BatchCookThreadProc()
+{
+	size_t deferredResourceCount = m_deferredResources.GetSize();
+
+	for( ; ; )
+	{
+		size_t resourceIndex = static_cast< size_t >( AtomicIncrementAcquire( m_nextDeferredResourceIndex ) - 1 );
+		if( resourceIndex >= deferredResourceCount )
+		{
+			break;
+		}
+
+		DeferredResource& rDeferredResource = m_deferredResources[ resourceIndex ];
+		Resource* pResource = Reflect::AssertCast< Resource >( rDeferredResource.spResource.Get() );
+
+		rDeferredResource.bSuccess = PreprocessResourceData(
+			rDeferredResource.path,
+			pResource,
+			rDeferredResource.sourceFilePath,
+			true );
+	}
+}
+
+/// Record the preprocessing time of a resource.
+///
+/// @param[in] pType        Resource type.
+/// @param[in] ticks        Time spent preprocessing the resource, in timer ticks.
+/// @param[in] bSuccess     True if preprocessing was successful, false if not.
+/// @param[in] bConcurrent  True if the resource was preprocessed on a batch cook worker thread.
+void AssetPreprocessor::AddResourceTypeStatistics(
+	const AssetType* pType,
+	uint64_t ticks,
+	bool bSuccess,
+	bool bConcurrent )
+{
+	HELIUM_ASSERT( pType );
+
+	MutexScopeLock scopeLock( m_statisticsLock );
+
+	ResourceTypeStatistics* pStatistics = NULL;
+
+	size_t typeCount = m_resourceTypeStatistics.GetSize();
+	for( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+	{
+		if( m_resourceTypeStatistics[ typeIndex ].pType == pType )
+		{
+			pStatistics = &m_resourceTypeStatistics[ typeIndex ];
+
+			break;
+		}
+	}
+
+	if( !pStatistics )
+	{
+		pStatistics = m_resourceTypeStatistics.New();
+		HELIUM_ASSERT( pStatistics );
+		pStatistics->pType = pType;
+		pStatistics->resourceCount = 0;
+		pStatistics->failureCount = 0;
+		pStatistics->concurrentResourceCount = 0;
+		pStatistics->ticks = 0;
+	}
+
+	++pStatistics->resourceCount;
+	pStatistics->failureCount += ( bSuccess ? 0 : 1 );
+	pStatistics->concurrentResourceCount += ( bConcurrent ? 1 : 0 );
+	pStatistics->ticks += ticks;
+}
+
+/// Load the cook database from the cache directory of the current platform if it has not been loaded yet.
+void AssetPreprocessor::ConditionalLoadCookDatabase()
+{
+	if( m_bCookDatabaseLoaded )
+	{
+		return;
+	}
+
+	m_bCookDatabaseLoaded = true;
+
+	String fileName = CacheManager::GetStaticInstance().GetPlatformDataDirectory();
+	fileName += HELIUM_COOK_DATABASE_FILE_NAME;
+
+	m_cookDatabase.Load( fileName );
+
+	// Input stamps only depend on file paths relative to the data directory, so cooked data stays valid when the
+	// project is moved.
+	FilePath dataDirectory;
+	if( FileLocations::GetDataDirectory( dataDirectory ) )
+	{
+		m_cookDatabase.SetDataDirectory( String( dataDirectory.c_str() ) );
+	}
+}
+
+/// Start a new cook database record for an asset, recording the inputs common to all assets: the asset file itself,
+/// the source file (for resources), and the template from which the asset was created.
+///
+/// @param[in] path             Asset path.
+/// @param[in] pObject          Asset instance.
+/// @param[in] rSourceFilePath  Path of the source file from which the asset is preprocessed, or an empty string if
+///                             the asset is not a resource.
+void AssetPreprocessor::RecordBaseDependencies( const AssetPath &path, Asset* pObject, const String& rSourceFilePath )
+{
+	HELIUM_ASSERT( pObject );
+
+	m_cookDatabase.BeginAsset( path );
+	m_cookDatabase.AddFileDependency( path, GetAssetFilePath( path ) );
+
+	if( !rSourceFilePath.IsEmpty() && FilePath( *rSourceFilePath ).Exists() )
+	{
+		m_cookDatabase.AddFileDependency( path, rSourceFilePath );
+	}
+
+	Asset* pTemplate = Reflect::AssertCast< Asset >( pObject->GetTemplate() );
+	if( pTemplate && !pTemplate->IsDefaultTemplate() )
+	{
+		m_cookDatabase.AddAssetDependency( path, pTemplate->GetPath() );
+	}
+}
 #endif  // HELIUM_TOOLS
@@ -2,7 +2,10 @@
 
 #include "PcSupport/PcSupport.h"
 
+#include "Platform/Locks.h"
+#include "Foundation/HashMap.h"
 #include "Engine/Cache.h"
+#include "PcSupport/CookDatabase.h"
 
 namespace Helium
 {
@@ -30,6 +33,29 @@ namespace Helium
         void LoadResourceData( const AssetPath &path, Resource* pResource );
         //@}
 
+        /// @name Incremental Cooking
+        //@{
+#if HELIUM_TOOLS
+        int64_t GetObjectInputStamp( const AssetPath &path, Asset* pObject );
+
+        void AddFileDependency( const AssetPath &path, const String& rFilePath );
+        void AddAssetDependency( const AssetPath &path, const AssetPath &dependencyPath );
+
+        bool SaveCookDatabase();
+#endif
+        //@}
+
+        /// @name Batch Cooking
+        //@{
+#if HELIUM_TOOLS
+        void BeginBatchCook();
+        bool EndBatchCook( size_t workerCount );
+        inline bool IsBatchCooking() const;
+
+        void TraceBatchCookSummary() const;
+#endif
+        //@}
+
         /// @name Static Access
         //@{
         static AssetPreprocessor* CreateStaticInstance();
@@ -39,9 +65,80 @@ namespace Helium
        //@}
 
     private:
+#if HELIUM_TOOLS
+        /// Resource whose preprocessing has been deferred until the end of a batch cook.
+        struct DeferredResource
+        {
+            /// Resource path.
+            AssetPath path;
+            /// Resource instance.
+            AssetPtr spResource;
+            /// Source file path.
+            String sourceFilePath;
+            /// True if preprocessing succeeded.
+            bool bSuccess;
+        };
+
+        /// Object whose caching has been deferred until the end of a batch cook.
+        struct DeferredObject
+        {
+            /// Object path.
+            AssetPath path;
+            /// Object path string (used for sorting).
+            String pathString;
+            /// Object instance.
+            AssetPtr spObject;
+            /// True to evict the platform preprocessed resource data after caching.
+            bool bEvictPlatformPreprocessedResourceData;
+        };
+
+        /// Batch cook statistics for a single resource type.
+        struct ResourceTypeStatistics
+        {
+            /// Resource type.
+            const AssetType* pType;
+            /// Number of resources preprocessed.
+            uint32_t resourceCount;
+            /// Number of resources that failed to preprocess.
+            uint32_t failureCount;
+            /// Number of resources preprocessed on batch worker threads.
+            uint32_t concurrentResourceCount;
+            /// Total preprocessing time, in timer ticks.
+            uint64_t ticks;
+        };
+#endif
+
         /// Platform-specific preprocessing support.
         PlatformPreprocessor* m_pPlatformPreprocessors[ Cache::PLATFORM_MAX ];
 
+#if HELIUM_TOOLS
+        /// Inputs recorded for each cooked asset.
+        CookDatabase m_cookDatabase;
+        /// True if the cook database has been loaded.
+        bool m_bCookDatabaseLoaded;
+
+        /// True if a batch cook is in progress.
+        bool m_bBatchCooking;
+        /// Resources to preprocess on worker threads at the end of the batch cook.
+        DynamicArray< DeferredResource > m_deferredResources;
+        /// Index of the next deferred resource to preprocess.
+        volatile int32_t m_nextDeferredResourceIndex;
+        /// Objects to cache at the end of the batch cook.
+        DynamicArray< DeferredObject > m_deferredObjects;
+        /// Deferred object lookup by path.
+        HashMap< AssetPath, size_t > m_deferredObjectIndices;
+        /// Per-resource type preprocessing statistics for the current batch cook.
+        DynamicArray< ResourceTypeStatistics > m_resourceTypeStatistics;
+        /// Lock for synchronizing access to the resource type statistics.
+        mutable Mutex m_statisticsLock;
+        /// Number of resources loaded from up-to-date cached data during the current batch cook.
+        uint32_t m_upToDateResourceCount;
+        /// Batch cook start time, in timer ticks.
+        uint64_t m_batchCookStartTicks;
+        /// Batch cook end time, in timer ticks.
+        uint64_t m_batchCookEndTicks;
+#endif
+
         /// Singleton instance.
         static AssetPreprocessor* sm_pInstance;
 
@@ -56,6 +153,17 @@ namespace Helium
 #if HELIUM_TOOLS
         bool LoadCachedResourceData( const AssetPath &path, Resource* pResource, Cache::EPlatform platform );
         bool PreprocessResource( const AssetPath &path, Resource* pResource, const String& rSourceFilePath );
+        bool PreprocessResourceData(
+            const AssetPath &path, Resource* pResource, const String& rSourceFilePath, bool bConcurrent );
+        void LoadPreprocessedPersistentResourceData( Resource* pResource );
+
+        bool DeferResourcePreprocessing(
+            const AssetPath &path, Resource* pResource, const String& rSourceFilePath );
+        void BatchCookThreadProc();
+        void AddResourceTypeStatistics( const AssetType* pType, uint64_t ticks, bool bSuccess, bool bConcurrent );
+
+        void ConditionalLoadCookDatabase();
+        void RecordBaseDependencies( const AssetPath &path, Asset* pObject, const String& rSourceFilePath );
 
         uint32_t LoadPersistentResourceData(
             AssetPath resourcePath, Cache::EPlatform platform, DynamicArray< uint8_t >& rPersistentDataBuffer );
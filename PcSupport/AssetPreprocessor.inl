@@ -13,4 +13,16 @@ namespace Helium
 
         return m_pPlatformPreprocessors[ platform ];
     }
+
+#if HELIUM_TOOLS
+    /// Get whether a batch cook is in progress.
+    ///
+    /// @return  True if a batch cook is in progress, false if not.
+    ///
+    /// @see BeginBatchCook(), EndBatchCook()
+    bool AssetPreprocessor::IsBatchCooking() const
+    {
+        return m_bBatchCooking;
+    }
+#endif
 }
@@ -0,0 +1,872 @@
+#include "PcSupportPch.h"
+
+#if HELIUM_TOOLS
+
+#include "PcSupport/CookDatabase.h"
+
+#include "Platform/File.h"
+#include "Foundation/FilePath.h"
+#include "Foundation/FileStream.h"
+
+#include <string>
+
+using namespace Helium;
+
+/// Cook database file identifier ('CKDB').
+static const uint32_t COOK_DATABASE_MAGIC = 0x42444b43;
+/// Size of the buffer used when reading files for hashing.
+static const size_t FILE_HASH_BUFFER_SIZE = 64 * 1024;
+
+/// FNV-1a 64-bit offset basis.
+static const uint64_t HASH_OFFSET_BASIS = 0xcbf29ce484222325ull;
+/// FNV-1a 64-bit prime.
+static const uint64_t HASH_PRIME = 0x100000001b3ull;
+
+/// Accumulate a block of data into a 64-bit FNV-1a hash.
+///
+/// @param[in] hash   Current hash value.
+/// @param[in] pData  Data to hash.
+/// @param[in] size   Size of the data, in bytes.
+///
+/// @return  Updated hash value.
+static uint64_t HashData( uint64_t hash, const void* pData, size_t size )
+{
+	const uint8_t* pBytes = static_cast< const uint8_t* >( pData );
+	for( size_t byteIndex = 0; byteIndex < size; ++byteIndex )
+	{
+		hash ^= pBytes[ byteIndex ];
+		hash *= HASH_PRIME;
+	}
+
+	return hash;
+}
+
+/// Accumulate a null-terminated string (including the terminator, so that consecutive strings cannot run together)
+/// into a 64-bit FNV-1a hash.
+///
+/// @param[in] hash     Current hash value.
+/// @param[in] pString  String to hash.
+///
+/// @return  Updated hash value.
+static uint64_t HashString( uint64_t hash, const char* pString )
+{
+	HELIUM_ASSERT( pString );
+
+	return HashData( hash, pString, StringLength( pString ) + 1 );
+}
+
+/// Append a value to a database write buffer.
+///
+/// @param[in] rBuffer  Buffer to which the value should be appended.
+/// @param[in] rValue   Value to append.
+template< typename T >
+static void WriteValue( DynamicArray< uint8_t >& rBuffer, const T& rValue )
+{
+	rBuffer.AddArray( reinterpret_cast< const uint8_t* >( &rValue ), sizeof( rValue ) );
+}
+
+/// Append a string (prefixed by its length) to a database write buffer.
+///
+/// @param[in] rBuffer  Buffer to which the string should be appended.
+/// @param[in] pString  String to append.
+static void WriteString( DynamicArray< uint8_t >& rBuffer, const char* pString )
+{
+	HELIUM_ASSERT( pString );
+
+	uint32_t length = static_cast< uint32_t >( StringLength( pString ) );
+	WriteValue( rBuffer, length );
+	rBuffer.AddArray( reinterpret_cast< const uint8_t* >( pString ), length );
+}
+
+/// Read a value from a database read buffer.
+///
+/// @param[out]    rValue      Value read.
+/// @param[in,out] rpCurrent   Current read position, advanced past the value if it was read successfully.
+/// @param[in]     pEnd        End of the buffer.
+///
+/// @return  True if the value was read, false if the end of the buffer was reached.
+template< typename T >
+static bool ReadValue( T& rValue, const uint8_t*& rpCurrent, const uint8_t* pEnd )
+{
+	if( static_cast< size_t >( pEnd - rpCurrent ) < sizeof( rValue ) )
+	{
+		return false;
+	}
+
+	MemoryCopy( &rValue, rpCurrent, sizeof( rValue ) );
+	rpCurrent += sizeof( rValue );
+
+	return true;
+}
+
+/// Read a string (prefixed by its length) from a database read buffer.
+///
+/// @param[out]    rString     String read.
+/// @param[in,out] rpCurrent   Current read position, advanced past the string if it was read successfully.
+/// @param[in]     pEnd        End of the buffer.
+///
+/// @return  True if the string was read, false if the end of the buffer was reached.
+static bool ReadString( std::string& rString, const uint8_t*& rpCurrent, const uint8_t* pEnd )
+{
+	uint32_t length;
+	if( !ReadValue( length, rpCurrent, pEnd ) || static_cast< size_t >( pEnd - rpCurrent ) < length )
+	{
+		return false;
+	}
+
+	rString.assign( reinterpret_cast< const char* >( rpCurrent ), length );
+	rpCurrent += length;
+
+	return true;
+}
+
+/// Constructor.
+CookDatabase::CookDatabase()
+	: m_cookIndex( 0 )
+	, m_bCooking( false )
+	, m_bDirty( false )
+	, m_fileHashCount( 0 )
+	, m_fileRehashCount( 0 )
+{
+}
+
+/// Destructor.
+CookDatabase::~CookDatabase()
+{
+}
+
+/// Load the database from disk.
+///
+/// Any existing contents are discarded.  If the file does not exist or cannot be parsed, the database is left empty
+/// (so that everything will be cooked again), and subsequent calls to Save() will still write to the given file.
+///
+/// @param[in] rFileName  Database file name.
+///
+/// @return  True if the database was loaded successfully, false if not.
+///
+/// @see Save()
+bool CookDatabase::Load( const String& rFileName )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	m_fileName = rFileName;
+	m_files.Clear();
+	m_assets.Clear();
+	m_bDirty = false;
+	InvalidateInputStamps();
+
+	FileStream* pStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_READ );
+	if( !pStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "CookDatabase: No cook database found at \"%s\".  All assets will be cooked.\n" ),
+			*rFileName );
+
+		return false;
+	}
+
+	int64_t size64 = pStream->GetSize();
+	if( size64 < 0 || static_cast< uint64_t >( size64 ) > static_cast< size_t >( -1 ) )
+	{
+		delete pStream;
+
+		return false;
+	}
+
+	size_t size = static_cast< size_t >( size64 );
+
+	DynamicArray< uint8_t > buffer;
+	buffer.Resize( size );
+	size_t bytesRead = ( size != 0 ? pStream->Read( buffer.GetData(), 1, size ) : 0 );
+
+	delete pStream;
+
+	const uint8_t* pCurrent = buffer.GetData();
+	const uint8_t* pEnd = pCurrent + bytesRead;
+
+	bool bValid = ( bytesRead == size );
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	bValid = bValid && ReadValue( magic, pCurrent, pEnd ) && magic == COOK_DATABASE_MAGIC;
+	bValid = bValid && ReadValue( version, pCurrent, pEnd ) && version == VERSION;
+
+	// Files are referenced by index from the asset records.
+	DynamicArray< Name > fileNames;
+
+	uint32_t fileCount = 0;
+	bValid = bValid && ReadValue( fileCount, pCurrent, pEnd );
+	if( bValid )
+	{
+		fileNames.Reserve( fileCount );
+	}
+
+	std::string string;
+	for( uint32_t fileIndex = 0; bValid && fileIndex < fileCount; ++fileIndex )
+	{
+		FileRecord record;
+		record.cookIndex = 0;
+		bValid = ReadString( string, pCurrent, pEnd ) &&
+			ReadValue( record.timestamp, pCurrent, pEnd ) &&
+			ReadValue( record.size, pCurrent, pEnd ) &&
+			ReadValue( record.hash, pCurrent, pEnd );
+		if( bValid )
+		{
+			Name fileName( string.c_str() );
+			fileNames.Push( fileName );
+
+			// Files that did not exist when the database was saved are stored with a negative size.
+			HashMap< Name, FileRecord >::Iterator fileIterator = m_files.Find( fileName );
+			if( record.size >= 0 && fileIterator == m_files.End() )
+			{
+				m_files.Insert( fileIterator, KeyValue< Name, FileRecord >( fileName, record ) );
+			}
+		}
+	}
+
+	uint32_t assetCount = 0;
+	bValid = bValid && ReadValue( assetCount, pCurrent, pEnd );
+
+	for( uint32_t assetIndex = 0; bValid && assetIndex < assetCount; ++assetIndex )
+	{
+		AssetPath path;
+		bValid = ReadString( string, pCurrent, pEnd ) && path.Set( string.c_str() );
+
+		AssetRecord record;
+
+		uint32_t assetFileCount = 0;
+		bValid = bValid && ReadValue( assetFileCount, pCurrent, pEnd );
+		for( uint32_t assetFileIndex = 0; bValid && assetFileIndex < assetFileCount; ++assetFileIndex )
+		{
+			uint32_t fileIndex;
+			bValid = ReadValue( fileIndex, pCurrent, pEnd ) && fileIndex < fileNames.GetSize();
+			if( bValid )
+			{
+				record.files.Push( fileNames[ fileIndex ] );
+			}
+		}
+
+		uint32_t dependencyCount = 0;
+		bValid = bValid && ReadValue( dependencyCount, pCurrent, pEnd );
+		for( uint32_t dependencyIndex = 0; bValid && dependencyIndex < dependencyCount; ++dependencyIndex )
+		{
+			AssetPath dependencyPath;
+			bValid = ReadString( string, pCurrent, pEnd ) && dependencyPath.Set( string.c_str() );
+			if( bValid )
+			{
+				record.dependencies.Push( dependencyPath );
+			}
+		}
+
+		if( bValid )
+		{
+			HashMap< AssetPath, AssetRecord >::Iterator assetIterator = m_assets.Find( path );
+			if( assetIterator == m_assets.End() )
+			{
+				m_assets.Insert( assetIterator, KeyValue< AssetPath, AssetRecord >( path, record ) );
+			}
+		}
+	}
+
+	if( !bValid )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "CookDatabase: Cook database \"%s\" is out of date or corrupt.  All assets will be cooked.\n" ),
+			*rFileName );
+
+		m_files.Clear();
+		m_assets.Clear();
+
+		return false;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "CookDatabase: Loaded %" ) PRIu32 TXT( " asset records referencing %" ) PRIu32 TXT( " files.\n" ),
+		assetCount,
+		fileCount );
+
+	return true;
+}
+
+/// Write the database to the file from which it was loaded, if it has been modified.
+///
+/// Only files that are still referenced by an asset record are written.  Referenced files that could not be hashed
+/// (i.e. because they do not exist) are still written, so that input stamps do not change when the database is
+/// reloaded.
+///
+/// @return  True if the database was written successfully or did not need to be written, false if not.
+///
+/// @see Load()
+bool CookDatabase::Save()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	if( !m_bDirty )
+	{
+		return true;
+	}
+
+	if( m_fileName.IsEmpty() )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "CookDatabase::Save(): No database file name has been set.\n" ) );
+
+		return false;
+	}
+
+	// Assign indices to the files still referenced by an asset record.
+	HashMap< Name, uint32_t > fileIndices;
+	DynamicArray< Name > fileNames;
+
+	HashMap< AssetPath, AssetRecord >::ConstIterator assetEnd = m_assets.End();
+	for( HashMap< AssetPath, AssetRecord >::ConstIterator assetIterator = m_assets.Begin();
+		assetIterator != assetEnd;
+		++assetIterator )
+	{
+		const DynamicArray< Name >& rFiles = assetIterator->Second().files;
+		size_t assetFileCount = rFiles.GetSize();
+		for( size_t assetFileIndex = 0; assetFileIndex < assetFileCount; ++assetFileIndex )
+		{
+			Name fileName = rFiles[ assetFileIndex ];
+			HashMap< Name, uint32_t >::Iterator indexIterator = fileIndices.Find( fileName );
+			if( indexIterator == fileIndices.End() )
+			{
+				fileIndices.Insert(
+					indexIterator,
+					KeyValue< Name, uint32_t >( fileName, static_cast< uint32_t >( fileNames.GetSize() ) ) );
+				fileNames.Push( fileName );
+			}
+		}
+	}
+
+	DynamicArray< uint8_t > buffer;
+	WriteValue( buffer, COOK_DATABASE_MAGIC );
+	WriteValue( buffer, VERSION );
+
+	uint32_t fileCount = static_cast< uint32_t >( fileNames.GetSize() );
+	WriteValue( buffer, fileCount );
+	for( uint32_t fileIndex = 0; fileIndex < fileCount; ++fileIndex )
+	{
+		Name fileName = fileNames[ fileIndex ];
+
+		FileRecord record;
+		record.timestamp = 0;
+		record.size = -1;
+		record.hash = 0;
+		record.cookIndex = 0;
+
+		HashMap< Name, FileRecord >::ConstIterator fileIterator = m_files.Find( fileName );
+		if( fileIterator != m_files.End() )
+		{
+			record = fileIterator->Second();
+		}
+
+		WriteString( buffer, *fileName );
+		WriteValue( buffer, record.timestamp );
+		WriteValue( buffer, record.size );
+		WriteValue( buffer, record.hash );
+	}
+
+	uint32_t assetCount = static_cast< uint32_t >( m_assets.GetSize() );
+	WriteValue( buffer, assetCount );
+
+	String pathString;
+	for( HashMap< AssetPath, AssetRecord >::ConstIterator assetIterator = m_assets.Begin();
+		assetIterator != assetEnd;
+		++assetIterator )
+	{
+		assetIterator->First().ToString( pathString );
+		WriteString( buffer, *pathString );
+
+		const AssetRecord& rRecord = assetIterator->Second();
+
+		size_t assetFileCount = rRecord.files.GetSize();
+		WriteValue( buffer, static_cast< uint32_t >( assetFileCount ) );
+		for( size_t assetFileIndex = 0; assetFileIndex < assetFileCount; ++assetFileIndex )
+		{
+			HashMap< Name, uint32_t >::ConstIterator indexIterator = fileIndices.Find( rRecord.files[ assetFileIndex ] );
+			HELIUM_ASSERT( indexIterator != fileIndices.End() );
+			WriteValue( buffer, indexIterator->Second() );
+		}
+
+		size_t dependencyCount = rRecord.dependencies.GetSize();
+		WriteValue( buffer, static_cast< uint32_t >( dependencyCount ) );
+		for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+		{
+			rRecord.dependencies[ dependencyIndex ].ToString( pathString );
+			WriteString( buffer, *pathString );
+		}
+	}
+
+	FileStream* pStream = FileStream::OpenFileStream( m_fileName, FileStream::MODE_WRITE, true );
+	if( !pStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "CookDatabase::Save(): Failed to open \"%s\" for writing.\n" ),
+			*m_fileName );
+
+		return false;
+	}
+
+	size_t bytesWritten = pStream->Write( buffer.GetData(), 1, buffer.GetSize() );
+
+	delete pStream;
+
+	if( bytesWritten != buffer.GetSize() )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "CookDatabase::Save(): Failed to write \"%s\".\n" ), *m_fileName );
+
+		// Never leave a partially written database behind.
+		FilePath( *m_fileName ).Delete();
+
+		return false;
+	}
+
+	m_bDirty = false;
+
+	return true;
+}
+
+/// Set the data directory, relative to which file paths are hashed into input stamps.  Files outside the data directory
+/// are hashed using their full path.
+///
+/// @param[in] rDirectory  Data directory path, with a trailing path separator character.
+void CookDatabase::SetDataDirectory( const String& rDirectory )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	m_dataDirectory = rDirectory;
+	InvalidateInputStamps();
+}
+
+/// Begin recording the inputs of an asset that is about to be cooked, discarding any inputs previously recorded for
+/// it.
+///
+/// @param[in] path  Asset path.
+///
+/// @see AddFileDependency(), AddAssetDependency(), RemoveAsset()
+void CookDatabase::BeginAsset( const AssetPath& path )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	HashMap< AssetPath, AssetRecord >::Iterator assetIterator = m_assets.Find( path );
+	if( assetIterator != m_assets.End() )
+	{
+		assetIterator->Second().files.Clear();
+		assetIterator->Second().dependencies.Clear();
+	}
+	else
+	{
+		m_assets.Insert( assetIterator, KeyValue< AssetPath, AssetRecord >( path, AssetRecord() ) );
+	}
+
+	m_bDirty = true;
+	InvalidateInputStamps();
+}
+
+/// Record a file read while cooking an asset.
+///
+/// @param[in] path       Asset path.
+/// @param[in] rFilePath  Path of the file on which the asset depends.
+///
+/// @see BeginAsset(), AddAssetDependency()
+void CookDatabase::AddFileDependency( const AssetPath& path, const String& rFilePath )
+{
+	if( rFilePath.IsEmpty() )
+	{
+		return;
+	}
+
+	Name fileName( *rFilePath );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	HashMap< AssetPath, AssetRecord >::Iterator assetIterator = m_assets.Find( path );
+	HELIUM_ASSERT( assetIterator != m_assets.End() );
+	if( assetIterator == m_assets.End() )
+	{
+		return;
+	}
+
+	DynamicArray< Name >& rFiles = assetIterator->Second().files;
+	size_t fileCount = rFiles.GetSize();
+	for( size_t fileIndex = 0; fileIndex < fileCount; ++fileIndex )
+	{
+		if( rFiles[ fileIndex ] == fileName )
+		{
+			return;
+		}
+	}
+
+	rFiles.Push( fileName );
+	m_bDirty = true;
+	InvalidateInputStamps();
+}
+
+/// Record an asset whose cooked data was used while cooking another asset.
+///
+/// @param[in] path            Asset path.
+/// @param[in] dependencyPath  Path of the asset on which the asset depends.
+///
+/// @see BeginAsset(), AddFileDependency()
+void CookDatabase::AddAssetDependency( const AssetPath& path, const AssetPath& dependencyPath )
+{
+	if( dependencyPath.IsEmpty() || dependencyPath == path )
+	{
+		return;
+	}
+
+	MutexScopeLock scopeLock( m_lock );
+
+	HashMap< AssetPath, AssetRecord >::Iterator assetIterator = m_assets.Find( path );
+	HELIUM_ASSERT( assetIterator != m_assets.End() );
+	if( assetIterator == m_assets.End() )
+	{
+		return;
+	}
+
+	DynamicArray< AssetPath >& rDependencies = assetIterator->Second().dependencies;
+	size_t dependencyCount = rDependencies.GetSize();
+	for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+	{
+		if( rDependencies[ dependencyIndex ] == dependencyPath )
+		{
+			return;
+		}
+	}
+
+	rDependencies.Push( dependencyPath );
+	m_bDirty = true;
+	InvalidateInputStamps();
+}
+
+/// Remove the record of an asset (i.e. because cooking it failed), so that it will always be treated as out of date.
+///
+/// @param[in] path  Asset path.
+///
+/// @see BeginAsset()
+void CookDatabase::RemoveAsset( const AssetPath& path )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	HashMap< AssetPath, AssetRecord >::Iterator assetIterator = m_assets.Find( path );
+	if( assetIterator != m_assets.End() )
+	{
+		m_assets.Remove( assetIterator );
+		m_bDirty = true;
+		InvalidateInputStamps();
+	}
+}
+
+/// Get whether inputs have been recorded for an asset.
+///
+/// @param[in] path  Asset path.
+///
+/// @return  True if the asset has a record in the database, false if not.
+bool CookDatabase::HasAsset( const AssetPath& path ) const
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	return ( m_assets.Find( path ) != m_assets.End() );
+}
+
+/// Begin a cook.
+///
+/// Until EndCook() is called, input files are assumed not to change, so each file is only checked once and input
+/// stamps are reused by later calls to GetInputStamp() until a record they may depend on is modified.
+///
+/// @see EndCook(), GetInputStamp()
+void CookDatabase::BeginCook()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	HELIUM_ASSERT( !m_bCooking );
+
+	// Skip zero, which marks files that have not been checked during any cook.
+	++m_cookIndex;
+	if( m_cookIndex == 0 )
+	{
+		m_cookIndex = 1;
+	}
+
+	m_bCooking = true;
+	InvalidateInputStamps();
+}
+
+/// End a cook started with BeginCook().
+///
+/// @see BeginCook()
+void CookDatabase::EndCook()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	HELIUM_ASSERT( m_bCooking );
+
+	m_bCooking = false;
+	InvalidateInputStamps();
+}
+
+/// Compute the input stamp of an asset from the current contents of all the files it transitively depends on.
+///
+/// @param[in] path  Asset path.
+///
+/// @return  Input stamp (never zero), or zero if no inputs have been recorded for the asset.
+///
+/// @see BeginCook()
+int64_t CookDatabase::GetInputStamp( const AssetPath& path )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	if( m_assets.Find( path ) == m_assets.End() )
+	{
+		return 0;
+	}
+
+	HashMap< AssetPath, uint64_t > stamps;
+	bool bCyclic = false;
+	uint64_t stamp = ComputeInputStamp( path, stamps, bCyclic );
+
+	// Zero is reserved for assets that have not been cooked.
+	return ( stamp != 0 ? static_cast< int64_t >( stamp ) : 1 );
+}
+
+/// Get the content hash of a file, only reading the file if its size or modification time has changed since it was
+/// last hashed.
+///
+/// @param[in] rFilePath  File path.
+///
+/// @return  Content hash, or zero if the file could not be read.
+uint64_t CookDatabase::GetFileHash( const String& rFilePath )
+{
+	Name fileName( *rFilePath );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	return UpdateFileHash( fileName );
+}
+
+/// Reset the file hash statistics.
+///
+/// @see GetFileHashCount(), GetFileRehashCount()
+void CookDatabase::ResetStatistics()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	m_fileHashCount = 0;
+	m_fileRehashCount = 0;
+}
+
+/// Get the content hash of a file, rehashing it if necessary.  The database lock must be held by the caller.
+///
+/// @param[in] filePath  File path.
+///
+/// @return  Content hash, or zero if the file could not be read.
+uint64_t CookDatabase::UpdateFileHash( Name filePath )
+{
+	HashMap< Name, FileRecord >::Iterator fileIterator = m_files.Find( filePath );
+	if( m_bCooking && fileIterator != m_files.End() && fileIterator->Second().cookIndex == m_cookIndex )
+	{
+		return fileIterator->Second().hash;
+	}
+
+	++m_fileHashCount;
+
+	Status stat;
+	if( !stat.Read( *filePath ) )
+	{
+		if( fileIterator != m_files.End() )
+		{
+			m_files.Remove( fileIterator );
+			m_bDirty = true;
+		}
+
+		return 0;
+	}
+
+	int64_t timestamp = static_cast< int64_t >( stat.m_ModifiedTime );
+	int64_t size = static_cast< int64_t >( stat.m_Size );
+
+	if( fileIterator != m_files.End() )
+	{
+		FileRecord& rRecord = fileIterator->Second();
+		if( rRecord.timestamp == timestamp && rRecord.size == size )
+		{
+			rRecord.cookIndex = m_cookIndex;
+
+			return rRecord.hash;
+		}
+	}
+
+	++m_fileRehashCount;
+
+	FileStream* pStream = FileStream::OpenFileStream( String( *filePath ), FileStream::MODE_READ );
+	if( !pStream )
+	{
+		return 0;
+	}
+
+	DynamicArray< uint8_t > buffer;
+	buffer.Resize( FILE_HASH_BUFFER_SIZE );
+
+	uint64_t hash = HASH_OFFSET_BASIS;
+	for( ; ; )
+	{
+		size_t bytesRead = pStream->Read( buffer.GetData(), 1, FILE_HASH_BUFFER_SIZE );
+		if( bytesRead == 0 )
+		{
+			break;
+		}
+
+		hash = HashData( hash, buffer.GetData(), bytesRead );
+	}
+
+	delete pStream;
+
+	// Zero is reserved for files that could not be read.
+	if( hash == 0 )
+	{
+		hash = 1;
+	}
+
+	if( fileIterator != m_files.End() )
+	{
+		FileRecord& rRecord = fileIterator->Second();
+		if( rRecord.hash != hash )
+		{
+			HELIUM_TRACE( TraceLevels::Info, TXT( "CookDatabase: \"%s\" has changed.\n" ), *filePath );
+		}
+
+		rRecord.timestamp = timestamp;
+		rRecord.size = size;
+		rRecord.hash = hash;
+		rRecord.cookIndex = m_cookIndex;
+	}
+	else
+	{
+		FileRecord record;
+		record.timestamp = timestamp;
+		record.size = size;
+		record.hash = hash;
+		record.cookIndex = m_cookIndex;
+		m_files.Insert( fileIterator, KeyValue< Name, FileRecord >( filePath, record ) );
+	}
+
+	m_bDirty = true;
+
+	return hash;
+}
+
+/// Compute the input stamp of an asset.  The database lock must be held by the caller.
+///
+/// @param[in]     path      Asset path.
+/// @param[in,out] rStamps   Stamps computed for the current request that could not be kept for the rest of the cook.
+///                          Assets whose stamps are still being computed are stored with a stamp of zero, which breaks
+///                          dependency cycles.
+/// @param[out]    rbCyclic  Set to true if the stamp depends on a dependency cycle (and therefore on the asset from
+///                          which the current request started), left unchanged if not.
+///
+/// @return  Input stamp, or zero if no inputs have been recorded for the asset.
+uint64_t CookDatabase::ComputeInputStamp(
+	const AssetPath& path,
+	HashMap< AssetPath, uint64_t >& rStamps,
+	bool& rbCyclic )
+{
+	HashMap< AssetPath, uint64_t >::ConstIterator cookStampIterator = m_inputStamps.Find( path );
+	if( cookStampIterator != m_inputStamps.End() )
+	{
+		return cookStampIterator->Second();
+	}
+
+	HashMap< AssetPath, uint64_t >::Iterator stampIterator = rStamps.Find( path );
+	if( stampIterator != rStamps.End() )
+	{
+		rbCyclic = true;
+
+		return stampIterator->Second();
+	}
+
+	rStamps.Insert( stampIterator, KeyValue< AssetPath, uint64_t >( path, 0 ) );
+
+	HashMap< AssetPath, AssetRecord >::ConstIterator assetIterator = m_assets.Find( path );
+	if( assetIterator == m_assets.End() )
+	{
+		return 0;
+	}
+
+	// Computing stamps only ever updates the file table, so the record remains valid while recursing.
+	const AssetRecord& rRecord = assetIterator->Second();
+
+	uint64_t stamp = HASH_OFFSET_BASIS;
+	stamp = HashData( stamp, &VERSION, sizeof( VERSION ) );
+
+	size_t fileCount = rRecord.files.GetSize();
+	for( size_t fileIndex = 0; fileIndex < fileCount; ++fileIndex )
+	{
+		Name fileName = rRecord.files[ fileIndex ];
+		uint64_t fileHash = UpdateFileHash( fileName );
+
+		stamp = HashString( stamp, GetRelativeFilePath( fileName ) );
+		stamp = HashData( stamp, &fileHash, sizeof( fileHash ) );
+	}
+
+	bool bCyclic = false;
+	String dependencyPathString;
+	size_t dependencyCount = rRecord.dependencies.GetSize();
+	for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+	{
+		AssetPath dependencyPath = rRecord.dependencies[ dependencyIndex ];
+		uint64_t dependencyStamp = ComputeInputStamp( dependencyPath, rStamps, bCyclic );
+
+		dependencyPath.ToString( dependencyPathString );
+		stamp = HashString( stamp, *dependencyPathString );
+		stamp = HashData( stamp, &dependencyStamp, sizeof( dependencyStamp ) );
+	}
+
+	stampIterator = rStamps.Find( path );
+	HELIUM_ASSERT( stampIterator != rStamps.End() );
+	stampIterator->Second() = stamp;
+
+	// Stamps that depend on a cycle vary with the asset from which the request started, so they are never reused.
+	if( bCyclic )
+	{
+		rbCyclic = true;
+	}
+	else if( m_bCooking )
+	{
+		HashMap< AssetPath, uint64_t >::Iterator inputStampIterator = m_inputStamps.Find( path );
+		HELIUM_ASSERT( inputStampIterator == m_inputStamps.End() );
+		m_inputStamps.Insert( inputStampIterator, KeyValue< AssetPath, uint64_t >( path, stamp ) );
+	}
+
+	return stamp;
+}
+
+/// Get the part of a file path that is hashed into input stamps.  The database lock must be held by the caller.
+///
+/// @param[in] filePath  File path.
+///
+/// @return  File path relative to the data directory, or the full file path if the file is outside the data directory.
+const char* CookDatabase::GetRelativeFilePath( Name filePath ) const
+{
+	const char* pFilePath = *filePath;
+
+	size_t directoryLength = m_dataDirectory.GetSize();
+	if( directoryLength != 0 && CompareString( pFilePath, *m_dataDirectory, directoryLength ) == 0 )
+	{
+		pFilePath += directoryLength;
+	}
+
+	return pFilePath;
+}
+
+/// Discard the input stamps kept for the current cook (i.e. because an asset record has been modified).  The database
+/// lock must be held by the caller.
+void CookDatabase::InvalidateInputStamps()
+{
+	m_inputStamps.Clear();
+}
+
+#endif  // HELIUM_TOOLS
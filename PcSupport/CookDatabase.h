@@ -0,0 +1,141 @@
+#pragma once
+
+#include "PcSupport/PcSupport.h"
+
+#if HELIUM_TOOLS
+
+#include "Platform/Locks.h"
+#include "Foundation/HashMap.h"
+#include "Foundation/Name.h"
+#include "Engine/AssetPath.h"
+
+/// Cook database file name (stored in the cache directory of the current platform).
+#define HELIUM_COOK_DATABASE_FILE_NAME TXT( "CookDatabase.dat" )
+
+namespace Helium
+{
+    /// Persistent record of the inputs used to cook each asset.
+    ///
+    /// For each cooked asset, the database records the files it was built from and the other assets whose cooked data
+    /// it consumed.  A content hash is stored for every file along with the size and modification time it had when it
+    /// was hashed, so files are only read again when their size or modification time changes, and a file that is
+    /// touched without being modified still produces the same hash.  The input stamp of an asset combines the content
+    /// hashes of its files with the input stamps of the assets it depends on, so it changes exactly when something in
+    /// the transitive closure of its inputs has changed.  File paths are hashed relative to the data directory, so
+    /// stamps do not depend on where the project is checked out.
+    ///
+    /// While a cook is in progress (between BeginCook() and EndCook()), input files are assumed not to change: each file
+    /// is only checked once, and the stamps of assets are kept until a record they may depend on is modified.
+    ///
+    /// All functions are thread-safe.
+    class HELIUM_PC_SUPPORT_API CookDatabase : NonCopyable
+    {
+    public:
+        /// Current database file format version number.  Since the version is also hashed into every input stamp,
+        /// changing it invalidates all previously cooked data.
+        static const uint32_t VERSION = 2;
+
+        /// @name Construction/Destruction
+        //@{
+        CookDatabase();
+        ~CookDatabase();
+        //@}
+
+        /// @name Saving/Loading
+        //@{
+        bool Load( const String& rFileName );
+        bool Save();
+
+        void SetDataDirectory( const String& rDirectory );
+        //@}
+
+        /// @name Dependency Recording
+        //@{
+        void BeginAsset( const AssetPath& path );
+        void AddFileDependency( const AssetPath& path, const String& rFilePath );
+        void AddAssetDependency( const AssetPath& path, const AssetPath& dependencyPath );
+        void RemoveAsset( const AssetPath& path );
+
+        bool HasAsset( const AssetPath& path ) const;
+        //@}
+
+        /// @name Input Stamps
+        //@{
+        void BeginCook();
+        void EndCook();
+
+        int64_t GetInputStamp( const AssetPath& path );
+        uint64_t GetFileHash( const String& rFilePath );
+        //@}
+
+        /// @name Statistics
+        //@{
+        inline uint32_t GetFileHashCount() const;
+        inline uint32_t GetFileRehashCount() const;
+        void ResetStatistics();
+        //@}
+
+    private:
+        /// Hashed file information.
+        struct FileRecord
+        {
+            /// File modification time when the file was hashed.
+            int64_t timestamp;
+            /// File size when the file was hashed.
+            int64_t size;
+            /// File content hash.
+            uint64_t hash;
+
+            /// Index of the last cook during which the file was checked (not saved).
+            uint32_t cookIndex;
+        };
+
+        /// Inputs of a cooked asset.
+        struct AssetRecord
+        {
+            /// Files read while cooking the asset.
+            DynamicArray< Name > files;
+            /// Assets whose cooked data was used while cooking the asset.
+            DynamicArray< AssetPath > dependencies;
+        };
+
+        /// Hashed files.
+        HashMap< Name, FileRecord > m_files;
+        /// Cooked assets.
+        HashMap< AssetPath, AssetRecord > m_assets;
+
+        /// Input stamps of assets computed during the current cook, excluding stamps that depend on a dependency cycle.
+        HashMap< AssetPath, uint64_t > m_inputStamps;
+
+        /// Database file name.
+        String m_fileName;
+        /// Data directory path (with a trailing path separator), stripped from file paths when computing stamps.
+        String m_dataDirectory;
+        /// Index of the current cook (incremented by each call to BeginCook()).
+        uint32_t m_cookIndex;
+        /// True if a cook is in progress.
+        bool m_bCooking;
+        /// True if the database has been modified since it was last loaded or saved.
+        bool m_bDirty;
+
+        /// Number of file hash requests since the statistics were last reset.
+        uint32_t m_fileHashCount;
+        /// Number of file hash requests that required the file contents to be read.
+        uint32_t m_fileRehashCount;
+
+        /// Lock for synchronizing access to the database.
+        mutable Mutex m_lock;
+
+        /// @name Private Utility Functions
+        //@{
+        uint64_t UpdateFileHash( Name filePath );
+        uint64_t ComputeInputStamp( const AssetPath& path, HashMap< AssetPath, uint64_t >& rStamps, bool& rbCyclic );
+        const char* GetRelativeFilePath( Name filePath ) const;
+        void InvalidateInputStamps();
+        //@}
+    };
+}
+
+#include "PcSupport/CookDatabase.inl"
+
+#endif  // HELIUM_TOOLS
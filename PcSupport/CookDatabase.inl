@@ -0,0 +1,23 @@
+namespace Helium
+{
+    /// Get the number of file hashes requested since the statistics were last reset.
+    ///
+    /// @return  Number of file hash requests.
+    ///
+    /// @see GetFileRehashCount(), ResetStatistics()
+    uint32_t CookDatabase::GetFileHashCount() const
+    {
+        return m_fileHashCount;
+    }
+
+    /// Get the number of file hash requests since the statistics were last reset that required the file contents to
+    /// be read (because the file was new or its size or modification time had changed).
+    ///
+    /// @return  Number of files rehashed.
+    ///
+    /// @see GetFileHashCount(), ResetStatistics()
+    uint32_t CookDatabase::GetFileRehashCount() const
+    {
+        return m_fileRehashCount;
+    }
+}
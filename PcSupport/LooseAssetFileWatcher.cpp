@@ -6,33 +6,58 @@
 #include "Foundation/Log.h"
 #include "Persist/ArchiveJson.h"
 #include "PcSupport/ResourceHandler.h"
+#include "Engine/FrameProfiler.h"
+
+#if HELIUM_OS_LINUX
+# include <sys/inotify.h>
+# include <poll.h>
+# include <unistd.h>
+# include <errno.h>
+#endif
 
 using namespace Helium;
 
+/// Handle value used for file system event handles and watch descriptors that are not open.
+static const int INVALID_EVENT_HANDLE = -1;
+
+#if HELIUM_OS_LINUX
+/// File system events that can indicate a new or modified asset file.
+static const uint32_t WATCH_EVENT_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE;
+/// Size of the buffer used for reading file system events.
+static const size_t EVENT_BUFFER_SIZE = 16 * 1024;
+#endif
+
+/// Check whether a file name refers to a file that can be loaded as an asset.
+///
+/// @param[in] rPath  File path.
+///
+/// @return  True if the file is a JSON object file or a raw file that a resource handler can import.
+static bool IsAssetFile( const FilePath& rPath )
+{
+	if ( rPath.Extension() == Persist::ArchiveExtensions[ Persist::ArchiveTypes::Json ] )
+	{
+		return true;
+	}
+
+	String objectNameString( rPath.Filename().c_str() );
+
+	return ( ResourceHandler::GetBestResourceHandlerForFile( objectNameString ) != NULL );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Sleep between runs and yield to other threads
-// The complex loop is to prevent Editor from hanging on exit (max hang will be "increments" seconds)
-inline void SleepBetweenTracking( bool* cancel = NULL, const uint32_t minutes = 1 )
+inline void SleepBetweenTracking()
 {
-	//const uint32_t increments = 1;
-	//uint32_t totalSeconds = 60 * minutes;
-	//for ( uint32_t seconds = 0; seconds < totalSeconds; seconds += increments )
-	//{
-	//	Thread::Sleep( increments * 1000 );
-
-	//	if ( ( cancel != NULL )
-	//		&& *cancel )
-	//	{
-	//		break;
-	//	}
-	//}
-
 	Thread::Sleep( 1000 );
 }
 
 LooseAssetFileWatcher::LooseAssetFileWatcher() 
 : m_StopTracking( false )
 , m_InterruptTracking( 0 )
+, m_EventHandle( INVALID_EVENT_HANDLE )
+, m_LastReloadLatency( 0.0f )
+, m_MaxReloadLatency( 0.0f )
+, m_ReloadCount( 0 )
 {
 
 }
@@ -61,6 +86,16 @@ void LooseAssetFileWatcher::AddPackage( LoosePackageLoader *pPackageLoader )
 	WatchedPackage *pWatchedPackage = m_PathsToWatch.New();
 	pWatchedPackage->m_Path = pPackageLoader->m_packageDirPath;
 	pWatchedPackage->m_Loader = pPackageLoader;
+	pWatchedPackage->m_WatchDescriptor = INVALID_EVENT_HANDLE;
+	pWatchedPackage->m_bPendingChanges = false;
+	pWatchedPackage->m_FirstEventTicks = 0;
+	pWatchedPackage->m_LastEventTicks = 0;
+
+	if ( m_EventHandle != INVALID_EVENT_HANDLE )
+	{
+		AddWatch( *pWatchedPackage );
+	}
+
 	AtomicDecrement( m_InterruptTracking );
 }
 
@@ -73,6 +108,7 @@ void LooseAssetFileWatcher::RemovePackage( LoosePackageLoader *pPackageLoader )
 	{
 		if (pPackageLoader == m_PathsToWatch[i].m_Loader)
 		{
+			RemoveWatch( m_PathsToWatch[i] );
 			m_PathsToWatch.RemoveSwap(i);
 			break;
 		}
@@ -95,9 +131,25 @@ void LooseAssetFileWatcher::StartThread()
 
 	m_StopTracking = false;
 
+	{
+		SpinLock lock( m_PathsToWatchLock );
+
+		// Prefer event-driven watching, packages we fail to watch will be polled instead
+		if ( OpenEventHandle() )
+		{
+			for ( DynamicArray<WatchedPackage>::Iterator packageIter = m_PathsToWatch.Begin(); packageIter != m_PathsToWatch.End(); ++packageIter )
+			{
+				AddWatch( *packageIter );
+			}
+		}
+	}
+
 	Helium::CallbackThread::Entry entry = &Helium::CallbackThread::EntryHelper<LooseAssetFileWatcher, &LooseAssetFileWatcher::TrackEverything>;
 	if ( !m_Thread.Create( entry, this, TXT( "LooseAssetFileWatcher Thread" ), ThreadPriorities::Low ) )
 	{
+		SpinLock lock( m_PathsToWatchLock );
+		CloseEventHandle();
+
 		throw Exception( TXT( "Unable to create thread for asset tracking." ) );
 	}
 }
@@ -109,161 +161,479 @@ void LooseAssetFileWatcher::StopThread()
 	m_StopTracking = true;
 
 	m_Thread.Join();
+
+	SpinLock lock( m_PathsToWatchLock );
+	CloseEventHandle();
 }
 
 void LooseAssetFileWatcher::TrackEverything()
 {
 	m_StopTracking = false;
 
+	HELIUM_FRAME_PROFILE_THREAD_SCOPE( "LooseAssetFileWatcher" );
+
+	if ( m_EventHandle != INVALID_EVENT_HANDLE )
+	{
+		// Only returns early if event-driven watching fails, in which case we fall back to polling everything
+		TrackEvents();
+	}
+
 	AssetAwareThreadSynchronizer assetSync;
 
 	while ( !m_StopTracking )
 	{
 		Log::Print( Log::Levels::Default, TXT("Tracker: Scanning packages for changes...\n"));
 
-		// Do this once outside the inner loop in case we are iterating over nothing
+		PollPackages( assetSync, false );
+		DispatchNotifications();
+
+		if ( !m_StopTracking )
+		{
+			SleepBetweenTracking();
+		}
+	}
+}
+
+/// Wait for file system events and rescan packages once their changes have settled.
+///
+/// Packages without a watch descriptor are still polled every POLL_INTERVAL_MS.  This returns when the thread is
+/// stopped or if the event handle fails, in which case the event handle is closed.
+void LooseAssetFileWatcher::TrackEvents()
+{
+#if HELIUM_OS_LINUX
+	AssetAwareThreadSynchronizer assetSync;
+
+	const uint64_t ticksPerMillisecond = Max< uint64_t >( Timer::GetTicksPerSecond() / 1000, 1 );
+	const uint64_t quietPeriodTicks = ticksPerMillisecond * EVENT_QUIET_PERIOD_MS;
+	const uint64_t pollIntervalTicks = ticksPerMillisecond * POLL_INTERVAL_MS;
+
+	// Catch anything that changed before the watches were added
+	PollPackages( assetSync, false );
+	DispatchNotifications();
+
+	uint64_t lastPollTicks = Timer::GetTickCount();
+	bool bHavePendingChanges = false;
+
+	while ( !m_StopTracking )
+	{
+		pollfd eventPollFd;
+		eventPollFd.fd = m_EventHandle;
+		eventPollFd.events = POLLIN;
+		eventPollFd.revents = 0;
+
+		int pollResult = poll( &eventPollFd, 1, bHavePendingChanges ? EVENT_QUIET_PERIOD_MS : EVENT_WAIT_TIMEOUT_MS );
+		if ( pollResult < 0 && errno != EINTR )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "LooseAssetFileWatcher: Failed to wait for file system events (error %d), falling back to polling.\n" ),
+				errno );
+
+			break;
+		}
+
+		if ( pollResult > 0 && !ReadEvents() )
+		{
+			break;
+		}
+
 		assetSync.Sync();
 
+		uint64_t currentTicks = Timer::GetTickCount();
+		uint64_t firstEventTicks = 0;
+		bHavePendingChanges = false;
+
 		{
 			SpinLock lock( m_PathsToWatchLock );
 
-			// Go through all the packages we're tracking
+			// Rescan only the packages whose burst of changes has settled
 			for ( DynamicArray<WatchedPackage>::Iterator packageIter = m_PathsToWatch.Begin(); packageIter != m_PathsToWatch.End(); ++packageIter )
 			{
-				assetSync.Sync();
-
-				//Log::Print( Log::Levels::Default, TXT("Tracker: Scanning package %s\n"), packageIter->m_Path.c_str() );
-
-				SimpleTimer packageTimer;
-				Helium::DirectoryIterator directory( packageIter->m_Path );
-
-				// For each file
-				for( ; !directory.IsDone(); directory.Next() )
+				if ( !packageIter->m_bPendingChanges )
 				{
-					// If our thread is supposed to die, bail early
-					if ( m_StopTracking )
-					{
-						break;
-					}
-
-					const DirectoryIteratorItem& item = directory.GetItem();
-
-					bool isNewFile = true;
-					bool isChangedFile = false;
-
-					Name objectName;
-					size_t objectIndex = Invalid< size_t >();
-
-					if ( item.m_Path.IsDirectory() )
-					{
-						// Skip directories
-						continue;
-					}
-					else if ( item.m_Path.Extension() == Persist::ArchiveExtensions[ Persist::ArchiveTypes::Json ] )
-					{
-						// JSON files get handled special
-						objectName.Set( item.m_Path.Basename().c_str() );
-						objectIndex = packageIter->m_Loader->FindObjectByName( objectName );
-					}
-					else
-					{
-						// See if it's a raw asset that we can handle
-						String objectNameString( item.m_Path.Filename().c_str() );
-
-						ResourceHandler* pBestHandler = ResourceHandler::GetBestResourceHandlerForFile( objectNameString );
-
-						if (!pBestHandler)
-						{
-							// We don't know what this file is.. skip it
-							continue;
-						}
-
-						objectName.Set( item.m_Path.Filename().c_str() );
-						objectIndex = packageIter->m_Loader->FindObjectByName( objectName );
-					}
-
-					// If the package says it loaded something as fresh as the file, do nothing
-					if ( objectIndex != Invalid< size_t >() &&
-						packageIter->m_Loader->m_objects[objectIndex].fileTimeStamp >= static_cast<int64_t>( directory.GetItem().m_ModTime ))
-					{
-						continue;
-					}
-
-					// If we have already emitted a message for this object, skip it
-					HashMap< Name, WatchedAsset >::Iterator watchedAssetItr = packageIter->m_Assets.Find( objectName );
-					if (watchedAssetItr != packageIter->m_Assets.End())
-					{
-						if (watchedAssetItr->Second().m_LastMessageTime >= static_cast<int64_t>( directory.GetItem().m_ModTime ) )
-						{
-							// We already emitted a message for this file change, so don't do anything
-							continue;
-						}
-
-						// We've emitted a message, but it's been modified again. Emit another message and update the timestamp
-						watchedAssetItr->Second().m_LastMessageTime = static_cast<int64_t>( directory.GetItem().m_ModTime );
-					}
-					else
-					{
-						// We've never emitted a message, so record that we will
-						WatchedAsset watchedAsset;
-						watchedAsset.m_LastMessageTime = static_cast<int64_t>( directory.GetItem().m_ModTime );
-
-						packageIter->m_Assets.Insert(
-							watchedAssetItr, 
-							KeyValue< Name, WatchedAsset >( objectName, watchedAsset ) );
-					}
-				
-					// We know the file is changed and we should throw an event.. choose a different event based on new vs. changed
-					if (objectIndex != Invalid< size_t >())
-					{
-						m_ChangeNotifications.Add( packageIter->m_Loader->GetAssetPath( objectIndex ) );
-					}
-					else
-					{
-						AssetPath path;
-						path.Set( objectName, false, packageIter->m_Loader->GetPackagePath());
-
-						m_NewNotifications.Add( path );
-					}
+					continue;
 				}
 
-				if ( m_StopTracking || m_InterruptTracking != 0 )
+				if ( currentTicks - packageIter->m_LastEventTicks < quietPeriodTicks )
 				{
-					// Our thread is supposed to die, bail early
-					//Log::Print( Log::Levels::Default, TXT("Tracker: Pre-empted after %.2fm\n"), packageTimer.Elapsed() / 1000.f / 60.f );
-					break;
+					bHavePendingChanges = true;
+					continue;
 				}
-				else 
+
+				if ( firstEventTicks == 0 || packageIter->m_FirstEventTicks < firstEventTicks )
 				{
-					//Log::Print( Log::Levels::Default, TXT("Tracker: Package scanned in %.2fm\n") , packageTimer.Elapsed() / 1000.f / 60.f );
+					firstEventTicks = packageIter->m_FirstEventTicks;
 				}
+
+				packageIter->m_bPendingChanges = false;
+				ScanPackage( *packageIter );
 			}
 		}
 
-		for ( DynamicArray<AssetPath>::Iterator changedAssetIter = m_ChangeNotifications.Begin(); changedAssetIter != m_ChangeNotifications.End(); ++changedAssetIter )
+		if ( currentTicks - lastPollTicks >= pollIntervalTicks )
 		{
-			HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *changedAssetIter->ToString());
-			AssetTracker::GetStaticInstance()->NotifyAssetChangedExternally( *changedAssetIter );
+			PollPackages( assetSync, true );
+			lastPollTicks = currentTicks;
+		}
+
+		size_t notificationCount = m_ChangeNotifications.GetSize() + m_NewNotifications.GetSize();
+		DispatchNotifications();
 
-			AssetPtr asset;
-			AssetLoader::GetStaticInstance()->LoadObject( *changedAssetIter, asset, true );
-			Asset::ReplaceAsset( asset.Get(), *changedAssetIter );
+		if ( notificationCount != 0 && firstEventTicks != 0 )
+		{
+			float32_t latency = static_cast< float32_t >( Timer::TicksToMilliseconds( Timer::GetTickCount() - firstEventTicks ) );
+
+			m_LastReloadLatency = latency;
+			m_MaxReloadLatency = Max( m_MaxReloadLatency, latency );
+			++m_ReloadCount;
+
+			HELIUM_FRAME_PROFILE_COUNTER_SET( "AssetReloadLatencyMs", static_cast< int32_t >( latency ) );
+
+			HELIUM_TRACE(
+				TraceLevels::Info,
+				TXT( "LooseAssetFileWatcher: Reloaded %" ) PRIuSZ TXT( " asset(s) %.2f ms after the first change event (max %.2f ms).\n" ),
+				notificationCount,
+				latency,
+				m_MaxReloadLatency );
 		}
+	}
+
+	if ( !m_StopTracking )
+	{
+		SpinLock lock( m_PathsToWatchLock );
+		CloseEventHandle();
+	}
+#endif
+}
+
+/// Scan packages for files that are newer than the versions loaded.
+///
+/// @param[in] rAssetSync      Synchronizer used to yield to asset loading between packages.
+/// @param[in] bUnwatchedOnly  True to only scan packages that are not watched for file system events.
+void LooseAssetFileWatcher::PollPackages( AssetAwareThreadSynchronizer& rAssetSync, bool bUnwatchedOnly )
+{
+	// Do this once outside the inner loop in case we are iterating over nothing
+	rAssetSync.Sync();
+
+	SpinLock lock( m_PathsToWatchLock );
 
-		for ( DynamicArray<AssetPath>::Iterator newAssetIter = m_NewNotifications.Begin(); newAssetIter != m_NewNotifications.End(); ++newAssetIter )
+	// Go through all the packages we're tracking
+	for ( DynamicArray<WatchedPackage>::Iterator packageIter = m_PathsToWatch.Begin(); packageIter != m_PathsToWatch.End(); ++packageIter )
+	{
+		if ( bUnwatchedOnly && packageIter->m_WatchDescriptor != INVALID_EVENT_HANDLE )
 		{
-			HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *newAssetIter->ToString());
-			AssetTracker::GetStaticInstance()->NotifyAssetCreatedExternally( *newAssetIter );
+			continue;
 		}
 
-		m_ChangeNotifications.Clear();
-		m_NewNotifications.Clear();
+		rAssetSync.Sync();
 
-		if ( !m_StopTracking )
+		ScanPackage( *packageIter );
+
+		if ( m_StopTracking || m_InterruptTracking != 0 )
 		{
-			// Sleep between runs and yield to other threads
-			// The complex loop is to prevent Editor from hanging on exit (max hang will be "increments" seconds)
-			SleepBetweenTracking( &m_StopTracking );
+			// Our thread is supposed to die, bail early
+			break;
 		}
 	}
-}
\ No newline at end of file
+}
+
+/// Scan a single package directory and queue notifications for new and modified asset files.
+///
+/// This must be called with the package list lock held.
+///
+/// @param[in] rPackage  Package to scan.
+void LooseAssetFileWatcher::ScanPackage( WatchedPackage& rPackage )
+{
+	HELIUM_FRAME_PROFILE_SCOPE( "LooseAssetFileWatcher::ScanPackage" );
+
+	Helium::DirectoryIterator directory( rPackage.m_Path );
+
+	// For each file
+	for( ; !directory.IsDone(); directory.Next() )
+	{
+		// If our thread is supposed to die, bail early
+		if ( m_StopTracking )
+		{
+			break;
+		}
+
+		const DirectoryIteratorItem& item = directory.GetItem();
+
+		Name objectName;
+		size_t objectIndex = Invalid< size_t >();
+
+		if ( item.m_Path.IsDirectory() )
+		{
+			// Skip directories
+			continue;
+		}
+		else if ( item.m_Path.Extension() == Persist::ArchiveExtensions[ Persist::ArchiveTypes::Json ] )
+		{
+			// JSON files get handled special
+			objectName.Set( item.m_Path.Basename().c_str() );
+			objectIndex = rPackage.m_Loader->FindObjectByName( objectName );
+		}
+		else
+		{
+			// See if it's a raw asset that we can handle
+			if ( !IsAssetFile( item.m_Path ) )
+			{
+				// We don't know what this file is.. skip it
+				continue;
+			}
+
+			objectName.Set( item.m_Path.Filename().c_str() );
+			objectIndex = rPackage.m_Loader->FindObjectByName( objectName );
+		}
+
+		// If the package says it loaded something as fresh as the file, do nothing
+		if ( objectIndex != Invalid< size_t >() &&
+			rPackage.m_Loader->m_objects[objectIndex].fileTimeStamp >= static_cast<int64_t>( item.m_ModTime ))
+		{
+			continue;
+		}
+
+		// If we have already emitted a message for this object, skip it
+		HashMap< Name, WatchedAsset >::Iterator watchedAssetItr = rPackage.m_Assets.Find( objectName );
+		if (watchedAssetItr != rPackage.m_Assets.End())
+		{
+			if (watchedAssetItr->Second().m_LastMessageTime >= static_cast<int64_t>( item.m_ModTime ) )
+			{
+				// We already emitted a message for this file change, so don't do anything
+				continue;
+			}
+
+			// We've emitted a message, but it's been modified again. Emit another message and update the timestamp
+			watchedAssetItr->Second().m_LastMessageTime = static_cast<int64_t>( item.m_ModTime );
+		}
+		else
+		{
+			// We've never emitted a message, so record that we will
+			WatchedAsset watchedAsset;
+			watchedAsset.m_LastMessageTime = static_cast<int64_t>( item.m_ModTime );
+
+			rPackage.m_Assets.Insert(
+				watchedAssetItr, 
+				KeyValue< Name, WatchedAsset >( objectName, watchedAsset ) );
+		}
+	
+		// We know the file is changed and we should throw an event.. choose a different event based on new vs. changed
+		if (objectIndex != Invalid< size_t >())
+		{
+			m_ChangeNotifications.Add( rPackage.m_Loader->GetAssetPath( objectIndex ) );
+		}
+		else
+		{
+			AssetPath path;
+			path.Set( objectName, false, rPackage.m_Loader->GetPackagePath());
+
+			m_NewNotifications.Add( path );
+		}
+	}
+}
+
+/// Reload changed assets and notify the asset tracker of new and changed assets queued by previous scans.
+void LooseAssetFileWatcher::DispatchNotifications()
+{
+	for ( DynamicArray<AssetPath>::Iterator changedAssetIter = m_ChangeNotifications.Begin(); changedAssetIter != m_ChangeNotifications.End(); ++changedAssetIter )
+	{
+		HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *changedAssetIter->ToString());
+		AssetTracker::GetStaticInstance()->NotifyAssetChangedExternally( *changedAssetIter );
+
+		AssetPtr asset;
+		AssetLoader::GetStaticInstance()->LoadObject( *changedAssetIter, asset, true );
+		Asset::ReplaceAsset( asset.Get(), *changedAssetIter );
+	}
+
+	for ( DynamicArray<AssetPath>::Iterator newAssetIter = m_NewNotifications.Begin(); newAssetIter != m_NewNotifications.End(); ++newAssetIter )
+	{
+		HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *newAssetIter->ToString());
+		AssetTracker::GetStaticInstance()->NotifyAssetCreatedExternally( *newAssetIter );
+	}
+
+	m_ChangeNotifications.Clear();
+	m_NewNotifications.Clear();
+}
+
+/// Open the handle used to receive file system events.
+///
+/// This must be called with the package list lock held.
+///
+/// @return  True if event-driven watching is available, false if packages must be polled.
+bool LooseAssetFileWatcher::OpenEventHandle()
+{
+	HELIUM_ASSERT( m_EventHandle == INVALID_EVENT_HANDLE );
+
+#if HELIUM_OS_LINUX
+	m_EventHandle = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+	if ( m_EventHandle < 0 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "LooseAssetFileWatcher: Failed to initialize inotify (error %d), falling back to polling.\n" ),
+			errno );
+
+		m_EventHandle = INVALID_EVENT_HANDLE;
+
+		return false;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+/// Close the file system event handle, leaving all packages to be polled.
+///
+/// This must be called with the package list lock held.
+void LooseAssetFileWatcher::CloseEventHandle()
+{
+	for ( DynamicArray<WatchedPackage>::Iterator packageIter = m_PathsToWatch.Begin(); packageIter != m_PathsToWatch.End(); ++packageIter )
+	{
+		packageIter->m_WatchDescriptor = INVALID_EVENT_HANDLE;
+	}
+
+#if HELIUM_OS_LINUX
+	if ( m_EventHandle != INVALID_EVENT_HANDLE )
+	{
+		close( m_EventHandle );
+		m_EventHandle = INVALID_EVENT_HANDLE;
+	}
+#endif
+}
+
+/// Start watching a package directory for file system events.
+///
+/// If the watch cannot be added, the package is left to be polled.  This must be called with the package list lock
+/// held.
+///
+/// @param[in] rPackage  Package to watch.
+void LooseAssetFileWatcher::AddWatch( WatchedPackage& rPackage )
+{
+	HELIUM_ASSERT( rPackage.m_WatchDescriptor == INVALID_EVENT_HANDLE );
+
+#if HELIUM_OS_LINUX
+	HELIUM_ASSERT( m_EventHandle != INVALID_EVENT_HANDLE );
+
+	int watchDescriptor = inotify_add_watch( m_EventHandle, rPackage.m_Path.c_str(), WATCH_EVENT_MASK | IN_ONLYDIR );
+	if ( watchDescriptor < 0 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "LooseAssetFileWatcher: Failed to watch \"%s\" (error %d), the package will be polled instead.\n" ),
+			rPackage.m_Path.c_str(),
+			errno );
+
+		return;
+	}
+
+	rPackage.m_WatchDescriptor = watchDescriptor;
+#endif
+}
+
+/// Stop watching a package directory for file system events.
+///
+/// This must be called with the package list lock held.
+///
+/// @param[in] rPackage  Package to stop watching.
+void LooseAssetFileWatcher::RemoveWatch( WatchedPackage& rPackage )
+{
+#if HELIUM_OS_LINUX
+	if ( m_EventHandle != INVALID_EVENT_HANDLE && rPackage.m_WatchDescriptor != INVALID_EVENT_HANDLE )
+	{
+		inotify_rm_watch( m_EventHandle, rPackage.m_WatchDescriptor );
+	}
+#endif
+
+	rPackage.m_WatchDescriptor = INVALID_EVENT_HANDLE;
+}
+
+/// Read all available file system events and flag the packages they refer to as having pending changes.
+///
+/// Events for files that are not asset files (i.e. editor backup and swap files) are ignored.
+///
+/// @return  True if events were read successfully, false if the event handle has failed.
+bool LooseAssetFileWatcher::ReadEvents()
+{
+#if HELIUM_OS_LINUX
+	char buffer[ EVENT_BUFFER_SIZE ] __attribute__(( aligned( __alignof__( struct inotify_event ) ) ));
+
+	for( ;; )
+	{
+		ssize_t bytesRead = read( m_EventHandle, buffer, sizeof( buffer ) );
+		if ( bytesRead < 0 )
+		{
+			if ( errno == EAGAIN || errno == EINTR )
+			{
+				return true;
+			}
+
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "LooseAssetFileWatcher: Failed to read file system events (error %d), falling back to polling.\n" ),
+				errno );
+
+			return false;
+		}
+
+		if ( bytesRead == 0 )
+		{
+			return true;
+		}
+
+		uint64_t eventTicks = Timer::GetTickCount();
+
+		SpinLock lock( m_PathsToWatchLock );
+
+		for ( char* pEventData = buffer; pEventData < buffer + bytesRead; )
+		{
+			const inotify_event* pEvent = reinterpret_cast< const inotify_event* >( pEventData );
+			pEventData += sizeof( inotify_event ) + pEvent->len;
+
+			// If the event queue overflowed we lost track of what changed, so rescan everything we watch
+			bool bOverflow = ( pEvent->mask & IN_Q_OVERFLOW ) != 0;
+
+			if ( !bOverflow )
+			{
+				if ( pEvent->mask & IN_ISDIR )
+				{
+					continue;
+				}
+
+				if ( !( pEvent->mask & IN_IGNORED ) &&
+					( pEvent->len == 0 || !IsAssetFile( FilePath( pEvent->name ) ) ) )
+				{
+					continue;
+				}
+			}
+
+			for ( DynamicArray<WatchedPackage>::Iterator packageIter = m_PathsToWatch.Begin(); packageIter != m_PathsToWatch.End(); ++packageIter )
+			{
+				if ( packageIter->m_WatchDescriptor == INVALID_EVENT_HANDLE ||
+					( !bOverflow && packageIter->m_WatchDescriptor != pEvent->wd ) )
+				{
+					continue;
+				}
+
+				if ( pEvent->mask & IN_IGNORED )
+				{
+					// The directory was removed or unmounted, so fall back to polling it
+					packageIter->m_WatchDescriptor = INVALID_EVENT_HANDLE;
+					break;
+				}
+
+				if ( !packageIter->m_bPendingChanges )
+				{
+					packageIter->m_bPendingChanges = true;
+					packageIter->m_FirstEventTicks = eventTicks;
+				}
+
+				packageIter->m_LastEventTicks = eventTicks;
+			}
+		}
+	}
+#else
+	return false;
+#endif
+}
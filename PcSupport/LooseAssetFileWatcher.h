@@ -4,9 +4,22 @@ namespace Helium
 {
 	class LoosePackageLoader;
 
+	/// Watches the directories of loose packages and reloads assets whose files are changed outside of the engine.
+	///
+	/// On Linux, file system change events are received through inotify (one watch per package directory), bursts of
+	/// events are coalesced until a package has been quiet for EVENT_QUIET_PERIOD_MS, and only the packages that
+	/// changed are rescanned.  Packages that cannot be watched (or all packages on other platforms) fall back to being
+	/// polled every POLL_INTERVAL_MS.
 	class HELIUM_PC_SUPPORT_API LooseAssetFileWatcher
 	{
 	public:
+		/// Time to wait between full scans of packages that are polled, in milliseconds.
+		static const uint32_t POLL_INTERVAL_MS = 1000;
+		/// Time a package must go without new file system events before it is rescanned, in milliseconds.
+		static const uint32_t EVENT_QUIET_PERIOD_MS = 100;
+		/// Maximum time to block waiting for file system events before checking for shutdown, in milliseconds.
+		static const uint32_t EVENT_WAIT_TIMEOUT_MS = 250;
+
 		LooseAssetFileWatcher();
 		virtual ~LooseAssetFileWatcher();
 
@@ -19,6 +32,13 @@ namespace Helium
 
 		void TrackEverything();
 
+		/// @name Reload Statistics
+		//@{
+		inline float32_t GetLastReloadLatency() const;
+		inline float32_t GetMaxReloadLatency() const;
+		inline size_t GetReloadCount() const;
+		//@}
+
 	protected:
 		Helium::CallbackThread m_Thread;
 		bool m_StopTracking;
@@ -35,6 +55,15 @@ namespace Helium
 			LoosePackageLoader *m_Loader;
 
 			HashMap< Name, WatchedAsset > m_Assets;
+
+			/// File system watch descriptor (invalid if the package is polled).
+			int m_WatchDescriptor;
+			/// True if file system events have been received since the package was last scanned.
+			bool m_bPendingChanges;
+			/// Tick count of the first event received since the package was last scanned.
+			uint64_t m_FirstEventTicks;
+			/// Tick count of the most recent event received for the package.
+			uint64_t m_LastEventTicks;
 		};
 
 		DynamicArray<WatchedPackage> m_PathsToWatch;
@@ -42,7 +71,31 @@ namespace Helium
 
 		DynamicArray<AssetPath> m_ChangeNotifications;
 		DynamicArray<AssetPath> m_NewNotifications;
+
+		/// File system event notification handle (invalid if event-driven watching is unavailable).
+		int m_EventHandle;
+
+		/// Latency between the first change event and reload completion for the most recent reload, in milliseconds.
+		float32_t m_LastReloadLatency;
+		/// Longest reload latency recorded, in milliseconds.
+		float32_t m_MaxReloadLatency;
+		/// Number of reloads triggered by file system events.
+		size_t m_ReloadCount;
+
+		/// @name Tracking Implementation
+		//@{
+		void TrackEvents();
+		void PollPackages( AssetAwareThreadSynchronizer& rAssetSync, bool bUnwatchedOnly );
+		void ScanPackage( WatchedPackage& rPackage );
+		void DispatchNotifications();
+
+		bool OpenEventHandle();
+		void CloseEventHandle();
+		void AddWatch( WatchedPackage& rPackage );
+		void RemoveWatch( WatchedPackage& rPackage );
+		bool ReadEvents();
+		//@}
 	};
 }
 
-#include "LooseAssetFileWatcher.inl"
\ No newline at end of file
+#include "LooseAssetFileWatcher.inl"
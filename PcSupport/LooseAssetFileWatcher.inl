@@ -1,8 +1,37 @@
-
 namespace Helium
 {
 	bool LooseAssetFileWatcher::IsThreadRunning()
 	{
 		return ( m_Thread.IsValid() );
 	}
-}
\ No newline at end of file
+
+	/// Get the latency of the most recent event-triggered reload.
+	///
+	/// @return  Time between the first file system event and reload completion, in milliseconds.
+	///
+	/// @see GetMaxReloadLatency(), GetReloadCount()
+	float32_t LooseAssetFileWatcher::GetLastReloadLatency() const
+	{
+		return m_LastReloadLatency;
+	}
+
+	/// Get the longest latency recorded for an event-triggered reload.
+	///
+	/// @return  Longest time between the first file system event and reload completion, in milliseconds.
+	///
+	/// @see GetLastReloadLatency(), GetReloadCount()
+	float32_t LooseAssetFileWatcher::GetMaxReloadLatency() const
+	{
+		return m_MaxReloadLatency;
+	}
+
+	/// Get the number of reloads triggered by file system events.
+	///
+	/// @return  Number of event-triggered reloads.
+	///
+	/// @see GetLastReloadLatency(), GetMaxReloadLatency()
+	size_t LooseAssetFileWatcher::GetReloadCount() const
+	{
+		return m_ReloadCount;
+	}
+}
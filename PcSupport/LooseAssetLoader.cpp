@@ -30,6 +30,8 @@ LooseAssetLoader::LooseAssetLoader()
 /// Destructor.
 LooseAssetLoader::~LooseAssetLoader()
 {
+	StopLoadThread();
+
 #if USE_LOOSE_ASSET_FILE_WATCHER
 	g_FileWatcher.StopThread();
 #endif
@@ -140,54 +142,15 @@ bool LooseAssetLoader::CacheObject( Asset* pAsset, bool bEvictPlatformPreprocess
 
 	Config& rConfig = Config::GetStaticInstance();
 
-	int64_t objectTimestamp = AssetLoader::GetAssetFileTimestamp( path );
-
-	if( !pAsset->IsDefaultTemplate() )
-	{
-		Resource* pResource = Reflect::SafeCast< Resource >( pAsset );
-		if( pResource )
-		{
-			AssetPath baseResourcePath = path;
-			HELIUM_ASSERT( !baseResourcePath.IsPackage() );
-			for( ; ; )
-			{
-				AssetPath parentPath = baseResourcePath.GetParent();
-				if( parentPath.IsEmpty() || parentPath.IsPackage() )
-				{
-					break;
-				}
-
-				baseResourcePath = parentPath;
-			}
-
-			FilePath sourceFilePath;
-			if ( !FileLocations::GetDataDirectory( sourceFilePath ) )
-			{
-				HELIUM_TRACE(
-					TraceLevels::Warning,
-					TXT( "LooseAssetLoader::CacheObject(): Could not obtain data directory.\n" ) );
-
-				return false;
-			}
-
-			sourceFilePath += baseResourcePath.ToFilePathString().GetData();
-
-			Status stat;
-			stat.Read( sourceFilePath.Get().c_str() );
-
-			int64_t sourceFileTimestamp = stat.m_ModifiedTime;
-			if( sourceFileTimestamp > objectTimestamp )
-			{
-				objectTimestamp = sourceFileTimestamp;
-			}
-		}
-	}
+	// Stamp the cached data with a hash of everything it was built from, so that it is only rebuilt once those inputs
+	// actually change.
+	int64_t objectStamp = pAssetPreprocessor->GetObjectInputStamp( path, pAsset );
 
 	// Cache the object.
 	bool bSuccess = pAssetPreprocessor->CacheObject(
 		path,
 		pAsset,
-		objectTimestamp,
+		objectStamp,
 		bEvictPlatformPreprocessedResourceData );
 	if( !bSuccess )
 	{
@@ -48,6 +48,18 @@ bool ResourceHandler::CacheResource(
 {
     return false;
 }
+
+/// Get whether CacheResource() can safely be called for different resources from multiple threads at once.
+///
+/// Handlers should only return true if caching a resource does not touch any shared state (i.e. the asset loader,
+/// other resources, or non-reentrant third-party libraries).  Such resources can be preprocessed in parallel by batch
+/// cooks.
+///
+/// @return  True if resources can be cached concurrently, false if not.
+bool ResourceHandler::CanCacheResourceConcurrently() const
+{
+    return false;
+}
 #endif  // HELIUM_TOOLS
 
 
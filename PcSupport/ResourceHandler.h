@@ -34,6 +34,7 @@ namespace Helium
 #if HELIUM_TOOLS
         virtual bool CacheResource(
             AssetPreprocessor* pAssetPreprocessor, Resource* pResource, const String& rSourceFilePath );
+        virtual bool CanCacheResourceConcurrently() const;
         
         void SaveObjectToPersistentDataBuffer(Reflect::Object *_object, DynamicArray< uint8_t > &_buffer);
 #endif
@@ -0,0 +1,585 @@
+#include "RenderingPch.h"
+#include "Rendering/RStateFilterCommandProxy.h"
+
+#include "Rendering/RBlendState.h"
+#include "Rendering/RConstantBuffer.h"
+#include "Rendering/RDepthStencilState.h"
+#include "Rendering/RIndexBuffer.h"
+#include "Rendering/RPixelShader.h"
+#include "Rendering/RRasterizerState.h"
+#include "Rendering/RRenderCommandList.h"
+#include "Rendering/RSamplerState.h"
+#include "Rendering/RTexture.h"
+#include "Rendering/RVertexBuffer.h"
+#include "Rendering/RVertexInputLayout.h"
+#include "Rendering/RVertexShader.h"
+
+using namespace Helium;
+
+/// Constructor.
+///
+/// @param[in] pTargetProxy  Proxy to which filtered commands should be passed.  The state of this proxy is assumed
+///                          to be unknown.
+RStateFilterCommandProxy::RStateFilterCommandProxy( RRenderCommandProxy* pTargetProxy )
+: m_spTargetProxy( pTargetProxy )
+, m_stencilReferenceValue( 0 )
+, m_knownStateFlags( 0 )
+, m_knownVertexBufferMask( 0 )
+, m_knownSamplerMask( 0 )
+, m_pendingSamplerMask( 0 )
+, m_knownTextureMask( 0 )
+, m_pendingTextureMask( 0 )
+, m_requestedBindCount( 0 )
+, m_issuedBindCount( 0 )
+{
+    HELIUM_ASSERT( pTargetProxy );
+
+    MemoryZero( m_vertexStrides, sizeof( m_vertexStrides ) );
+    MemoryZero( m_vertexOffsets, sizeof( m_vertexOffsets ) );
+
+    MemoryZero( m_vertexConstantBuffers.limitSizes, sizeof( m_vertexConstantBuffers.limitSizes ) );
+    m_vertexConstantBuffers.knownMask = 0;
+    MemoryZero( m_pixelConstantBuffers.limitSizes, sizeof( m_pixelConstantBuffers.limitSizes ) );
+    m_pixelConstantBuffers.knownMask = 0;
+}
+
+/// Destructor.
+RStateFilterCommandProxy::~RStateFilterCommandProxy()
+{
+}
+
+/// @copydoc RRenderCommandProxy::SetRasterizerState()
+void RStateFilterCommandProxy::SetRasterizerState( RRasterizerState* pState )
+{
+    ++m_requestedBindCount;
+
+    if( ( m_knownStateFlags & STATE_FLAG_RASTERIZER ) && m_spRasterizerState == pState )
+    {
+        return;
+    }
+
+    m_spRasterizerState = pState;
+    m_knownStateFlags |= STATE_FLAG_RASTERIZER;
+
+    ++m_issuedBindCount;
+    m_spTargetProxy->SetRasterizerState( pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetBlendState()
+void RStateFilterCommandProxy::SetBlendState( RBlendState* pState )
+{
+    ++m_requestedBindCount;
+
+    if( ( m_knownStateFlags & STATE_FLAG_BLEND ) && m_spBlendState == pState )
+    {
+        return;
+    }
+
+    m_spBlendState = pState;
+    m_knownStateFlags |= STATE_FLAG_BLEND;
+
+    ++m_issuedBindCount;
+    m_spTargetProxy->SetBlendState( pState );
+}
+
+/// @copydoc RRenderCommandProxy::SetDepthStencilState()
+void RStateFilterCommandProxy::SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue )
+{
+    ++m_requestedBindCount;
+
+    if( ( m_knownStateFlags & STATE_FLAG_DEPTH_STENCIL ) &&
+        m_spDepthStencilState == pState &&
+        m_stencilReferenceValue == stencilReferenceValue )
+    {
+        return;
+    }
+
+    m_spDepthStencilState = pState;
+    m_stencilReferenceValue = stencilReferenceValue;
+    m_knownStateFlags |= STATE_FLAG_DEPTH_STENCIL;
+
+    ++m_issuedBindCount;
+    m_spTargetProxy->SetDepthStencilState( pState, stencilReferenceValue );
+}
+
+/// @copydoc RRenderCommandProxy::SetSamplerStates()
+void RStateFilterCommandProxy::SetSamplerStates(
+    size_t startIndex,
+    size_t samplerCount,
+    RSamplerState* const* ppStates )
+{
+    HELIUM_ASSERT( ppStates || samplerCount == 0 );
+
+    m_requestedBindCount += static_cast< uint32_t >( samplerCount );
+
+    // Slots outside the tracked range are passed through as is.
+    size_t trackedCount = 0;
+    if( startIndex < SAMPLER_SLOT_COUNT )
+    {
+        trackedCount = Min( samplerCount, SAMPLER_SLOT_COUNT - startIndex );
+    }
+
+    if( trackedCount < samplerCount )
+    {
+        size_t untrackedCount = samplerCount - trackedCount;
+        m_issuedBindCount += static_cast< uint32_t >( untrackedCount );
+        m_spTargetProxy->SetSamplerStates( startIndex + trackedCount, untrackedCount, ppStates + trackedCount );
+    }
+
+    // Defer changes to tracked slots until the next draw.
+    for( size_t stateIndex = 0; stateIndex < trackedCount; ++stateIndex )
+    {
+        size_t slotIndex = startIndex + stateIndex;
+        uint32_t slotMask = 1U << slotIndex;
+
+        RSamplerState* pState = ppStates[ stateIndex ];
+        m_pendingSamplerStates[ slotIndex ] = pState;
+        if( ( m_knownSamplerMask & slotMask ) && m_samplerStates[ slotIndex ] == pState )
+        {
+            m_pendingSamplerMask &= ~slotMask;
+        }
+        else
+        {
+            m_pendingSamplerMask |= slotMask;
+        }
+    }
+}
+
+/// @copydoc RRenderCommandProxy::SetRenderSurfaces()
+void RStateFilterCommandProxy::SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface )
+{
+    m_spTargetProxy->SetRenderSurfaces( pRenderTargetSurface, pDepthStencilSurface );
+}
+
+/// @copydoc RRenderCommandProxy::SetViewport()
+void RStateFilterCommandProxy::SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height )
+{
+    // Some platforms reset the viewport when the render surfaces change, so viewport changes are never filtered.
+    m_spTargetProxy->SetViewport( x, y, width, height );
+}
+
+/// @copydoc RRenderCommandProxy::BeginScene()
+void RStateFilterCommandProxy::BeginScene()
+{
+    m_spTargetProxy->BeginScene();
+}
+
+/// @copydoc RRenderCommandProxy::EndScene()
+void RStateFilterCommandProxy::EndScene()
+{
+    m_spTargetProxy->EndScene();
+}
+
+/// @copydoc RRenderCommandProxy::Clear()
+void RStateFilterCommandProxy::Clear( uint32_t clearFlags, const Color& rColor, float32_t depth, uint8_t stencil )
+{
+    m_spTargetProxy->Clear( clearFlags, rColor, depth, stencil );
+}
+
+/// @copydoc RRenderCommandProxy::SetIndexBuffer()
+void RStateFilterCommandProxy::SetIndexBuffer( RIndexBuffer* pBuffer )
+{
+    ++m_requestedBindCount;
+
+    if( ( m_knownStateFlags & STATE_FLAG_INDEX_BUFFER ) && m_spIndexBuffer == pBuffer )
+    {
+        return;
+    }
+
+    m_spIndexBuffer = pBuffer;
+    m_knownStateFlags |= STATE_FLAG_INDEX_BUFFER;
+
+    ++m_issuedBindCount;
+    m_spTargetProxy->SetIndexBuffer( pBuffer );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexBuffers()
+void RStateFilterCommandProxy::SetVertexBuffers(
+    size_t startIndex,
+    size_t bufferCount,
+    RVertexBuffer* const* ppBuffers,
+    uint32_t* pStrides,
+    uint32_t* pOffsets )
+{
+    HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+    HELIUM_ASSERT( pStrides || bufferCount == 0 );
+    HELIUM_ASSERT( pOffsets || bufferCount == 0 );
+
+    m_requestedBindCount += static_cast< uint32_t >( bufferCount );
+
+    size_t trackedCount = 0;
+    if( startIndex < VERTEX_BUFFER_SLOT_COUNT )
+    {
+        trackedCount = Min( bufferCount, VERTEX_BUFFER_SLOT_COUNT - startIndex );
+    }
+
+    bool bChanged = ( trackedCount < bufferCount );
+    for( size_t bufferIndex = 0; bufferIndex < trackedCount && !bChanged; ++bufferIndex )
+    {
+        size_t slotIndex = startIndex + bufferIndex;
+        bChanged = ( !( m_knownVertexBufferMask & ( 1U << slotIndex ) ) ||
+                     m_vertexBuffers[ slotIndex ] != ppBuffers[ bufferIndex ] ||
+                     m_vertexStrides[ slotIndex ] != pStrides[ bufferIndex ] ||
+                     m_vertexOffsets[ slotIndex ] != pOffsets[ bufferIndex ] );
+    }
+
+    if( !bChanged )
+    {
+        return;
+    }
+
+    for( size_t bufferIndex = 0; bufferIndex < trackedCount; ++bufferIndex )
+    {
+        size_t slotIndex = startIndex + bufferIndex;
+        m_vertexBuffers[ slotIndex ] = ppBuffers[ bufferIndex ];
+        m_vertexStrides[ slotIndex ] = pStrides[ bufferIndex ];
+        m_vertexOffsets[ slotIndex ] = pOffsets[ bufferIndex ];
+        m_knownVertexBufferMask |= 1U << slotIndex;
+    }
+
+    m_issuedBindCount += static_cast< uint32_t >( bufferCount );
+    m_spTargetProxy->SetVertexBuffers( startIndex, bufferCount, ppBuffers, pStrides, pOffsets );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexInputLayout()
+void RStateFilterCommandProxy::SetVertexInputLayout( RVertexInputLayout* pLayout )
+{
+    ++m_requestedBindCount;
+
+    if( ( m_knownStateFlags & STATE_FLAG_VERTEX_INPUT_LAYOUT ) && m_spVertexInputLayout == pLayout )
+    {
+        return;
+    }
+
+    m_spVertexInputLayout = pLayout;
+    m_knownStateFlags |= STATE_FLAG_VERTEX_INPUT_LAYOUT;
+
+    ++m_issuedBindCount;
+    m_spTargetProxy->SetVertexInputLayout( pLayout );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexShader()
+void RStateFilterCommandProxy::SetVertexShader( RVertexShader* pShader )
+{
+    ++m_requestedBindCount;
+
+    if( ( m_knownStateFlags & STATE_FLAG_VERTEX_SHADER ) && m_spVertexShader == pShader )
+    {
+        return;
+    }
+
+    m_spVertexShader = pShader;
+    m_knownStateFlags |= STATE_FLAG_VERTEX_SHADER;
+
+    ++m_issuedBindCount;
+    m_spTargetProxy->SetVertexShader( pShader );
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelShader()
+void RStateFilterCommandProxy::SetPixelShader( RPixelShader* pShader )
+{
+    ++m_requestedBindCount;
+
+    if( ( m_knownStateFlags & STATE_FLAG_PIXEL_SHADER ) && m_spPixelShader == pShader )
+    {
+        return;
+    }
+
+    m_spPixelShader = pShader;
+    m_knownStateFlags |= STATE_FLAG_PIXEL_SHADER;
+
+    ++m_issuedBindCount;
+    m_spTargetProxy->SetPixelShader( pShader );
+}
+
+/// @copydoc RRenderCommandProxy::SetVertexConstantBuffers()
+void RStateFilterCommandProxy::SetVertexConstantBuffers(
+    size_t startIndex,
+    size_t bufferCount,
+    RConstantBuffer* const* ppBuffers,
+    const size_t* pLimitSizes )
+{
+    SetConstantBuffers( m_vertexConstantBuffers, false, startIndex, bufferCount, ppBuffers, pLimitSizes );
+}
+
+/// @copydoc RRenderCommandProxy::SetPixelConstantBuffers()
+void RStateFilterCommandProxy::SetPixelConstantBuffers(
+    size_t startIndex,
+    size_t bufferCount,
+    RConstantBuffer* const* ppBuffers,
+    const size_t* pLimitSizes )
+{
+    SetConstantBuffers( m_pixelConstantBuffers, true, startIndex, bufferCount, ppBuffers, pLimitSizes );
+}
+
+/// @copydoc RRenderCommandProxy::SetTexture()
+void RStateFilterCommandProxy::SetTexture( size_t samplerIndex, RTexture* pTexture )
+{
+    ++m_requestedBindCount;
+
+    if( samplerIndex >= SAMPLER_SLOT_COUNT )
+    {
+        ++m_issuedBindCount;
+        m_spTargetProxy->SetTexture( samplerIndex, pTexture );
+
+        return;
+    }
+
+    // Defer the change until the next draw.
+    uint32_t slotMask = 1U << samplerIndex;
+    m_pendingTextures[ samplerIndex ] = pTexture;
+    if( ( m_knownTextureMask & slotMask ) && m_textures[ samplerIndex ] == pTexture )
+    {
+        m_pendingTextureMask &= ~slotMask;
+    }
+    else
+    {
+        m_pendingTextureMask |= slotMask;
+    }
+}
+
+/// @copydoc RRenderCommandProxy::DrawIndexed()
+void RStateFilterCommandProxy::DrawIndexed(
+    ERendererPrimitiveType primitiveType,
+    uint32_t baseVertexIndex,
+    uint32_t minIndex,
+    uint32_t usedVertexCount,
+    uint32_t startIndex,
+    uint32_t primitiveCount )
+{
+    FlushPendingBinds();
+    m_spTargetProxy->DrawIndexed(
+        primitiveType,
+        baseVertexIndex,
+        minIndex,
+        usedVertexCount,
+        startIndex,
+        primitiveCount );
+}
+
+/// @copydoc RRenderCommandProxy::DrawUnindexed()
+void RStateFilterCommandProxy::DrawUnindexed(
+    ERendererPrimitiveType primitiveType,
+    uint32_t baseVertexIndex,
+    uint32_t primitiveCount )
+{
+    FlushPendingBinds();
+    m_spTargetProxy->DrawUnindexed( primitiveType, baseVertexIndex, primitiveCount );
+}
+
+/// @copydoc RRenderCommandProxy::SetFence()
+void RStateFilterCommandProxy::SetFence( RFence* pFence )
+{
+    m_spTargetProxy->SetFence( pFence );
+}
+
+/// @copydoc RRenderCommandProxy::UnbindResources()
+void RStateFilterCommandProxy::UnbindResources()
+{
+    // Binds that were never followed by a draw have no effect once everything is unbound.
+    DiscardPendingBinds();
+
+    m_spTargetProxy->UnbindResources();
+
+    // Release our references along with those of the target proxy.
+    InvalidateState();
+}
+
+/// @copydoc RRenderCommandProxy::ExecuteCommandList()
+void RStateFilterCommandProxy::ExecuteCommandList( RRenderCommandList* pCommandList )
+{
+    FlushPendingBinds();
+    m_spTargetProxy->ExecuteCommandList( pCommandList );
+
+    // The command list can change any state.
+    InvalidateState();
+}
+
+/// @copydoc RRenderCommandProxy::FinishCommandList()
+void RStateFilterCommandProxy::FinishCommandList( RRenderCommandListPtr& rspCommandList )
+{
+    FlushPendingBinds();
+    m_spTargetProxy->FinishCommandList( rspCommandList );
+
+    // Recording of the next command list starts from an unknown state.
+    InvalidateState();
+}
+
+/// Forget the state last passed on to the target proxy, causing the next bind of each state to be issued regardless
+/// of its value.
+///
+/// This must be called whenever the state of the target proxy may have changed without going through this proxy.
+/// Any pending sampler state and texture changes are discarded, and all references to bound resources are released.
+void RStateFilterCommandProxy::InvalidateState()
+{
+    DiscardPendingBinds();
+
+    m_spRasterizerState.Release();
+    m_spBlendState.Release();
+    m_spDepthStencilState.Release();
+    m_spIndexBuffer.Release();
+    m_spVertexInputLayout.Release();
+    m_spVertexShader.Release();
+    m_spPixelShader.Release();
+    m_knownStateFlags = 0;
+
+    for( size_t slotIndex = 0; slotIndex < VERTEX_BUFFER_SLOT_COUNT; ++slotIndex )
+    {
+        m_vertexBuffers[ slotIndex ].Release();
+    }
+
+    m_knownVertexBufferMask = 0;
+
+    for( size_t slotIndex = 0; slotIndex < CONSTANT_BUFFER_SLOT_COUNT; ++slotIndex )
+    {
+        m_vertexConstantBuffers.buffers[ slotIndex ].Release();
+        m_pixelConstantBuffers.buffers[ slotIndex ].Release();
+    }
+
+    m_vertexConstantBuffers.knownMask = 0;
+    m_pixelConstantBuffers.knownMask = 0;
+
+    for( size_t slotIndex = 0; slotIndex < SAMPLER_SLOT_COUNT; ++slotIndex )
+    {
+        m_samplerStates[ slotIndex ].Release();
+        m_textures[ slotIndex ].Release();
+    }
+
+    m_knownSamplerMask = 0;
+    m_knownTextureMask = 0;
+}
+
+/// Reset the requested and issued bind counters to zero.
+///
+/// @see GetRequestedBindCount(), GetIssuedBindCount(), GetFilteredBindCount()
+void RStateFilterCommandProxy::ResetBindCounts()
+{
+    m_requestedBindCount = 0;
+    m_issuedBindCount = 0;
+}
+
+/// Pass all deferred sampler state and texture changes on to the target proxy.
+///
+/// Sampler states for adjacent slots are set using a single call.
+void RStateFilterCommandProxy::FlushPendingBinds()
+{
+    uint32_t pendingMask = m_pendingSamplerMask;
+    size_t slotIndex = 0;
+    while( pendingMask != 0 )
+    {
+        if( !( pendingMask & 1 ) )
+        {
+            pendingMask >>= 1;
+            ++slotIndex;
+
+            continue;
+        }
+
+        size_t rangeStart = slotIndex;
+        do
+        {
+            m_samplerStates[ slotIndex ] = m_pendingSamplerStates[ slotIndex ];
+            pendingMask >>= 1;
+            ++slotIndex;
+        } while( pendingMask & 1 );
+
+        size_t rangeCount = slotIndex - rangeStart;
+        m_issuedBindCount += static_cast< uint32_t >( rangeCount );
+        m_spTargetProxy->SetSamplerStates( rangeStart, rangeCount, m_samplerStates + rangeStart );
+    }
+
+    m_knownSamplerMask |= m_pendingSamplerMask;
+    m_pendingSamplerMask = 0;
+
+    pendingMask = m_pendingTextureMask;
+    for( slotIndex = 0; pendingMask != 0; ++slotIndex, pendingMask >>= 1 )
+    {
+        if( pendingMask & 1 )
+        {
+            RTexture* pTexture = m_pendingTextures[ slotIndex ];
+            m_textures[ slotIndex ] = pTexture;
+
+            ++m_issuedBindCount;
+            m_spTargetProxy->SetTexture( slotIndex, pTexture );
+        }
+    }
+
+    m_knownTextureMask |= m_pendingTextureMask;
+    m_pendingTextureMask = 0;
+}
+
+/// Drop all deferred sampler state and texture changes without passing them on to the target proxy.
+void RStateFilterCommandProxy::DiscardPendingBinds()
+{
+    for( size_t slotIndex = 0; slotIndex < SAMPLER_SLOT_COUNT; ++slotIndex )
+    {
+        m_pendingSamplerStates[ slotIndex ].Release();
+        m_pendingTextures[ slotIndex ].Release();
+    }
+
+    m_pendingSamplerMask = 0;
+    m_pendingTextureMask = 0;
+}
+
+/// Filter a change to a range of constant buffers for either the vertex or pixel shader.
+///
+/// The call is passed on unchanged if any buffer or update limit in the range differs from the bound state.  Buffer
+/// contents are not compared, as updates to the contents of a bound buffer are picked up by the renderer at draw time.
+///
+/// @param[in] rSlots        Bound constant buffer slots for the shader type.
+/// @param[in] bPixelShader  True to set pixel shader constant buffers, false to set vertex shader constant buffers.
+/// @param[in] startIndex    Starting constant buffer index to set.
+/// @param[in] bufferCount   Number of consecutive constant buffers to set.
+/// @param[in] ppBuffers     Array of constant buffers to set.
+/// @param[in] pLimitSizes   Optional array of update limits, in bytes, for each constant buffer.
+void RStateFilterCommandProxy::SetConstantBuffers(
+    ConstantBufferSlots& rSlots,
+    bool bPixelShader,
+    size_t startIndex,
+    size_t bufferCount,
+    RConstantBuffer* const* ppBuffers,
+    const size_t* pLimitSizes )
+{
+    HELIUM_ASSERT( ppBuffers || bufferCount == 0 );
+
+    m_requestedBindCount += static_cast< uint32_t >( bufferCount );
+
+    size_t trackedCount = 0;
+    if( startIndex < CONSTANT_BUFFER_SLOT_COUNT )
+    {
+        trackedCount = Min( bufferCount, CONSTANT_BUFFER_SLOT_COUNT - startIndex );
+    }
+
+    bool bChanged = ( trackedCount < bufferCount );
+    for( size_t bufferIndex = 0; bufferIndex < trackedCount && !bChanged; ++bufferIndex )
+    {
+        size_t slotIndex = startIndex + bufferIndex;
+        size_t limitSize = ( pLimitSizes ? pLimitSizes[ bufferIndex ] : Invalid< size_t >() );
+        bChanged = ( !( rSlots.knownMask & ( 1U << slotIndex ) ) ||
+                     rSlots.buffers[ slotIndex ] != ppBuffers[ bufferIndex ] ||
+                     rSlots.limitSizes[ slotIndex ] != limitSize );
+    }
+
+    if( !bChanged )
+    {
+        return;
+    }
+
+    for( size_t bufferIndex = 0; bufferIndex < trackedCount; ++bufferIndex )
+    {
+        size_t slotIndex = startIndex + bufferIndex;
+        rSlots.buffers[ slotIndex ] = ppBuffers[ bufferIndex ];
+        rSlots.limitSizes[ slotIndex ] = ( pLimitSizes ? pLimitSizes[ bufferIndex ] : Invalid< size_t >() );
+        rSlots.knownMask |= 1U << slotIndex;
+    }
+
+    m_issuedBindCount += static_cast< uint32_t >( bufferCount );
+    if( bPixelShader )
+    {
+        m_spTargetProxy->SetPixelConstantBuffers( startIndex, bufferCount, ppBuffers, pLimitSizes );
+    }
+    else
+    {
+        m_spTargetProxy->SetVertexConstantBuffers( startIndex, bufferCount, ppBuffers, pLimitSizes );
+    }
+}
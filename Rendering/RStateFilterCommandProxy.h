@@ -0,0 +1,222 @@
+#pragma once
+
+#include "Rendering/RRenderCommandProxy.h"
+
+namespace Helium
+{
+    HELIUM_DECLARE_RPTR( RRenderCommandProxy );
+
+    HELIUM_DECLARE_RPTR( RRasterizerState );
+    HELIUM_DECLARE_RPTR( RBlendState );
+    HELIUM_DECLARE_RPTR( RDepthStencilState );
+
+    HELIUM_DECLARE_RPTR( RIndexBuffer );
+    HELIUM_DECLARE_RPTR( RVertexInputLayout );
+
+    HELIUM_DECLARE_RPTR( RVertexShader );
+    HELIUM_DECLARE_RPTR( RPixelShader );
+
+    HELIUM_DECLARE_RPTR( RTexture );
+
+    /// Render command proxy that filters out redundant state changes before passing commands on to another proxy.
+    ///
+    /// A shadow copy of the state last sent to the target proxy is kept, and binds of state objects, shaders, buffers,
+    /// and textures that match it are dropped.  Sampler state and texture binds are deferred until the next draw, so
+    /// changes to the same slot in between draws collapse into a single bind, and sampler states for adjacent slots
+    /// are issued as a single range.  Commands that do not bind state are always passed through.
+    ///
+    /// The filter only knows about state set through itself.  Any time the target proxy state may change behind its
+    /// back, InvalidateState() must be called so that the next bind of each state is issued unconditionally.
+    class HELIUM_RENDERING_API RStateFilterCommandProxy : public RRenderCommandProxy
+    {
+    public:
+        /// Number of sampler and texture slots tracked.
+        static const size_t SAMPLER_SLOT_COUNT = 16;
+        /// Number of vertex buffer slots tracked.
+        static const size_t VERTEX_BUFFER_SLOT_COUNT = 16;
+        /// Number of constant buffer slots tracked for each shader type.
+        static const size_t CONSTANT_BUFFER_SLOT_COUNT = 16;
+
+        /// @name Construction/Destruction
+        //@{
+        explicit RStateFilterCommandProxy( RRenderCommandProxy* pTargetProxy );
+        //@}
+
+        /// @name State Management
+        //@{
+        void SetRasterizerState( RRasterizerState* pState );
+        void SetBlendState( RBlendState* pState );
+        void SetDepthStencilState( RDepthStencilState* pState, uint8_t stencilReferenceValue );
+        void SetSamplerStates( size_t startIndex, size_t samplerCount, RSamplerState* const* ppStates );
+        //@}
+
+        /// @name Render Target Management
+        //@{
+        void SetRenderSurfaces( RSurface* pRenderTargetSurface, RSurface* pDepthStencilSurface );
+        void SetViewport( uint32_t x, uint32_t y, uint32_t width, uint32_t height );
+        //@}
+
+        /// @name Command Generation
+        //@{
+        void BeginScene();
+        void EndScene();
+
+        void Clear( uint32_t clearFlags, const Color& rColor, float32_t depth, uint8_t stencil );
+
+        void SetIndexBuffer( RIndexBuffer* pBuffer );
+        void SetVertexBuffers(
+            size_t startIndex, size_t bufferCount, RVertexBuffer* const* ppBuffers, uint32_t* pStrides,
+            uint32_t* pOffsets );
+        void SetVertexInputLayout( RVertexInputLayout* pLayout );
+
+        void SetVertexShader( RVertexShader* pShader );
+        void SetPixelShader( RPixelShader* pShader );
+
+        void SetVertexConstantBuffers(
+            size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
+            const size_t* pLimitSizes = NULL );
+        void SetPixelConstantBuffers(
+            size_t startIndex, size_t bufferCount, RConstantBuffer* const* ppBuffers,
+            const size_t* pLimitSizes = NULL );
+
+        void SetTexture( size_t samplerIndex, RTexture* pTexture );
+
+        void DrawIndexed(
+            ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t minIndex, uint32_t usedVertexCount,
+            uint32_t startIndex, uint32_t primitiveCount );
+        void DrawUnindexed( ERendererPrimitiveType primitiveType, uint32_t baseVertexIndex, uint32_t primitiveCount );
+        //@}
+
+        /// @name Fence Commands
+        //@{
+        void SetFence( RFence* pFence );
+        //@}
+
+        /// @name Miscellaneous Resource Management
+        //@{
+        void UnbindResources();
+        //@}
+
+        /// @name Command List Support
+        //@{
+        void ExecuteCommandList( RRenderCommandList* pCommandList );
+
+        void FinishCommandList( RRenderCommandListPtr& rspCommandList );
+        //@}
+
+        /// @name Filtering Support
+        //@{
+        inline RRenderCommandProxy* GetTargetProxy() const;
+
+        void InvalidateState();
+
+        inline uint32_t GetRequestedBindCount() const;
+        inline uint32_t GetIssuedBindCount() const;
+        inline uint32_t GetFilteredBindCount() const;
+        void ResetBindCounts();
+        //@}
+
+    private:
+        /// Single state bind flags.
+        enum EStateFlag
+        {
+            STATE_FLAG_RASTERIZER          = ( 1 << 0 ),
+            STATE_FLAG_BLEND               = ( 1 << 1 ),
+            STATE_FLAG_DEPTH_STENCIL       = ( 1 << 2 ),
+            STATE_FLAG_INDEX_BUFFER        = ( 1 << 3 ),
+            STATE_FLAG_VERTEX_INPUT_LAYOUT = ( 1 << 4 ),
+            STATE_FLAG_VERTEX_SHADER       = ( 1 << 5 ),
+            STATE_FLAG_PIXEL_SHADER        = ( 1 << 6 )
+        };
+
+        /// Constant buffer slot bindings for a single shader type.
+        struct ConstantBufferSlots
+        {
+            /// Bound constant buffers.
+            RConstantBufferPtr buffers[ CONSTANT_BUFFER_SLOT_COUNT ];
+            /// Bound constant buffer update limits, in bytes (invalid if not limited).
+            size_t limitSizes[ CONSTANT_BUFFER_SLOT_COUNT ];
+            /// Bit mask of slots for which the bound buffer is known.
+            uint32_t knownMask;
+        };
+
+        /// Proxy to which commands are passed.
+        RRenderCommandProxyPtr m_spTargetProxy;
+
+        /// Bound rasterizer state.
+        RRasterizerStatePtr m_spRasterizerState;
+        /// Bound blend state.
+        RBlendStatePtr m_spBlendState;
+        /// Bound depth-stencil state.
+        RDepthStencilStatePtr m_spDepthStencilState;
+        /// Bound stencil reference value.
+        uint8_t m_stencilReferenceValue;
+
+        /// Bound index buffer.
+        RIndexBufferPtr m_spIndexBuffer;
+        /// Bound vertex input layout.
+        RVertexInputLayoutPtr m_spVertexInputLayout;
+
+        /// Bound vertex shader.
+        RVertexShaderPtr m_spVertexShader;
+        /// Bound pixel shader.
+        RPixelShaderPtr m_spPixelShader;
+
+        /// Combination of EStateFlag flags for the single states whose bound values are known.
+        uint32_t m_knownStateFlags;
+
+        /// Bound vertex buffers.
+        RVertexBufferPtr m_vertexBuffers[ VERTEX_BUFFER_SLOT_COUNT ];
+        /// Bound vertex buffer strides.
+        uint32_t m_vertexStrides[ VERTEX_BUFFER_SLOT_COUNT ];
+        /// Bound vertex buffer offsets.
+        uint32_t m_vertexOffsets[ VERTEX_BUFFER_SLOT_COUNT ];
+        /// Bit mask of vertex buffer slots whose bound values are known.
+        uint32_t m_knownVertexBufferMask;
+
+        /// Vertex shader constant buffer bindings.
+        ConstantBufferSlots m_vertexConstantBuffers;
+        /// Pixel shader constant buffer bindings.
+        ConstantBufferSlots m_pixelConstantBuffers;
+
+        /// Bound sampler states.
+        RSamplerStatePtr m_samplerStates[ SAMPLER_SLOT_COUNT ];
+        /// Sampler states to bind at the next draw.
+        RSamplerStatePtr m_pendingSamplerStates[ SAMPLER_SLOT_COUNT ];
+        /// Bit mask of sampler slots whose bound states are known.
+        uint32_t m_knownSamplerMask;
+        /// Bit mask of sampler slots with pending changes.
+        uint32_t m_pendingSamplerMask;
+
+        /// Bound textures.
+        RTexturePtr m_textures[ SAMPLER_SLOT_COUNT ];
+        /// Textures to bind at the next draw.
+        RTexturePtr m_pendingTextures[ SAMPLER_SLOT_COUNT ];
+        /// Bit mask of texture slots whose bound textures are known.
+        uint32_t m_knownTextureMask;
+        /// Bit mask of texture slots with pending changes.
+        uint32_t m_pendingTextureMask;
+
+        /// Number of state binds requested since the last counter reset.
+        uint32_t m_requestedBindCount;
+        /// Number of state binds passed on to the target proxy since the last counter reset.
+        uint32_t m_issuedBindCount;
+
+        /// @name Construction/Destruction
+        //@{
+        ~RStateFilterCommandProxy();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        void FlushPendingBinds();
+        void DiscardPendingBinds();
+
+        void SetConstantBuffers(
+            ConstantBufferSlots& rSlots, bool bPixelShader, size_t startIndex, size_t bufferCount,
+            RConstantBuffer* const* ppBuffers, const size_t* pLimitSizes );
+        //@}
+    };
+}
+
+#include "Rendering/RStateFilterCommandProxy.inl"
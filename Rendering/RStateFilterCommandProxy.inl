@@ -0,0 +1,43 @@
+namespace Helium
+{
+    /// Get the proxy to which commands are passed.
+    ///
+    /// @return  Target command proxy.
+    RRenderCommandProxy* RStateFilterCommandProxy::GetTargetProxy() const
+    {
+        return m_spTargetProxy;
+    }
+
+    /// Get the number of state binds requested through this proxy since the counters were last reset.
+    ///
+    /// Each slot set by a call that sets a range of slots counts as a separate bind.
+    ///
+    /// @return  Requested bind count.
+    ///
+    /// @see GetIssuedBindCount(), GetFilteredBindCount(), ResetBindCounts()
+    uint32_t RStateFilterCommandProxy::GetRequestedBindCount() const
+    {
+        return m_requestedBindCount;
+    }
+
+    /// Get the number of state binds passed on to the target proxy since the counters were last reset.
+    ///
+    /// @return  Issued bind count.
+    ///
+    /// @see GetRequestedBindCount(), GetFilteredBindCount(), ResetBindCounts()
+    uint32_t RStateFilterCommandProxy::GetIssuedBindCount() const
+    {
+        return m_issuedBindCount;
+    }
+
+    /// Get the number of requested state binds that were dropped, either because they matched the bound state or
+    /// because they were replaced before the next draw.
+    ///
+    /// @return  Filtered bind count.
+    ///
+    /// @see GetRequestedBindCount(), GetIssuedBindCount(), ResetBindCounts()
+    uint32_t RStateFilterCommandProxy::GetFilteredBindCount() const
+    {
+        return ( m_requestedBindCount > m_issuedBindCount ? m_requestedBindCount - m_issuedBindCount : 0 );
+    }
+}
@@ -1,6 +1,8 @@
 #include "RenderingPch.h"
 #include "Rendering/Renderer.h"
 
+#include "Rendering/RStateFilterCommandProxy.h"
+
 using namespace Helium;
 
 Renderer* Renderer::sm_pInstance = NULL;
@@ -273,9 +275,12 @@ Renderer::~Renderer()
 /// Note that only one thread (typically the same thread used to process the target window messages) should use an
 /// immediate command proxy at a time.
 ///
+/// Renderer implementations return the proxy through a redundant state filter (see GetImmediateCommandFilter()), so
+/// callers do not need to track the state they have already set.
+///
 /// @return  Immediate render command proxy interface.
 ///
-/// @see CreateDeferredCommandProxy()
+/// @see CreateDeferredCommandProxy(), GetImmediateCommandFilter()
 
 /// @fn RRenderCommandProxy* Renderer::CreateDeferredCommandProxy()
 /// Create a render command proxy for recording render commands for later immediate use.
@@ -25,6 +25,8 @@ namespace Helium
 
     class RFence;
 
+    HELIUM_DECLARE_RPTR( RStateFilterCommandProxy );
+
     /// Main renderer base class.
     class HELIUM_RENDERING_API Renderer : NonCopyable
     {
@@ -140,6 +142,7 @@ namespace Helium
         //@{
         virtual RRenderCommandProxy* GetImmediateCommandProxy() = 0;
         virtual RRenderCommandProxy* CreateDeferredCommandProxy() = 0;
+        inline RStateFilterCommandProxy* GetImmediateCommandFilter() const;
 
         virtual void Flush() = 0;
         //@}
@@ -154,6 +157,9 @@ namespace Helium
         /// Renderer feature flags.
         uint32_t m_featureFlags;
 
+        /// Redundant state filter wrapping the immediate render command proxy.
+        RStateFilterCommandProxyPtr m_spImmediateCommandFilter;
+
         /// Singleton instance.
         static Renderer* sm_pInstance;
 
@@ -37,6 +37,18 @@ namespace Helium
         return ( ( m_featureFlags & featureFlags ) != 0 );
     }
 
+    /// Get the redundant state filter through which commands issued to the immediate command proxy are passed.
+    ///
+    /// The filter counts the state binds it receives and drops, which can be queried and reset each frame.
+    ///
+    /// @return  Immediate command state filter, or null if the renderer has not created its main context.
+    ///
+    /// @see GetImmediateCommandProxy()
+    RStateFilterCommandProxy* Renderer::GetImmediateCommandFilter() const
+    {
+        return m_spImmediateCommandFilter;
+    }
+
     /// Constructor.
     ///
     /// Initializes to a default set of parameters.
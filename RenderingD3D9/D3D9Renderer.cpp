@@ -3,6 +3,7 @@
 
 #include "Platform/Thread.h"
 #include "Rendering/RendererUtil.h"
+#include "Rendering/RStateFilterCommandProxy.h"
 
 #include "RenderingD3D9/D3D9BlendState.h"
 #include "RenderingD3D9/D3D9ConstantBuffer.h"
@@ -197,6 +198,7 @@ void D3D9Renderer::Shutdown()
     HELIUM_TRACE( TraceLevels::Info, TXT( "Shutting down Direct3D 9 rendering support (D3D9Renderer).\n" ) );
 
     m_spMainContext.Release();
+    m_spImmediateCommandFilter.Release();
     m_spImmediateCommandProxy.Release();
 
     for( size_t mapPoolIndex = 0; mapPoolIndex < HELIUM_ARRAY_COUNT( m_staticTextureMapTargetPools ); ++mapPoolIndex )
@@ -317,6 +319,9 @@ bool D3D9Renderer::CreateMainContext( const ContextInitParameters& rInitParamete
     m_spImmediateCommandProxy = new D3D9ImmediateCommandProxy( m_pD3DDevice );
     HELIUM_ASSERT( m_spImmediateCommandProxy );
 
+    m_spImmediateCommandFilter = new RStateFilterCommandProxy( m_spImmediateCommandProxy );
+    HELIUM_ASSERT( m_spImmediateCommandFilter );
+
     // Create the main rendering context interface.
     m_spMainContext = new D3D9MainContext( m_pD3DDevice );
     HELIUM_ASSERT( m_spMainContext );
@@ -1266,7 +1271,7 @@ bool D3D9Renderer::TrySyncFence( RFence* pFence )
 /// @copydoc Renderer::GetImmediateCommandProxy()
 RRenderCommandProxy* D3D9Renderer::GetImmediateCommandProxy()
 {
-    return m_spImmediateCommandProxy;
+    return m_spImmediateCommandFilter;
 }
 
 /// @copydoc Renderer::CreateDeferredCommandProxy()
@@ -27,8 +27,6 @@ void GLImmediateCommandProxy::SetRasterizerState( RRasterizerState* pState )
 	GLRasterizerState *pGLState = static_cast< GLRasterizerState* >( pState );
 	HELIUM_ASSERT( pGLState != NULL );
 
-	// TODO: don't make redundant state changes.
-
 	glPolygonMode( GL_FRONT_AND_BACK, pGLState->m_fillMode );
 
 	if( pGLState->m_cullEnable )
@@ -59,8 +57,6 @@ void GLImmediateCommandProxy::SetBlendState( RBlendState* pState )
 	GLBlendState *pGLState = static_cast< GLBlendState* >( pState );
 	HELIUM_ASSERT( pGLState != NULL );
 
-	// TODO: don't make redundant state changes.
-
 	glColorMask(
 		pGLState->m_redWriteMaskEnable,
 		pGLState->m_greenWriteMaskEnable,
@@ -87,8 +83,6 @@ void GLImmediateCommandProxy::SetDepthStencilState( RDepthStencilState* pState,
 	GLDepthStencilState *pGLState = static_cast< GLDepthStencilState* >( pState );
 	HELIUM_ASSERT( pGLState != NULL );
 
-	// TODO: don't make redundant state changes.
-
 	if( pGLState->m_depthTestEnable )
 	{
 		glEnable( GL_DEPTH_TEST );
@@ -137,7 +131,7 @@ void GLImmediateCommandProxy::SetSamplerStates(
 	glGetIntegerv( GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxActiveTextures );
 
 	HELIUM_ASSERT( startIndex < maxActiveTextures );
-	if( startIndex >= maxActiveTextures )
+	if( startIndex + samplerCount > maxActiveTextures )
 	{
 		HELIUM_TRACE( TraceLevels::Warning, "GLImmediateCommandProxy: Maximum number of active textures exceeded.\n" );
 		if( startIndex < maxActiveTextures )
@@ -157,9 +151,7 @@ void GLImmediateCommandProxy::SetSamplerStates(
 		GLSamplerState *pGLState = static_cast< GLSamplerState* >( ppStates[ i ] );
 		HELIUM_ASSERT( pGLState != NULL );
 
-		// TODO: don't make redundant state changes.
-		
-		const GLenum activeTexture = GL_TEXTURE0 + static_cast< GLenum >( i );
+		const GLenum activeTexture = GL_TEXTURE0 + static_cast< GLenum >( startIndex + i );
 		glActiveTexture( activeTexture );
 
 		glTexParameteri( pGLState->m_texParameterTarget, GL_TEXTURE_MIN_FILTER, pGLState->m_minFilter );
@@ -15,6 +15,7 @@
 #include "RenderingGL/GLSurface.h"
 
 #include "Rendering/RendererUtil.h"
+#include "Rendering/RStateFilterCommandProxy.h"
 
 #include "GL/glew.h"
 #include "GLFW/glfw3.h"
@@ -126,6 +127,7 @@ void GLRenderer::Shutdown()
 	HELIUM_TRACE( TraceLevels::Info, TXT( "Shutting down OpenGL rendering support.\n" ) );
 
 	m_spMainContext.Release();
+	m_spImmediateCommandFilter.Release();
 	m_spImmediateCommandProxy.Release();
 
 	m_featureFlags = 0;
@@ -144,6 +146,9 @@ bool GLRenderer::CreateMainContext( const ContextInitParameters& rInitParameters
 	m_spImmediateCommandProxy = new GLImmediateCommandProxy( m_pGlfwWindow );
 	HELIUM_ASSERT( m_spImmediateCommandProxy );
 
+	m_spImmediateCommandFilter = new RStateFilterCommandProxy( m_spImmediateCommandProxy );
+	HELIUM_ASSERT( m_spImmediateCommandFilter );
+
 	// Create the main rendering context interface.
 	glfwMakeContextCurrent( m_pGlfwWindow );
 	m_spMainContext = new GLMainContext( m_pGlfwWindow );
@@ -641,7 +646,7 @@ bool GLRenderer::TrySyncFence( RFence* pFence )
 /// @copydoc Renderer::GetImmediateCommandProxy()
 RRenderCommandProxy* GLRenderer::GetImmediateCommandProxy()
 {
-	return m_spImmediateCommandProxy;
+	return m_spImmediateCommandFilter;
 }
 
 /// @copydoc Renderer::CreateDeferredCommandProxy()